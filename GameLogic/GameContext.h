@@ -11,9 +11,11 @@
 // GameRender / Starstrike continue to include GameApp.h (which
 #pragma once
 
+#include "GameSimEventQueue.h"
 #include "rgb_colour.h"
 
 class Camera;
+class ExplosionManager;
 class Location;
 class Server;
 class ClientToServer;
@@ -35,6 +37,21 @@ class StartSequence;
 class BitmapRGBA;
 class SoundLibrary2d;
 
+namespace Neuron
+{
+  class JobSystem;
+}
+
+// Mersenne Twister state behind syncrand().  Every match draws from its own.
+struct SyncRandState
+{
+    static constexpr int SIZE = 624;
+
+    uint32_t m_mt[SIZE] = {};
+    int m_mti = SIZE + 1;   // SIZE + 1 means not seeded yet
+    uint64_t m_draws = 0;   // Values handed out, folded into the sync digest
+};
+
 struct GameContext
 {
     // Library Code Objects
@@ -43,6 +60,7 @@ struct GameContext
     ParticleSystem* m_particleSystem = nullptr;
     LangTable* m_langTable = nullptr;
     Profiler* m_profiler = nullptr;
+    Neuron::JobSystem* m_jobSystem = nullptr; // Shared by every match in the process
 
     // Things that are the world
     GlobalWorld* m_globalWorld = nullptr;
@@ -60,6 +78,7 @@ struct GameContext
     Script* m_script = nullptr;
     GameCursor* m_gameCursor = nullptr;
     GameCursor2D* m_gameCursor2D = nullptr;
+    ExplosionManager* m_explosionManager = nullptr; // Drawn for the match on screen; nullptr when headless
     StartSequence* m_startSequence = nullptr;
 
     bool m_bypassNetworking = false;
@@ -86,6 +105,20 @@ struct GameContext
     bool m_atMainMenu = false; // true when the player is viewing the darwinia/mutliwinia menu
     int m_gameMode = GameModeNone;
 
+    // Per-match simulation state.  A process may host several matches, each
+    // with its own GameContext, so nothing the simulation mutates outside the
+    // Location may live in a global.
+    GameSimEventQueue m_simEventQueue;
+    SyncRandState m_syncRandom;
+    int m_nextUniqueId = 0; // Last WorldObjectId unique id handed out
+
+    // Where this match's client is in the server's letter sequence.  The
+    // listener thread moves m_startTime, so it cannot be process-wide either.
+    double m_startTime = std::numeric_limits<double>::max(); // Local time of sequence id 0
+    double m_lastServerAdvance = 0.0; // Local time of the last letter processed
+    int m_lastProcessedSequenceId = -1;
+    int m_sliceNum = -1; // Most recently advanced slice; -1 between letters
+
     enum
     {
       GameModeNone,
@@ -102,4 +135,25 @@ struct GameContext
     static const char* GetScreenshotDirectory();
 };
 
-inline GameContext* g_context = {};
+// The context this thread is simulating.  Thread-local so a host can advance
+// several matches at once; threads doing work for a match (network I/O,
+// parallel loops) bind its context with GameContextScope.
+inline thread_local GameContext* g_context = {};
+
+class GameContextScope
+{
+  public:
+    explicit GameContextScope(GameContext* _context)
+      : m_previous(g_context)
+    {
+      g_context = _context;
+    }
+
+    ~GameContextScope() { g_context = m_previous; }
+
+    GameContextScope(const GameContextScope&) = delete;
+    GameContextScope& operator=(const GameContextScope&) = delete;
+
+  private:
+    GameContext* m_previous;
+};
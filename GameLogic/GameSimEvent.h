@@ -4,6 +4,7 @@
 #include "GameMatrix.h"
 #include "rgb_colour.h"
 #include "worldobject.h"
+#include "SimEventQueue.h"
 
 #include <variant>
 
@@ -116,6 +117,42 @@ struct GameSimEvent
     return std::visit(std::forward<Visitor>(_vis), data);
   }
 
+  // --- Coalescing (see SimEventQueue) ---------------------------------------
+
+  // The same sound event on the same object plays once per drain.  Stopping
+  // an object's sounds is a barrier so a later restart is not swallowed.
+  // Particles and explosions are never merged, and neither is a sound from
+  // an object without a valid id, which cannot be told apart from others.
+  [[nodiscard]] uint64_t CoalesceKey() const
+  {
+    auto soundKey = [this](const WorldObjectId& _id, const char* _eventName, int _sourceType = -1) -> uint64_t
+    {
+      if (!_id.IsValid())
+        return 0;
+
+      uint64_t key = 0xcbf29ce484222325ULL;
+      auto fold = [&key](uint64_t _value) { key = (key ^ _value) * 0x100000001b3ULL; };
+      fold(data.index());
+      fold(static_cast<uint32_t>(_sourceType));
+      fold(_id.GetTeamId());
+      fold(static_cast<uint32_t>(_id.GetUnitId()));
+      fold(static_cast<uint32_t>(_id.GetIndex()));
+      fold(static_cast<uint32_t>(_id.GetUniqueId()));
+      for (const char* c = _eventName; c && *c; ++c)
+        fold(static_cast<unsigned char>(*c));
+      return (key == 0 || key == SIM_EVENT_BARRIER) ? 1 : key;
+    };
+
+    return Visit(Overloaded{
+      [](const ParticleSpawn&) -> uint64_t { return 0; },
+      [](const Explosion&) -> uint64_t { return 0; },
+      [](const SoundStop&) -> uint64_t { return SIM_EVENT_BARRIER; },
+      [&](const SoundEntityEvent& e) { return soundKey(e.objectId, e.eventName); },
+      [&](const SoundBuildingEvent& e) { return soundKey(e.objectId, e.eventName); },
+      [&](const SoundOtherEvent& e) { return soundKey(e.objectId, e.eventName, e.soundSourceType); },
+    });
+  }
+
   // --- Factory helpers (preserve producer call-site compatibility) ----------
 
   [[nodiscard]] static GameSimEvent MakeParticle(const Neuron::Math::GameVector3& _pos, const Neuron::Math::GameVector3& _vel, int _particleType,
@@ -1,4 +0,0 @@
-#include "pch.h"
-#include "GameSimEventQueue.h"
-
-GameSimEventQueue g_simEventQueue;
@@ -3,6 +3,4 @@
 #include "SimEventQueue.h" // NeuronCore generic template
 #include "GameSimEvent.h"
 
-using GameSimEventQueue = SimEventQueue<GameSimEvent, 1024>;
-
-extern GameSimEventQueue g_simEventQueue;
+using GameSimEventQueue = SimEventQueue<GameSimEvent>; // One per match: GameContext::m_simEventQueue
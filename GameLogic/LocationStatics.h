@@ -0,0 +1,26 @@
+#pragma once
+
+#include "llist.h"
+
+// Teleport: maps units going in onto units coming out
+struct TeleportMap
+{
+  int m_teamId;
+  int m_fromUnitId;
+  int m_toUnitId;
+};
+
+// State shared by every object of a kind within one Location.  These were
+// class statics, which two matches in one process would share; each
+// Location now has its own.  Late-join snapshots carry all but
+// m_masterSpawnPointId, which MasterSpawnPoint::Advance sets every tick.
+struct LocationStatics
+{
+  unsigned int m_lastWayPointId = 0;          // HistoricWayPoint
+  float m_refineryPopulation = 0.0f;          // MineBuilding
+  float m_refineryRecalculateTimer = 0.0f;
+  float m_overpopulationTimer = 0.0f;         // SpawnPopulationLock
+  int m_overpopulation = 0;
+  LList<TeleportMap> m_teleportMap;           // Teleport
+  int m_masterSpawnPointId = -1;              // MasterSpawnPoint, by unique id
+};
@@ -0,0 +1,40 @@
+// GameLogic/SyncReport.h
+//
+// Per-subsystem state checksums a client reports to the server after each
+// processed sequence id.  The server compares reports from every client and
+// records the first sequence id and subsystem at which they diverge.
+#pragma once
+
+enum class SyncSubsystem : unsigned char
+{
+  Entities,
+  Buildings,
+  Spirits,
+  Random
+};
+
+inline constexpr int NumSyncSubsystems = 4;
+
+struct SyncReport
+{
+  uint64_t m_checksums[NumSyncSubsystems] = {};
+
+  uint64_t& operator[](SyncSubsystem _subsystem) { return m_checksums[static_cast<int>(_subsystem)]; }
+
+  // Returns the first subsystem that differs from _other, or -1 if in sync
+  int FirstMismatch(const SyncReport& _other) const
+  {
+    for (int i = 0; i < NumSyncSubsystems; ++i)
+    {
+      if (m_checksums[i] != _other.m_checksums[i])
+        return i;
+    }
+    return -1;
+  }
+
+  static const char* GetSubsystemName(int _subsystem)
+  {
+    static const char* names[NumSyncSubsystems] = {"Entities", "Buildings", "Spirits", "Random"};
+    return (_subsystem >= 0 && _subsystem < NumSyncSubsystems) ? names[_subsystem] : "Unknown";
+  }
+};
@@ -251,26 +251,22 @@ void TerrainWorld::SnapshotAllDirtyChunks()
 
 
 // ============================================================================
-// CA tick — OMP parallel over active chunks
+// CA tick — parallel over active chunks
 // ============================================================================
 
-void TerrainWorld::TickActiveChunks(float _alpha, float _beta, float _maxPh)
+void TerrainWorld::TickActiveChunks(float _alpha, float _beta, float _maxPh, JobSystem* _jobs)
 {
     // Halo exchange must happen before parallel tick so each chunk
     // has consistent neighbor data.
     ExchangeHalos();
 
-    int numActive = m_activeChunkCount;
-
-#undef for
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < numActive; ++i)
+    ParallelFor(_jobs, 0, m_activeChunkCount, 1, [&](int i)
     {
         TerrainChunk* chunk = m_activeChunks[i];
         chunk->TickPheromones(_alpha, _beta, _maxPh,
             GetNeighborN(chunk), GetNeighborS(chunk),
             GetNeighborE(chunk), GetNeighborW(chunk));
-    }
+    });
 }
 
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "JobSystem.h"
 #include "TerrainChunk.h"
 
 // ============================================================================
@@ -47,8 +48,8 @@ public:
     // compare post-tick state against the pre-tick baseline (§7.3 R7).
     void SnapshotAllDirtyChunks();
 
-    // --- CA tick (server-only, OMP parallel over active chunks) ---
-    void TickActiveChunks(float _alpha, float _beta, float _maxPh);
+    // --- CA tick (server-only, parallel over active chunks when given a JobSystem) ---
+    void TickActiveChunks(float _alpha, float _beta, float _maxPh, JobSystem* _jobs = nullptr);
 
     // --- Halo exchange (call before TickActiveChunks) ---
     void ExchangeHalos();
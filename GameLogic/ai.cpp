@@ -166,6 +166,18 @@ int AI::FindNearestTarget(const LegacyVector3& _fromPos)
   return id;
 }
 
+void AI::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_timer);
+}
+
+void AI::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_timer);
+}
+
 bool AI::Advance([[maybe_unused]] Unit* _unit)
 {
   //
@@ -394,6 +406,28 @@ float AITarget::IsNearTo(int _aiTargetId)
   return -1.0f;
 }
 
+void AITarget::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_teamCountTimer);
+  WriteSnapshotList(_writer, m_neighbours);
+  _writer.Write(m_friendCount);
+  _writer.Write(m_enemyCount);
+  _writer.Write(m_idleCount);
+  _writer.Write(m_priority);
+}
+
+void AITarget::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_teamCountTimer);
+  ReadSnapshotList(_reader, m_neighbours);
+  _reader.Read(m_friendCount);
+  _reader.Read(m_enemyCount);
+  _reader.Read(m_idleCount);
+  _reader.Read(m_priority);
+}
+
 bool AITarget::Advance()
 {
   RecalculatePriority();
@@ -537,6 +571,36 @@ bool AISpawnPoint::PopulationLocked()
   return false;
 }
 
+void AISpawnPoint::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_timer);
+  _writer.Write(m_online);
+  _writer.Write(m_numSpawned);
+  _writer.Write(m_populationLock);
+  _writer.Write(m_entityType);
+  _writer.Write(m_count);
+  _writer.Write(m_period);
+  _writer.Write(m_activatorId);
+  _writer.Write(m_spawnLimit);
+  _writer.Write(m_routeId);
+}
+
+void AISpawnPoint::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_timer);
+  _reader.Read(m_online);
+  _reader.Read(m_numSpawned);
+  _reader.Read(m_populationLock);
+  _reader.Read(m_entityType);
+  _reader.Read(m_count);
+  _reader.Read(m_period);
+  _reader.Read(m_activatorId);
+  _reader.Read(m_spawnLimit);
+  _reader.Read(m_routeId);
+}
+
 bool AISpawnPoint::Advance()
 {
   //
@@ -17,6 +17,8 @@ class AI : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
 };
 
@@ -40,6 +42,8 @@ class AITarget : public Building
     AITarget();
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void RecalculateNeighbours();
     void RecountTeams();
@@ -76,6 +80,8 @@ class AISpawnPoint : public Building
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Read(TextReader* _in, bool _dynamic) override;
     void Write(FileWriter* _out) override;
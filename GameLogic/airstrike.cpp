@@ -112,6 +112,34 @@ bool AirstrikeUnit::AdvanceToTargetPosition(LegacyVector3 _targetPos)
   return (newDistance < 10.0f);
 }
 
+void AirstrikeUnit::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Unit::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_enterPosition);
+  WriteSnapshotVector(_writer, m_attackPosition);
+  WriteSnapshotVector(_writer, m_exitPosition);
+  WriteSnapshotVector(_writer, m_front);
+  WriteSnapshotVector(_writer, m_up);
+  _writer.Write(m_speed);
+  _writer.Write(m_effectId);
+  _writer.Write(m_numInvaders);
+  _writer.Write(m_state);
+}
+
+void AirstrikeUnit::ReadSnapshot(SnapshotReader& _reader)
+{
+  Unit::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_enterPosition);
+  ReadSnapshotVector(_reader, m_attackPosition);
+  ReadSnapshotVector(_reader, m_exitPosition);
+  ReadSnapshotVector(_reader, m_front);
+  ReadSnapshotVector(_reader, m_up);
+  _reader.Read(m_speed);
+  _reader.Read(m_effectId);
+  _reader.Read(m_numInvaders);
+  _reader.Read(m_state);
+}
+
 bool AirstrikeUnit::Advance(int _slice)
 {
   //
@@ -154,6 +182,20 @@ SpaceInvader::SpaceInvader()
   m_bombShape = Resource::GetShapeStatic("throwable.shp");
 }
 
+void SpaceInvader::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_targetPos);
+  _writer.Write(m_armed);
+}
+
+void SpaceInvader::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_targetPos);
+  _reader.Read(m_armed);
+}
+
 bool SpaceInvader::Advance(Unit* _unit)
 {
   if (m_dead)
@@ -191,7 +233,7 @@ bool SpaceInvader::Advance(Unit* _unit)
       int index = g_context->m_location->m_effects.PutData(weapon);
       weapon->m_id.Set(m_id.GetTeamId(), UNIT_EFFECTS, index, -1);
       weapon->m_id.GenerateUniqueId();
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "DropGrenade"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "DropGrenade"));
       m_armed = false;
     }
   }
@@ -30,6 +30,8 @@ class AirstrikeUnit : public Unit
 
     void Begin() override;
     bool Advance(int _slice) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     bool IsInView() override;
 };
@@ -44,5 +46,7 @@ class SpaceInvader : public Entity
     SpaceInvader();
 
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
 };
@@ -54,14 +54,14 @@ void AntHill::Damage(float _damage)
     if (healthBandAfter != healthBandBefore)
     {
       Matrix34 mat(m_front, g_upVector, m_pos);
-      g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f - static_cast<float>(m_health) / 100.0f));
-      g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Damage"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f - static_cast<float>(m_health) / 100.0f));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Damage"));
     }
 
     if (m_health <= 0)
     {
       Matrix34 mat(m_front, g_upVector, m_pos);
-      g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
+      g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
 
       int numSpirits = m_numAntsInside + m_numSpiritsInside;
       for (int i = 0; i < numSpirits; ++i)
@@ -78,7 +78,7 @@ void AntHill::Damage(float _damage)
         g_context->m_location->SpawnSpirit(pos, vel, m_id.GetTeamId(), WorldObjectId());
       }
 
-      g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
       m_health = 0;
     }
   }
@@ -245,6 +245,50 @@ bool AntHill::PopulationLocked()
   return false;
 }
 
+void AntHill::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.WriteCount(m_objectives.Size());
+  for (int i = 0; i < m_objectives.Size(); ++i)
+  {
+    const AntObjective* objective = m_objectives.GetData(i);
+    WriteSnapshotVector(_writer, objective->m_pos);
+    WriteSnapshotId(_writer, objective->m_targetId);
+    _writer.Write(objective->m_numToSend);
+  }
+  WriteSnapshotTime(_writer, m_objectiveTimer);
+  WriteSnapshotTime(_writer, m_spawnTimer);
+  WriteSnapshotTime(_writer, m_eggConvertTimer);
+  _writer.Write(m_health);
+  _writer.Write(m_unitId);
+  _writer.Write(m_populationLock);
+  _writer.Write(m_numAntsInside);
+  _writer.Write(m_numSpiritsInside);
+}
+
+void AntHill::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  m_objectives.EmptyAndDelete();
+  const int numObjectives = _reader.ReadCount();
+  for (int i = 0; i < numObjectives; ++i)
+  {
+    auto objective = new AntObjective();
+    ReadSnapshotVector(_reader, objective->m_pos);
+    ReadSnapshotId(_reader, objective->m_targetId);
+    _reader.Read(objective->m_numToSend);
+    m_objectives.PutDataAtEnd(objective);
+  }
+  ReadSnapshotTime(_reader, m_objectiveTimer);
+  ReadSnapshotTime(_reader, m_spawnTimer);
+  ReadSnapshotTime(_reader, m_eggConvertTimer);
+  _reader.Read(m_health);
+  _reader.Read(m_unitId);
+  _reader.Read(m_populationLock);
+  _reader.Read(m_numAntsInside);
+  _reader.Read(m_numSpiritsInside);
+}
+
 bool AntHill::Advance()
 {
   Building::Advance();
@@ -46,6 +46,8 @@ class AntHill : public Building
     void Initialise(Building* _template) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void Damage(float _damage) override;
     void Destroy(float _intensity) override;
 
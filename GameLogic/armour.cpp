@@ -70,7 +70,7 @@ void Armour::ChangeHealth(int _amount)
   if (!m_dead)
   {
     if (_amount < 0)
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
 
     int oldHealth = m_stats[StatHealth];
     int newHealth = oldHealth + _amount;
@@ -85,13 +85,13 @@ void Armour::ChangeHealth(int _amount)
     {
       float fractionDead = 1.0f - static_cast<float>(newHealth) / EntityBlueprint::GetStat(TypeArmour, StatHealth);
       Matrix34 bodyMat(m_front, m_up, m_pos);
-      g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, bodyMat, fractionDead));
+      g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, bodyMat, fractionDead));
     }
 
     if (newHealth == 0)
     {
       m_dead = true;
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
     }
   }
 }
@@ -114,7 +114,7 @@ void Armour::ConvertToGunTurret()
   //
   // Explode some polys, to cover the ropey change
   Matrix34 bodyMat(m_front, m_up, m_pos);
-  g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, bodyMat, 1.0f));
+  g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, bodyMat, 1.0f));
   turret->ExplodeBody();
 }
 
@@ -223,6 +223,32 @@ void Armour::DetectCollisions()
     m_wayPoint = m_pos + escapeVector * 40.0f;
 }
 
+void Armour::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_up);
+  WriteSnapshotVector(_writer, m_conversionPoint);
+  _writer.Write(m_speed);
+  _writer.Write(m_numPassengers);
+  WriteSnapshotTime(_writer, m_previousUnloadTimer);
+  _writer.Write(m_newOrdersTimer);
+  WriteSnapshotVector(_writer, m_wayPoint);
+  _writer.Write(m_state);
+}
+
+void Armour::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_up);
+  ReadSnapshotVector(_reader, m_conversionPoint);
+  _reader.Read(m_speed);
+  _reader.Read(m_numPassengers);
+  ReadSnapshotTime(_reader, m_previousUnloadTimer);
+  _reader.Read(m_newOrdersTimer);
+  ReadSnapshotVector(_reader, m_wayPoint);
+  _reader.Read(m_state);
+}
+
 bool Armour::Advance(Unit* _unit)
 {
   if (m_dead)
@@ -246,7 +272,7 @@ bool Armour::Advance(Unit* _unit)
     LegacyVector3 pos = m_pos + vel * 2;
     pos.y += 3.0f;
     float size = 50.0f + (syncrand() % 50);
-    g_simEventQueue.Push(SimEvent::MakeParticle(pos, vel, SimParticle::TypeMissileTrail, size));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(pos, vel, SimParticle::TypeMissileTrail, size));
   }
 
   //
@@ -379,7 +405,7 @@ void Armour::AddPassenger()
 {
   ++m_numPassengers;
 
-  g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoadDarwinian"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoadDarwinian"));
 }
 
 void Armour::RemovePassenger()
@@ -387,7 +413,7 @@ void Armour::RemovePassenger()
   --m_numPassengers;
   m_previousUnloadTimer = GetHighResTime();
 
-  g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "UnloadDarwinian"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "UnloadDarwinian"));
 }
 
 void Armour::GetEntrance(LegacyVector3& _exitPos, LegacyVector3& _exitDir)
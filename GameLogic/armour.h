@@ -44,6 +44,8 @@ class Armour : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
 
     void SetOrders(const LegacyVector3& _orders);
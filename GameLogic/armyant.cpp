@@ -60,7 +60,7 @@ void ArmyAnt::ChangeHealth(int _amount)
     transform.f *= m_scale;
     transform.u *= m_scale;
     transform.r *= m_scale;
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
 
     //
     // Drop any spirits we are carrying
@@ -81,6 +81,28 @@ void ArmyAnt::ChangeHealth(int _amount)
   }
 }
 
+void ArmyAnt::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_scale);
+  WriteSnapshotVector(_writer, m_wayPoint);
+  _writer.Write(m_orders);
+  _writer.Write(m_targetFound);
+  _writer.Write(m_spiritId);
+  WriteSnapshotId(_writer, m_targetId);
+}
+
+void ArmyAnt::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_scale);
+  ReadSnapshotVector(_reader, m_wayPoint);
+  _reader.Read(m_orders);
+  _reader.Read(m_targetFound);
+  _reader.Read(m_spiritId);
+  ReadSnapshotId(_reader, m_targetId);
+}
+
 bool ArmyAnt::Advance(Unit* _unit)
 {
   bool amIDead = Entity::Advance(_unit);
@@ -273,9 +295,9 @@ bool ArmyAnt::AdvanceAttackEnemy()
     targetEntity->ChangeHealth(-1);
     for (int i = 0; i < 3; ++i)
     {
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, LegacyVector3(syncsfrand(15.0f), syncsfrand(15.0f) + 15.0f, syncsfrand(15.0f)), SimParticle::TypeMuzzleFlash));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, LegacyVector3(syncsfrand(15.0f), syncsfrand(15.0f) + 15.0f, syncsfrand(15.0f)), SimParticle::TypeMuzzleFlash));
     }
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
   }
 
   return false;
@@ -308,7 +330,7 @@ bool ArmyAnt::AdvanceReturnToBase()
         if (spirit && spirit->m_state == Spirit::StateAttached)
         {
           antHill->m_numSpiritsInside++;
-          g_context->m_location->m_spirits.MarkNotUsed(m_spiritId);
+          g_context->m_location->RemoveSpirit(m_spiritId);
         }
       }
 
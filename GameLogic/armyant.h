@@ -49,6 +49,8 @@ class ArmyAnt : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
 
     void OrderReturnToBase();
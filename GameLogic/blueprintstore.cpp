@@ -36,6 +36,24 @@ void BlueprintBuilding::Initialise(Building* _template)
     m_infected = 0.0f;
 }
 
+void BlueprintBuilding::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_buildingLink);
+  _writer.Write(m_infected);
+  _writer.Write(m_segment);
+  WriteSnapshotVector(_writer, m_vel);
+}
+
+void BlueprintBuilding::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_buildingLink);
+  _reader.Read(m_infected);
+  _reader.Read(m_segment);
+  ReadSnapshotVector(_reader, m_vel);
+}
+
 bool BlueprintBuilding::Advance()
 {
   auto blueprintBuilding = static_cast<BlueprintBuilding*>(g_context->m_location->GetBuilding(m_buildingLink));
@@ -163,6 +181,18 @@ void BlueprintStore::SendBlueprint(int _segment, bool _infected)
   m_segments[_segment] = oldValue;
 }
 
+void BlueprintStore::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  BlueprintBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_segments);
+}
+
+void BlueprintStore::ReadSnapshot(SnapshotReader& _reader)
+{
+  BlueprintBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_segments);
+}
+
 bool BlueprintStore::Advance()
 {
   int fullyInfected = 0;
@@ -359,6 +389,18 @@ void BlueprintRelay::SetDetail([[maybe_unused]] int _detail)
   m_radius = m_shape->CalculateRadius(mat, m_centerPos);
 }
 
+void BlueprintRelay::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  BlueprintBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_altitude);
+}
+
+void BlueprintRelay::ReadSnapshot(SnapshotReader& _reader)
+{
+  BlueprintBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_altitude);
+}
+
 bool BlueprintRelay::Advance()
 {
   float ourTime = g_gameTime + m_id.GetUniqueId() + m_id.GetIndex();
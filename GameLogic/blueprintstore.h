@@ -21,6 +21,8 @@ public:
 
     void Initialise( Building *_template );
     bool Advance();
+    void WriteSnapshot( SnapshotWriter &_writer ) const;
+    void ReadSnapshot( SnapshotReader &_reader );
     bool IsInView();
 
     virtual void SendBlueprint( int _segment, bool _infected );
@@ -51,6 +53,8 @@ public:
 
     void Initialise     ( Building *_template );
     bool Advance        ();
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
     void SendBlueprint  ( int _segment, bool _infected );
 
     const char* GetObjectiveCounter();
@@ -93,6 +97,8 @@ public:
     void SetDetail( int _detail );
 
     bool Advance();
+    void WriteSnapshot( SnapshotWriter &_writer ) const;
+    void ReadSnapshot( SnapshotReader &_reader );
 
     void Read   ( TextReader *_in, bool _dynamic );
     void Write  ( FileWriter *_out );
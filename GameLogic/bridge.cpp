@@ -47,6 +47,24 @@ void Bridge::SetBridgeType(int _type)
   DEBUG_ASSERT(m_signal);
 }
 
+void Bridge::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Teleport::WriteSnapshot(_writer);
+  _writer.Write(m_bridgeType);
+  _writer.Write(m_nextBridgeId);
+  _writer.Write(m_status);
+  _writer.Write(m_beingOperated);
+}
+
+void Bridge::ReadSnapshot(SnapshotReader& _reader)
+{
+  Teleport::ReadSnapshot(_reader);
+  _reader.Read(m_bridgeType);
+  _reader.Read(m_nextBridgeId);
+  _reader.Read(m_status);
+  _reader.Read(m_beingOperated);
+}
+
 bool Bridge::Advance()
 {
   if (m_status < 0.0f)
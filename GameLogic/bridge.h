@@ -32,6 +32,8 @@ public:
     void SetBridgeType  ( int _type );
 
     bool Advance        ();
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
 
     bool GetAvailablePosition   ( LegacyVector3 &_pos, LegacyVector3 &_front );                     // Finds place for engineer
     void BeginOperation         ();
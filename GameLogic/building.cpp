@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "building.h"
+#include "SyncChecksum.h"
 #include "GameContext.h"
 #include "ai.h"
 #include "anthill.h"
@@ -64,6 +65,8 @@ Building::Building()
     m_isGlobal(false),
     m_radius(13.0f),
     m_destroyed(false),
+    m_sleepTicks(0),
+    m_dormantSlot(-1),
     m_shape(nullptr)
 {
   std::call_once(s_controlPadOnce, []()
@@ -110,7 +113,7 @@ void Building::Initialise(Building* _template)
   if (gb)
     m_id.SetTeamId(gb->m_teamId);
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Create"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Create"));
 }
 
 void Building::SetDetail([[maybe_unused]] int _detail)
@@ -133,6 +136,61 @@ void Building::SetDetail([[maybe_unused]] int _detail)
   }
 }
 
+// *** GetSyncHash
+uint64_t Building::GetSyncHash() const
+{
+  SyncHasher hasher(WorldObject::GetSyncHash());
+  hasher.Fold(m_destroyed);
+  return hasher.Value();
+}
+
+// *** WriteSnapshot
+void Building::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_front);
+  WriteSnapshotVector(_writer, m_up);
+  _writer.Write(m_timeOfDeath);
+  _writer.Write(m_destroyed);
+
+  _writer.WriteVarUInt(static_cast<uint32_t>(m_ports.Size()));
+  for (int i = 0; i < m_ports.Size(); ++i)
+  {
+    const BuildingPort* port = m_ports[i];
+    WriteSnapshotId(_writer, port->m_occupant);
+    _writer.Write(port->m_counter);
+  }
+}
+
+// *** ReadSnapshot
+// Shape, lights and ports come from Initialise; only the runtime state is read
+void Building::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_front);
+  ReadSnapshotVector(_reader, m_up);
+  _reader.Read(m_timeOfDeath);
+  _reader.Read(m_destroyed);
+  m_sleepTicks = 0;
+  m_dormantSlot = -1; // Location wakes everything after a snapshot
+
+  int numPorts = static_cast<int>(_reader.ReadVarUInt());
+  for (int i = 0; i < numPorts; ++i)
+  {
+    WorldObjectId occupant;
+    int counter[NUM_TEAMS];
+    ReadSnapshotId(_reader, occupant);
+    _reader.Read(counter);
+
+    if (m_ports.ValidIndex(i))
+    {
+      BuildingPort* port = m_ports[i];
+      port->m_occupant = occupant;
+      memcpy(port->m_counter, counter, sizeof(counter));
+    }
+  }
+}
+
 bool Building::Advance()
 {
   if (m_destroyed)
@@ -142,6 +200,16 @@ bool Building::Advance()
   return false;
 }
 
+void Building::Wake()
+{
+  if (m_dormantSlot != -1)
+  {
+    g_context->m_location->WakeBuilding(m_dormantSlot);
+    m_dormantSlot = -1;
+  }
+  m_sleepTicks = 0;
+}
+
 void Building::SetShape(ShapeStatic* _shape) { m_shape = _shape; }
 
 void Building::SetShapeLights(const ShapeFragmentData* _fragment)
@@ -209,7 +277,8 @@ void Building::Reprogram([[maybe_unused]] float _complete) {}
 
 void Building::ReprogramComplete()
 {
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ReprogramComplete"));
+  Wake();
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ReprogramComplete"));
 
   GlobalBuilding* gb = g_context->m_globalWorld->GetBuilding(m_id.GetUniqueId(), g_context->m_locationId);
   if (gb)
@@ -220,13 +289,14 @@ void Building::ReprogramComplete()
 
 void Building::SetTeamId(int _teamId)
 {
+  Wake();
   m_id.SetTeamId(_teamId);
 
   GlobalBuilding* gb = g_context->m_globalWorld->GetBuilding(m_id.GetUniqueId(), g_context->m_locationId);
   if (gb)
     gb->m_teamId = _teamId;
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ChangeTeam"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ChangeTeam"));
 }
 
 LegacyVector3 Building::PushFromBuilding(const LegacyVector3& pos, float _radius)
@@ -301,18 +371,23 @@ void Building::EvaluatePorts()
   }
 }
 
-void Building::Damage([[maybe_unused]] float _damage) { g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Damage")); }
+void Building::Damage([[maybe_unused]] float _damage)
+{
+  Wake();
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Damage"));
+}
 
 void Building::Destroy(float _intensity)
 {
+  Wake();
   m_destroyed = true;
 
   Matrix34 mat(m_front, g_upVector, m_pos);
   for (int i = 0; i < 3; ++i)
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
   g_context->m_location->Bang(m_pos, _intensity, _intensity / 4.0f);
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
 
   for (int i = 0; i < static_cast<int>(_intensity / 4.0f); ++i)
   {
@@ -320,7 +395,7 @@ void Building::Destroy(float _intensity)
     vel.x += syncsfrand(100.0f);
     vel.y += syncsfrand(100.0f);
     vel.z += syncsfrand(100.0f);
-    g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeExplosionCore, 100.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeExplosionCore, 100.0f));
   }
 }
 
@@ -401,6 +476,7 @@ bool Building::GetPortPosition(int _portId, LegacyVector3& _pos, LegacyVector3&
 
 void Building::OperatePort(int _portId, int _teamId)
 {
+  Wake();
   if (m_ports.ValidIndex(_portId))
   {
     BuildingPort* port = m_ports[_portId];
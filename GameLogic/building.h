@@ -95,6 +95,9 @@ class Building : public WorldObject
 
     bool m_destroyed; // Building has been destroyed using the script command DestroyBuilding, remove it next Advance
 
+    int m_sleepTicks; // Set by Sleep() during Advance, picked up by Location::AdvanceBuildings
+    int m_dormantSlot; // Index in Location::m_buildings while dormant, otherwise -1
+
     ShapeStatic* m_shape;
     LList<ShapeMarkerData*> m_lights; // Ownership lights
     LList<BuildingPort*> m_ports; // Require Darwinians in them to operate
@@ -106,6 +109,9 @@ class Building : public WorldObject
 
     virtual void Initialise(Building* _template);
     bool Advance() override;
+    uint64_t GetSyncHash() const override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     virtual void SetShape(ShapeStatic* _shape);
     void SetShapeLights(const ShapeFragmentData* _fragment); // Recursivly search for lights
@@ -117,6 +123,16 @@ class Building : public WorldObject
 
     virtual bool PerformDepthSort(LegacyVector3& _centerPos); // Return true if you plan to use transparencies
 
+    // A building whose Advance has nothing left to do may call Sleep() from
+    // it; Location then skips it for _ticks server ticks (-1 = until woken).
+    // Anything that gives it work again must call Wake().  While asleep its
+    // Advance may change nothing that reaches the sync report, so late
+    // joiners (who start with everything awake) stay in sync.  Cosmetic
+    // work, like a Tree's falling leaves, may differ.
+    void Sleep(int _ticks = -1) { m_sleepTicks = _ticks; }
+    void Wake();
+    bool IsDormant() const { return m_dormantSlot != -1; }
+
     virtual void SetTeamId(int _teamId);
     virtual void Reprogram(float _complete);
     virtual void ReprogramComplete();
@@ -26,6 +26,24 @@ Cave::Cave()
   DEBUG_ASSERT(m_spawnPoint);
 }
 
+void Cave::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_troopType);
+  _writer.Write(m_unitId);
+  _writer.Write(m_spawnTimer);
+  _writer.Write(m_dead);
+}
+
+void Cave::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_troopType);
+  _reader.Read(m_unitId);
+  _reader.Read(m_spawnTimer);
+  _reader.Read(m_dead);
+}
+
 bool Cave::Advance()
 {
   if (m_dead)
@@ -64,7 +82,7 @@ void Cave::Damage(float _damage)
   if (_damage > 80.0f)
   {
     Matrix34 mat(m_front, g_upVector, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
     m_dead = true;
   }
 }
@@ -19,6 +19,8 @@ public:
     Cave();
 
     bool Advance();
+    void WriteSnapshot( SnapshotWriter &_writer ) const;
+    void ReadSnapshot( SnapshotReader &_reader );
     void Damage( float _damage );
 };
 
@@ -116,7 +116,7 @@ void Centipede::ChangeHealth(int _amount)
     transform.u *= m_size;
     transform.r *= m_size;
 
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
 
     auto next = static_cast<Centipede*>(g_context->m_location->GetEntitySafe(m_next, TypeCentipede));
     if (next)
@@ -130,7 +130,7 @@ void Centipede::ChangeHealth(int _amount)
 void Centipede::Panic(float _time)
 {
   if (m_panic <= 0.0f)
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Panic"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Panic"));
 
   m_panic = std::max(_time, m_panic);
 
@@ -144,6 +144,34 @@ void Centipede::Panic(float _time)
   }
 }
 
+void Centipede::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_size);
+  WriteSnapshotId(_writer, m_next);
+  WriteSnapshotId(_writer, m_prev);
+  WriteSnapshotVector(_writer, m_targetPos);
+  WriteSnapshotId(_writer, m_targetEntity);
+  WriteSnapshotHistory(_writer, m_positionHistory);
+  _writer.Write(m_linked);
+  _writer.Write(m_panic);
+  _writer.Write(m_numSpiritsEaten);
+}
+
+void Centipede::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_size);
+  ReadSnapshotId(_reader, m_next);
+  ReadSnapshotId(_reader, m_prev);
+  ReadSnapshotVector(_reader, m_targetPos);
+  ReadSnapshotId(_reader, m_targetEntity);
+  ReadSnapshotHistory(_reader, m_positionHistory);
+  _reader.Read(m_linked);
+  _reader.Read(m_panic);
+  _reader.Read(m_numSpiritsEaten);
+}
+
 bool Centipede::Advance(Unit* _unit)
 {
   ASSERT_TEXT(_unit, "Centipedes must be created in a unit");
@@ -291,7 +319,7 @@ void Centipede::Attack(const LegacyVector3& _pos)
     float distance = pushVector.Mag();
     if (distance < m_radius)
     {
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
 
       pushVector.SetLength(m_radius - distance);
 
@@ -344,7 +372,7 @@ void Centipede::EatSpirits()
     if (syncfrand(1.0f) < eatChance)
     {
       int eatenIndex = m_eaten[i];
-      g_context->m_location->m_spirits.MarkNotUsed(eatenIndex);
+      g_context->m_location->RemoveSpirit(eatenIndex);
       ++m_numSpiritsEaten;
       break;
     }
@@ -393,7 +421,7 @@ void Centipede::EatSpirits()
       centipede->Begin();
 
       g_context->m_location->m_entityGrid->AddObject(centipede->m_id, centipede->m_pos.x, centipede->m_pos.z, centipede->m_radius);
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Grow"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Grow"));
 
       tail = centipede;
       m_numSpiritsEaten -= CENTIPEDE_NUMSPIRITSTOREGROW;
@@ -451,7 +479,7 @@ bool Centipede::SearchForTargetEnemy()
   if (targetId.IsValid())
   {
     m_targetEntity = targetId;
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnemySighted"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnemySighted"));
     return true;
   }
   m_targetEntity.SetInvalid();
@@ -524,21 +552,17 @@ bool Centipede::SearchForRandomPosition()
 
 void Centipede::RecordHistoryPosition()
 {
-  m_positionHistory.PutDataAtStart(m_pos);
-
-  int maxHistorys = 3;
-
-  for (int i = maxHistorys; i < m_positionHistory.Size(); ++i)
-    m_positionHistory.RemoveData(i);
+  m_positionHistory.Push(m_pos);
+  m_positionHistory.Truncate(CENTIPEDE_HISTORYSIZE);
 }
 
 bool Centipede::GetTrailPosition(LegacyVector3& _pos, LegacyVector3& _vel, int _numSteps)
 {
-  if (m_positionHistory.Size() < 3)
+  if (m_positionHistory.Size() < CENTIPEDE_HISTORYSIZE)
     return false;
 
-  LegacyVector3 pos1 = *m_positionHistory.GetPointer(_numSteps + 1);
-  LegacyVector3 pos2 = *m_positionHistory.GetPointer(_numSteps);
+  const LegacyVector3& pos1 = m_positionHistory[_numSteps + 1];
+  const LegacyVector3& pos2 = m_positionHistory[_numSteps];
   _pos = pos1 + (pos2 - pos1) * (1.0f - m_size);
   _vel = (pos2 - pos1) / SERVER_ADVANCE_PERIOD;
 
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "entity.h"
+#include "HistoryRing.h"
 
 #define CENTIPEDE_MINSEARCHRANGE        75.0f
 #define CENTIPEDE_MAXSEARCHRANGE        150.0f
 #define CENTIPEDE_SPIRITEATRANGE        10.0f
 #define CENTIPEDE_NUMSPIRITSTOREGROW    4
 #define CENTIPEDE_MAXSIZE               20
+#define CENTIPEDE_HISTORYSIZE           3
 
 class ShapeStatic;
 
@@ -24,7 +26,7 @@ class Centipede : public Entity
     LegacyVector3 m_targetPos;
     WorldObjectId m_targetEntity;
 
-    LList<LegacyVector3> m_positionHistory;
+    Neuron::HistoryRing<LegacyVector3, 4> m_positionHistory; // Newest first, CENTIPEDE_HISTORYSIZE long
     bool m_linked;
     float m_panic;
     int m_numSpiritsEaten;
@@ -50,6 +52,8 @@ class Centipede : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
 
     bool IsInView() override;
@@ -43,6 +43,28 @@ ConstructionYard::ConstructionYard()
   }
 }
 
+void ConstructionYard::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_numPrimitives);
+  _writer.Write(m_numSurges);
+  _writer.Write(m_numTanksProduced);
+  _writer.Write(m_fractionPopulated);
+  _writer.Write(m_timer);
+  _writer.Write(m_alpha);
+}
+
+void ConstructionYard::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_numPrimitives);
+  _reader.Read(m_numSurges);
+  _reader.Read(m_numTanksProduced);
+  _reader.Read(m_fractionPopulated);
+  _reader.Read(m_timer);
+  _reader.Read(m_alpha);
+}
+
 bool ConstructionYard::Advance()
 {
   m_fractionPopulated = static_cast<float>(GetNumPortsOccupied()) / static_cast<float>(GetNumPorts());
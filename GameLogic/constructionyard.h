@@ -35,6 +35,8 @@ public:
     ConstructionYard();
 
     bool Advance();
+    void WriteSnapshot(SnapshotWriter& _writer) const;
+    void ReadSnapshot(SnapshotReader& _reader);
 
     Matrix34 GetRungMatrix1();
     Matrix34 GetRungMatrix2();
@@ -53,6 +53,24 @@ void ControlTower::Initialise(Building* _template)
   m_controlBuildingId = static_cast<ControlTower*>(_template)->m_controlBuildingId;
 }
 
+void ControlTower::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_ownership);
+  _writer.Write(m_beingReprogrammed);
+  _writer.Write(m_controlBuildingId);
+  _writer.Write(m_checkTargetTimer);
+}
+
+void ControlTower::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_ownership);
+  _reader.Read(m_beingReprogrammed);
+  _reader.Read(m_controlBuildingId);
+  _reader.Read(m_checkTargetTimer);
+}
+
 bool ControlTower::Advance()
 {
   //
@@ -110,7 +128,7 @@ bool ControlTower::Advance()
       Matrix34 worldMat = m_shape->GetMarkerWorldMatrix(m_console[i], rootMat);
       LegacyVector3 particleVel = worldMat.pos - m_pos;
       particleVel += LegacyVector3(sfrand() * 10.0f, sfrand() * 5.0f, sfrand() * 10.0f);
-      g_simEventQueue.Push(SimEvent::MakeParticle(worldMat.pos, particleVel, SimParticle::TypeBlueSpark));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(worldMat.pos, particleVel, SimParticle::TypeBlueSpark));
     }
   }
 
@@ -182,7 +200,7 @@ bool ControlTower::Reprogram(int _teamId)
 
         if (m_ownership == 100.0f)
         {
-          g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ReprogramComplete"));
+          g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ReprogramComplete"));
           //g_context->m_sepulveda
           targetBuilding->ReprogramComplete();
           SetTeamId(_teamId);
@@ -31,6 +31,8 @@ class ControlTower : public Building
     void Initialise(Building* _template) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     bool IsInView() override;
 
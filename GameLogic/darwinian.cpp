@@ -153,6 +153,62 @@ bool Darwinian::SearchForNewTask()
   return newTargetFound;
 }
 
+void Darwinian::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  _writer.Write(m_promoted);
+  WriteSnapshotVector(_writer, m_wayPoint);
+  _writer.Write(m_retargetTimer);
+  WriteSnapshotId(_writer, m_threatId);
+  WriteSnapshotId(_writer, m_armourId);
+  WriteSnapshotId(_writer, m_officerId);
+  _writer.Write(m_spiritId);
+  _writer.Write(m_buildingId);
+  _writer.Write(m_portId);
+  WriteSnapshotId(_writer, m_boxKiteId);
+  _writer.Write(m_threatRange);
+  _writer.Write(m_scared);
+  _writer.Write(m_controllerId);
+  _writer.Write(m_wayPointId);
+  _writer.Write(m_teleportRequired);
+  WriteSnapshotVector(_writer, m_orders);
+  _writer.Write(m_ordersBuildingId);
+  _writer.Write(m_ordersSet);
+  _writer.Write(m_grenadeTimer);
+  _writer.Write(m_officerTimer);
+  _writer.Write(m_shadowBuildingId);
+  WriteSnapshotVector(_writer, m_avoidObstruction);
+}
+
+void Darwinian::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  _reader.Read(m_promoted);
+  ReadSnapshotVector(_reader, m_wayPoint);
+  _reader.Read(m_retargetTimer);
+  ReadSnapshotId(_reader, m_threatId);
+  ReadSnapshotId(_reader, m_armourId);
+  ReadSnapshotId(_reader, m_officerId);
+  _reader.Read(m_spiritId);
+  _reader.Read(m_buildingId);
+  _reader.Read(m_portId);
+  ReadSnapshotId(_reader, m_boxKiteId);
+  _reader.Read(m_threatRange);
+  _reader.Read(m_scared);
+  _reader.Read(m_controllerId);
+  _reader.Read(m_wayPointId);
+  _reader.Read(m_teleportRequired);
+  ReadSnapshotVector(_reader, m_orders);
+  _reader.Read(m_ordersBuildingId);
+  _reader.Read(m_ordersSet);
+  _reader.Read(m_grenadeTimer);
+  _reader.Read(m_officerTimer);
+  _reader.Read(m_shadowBuildingId);
+  ReadSnapshotVector(_reader, m_avoidObstruction);
+}
+
 bool Darwinian::Advance(Unit* _unit)
 {
   if (m_promoted)
@@ -482,7 +538,7 @@ bool Darwinian::AdvanceCombat()
   {
     m_state = StateIdle;
     m_retargetTimer = 0.0;
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
     END_PROFILE(g_context->m_profiler, "AdvanceCombat");
     return false;
   }
@@ -498,7 +554,7 @@ bool Darwinian::AdvanceCombat()
     {
       m_state = StateIdle;
       m_retargetTimer = 0.0;
-      g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
       END_PROFILE(g_context->m_profiler, "AdvanceCombat");
       return false;
     }
@@ -785,7 +841,7 @@ bool Darwinian::AdvanceUnderControl()
   //
   // Try to lookup our controller
 
-  Task* task = g_context->m_taskManager->GetTask(m_controllerId);
+  Task* task = g_context->m_taskManager ? g_context->m_taskManager->GetTask(m_controllerId) : nullptr;
   Unit* controller = nullptr;
   if (task)
     controller = g_context->m_location->GetUnit(task->m_objId);
@@ -797,10 +853,10 @@ bool Darwinian::AdvanceUnderControl()
     for (int i = 0; i < numFlashes; ++i)
     {
       LegacyVector3 vel(sfrand(5.0f), frand(15.0f), sfrand(5.0f));
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeControlFlash));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeControlFlash));
     }
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EscapedControl"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EscapedControl"));
     return false;
   }
 
@@ -1284,7 +1340,7 @@ bool Darwinian::SearchForOfficers()
         m_wayPoint = PushFromObstructions(m_wayPoint, false);
         m_wayPoint.y = g_context->m_location->m_landscape.m_heightMap->GetValue(m_wayPoint.x, m_wayPoint.z);
 
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "GivenOrders"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "GivenOrders"));
 
         m_state = StateFollowingOrders;
         END_PROFILE(g_context->m_profiler, "SearchOfficers");
@@ -1371,7 +1427,7 @@ void Darwinian::GiveOrders(const LegacyVector3& _targetPos)
   m_wayPoint.y = g_context->m_location->m_landscape.m_heightMap->GetValue(m_wayPoint.x, m_wayPoint.z);
   m_wayPoint = PushFromObstructions(m_wayPoint);
 
-  g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "GivenOrders"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "GivenOrders"));
 
   m_state = StateFollowingOrders;
 }
@@ -1480,7 +1536,7 @@ bool Darwinian::SearchForThreats()
     m_scared = true;
     if (m_threatId != threatId)
     {
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SeenThreatRunAway"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SeenThreatRunAway"));
       m_threatId = threatId;
     }
     END_PROFILE(g_context->m_profiler, "SearchThreats");
@@ -1570,9 +1626,9 @@ bool Darwinian::SearchForThreats()
     if (m_threatId != threatId)
     {
       if (m_scared)
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SeenThreatRunAway"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SeenThreatRunAway"));
       else
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SeenThreatAttack"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SeenThreatAttack"));
       m_threatId = threatId;
     }
 
@@ -1588,7 +1644,7 @@ bool Darwinian::SearchForThreats()
   }
   // There are no nearby threats
   m_threatId.SetInvalid();
-  g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
 
   END_PROFILE(g_context->m_profiler, "SearchThreats");
   return false;
@@ -1685,7 +1741,7 @@ bool Darwinian::BeginVictoryDance()
       // jump!
       m_vel.y += 15.0f + syncfrand(15.0f);
       m_onGround = false;
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "VictoryJump"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "VictoryJump"));
       return true;
     }
   }
@@ -1884,7 +1940,7 @@ LegacyVector3 Darwinian::PushFromObstructions(const LegacyVector3& pos, bool kil
 
 void Darwinian::TakeControl(int _controllerId)
 {
-  Task* controller = g_context->m_taskManager->GetTask(_controllerId);
+  Task* controller = g_context->m_taskManager ? g_context->m_taskManager->GetTask(_controllerId) : nullptr;
   if (controller)
   {
     m_controllerId = _controllerId;
@@ -1900,10 +1956,10 @@ void Darwinian::TakeControl(int _controllerId)
     for (int i = 0; i < numFlashes; ++i)
     {
       LegacyVector3 vel(sfrand(5.0f), frand(15.0f), sfrand(5.0f));
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeControlFlash));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeControlFlash));
     }
 
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "TakenControl"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "TakenControl"));
   }
 }
 
@@ -1934,11 +1990,11 @@ bool Darwinian::AdvanceOnFire()
     int particleType = SimParticle::TypeDarwinianFire;
     if (i > 4)
       particleType = SimParticle::TypeMissileTrail;
-    g_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, fireVel, particleType, fireSize));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, fireVel, particleType, fireSize));
   }
 
   if (syncrand() % 50 == 0)
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "OnFire"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "OnFire"));
 
   if (!m_dead && syncfrand(10) < 2 && m_onGround)
     ChangeHealth(-2);
@@ -1970,6 +2026,30 @@ BoxKite::BoxKite()
   m_up = g_upVector;
 }
 
+void BoxKite::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_front);
+  WriteSnapshotVector(_writer, m_up);
+  _writer.Write(m_state);
+  WriteSnapshotTime(_writer, m_birthTime);
+  WriteSnapshotTime(_writer, m_deathTime);
+  _writer.Write(m_brightness);
+  _writer.Write(m_size);
+}
+
+void BoxKite::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_front);
+  ReadSnapshotVector(_reader, m_up);
+  _reader.Read(m_state);
+  ReadSnapshotTime(_reader, m_birthTime);
+  ReadSnapshotTime(_reader, m_deathTime);
+  _reader.Read(m_brightness);
+  _reader.Read(m_size);
+}
+
 bool BoxKite::Advance()
 {
   if (m_state == StateReleased)
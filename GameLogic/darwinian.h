@@ -101,6 +101,8 @@ class Darwinian : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
     bool IsInView() override;
 
@@ -139,5 +141,7 @@ class BoxKite : public WorldObject
 
     BoxKite();
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void Release();
 };
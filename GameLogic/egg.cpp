@@ -28,6 +28,22 @@ void Egg::ChangeHealth(int amount)
   }
 }
 
+void Egg::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  _writer.Write(m_spiritId);
+  _writer.Write(m_timer);
+}
+
+void Egg::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  _reader.Read(m_spiritId);
+  _reader.Read(m_timer);
+}
+
 bool Egg::Advance(Unit* _unit)
 {
   if (g_context->m_location->m_spirits.ValidIndex(m_spiritId))
@@ -44,7 +60,7 @@ bool Egg::Advance(Unit* _unit)
 
       if (m_timer >= 15.0f)
       {
-        g_context->m_location->m_spirits.MarkNotUsed(m_spiritId);
+        g_context->m_location->RemoveSpirit(m_spiritId);
         g_context->m_location->SpawnEntities(m_pos, m_id.GetTeamId(), -1, TypeVirii, 4, g_zeroVector, 0.0f, 200.0f);
         return true;
       }
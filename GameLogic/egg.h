@@ -27,6 +27,8 @@ public:
     void ChangeHealth   ( int amount );
 
     bool Advance        ( Unit *_unit );
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
     void Fertilise      ( int spiritId );
 };
 
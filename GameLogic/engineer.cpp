@@ -226,20 +226,20 @@ void Engineer::ChangeHealth(int amount)
     int healthBandBefore = static_cast<int>(m_stats[StatHealth] / 50.0f);
 
     if (amount < 0)
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
 
     if (m_stats[StatHealth] + amount < 0)
     {
       m_stats[StatHealth] = 0;
       m_dead = true;
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
     }
     else if (m_stats[StatHealth] + amount > 255)
       m_stats[StatHealth] = 255;
     else
     {
       m_stats[StatHealth] += amount;
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash));
     }
 
     int healthBandAfter = static_cast<int>(m_stats[StatHealth] / 50.0f);
@@ -251,11 +251,54 @@ void Engineer::ChangeHealth(int amount)
     if (fractionDead == 1.0f || healthBandAfter < healthBandBefore)
     {
       Matrix34 transform(m_front, g_upVector, m_pos);
-      g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
+      g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
     }
   }
 }
 
+void Engineer::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  WriteSnapshotVector(_writer, m_wayPoint);
+  _writer.Write(m_hoverHeight);
+  _writer.Write(m_idleRotateRate);
+  WriteSnapshotVector(_writer, m_targetPos);
+  WriteSnapshotVector(_writer, m_targetFront);
+  _writer.Write(m_retargetTimer);
+  WriteSnapshotList(_writer, m_spirits);
+  _writer.Write(m_spiritId);
+  _writer.Write(m_positionId);
+  _writer.Write(m_bridgeId);
+  _writer.WriteCount(m_positionHistory.Size());
+  for (int i = 0; i < m_positionHistory.Size(); ++i)
+    WriteSnapshotVector(_writer, *m_positionHistory.GetData(i));
+}
+
+void Engineer::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  ReadSnapshotVector(_reader, m_wayPoint);
+  _reader.Read(m_hoverHeight);
+  _reader.Read(m_idleRotateRate);
+  ReadSnapshotVector(_reader, m_targetPos);
+  ReadSnapshotVector(_reader, m_targetFront);
+  _reader.Read(m_retargetTimer);
+  ReadSnapshotList(_reader, m_spirits);
+  _reader.Read(m_spiritId);
+  _reader.Read(m_positionId);
+  _reader.Read(m_bridgeId);
+  m_positionHistory.EmptyAndDelete();
+  const int numPositions = _reader.ReadCount();
+  for (int i = 0; i < numPositions; ++i)
+  {
+    auto position = new LegacyVector3;
+    ReadSnapshotVector(_reader, *position);
+    m_positionHistory.PutDataAtEnd(position);
+  }
+}
+
 bool Engineer::Advance(Unit* _unit)
 {
   bool amIDead = false;
@@ -320,16 +363,16 @@ bool Engineer::Advance(Unit* _unit)
       if (ct)
       {
         ct->EndReprogram(m_positionId);
-        g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
       }
     }
 
     // If I was researching something, stop now
     if (m_state == StateResearching)
     {
-      g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
     }
 
     // If I was operating a bridge, stop now
@@ -388,8 +431,8 @@ bool Engineer::Advance(Unit* _unit)
     auto ct = static_cast<ControlTower*>(building);
     ct->EndReprogram(m_positionId);
     m_positionId = -1;
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
   }
 
   if (building && building->m_type == Building::TypeBridge && m_state != StateOperatingBridge)
@@ -402,7 +445,7 @@ bool Engineer::Advance(Unit* _unit)
   if (building && building->m_type == Building::TypeResearchItem && m_state != StateResearching)
   {
     // We've been moved away from researching a research item
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
   }
 
   //
@@ -623,7 +666,7 @@ bool Engineer::AdvanceToIncubator()
     {
       Spirit* s = g_context->m_location->m_spirits.GetPointer(spiritId);
       incubator->AddSpirit(s);
-      g_context->m_location->m_spirits.MarkNotUsed(spiritId);
+      g_context->m_location->RemoveSpirit(spiritId);
       m_spirits.RemoveData(0);
     }
 
@@ -667,7 +710,7 @@ bool Engineer::AdvanceToControlTower()
     {
       m_positionId = positionId;
       ct->BeginReprogram(m_positionId);
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "BeginReprogramming"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "BeginReprogramming"));
       m_state = StateReprogramming;
     }
   }
@@ -685,7 +728,7 @@ bool Engineer::AdvanceResearching()
   auto item = static_cast<ResearchItem*>(g_context->m_location->GetBuilding(m_buildingId));
   if (!item || item->m_type != Building::TypeResearchItem || !item->NeedsReprogram())
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
 
     m_buildingId = -1;
     m_state = StateIdle;
@@ -699,8 +742,8 @@ bool Engineer::AdvanceResearching()
 
   if (amIDone)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ReprogrammingComplete"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ReprogrammingComplete"));
     m_buildingId = -1;
     m_state = StateIdle;
     return false;
@@ -720,7 +763,7 @@ bool Engineer::AdvanceResearching()
   {
     LegacyVector3 particleVel = m_pos - toPos;
     particleVel += LegacyVector3(sfrand() * 15.0f, frand() * 10.0f, sfrand() * 15.0f);
-    g_simEventQueue.Push(SimEvent::MakeParticle(toPos, particleVel, SimParticle::TypeBlueSpark));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(toPos, particleVel, SimParticle::TypeBlueSpark));
   }
 
   //
@@ -750,7 +793,7 @@ bool Engineer::AdvanceReprogramming()
   if (!building)
   {
     m_state = StateIdle;
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EndReprogramming"));
     return false;
   }
 
@@ -761,8 +804,8 @@ bool Engineer::AdvanceReprogramming()
     bool finished = ct->Reprogram(m_id.GetTeamId());
     if (finished)
     {
-      g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ReprogrammingComplete"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ReprogrammingComplete"));
       ct->EndReprogram(m_positionId);
       m_buildingId = -1;
       m_positionId = -1;
@@ -924,7 +967,7 @@ bool Engineer::AdvanceToResearchItem()
   bool arrived = AdvanceToTargetPos();
   if (arrived)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "BeginReprogramming"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "BeginReprogramming"));
     m_state = StateResearching;
   }
 
@@ -80,6 +80,8 @@ class Engineer : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void BeginBridge(LegacyVector3 _to);
     void EndBridge();
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "entity.h"
+#include "SyncChecksum.h"
 #include "GameContext.h"
 #include "ai.h"
 #include "airstrike.h"
@@ -125,13 +126,13 @@ void Entity::ChangeHealth(int amount)
   if (!m_dead)
   {
     if (amount < 0)
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
 
     if (m_stats[StatHealth] + amount <= 0)
     {
       m_stats[StatHealth] = 100;
       m_dead = true;
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
       g_context->m_location->SpawnSpirit(m_pos, m_vel * 0.5f, m_id.GetTeamId(), m_id);
     }
     else if (m_stats[StatHealth] + amount > 255)
@@ -154,10 +155,60 @@ void Entity::Attack(const LegacyVector3& pos)
     m_reloading = m_stats[StatRate];
     m_justFired = true;
 
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
   }
 }
 
+// *** GetSyncHash
+uint64_t Entity::GetSyncHash() const
+{
+  SyncHasher hasher(WorldObject::GetSyncHash());
+  for (int i = 0; i < NumStats; ++i)
+    hasher.Fold(static_cast<unsigned int>(m_stats[i]));
+  hasher.Fold(m_dead).Fold(m_reloading).Fold(m_routeId).Fold(m_routeWayPointId);
+  return hasher.Value();
+}
+
+// *** WriteSnapshot
+void Entity::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_formationIndex);
+  _writer.Write(m_buildingId);
+  WriteSnapshotVector(_writer, m_spawnPoint);
+  _writer.Write(m_roamRange);
+  _writer.Write(m_stats);
+  _writer.Write(m_dead);
+  _writer.Write(m_justFired);
+  _writer.Write(m_reloading);
+  _writer.Write(m_inWater);
+  WriteSnapshotVector(_writer, m_front);
+  WriteSnapshotVector(_writer, m_angVel);
+  _writer.Write(m_routeId);
+  _writer.Write(m_routeWayPointId);
+  _writer.Write(m_routeTriggerDistance);
+}
+
+// *** ReadSnapshot
+void Entity::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_formationIndex);
+  _reader.Read(m_buildingId);
+  ReadSnapshotVector(_reader, m_spawnPoint);
+  _reader.Read(m_roamRange);
+  _reader.Read(m_stats);
+  _reader.Read(m_dead);
+  _reader.Read(m_justFired);
+  _reader.Read(m_reloading);
+  _reader.Read(m_inWater);
+  ReadSnapshotVector(_reader, m_front);
+  ReadSnapshotVector(_reader, m_angVel);
+  _reader.Read(m_routeId);
+  _reader.Read(m_routeWayPointId);
+  _reader.Read(m_routeTriggerDistance);
+}
+
 bool Entity::AdvanceDead([[maybe_unused]] Unit* _unit)
 {
   int newHealth = m_stats[StatHealth];
@@ -202,7 +253,7 @@ int Entity::EnterTeleports(int _requiredId)
       {
         WorldObjectId id(m_id);
         radarDish->EnterTeleport(id);
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnterTeleport"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnterTeleport"));
         return buildingId;
       }
     }
@@ -217,7 +268,7 @@ int Entity::EnterTeleports(int _requiredId)
         {
           WorldObjectId id(m_id);
           bridge->EnterTeleport(id);
-          g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnterTeleport"));
+          g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnterTeleport"));
           return buildingId;
         }
       }
@@ -288,7 +339,7 @@ void Entity::AdvanceInWater(Unit* _unit)
 
 void Entity::Begin()
 {
-  g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Create"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Create"));
 
   if (m_shape)
   {
@@ -552,7 +603,8 @@ Entity* Entity::NewEntity(int _troopType)
   default: DEBUG_ASSERT(false);
   }
 
-  entity->m_id.GenerateUniqueId();
+  if (entity)
+    entity->m_id.GenerateUniqueId();
 
   return entity;
 }
@@ -84,6 +84,10 @@ class Entity : public WorldObject
     virtual void AdvanceInAir(Unit* _unit);
     virtual void AdvanceInWater(Unit* _unit);
 
+    uint64_t GetSyncHash() const override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
+
     virtual void ChangeHealth(int amount);
     virtual void Attack(const LegacyVector3& pos);
 
@@ -143,6 +143,34 @@ LegacyVector3 EntityLeg::GetIdealSwingingFootPos(float _fractionComplete)
   return pos;
 }
 
+void EntityLeg::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  _writer.Write(m_legLift);
+  _writer.Write(m_idealLegSlope);
+  _writer.Write(m_legSwingDuration);
+  _writer.Write(m_lookAheadCoef);
+  WriteSnapshotVector(_writer, m_foot.m_pos);
+  WriteSnapshotVector(_writer, m_foot.m_targetPos);
+  _writer.Write(m_foot.m_state);
+  WriteSnapshotTime(_writer, m_foot.m_leftGroundTimeStamp);
+  WriteSnapshotVector(_writer, m_foot.m_lastGroundPos);
+  WriteSnapshotVector(_writer, m_foot.m_bodyToFoot);
+}
+
+void EntityLeg::ReadSnapshot(SnapshotReader& _reader)
+{
+  _reader.Read(m_legLift);
+  _reader.Read(m_idealLegSlope);
+  _reader.Read(m_legSwingDuration);
+  _reader.Read(m_lookAheadCoef);
+  ReadSnapshotVector(_reader, m_foot.m_pos);
+  ReadSnapshotVector(_reader, m_foot.m_targetPos);
+  _reader.Read(m_foot.m_state);
+  ReadSnapshotTime(_reader, m_foot.m_leftGroundTimeStamp);
+  ReadSnapshotVector(_reader, m_foot.m_lastGroundPos);
+  ReadSnapshotVector(_reader, m_foot.m_bodyToFoot);
+}
+
 // Returns true if the foot was planted this frame
 bool EntityLeg::Advance()
 {
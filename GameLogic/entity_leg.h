@@ -2,6 +2,7 @@
 
 
 #include "LegacyVector3.h"
+#include "SnapshotStream.h"
 
 class Entity;
 class ShapeMarkerData;
@@ -72,5 +73,8 @@ public:
 	bool	Advance(); // Returns true if the foot was planted this frame
 	void	AdvanceSpiderPounce(float _fractionComplete);
 	void	Render(float _predictionTime, LegacyVector3 const &_predictedMovement);
+
+	void	WriteSnapshot(SnapshotWriter& _writer) const;
+	void	ReadSnapshot(SnapshotReader& _reader);
 };
 
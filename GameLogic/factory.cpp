@@ -66,6 +66,36 @@ void Factory::RequestUnit(unsigned char _troopType, int _numToCreate)
   m_state = StateCreating;
 }
 
+void Factory::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_troopType);
+  _writer.Write(m_stats);
+  _writer.Write(m_initialCapacity);
+  _writer.Write(m_unitId);
+  _writer.Write(m_numToCreate);
+  _writer.Write(m_numCreated);
+  _writer.Write(m_timeToCreate);
+  _writer.Write(m_timeSoFar);
+  _writer.Write(m_state);
+  m_spiritStore.WriteSnapshot(_writer);
+}
+
+void Factory::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_troopType);
+  _reader.Read(m_stats);
+  _reader.Read(m_initialCapacity);
+  _reader.Read(m_unitId);
+  _reader.Read(m_numToCreate);
+  _reader.Read(m_numCreated);
+  _reader.Read(m_timeToCreate);
+  _reader.Read(m_timeSoFar);
+  _reader.Read(m_state);
+  m_spiritStore.ReadSnapshot(_reader);
+}
+
 bool Factory::Advance()
 {
   switch (m_state)
@@ -39,6 +39,8 @@ public:
     void Initialise( Building *_template );
 
     bool Advance();
+    void WriteSnapshot( SnapshotWriter &_writer ) const;
+    void ReadSnapshot( SnapshotReader &_reader );
     void AdvanceStateUnused();
     void AdvanceStateCreating();
     void AdvanceStateRecharging();
@@ -30,6 +30,24 @@ void FeedingTube::Initialise(Building* _template)
   m_receiverId = static_cast<FeedingTube*>(_template)->m_receiverId;
 }
 
+// *** WriteSnapshot
+void FeedingTube::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_receiverId);
+  _writer.Write(m_range);
+  _writer.Write(m_signal);
+}
+
+// *** ReadSnapshot
+void FeedingTube::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_receiverId);
+  _reader.Read(m_range);
+  _reader.Read(m_signal);
+}
+
 bool FeedingTube::Advance()
 {
   Matrix34 rootMat(m_front, g_upVector, m_pos);
@@ -24,6 +24,8 @@ class FeedingTube : public Building
     void Write(FileWriter* _out) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     LegacyVector3 GetStartPoint();
     LegacyVector3 GetEndPoint();
@@ -60,6 +60,20 @@ bool PowerBuilding::IsInView()
   return Building::IsInView();
 }
 
+void PowerBuilding::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_powerLink);
+  WriteSnapshotList(_writer, m_surges);
+}
+
+void PowerBuilding::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_powerLink);
+  ReadSnapshotList(_reader, m_surges);
+}
+
 bool PowerBuilding::Advance()
 {
   for (int i = 0; i < m_surges.Size(); ++i)
@@ -84,9 +98,10 @@ bool PowerBuilding::Advance()
 
 void PowerBuilding::TriggerSurge(float _initValue)
 {
+  Wake();
   m_surges.PutDataAtStart(_initValue);
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "TriggerSurge"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "TriggerSurge"));
 }
 
 void PowerBuilding::Read(TextReader* _in, bool _dynamic)
@@ -142,7 +157,25 @@ const char* Generator::GetObjectiveCounter()
 void Generator::ReprogramComplete()
 {
   m_enabled = true;
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Enable"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Enable"));
+}
+
+void Generator::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  PowerBuilding::WriteSnapshot(_writer);
+  WriteSnapshotTime(_writer, m_timerSync);
+  _writer.Write(m_numThisSecond);
+  _writer.Write(m_enabled);
+  _writer.Write(m_throughput);
+}
+
+void Generator::ReadSnapshot(SnapshotReader& _reader)
+{
+  PowerBuilding::ReadSnapshot(_reader);
+  ReadSnapshotTime(_reader, m_timerSync);
+  _reader.Read(m_numThisSecond);
+  _reader.Read(m_enabled);
+  _reader.Read(m_throughput);
 }
 
 bool Generator::Advance()
@@ -207,7 +240,13 @@ Pylon::Pylon()
   SetShape(Resource::GetShapeStatic("pylon.shp"));
 }
 
-bool Pylon::Advance() { return PowerBuilding::Advance(); }
+bool Pylon::Advance()
+{
+  bool removeBuilding = PowerBuilding::Advance();
+  if (!removeBuilding && m_surges.Size() == 0 && GetNumPorts() == 0)
+    Sleep(); // Until the next surge arrives
+  return removeBuilding;
+}
 
 // ****************************************************************************
 // Class PylonStart
@@ -228,6 +267,18 @@ void PylonStart::Initialise(Building* _template)
   m_reqBuildingId = static_cast<PylonStart*>(_template)->m_reqBuildingId;
 }
 
+void PylonStart::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  PowerBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_reqBuildingId);
+}
+
+void PylonStart::ReadSnapshot(SnapshotReader& _reader)
+{
+  PowerBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_reqBuildingId);
+}
+
 bool PylonStart::Advance()
 {
   //
@@ -342,6 +393,18 @@ void SolarPanel::Initialise(Building* _template)
   PowerBuilding::Initialise(_template);
 }
 
+void SolarPanel::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  PowerBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_operating);
+}
+
+void SolarPanel::ReadSnapshot(SnapshotReader& _reader)
+{
+  PowerBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_operating);
+}
+
 bool SolarPanel::Advance()
 {
   float fractionOccupied = static_cast<float>(GetNumPortsOccupied()) / static_cast<float>(GetNumPorts());
@@ -352,14 +415,14 @@ bool SolarPanel::Advance()
   if (fractionOccupied > 0.6f)
   {
     if (!m_operating)
-      g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Operate"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Operate"));
     m_operating = true;
   }
 
   if (fractionOccupied < 0.3f)
   {
     if (m_operating)
-      g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
     m_operating = false;
   }
 
@@ -23,6 +23,8 @@ class PowerBuilding : public Building
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     bool IsInView() override;
     LegacyVector3 GetPowerLocation();
@@ -62,6 +64,8 @@ class Generator : public PowerBuilding
     const char* GetObjectiveCounter() override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
 
 // ****************************************************************************
@@ -88,6 +92,8 @@ class PylonStart : public PowerBuilding
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Read(TextReader* _in, bool _dynamic) override;
     void Write(FileWriter* _out) override;
@@ -127,4 +133,6 @@ class SolarPanel : public PowerBuilding
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
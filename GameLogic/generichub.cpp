@@ -26,6 +26,20 @@ void DynamicBase::Initialise(Building* _template)
   SetShapeName(static_cast<DynamicBase*>(_template)->m_shapeName);
 }
 
+void DynamicBase::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_buildingLink);
+  _writer.WriteString(m_shapeName);
+}
+
+void DynamicBase::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_buildingLink);
+  _reader.ReadString(m_shapeName, sizeof(m_shapeName));
+}
+
 bool DynamicBase::Advance() { return Building::Advance(); }
 
 void DynamicBase::Read(TextReader* _in, bool _dynamic)
@@ -97,7 +111,31 @@ void DynamicHub::Initialise(Building* _template)
 void DynamicHub::ReprogramComplete()
 {
   m_reprogrammed = true;
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Enable"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Enable"));
+}
+
+void DynamicHub::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  DynamicBase::WriteSnapshot(_writer);
+  _writer.Write(m_enabled);
+  _writer.Write(m_reprogrammed);
+  _writer.Write(m_numLinks);
+  _writer.Write(m_activeLinks);
+  _writer.Write(m_currentScore);
+  _writer.Write(m_requiredScore);
+  _writer.Write(m_minActiveLinks);
+}
+
+void DynamicHub::ReadSnapshot(SnapshotReader& _reader)
+{
+  DynamicBase::ReadSnapshot(_reader);
+  _reader.Read(m_enabled);
+  _reader.Read(m_reprogrammed);
+  _reader.Read(m_numLinks);
+  _reader.Read(m_activeLinks);
+  _reader.Read(m_currentScore);
+  _reader.Read(m_requiredScore);
+  _reader.Read(m_minActiveLinks);
 }
 
 bool DynamicHub::Advance()
@@ -256,6 +294,24 @@ void DynamicNode::Initialise(Building* _template)
   m_scoreSupplied = nodeCopy->m_scoreSupplied;
 }
 
+void DynamicNode::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  DynamicBase::WriteSnapshot(_writer);
+  _writer.Write(m_operating);
+  _writer.Write(m_scoreValue);
+  _writer.Write(m_scoreTimer);
+  _writer.Write(m_scoreSupplied);
+}
+
+void DynamicNode::ReadSnapshot(SnapshotReader& _reader)
+{
+  DynamicBase::ReadSnapshot(_reader);
+  _reader.Read(m_operating);
+  _reader.Read(m_scoreValue);
+  _reader.Read(m_scoreTimer);
+  _reader.Read(m_scoreSupplied);
+}
+
 bool DynamicNode::Advance()
 {
   bool friendly = true;
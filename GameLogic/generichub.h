@@ -20,6 +20,8 @@ class DynamicBase : public Building
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Read(TextReader* _in, bool _dynamic) override;
     void Write(FileWriter* _out) override;
@@ -59,6 +61,8 @@ class DynamicHub : public DynamicBase
     const char* GetObjectiveCounter() override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void ActivateLink();
     void DeactivateLink();
@@ -89,6 +93,8 @@ class DynamicNode : public DynamicBase
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void ReprogramComplete() override;
 
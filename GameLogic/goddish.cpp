@@ -27,6 +27,24 @@ GodDish::GodDish()
 
 void GodDish::Initialise(Building* _template) { Building::Initialise(_template); }
 
+void GodDish::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_activated);
+  _writer.Write(m_timer);
+  _writer.Write(m_numSpawned);
+  _writer.Write(m_spawnSpam);
+}
+
+void GodDish::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_activated);
+  _reader.Read(m_timer);
+  _reader.Read(m_numSpawned);
+  _reader.Read(m_spawnSpam);
+}
+
 bool GodDish::Advance()
 {
   if (m_activated)
@@ -55,29 +73,22 @@ void GodDish::Activate()
 
   Team* team = &g_context->m_location->m_teams[0];
 
-  for (int i = 0; i < team->m_others.Size(); ++i)
+  for (int i : team->GetOthers(Entity::TypeDarwinian))
   {
-    if (team->m_others.ValidIndex(i))
-    {
-      Entity* entity = team->m_others[i];
-      if (entity && entity->m_type == Entity::TypeDarwinian)
-      {
-        auto darwinian = static_cast<Darwinian*>(entity);
-        darwinian->WatchSpectacle(m_id.GetUniqueId());
-        darwinian->CastShadow(m_id.GetUniqueId());
-      }
-    }
+    auto darwinian = static_cast<Darwinian*>(team->m_others[i]);
+    darwinian->WatchSpectacle(m_id.GetUniqueId());
+    darwinian->CastShadow(m_id.GetUniqueId());
   }
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ConnectToGod"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ConnectToGod"));
 }
 
 void GodDish::DeActivate()
 {
   m_activated = false;
 
-  g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "DisconnectFromGod"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "DisconnectFromGod"));
 }
 
 void GodDish::SpawnSpam(bool _isResearch)
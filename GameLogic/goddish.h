@@ -15,6 +15,8 @@ class GodDish : public Building
     void Initialise(Building* _template) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     bool IsInView() override;
 
     void Activate();
@@ -87,8 +87,8 @@ void GunTurret::ExplodeBody()
   LegacyVector3 barrelFront = m_turret->GetMarkerWorldMatrix(m_barrelMount, turretPos).f;
   Matrix34 barrelMat(barrelFront, m_up, barrelPos);
 
-  g_simEventQueue.Push(SimEvent::MakeExplosion(m_turret, turretPos, 1.0f));
-  g_simEventQueue.Push(SimEvent::MakeExplosion(m_barrel, barrelMat, 1.0f));
+  g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_turret, turretPos, 1.0f));
+  g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_barrel, barrelMat, 1.0f));
 }
 
 bool GunTurret::SearchForTargets()
@@ -104,7 +104,7 @@ bool GunTurret::SearchForTargets()
   Entity* entity = g_context->m_location->GetEntity(m_targetId);
 
   if (entity && m_targetId != previousTarget)
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "TargetSighted"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "TargetSighted"));
 
   return (m_targetId.IsValid());
 }
@@ -183,7 +183,39 @@ void GunTurret::PrimaryFire()
   }
 
   if (fired)
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "FireShell"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "FireShell"));
+}
+
+void GunTurret::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_turretFront);
+  WriteSnapshotVector(_writer, m_barrelUp);
+  _writer.Write(m_aiTargetCreated);
+  WriteSnapshotVector(_writer, m_target);
+  WriteSnapshotId(_writer, m_targetId);
+  _writer.Write(m_fireTimer);
+  _writer.Write(m_nextBarrel);
+  _writer.Write(m_retargetTimer);
+  _writer.Write(m_targetCreated);
+  _writer.Write(m_health);
+  _writer.Write(m_ownershipTimer);
+}
+
+void GunTurret::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_turretFront);
+  ReadSnapshotVector(_reader, m_barrelUp);
+  _reader.Read(m_aiTargetCreated);
+  ReadSnapshotVector(_reader, m_target);
+  ReadSnapshotId(_reader, m_targetId);
+  _reader.Read(m_fireTimer);
+  _reader.Read(m_nextBarrel);
+  _reader.Read(m_retargetTimer);
+  _reader.Read(m_targetCreated);
+  _reader.Read(m_health);
+  _reader.Read(m_ownershipTimer);
 }
 
 bool GunTurret::Advance()
@@ -228,8 +260,9 @@ bool GunTurret::Advance()
     m_ownershipTimer = GUNTURRET_OWNERSHIPTIMER;
   }
 
+  // A headless match has no player at the controls
   Team* team = g_context->m_location->GetMyTeam();
-  bool underPlayerControl = (team && team->m_currentBuildingId == m_id.GetUniqueId());
+  bool underPlayerControl = (g_context->m_camera && team && team->m_currentBuildingId == m_id.GetUniqueId());
 
   //
   // Look for a new target
@@ -340,6 +373,18 @@ GunTurretTarget::GunTurretTarget(int _buildingId)
   : WorldObject(),
     m_buildingId(_buildingId) { m_type = EffectGunTurretTarget; }
 
+void GunTurretTarget::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_buildingId);
+}
+
+void GunTurretTarget::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_buildingId);
+}
+
 bool GunTurretTarget::Advance()
 {
   auto turret = static_cast<GunTurret*>(g_context->m_location->GetBuilding(m_buildingId));
@@ -49,6 +49,8 @@ class GunTurret : public Building
     void ExplodeBody();
     void Damage(float _damage) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     LegacyVector3 GetTarget();
 
@@ -65,4 +67,6 @@ class GunTurretTarget : public WorldObject
 
     GunTurretTarget(int _buildingId);
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
@@ -60,6 +60,47 @@ void Incubator::Initialise(Building* _template)
   }
 }
 
+void Incubator::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  WriteSnapshotArray(_writer, m_spirits, [&](int _index) { m_spirits[_index].WriteSnapshot(_writer); });
+  _writer.Write(m_troopType);
+  _writer.Write(m_timer);
+  _writer.WriteCount(m_incoming.Size());
+  for (int i = 0; i < m_incoming.Size(); ++i)
+  {
+    const IncubatorIncoming* incoming = m_incoming.GetData(i);
+    WriteSnapshotVector(_writer, incoming->m_pos);
+    _writer.Write(incoming->m_entrance);
+    _writer.Write(incoming->m_alpha);
+  }
+  _writer.Write(m_numStartingSpirits);
+}
+
+void Incubator::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  ReadSnapshotArray(_reader, m_spirits, [&](int)
+  {
+    Spirit spirit;
+    spirit.ReadSnapshot(_reader);
+    return spirit;
+  });
+  _reader.Read(m_troopType);
+  _reader.Read(m_timer);
+  m_incoming.EmptyAndDelete();
+  const int numIncoming = _reader.ReadCount();
+  for (int i = 0; i < numIncoming; ++i)
+  {
+    auto incoming = new IncubatorIncoming();
+    ReadSnapshotVector(_reader, incoming->m_pos);
+    _reader.Read(incoming->m_entrance);
+    _reader.Read(incoming->m_alpha);
+    m_incoming.PutDataAtEnd(incoming);
+  }
+  _reader.Read(m_numStartingSpirits);
+}
+
 bool Incubator::Advance()
 {
   //
@@ -154,14 +195,14 @@ void Incubator::SpawnEntity()
   for (int i = 0; i < numFlashes; ++i)
   {
     LegacyVector3 vel(sfrand(15.0f), frand(35.0f), sfrand(15.0f));
-    g_simEventQueue.Push(SimEvent::MakeParticle(exit.pos, vel, SimParticle::TypeControlFlash));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(exit.pos, vel, SimParticle::TypeControlFlash));
     //g_context->m_particleSystem->CreateParticle( spiritPos, vel, Particle::TypeControlFlash );
   }
 
   //
   // Sound effect
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "SpawnEntity"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "SpawnEntity"));
 }
 
 void Incubator::AddSpirit(Spirit* _spirit)
@@ -180,7 +221,7 @@ void Incubator::AddSpirit(Spirit* _spirit)
   ii->m_alpha = 1.0f;
   m_incoming.PutData(ii);
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "AddSpirit"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "AddSpirit"));
 }
 
 void Incubator::GetDockPoint(LegacyVector3& _pos, LegacyVector3& _front)
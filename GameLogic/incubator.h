@@ -39,6 +39,8 @@ class Incubator : public Building
     void Initialise(Building* _template) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void SpawnEntity();
     void AddSpirit(Spirit* _spirit);
 
@@ -20,8 +20,6 @@
 #include "insertion_squad.h"
 #include "teleport.h"
 
-unsigned int HistoricWayPoint::s_lastId = 0;
-
 //*****************************************************************************
 // Class InsertionSquad
 //*****************************************************************************
@@ -38,6 +36,40 @@ InsertionSquad::InsertionSquad(int teamId, int unitId, int numEntities, const Le
 
 InsertionSquad::~InsertionSquad() { m_positionHistory.EmptyAndDelete(); }
 
+void InsertionSquad::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Unit::WriteSnapshot(_writer);
+  _writer.WriteCount(m_positionHistory.Size());
+  for (int i = 0; i < m_positionHistory.Size(); ++i)
+  {
+    const HistoricWayPoint* wayPoint = m_positionHistory.GetData(i);
+    WriteSnapshotVector(_writer, wayPoint->m_pos);
+    _writer.Write(wayPoint->m_id);
+  }
+  _writer.Write(m_weaponType);
+  _writer.Write(m_controllerId);
+  _writer.Write(m_teleportId);
+}
+
+void InsertionSquad::ReadSnapshot(SnapshotReader& _reader)
+{
+  Unit::ReadSnapshot(_reader);
+  m_positionHistory.EmptyAndDelete();
+  const int numWayPoints = _reader.ReadCount();
+  for (int i = 0; i < numWayPoints; ++i)
+  {
+    LegacyVector3 pos;
+    ReadSnapshotVector(_reader, pos);
+    unsigned int id;
+    _reader.Read(id);
+    auto wayPoint = new HistoricWayPoint(pos, id);
+    m_positionHistory.PutDataAtEnd(wayPoint);
+  }
+  _reader.Read(m_weaponType);
+  _reader.Read(m_controllerId);
+  _reader.Read(m_teleportId);
+}
+
 Entity* InsertionSquad::GetPointMan()
 {
   for (int i = 0; i < m_entities.Size(); ++i)
@@ -79,16 +111,17 @@ void InsertionSquad::SetWayPoint(const LegacyVector3& _pos)
 
   // If we found the point man add his position to the position history
   // otherwise add the position that was passed in as an argument
+  const unsigned int wayPointId = ++g_context->m_location->m_statics.m_lastWayPointId;
   HistoricWayPoint* newWayPoint;
   if (pointMan && pointMan->m_enabled)
-    newWayPoint = new HistoricWayPoint(pointMan->m_pos);
+    newWayPoint = new HistoricWayPoint(pointMan->m_pos, wayPointId);
   else
-    newWayPoint = new HistoricWayPoint(_pos);
+    newWayPoint = new HistoricWayPoint(_pos, wayPointId);
   m_positionHistory.PutDataAtStart(newWayPoint);
 
   // If this squad is using a Controller, update the Route
   // that the Controller points to
-  Task* controller = g_context->m_taskManager->GetTask(m_controllerId);
+  Task* controller = g_context->m_taskManager ? g_context->m_taskManager->GetTask(m_controllerId) : nullptr;
   if (controller)
   {
     LegacyVector3 lastAddedPos = controller->m_route->m_wayPoints[controller->m_route->m_wayPoints.Size() - 1]->GetPos();
@@ -318,13 +351,13 @@ void Squadie::ChangeHealth(int _amount)
   if (!m_dead)
   {
     if (_amount < 0)
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LoseHealth"));
 
     if (m_stats[StatHealth] + _amount <= 0)
     {
       m_stats[StatHealth] = 100;
       m_dead = true;
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Die"));
     }
     else if (m_stats[StatHealth] + _amount > 255)
       m_stats[StatHealth] = 255;
@@ -335,10 +368,28 @@ void Squadie::ChangeHealth(int _amount)
   if (!dead && m_dead)
   {
     Matrix34 transform(m_front, g_upVector, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
   }
 }
 
+void Squadie::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_justFired);
+  _writer.Write(m_secondaryTimer);
+  WriteSnapshotId(_writer, m_enemyId);
+  _writer.Write(m_retargetTimer);
+}
+
+void Squadie::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_justFired);
+  _reader.Read(m_secondaryTimer);
+  ReadSnapshotId(_reader, m_enemyId);
+  _reader.Read(m_retargetTimer);
+}
+
 bool Squadie::Advance(Unit* _theUnit)
 {
   // DebugTrace( "Squadie %d, Health: %d, Dead %d\n", m_formationIndex, m_stats[StatHealth], (int)m_dead );
@@ -348,7 +399,7 @@ bool Squadie::Advance(Unit* _theUnit)
     if (m_secondaryTimer <= 0.0f)
     {
       // Secondary weapon is reloaded
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "WeaponReturns"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "WeaponReturns"));
     }
   }
 
@@ -511,13 +562,13 @@ void Squadie::Attack(const LegacyVector3& _pos)
     Matrix34 brass = m_shape->GetMarkerWorldMatrix(m_brass, mat);
     LegacyVector3 particleVel = brass.f * (5.0f + syncfrand(10.0f));
     particleVel += LegacyVector3(syncsfrand(5.0f), syncsfrand(5.0f), syncsfrand(5.0f));
-    g_simEventQueue.Push(SimEvent::MakeParticle(brass.pos, particleVel, SimParticle::TypeBrass));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(brass.pos, particleVel, SimParticle::TypeBrass));
 
     //
     //
     m_reloading = m_stats[StatRate];
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "FireLaser"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "FireLaser"));
   }
 }
 
@@ -536,25 +587,25 @@ void Squadie::FireSecondaryWeapon(const LegacyVector3& _pos)
     switch (squad->m_weaponType)
     {
     case GlobalResearch::TypeGrenade:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ThrowGrenade"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ThrowGrenade"));
       g_context->m_location->ThrowWeapon(laserPos, _pos, EffectThrowableGrenade, m_id.GetTeamId());
       m_secondaryTimer = 4.0f;
       break;
 
     case GlobalResearch::TypeAirStrike:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ThrowAirStrike"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ThrowAirStrike"));
       g_context->m_location->ThrowWeapon(laserPos, _pos, EffectThrowableAirstrikeMarker, m_id.GetTeamId());
       m_secondaryTimer = 20.0f;
       break;
 
     case GlobalResearch::TypeController:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ThrowController"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ThrowController"));
       g_context->m_location->ThrowWeapon(laserPos, _pos, EffectThrowableControllerGrenade, m_id.GetTeamId());
       m_secondaryTimer = 4.0f;
       break;
 
     case GlobalResearch::TypeRocket:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "FireRocket"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "FireRocket"));
       g_context->m_location->FireRocket(laserPos, _pos, m_id.GetTeamId());
       m_secondaryTimer = 4.0f;
       break;
@@ -15,14 +15,10 @@ class HistoricWayPoint
   public:
     LegacyVector3 m_pos;
     unsigned int m_id;
-    static unsigned int s_lastId;
-
-    HistoricWayPoint(const LegacyVector3& _pos)
-      : m_pos(_pos)
-    {
-      s_lastId++;
-      m_id = s_lastId;
-    }
+
+    HistoricWayPoint(const LegacyVector3& _pos, unsigned int _id)
+      : m_pos(_pos),
+        m_id(_id) {}
 };
 
 //*****************************************************************************
@@ -43,6 +39,8 @@ class InsertionSquad : public Unit
     ~InsertionSquad() override;
 
     void SetWayPoint(const LegacyVector3& _pos) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     LegacyVector3 GetTargetPos(float _distFromPointMan);
     Entity* GetPointMan();
     void SetWeaponType(int _weaponType); // Indexes into GlobalResearch
@@ -77,6 +75,8 @@ class Squadie : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
     void Attack(const LegacyVector3& _pos) override;
 
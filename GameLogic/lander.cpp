@@ -20,6 +20,20 @@ Lander::Lander()
   DEBUG_ASSERT(m_shape);
 }
 
+void Lander::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  _writer.Write(m_spawnTimer);
+}
+
+void Lander::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  _reader.Read(m_spawnTimer);
+}
+
 bool Lander::Advance(Unit* _unit)
 {
   m_front.Set(-1, 0, 0);
@@ -58,7 +72,7 @@ bool Lander::Advance(Unit* _unit)
   return false;
 }
 
-void Lander::ChangeHealth([[maybe_unused]] int amount) { g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash)); }
+void Lander::ChangeHealth([[maybe_unused]] int amount) { g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash)); }
 
 bool Lander::AdvanceSailing()
 {
@@ -20,6 +20,8 @@ public:
     Lander();
 
     bool Advance        ( Unit *_unit );
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
     bool AdvanceSailing ();
     bool AdvanceLanded  ();
 
@@ -75,10 +75,34 @@ void LaserFence::Spark()
     particleVel.SetLength(40.0f + frand(20.0f));
     particleVel += LegacyVector3(frand() * 20.0f, sfrand() * 20.0f, sfrand() * 20.0f);
     float size = 25.0f + frand(25.0f);
-    g_simEventQueue.Push(SimEvent::MakeParticle(sparkPos, particleVel, SimParticle::TypeSpark, size));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(sparkPos, particleVel, SimParticle::TypeSpark, size));
   }
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Spark"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Spark"));
+}
+
+void LaserFence::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_status);
+  _writer.Write(m_nextLaserFenceId);
+  _writer.Write(m_sparkTimer);
+  _writer.Write(m_radiusSet);
+  _writer.Write(m_nextToggled);
+  _writer.Write(m_mode);
+  _writer.Write(m_scale);
+}
+
+void LaserFence::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_status);
+  _reader.Read(m_nextLaserFenceId);
+  _reader.Read(m_sparkTimer);
+  _reader.Read(m_radiusSet);
+  _reader.Read(m_nextToggled);
+  _reader.Read(m_mode);
+  _reader.Read(m_scale);
 }
 
 bool LaserFence::Advance()
@@ -276,7 +300,7 @@ int LaserFence::GetBuildingLink() { return m_nextLaserFenceId; }
 
 void LaserFence::SetBuildingLink(int _buildingId) { m_nextLaserFenceId = _buildingId; }
 
-void LaserFence::Electrocute([[maybe_unused]] const LegacyVector3& _pos) { g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Electrocute")); }
+void LaserFence::Electrocute([[maybe_unused]] const LegacyVector3& _pos) { g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Electrocute")); }
 
 bool LaserFence::DoesSphereHit(const LegacyVector3& _pos, float _radius)
 {
@@ -46,6 +46,8 @@ public:
     void SetDetail ( int _detail );
 
     bool Advance        ();
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
 
     bool PerformDepthSort   ( LegacyVector3 &_centerPos );
     bool IsInView           ();
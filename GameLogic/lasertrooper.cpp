@@ -15,6 +15,22 @@ void LaserTrooper::Begin()
   m_victoryDance = -1.0f;
 }
 
+void LaserTrooper::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_targetPos);
+  WriteSnapshotVector(_writer, m_unitTargetPos);
+  _writer.Write(m_victoryDance);
+}
+
+void LaserTrooper::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_targetPos);
+  ReadSnapshotVector(_reader, m_unitTargetPos);
+  _reader.Read(m_victoryDance);
+}
+
 bool LaserTrooper::Advance(Unit* _unit)
 {
   if (m_targetPos == g_zeroVector)
@@ -17,6 +17,8 @@ public:
     void Begin      ();
 
     bool Advance    ( Unit *_unit );
+    void WriteSnapshot ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot ( SnapshotReader &_reader );
 
     void AdvanceVictoryDance();
 };
@@ -20,6 +20,18 @@ Library::Library()
 }
 
 
+void Library::WriteSnapshot( SnapshotWriter &_writer ) const
+{
+    Building::WriteSnapshot( _writer );
+    _writer.Write( m_scrollSpawned );
+}
+
+void Library::ReadSnapshot( SnapshotReader &_reader )
+{
+    Building::ReadSnapshot( _reader );
+    _reader.Read( m_scrollSpawned );
+}
+
 bool Library::Advance()
 {
     for( int i = 0; i < GlobalResearch::NumResearchItems; ++i )
@@ -16,5 +16,7 @@ public:
     Library();
 
     bool Advance();
+    void WriteSnapshot(SnapshotWriter& _writer) const;
+    void ReadSnapshot(SnapshotReader& _reader);
 };
 
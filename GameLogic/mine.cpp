@@ -31,9 +31,6 @@ ShapeMarkerData* MineBuilding::s_cartContents[] = {nullptr, nullptr, nullptr};
 ShapeStatic* MineBuilding::s_polygon1 = nullptr;
 ShapeStatic* MineBuilding::s_primitive1 = nullptr;
 
-float MineBuilding::s_refineryPopulation = 0.0f;
-float MineBuilding::s_refineryRecalculateTimer = 0.0f;
-
 MineBuilding::MineBuilding()
   : Building(),
     m_trackLink(-1),
@@ -93,11 +90,45 @@ bool MineBuilding::IsInView()
   return Building::IsInView();
 }
 
+void MineBuilding::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_trackLink);
+  _writer.WriteCount(m_carts.Size());
+  for (int i = 0; i < m_carts.Size(); ++i)
+  {
+    const MineCart* cart = m_carts.GetData(i);
+    _writer.Write(cart->m_progress);
+    _writer.Write(cart->m_polygons);
+    _writer.Write(cart->m_primitives);
+  }
+  _writer.Write(m_previousMineSpeed);
+  _writer.Write(m_wheelRotate);
+}
+
+void MineBuilding::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_trackLink);
+  m_carts.EmptyAndDelete();
+  const int numCarts = _reader.ReadCount();
+  for (int i = 0; i < numCarts; ++i)
+  {
+    auto cart = new MineCart();
+    _reader.Read(cart->m_progress);
+    _reader.Read(cart->m_polygons);
+    _reader.Read(cart->m_primitives);
+    m_carts.PutDataAtEnd(cart);
+  }
+  _reader.Read(m_previousMineSpeed);
+  _reader.Read(m_wheelRotate);
+}
+
 bool MineBuilding::Advance()
 {
   float mineSpeed = RefinerySpeed();
   if (m_previousMineSpeed <= 0.1f && mineSpeed > 0.1f)
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "CogTurn"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "CogTurn"));
   m_previousMineSpeed = mineSpeed;
 
   if (mineSpeed > 0.0f)
@@ -181,7 +212,8 @@ void MineBuilding::SetBuildingLink(int _buildingId) { m_trackLink = _buildingId;
 
 float MineBuilding::RefinerySpeed()
 {
-  if (GetHighResTime() >= s_refineryRecalculateTimer)
+  LocationStatics& statics = g_context->m_location->m_statics;
+  if (GetHighResTime() >= statics.m_refineryRecalculateTimer)
   {
     //
     // Find the refinery
@@ -216,14 +248,14 @@ float MineBuilding::RefinerySpeed()
     {
       int numPorts = driver->GetNumPorts();
       int numPortsOccupied = driver->GetNumPortsOccupied();
-      s_refineryPopulation = static_cast<float>(numPortsOccupied) / static_cast<float>(numPorts);
+      statics.m_refineryPopulation = static_cast<float>(numPortsOccupied) / static_cast<float>(numPorts);
     }
     else if (numFuelGenerators > 0)
-      s_refineryPopulation = fuelGeneratorFactor / static_cast<float>(numFuelGenerators);
+      statics.m_refineryPopulation = fuelGeneratorFactor / static_cast<float>(numFuelGenerators);
     else
     {
       int mineLocationId = g_context->m_globalWorld->GetLocationId("mine");
-      s_refineryPopulation = 0.0f;
+      statics.m_refineryPopulation = 0.0f;
 
       for (int i = 0; i < g_context->m_globalWorld->m_buildings.Size(); ++i)
       {
@@ -232,17 +264,17 @@ float MineBuilding::RefinerySpeed()
           GlobalBuilding* gb = g_context->m_globalWorld->m_buildings[i];
           if (gb && gb->m_locationId == mineLocationId && gb->m_type == TypeRefinery && gb->m_online)
           {
-            s_refineryPopulation = 1.0f;
+            statics.m_refineryPopulation = 1.0f;
             break;
           }
         }
       }
     }
 
-    s_refineryRecalculateTimer = GetHighResTime() + 0.1f;
+    statics.m_refineryRecalculateTimer = GetHighResTime() + 0.1f;
   }
 
-  float speed = s_refineryPopulation * fabs(sinf(g_gameTime * 2.0f)) * 0.5f;
+  float speed = statics.m_refineryPopulation * fabs(sinf(g_gameTime * 2.0f)) * 0.5f;
 
   return speed;
 }
@@ -297,6 +329,18 @@ void TrackJunction::Initialise(Building* _template)
   }
 }
 
+void TrackJunction::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  MineBuilding::WriteSnapshot(_writer);
+  WriteSnapshotList(_writer, m_trackLinks);
+}
+
+void TrackJunction::ReadSnapshot(SnapshotReader& _reader)
+{
+  MineBuilding::ReadSnapshot(_reader);
+  ReadSnapshotList(_reader, m_trackLinks);
+}
+
 void TrackJunction::TriggerCart(MineCart* _cart, float _initValue)
 {
   if (m_trackLinks.Size() > 0)
@@ -352,6 +396,18 @@ void TrackStart::Initialise(Building* _template)
   m_reqBuildingId = static_cast<TrackStart*>(_template)->m_reqBuildingId;
 }
 
+void TrackStart::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  MineBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_reqBuildingId);
+}
+
+void TrackStart::ReadSnapshot(SnapshotReader& _reader)
+{
+  MineBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_reqBuildingId);
+}
+
 bool TrackStart::Advance()
 {
   //
@@ -423,6 +479,18 @@ void TrackEnd::Initialise(Building* _template)
   m_reqBuildingId = static_cast<TrackEnd*>(_template)->m_reqBuildingId;
 }
 
+void TrackEnd::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  MineBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_reqBuildingId);
+}
+
+void TrackEnd::ReadSnapshot(SnapshotReader& _reader)
+{
+  MineBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_reqBuildingId);
+}
+
 bool TrackEnd::Advance()
 {
   //
@@ -35,8 +35,6 @@ class MineBuilding : public Building
     static ShapeStatic* s_polygon1;
     static ShapeStatic* s_primitive1;
 
-    static float s_refineryPopulation;
-    static float s_refineryRecalculateTimer;
     static float RefinerySpeed();
 
   public:
@@ -44,6 +42,9 @@ class MineBuilding : public Building
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
+
 
     bool IsInView() override;
 
@@ -94,6 +95,8 @@ class TrackJunction : public MineBuilding
     TrackJunction();
 
     void Initialise(Building* _template) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void TriggerCart(MineCart* _cart, float _initValue) override;
 
@@ -116,6 +119,8 @@ class TrackStart : public MineBuilding
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Read(TextReader* _in, bool _dynamic) override;
     void Write(FileWriter* _out) override;
@@ -134,6 +139,8 @@ class TrackEnd : public MineBuilding
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Read(TextReader* _in, bool _dynamic) override;
     void Write(FileWriter* _out) override;
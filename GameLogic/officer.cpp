@@ -85,7 +85,7 @@ void Officer::ChangeHealth(int amount)
   {
     // We just died
     Matrix34 transform(m_front, g_upVector, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
   }
 }
 
@@ -209,13 +209,43 @@ void Officer::Absorb()
       Entity* entity = g_context->m_location->GetEntity(nearestId);
 
       g_context->m_location->m_entityGrid->RemoveObject(nearestId, entity->m_pos.x, entity->m_pos.z, entity->m_radius);
-      g_context->m_location->m_teams[nearestId.GetTeamId()].m_others.MarkNotUsed(nearestId.GetIndex());
+      g_context->m_location->m_teams[nearestId.GetTeamId()].RemoveOther(nearestId.GetIndex());
       ++m_shield;
       m_absorbTimer = 1.0f;
     }
   }
 }
 
+void Officer::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  WriteSnapshotVector(_writer, m_wayPoint);
+  _writer.Write(m_wayPointTeleportId);
+  _writer.Write(m_shield);
+  _writer.Write(m_demoted);
+  _writer.Write(m_absorb);
+  _writer.Write(m_absorbTimer);
+  _writer.Write(m_orders);
+  WriteSnapshotVector(_writer, m_orderPosition);
+  _writer.Write(m_ordersBuildingId);
+}
+
+void Officer::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  ReadSnapshotVector(_reader, m_wayPoint);
+  _reader.Read(m_wayPointTeleportId);
+  _reader.Read(m_shield);
+  _reader.Read(m_demoted);
+  _reader.Read(m_absorb);
+  _reader.Read(m_absorbTimer);
+  _reader.Read(m_orders);
+  ReadSnapshotVector(_reader, m_orderPosition);
+  _reader.Read(m_ordersBuildingId);
+}
+
 bool Officer::Advance(Unit* _unit)
 {
   if (!m_onGround)
@@ -346,7 +376,7 @@ void Officer::SetWaypoint(const LegacyVector3& _wayPoint)
 
 void Officer::CancelOrderSounds()
 {
-  g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
 }
 
 void Officer::SetOrders(const LegacyVector3& _orders)
@@ -409,15 +439,15 @@ void Officer::SetOrders(const LegacyVector3& _orders)
         {
           if (orders.m_arrivedTimer < 0.0f)
           {
-            g_simEventQueue.Push(SimEvent::MakeParticle(orders.m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash, 50.0f));
-            g_simEventQueue.Push(SimEvent::MakeParticle(orders.m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash, 40.0f));
+            g_context->m_simEventQueue.Push(SimEvent::MakeParticle(orders.m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash, 50.0f));
+            g_context->m_simEventQueue.Push(SimEvent::MakeParticle(orders.m_pos, g_zeroVector, SimParticle::TypeMuzzleFlash, 40.0f));
           }
           if (orders.Advance())
             break;
         }
 
         CancelOrderSounds();
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
       }
     }
     else
@@ -471,16 +501,16 @@ void Officer::SetOrders(const LegacyVector3& _orders)
         switch (m_orders)
         {
         case OrderNone:
-          g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderNone"));
+          g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderNone"));
           break;
         case OrderGoto:
-          g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
+          g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
           break;
         case OrderFollow:
           if (m_absorb)
-            g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderAbsorb"));
+            g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderAbsorb"));
           else
-            g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderFollow"));
+            g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderFollow"));
           break;
         }
 
@@ -543,16 +573,16 @@ void Officer::SetNextMode()
     switch (m_orders)
     {
     case OrderNone:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderNone"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderNone"));
       break;
     case OrderGoto:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
       break;
     case OrderFollow:
       if (m_absorb)
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderAbsorb"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderAbsorb"));
       else
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderFollow"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderFollow"));
       break;
     }
 
@@ -613,16 +643,16 @@ void Officer::SetPreviousMode()
     switch (m_orders)
     {
     case OrderNone:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderNone"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderNone"));
       break;
     case OrderGoto:
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderGoto"));
       break;
     case OrderFollow:
       if (m_absorb)
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderAbsorb"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderAbsorb"));
       else
-        g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderFollow"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "SetOrderFollow"));
       break;
     }
 
@@ -643,6 +673,20 @@ OfficerOrders::OfficerOrders()
   : WorldObject(),
     m_arrivedTimer(-1.0f) { m_type = EffectOfficerOrders; }
 
+void OfficerOrders::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_wayPoint);
+  _writer.Write(m_arrivedTimer);
+}
+
+void OfficerOrders::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_wayPoint);
+  _reader.Read(m_arrivedTimer);
+}
+
 bool OfficerOrders::Advance()
 {
   if (m_arrivedTimer >= 0.0f)
@@ -674,7 +718,7 @@ bool OfficerOrders::Advance()
 
     m_vel = (m_pos - oldPos) / SERVER_ADVANCE_PERIOD;
 
-    g_simEventQueue.Push(SimEvent::MakeParticle(oldPos, g_zeroVector, SimParticle::TypeMuzzleFlash, 30.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(oldPos, g_zeroVector, SimParticle::TypeMuzzleFlash, 30.0f));
 
     if (m_vel.Mag() * SERVER_ADVANCE_PERIOD > distance)
       m_arrivedTimer = 0.0f;
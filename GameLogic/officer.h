@@ -56,6 +56,8 @@ class Officer : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void ChangeHealth(int amount) override;
 
@@ -79,4 +81,6 @@ class OfficerOrders : public WorldObject
     OfficerOrders();
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
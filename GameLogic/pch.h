@@ -3,8 +3,6 @@
 #include "NeuronClient.h"
 
 #include "darray.h"
-#include "btree.h"
-#include "hash_table.h"
 #include "fast_darray.h"
 #include "resource.h"
 #include "location.h"
@@ -40,6 +40,20 @@ void Powerstation::Initialise( Building *_template )
 }
 
 
+// *** WriteSnapshot
+void Powerstation::WriteSnapshot( SnapshotWriter &_writer ) const
+{
+    Building::WriteSnapshot( _writer );
+    _writer.Write( m_linkedBuildingId );
+}
+
+// *** ReadSnapshot
+void Powerstation::ReadSnapshot( SnapshotReader &_reader )
+{
+    Building::ReadSnapshot( _reader );
+    _reader.Read( m_linkedBuildingId );
+}
+
 // *** Advance
 bool Powerstation::Advance()
 {
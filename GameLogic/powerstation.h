@@ -19,6 +19,8 @@ public:
 	void Initialise		(Building *_template);
 
     bool Advance		();
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
 
     int  GetBuildingLink();
     void SetBuildingLink(int _buildingId);
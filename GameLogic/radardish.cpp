@@ -60,6 +60,34 @@ bool RadarDish::GetEntrance(LegacyVector3& _pos, LegacyVector3& _front)
   return true;
 }
 
+void RadarDish::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Teleport::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_entrancePos);
+  WriteSnapshotVector(_writer, m_entranceFront);
+  WriteSnapshotVector(_writer, m_target);
+  _writer.Write(m_receiverId);
+  _writer.Write(m_range);
+  _writer.Write(m_signal);
+  _writer.Write(m_newlyCreated);
+  _writer.Write(m_horizontallyAligned);
+  _writer.Write(m_verticallyAligned);
+}
+
+void RadarDish::ReadSnapshot(SnapshotReader& _reader)
+{
+  Teleport::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_entrancePos);
+  ReadSnapshotVector(_reader, m_entranceFront);
+  ReadSnapshotVector(_reader, m_target);
+  _reader.Read(m_receiverId);
+  _reader.Read(m_range);
+  _reader.Read(m_signal);
+  _reader.Read(m_newlyCreated);
+  _reader.Read(m_horizontallyAligned);
+  _reader.Read(m_verticallyAligned);
+}
+
 bool RadarDish::Advance()
 {
   //
@@ -144,8 +172,8 @@ bool RadarDish::Advance()
 
   if (m_movementSoundsPlaying && m_horizontallyAligned && dishState.angVel.Mag() < 0.05f)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "EndRotation"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "EndRotation"));
     m_movementSoundsPlaying = false;
   }
 
@@ -202,8 +230,8 @@ bool RadarDish::Advance()
     m_range = 0.0f;
     m_signal = 0.0f;
     m_receiverId = -1;
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "RadarDish ConnectionEstablished"));
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ConnectionLost"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "RadarDish ConnectionEstablished"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ConnectionLost"));
 
     GlobalBuilding* gb = g_context->m_globalWorld->GetBuilding(m_id.GetUniqueId(), g_context->m_locationId);
     if (gb)
@@ -212,7 +240,7 @@ bool RadarDish::Advance()
 
   if (!previouslyAligned && found)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ConnectionEstablished"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "ConnectionEstablished"));
 
     GlobalBuilding* gb = g_context->m_globalWorld->GetBuilding(m_id.GetUniqueId(), g_context->m_locationId);
     if (gb)
@@ -255,9 +283,9 @@ void RadarDish::Aim(LegacyVector3 _worldPos)
   m_verticallyAligned = false;
 
   if (m_movementSoundsPlaying)
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "RadarDish BeginRotation"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "RadarDish BeginRotation"));
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "BeginRotation"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "BeginRotation"));
   m_movementSoundsPlaying = true;
 }
 
@@ -330,7 +358,7 @@ bool RadarDish::UpdateEntityInTransit(Entity* _entity)
 
     g_context->m_location->m_entityGrid->AddObject(id, _entity->m_pos.x, _entity->m_pos.z, _entity->m_radius);
 
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(_entity->m_id, "ExitTeleport"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(_entity->m_id, "ExitTeleport"));
     return true;
   }
 
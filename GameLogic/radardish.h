@@ -40,6 +40,8 @@ class RadarDish : public Teleport
     void SetDetail(int _detail) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Aim(LegacyVector3 _worldPos);
 
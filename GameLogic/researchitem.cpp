@@ -53,6 +53,24 @@ void ResearchItem::SetDetail([[maybe_unused]] int _detail)
   m_radius = m_shape->CalculateRadius(mat, m_centerPos);
 }
 
+void ResearchItem::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_reprogrammed);
+  _writer.Write(m_researchType);
+  _writer.Write(m_level);
+  _writer.Write(m_inLibrary);
+}
+
+void ResearchItem::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_reprogrammed);
+  _reader.Read(m_researchType);
+  _reader.Read(m_level);
+  _reader.Read(m_inLibrary);
+}
+
 bool ResearchItem::Advance()
 {
   if (m_vel.Mag() > 1.0f)
@@ -74,19 +92,22 @@ bool ResearchItem::Advance()
   if (m_reprogrammed <= 0.0f)
   {
     Matrix34 mat(m_front, m_up, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
 
     int existingLevel = g_context->m_globalWorld->m_research->CurrentLevel(m_researchType);
 
     g_context->m_globalWorld->m_research->AddResearch(m_researchType);
     g_context->m_globalWorld->m_research->m_researchLevel[m_researchType] = m_level;
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "AquireResearch"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "AquireResearch"));
 
-    if (existingLevel == 0)
-      g_context->m_taskManagerInterface->SetCurrentMessage(TaskManagerInterface::MessageResearch, m_researchType, 4.0f);
-    else
-      g_context->m_taskManagerInterface->SetCurrentMessage(TaskManagerInterface::MessageResearchUpgrade, m_researchType, 4.0f);
+    if (TaskManagerInterface* taskManagerInterface = g_context->m_taskManagerInterface)
+    {
+      if (existingLevel == 0)
+        taskManagerInterface->SetCurrentMessage(TaskManagerInterface::MessageResearch, m_researchType, 4.0f);
+      else
+        taskManagerInterface->SetCurrentMessage(TaskManagerInterface::MessageResearchUpgrade, m_researchType, 4.0f);
+    }
 
     return true;
   }
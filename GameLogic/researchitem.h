@@ -21,6 +21,8 @@ class ResearchItem : public Building
     void SetDetail(int _detail) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     bool NeedsReprogram();
     bool Reprogram();
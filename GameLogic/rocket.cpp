@@ -77,6 +77,20 @@ FuelBuilding* FuelBuilding::GetLinkedBuilding() const
   return nullptr;
 }
 
+void FuelBuilding::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_fuelLink);
+  _writer.Write(m_currentLevel);
+}
+
+void FuelBuilding::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_fuelLink);
+  _reader.Read(m_currentLevel);
+}
+
 bool FuelBuilding::Advance()
 {
   FuelBuilding* fuelBuilding = GetLinkedBuilding();
@@ -139,7 +153,7 @@ void FuelBuilding::Destroy(float _intensity)
     ourPipePos += pipeVector * 10;
 
     Matrix34 pipeMat(up, pipeVector, ourPipePos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(s_fuelPipe, pipeMat, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(s_fuelPipe, pipeMat, 1.0f));
   }
 }
 
@@ -163,6 +177,22 @@ FuelGenerator::FuelGenerator()
 
 void FuelGenerator::ProvideSurge() { m_surges++; }
 
+void FuelGenerator::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  FuelBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_pumpMovement);
+  _writer.Write(m_previousPumpPos);
+  _writer.Write(m_surges);
+}
+
+void FuelGenerator::ReadSnapshot(SnapshotReader& _reader)
+{
+  FuelBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_pumpMovement);
+  _reader.Read(m_previousPumpPos);
+  _reader.Read(m_surges);
+}
+
 bool FuelGenerator::Advance()
 {
   //
@@ -206,7 +236,7 @@ bool FuelGenerator::Advance()
       LegacyVector3 particlePos = m_pump->GetMarkerWorldMatrix(m_pumpTip, mat).pos;
       float size = 150.0f + frand(150.0f);
 
-      g_simEventQueue.Push(SimEvent::MakeParticle(particlePos, pumpVel, SimParticle::TypeDarwinianFire, size));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(particlePos, pumpVel, SimParticle::TypeDarwinianFire, size));
     }
   }
 
@@ -214,9 +244,9 @@ bool FuelGenerator::Advance()
   // Play sounds
 
   if (previousPumpPos >= 0.1f && m_previousPumpPos < 0.1f)
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PumpUp"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PumpUp"));
   else if (previousPumpPos <= 0.9f && m_previousPumpPos > 0.9f)
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PumpDown"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PumpDown"));
 
   return FuelBuilding::Advance();
 }
@@ -256,12 +286,12 @@ bool FuelPipe::Advance()
 
   if (m_currentLevel > 0.2f && !m_pumpSoundActive)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PumpFuel"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PumpFuel"));
     m_pumpSoundActive = true;
   }
   else if (m_currentLevel <= 0.2f && m_pumpSoundActive)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "FuelPipe PumpFuel"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "FuelPipe PumpFuel"));
     m_pumpSoundActive = false;
   }
 
@@ -352,10 +382,10 @@ bool FuelStation::BoardRocket(WorldObjectId _id)
       for (int i = 0; i < numFlashes; ++i)
       {
         LegacyVector3 vel(sfrand(15.0f), frand(35.0f), sfrand(15.0f));
-        g_simEventQueue.Push(SimEvent::MakeParticle(entityPos, vel, SimParticle::TypeControlFlash));
+        g_context->m_simEventQueue.Push(SimEvent::MakeParticle(entityPos, vel, SimParticle::TypeControlFlash));
       }
 
-      g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "LoadPassenger"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "LoadPassenger"));
     }
 
     return result;
@@ -445,10 +475,10 @@ void EscapeRocket::SetupSounds()
   if (requiredSoundName != m_activeSoundName)
   {
     // Stop all ambience sounds for this rocket
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
 
     if (requiredSoundName)
-      g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, requiredSoundName));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, requiredSoundName));
 
     m_activeSoundName = requiredSoundName;
 
@@ -463,12 +493,12 @@ void EscapeRocket::SetupSounds()
 
   if (wantEngine && !m_engineSoundActive)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "EngineBurn"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "EngineBurn"));
     m_engineSoundActive = true;
   }
   else if (!wantEngine && m_engineSoundActive)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "EscapeRocket EngineBurn"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "EscapeRocket EngineBurn"));
     m_engineSoundActive = false;
   }
 }
@@ -593,14 +623,18 @@ void EscapeRocket::AdvanceIgnition()
     if (m_spawnCompleted)
     {
       m_countdown = 10.0f;
-      g_context->m_taskManagerInterface->SetVisible(false);
-      if (g_context->m_script->IsRunningScript())
-        g_context->m_script->Skip();
+      if (g_context->m_taskManagerInterface)
+        g_context->m_taskManagerInterface->SetVisible(false);
+      if (Script* script = g_context->m_script)
+      {
+        if (script->IsRunningScript())
+          script->Skip();
 #ifdef DEMOBUILD
-      g_context->m_script->RunScript("launchpad_victory_demo.txt");
+        script->RunScript("launchpad_victory_demo.txt");
 #else
-      g_context->m_script->RunScript("launchpad_victory.txt");
+        script->RunScript("launchpad_victory.txt");
 #endif
+      }
     }
   }
 }
@@ -698,7 +732,7 @@ void EscapeRocket::AdvanceExploding()
   if (m_fuel > 0.0f)
   {
     Matrix34 mat(m_front, g_upVector, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 0.001f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 0.001f));
   }
 
   //
@@ -719,8 +753,8 @@ void EscapeRocket::AdvanceExploding()
     float smokeSize = fireSize;
 
     if (m_fuel > 0.0f)
-      g_simEventQueue.Push(SimEvent::MakeParticle(windowMat.pos, vel, SimParticle::TypeFire, fireSize));
-    g_simEventQueue.Push(SimEvent::MakeParticle(windowMat.pos, smokeVel, SimParticle::TypeMissileTrail, smokeSize));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(windowMat.pos, vel, SimParticle::TypeFire, fireSize));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(windowMat.pos, smokeVel, SimParticle::TypeMissileTrail, smokeSize));
   }
 
   if (m_damage <= 0.0f)
@@ -739,20 +773,13 @@ void EscapeRocket::SetupSpectacle()
     for (int t = 0; t < NUM_TEAMS; ++t)
     {
       Team* team = &g_context->m_location->m_teams[t];
-      for (int i = 0; i < team->m_others.Size(); ++i)
+      for (int i : team->GetOthers(Entity::TypeDarwinian))
       {
-        if (team->m_others.ValidIndex(i))
-        {
-          Entity* entity = team->m_others[i];
-          if (entity && entity->m_type == Entity::TypeDarwinian)
-          {
-            auto darwinian = static_cast<Darwinian*>(entity);
-            //if( m_state == StateReady ) darwinian->CastShadow( m_id.GetUniqueId() );
-            // Causes too much of a slow down, and doesn't add much visually to the scene
-            if (t == 0 && darwinian->m_state == Darwinian::StateIdle && (syncrand() % 10) < 2)
-              darwinian->WatchSpectacle(m_id.GetUniqueId());
-          }
-        }
+        auto darwinian = static_cast<Darwinian*>(team->m_others[i]);
+        //if( m_state == StateReady ) darwinian->CastShadow( m_id.GetUniqueId() );
+        // Causes too much of a slow down, and doesn't add much visually to the scene
+        if (t == 0 && darwinian->m_state == Darwinian::StateIdle && (syncrand() % 10) < 2)
+          darwinian->WatchSpectacle(m_id.GetUniqueId());
       }
     }
 
@@ -802,11 +829,43 @@ void EscapeRocket::Damage(float _damage)
     if (m_damage > 100.0f)
     {
       m_state = StateExploding;
-      g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
     }
   }
 }
 
+void EscapeRocket::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  FuelBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_shadowTimer);
+  _writer.Write(m_cameraShake);
+  WriteSnapshotVector(_writer, m_vel);
+  _writer.Write(m_state);
+  _writer.Write(m_fuel);
+  _writer.Write(m_pipeCount);
+  _writer.Write(m_passengers);
+  _writer.Write(m_countdown);
+  _writer.Write(m_damage);
+  _writer.Write(m_spawnBuildingId);
+  _writer.Write(m_spawnCompleted);
+}
+
+void EscapeRocket::ReadSnapshot(SnapshotReader& _reader)
+{
+  FuelBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_shadowTimer);
+  _reader.Read(m_cameraShake);
+  ReadSnapshotVector(_reader, m_vel);
+  _reader.Read(m_state);
+  _reader.Read(m_fuel);
+  _reader.Read(m_pipeCount);
+  _reader.Read(m_passengers);
+  _reader.Read(m_countdown);
+  _reader.Read(m_damage);
+  _reader.Read(m_spawnBuildingId);
+  _reader.Read(m_spawnCompleted);
+}
+
 bool EscapeRocket::Advance()
 {
   switch (m_state)
@@ -845,7 +904,8 @@ bool EscapeRocket::Advance()
     m_cameraShake -= SERVER_ADVANCE_PERIOD;
 
     float actualShake = m_cameraShake / 5.0f;
-    g_context->m_camera->CreateCameraShake(actualShake);
+    if (g_context->m_camera)
+      g_context->m_camera->CreateCameraShake(actualShake);
   }
 
   if (m_state == StateReady || m_state == StateCountdown || m_state == StateFlight)
@@ -865,10 +925,10 @@ bool EscapeRocket::Advance()
       {
         vel.x *= 0.75f;
         vel.z *= 0.75f;
-        g_simEventQueue.Push(SimEvent::MakeParticle(pos, vel, SimParticle::TypeMissileTrail, size));
+        g_context->m_simEventQueue.Push(SimEvent::MakeParticle(pos, vel, SimParticle::TypeMissileTrail, size));
       }
       else
-        g_simEventQueue.Push(SimEvent::MakeParticle(pos, vel, SimParticle::TypeMissileFire, size));
+        g_context->m_simEventQueue.Push(SimEvent::MakeParticle(pos, vel, SimParticle::TypeMissileFire, size));
     }
   }
 
@@ -25,6 +25,8 @@ class FuelBuilding : public Building
     FuelBuilding* GetLinkedBuilding() const;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     bool IsInView() override;
 
@@ -59,6 +61,8 @@ class FuelGenerator : public FuelBuilding
     void ProvideSurge();
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     const char* GetObjectiveCounter() override;
 };
@@ -153,6 +157,8 @@ class EscapeRocket : public FuelBuilding
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void ProvideFuel(float _level) override;
     bool SafeToLaunch();
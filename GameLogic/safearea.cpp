@@ -30,6 +30,26 @@ void SafeArea::Initialise(Building* _template)
   m_centerPos = m_pos + LegacyVector3(0, m_radius / 2, 0);
 }
 
+void SafeArea::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_size);
+  _writer.Write(m_entitiesRequired);
+  _writer.Write(m_entityTypeRequired);
+  WriteSnapshotTime(_writer, m_recountTimer);
+  _writer.Write(m_entitiesCounted);
+}
+
+void SafeArea::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_size);
+  _reader.Read(m_entitiesRequired);
+  _reader.Read(m_entityTypeRequired);
+  ReadSnapshotTime(_reader, m_recountTimer);
+  _reader.Read(m_entitiesCounted);
+}
+
 bool SafeArea::Advance()
 {
   //
@@ -19,6 +19,8 @@ public:
 
     void Initialise ( Building *_template );
     bool Advance    ();
+    void WriteSnapshot ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot ( SnapshotReader &_reader );
 
     bool DoesSphereHit          (LegacyVector3 const &_pos, float _radius);
     bool DoesShapeHit           (ShapeStatic *_shape, Matrix34 _transform);
@@ -41,13 +41,36 @@ void ScriptTrigger::Trigger()
   if (strstr(m_scriptFilename, ".txt"))
   {
     // Run a script, speficied by filename
-    g_context->m_script->RunScript(m_scriptFilename);
+    if (g_context->m_script)
+      g_context->m_script->RunScript(m_scriptFilename);
     m_triggered = -1;
   }
   else
     m_triggered = 1;
 }
 
+void ScriptTrigger::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.WriteString(m_scriptFilename);
+  _writer.Write(m_range);
+  _writer.Write(m_entityType);
+  _writer.Write(m_linkId);
+  _writer.Write(m_triggered);
+  _writer.Write(m_timer);
+}
+
+void ScriptTrigger::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.ReadString(m_scriptFilename, sizeof(m_scriptFilename));
+  _reader.Read(m_range);
+  _reader.Read(m_entityType);
+  _reader.Read(m_linkId);
+  _reader.Read(m_triggered);
+  _reader.Read(m_timer);
+}
+
 bool ScriptTrigger::Advance()
 {
   if (m_entityType != SCRIPTRIGGER_RUNNEVER)
@@ -58,7 +81,9 @@ bool ScriptTrigger::Advance()
       return true;
     }
     if (m_triggered <= 0) {
-      bool alreadyRunningScript = g_context->m_script->IsRunningScript() || !g_context->m_camera->IsInteractive();
+      // A headless match has neither, so only the entity triggers fire there
+      Camera* camera = g_context->m_camera;
+      bool alreadyRunningScript = (g_context->m_script && g_context->m_script->IsRunningScript()) || (camera && !camera->IsInteractive());
 
       if (!alreadyRunningScript)
       {
@@ -73,19 +98,25 @@ bool ScriptTrigger::Advance()
             Trigger();
           else if (m_entityType == SCRIPTRIGGER_RUNCAMENTER)
           {
-            float camDistance = (g_context->m_camera->GetPos() - m_pos).Mag();
-            LegacyVector3 camVel = g_context->m_camera->GetVel();
-            bool camInteractive = g_context->m_camera->IsInteractive();
+            if (!camera)
+              return Building::Advance();
+
+            float camDistance = (camera->GetPos() - m_pos).Mag();
+            LegacyVector3 camVel = camera->GetVel();
+            bool camInteractive = camera->IsInteractive();
 
             if (camDistance <= m_range && camVel.Mag() < 5.0f && camInteractive)
               Trigger();
           }
           else if (m_entityType == SCRIPTRIGGER_RUNCAMVIEW)
           {
-            float camDistance = (g_context->m_camera->GetPos() - m_pos).Mag();
-            LegacyVector3 camVel = g_context->m_camera->GetVel();
-            bool camInteractive = g_context->m_camera->IsInteractive();
-            bool inView = RaySphereIntersection(g_context->m_camera->GetPos(), g_context->m_camera->GetFront(), m_pos, m_range);
+            if (!camera)
+              return Building::Advance();
+
+            float camDistance = (camera->GetPos() - m_pos).Mag();
+            LegacyVector3 camVel = camera->GetVel();
+            bool camInteractive = camera->IsInteractive();
+            bool inView = RaySphereIntersection(camera->GetPos(), camera->GetFront(), m_pos, m_range);
 
             if (camDistance <= (m_range + 300.0f) && camVel.Mag() < 5.0f && camInteractive && inView)
               Trigger();
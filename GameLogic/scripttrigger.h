@@ -26,6 +26,8 @@ public:
 
     void Initialise     ( Building *_template );
     bool Advance        ();
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
 
     void Trigger();
 
@@ -21,6 +21,28 @@ Snow::Snow()
   m_type = EffectSnow;
 }
 
+void Snow::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  WriteSnapshotTime(_writer, m_timeSync);
+  _writer.Write(m_positionOffset);
+  _writer.Write(m_xaxisRate);
+  _writer.Write(m_yaxisRate);
+  _writer.Write(m_zaxisRate);
+  WriteSnapshotVector(_writer, m_hover);
+}
+
+void Snow::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  ReadSnapshotTime(_reader, m_timeSync);
+  _reader.Read(m_positionOffset);
+  _reader.Read(m_xaxisRate);
+  _reader.Read(m_yaxisRate);
+  _reader.Read(m_zaxisRate);
+  ReadSnapshotVector(_reader, m_hover);
+}
+
 bool Snow::Advance()
 {
   m_vel *= 0.9f;
@@ -20,6 +20,8 @@ public:
     Snow();
 
     bool Advance();
+    void WriteSnapshot(SnapshotWriter& _writer) const;
+    void ReadSnapshot(SnapshotReader& _reader);
 
     float GetLife();                        // Returns 0.0f-1.0f (0.0f=dead, 1.0f=alive)
 };
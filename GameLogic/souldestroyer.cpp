@@ -68,15 +68,15 @@ void SoulDestroyer::ChangeHealth(int _amount)
     Panic(2.0f + syncfrand(2.0f));
 
     Matrix34 transform(m_front, m_up, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
 
     if (m_dead)
     {
       // We just died
       for (int i = 1; i < m_positionHistory.Size(); i += 1)
       {
-        LegacyVector3 pos1 = *m_positionHistory.GetPointer(i);
-        LegacyVector3 pos2 = *m_positionHistory.GetPointer(i - 1);
+        const LegacyVector3& pos1 = m_positionHistory[i];
+        const LegacyVector3& pos2 = m_positionHistory[i - 1];
 
         LegacyVector3 pos = pos1 + (pos2 - pos1);
         LegacyVector3 front = (pos2 - pos1).Normalise();
@@ -94,12 +94,40 @@ void SoulDestroyer::ChangeHealth(int _amount)
         tailMat.r *= scale;
         tailMat.f *= scale;
 
-        g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, tailMat, 1.0f));
+        g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, tailMat, 1.0f));
       }
     }
   }
 }
 
+void SoulDestroyer::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_targetPos);
+  WriteSnapshotVector(_writer, m_up);
+  WriteSnapshotId(_writer, m_targetEntity);
+  WriteSnapshotHistory(_writer, m_positionHistory);
+  WriteSnapshotArray(_writer, m_spirits, [&](int _index) { _writer.Write(m_spirits[_index]); });
+  _writer.Write(m_retargetTimer);
+  _writer.Write(m_panic);
+  for (const LegacyVector3& position : m_spiritPosition)
+    WriteSnapshotVector(_writer, position);
+}
+
+void SoulDestroyer::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_targetPos);
+  ReadSnapshotVector(_reader, m_up);
+  ReadSnapshotId(_reader, m_targetEntity);
+  ReadSnapshotHistory(_reader, m_positionHistory);
+  ReadSnapshotArray(_reader, m_spirits, [&](int) { return _reader.Read<float>(); });
+  _reader.Read(m_retargetTimer);
+  _reader.Read(m_panic);
+  for (LegacyVector3& position : m_spiritPosition)
+    ReadSnapshotVector(_reader, position);
+}
+
 bool SoulDestroyer::Advance(Unit* _unit)
 {
   if (m_dead)
@@ -142,6 +170,14 @@ bool SoulDestroyer::Advance(Unit* _unit)
 
   RecordHistoryPosition();
 
+  // Captured spirits fade out over a minute
+  const float timeNow = static_cast<float>(GetHighResTime());
+  for (int i = 0; i < m_spirits.Size(); ++i)
+  {
+    if (m_spirits.ValidIndex(i) && timeNow >= m_spirits[i] + 60.0f)
+      m_spirits.MarkNotUsed(i);
+  }
+
   if (m_panic < 0.1f)
     Attack(m_pos);
 
@@ -163,7 +199,7 @@ void SoulDestroyer::Attack(const LegacyVector3& _pos)
     float distance = pushVector.Mag();
     if (distance < SOULDESTROYER_DAMAGERANGE)
     {
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
 
       pushVector.SetLength(SOULDESTROYER_DAMAGERANGE - distance);
 
@@ -183,7 +219,7 @@ void SoulDestroyer::Attack(const LegacyVector3& _pos)
       int spiritIndex = g_context->m_location->GetSpirit(id);
       if (spiritIndex != -1)
       {
-        g_context->m_location->m_spirits.MarkNotUsed(spiritIndex);
+        g_context->m_location->RemoveSpirit(spiritIndex);
         if (m_spirits.NumUsed() < SOULDESTROYER_MAXSPIRITS)
           m_spirits.PutData(static_cast<float>(GetHighResTime()));
         else
@@ -211,7 +247,7 @@ void SoulDestroyer::Attack(const LegacyVector3& _pos)
 void SoulDestroyer::Panic(float _time)
 {
   if (m_panic <= 0.0f)
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Panic"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Panic"));
 
   m_panic = std::max(_time, m_panic);
 }
@@ -268,7 +304,7 @@ bool SoulDestroyer::SearchForTargetEnemy()
   if (targetId.IsValid())
   {
     m_targetEntity = targetId;
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnemySighted"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "EnemySighted"));
     return true;
   }
   m_targetEntity.SetInvalid();
@@ -310,15 +346,14 @@ void SoulDestroyer::RecordHistoryPosition()
 {
   Matrix34 mat(m_front, m_up, m_pos);
   LegacyVector3 tailPos = s_shapeHead->GetMarkerWorldMatrix(s_tailMarker, mat).pos;
-  m_positionHistory.PutDataAtStart(tailPos);
+  m_positionHistory.Push(tailPos);
 
   //int maxHistorys = 11;
   int maxHistorys = m_roamRange / 30.0f;
-  maxHistorys = std::max(9, maxHistorys);
-  maxHistorys = std::min(25, maxHistorys);
+  maxHistorys = std::max(SOULDESTROYER_MINHISTORY, maxHistorys);
+  maxHistorys = std::min(SOULDESTROYER_MAXHISTORY, maxHistorys);
 
-  for (int i = maxHistorys; i < m_positionHistory.Size(); ++i)
-    m_positionHistory.RemoveData(i);
+  m_positionHistory.Truncate(maxHistorys);
 }
 
 bool SoulDestroyer::GetTrailPosition(LegacyVector3& _pos, LegacyVector3& _vel)
@@ -326,8 +361,8 @@ bool SoulDestroyer::GetTrailPosition(LegacyVector3& _pos, LegacyVector3& _vel)
   if (m_positionHistory.Size() < 2)
     return false;
 
-  LegacyVector3 pos1 = *m_positionHistory.GetPointer(1);
-  LegacyVector3 pos2 = *m_positionHistory.GetPointer(0);
+  const LegacyVector3& pos1 = m_positionHistory[1];
+  const LegacyVector3& pos2 = m_positionHistory[0];
 
   _pos = pos1 + (pos2 - pos1);
   _vel = (pos2 - pos1) / SERVER_ADVANCE_PERIOD;
@@ -390,6 +425,32 @@ Zombie::Zombie()
   m_type = EffectZombie;
 }
 
+void Zombie::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_front);
+  WriteSnapshotVector(_writer, m_up);
+  _writer.Write(m_life);
+  WriteSnapshotVector(_writer, m_hover);
+  _writer.Write(m_positionOffset);
+  _writer.Write(m_xaxisRate);
+  _writer.Write(m_yaxisRate);
+  _writer.Write(m_zaxisRate);
+}
+
+void Zombie::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_front);
+  ReadSnapshotVector(_reader, m_up);
+  _reader.Read(m_life);
+  ReadSnapshotVector(_reader, m_hover);
+  _reader.Read(m_positionOffset);
+  _reader.Read(m_xaxisRate);
+  _reader.Read(m_yaxisRate);
+  _reader.Read(m_zaxisRate);
+}
+
 bool Zombie::Advance()
 {
   m_life += SERVER_ADVANCE_PERIOD;
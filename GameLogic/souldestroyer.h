@@ -2,11 +2,14 @@
 
 #include "entity.h"
 #include "fast_darray.h"
+#include "HistoryRing.h"
 
 #define SOULDESTROYER_MINSEARCHRANGE       200.0f
 #define SOULDESTROYER_MAXSEARCHRANGE       300.0f
 #define SOULDESTROYER_DAMAGERANGE          25.0f
 #define SOULDESTROYER_MAXSPIRITS           50
+#define SOULDESTROYER_MINHISTORY           9
+#define SOULDESTROYER_MAXHISTORY           25
 
 class ShapeStatic;
 
@@ -18,7 +21,7 @@ class SoulDestroyer : public Entity
     LegacyVector3 m_targetPos;
     LegacyVector3 m_up;
     WorldObjectId m_targetEntity;
-    LList<LegacyVector3> m_positionHistory;
+    Neuron::HistoryRing<LegacyVector3, 32> m_positionHistory; // Newest first
     FastDArray<float> m_spirits;
 
     float m_retargetTimer;
@@ -45,6 +48,8 @@ class SoulDestroyer : public Entity
 
     void Begin() override;
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void ChangeHealth(int _amount) override;
 
     void Attack(const LegacyVector3& _pos) override;
@@ -68,4 +73,6 @@ class Zombie : public WorldObject
     Zombie();
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
@@ -61,7 +61,7 @@ void Spam::Damage(float _damage)
     percentDead = std::min(percentDead, 1.0f);
     percentDead = std::max(percentDead, 0.0f);
     Matrix34 mat(m_front, g_upVector, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, percentDead));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, percentDead));
   }
 
   if (!dead && m_damage <= 0.0f)
@@ -70,7 +70,7 @@ void Spam::Damage(float _damage)
     GlobalBuilding* gb = g_context->m_globalWorld->GetBuilding(m_id.GetUniqueId(), g_context->m_locationId);
     if (gb)
       gb->m_online = true;
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Explode"));
   }
 }
 
@@ -100,7 +100,27 @@ void Spam::SpawnInfection()
     infection->m_id.GenerateUniqueId();
   }
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Attack"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Attack"));
+}
+
+void Spam::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_timer);
+  _writer.Write(m_damage);
+  _writer.Write(m_research);
+  _writer.Write(m_onGround);
+  _writer.Write(m_activated);
+}
+
+void Spam::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_timer);
+  _reader.Read(m_damage);
+  _reader.Read(m_research);
+  _reader.Read(m_onGround);
+  _reader.Read(m_activated);
 }
 
 bool Spam::Advance()
@@ -178,7 +198,7 @@ bool Spam::Advance()
   }
 
   if (m_research)
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "Spam Create"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "Spam Create"));
 
   return Building::Advance();
 }
@@ -194,7 +214,7 @@ void Spam::SetAsResearch()
   m_research = true;
   m_activated = false;
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "CreateResearch"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "CreateResearch"));
 }
 
 // ============================================================================
@@ -339,7 +359,7 @@ void SpamInfection::AdvanceAttackingEntity()
       {
         g_context->m_location->SpawnEntities(target->m_pos, 1, -1, Entity::TypeDarwinian, 1, target->m_vel, 0.0f);
         g_context->m_location->m_entityGrid->RemoveObject(m_targetId, target->m_pos.x, target->m_pos.z, target->m_radius);
-        g_context->m_location->m_teams[0].m_others.MarkNotUsed(m_targetId.GetIndex());
+        g_context->m_location->m_teams[0].RemoveOther(m_targetId.GetIndex());
         delete target;
       }
       else
@@ -357,7 +377,7 @@ void SpamInfection::AdvanceAttackingEntity()
       LegacyVector3 vel(sfrand(15.0f), frand(15.0f), sfrand(15.0f));
       float size = i * 30;
       LegacyVector3 pos = m_pos + LegacyVector3(0, 50, 0);
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeFire, size));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeFire, size));
     }
 
     m_life += 1.0f;
@@ -393,7 +413,7 @@ void SpamInfection::AdvanceAttackingSpirit()
     if (syncfrand(20.0f) < 1.0f)
       entityType = Entity::TypeSpider;
     g_context->m_location->SpawnEntities(spirit->m_pos, 1, -1, entityType, 1, g_zeroVector, 0.0f, 200.0f);
-    g_context->m_location->m_spirits.MarkNotUsed(m_spiritId);
+    g_context->m_location->RemoveSpirit(m_spiritId);
 
     int numFlashes = 5 + darwiniaRandom() % 5;
     for (int i = 0; i < numFlashes; ++i)
@@ -401,7 +421,7 @@ void SpamInfection::AdvanceAttackingSpirit()
       LegacyVector3 vel(sfrand(15.0f), frand(15.0f), sfrand(15.0f));
       float size = i * 30;
       LegacyVector3 pos = m_pos + LegacyVector3(0, 50, 0);
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeFire, size));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeFire, size));
     }
 
     m_life += 1.0f;
@@ -425,6 +445,32 @@ bool SpamInfection::AdvanceToTargetPosition()
   return (distance < 20.0f);
 }
 
+void SpamInfection::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  _writer.Write(m_retargetTimer);
+  WriteSnapshotId(_writer, m_targetId);
+  _writer.Write(m_spiritId);
+  WriteSnapshotVector(_writer, m_targetPos);
+  _writer.Write(m_life);
+  WriteSnapshotList(_writer, m_positionHistory);
+  _writer.Write(m_parentId);
+}
+
+void SpamInfection::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  _reader.Read(m_retargetTimer);
+  ReadSnapshotId(_reader, m_targetId);
+  _reader.Read(m_spiritId);
+  ReadSnapshotVector(_reader, m_targetPos);
+  _reader.Read(m_life);
+  ReadSnapshotList(_reader, m_positionHistory);
+  _reader.Read(m_parentId);
+}
+
 bool SpamInfection::Advance()
 {
   switch (m_state)
@@ -25,6 +25,8 @@ class Spam : public Building
     void Destroy(float _intensity) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void SetAsResearch();
     void SendFromHeaven();
@@ -73,4 +75,6 @@ class SpamInfection : public WorldObject
     SpamInfection();
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
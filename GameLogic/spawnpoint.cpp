@@ -141,6 +141,8 @@ LegacyVector3 SpawnBuilding::GetSpiritLink() const
 
 void SpawnBuilding::TriggerSpirit(SpawnBuildingSpirit* _spirit)
 {
+  Wake();
+
   int numAdds = 0;
 
   for (int i = 0; i < m_links.Size(); ++i)
@@ -165,6 +167,53 @@ void SpawnBuilding::TriggerSpirit(SpawnBuildingSpirit* _spirit)
   }
 }
 
+void SpawnBuilding::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.WriteCount(m_links.Size());
+  for (int i = 0; i < m_links.Size(); ++i)
+  {
+    const SpawnBuildingLink* link = m_links.GetData(i);
+    _writer.Write(link->m_targetBuildingId);
+    WriteSnapshotList(_writer, link->m_targets);
+    _writer.WriteCount(link->m_spirits.Size());
+    for (int j = 0; j < link->m_spirits.Size(); ++j)
+    {
+      const SpawnBuildingSpirit* spirit = link->m_spirits.GetData(j);
+      _writer.Write(spirit->m_targetBuildingId);
+      _writer.Write(spirit->m_currentProgress);
+    }
+  }
+  WriteSnapshotVector(_writer, m_visibilityMidpoint);
+  _writer.Write(m_visibilityRadius);
+}
+
+void SpawnBuilding::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  for (int i = 0; i < m_links.Size(); ++i)
+    m_links.GetData(i)->m_spirits.EmptyAndDelete();
+  m_links.EmptyAndDelete();
+  const int numLinks = _reader.ReadCount();
+  for (int i = 0; i < numLinks; ++i)
+  {
+    auto link = new SpawnBuildingLink();
+    _reader.Read(link->m_targetBuildingId);
+    ReadSnapshotList(_reader, link->m_targets);
+    const int numSpirits = _reader.ReadCount();
+    for (int j = 0; j < numSpirits; ++j)
+    {
+      auto spirit = new SpawnBuildingSpirit();
+      _reader.Read(spirit->m_targetBuildingId);
+      _reader.Read(spirit->m_currentProgress);
+      link->m_spirits.PutDataAtEnd(spirit);
+    }
+    m_links.PutDataAtEnd(link);
+  }
+  ReadSnapshotVector(_reader, m_visibilityMidpoint);
+  _reader.Read(m_visibilityRadius);
+}
+
 bool SpawnBuilding::Advance()
 {
   //
@@ -223,9 +272,23 @@ SpawnLink::SpawnLink()
   SetShape(Resource::GetShapeStatic("spawnlink.shp"));
 }
 
-// ============================================================================
+bool SpawnLink::Advance()
+{
+  bool removeBuilding = SpawnBuilding::Advance();
+  if (removeBuilding || GetNumPorts() != 0)
+    return removeBuilding;
+
+  for (int i = 0; i < m_links.Size(); ++i)
+  {
+    if (m_links[i]->m_spirits.Size() > 0)
+      return false;
+  }
+
+  Sleep(); // Until the next spirit arrives
+  return false;
+}
 
-int MasterSpawnPoint::s_masterSpawnPointId = -1;
+// ============================================================================
 
 MasterSpawnPoint::MasterSpawnPoint()
   : SpawnBuilding(),
@@ -238,7 +301,7 @@ MasterSpawnPoint::MasterSpawnPoint()
 
 MasterSpawnPoint* MasterSpawnPoint::GetMasterSpawnPoint()
 {
-  Building* building = g_context->m_location->GetBuilding(s_masterSpawnPointId);
+  Building* building = g_context->m_location->GetBuilding(g_context->m_location->m_statics.m_masterSpawnPointId);
   if (building && building->m_type == TypeSpawnPointMaster)
     return static_cast<MasterSpawnPoint*>(building);
 
@@ -252,9 +315,21 @@ void MasterSpawnPoint::RequestSpirit(int _targetBuildingId)
   TriggerSpirit(spirit);
 }
 
+void MasterSpawnPoint::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  SpawnBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_exploreLinks);
+}
+
+void MasterSpawnPoint::ReadSnapshot(SnapshotReader& _reader)
+{
+  SpawnBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_exploreLinks);
+}
+
 bool MasterSpawnPoint::Advance()
 {
-  s_masterSpawnPointId = m_id.GetUniqueId();
+  g_context->m_location->m_statics.m_masterSpawnPointId = m_id.GetUniqueId();
 
   //
   // Explore our links first time through
@@ -432,6 +507,24 @@ bool SpawnPoint::PerformDepthSort(LegacyVector3& _centerPos)
   return true;
 }
 
+void SpawnPoint::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  SpawnBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_evaluateTimer);
+  _writer.Write(m_spawnTimer);
+  _writer.Write(m_populationLock);
+  _writer.Write(m_numFriendsNearby);
+}
+
+void SpawnPoint::ReadSnapshot(SnapshotReader& _reader)
+{
+  SpawnBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_evaluateTimer);
+  _reader.Read(m_spawnTimer);
+  _reader.Read(m_populationLock);
+  _reader.Read(m_numFriendsNearby);
+}
+
 bool SpawnPoint::Advance()
 {
   //
@@ -479,9 +572,6 @@ bool SpawnPoint::Advance()
 
 // ============================================================================
 
-float SpawnPopulationLock::s_overpopulationTimer = 0.0f;
-int SpawnPopulationLock::s_overpopulation = 0;
-
 SpawnPopulationLock::SpawnPopulationLock()
   : Building(),
     m_searchRadius(500.0f),
@@ -508,6 +598,28 @@ void SpawnPopulationLock::Initialise(Building* _template)
   m_originalMaxPopulation = m_maxPopulation;
 }
 
+void SpawnPopulationLock::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_searchRadius);
+  _writer.Write(m_maxPopulation);
+  _writer.Write(m_teamCount);
+  _writer.Write(m_originalMaxPopulation);
+  _writer.Write(m_recountTimer);
+  _writer.Write(m_recountTeamId);
+}
+
+void SpawnPopulationLock::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_searchRadius);
+  _reader.Read(m_maxPopulation);
+  _reader.Read(m_teamCount);
+  _reader.Read(m_originalMaxPopulation);
+  _reader.Read(m_recountTimer);
+  _reader.Read(m_recountTeamId);
+}
+
 bool SpawnPopulationLock::Advance()
 {
   //
@@ -516,9 +628,10 @@ bool SpawnPopulationLock::Advance()
   // This only really applies to Green darwinians, as the player can arrange
   // it so an unlimited army gathers on a single island
 
-  if (GetHighResTime() > s_overpopulationTimer)
+  LocationStatics& statics = g_context->m_location->m_statics;
+  if (GetHighResTime() > statics.m_overpopulationTimer)
   {
-    s_overpopulationTimer = GetHighResTime() + 1.0f;
+    statics.m_overpopulationTimer = GetHighResTime() + 1.0f;
 
     int totalOverpopulation = 0;
 
@@ -536,10 +649,10 @@ bool SpawnPopulationLock::Advance()
       }
     }
 
-    s_overpopulation = totalOverpopulation / 2;
+    statics.m_overpopulation = totalOverpopulation / 2;
   }
 
-  m_maxPopulation = m_originalMaxPopulation - s_overpopulation;
+  m_maxPopulation = m_originalMaxPopulation - statics.m_overpopulation;
   m_maxPopulation = std::max(m_maxPopulation, 0);
 
   //
@@ -40,6 +40,8 @@ public:
 
     void            Initialise  ( Building *_template );
     bool            Advance     ();
+    void            WriteSnapshot ( SnapshotWriter &_writer ) const;
+    void            ReadSnapshot ( SnapshotReader &_reader );
 
     virtual void    TriggerSpirit   ( SpawnBuildingSpirit *_spirit );
 
@@ -61,6 +63,8 @@ class SpawnLink : public SpawnBuilding
 {
 public:
     SpawnLink();
+
+    bool Advance();
 };
 
 
@@ -69,13 +73,14 @@ public:
 class MasterSpawnPoint : public SpawnBuilding
 {
 protected:
-    static int s_masterSpawnPointId;
     bool m_exploreLinks;
 
 public:
     MasterSpawnPoint();
 
     bool Advance();
+    void WriteSnapshot( SnapshotWriter &_writer ) const;
+    void ReadSnapshot( SnapshotReader &_reader );
 
     void RequestSpirit( int _targetBuildingId );
 
@@ -105,6 +110,8 @@ public:
     SpawnPoint();
 
     bool            Advance();
+    void WriteSnapshot( SnapshotWriter &_writer ) const;
+    void ReadSnapshot( SnapshotReader &_reader );
 
     bool PerformDepthSort( LegacyVector3 &_centerPos );
 
@@ -123,8 +130,6 @@ public:
     int     m_teamCount[NUM_TEAMS];
 
 protected:
-    static float    s_overpopulationTimer;
-    static int      s_overpopulation;
     int             m_originalMaxPopulation;
     float           m_recountTimer;
     int             m_recountTeamId;
@@ -134,6 +139,8 @@ public:
 
     void    Initialise      ( Building *_template );
     bool    Advance         ();
+    void    WriteSnapshot   ( SnapshotWriter &_writer ) const;
+    void    ReadSnapshot    ( SnapshotReader &_reader );
     void Read   ( TextReader *_in, bool _dynamic );
     void Write  ( FileWriter *_out );
 
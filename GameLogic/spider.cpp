@@ -116,7 +116,7 @@ void Spider::ChangeHealth(int _amount)
     fractionDead = std::max(fractionDead, 0.0f);
     fractionDead = std::min(fractionDead, 1.0f);
     Matrix34 transform(m_front, m_up, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
   }
 }
 
@@ -158,7 +158,7 @@ void Spider::StompFoot(const LegacyVector3& _pos)
   {
     LegacyVector3 vel(syncsfrand(20.0f), 5.0f + syncfrand(5.0f), syncsfrand(20.0f));
 
-    g_simEventQueue.Push(SimEvent::MakeParticle(_pos, vel, SimParticle::TypeMuzzleFlash, 10.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(_pos, vel, SimParticle::TypeMuzzleFlash, 10.0f));
   }
 
   //
@@ -235,7 +235,7 @@ void Spider::UpdateLegs()
     //		}
 
     if (footPlanted)
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "FootFall"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "FootFall"));
   }
 
   m_delayBetweenLifts = m_parameters[stage].m_delayBetweenLifts;
@@ -416,8 +416,8 @@ bool Spider::AdvanceAttack()
         m_legs[i]->m_foot.m_targetPos = m_legs[i]->m_foot.m_pos + forwards;
       }
 
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Pounce"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Pounce"));
     }
   }
 
@@ -441,7 +441,7 @@ bool Spider::AdvancePouncing()
     for (int i = 0; i < SPIDER_NUM_LEGS; ++i)
       m_legs[i]->m_foot.m_state = EntityFoot::OnGround;
 
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "PounceLand"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "PounceLand"));
 
     // Squash people
     float squashRange = 40.0f;
@@ -581,7 +581,7 @@ bool Spider::AdvanceEggLaying()
 
     g_context->m_location->SpawnEntities(eggLayMat.pos, m_id.GetTeamId(), -1, TypeEgg, 1, g_zeroVector, 0.0f);
 
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LayEgg"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LayEgg"));
 
     m_spiritId = -1;
     m_state = StateIdle;
@@ -590,6 +590,42 @@ bool Spider::AdvanceEggLaying()
   return false;
 }
 
+void Spider::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  WriteSnapshotTime(_writer, m_nextLegMoveTime);
+  _writer.Write(m_delayBetweenLifts);
+  _writer.Write(m_speed);
+  _writer.Write(m_targetHoverHeight);
+  WriteSnapshotVector(_writer, m_targetPos);
+  WriteSnapshotVector(_writer, m_up);
+  WriteSnapshotTime(_writer, m_pounceStartTime);
+  _writer.Write(m_retargetTimer);
+  WriteSnapshotVector(_writer, m_pounceTarget);
+  _writer.Write(m_spiritId);
+  for (const EntityLeg* leg : m_legs)
+    leg->WriteSnapshot(_writer);
+}
+
+void Spider::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  ReadSnapshotTime(_reader, m_nextLegMoveTime);
+  _reader.Read(m_delayBetweenLifts);
+  _reader.Read(m_speed);
+  _reader.Read(m_targetHoverHeight);
+  ReadSnapshotVector(_reader, m_targetPos);
+  ReadSnapshotVector(_reader, m_up);
+  ReadSnapshotTime(_reader, m_pounceStartTime);
+  _reader.Read(m_retargetTimer);
+  ReadSnapshotVector(_reader, m_pounceTarget);
+  _reader.Read(m_spiritId);
+  for (EntityLeg* leg : m_legs)
+    leg->ReadSnapshot(_reader);
+}
+
 bool Spider::Advance(Unit* _unit)
 {
   if (!m_dead)
@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "spirit.h"
+#include "SyncChecksum.h"
 #include "GameContext.h"
 #include "GameSimEventQueue.h"
 #include "camera.h"
@@ -35,7 +36,51 @@ void Spirit::Begin()
   m_numNearbyEggs = 0;
   m_eggSearchTimer = 0.0f;
 
-  g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "Create"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "Create"));
+}
+
+// *** GetSyncHash
+uint64_t Spirit::GetSyncHash() const
+{
+  SyncHasher hasher(WorldObject::GetSyncHash());
+  hasher.Fold(static_cast<unsigned int>(m_teamId)).Fold(m_state).Fold(m_positionOffset);
+  return hasher.Value();
+}
+
+// *** WriteSnapshot
+void Spirit::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_teamId);
+  _writer.Write(m_state);
+  WriteSnapshotId(_writer, m_worldObjectId);
+  _writer.Write(m_eggSearchTimer);
+  _writer.Write(m_positionOffset);
+  _writer.Write(m_xaxisRate);
+  _writer.Write(m_yaxisRate);
+  _writer.Write(m_zaxisRate);
+  _writer.Write(m_pushFromBuildings);
+  _writer.Write(m_timeSync);
+  WriteSnapshotVector(_writer, m_hover);
+}
+
+// *** ReadSnapshot
+// Nearby eggs are a cache; they are searched for again on the next advance
+void Spirit::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_teamId);
+  _reader.Read(m_state);
+  ReadSnapshotId(_reader, m_worldObjectId);
+  _reader.Read(m_eggSearchTimer);
+  _reader.Read(m_positionOffset);
+  _reader.Read(m_xaxisRate);
+  _reader.Read(m_yaxisRate);
+  _reader.Read(m_zaxisRate);
+  _reader.Read(m_pushFromBuildings);
+  _reader.Read(m_timeSync);
+  ReadSnapshotVector(_reader, m_hover);
+  m_numNearbyEggs = 0;
 }
 
 bool Spirit::Advance()
@@ -92,7 +137,7 @@ bool Spirit::Advance()
       if (m_timeSync <= 0.0f)
       {
         m_state = StateDeath;
-        g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "BeginAscent"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "BeginAscent"));
         m_timeSync = 180.0f;
         AddToGlobalWorld();
       }
@@ -212,7 +257,7 @@ void Spirit::AddToGlobalWorld()
 void Spirit::CollectorArrives()
 {
   m_state = StateAttached;
-  g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "PickedUp"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "PickedUp"));
 }
 
 void Spirit::CollectorDrops()
@@ -222,7 +267,7 @@ void Spirit::CollectorDrops()
   m_state = StateFloating;
   m_pushFromBuildings = true;
   //    Begin();
-  g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "Dropped"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "Dropped"));
 }
 
 void Spirit::InEgg()
@@ -230,7 +275,7 @@ void Spirit::InEgg()
   m_state = StateInEgg;
   m_vel.Zero();
   m_hover.Zero();
-  g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "PlacedInEgg"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "PlacedInEgg"));
 }
 
 void Spirit::EggDestroyed()
@@ -239,7 +284,7 @@ void Spirit::EggDestroyed()
   m_hover.Zero();
   m_state = StateFloating;
   //    Begin();
-  g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "EggDestroyed"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeSpirit, "EggDestroyed"));
 }
 
 int Spirit::NumNearbyEggs() { return m_numNearbyEggs; }
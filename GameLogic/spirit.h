@@ -45,6 +45,9 @@ public:
 
     void Begin      ();
     bool Advance    ();
+    uint64_t GetSyncHash() const override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void CollectorArrives   ();                             // A collector is above me and picks me up
     void CollectorDrops     ();                             // My collector has dropped me
@@ -57,6 +57,20 @@ bool ReceiverBuilding::IsInView()
   return Building::IsInView();
 }
 
+void ReceiverBuilding::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_spiritLink);
+  WriteSnapshotList(_writer, m_spirits);
+}
+
+void ReceiverBuilding::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_spiritLink);
+  ReadSnapshotList(_reader, m_spirits);
+}
+
 bool ReceiverBuilding::Advance()
 {
   for (int i = 0; i < m_spirits.Size(); ++i)
@@ -81,8 +95,9 @@ bool ReceiverBuilding::Advance()
 
 void ReceiverBuilding::TriggerSpirit(float _initValue)
 {
+  Wake();
   m_spirits.PutDataAtStart(_initValue);
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "TriggerSpirit"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "TriggerSpirit"));
 }
 
 void ReceiverBuilding::Read(TextReader* _in, bool _dynamic)
@@ -179,6 +194,35 @@ void SpiritProcessor::TriggerSpirit(float _initValue)
 
 bool SpiritProcessor::IsInView() { return true; }
 
+void SpiritProcessor::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  ReceiverBuilding::WriteSnapshot(_writer);
+  _writer.Write(m_timerSync);
+  _writer.Write(m_numThisSecond);
+  _writer.Write(m_spawnSync);
+  _writer.Write(m_throughput);
+  _writer.WriteCount(m_floatingSpirits.Size());
+  for (int i = 0; i < m_floatingSpirits.Size(); ++i)
+    m_floatingSpirits.GetData(i)->WriteSnapshot(_writer);
+}
+
+void SpiritProcessor::ReadSnapshot(SnapshotReader& _reader)
+{
+  ReceiverBuilding::ReadSnapshot(_reader);
+  _reader.Read(m_timerSync);
+  _reader.Read(m_numThisSecond);
+  _reader.Read(m_spawnSync);
+  _reader.Read(m_throughput);
+  m_floatingSpirits.EmptyAndDelete();
+  const int numFloating = _reader.ReadCount();
+  for (int i = 0; i < numFloating; ++i)
+  {
+    auto spirit = new UnprocessedSpirit();
+    spirit->ReadSnapshot(_reader);
+    m_floatingSpirits.PutDataAtEnd(spirit);
+  }
+}
+
 bool SpiritProcessor::Advance()
 {
   //
@@ -250,7 +294,13 @@ ReceiverLink::ReceiverLink()
   SetShape(Resource::GetShapeStatic("receiverlink.shp"));
 }
 
-bool ReceiverLink::Advance() { return ReceiverBuilding::Advance(); }
+bool ReceiverLink::Advance()
+{
+  bool removeBuilding = ReceiverBuilding::Advance();
+  if (!removeBuilding && m_spirits.Size() == 0 && GetNumPorts() == 0)
+    Sleep(); // Until the next spirit arrives
+  return removeBuilding;
+}
 
 // ****************************************************************************
 // Class ReceiverSpiritSpawner
@@ -380,6 +430,37 @@ UnprocessedSpirit::UnprocessedSpirit()
   m_timeSync = GetHighResTime();
 }
 
+void UnprocessedSpirit::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  _writer.Write(m_positionOffset);
+  _writer.Write(m_xaxisRate);
+  _writer.Write(m_yaxisRate);
+  _writer.Write(m_zaxisRate);
+  WriteSnapshotVector(_writer, m_hover);
+  // Falling spirits hold the time they were made; the later states count down
+  if (m_state == StateUnprocessedFalling)
+    WriteSnapshotTime(_writer, m_timeSync);
+  else
+    _writer.Write(m_timeSync);
+}
+
+void UnprocessedSpirit::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  _reader.Read(m_positionOffset);
+  _reader.Read(m_xaxisRate);
+  _reader.Read(m_yaxisRate);
+  _reader.Read(m_zaxisRate);
+  ReadSnapshotVector(_reader, m_hover);
+  if (m_state == StateUnprocessedFalling)
+    ReadSnapshotTime(_reader, m_timeSync);
+  else
+    _reader.Read(m_timeSync);
+}
+
 bool UnprocessedSpirit::Advance()
 {
   m_vel *= 0.9f;
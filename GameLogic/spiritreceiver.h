@@ -24,6 +24,8 @@ class ReceiverBuilding : public Building
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     bool IsInView() override;
     virtual LegacyVector3 GetSpiritLocation();
@@ -61,6 +63,8 @@ class SpiritProcessor : public ReceiverBuilding
 
     void Initialise(Building* _building) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     bool IsInView() override;
 };
 
@@ -139,5 +143,7 @@ class UnprocessedSpirit : public WorldObject
     UnprocessedSpirit();
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     float GetLife(); // Returns 0.0f-1.0f (0.0f=dead, 1.0f=alive)
 };
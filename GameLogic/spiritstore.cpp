@@ -7,6 +7,7 @@
 #include "GameContext.h"
 
 #include "spiritstore.h"
+#include "worldobject.h"
 
 
 SpiritStore::SpiritStore()
@@ -48,6 +49,31 @@ void SpiritStore::Advance()
 }
 
 
+void SpiritStore::WriteSnapshot( SnapshotWriter &_writer ) const
+{
+    WriteSnapshotVector( _writer, m_pos );
+    _writer.Write( m_sizeX );
+    _writer.Write( m_sizeY );
+    _writer.Write( m_sizeZ );
+    WriteSnapshotArray( _writer, m_spirits, [&]( int _index ) { m_spirits[_index].WriteSnapshot( _writer ); } );
+}
+
+
+void SpiritStore::ReadSnapshot( SnapshotReader &_reader )
+{
+    ReadSnapshotVector( _reader, m_pos );
+    _reader.Read( m_sizeX );
+    _reader.Read( m_sizeY );
+    _reader.Read( m_sizeZ );
+    ReadSnapshotArray( _reader, m_spirits, [&]( int )
+    {
+        Spirit spirit;
+        spirit.ReadSnapshot( _reader );
+        return spirit;
+    } );
+}
+
+
 int SpiritStore::NumSpirits ()
 {
     return m_spirits.NumUsed();
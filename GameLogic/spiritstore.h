@@ -25,6 +25,9 @@ public:
 
     void Advance    ();
 
+    void WriteSnapshot  ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot   ( SnapshotReader &_reader );
+
     int  NumSpirits     ();
     void AddSpirit      ( Spirit *_spirit );
     void RemoveSpirits  ( int _quantity );
@@ -59,7 +59,7 @@ void SporeGenerator::ChangeHealth(int _amount)
       fractionDead = 1.0f;
 
     Matrix34 transform(m_front, g_upVector, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, fractionDead));
 
     m_state = StatePanic;
     m_retargetTimer = 10.0f;
@@ -183,6 +183,26 @@ bool SporeGenerator::AdvanceToTargetPosition()
   return (distanceToTarget < 10.0f);
 }
 
+void SporeGenerator::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_retargetTimer);
+  _writer.Write(m_eggTimer);
+  WriteSnapshotVector(_writer, m_targetPos);
+  _writer.Write(m_spiritId);
+  _writer.Write(m_state);
+}
+
+void SporeGenerator::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_retargetTimer);
+  _reader.Read(m_eggTimer);
+  ReadSnapshotVector(_reader, m_targetPos);
+  _reader.Read(m_spiritId);
+  _reader.Read(m_state);
+}
+
 bool SporeGenerator::Advance(Unit* _unit)
 {
   bool amIDead = Entity::Advance(_unit);
@@ -248,7 +268,7 @@ bool SporeGenerator::AdvanceEggLaying()
       Matrix34 mat(m_front, g_upVector, m_pos);
       Matrix34 eggLayMat = m_shape->GetMarkerWorldMatrix(m_eggMarker, mat);
       g_context->m_location->SpawnEntities(eggLayMat.pos, m_id.GetTeamId(), -1, TypeEgg, 1, m_vel, 0.0f);
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LayEgg"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "LayEgg"));
     }
   }
 
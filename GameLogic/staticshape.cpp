@@ -110,7 +110,27 @@ bool StaticShape::DoesShapeHit(ShapeStatic* _shape, Matrix34 _theTransform)
   return _shape->SphereHit(&package, _theTransform, true);
 }
 
-bool StaticShape::Advance() { return Building::Advance(); }
+void StaticShape::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.WriteString(m_shapeName);
+  _writer.Write(m_scale);
+}
+
+void StaticShape::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.ReadString(m_shapeName, sizeof(m_shapeName));
+  _reader.Read(m_scale);
+}
+
+bool StaticShape::Advance()
+{
+  bool removeBuilding = Building::Advance();
+  if (!removeBuilding && GetNumPorts() == 0)
+    Sleep();
+  return removeBuilding;
+}
 
 void StaticShape::Read(TextReader* _in, bool _dynamic)
 {
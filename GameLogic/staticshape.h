@@ -20,6 +20,8 @@ public:
     void SetStringId    ( const char *_stringId );
 
     bool Advance();
+    void WriteSnapshot( SnapshotWriter &_writer ) const;
+    void ReadSnapshot( SnapshotReader &_reader );
 
     bool DoesSphereHit          (LegacyVector3 const &_pos, float _radius);
     bool DoesShapeHit           (ShapeStatic *_shape, Matrix34 _transform);
@@ -56,6 +56,34 @@ void FenceSwitch::SetDetail(int _detail)
   Building::SetDetail(_detail);
 }
 
+// *** WriteSnapshot
+void FenceSwitch::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_linkedBuildingId);
+  _writer.Write(m_linkedBuildingId2);
+  _writer.Write(m_switchable);
+  _writer.Write(m_timer);
+  _writer.WriteString(m_script);
+  _writer.Write(m_locked);
+  _writer.Write(m_lockable);
+  _writer.Write(m_switchValue);
+}
+
+// *** ReadSnapshot
+void FenceSwitch::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_linkedBuildingId);
+  _reader.Read(m_linkedBuildingId2);
+  _reader.Read(m_switchable);
+  _reader.Read(m_timer);
+  _reader.ReadString(m_script, sizeof(m_script));
+  _reader.Read(m_locked);
+  _reader.Read(m_lockable);
+  _reader.Read(m_switchValue);
+}
+
 // *** Advance
 bool FenceSwitch::Advance()
 {
@@ -195,7 +223,7 @@ bool FenceSwitch::Advance()
 
   if (switched)
   {
-    if (strstr(m_script, ".txt"))
+    if (strstr(m_script, ".txt") && g_context->m_script)
       g_context->m_script->RunScript(m_script);
     if (m_lockable)
       m_locked = true;
@@ -31,6 +31,8 @@ class FenceSwitch : public Building
     void SetDetail(int _detail) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Switch();
 
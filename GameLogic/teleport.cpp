@@ -21,8 +21,6 @@
 #include "teleport.h"
 #include "insertion_squad.h"
 
-LList<TeleportMap> Teleport::m_teleportMap;
-
 
 
 // *** Constructor
@@ -44,6 +42,24 @@ void Teleport::SetShape( ShapeStatic *_shape )
 }
 
 
+// *** WriteSnapshot
+void Teleport::WriteSnapshot( SnapshotWriter &_writer ) const
+{
+    Building::WriteSnapshot( _writer );
+    _writer.Write( m_timeSync );
+    _writer.Write( m_sendPeriod );
+    WriteSnapshotList( _writer, m_inTransit );
+}
+
+// *** ReadSnapshot
+void Teleport::ReadSnapshot( SnapshotReader &_reader )
+{
+    Building::ReadSnapshot( _reader );
+    _reader.Read( m_timeSync );
+    _reader.Read( m_sendPeriod );
+    ReadSnapshotList( _reader, m_inTransit );
+}
+
 // *** Advance
 bool Teleport::Advance ()
 {
@@ -79,14 +95,15 @@ bool Teleport::Advance ()
     // If a unit no longer exists, remove it from our teleport map
     // to prevent confusion (since unit ids are re-used)
 
-    for( int i = 0; i < m_teleportMap.Size(); ++i )
+    LList<TeleportMap> &teleportMap = g_context->m_location->m_statics.m_teleportMap;
+    for( int i = 0; i < teleportMap.Size(); ++i )
     {
-        TeleportMap *map = m_teleportMap.GetPointer(i);
+        TeleportMap *map = teleportMap.GetPointer(i);
         WorldObjectId unitId( map->m_teamId, map->m_fromUnitId, -1, -1 );
         Unit *unit = g_context->m_location->GetUnit( unitId );
         if( !unit )
         {
-            m_teleportMap.RemoveData(i);
+            teleportMap.RemoveData(i);
             --i;
         }
     }
@@ -141,10 +158,11 @@ void Teleport::EnterTeleport( WorldObjectId _id, bool _relay )
                 //
                 // Look for the new unit that i'm going to
 
+                LList<TeleportMap> &teleportMap = g_context->m_location->m_statics.m_teleportMap;
                 int newUnitId = -1;
-                for( int i = 0; i < m_teleportMap.Size(); ++i )
+                for( int i = 0; i < teleportMap.Size(); ++i )
                 {
-                    TeleportMap *map = m_teleportMap.GetPointer(i);
+                    TeleportMap *map = teleportMap.GetPointer(i);
                     if( map->m_teamId == _id.GetTeamId() &&
                         map->m_fromUnitId == _id.GetUnitId() )
                     {
@@ -182,16 +200,17 @@ void Teleport::EnterTeleport( WorldObjectId _id, bool _relay )
                     // If this was an insertion squad we just broke up,
                     // then we must create a Task to represent the new squad
 
-                    if( oldUnit->m_troopType == Entity::TypeInsertionSquadie )
+                    TaskManager *taskManager = g_context->m_taskManager;     // nullptr when headless
+                    if( oldUnit->m_troopType == Entity::TypeInsertionSquadie && taskManager )
                     {
                         // Shut down the old task
-                        for( int i = 0; i < g_context->m_taskManager->m_tasks.Size(); ++i )
+                        for( int i = 0; i < taskManager->m_tasks.Size(); ++i )
                         {
-                            Task *task = g_context->m_taskManager->m_tasks[i];
+                            Task *task = taskManager->m_tasks[i];
                             if( task->m_type == GlobalResearch::TypeSquad &&
                                 task->m_objId == WorldObjectId( oldUnit->m_teamId, oldUnit->m_unitId, -1, -1 ) )
                             {
-                                g_context->m_taskManager->m_tasks.RemoveData(i);
+                                taskManager->m_tasks.RemoveData(i);
                                 delete task;
                                 break;
                             }
@@ -201,16 +220,19 @@ void Teleport::EnterTeleport( WorldObjectId _id, bool _relay )
                         task->m_type = GlobalResearch::TypeSquad;
                         task->m_state = Task::StateRunning;
                         task->m_objId.Set( newUnit->m_teamId, newUnit->m_unitId, -1, -1 );
-                        bool success = g_context->m_taskManager->RegisterTask( task );
-                        if( success ) g_context->m_taskManager->SelectTask( task->m_id );
+                        bool success = taskManager->RegisterTask( task );
+                        if( success ) taskManager->SelectTask( task->m_id );
+                    }
 
+                    if( oldUnit->m_troopType == Entity::TypeInsertionSquadie )
+                    {
                         ((InsertionSquad *)newUnit)->m_weaponType = ((InsertionSquad *)oldUnit)->m_weaponType;
                         ((InsertionSquad *)newUnit)->m_controllerId = ((InsertionSquad *)oldUnit)->m_controllerId;
                         ((InsertionSquad *)oldUnit)->m_controllerId = -1;
-                        Task *controller = g_context->m_taskManager->GetTask( ((InsertionSquad *)newUnit)->m_controllerId );
+                        Task *controller = taskManager ? taskManager->GetTask( ((InsertionSquad *)newUnit)->m_controllerId ) : NULL;
                         if( controller )
                         {
-                            controller->m_objId = task->m_objId;
+                            controller->m_objId.Set( newUnit->m_teamId, newUnit->m_unitId, -1, -1 );
                             controller->m_route->AddWayPoint( m_id.GetUniqueId() );
                         }
                     }
@@ -235,7 +257,7 @@ void Teleport::EnterTeleport( WorldObjectId _id, bool _relay )
                     map.m_teamId = entity->m_id.GetTeamId();
                     map.m_fromUnitId = oldUnit->m_unitId;
                     map.m_toUnitId = newUnit->m_unitId;
-                    m_teleportMap.PutDataAtStart( map );
+                    teleportMap.PutDataAtStart( map );
                 }
 
                 DEBUG_ASSERT( newUnit );
@@ -6,19 +6,11 @@
 
 class Entity;
 
-struct TeleportMap
-{
-  int m_teamId;
-  int m_fromUnitId;
-  int m_toUnitId;
-};
-
 class Teleport : public Building
 {
   protected:
     float m_timeSync;
     float m_sendPeriod; // Minimum time between sends
-    static LList<TeleportMap> m_teleportMap; // Maps units going in onto units comingout
 
     ShapeMarkerData* m_entrance;
 
@@ -30,6 +22,8 @@ class Teleport : public Building
     void SetShape(ShapeStatic* _shape) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void EnterTeleport(WorldObjectId _id, bool _relay = false); // Relay=true means i've entered directly from another teleport
 
@@ -20,6 +20,7 @@ Tree::Tree()
     m_fireDamage(0.0f),
     m_onFire(0.0f),
     m_burnSoundPlaying(false),
+    m_ticksToLeaf(0),
     m_height(50.0f),
     m_budsize(1.0f),
     m_pushUp(1.0f),
@@ -32,7 +33,8 @@ Tree::Tree()
 
 Tree::~Tree()
 {
-  if (g_renderBackend)
+  // A headless match's trees were never drawn, and their ids may be on screen in another match
+  if (g_renderBackend && g_context->m_renderer)
     g_renderBackend->ReleaseBuilding(m_id.GetUniqueId());
 }
 
@@ -52,11 +54,24 @@ void Tree::Initialise(Building* _template)
   m_branchColour = tree->m_branchColour;
   m_leafColour = tree->m_leafColour;
   m_leafDropRate = tree->m_leafDropRate;
+
+  if (m_leafDropRate > 0)
+    m_ticksToLeaf = DrawTicksToLeaf();
+}
+
+// Gap to the next falling leaf: one chance in 51 - m_leafDropRate per tick
+int Tree::DrawTicksToLeaf() const
+{
+  int ticks = 1;
+  while (rand() % (51 - m_leafDropRate) != 0)
+    ++ticks;
+  return ticks;
 }
 
 void Tree::SetDetail(int _detail)
 {
   Building::SetDetail(_detail);
+  Wake(); // Advance regenerates the mesh
 
   int oldIterations = m_iterations;
   if (_detail == 0)
@@ -72,6 +87,40 @@ void Tree::SetDetail(int _detail)
   m_radius = m_hitcheckRadius * m_height * 1.5f;
 }
 
+void Tree::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_fireDamage);
+  _writer.Write(m_onFire);
+  _writer.Write(m_ticksToLeaf);
+  _writer.Write(m_height);
+  _writer.Write(m_budsize);
+  _writer.Write(m_pushUp);
+  _writer.Write(m_pushOut);
+  _writer.Write(m_iterations);
+  _writer.Write(m_seed);
+  _writer.Write(m_leafColour);
+  _writer.Write(m_branchColour);
+  _writer.Write(m_leafDropRate);
+}
+
+void Tree::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_fireDamage);
+  _reader.Read(m_onFire);
+  _reader.Read(m_ticksToLeaf);
+  _reader.Read(m_height);
+  _reader.Read(m_budsize);
+  _reader.Read(m_pushUp);
+  _reader.Read(m_pushOut);
+  _reader.Read(m_iterations);
+  _reader.Read(m_seed);
+  _reader.Read(m_leafColour);
+  _reader.Read(m_branchColour);
+  _reader.Read(m_leafDropRate);
+}
+
 bool Tree::Advance()
 {
   // Ensure mesh is generated before the renderer sees this tree.
@@ -103,14 +152,14 @@ bool Tree::Advance()
       fireSpawn += LegacyVector3(sfrand(actualHeight * 1.0f), sfrand(actualHeight * 0.5f), sfrand(actualHeight * 1.0f));
       float fireSize = actualHeight * 2.0f;
       fireSize *= (1.0f + sfrand(0.5f));
-      g_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeFire, fireSize));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeFire, fireSize));
     }
 
     if (frand(100.0f) < 10.0f)
     {
       LegacyVector3 fireSpawn = m_pos + LegacyVector3(0, actualHeight, 0);
       fireSpawn += LegacyVector3(sfrand(actualHeight * 0.75f), sfrand(actualHeight * 0.75f), sfrand(actualHeight * 0.75f));
-      g_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeExplosionDebris));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeExplosionDebris));
     }
 
     //
@@ -146,8 +195,8 @@ bool Tree::Advance()
   {
     if (m_burnSoundPlaying)
     {
-      g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "Tree Burn"));
-      g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Create"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "Tree Burn"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Create"));
 
       m_burnSoundPlaying = false;
     }
@@ -162,15 +211,31 @@ bool Tree::Advance()
 
   if (m_onFire == 0.0f && m_leafDropRate > 0)
   {
-    // drop some leaves
-    if (rand() % (51 - m_leafDropRate) == 0)
+    // drop some leaves.  The gap to the next one is drawn up front so the
+    // tree can sleep through it.
+    if (--m_ticksToLeaf <= 0)
     {
       float actualHeight = GetActualHeight(0.0f);
       LegacyVector3 fireSpawn = m_pos + LegacyVector3(0, actualHeight, 0);
       fireSpawn += LegacyVector3(sfrand(actualHeight * 1.0f), sfrand(actualHeight * 0.25f), sfrand(actualHeight * 1.0f));
-      g_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeLeaf, -1.0f,
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeLeaf, -1.0f,
         RGBAColour(m_leafColourArray[0], m_leafColourArray[1], m_leafColourArray[2])));
+
+      m_ticksToLeaf = DrawTicksToLeaf();
+    }
+  }
+
+  // Not burning, regrowing or cooling down: nothing to do until something
+  // damages us or the next leaf falls
+  if (m_onFire == 0.0f && m_fireDamage == 0.0f)
+  {
+    if (m_leafDropRate > 0)
+    {
+      Sleep(m_ticksToLeaf - 1);
+      m_ticksToLeaf = 1;
     }
+    else
+      Sleep();
   }
 
   return false;
@@ -262,8 +327,8 @@ void Tree::Damage(float _damage)
 
       if (!m_burnSoundPlaying)
       {
-        g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "Tree Create"));
-        g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Burn"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id, "Tree Create"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Burn"));
 
         m_burnSoundPlaying = true;
       }
@@ -8,6 +8,7 @@ class Tree : public Building
   protected:
     void CalcBranchRadius(LegacyVector3 _from, LegacyVector3 _to, int _iterations);
     void GenerateBranch(LegacyVector3 _from, LegacyVector3 _to, int _iterations, bool _calcRadius, bool _renderBranch, bool _renderLeaf, TreeMeshData& _mesh);
+    int DrawTicksToLeaf() const;
 
     LegacyVector3 m_hitcheckCenter;
     float m_hitcheckRadius;
@@ -16,6 +17,7 @@ class Tree : public Building
     float m_fireDamage;
     float m_onFire;
     bool m_burnSoundPlaying;
+    int m_ticksToLeaf; // Advances until the next falling leaf
 
     public:
       TreeMeshData m_branchMesh;
@@ -45,6 +47,8 @@ class Tree : public Building
     void SetDetail(int _detail) override;
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void Generate();
 
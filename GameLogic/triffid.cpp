@@ -114,7 +114,7 @@ void Triffid::Damage(float _damage)
   m_damage += _damage;
 
   if (m_damage <= 0.0f && !dead)
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Burn"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "Burn"));
 }
 
 void Triffid::Launch()
@@ -154,7 +154,7 @@ void Triffid::Launch()
     triffidEgg->m_roamRange = m_triggerRadius;
   }
 
-  g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "LaunchEgg"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "LaunchEgg"));
 }
 
 void Triffid::Initialise(Building* _template)
@@ -183,6 +183,42 @@ void Triffid::Initialise(Building* _template)
   m_timerSync = GetHighResTime() + timeAdd;
 }
 
+void Triffid::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  WriteSnapshotTime(_writer, m_timerSync);
+  _writer.Write(m_damage);
+  _writer.Write(m_triggered);
+  WriteSnapshotTime(_writer, m_triggerTimer);
+  _writer.Write(m_spawn);
+  _writer.Write(m_size);
+  _writer.Write(m_reloadTime);
+  _writer.Write(m_pitch);
+  _writer.Write(m_force);
+  _writer.Write(m_variance);
+  _writer.Write(m_useTrigger);
+  WriteSnapshotVector(_writer, m_triggerLocation);
+  _writer.Write(m_triggerRadius);
+}
+
+void Triffid::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  ReadSnapshotTime(_reader, m_timerSync);
+  _reader.Read(m_damage);
+  _reader.Read(m_triggered);
+  ReadSnapshotTime(_reader, m_triggerTimer);
+  _reader.Read(m_spawn);
+  _reader.Read(m_size);
+  _reader.Read(m_reloadTime);
+  _reader.Read(m_pitch);
+  _reader.Read(m_force);
+  _reader.Read(m_variance);
+  _reader.Read(m_useTrigger);
+  ReadSnapshotVector(_reader, m_triggerLocation);
+  _reader.Read(m_triggerRadius);
+}
+
 bool Triffid::Advance()
 {
   //
@@ -194,18 +230,18 @@ bool Triffid::Advance()
     LegacyVector3 fireSpawn = headMat.pos;
     fireSpawn += LegacyVector3(sfrand(10.0f * m_size), sfrand(10.0f * m_size), sfrand(10.0f * m_size));
     float fireSize = 100.0f + sfrand(100.0f * m_size);
-    g_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeFire, fireSize));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeFire, fireSize));
 
     fireSpawn = m_pos + LegacyVector3(sfrand(10.0f * m_size), sfrand(10.0f * m_size), sfrand(10.0f * m_size));
-    g_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeFire, fireSize));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeFire, fireSize));
 
     if (frand(100.0f) < 10.0f)
-      g_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeExplosionDebris));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(fireSpawn, g_zeroVector, SimParticle::TypeExplosionDebris));
 
     m_size -= 0.006f;
     if (m_size <= 0.3f)
     {
-      g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, headMat, 1.0f));
+      g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, headMat, 1.0f));
       return true;
     }
     m_timerSync -= 0.5f;
@@ -342,7 +378,7 @@ void TriffidEgg::ChangeHealth(int _amount)
     transform.f *= m_size;
     transform.u *= m_size;
     transform.r *= m_size;
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
   }
 }
 
@@ -433,6 +469,32 @@ void TriffidEgg::Spawn()
   }
 }
 
+void TriffidEgg::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_up);
+  _writer.Write(m_force);
+  WriteSnapshotTime(_writer, m_timerSync);
+  _writer.Write(m_life);
+  _writer.Write(m_size);
+  _writer.Write(m_spawnType);
+  WriteSnapshotVector(_writer, m_spawnPoint);
+  _writer.Write(m_spawnRange);
+}
+
+void TriffidEgg::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_up);
+  _reader.Read(m_force);
+  ReadSnapshotTime(_reader, m_timerSync);
+  _reader.Read(m_life);
+  _reader.Read(m_size);
+  _reader.Read(m_spawnType);
+  ReadSnapshotVector(_reader, m_spawnPoint);
+  _reader.Read(m_spawnRange);
+}
+
 bool TriffidEgg::Advance(Unit* _unit)
 {
   if (m_dead)
@@ -458,7 +520,7 @@ bool TriffidEgg::Advance(Unit* _unit)
     if (m_pos.y < landHeight + 3.0f)
       m_pos.y = landHeight + 3.0f;
     if (m_force > 0.1f)
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Bounce"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Bounce"));
   }
 
   // Self right ourselves
@@ -478,9 +540,9 @@ bool TriffidEgg::Advance(Unit* _unit)
   if (GetHighResTime() > m_timerSync)
   {
     Matrix34 transform(m_front, m_up, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
     Spawn();
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "BurstOpen"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "BurstOpen"));
     return true;
   }
 
@@ -44,6 +44,8 @@ class Triffid : public Building
 
     void Initialise(Building* _template) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     void Launch();
 
     void Damage(float _damage) override;
@@ -86,4 +88,6 @@ class TriffidEgg : public Entity
     void ChangeHealth(int _amount) override;
     void Spawn();
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
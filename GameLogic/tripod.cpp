@@ -106,7 +106,7 @@ void Tripod::ChangeHealth(int _amount)
     {
       // We just died
       Matrix34 transform(m_front, m_up, m_pos);
-      g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
+      g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, transform, 1.0f));
     }
   }
 }
@@ -472,6 +472,52 @@ void Tripod::AdvancePostAttack()
   m_front.Normalise();
 }
 
+void Tripod::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_mode);
+  _writer.Write(m_nextLegToMove);
+  _writer.Write(m_speed);
+  _writer.Write(m_targetHoverHeight);
+  WriteSnapshotVector(_writer, m_up);
+  for (const Vector2& direction : m_navData.m_directions)
+  {
+    _writer.Write(direction.x);
+    _writer.Write(direction.y);
+  }
+  _writer.Write(m_navData.m_dir);
+  _writer.Write(m_navData.m_targetPos.x);
+  _writer.Write(m_navData.m_targetPos.y);
+  WriteSnapshotVector(_writer, m_bodyVel);
+  WriteSnapshotVector(_writer, m_attackTarget);
+  WriteSnapshotTime(_writer, m_modeStartTime);
+  for (const EntityLeg* leg : m_legs)
+    leg->WriteSnapshot(_writer);
+}
+
+void Tripod::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_mode);
+  _reader.Read(m_nextLegToMove);
+  _reader.Read(m_speed);
+  _reader.Read(m_targetHoverHeight);
+  ReadSnapshotVector(_reader, m_up);
+  for (Vector2& direction : m_navData.m_directions)
+  {
+    _reader.Read(direction.x);
+    _reader.Read(direction.y);
+  }
+  _reader.Read(m_navData.m_dir);
+  _reader.Read(m_navData.m_targetPos.x);
+  _reader.Read(m_navData.m_targetPos.y);
+  ReadSnapshotVector(_reader, m_bodyVel);
+  ReadSnapshotVector(_reader, m_attackTarget);
+  ReadSnapshotTime(_reader, m_modeStartTime);
+  for (EntityLeg* leg : m_legs)
+    leg->ReadSnapshot(_reader);
+}
+
 bool Tripod::Advance([[maybe_unused]] Unit* _unit)
 {
   //
@@ -537,7 +583,7 @@ bool Tripod::Advance([[maybe_unused]] Unit* _unit)
   if (m_pos.y < g_context->m_location->m_landscape.m_heightMap->GetValue(m_pos.x, m_pos.z))
   {
     Matrix34 mat(m_front, m_up, m_pos);
-    g_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeExplosion(m_shape, mat, 1.0f));
     return true;
   }
 
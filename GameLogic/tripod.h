@@ -77,6 +77,8 @@ public:
 	~Tripod();
 
 	bool Advance(Unit *_unit);
+	void WriteSnapshot(SnapshotWriter& _writer) const;
+	void ReadSnapshot(SnapshotReader& _reader);
 	void Begin();
 };
 
@@ -74,13 +74,27 @@ void TrunkPort::SetDetail(int _detail)
   }
 }
 
+void TrunkPort::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_targetLocationId);
+  WriteSnapshotTime(_writer, m_openTimer);
+}
+
+void TrunkPort::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_targetLocationId);
+  ReadSnapshotTime(_reader, m_openTimer);
+}
+
 bool TrunkPort::Advance()
 {
   GlobalBuilding* gb = g_context->m_globalWorld->GetBuilding(m_id.GetUniqueId(), g_context->m_locationId);
   if (gb && gb->m_online && m_openTimer == 0.0f)
   {
     m_openTimer = GetHighResTime();
-    g_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PowerUp"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundBuilding(m_id, "PowerUp"));
   }
 
   return Building::Advance();
@@ -21,6 +21,8 @@ class TrunkPort : public Building
     void Initialise(Building* _template) override;
     void SetDetail(int _detail) override;
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     bool PerformDepthSort(LegacyVector3& _centerPos) override;
 
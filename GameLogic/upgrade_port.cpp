@@ -19,6 +19,18 @@ PrimaryUpgradePort::PrimaryUpgradePort()
   SetShape(Resource::GetShapeStatic("primaryupgradeport.shp"));
 }
 
+void PrimaryUpgradePort::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_controlTowersOwned);
+}
+
+void PrimaryUpgradePort::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_controlTowersOwned);
+}
+
 void PrimaryUpgradePort::ReprogramComplete()
 {
   m_controlTowersOwned++;
@@ -19,6 +19,8 @@ public:
 
 public:
     PrimaryUpgradePort();
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     void ReprogramComplete();
 };
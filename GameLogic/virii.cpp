@@ -17,6 +17,20 @@ ViriiUnit::ViriiUnit(int teamId, int unitId, int numEntities, const LegacyVector
     m_enemiesFound(false),
     m_cameraClose(false) {}
 
+void ViriiUnit::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Unit::WriteSnapshot(_writer);
+  _writer.Write(m_enemiesFound);
+  _writer.Write(m_cameraClose);
+}
+
+void ViriiUnit::ReadSnapshot(SnapshotReader& _reader)
+{
+  Unit::ReadSnapshot(_reader);
+  _reader.Read(m_enemiesFound);
+  _reader.Read(m_cameraClose);
+}
+
 bool ViriiUnit::Advance(int _slice)
 {
   float searchRadius = m_radius + VIRII_MAXSEARCHRANGE;
@@ -35,7 +49,57 @@ Virii::Virii()
     m_historyTimer(0.0f),
     m_prevPosTimer(0.0f) { m_retargetTimer = syncfrand(2.0f); }
 
-Virii::~Virii() { m_positionHistory.EmptyAndDelete(); }
+void Virii::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Entity::WriteSnapshot(_writer);
+  _writer.Write(m_state);
+  _writer.Write(m_hoverHeight);
+  _writer.Write(m_retargetTimer);
+  WriteSnapshotId(_writer, m_enemyId);
+  WriteSnapshotId(_writer, m_eggId);
+  _writer.Write(m_spiritId);
+  WriteSnapshotVector(_writer, m_wayPoint);
+  _writer.Write(m_historyTimer);
+  WriteSnapshotVector(_writer, m_prevPos);
+  _writer.Write(m_prevPosTimer);
+  _writer.WriteCount(m_positionHistory.Size());
+  for (int i = m_positionHistory.Size() - 1; i >= 0; --i)
+  {
+    const ViriiHistory& history = m_positionHistory[i];
+    WriteSnapshotVector(_writer, history.m_pos);
+    WriteSnapshotVector(_writer, history.m_right);
+    WriteSnapshotVector(_writer, history.m_glowDiff);
+    _writer.Write(history.m_distance);
+    _writer.Write(history.m_required);
+  }
+}
+
+void Virii::ReadSnapshot(SnapshotReader& _reader)
+{
+  Entity::ReadSnapshot(_reader);
+  _reader.Read(m_state);
+  _reader.Read(m_hoverHeight);
+  _reader.Read(m_retargetTimer);
+  ReadSnapshotId(_reader, m_enemyId);
+  ReadSnapshotId(_reader, m_eggId);
+  _reader.Read(m_spiritId);
+  ReadSnapshotVector(_reader, m_wayPoint);
+  _reader.Read(m_historyTimer);
+  ReadSnapshotVector(_reader, m_prevPos);
+  _reader.Read(m_prevPosTimer);
+  m_positionHistory.Clear();
+  const int numHistory = _reader.ReadCount();
+  for (int i = 0; i < numHistory; ++i)
+  {
+    ViriiHistory history;
+    ReadSnapshotVector(_reader, history.m_pos);
+    ReadSnapshotVector(_reader, history.m_right);
+    ReadSnapshotVector(_reader, history.m_glowDiff);
+    _reader.Read(history.m_distance);
+    _reader.Read(history.m_required);
+    m_positionHistory.Push(history);
+  }
+}
 
 bool Virii::Advance(Unit* _unit)
 {
@@ -139,7 +203,7 @@ bool Virii::Advance(Unit* _unit)
 
     if (!recorded)
     {
-      float lastRecordedHeight = m_positionHistory[0]->m_pos.y;
+      float lastRecordedHeight = m_positionHistory[0].m_pos.y;
       if (fabs(m_pos.y - lastRecordedHeight) > 3.0f)
         RecordHistoryPosition(false);
     }
@@ -168,50 +232,36 @@ void Virii::RecordHistoryPosition(bool _required)
   LegacyVector3 landNormal = g_context->m_location->m_landscape.m_normalMap->GetValue(m_pos.x, m_pos.z);
   LegacyVector3 prevPos;
   if (m_positionHistory.Size() > 0)
-    prevPos = m_positionHistory[0]->m_pos;
+    prevPos = m_positionHistory[0].m_pos;
 
-  auto history = new ViriiHistory();
-  history->m_pos = m_pos;
-  history->m_right = (m_pos - prevPos) ^ landNormal;
-  history->m_right.Normalise();
-  history->m_distance = 0.0f;
-  history->m_required = _required;
+  ViriiHistory history;
+  history.m_pos = m_pos;
+  history.m_right = (m_pos - prevPos) ^ landNormal;
+  history.m_right.Normalise();
+  history.m_distance = 0.0f;
+  history.m_required = _required;
 
   if (m_positionHistory.Size() > 0)
   {
-    history->m_distance = (m_pos - m_positionHistory[0]->m_pos).Mag();
-    history->m_glowDiff = (m_pos - m_positionHistory[0]->m_pos);
-    history->m_glowDiff.SetLength(10.0f);
+    history.m_distance = (m_pos - m_positionHistory[0].m_pos).Mag();
+    history.m_glowDiff = (m_pos - m_positionHistory[0].m_pos);
+    history.m_glowDiff.SetLength(10.0f);
   }
 
-  m_positionHistory.PutDataAtStart(history);
+  // A full ring drops its oldest point here, before the tail length does
+  m_positionHistory.Push(history);
 
   float totalDistance = 0.0f;
-  int removeFrom = -1;
-
-  float tailLength = 175.0f; 
   for (int i = 0; i < m_positionHistory.Size(); ++i)
   {
-    ViriiHistory* viriiHistory = m_positionHistory[i];
-    totalDistance += viriiHistory->m_distance;
-
-    if (totalDistance > tailLength)
+    totalDistance += m_positionHistory[i].m_distance;
+    if (totalDistance > VIRII_TAILLENGTH)
     {
-      removeFrom = i;
+      m_positionHistory.Truncate(i);
       break;
     }
   }
 
-  if (removeFrom != -1)
-  {
-    while (m_positionHistory.ValidIndex(removeFrom))
-    {
-      ViriiHistory* viriiHistory = m_positionHistory[removeFrom];
-      m_positionHistory.RemoveData(removeFrom);
-      delete viriiHistory;
-    }
-  }
-
   END_PROFILE(g_context->m_profiler, "RecordHistory");
 }
 
@@ -327,9 +377,9 @@ bool Virii::AdvanceAttacking()
     entity->ChangeHealth(-20);
     for (int i = 0; i < 3; ++i)
     {
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, LegacyVector3(syncsfrand(15.0f), syncsfrand(15.0f) + 15.0f, syncsfrand(15.0f)), SimParticle::TypeMuzzleFlash));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, LegacyVector3(syncsfrand(15.0f), syncsfrand(15.0f) + 15.0f, syncsfrand(15.0f)), SimParticle::TypeMuzzleFlash));
     }
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "Attack"));
     SearchForEnemies();
   }
 
@@ -599,7 +649,7 @@ bool Virii::SearchForIdleDirection()
     m_wayPoint = nextPos;
     m_state = StateIdle;
     RecordHistoryPosition(true);
-    g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ChangeDirection"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ChangeDirection"));
     END_PROFILE(g_context->m_profiler, "SearchForIdleDir");
     return true;
   }
@@ -621,7 +671,7 @@ bool Virii::SearchForIdleDirection()
       m_wayPoint = nextPos;
       m_state = StateIdle;
       RecordHistoryPosition(true);
-      g_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ChangeDirection"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundEntity(m_id, "ChangeDirection"));
       END_PROFILE(g_context->m_profiler, "SearchForIdleDir");
       return true;
     }
@@ -671,7 +721,7 @@ bool Virii::AdvanceDead()
 {
   for (int i = 0; i < m_positionHistory.Size(); ++i)
   {
-    LegacyVector3* thisPos = &m_positionHistory[i]->m_pos;
+    LegacyVector3* thisPos = &m_positionHistory[i].m_pos;
     *thisPos = AdvanceDeadPositionVector(i, *thisPos, SERVER_ADVANCE_PERIOD);
   }
   return true;
@@ -684,7 +734,7 @@ bool Virii::IsInView()
 
   for (int i = 0; i < m_positionHistory.Size(); ++i)
   {
-    LegacyVector3 pos = m_positionHistory[i]->m_pos;
+    LegacyVector3 pos = m_positionHistory[i].m_pos;
     float distance = (pos - centerPos).MagSquared();
     if (distance > radiusSqd)
       radiusSqd = distance;
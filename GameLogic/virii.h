@@ -2,12 +2,12 @@
 
 #include "entity.h"
 #include "unit.h"
+#include "HistoryRing.h"
 
 #define VIRII_MAXSEARCHRANGE    60.0f
 #define VIRII_MINSEARCHRANGE    30.0f
 #define VIRII_TAILLENGTH        175.0f
-
-class ViriiHistory;
+#define VIRII_MAXHISTORY        64          // History points kept, however short the tail
 
 //*****************************************************************************
 // Class ViriiUnit
@@ -22,6 +22,23 @@ class ViriiUnit : public Unit
     ViriiUnit(int teamId, int unitId, int numEntities, const LegacyVector3& _pos);
 
     bool Advance(int _slice) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
+};
+
+//*****************************************************************************
+// Class ViriiHistory
+//*****************************************************************************
+
+class ViriiHistory
+{
+  public:
+    LegacyVector3 m_pos; // Position in world
+    LegacyVector3 m_right; // Right vector (front is to next point, up is land normal)
+    LegacyVector3 m_glowDiff; // Diff to previous history point, sized for glow effect
+    float m_distance = 0.0f; // Distance to previous history point
+    bool m_required = false; // True means this is an absolute history position (eg direction change)
+    // false means its just to smooth out the path (eg height change)
 };
 
 //*****************************************************************************
@@ -67,13 +84,14 @@ class Virii : public Entity
     void RecordHistoryPosition(bool _required); // if !_required this is simply to make it smoother
     LegacyVector3 AdvanceDeadPositionVector(int _index, const LegacyVector3& _pos, float _time);
 
-    LList<ViriiHistory*> m_positionHistory;
+    Neuron::HistoryRing<ViriiHistory, VIRII_MAXHISTORY> m_positionHistory; // Newest first
 
   public:
     Virii();
-    ~Virii() override;
 
     bool Advance(Unit* _unit) override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
     bool AdvanceIdle();
     bool AdvanceAttacking();
     bool AdvanceToSpirit();
@@ -82,18 +100,3 @@ class Virii : public Entity
 
     bool IsInView() override;
 };
-
-//*****************************************************************************
-// Class ViriiHistory
-//*****************************************************************************
-
-class ViriiHistory
-{
-  public:
-    LegacyVector3 m_pos; // Position in world
-    LegacyVector3 m_right; // Right vector (front is to next point, up is land normal)
-    LegacyVector3 m_glowDiff; // Diff to previous history point, sized for glow effect
-    float m_distance; // Distance to previous history point
-    bool m_required; // True means this is an absolute history position (eg direction change)
-    // false means its just to smooth out the path (eg height change)
-};
@@ -16,6 +16,20 @@ Wall::Wall()
   SetShape(Resource::GetShapeStatic("wall.shp"));
 }
 
+void Wall::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  Building::WriteSnapshot(_writer);
+  _writer.Write(m_damage);
+  _writer.Write(m_fallSpeed);
+}
+
+void Wall::ReadSnapshot(SnapshotReader& _reader)
+{
+  Building::ReadSnapshot(_reader);
+  _reader.Read(m_damage);
+  _reader.Read(m_fallSpeed);
+}
+
 bool Wall::Advance()
 {
   float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue(m_pos.x, m_pos.z);
@@ -38,12 +52,18 @@ bool Wall::Advance()
         particlePos.y = g_context->m_location->m_landscape.m_heightMap->GetValue(particlePos.x, particlePos.z) + 10.0f;
         LegacyVector3 particleVel(sfrand(10.0f), frand(10.0f), sfrand(10.0f));
 
-        g_simEventQueue.Push(SimEvent::MakeParticle(particlePos, particleVel, SimParticle::TypeRocketTrail, 50.0f));
+        g_context->m_simEventQueue.Push(SimEvent::MakeParticle(particlePos, particleVel, SimParticle::TypeRocketTrail, 50.0f));
       }
     }
   }
+  else
+    Sleep(); // Resting on the ground until damaged again
 
   return false;
 }
 
-void Wall::Damage(float _damage) { m_damage -= _damage; }
+void Wall::Damage(float _damage)
+{
+  Wake();
+  m_damage -= _damage;
+}
@@ -16,6 +16,8 @@ public:
     Wall();
 
     bool Advance    ();
+    void WriteSnapshot ( SnapshotWriter &_writer ) const;
+    void ReadSnapshot ( SnapshotReader &_reader );
     void Damage     ( float _damage );
 
 };
@@ -51,15 +51,35 @@ void ThrowableWeapon::TriggerSoundEvent(const char* _event)
   case EffectThrowableGrenade:
   case EffectThrowableAirstrikeMarker:
   case EffectThrowableControllerGrenade:
-    g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeGrenade, _event));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeGrenade, _event));
     break;
 
   case EffectThrowableAirstrikeBomb:
-    g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeAirstrikeBomb, _event));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeAirstrikeBomb, _event));
     break;
   }
 }
 
+void ThrowableWeapon::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  WriteSnapshotTime(_writer, m_birthTime);
+  _writer.Write(m_force);
+  WriteSnapshotVector(_writer, m_front);
+  WriteSnapshotVector(_writer, m_up);
+  _writer.Write(m_numFlashes);
+}
+
+void ThrowableWeapon::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  ReadSnapshotTime(_reader, m_birthTime);
+  _reader.Read(m_force);
+  ReadSnapshotVector(_reader, m_front);
+  ReadSnapshotVector(_reader, m_up);
+  _reader.Read(m_numFlashes);
+}
+
 bool ThrowableWeapon::Advance()
 {
   if (m_type != EffectThrowableAirstrikeMarker && syncfrand() > 0.2f)
@@ -68,7 +88,7 @@ bool ThrowableWeapon::Advance()
     vel.x += syncsfrand(5.0f);
     vel.y += syncsfrand(5.0f);
     vel.z += syncsfrand(5.0f);
-    g_simEventQueue.Push(SimEvent::MakeParticle(m_pos - m_vel * SERVER_ADVANCE_PERIOD, vel, SimParticle::TypeRocketTrail, 40.0f));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos - m_vel * SERVER_ADVANCE_PERIOD, vel, SimParticle::TypeRocketTrail, 40.0f));
   }
 
   if (m_force > 0.1f)
@@ -136,6 +156,20 @@ Grenade::Grenade(const LegacyVector3& _startPos, const LegacyVector3& _front, fl
     m_life(3.0f),
     m_power(25.0f) { m_colour.Set(255, 100, 100); }
 
+void Grenade::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  ThrowableWeapon::WriteSnapshot(_writer);
+  _writer.Write(m_life);
+  _writer.Write(m_power);
+}
+
+void Grenade::ReadSnapshot(SnapshotReader& _reader)
+{
+  ThrowableWeapon::ReadSnapshot(_reader);
+  _reader.Read(m_life);
+  _reader.Read(m_power);
+}
+
 bool Grenade::Advance()
 {
   m_life -= SERVER_ADVANCE_PERIOD;
@@ -158,6 +192,18 @@ bool Grenade::Advance()
 AirStrikeMarker::AirStrikeMarker(const LegacyVector3& _startPos, const LegacyVector3& _front, float _force)
   : ThrowableWeapon(EffectThrowableAirstrikeMarker, _startPos, _front, _force) { m_colour.Set(255, 100, 100); }
 
+void AirStrikeMarker::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  ThrowableWeapon::WriteSnapshot(_writer);
+  WriteSnapshotId(_writer, m_airstrikeUnit);
+}
+
+void AirStrikeMarker::ReadSnapshot(SnapshotReader& _reader)
+{
+  ThrowableWeapon::ReadSnapshot(_reader);
+  ReadSnapshotId(_reader, m_airstrikeUnit);
+}
+
 bool AirStrikeMarker::Advance()
 {
   ThrowableWeapon::Advance();
@@ -169,7 +215,7 @@ bool AirStrikeMarker::Advance()
   vel.x += syncsfrand(5.0f);
   vel.y += syncsfrand(5.0f);
   vel.z += syncsfrand(5.0f);
-  g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeFire, 100.0f));
+  g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeFire, 100.0f));
 
   //
   // If its time, summon the actual airstrike
@@ -222,16 +268,16 @@ bool ControllerGrenade::Advance()
 
   if (GetHighResTime() > m_birthTime + 3.0f)
   {
-    g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeGrenade, "ExplodeController"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeGrenade, "ExplodeController"));
 
     int numFlashes = 5 + darwiniaRandom() % 5;
     for (int i = 0; i < numFlashes; ++i)
     {
       LegacyVector3 vel(sfrand(15.0f), frand(35.0f), sfrand(15.0f));
-      g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeControlFlash, 100.0f));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeControlFlash, 100.0f));
     }
 
-    Task* currentTask = g_context->m_taskManager->GetCurrentTask();
+    Task* currentTask = g_context->m_taskManager ? g_context->m_taskManager->GetCurrentTask() : nullptr;
     if (currentTask && currentTask->m_type == GlobalResearch::TypeSquad)
     {
       Unit* owner = g_context->m_location->GetUnit(currentTask->m_objId);
@@ -277,7 +323,23 @@ Rocket::Rocket(LegacyVector3 _startPos, LegacyVector3 _targetPos)
   m_type = EffectRocket;
 }
 
-void Rocket::Initialise() { g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Create")); }
+void Rocket::Initialise() { g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Create")); }
+
+void Rocket::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_fromTeamId);
+  WriteSnapshotTime(_writer, m_timer);
+  WriteSnapshotVector(_writer, m_target);
+}
+
+void Rocket::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_fromTeamId);
+  ReadSnapshotTime(_reader, m_timer);
+  ReadSnapshotVector(_reader, m_target);
+}
 
 bool Rocket::Advance()
 {
@@ -298,7 +360,7 @@ bool Rocket::Advance()
     vel.x += syncsfrand(4.0f);
     vel.y += syncsfrand(4.0f);
     vel.z += syncsfrand(4.0f);
-    g_simEventQueue.Push(SimEvent::MakeParticle(m_pos - m_vel * SERVER_ADVANCE_PERIOD, vel, SimParticle::TypeFire));
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos - m_vel * SERVER_ADVANCE_PERIOD, vel, SimParticle::TypeFire));
   }
 
   //
@@ -328,8 +390,8 @@ bool Rocket::Advance()
   if (GetHighResTime() > m_timer + maxLife)
   {
     g_context->m_location->Bang(m_pos, 15.0f, 25.0f);
-    g_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
-    g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Explode"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundStop(m_id));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Explode"));
     return true;
   }
 
@@ -339,7 +401,7 @@ bool Rocket::Advance()
   if (g_context->m_location->m_landscape.m_heightMap->GetValue(m_pos.x, m_pos.z) >= m_pos.y)
   {
     g_context->m_location->Bang(m_pos, 15.0f, 25.0f);
-    g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Explode"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Explode"));
     return true;
   }
 
@@ -355,7 +417,7 @@ bool Rocket::Advance()
     if (building->DoesSphereHit(m_pos, 3.0f))
     {
       g_context->m_location->Bang(m_pos, 15.0f, 25.0f);
-      g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Explode"));
+      g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeRocket, "Explode"));
       return true;
     }
   }
@@ -373,7 +435,25 @@ void Laser::Initialise(float _lifeTime)
   m_harmless = false;
   m_bounced = false;
 
-  g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "Create"));
+  g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "Create"));
+}
+
+void Laser::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_fromTeamId);
+  _writer.Write(m_life);
+  _writer.Write(m_harmless);
+  _writer.Write(m_bounced);
+}
+
+void Laser::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_fromTeamId);
+  _reader.Read(m_life);
+  _reader.Read(m_harmless);
+  _reader.Read(m_bounced);
 }
 
 bool Laser::Advance()
@@ -415,7 +495,7 @@ bool Laser::Advance()
     distanceRemaining.SetLength(distanceTotal - distanceTravelled);
 
     m_pos += distanceRemaining;
-    g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "Richochet"));
+    g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "Richochet"));
 
     m_bounced = true;
   }
@@ -445,8 +525,8 @@ bool Laser::Advance()
         vel.x += sfrand(10.0f);
         vel.y += sfrand(10.0f);
         vel.z += sfrand(10.0f);
-        g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeRocketTrail));
-        g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "HitBuilding"));
+        g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeRocketTrail));
+        g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "HitBuilding"));
         return true;
       }
     }
@@ -470,7 +550,7 @@ bool Laser::Advance()
 
         if (PointSegDist2D(Vector2(entity->m_pos), Vector2(rayStart), Vector2(rayEnd)) < 10.0f)
         {
-          g_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "HitEntity"));
+          g_context->m_simEventQueue.Push(SimEvent::MakeSoundOther(m_pos, m_id, SimSoundSource::TypeLaser, "HitEntity"));
           if (entity->m_type == Entity::TypeSpider
             || entity->m_type == Entity::TypeTriffidEgg || entity->m_type == Entity::TypeSoulDestroyer || entity->m_type ==
             Entity::TypeArmour)
@@ -517,6 +597,22 @@ Shockwave::Shockwave(int _teamId, float _size)
   m_type = EffectShockwave;
 }
 
+void Shockwave::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_teamId);
+  _writer.Write(m_size);
+  _writer.Write(m_life);
+}
+
+void Shockwave::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_teamId);
+  _reader.Read(m_size);
+  _reader.Read(m_life);
+}
+
 bool Shockwave::Advance()
 {
   m_life -= SERVER_ADVANCE_PERIOD;
@@ -579,6 +675,22 @@ MuzzleFlash::MuzzleFlash(const LegacyVector3& _pos, const LegacyVector3& _front,
     m_size(_size),
     m_life(_life) { m_pos = _pos; }
 
+void MuzzleFlash::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  WriteSnapshotVector(_writer, m_front);
+  _writer.Write(m_size);
+  _writer.Write(m_life);
+}
+
+void MuzzleFlash::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  ReadSnapshotVector(_reader, m_front);
+  _reader.Read(m_size);
+  _reader.Read(m_life);
+}
+
 bool MuzzleFlash::Advance()
 {
   if (m_life <= 0.0f)
@@ -669,8 +781,8 @@ bool Missile::Advance()
 
   Matrix34 mat(m_front, m_up, m_pos);
   LegacyVector3 boosterPos = m_shape->GetMarkerWorldMatrix(m_booster, mat).pos;
-  g_simEventQueue.Push(SimEvent::MakeParticle(boosterPos - m_vel * SERVER_ADVANCE_PERIOD * 2.0f, vel, SimParticle::TypeMissileTrail, size));
-  g_simEventQueue.Push(SimEvent::MakeParticle(boosterPos - m_vel * SERVER_ADVANCE_PERIOD * 1.5f, vel, SimParticle::TypeMissileTrail, size));
+  g_context->m_simEventQueue.Push(SimEvent::MakeParticle(boosterPos - m_vel * SERVER_ADVANCE_PERIOD * 2.0f, vel, SimParticle::TypeMissileTrail, size));
+  g_context->m_simEventQueue.Push(SimEvent::MakeParticle(boosterPos - m_vel * SERVER_ADVANCE_PERIOD * 1.5f, vel, SimParticle::TypeMissileTrail, size));
 
   return false;
 }
@@ -685,6 +797,18 @@ TurretShell::TurretShell(float _life)
   : WorldObject(),
     m_life(_life) { m_type = EffectGunTurretShell; }
 
+void TurretShell::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WorldObject::WriteSnapshot(_writer);
+  _writer.Write(m_life);
+}
+
+void TurretShell::ReadSnapshot(SnapshotReader& _reader)
+{
+  WorldObject::ReadSnapshot(_reader);
+  _reader.Read(m_life);
+}
+
 bool TurretShell::Advance()
 {
   //
@@ -765,7 +889,7 @@ bool TurretShell::Advance()
             vel.y += frand(10.0f);
             vel.z += sfrand(10.0f);
             float size = 25.0f + frand(25.0f);
-            g_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeRocketTrail, size));
+            g_context->m_simEventQueue.Push(SimEvent::MakeParticle(m_pos, vel, SimParticle::TypeRocketTrail, size));
           }
           building->Damage(-2);
           return true;
@@ -789,7 +913,7 @@ bool TurretShell::Advance()
       vel.y += frand(10.0f);
       vel.z += sfrand(10.0f);
       float size = 25.0f + frand(25.0f);
-      g_simEventQueue.Push(SimEvent::MakeParticle(oldPos, vel, SimParticle::TypeRocketTrail, size));
+      g_context->m_simEventQueue.Push(SimEvent::MakeParticle(oldPos, vel, SimParticle::TypeRocketTrail, size));
     }
 
     return true;
@@ -30,6 +30,8 @@ class ThrowableWeapon : public WorldObject
 
     void Initialise();
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 
     static float GetMaxForce(int _researchLevel);
     static float GetApproxMaxRange(float _maxForce);
@@ -47,6 +49,8 @@ class Grenade : public ThrowableWeapon
 
     Grenade(const LegacyVector3& _startPos, const LegacyVector3& _front, float _force);
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
 
 // ****************************************************************************
@@ -60,6 +64,8 @@ class AirStrikeMarker : public ThrowableWeapon
 
     AirStrikeMarker(const LegacyVector3& _startPos, const LegacyVector3& _front, float _force);
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
 };
 
 // ****************************************************************************
@@ -92,6 +98,8 @@ class Rocket : public WorldObject
 
     void Initialise();
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
   };
 
 // ****************************************************************************
@@ -110,6 +118,8 @@ class Laser : public WorldObject
 
     void Initialise(float _lifeTime);
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
   };
 
 // ****************************************************************************
@@ -124,6 +134,8 @@ class TurretShell : public WorldObject
     TurretShell(float _life);
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
   };
 
 // ****************************************************************************
@@ -141,6 +153,8 @@ class Shockwave : public WorldObject
     Shockwave(int _teamId, float _size);
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
   };
 
 // ****************************************************************************
@@ -158,6 +172,8 @@ class MuzzleFlash : public WorldObject
     MuzzleFlash(const LegacyVector3& _pos, const LegacyVector3& _front, float _size, float _life);
 
     bool Advance() override;
+    void WriteSnapshot(SnapshotWriter& _writer) const override;
+    void ReadSnapshot(SnapshotReader& _reader) override;
   };
 
 // ****************************************************************************
@@ -2,6 +2,7 @@
 #include "GameContext.h"
 #include "location.h"
 #include "worldobject.h"
+#include "SyncChecksum.h"
 
 #define COEF_OF_RESTITUTION	0.85f
 
@@ -9,8 +10,6 @@
 //  WorldObjectId
 // ****************************************************************************
 
-int WorldObjectId::s_nextUniqueId = 0;
-
 #define ID_MAXTEAMS     256
 #define ID_MAXUNITS     65536
 #define ID_MAXTROOPS    65536
@@ -62,11 +61,11 @@ const WorldObjectId& WorldObjectId::operator =(const WorldObjectId& w)
   return *this;
 }
 
-void WorldObjectId::GenerateUniqueId()
-{
-  ++s_nextUniqueId;
-  m_uniqueId = s_nextUniqueId;
-}
+void WorldObjectId::GenerateUniqueId() { m_uniqueId = ++g_context->m_nextUniqueId; }
+
+int WorldObjectId::GetNextUniqueId() { return g_context->m_nextUniqueId; }
+
+void WorldObjectId::SetNextUniqueId(int _id) { g_context->m_nextUniqueId = _id; }
 
 // ****************************************************************************
 //  Class WorldObject
@@ -76,10 +75,47 @@ void WorldObjectId::GenerateUniqueId()
 WorldObject::WorldObject()
   : m_type(0),
     m_onGround(false),
-    m_enabled(true) {}
+    m_enabled(true),
+    m_syncContribution(0) {}
 
 WorldObject::~WorldObject() {}
 
+// *** GetSyncHash
+uint64_t WorldObject::GetSyncHash() const
+{
+  SyncHasher hasher;
+  hasher.Fold(static_cast<unsigned int>(m_id.GetTeamId())).Fold(m_id.GetUnitId()).Fold(m_id.GetIndex()).Fold(m_id.GetUniqueId());
+  hasher.Fold(m_type);
+  hasher.Fold(m_pos.x).Fold(m_pos.y).Fold(m_pos.z);
+  hasher.Fold(m_vel.x).Fold(m_vel.y).Fold(m_vel.z);
+  hasher.Fold(m_onGround).Fold(m_enabled);
+  return hasher.Value();
+}
+
+// *** WriteSnapshot
+void WorldObject::WriteSnapshot(SnapshotWriter& _writer) const
+{
+  WriteSnapshotId(_writer, m_id);
+  _writer.Write(m_type);
+  WriteSnapshotVector(_writer, m_pos);
+  WriteSnapshotVector(_writer, m_vel);
+  _writer.Write(m_onGround);
+  _writer.Write(m_enabled);
+  _writer.Write(m_syncContribution);
+}
+
+// *** ReadSnapshot
+void WorldObject::ReadSnapshot(SnapshotReader& _reader)
+{
+  ReadSnapshotId(_reader, m_id);
+  _reader.Read(m_type);
+  ReadSnapshotVector(_reader, m_pos);
+  ReadSnapshotVector(_reader, m_vel);
+  _reader.Read(m_onGround);
+  _reader.Read(m_enabled);
+  _reader.Read(m_syncContribution);
+}
+
 // *** BounceOffLandscape
 void WorldObject::BounceOffLandscape()
 {
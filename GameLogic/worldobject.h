@@ -2,6 +2,11 @@
 
 #include "rgb_colour.h"
 #include "LegacyVector3.h"
+#include "HistoryRing.h"
+#include "hi_res_time.h"
+#include "SnapshotStream.h"
+#include "fast_darray.h"
+#include "llist.h"
 
 // ****************************************************************************
 //  Class WorldObjectId
@@ -20,8 +25,6 @@ class WorldObjectId
     int m_index;
     int m_uniqueId;
 
-    static int s_nextUniqueId;
-
   public:
     WorldObjectId();
     WorldObjectId(unsigned char _teamId, int _unitId, int _index, int _uniqueId);
@@ -35,6 +38,9 @@ class WorldObjectId
     void SetUniqueId(int _uniqueId) { m_uniqueId = _uniqueId; }
     void GenerateUniqueId();
 
+    static int GetNextUniqueId();             // The generator is per match; late-join snapshots carry it
+    static void SetNextUniqueId(int _id);
+
     unsigned char GetTeamId() const { return m_teamId; }
     int GetUnitId() const { return m_unitId; }
     int GetIndex() const { return m_index; }
@@ -47,6 +53,237 @@ class WorldObjectId
     const WorldObjectId& operator =(const WorldObjectId& w);
 };
 
+// LegacyVector3 has a user-declared assignment operator, so it is not
+// trivially copyable as far as SnapshotWriter::Write is concerned
+inline void WriteSnapshotVector(SnapshotWriter& _writer, const LegacyVector3& _v)
+{
+  _writer.Write(_v.x);
+  _writer.Write(_v.y);
+  _writer.Write(_v.z);
+}
+
+inline void ReadSnapshotVector(SnapshotReader& _reader, LegacyVector3& _v)
+{
+  _reader.Read(_v.x);
+  _reader.Read(_v.y);
+  _reader.Read(_v.z);
+}
+
+inline void WriteSnapshotId(SnapshotWriter& _writer, const WorldObjectId& _id)
+{
+  _writer.Write(_id.GetTeamId());
+  _writer.Write(_id.GetUnitId());
+  _writer.Write(_id.GetIndex());
+  _writer.Write(_id.GetUniqueId());
+}
+
+inline void ReadSnapshotId(SnapshotReader& _reader, WorldObjectId& _id)
+{
+  auto teamId = _reader.Read<unsigned char>();
+  int unitId = _reader.Read<int>();
+  int index = _reader.Read<int>();
+  int uniqueId = _reader.Read<int>();
+  _id.Set(teamId, unitId, index, uniqueId);
+}
+
+// GetHighResTime() stamps go as an offset from now, since the two machines'
+// clocks share no origin.  Zero, which these fields use for never, stays zero.
+inline void WriteSnapshotTime(SnapshotWriter& _writer, float _time)
+{
+  const bool set = _time != 0.0f;
+  _writer.Write(set);
+  if (set)
+    _writer.Write(static_cast<float>(_time - GetHighResTime()));
+}
+
+inline void ReadSnapshotTime(SnapshotReader& _reader, float& _time)
+{
+  _time = 0.0f;
+  if (_reader.Read<bool>())
+    _time = static_cast<float>(GetHighResTime() + _reader.Read<float>());
+}
+
+// LLists of plain values, ids and vectors, in list order
+template <class T>
+void WriteSnapshotList(SnapshotWriter& _writer, const LList<T>& _list)
+{
+  _writer.WriteCount(_list.Size());
+  for (int i = 0; i < _list.Size(); ++i)
+    _writer.Write(_list.GetData(i));
+}
+
+template <class T>
+void ReadSnapshotList(SnapshotReader& _reader, LList<T>& _list)
+{
+  _list.Empty();
+  const int size = _reader.ReadCount();
+  for (int i = 0; i < size; ++i)
+    _list.PutDataAtEnd(_reader.Read<T>());
+}
+
+inline void WriteSnapshotList(SnapshotWriter& _writer, const LList<WorldObjectId>& _list)
+{
+  _writer.WriteCount(_list.Size());
+  for (int i = 0; i < _list.Size(); ++i)
+    WriteSnapshotId(_writer, *_list.GetPointer(i));
+}
+
+inline void ReadSnapshotList(SnapshotReader& _reader, LList<WorldObjectId>& _list)
+{
+  _list.Empty();
+  const int size = _reader.ReadCount();
+  for (int i = 0; i < size; ++i)
+  {
+    WorldObjectId id;
+    ReadSnapshotId(_reader, id);
+    _list.PutDataAtEnd(id);
+  }
+}
+
+inline void WriteSnapshotList(SnapshotWriter& _writer, const LList<LegacyVector3>& _list)
+{
+  _writer.WriteCount(_list.Size());
+  for (int i = 0; i < _list.Size(); ++i)
+    WriteSnapshotVector(_writer, *_list.GetPointer(i));
+}
+
+inline void ReadSnapshotList(SnapshotReader& _reader, LList<LegacyVector3>& _list)
+{
+  _list.Empty();
+  const int size = _reader.ReadCount();
+  for (int i = 0; i < size; ++i)
+  {
+    LegacyVector3 v;
+    ReadSnapshotVector(_reader, v);
+    _list.PutDataAtEnd(v);
+  }
+}
+
+// Writes a FastDArray's slot layout: every slot, then the free list in the
+// order PutData will reuse it.  A reader that rebuilds both hands out the
+// same indices as the host from then on.
+template <class T, class WriteSlot>
+void WriteSnapshotArray(SnapshotWriter& _writer, const FastDArray<T>& _array, WriteSlot _writeSlot)
+{
+  _writer.WriteCount(_array.Size());
+  for (int i = 0; i < _array.Size(); ++i)
+  {
+    const bool used = _array.ValidIndex(i);
+    _writer.Write(used);
+    if (used)
+      _writeSlot(i);
+  }
+
+  std::vector<int> freeList;
+  for (int i = _array.FreeListHead(); i != -1; i = _array.FreeListNext(i))
+    freeList.push_back(i);
+
+  _writer.WriteCount(static_cast<int>(freeList.size()));
+  for (int index : freeList)
+    _writer.WriteVarUInt(static_cast<uint32_t>(index));
+}
+
+// Rebuilds an empty FastDArray from WriteSnapshotArray's output.  _readSlot
+// returns the element for each used slot.  A slot layout that could not have
+// been written invalidates _reader.
+template <class T, class ReadSlot>
+bool ReadSnapshotArray(SnapshotReader& _reader, FastDArray<T>& _array, ReadSlot _readSlot)
+{
+  const int size = _reader.ReadCount();
+  if (_reader.Overflowed())
+    return false;
+
+  // A fresh array hands out slots 0, 1, 2... so every PutData below lands on index i
+  _array.Empty();
+  if (size > 0)
+    _array.SetSize(size);
+
+  std::vector<int> unused;
+  for (int i = 0; i < size; ++i)
+  {
+    if (_reader.Read<bool>())
+      _array.PutData(_readSlot(i));
+    else
+    {
+      _array.PutData(T{});
+      unused.push_back(i);
+    }
+  }
+  for (int index : unused)
+    _array.MarkNotUsed(index);
+
+  const int numFree = _reader.ReadCount();
+  if (numFree != static_cast<int>(unused.size()))
+  {
+    _reader.Invalidate();
+    return false;
+  }
+
+  std::vector<int> freeList(numFree);
+  std::vector<bool> listed(size, false);
+  for (int& index : freeList)
+  {
+    const uint32_t slot = _reader.ReadVarUInt();
+    if (slot >= static_cast<uint32_t>(size) || _array.ValidIndex(static_cast<int>(slot)) || listed[slot])
+    {
+      _reader.Invalidate();
+      break;
+    }
+    index = static_cast<int>(slot);
+    listed[slot] = true;
+  }
+  if (_reader.Overflowed())
+    return false;
+
+  _array.SetFreeList(freeList.data(), numFree);
+  return true;
+}
+
+// Moves a staged array's slots and free list into _to, whose old elements the
+// caller has already dealt with.  Leaves _from empty.
+template <class T>
+void InstallSnapshotArray(FastDArray<T>& _to, FastDArray<T>& _from)
+{
+  std::vector<int> freeList;
+  for (int i = _from.FreeListHead(); i != -1; i = _from.FreeListNext(i))
+    freeList.push_back(i);
+
+  _to.Empty();
+  if (_from.Size() > 0)
+    _to.SetSize(_from.Size());
+  for (int i = 0; i < _from.Size(); ++i)
+    _to.PutData(_from.ValidIndex(i) ? _from[i] : T{});
+  for (int i = 0; i < _from.Size(); ++i)
+  {
+    if (!_from.ValidIndex(i))
+      _to.MarkNotUsed(i);
+  }
+  _to.SetFreeList(freeList.data(), static_cast<int>(freeList.size()));
+  _from.Empty();
+}
+
+// Oldest first, so that pushing them back in order rebuilds the ring
+template <int Capacity>
+void WriteSnapshotHistory(SnapshotWriter& _writer, const Neuron::HistoryRing<LegacyVector3, Capacity>& _history)
+{
+  _writer.WriteCount(_history.Size());
+  for (int i = _history.Size() - 1; i >= 0; --i)
+    WriteSnapshotVector(_writer, _history[i]);
+}
+
+template <int Capacity>
+void ReadSnapshotHistory(SnapshotReader& _reader, Neuron::HistoryRing<LegacyVector3, Capacity>& _history)
+{
+  _history.Clear();
+  const int size = _reader.ReadCount();
+  for (int i = 0; i < size; ++i)
+  {
+    LegacyVector3 v;
+    ReadSnapshotVector(_reader, v);
+    _history.Push(v);
+  }
+}
+
 // ****************************************************************************
 //  Class WorldObject
 // ****************************************************************************
@@ -81,11 +318,19 @@ class WorldObject
     bool m_onGround;
     bool m_enabled;
 
+    uint64_t m_syncContribution; // Digest last folded into the Location sync checksum
+
     WorldObject();
     virtual ~WorldObject();
     void BounceOffLandscape();
 
     virtual bool Advance();
+    virtual uint64_t GetSyncHash() const; // Digest of the simulation state, see SyncChecksum.h
+
+    // Late-join snapshot of the simulation state.  Overrides call the base
+    // class first; state a class does not write is left as Begin() set it.
+    virtual void WriteSnapshot(SnapshotWriter& _writer) const;
+    virtual void ReadSnapshot(SnapshotReader& _reader);
 };
 
 // ****************************************************************************
@@ -84,10 +84,14 @@ void DarwinianRenderer::Render(const Entity& _entity, const EntityRenderContext&
         LegacyVector3 pos4 = pos1 + LegacyVector3(0.0f, 0.0f, size * 2.0f);
         LegacyVector3 pos3 = pos2 + LegacyVector3(0.0f, 0.0f, size * 2.0f);
 
-        pos1.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos1.x, pos1.z);
-        pos2.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos2.x, pos2.z);
-        pos3.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos3.x, pos3.z);
-        pos4.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos4.x, pos4.z);
+        const float cornerX[4] = {pos1.x, pos2.x, pos3.x, pos4.x};
+        const float cornerZ[4] = {pos1.z, pos2.z, pos3.z, pos4.z};
+        float cornerHeights[4];
+        g_context->m_location->m_landscape.m_heightMap->GetValues(cornerX, cornerZ, cornerHeights, 4);
+        pos1.y = 0.3f + cornerHeights[0];
+        pos2.y = 0.3f + cornerHeights[1];
+        pos3.y = 0.3f + cornerHeights[2];
+        pos4.y = 0.3f + cornerHeights[3];
 
         // Flush accumulated main-sprite quads before changing depthMask
         batcher.Flush();
@@ -235,10 +239,14 @@ void DarwinianRenderer::Render(const Entity& _entity, const EntityRenderContext&
                     pos4 -= entityRight;
                     pos3 += entityRight;
 
-                    pos1.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos1.x, pos1.z);
-                    pos2.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos2.x, pos2.z);
-                    pos3.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos3.x, pos3.z);
-                    pos4.y = 0.3f + g_context->m_location->m_landscape.m_heightMap->GetValue(pos4.x, pos4.z);
+                    const float cornerX[4] = {pos1.x, pos2.x, pos3.x, pos4.x};
+                    const float cornerZ[4] = {pos1.z, pos2.z, pos3.z, pos4.z};
+                    float cornerHeights[4];
+                    g_context->m_location->m_landscape.m_heightMap->GetValues(cornerX, cornerZ, cornerHeights, 4);
+                    pos1.y = 0.3f + cornerHeights[0];
+                    pos2.y = 0.3f + cornerHeights[1];
+                    pos3.y = 0.3f + cornerHeights[2];
+                    pos4.y = 0.3f + cornerHeights[3];
 
                     glShadeModel(GL_SMOOTH);
                     glDepthMask(false);
@@ -57,10 +57,14 @@ void ShadowRenderer::Render(const LegacyVector3& _pos, float _size)
     LegacyVector3 posC = shadowPos + shadowR + shadowU;
     LegacyVector3 posD = shadowPos - shadowR + shadowU;
 
-    posA.y = g_context->m_location->m_landscape.m_heightMap->GetValue(posA.x, posA.z) + 0.9f;
-    posB.y = g_context->m_location->m_landscape.m_heightMap->GetValue(posB.x, posB.z) + 0.9f;
-    posC.y = g_context->m_location->m_landscape.m_heightMap->GetValue(posC.x, posC.z) + 0.9f;
-    posD.y = g_context->m_location->m_landscape.m_heightMap->GetValue(posD.x, posD.z) + 0.9f;
+    const float cornerX[4] = {posA.x, posB.x, posC.x, posD.x};
+    const float cornerZ[4] = {posA.z, posB.z, posC.z, posD.z};
+    float cornerHeights[4];
+    g_context->m_location->m_landscape.m_heightMap->GetValues(cornerX, cornerZ, cornerHeights, 4);
+    posA.y = cornerHeights[0] + 0.9f;
+    posB.y = cornerHeights[1] + 0.9f;
+    posC.y = cornerHeights[2] + 0.9f;
+    posD.y = cornerHeights[3] + 0.9f;
 
     posA.y = std::max(posA.y, 1.0f);
     posB.y = std::max(posB.y, 1.0f);
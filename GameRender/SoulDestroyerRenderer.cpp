@@ -39,8 +39,8 @@ void SoulDestroyerRenderer::Render(const Entity& _entity, const EntityRenderCont
 
     for (int i = 1; i < sd.m_positionHistory.Size(); i += 1)
     {
-        LegacyVector3 pos1 = *sd.m_positionHistory.GetPointer(i);
-        LegacyVector3 pos2 = *sd.m_positionHistory.GetPointer(i - 1);
+        const LegacyVector3& pos1 = sd.m_positionHistory[i];
+        const LegacyVector3& pos2 = sd.m_positionHistory[i - 1];
 
         LegacyVector3 pos = pos1 + (pos2 - pos1);
         LegacyVector3 vel = (pos2 - pos1) / SERVER_ADVANCE_PERIOD;
@@ -66,26 +66,18 @@ void SoulDestroyerRenderer::Render(const Entity& _entity, const EntityRenderCont
     glEnable(GL_BLEND);
     glDepthMask(false);
 
-    // TODO Phase 6: eliminate mutation — m_spirits.MarkNotUsed() should move to Advance()
-    SoulDestroyer& mutableSd = const_cast<SoulDestroyer&>(sd);
-
     float timeNow = GetHighResTime();
     for (int i = 0; i < sd.m_spirits.Size(); ++i)
     {
         if (sd.m_spirits.ValidIndex(i))
         {
-            float birthTime = sd.m_spirits[i];
-            if (timeNow >= birthTime + 60.0f)
-                mutableSd.m_spirits.MarkNotUsed(i);
-            else
-            {
-                float alpha = 1.0f - (timeNow - sd.m_spirits[i]) / 60.0f;
-                alpha = std::min(alpha, 1.0f);
-                alpha = std::max(alpha, 0.0f);
-                LegacyVector3 pos = sd.m_pos + sd.m_spiritPosition[i];
-                pos += sd.m_vel * predictionTime;
-                RenderSpirit(pos, alpha);
-            }
+            // SoulDestroyer::Advance frees them once faded
+            float alpha = 1.0f - (timeNow - sd.m_spirits[i]) / 60.0f;
+            alpha = std::min(alpha, 1.0f);
+            alpha = std::max(alpha, 0.0f);
+            LegacyVector3 pos = sd.m_pos + sd.m_spiritPosition[i];
+            pos += sd.m_vel * predictionTime;
+            RenderSpirit(pos, alpha);
         }
     }
 
@@ -120,8 +112,8 @@ void SoulDestroyerRenderer::RenderShapes(const Entity& _entity, float _predictio
 
     for (int i = 1; i < sd.m_positionHistory.Size(); i += 1)
     {
-        LegacyVector3 pos1 = *sd.m_positionHistory.GetPointer(i);
-        LegacyVector3 pos2 = *sd.m_positionHistory.GetPointer(i - 1);
+        const LegacyVector3& pos1 = sd.m_positionHistory[i];
+        const LegacyVector3& pos2 = sd.m_positionHistory[i - 1];
 
         LegacyVector3 pos = pos1 + (pos2 - pos1);
         LegacyVector3 front = (pos2 - pos1).Normalise();
@@ -69,7 +69,7 @@ void ViriiRenderer::Render(const Entity& _entity, const EntityRenderContext& _ct
     prevPos.m_right = -v.m_front ^ landNormal;
     LegacyVector3 firstPos;
     if (v.m_positionHistory.Size() > 0)
-        firstPos = v.m_positionHistory[0]->m_pos;
+        firstPos = v.m_positionHistory[0].m_pos;
     prevPos.m_distance = (predictedPos - firstPos).Mag();
     prevPos.m_glowDiff = (predictedPos - firstPos).SetLength(10.0f);
 
@@ -99,15 +99,15 @@ void ViriiRenderer::Render(const Entity& _entity, const EntityRenderContext& _ct
 
     for (int i = 0; i < lastIndex; i++)
     {
-        ViriiHistory* history = v.m_positionHistory[i];
+        const ViriiHistory& history = v.m_positionHistory[i];
 
-        if (!history->m_required)
+        if (!history.m_required)
         {
-            skippedDistance += history->m_distance;
+            skippedDistance += history.m_distance;
             continue;
         }
 
-        LegacyVector3& pos = history->m_pos;
+        const LegacyVector3& pos = history.m_pos;
         LegacyVector3 wormRightAngle = prevPos.m_right * wormWidth;
         LegacyVector3 glowRightAngle = prevPos.m_right * glowWidth;
         float distance = prevPos.m_distance + skippedDistance;
@@ -151,7 +151,7 @@ void ViriiRenderer::Render(const Entity& _entity, const EntityRenderContext& _ct
                 makeVtx(pos - glowRightAngle - glowDiff, glowColor, glowTexXpos, glowTexH));
         }
 
-        prevPos = *history;
+        prevPos = history;
     }
 
     // No Flush here — caller (Team::RenderVirii) flushes after all virii.
@@ -35,7 +35,7 @@ void NetworkWindow::Render(bool hasFocus)
 #endif // PROFILER_ENABLED
     g_editorFont.DrawText2D(m_x + 10, m_y + 30, DEF_FONT_SIZE, "SERVER SeqID : %d", g_context->m_server->m_sequenceId);
 
-    int diff = g_context->m_server->m_sequenceId - g_lastProcessedSequenceId;
+    int diff = g_context->m_server->m_sequenceId - g_context->m_lastProcessedSequenceId;
     g_editorFont.DrawText2D(m_x + 10, m_y + 60, DEF_FONT_SIZE, "Diff         : %d", diff);
   }
 
@@ -45,7 +45,7 @@ void NetworkWindow::Render(bool hasFocus)
   //    g_editorFont.DrawText2D( m_x + 10, m_y + 175, DEF_FONT_SIZE,
   //		"Client RECV  : %4.0f bytes", g_context->m_profiler->GetTotalTime("Client Receive") );
 #endif // PROFILER_ENABLED
-  g_editorFont.DrawText2D(m_x + 10, m_y + 45, DEF_FONT_SIZE, "CLIENT SeqID : %d", g_lastProcessedSequenceId);
+  g_editorFont.DrawText2D(m_x + 10, m_y + 45, DEF_FONT_SIZE, "CLIENT SeqID : %d", g_context->m_lastProcessedSequenceId);
 
   g_editorFont.DrawText2D(m_x + 10, m_y + 80, DEF_FONT_SIZE, "Inbox: %d", g_context->m_clientToServer->m_inbox.Size());
 
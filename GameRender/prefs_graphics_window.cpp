@@ -146,7 +146,7 @@ void RenderCPUUsage(LList<const char*>* elements, int x, int y)
   float totalOccup = 0.0f;
   for (int i = 0; i < elements->Size(); ++i)
   {
-    ProfiledElement* element = g_context->m_profiler->m_rootElement->m_children.GetData(elements->GetData(i));
+    ProfiledElement* element = g_context->m_profiler->m_rootElement->m_children.Get(elements->GetData(i));
     if (element && element->m_lastNumCalls > 0)
     {
       float occup = element->m_lastTotalTime * 100;
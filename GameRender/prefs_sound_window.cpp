@@ -290,7 +290,7 @@ void PrefsSoundWindow::Render( bool _hasFocus )
 //    g_editorFont.DrawText2DCenter( m_x + m_w/2, m_y + m_h - 70, 12, "%d channels allocated", numChannels );
 
 #ifdef PROFILER_ENABLED
-    ProfiledElement *element = g_context->m_profiler->m_rootElement->m_children.GetData( "Advance SoundSystem" );
+    ProfiledElement *element = g_context->m_profiler->m_rootElement->m_children.Get( "Advance SoundSystem" );
     if( element->m_lastNumCalls > 0 )
     {
         float occup = element->m_lastTotalTime * 100;
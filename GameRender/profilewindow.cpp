@@ -73,7 +73,7 @@ ProfileWindow::~ProfileWindow()
 
 void ProfileWindow::RenderElementProfile(ProfiledElement *_pe, unsigned int _indent)
 {
-	if (_pe->m_children.NumUsed() == 0) return;
+	if (_pe->m_children.IsEmpty()) return;
 
     int left = m_x + 10;
     std::string caption;
@@ -92,11 +92,8 @@ void ProfileWindow::RenderElementProfile(ProfiledElement *_pe, unsigned int _ind
 	float largestTime = 1000.0f * _pe->GetMaxChildTime();
 	float totalTime = 0.0f;
 
-	short i = _pe->m_children.StartOrderedWalk();
-	while (i != -1)
+	_pe->m_children.ForEachSorted([&](std::string_view, ProfiledElement *child)
     {
-        ProfiledElement *child = _pe->m_children[i];
-
         float time = float( child->m_lastTotalTime * 1000.0f );
 		float avrgTime = 1000.0f * child->m_historyTotalTime / child->m_historyNumCalls;
 		if (avrgTime > 0.0f)
@@ -104,7 +101,7 @@ void ProfileWindow::RenderElementProfile(ProfiledElement *_pe, unsigned int _ind
 			totalTime += time;
 
 			char icon[] = " ";
-			if (child->m_children.NumUsed() > 0)
+			if (!child->m_children.IsEmpty())
 			{
 				icon[0] = child->m_isExpanded ? '-' : '+';
 			}
@@ -162,14 +159,12 @@ void ProfileWindow::RenderElementProfile(ProfiledElement *_pe, unsigned int _ind
 				m_h += 12;
 			}
 
-			if (child->m_isExpanded && child->m_children.NumUsed() > 0)
+			if (child->m_isExpanded && !child->m_children.IsEmpty())
 			{
 				RenderElementProfile(child, _indent + 2);
 			}
 		}
-
-		i = _pe->m_children.GetNextOrderedIndex();
-    }
+    });
 
 	glColor3ub(255,255,255);
 	g_editorFont.DrawText2D( left + (_indent+1) * 7.5f, m_yPos+=12, DEF_FONT_SIZE, "Total %.0f", totalTime );
@@ -2,6 +2,7 @@
 
 
 #include "2d_array.h"
+#include "SurfaceKernels.h"
 
 
 // ****************************************************************************
@@ -39,6 +40,7 @@ public:
 							   T _outsideValue);
 
 	T 				GetValue(float _x, float _y) const;
+	void			GetValues(const float *_x, const float *_y, T *_values, int _count) const; // GetValue at each point, four at a time for float maps
 	T const			&GetValueNearest(float _x, float _y) const; // Like GetValue but without interpolation
 	T				*GetPointerNearest(float _x, float _y) const;
 	T				GetHighestValue() const;
@@ -151,6 +153,28 @@ T SurfaceMap2D<T>::GetValue(float _x, float _y) const
 }
 
 
+// For callers that know all their points up front.  Entities still snap to
+// the ground with GetValue: each picks its point mid-Advance, after moving,
+// so the points only exist one at a time and in sim order.
+template <class T>
+void SurfaceMap2D<T>::GetValues(const float *_x, const float *_y, T *_values, int _count) const
+{
+	if constexpr (std::is_same_v<T, float>)
+	{
+		if (this->m_numColumns > 0 && this->m_numRows > 0)
+		{
+			const Neuron::Surface::Grid grid{ this->m_data, this->m_numColumns, this->m_numRows,
+											  m_x0, m_y0, m_invCellSizeX, m_invCellSizeY };
+			Neuron::Surface::SampleBilinear(grid, _x, _y, _values, _count);
+			return;
+		}
+	}
+
+	for (int i = 0; i < _count; ++i)
+		_values[i] = GetValue(_x[i], _y[i]);
+}
+
+
 template <class T>
 T const& SurfaceMap2D<T>::GetValueNearest(float _x, float _y) const
 {
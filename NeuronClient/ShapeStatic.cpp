@@ -7,11 +7,6 @@
 #include "ShapeMeshCache.h"
 #include "opengl_directx_internals.h"
 
-// Per-thread scratch buffer for world-space positions in accurate hit-tests.
-// Grows to the largest fragment encountered and stays allocated for reuse.
-// Safe across recursion: each level fully consumes the buffer before recurring.
-static thread_local std::vector<LegacyVector3> t_scratchWS;
-
 // ****************************************************************************
 // Class ShapeMarkerData
 // ****************************************************************************
@@ -246,6 +241,7 @@ ShapeFragmentData::ShapeFragmentData(TextReader* _in, const char* _name)
     m_parentName = _strdup("unknown");
 
   GenerateNormals();
+  BuildHitTree();
 }
 
 // This constructor is used when you want to build a shape from scratch yourself,
@@ -614,6 +610,19 @@ void ShapeFragmentData::GenerateNormals()
   }
 }
 
+// *** BuildHitTree
+// Groups the triangles into a bounding-volume hierarchy so that accurate hit
+// tests only run the exact triangle test on the triangles near the query.
+void ShapeFragmentData::BuildHitTree()
+{
+  m_hitTree.Build(static_cast<int>(m_numTriangles), [this](int _triangle, int _corner) -> const LegacyVector3&
+  {
+    const ShapeTriangle& tri = m_triangles[_triangle];
+    const unsigned short vertex = _corner == 0 ? tri.v1 : _corner == 1 ? tri.v2 : tri.v3;
+    return m_positions[m_vertices[vertex].m_posId];
+  });
+}
+
 // *** RegisterPositions
 void ShapeFragmentData::RegisterPositions(LegacyVector3* _positions, unsigned int _numPositions)
 {
@@ -922,23 +931,16 @@ bool ShapeFragmentData::RayHit(const FragmentState* _states, RayPackage* _packag
     if (_accurate == false)
       return true;
 
-    // Compute World Space versions of all the vertices
-    if (t_scratchWS.size() < m_numPositions)
-      t_scratchWS.resize(m_numPositions);
-    LegacyVector3* positionsInWS = t_scratchWS.data();
-    for (unsigned int i = 0; i < m_numPositions; ++i)
-      positionsInWS[i] = m_positions[i] * totalMatrix;
-
-    // Check each triangle in this fragment for intersection
-    for (unsigned int j = 0; j < m_numTriangles; ++j)
+    // Check the triangles the hit tree can't rule out, in world space
+    DEBUG_ASSERT(m_hitTree.GetNumTriangles() == static_cast<int>(m_numTriangles));
+    bool hit = m_hitTree.AnyNearLine(totalMatrix, _package->m_rayStart, _package->m_rayDir, [&](int _triangle)
     {
-      VertexPosCol* v1 = &m_vertices[m_triangles[j].v1];
-      VertexPosCol* v2 = &m_vertices[m_triangles[j].v2];
-      VertexPosCol* v3 = &m_vertices[m_triangles[j].v3];
-      if (RayTriIntersection(_package->m_rayStart, _package->m_rayDir, positionsInWS[v1->m_posId], positionsInWS[v2->m_posId],
-                             positionsInWS[v3->m_posId]))
-        return true;
-    }
+      const ShapeTriangle& tri = m_triangles[_triangle];
+      return RayTriIntersection(_package->m_rayStart, _package->m_rayDir, m_positions[m_vertices[tri.v1].m_posId] * totalMatrix,
+                                m_positions[m_vertices[tri.v2].m_posId] * totalMatrix, m_positions[m_vertices[tri.v3].m_posId] * totalMatrix);
+    });
+    if (hit)
+      return true;
   }
 
   // If we haven't found a hit then recurse into all child fragments
@@ -968,23 +970,17 @@ bool ShapeFragmentData::SphereHit(const FragmentState* _states, SpherePackage* _
     if (_accurate == false)
       return true;
 
-    // Compute World Space versions of all the vertices
-    if (t_scratchWS.size() < m_numPositions)
-      t_scratchWS.resize(m_numPositions);
-    LegacyVector3* positionsInWS = t_scratchWS.data();
-    for (unsigned int i = 0; i < m_numPositions; ++i)
-      positionsInWS[i] = m_positions[i] * totalMatrix;
-
-    // Check each triangle in this fragment for intersection
-    for (unsigned int j = 0; j < m_numTriangles; ++j)
+    // Check the triangles the hit tree can't rule out, in world space
+    DEBUG_ASSERT(m_hitTree.GetNumTriangles() == static_cast<int>(m_numTriangles));
+    bool hit = m_hitTree.AnyNearSphere(totalMatrix, _package->m_pos, _package->m_radius, [&](int _triangle)
     {
-      VertexPosCol* v1 = &m_vertices[m_triangles[j].v1];
-      VertexPosCol* v2 = &m_vertices[m_triangles[j].v2];
-      VertexPosCol* v3 = &m_vertices[m_triangles[j].v3];
-      if (SphereTriangleIntersection(_package->m_pos, _package->m_radius, positionsInWS[v1->m_posId], positionsInWS[v2->m_posId],
-                                     positionsInWS[v3->m_posId]))
-        return true;
-    }
+      const ShapeTriangle& tri = m_triangles[_triangle];
+      return SphereTriangleIntersection(_package->m_pos, _package->m_radius, m_positions[m_vertices[tri.v1].m_posId] * totalMatrix,
+                                        m_positions[m_vertices[tri.v2].m_posId] * totalMatrix,
+                                        m_positions[m_vertices[tri.v3].m_posId] * totalMatrix);
+    });
+    if (hit)
+      return true;
   }
 
   // If we haven't found a hit then recurse into all child fragments
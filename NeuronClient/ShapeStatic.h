@@ -4,6 +4,7 @@
 #include "matrix34.h"
 #include "rgb_colour.h"
 #include "LegacyVector3.h"
+#include "TriangleBvh.h"
 
 class TextReader;
 class ShapeFragmentData;
@@ -117,6 +118,7 @@ class ShapeFragmentData
     void ParseTriangleBlock(TextReader* in, unsigned int numTriangles);
 
     void GenerateNormals();
+    void BuildHitTree();
 
   public:
     // Geometry (loaded from disk, never modified)
@@ -142,6 +144,7 @@ class ShapeFragmentData
     float m_radius;
     float m_mostPositiveY;
     float m_mostNegativeY;
+    Neuron::TriangleBvh m_hitTree; // Culls triangles for accurate hit tests; built by the loading constructor
 
     // Tree structure
     int m_fragmentIndex; // Ordinal in ShapeStatic's flat array
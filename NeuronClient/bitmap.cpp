@@ -8,6 +8,7 @@
 #include "rgb_colour.h"
 #include "preferences.h"
 #include "GameApp.h"
+#include "ImageKernels.h"
 
 #define BMP_RGB				0
 #define OS2INFOHEADERSIZE  12
@@ -443,57 +444,13 @@ void BitmapRGBA::DrawLine(int x1, int y1, int x2, int y2, const RGBAColour& colo
 // *** GetInterpolatedPixel
 RGBAColour BitmapRGBA::GetInterpolatedPixel(float _x, float _y) const
 {
-  int x1 = floorf(_x);
-  int y1 = floorf(_y);
-  int x2 = ceilf(_x);
-  int y2 = ceilf(_y);
-
-  if (x2 == m_width)
-    x2 = m_width - 1;
-
-  if (y2 == m_height)
-    y2 = m_height - 1;
-
-  float fractionalX = _x - x1;
-  float fractionalY = _y - y1;
-
-  float weight11 = (1.0f - fractionalX) * (1.0f - fractionalY);
-  float weight12 = (1.0f - fractionalX) * (fractionalY);
-  float weight21 = (fractionalX) * (1.0f - fractionalY);
-  float weight22 = (fractionalX) * (fractionalY);
-
-  const RGBAColour& c11 = GetPixelClipped(x1, y1);
-  const RGBAColour& c12 = GetPixelClipped(x1, y2);
-  const RGBAColour& c21 = GetPixelClipped(x2, y1);
-  const RGBAColour& c22 = GetPixelClipped(x2, y2);
-
-  RGBAColour returnVal(
-    static_cast<float>(c11.r) * weight11 + static_cast<float>(c12.r) * weight12 + static_cast<float>(c21.r) * weight21 + static_cast<float>(
-      c22.r) * weight22,
-    static_cast<float>(c11.g) * weight11 + static_cast<float>(c12.g) * weight12 + static_cast<float>(c21.g) * weight21 + static_cast<float>(
-      c22.g) * weight22,
-    static_cast<float>(c11.b) * weight11 + static_cast<float>(c12.b) * weight12 + static_cast<float>(c21.b) * weight21 + static_cast<float>(
-      c22.b) * weight22,
-    static_cast<float>(c11.a) * weight11 + static_cast<float>(c12.a) * weight12 + static_cast<float>(c21.a) * weight21 + static_cast<float>(
-      c22.a) * weight22);
-
-  return returnVal;
+  RGBAColour result;
+  Neuron::Image::StorePixel(reinterpret_cast<uint8_t*>(&result),
+                            Neuron::Image::Bilinear(reinterpret_cast<const uint8_t*>(m_pixels), m_width, m_height, _x, _y));
+  return result;
 }
 
-void BitmapRGBA::ConvertToGreyScale()
-{
-  RGBAColour* c = m_pixels;
-  unsigned numPixels = m_width * m_height;
-
-  while (numPixels--)
-  {
-    int average = (c->r + c->b + c->g) / 3;
-    c->r = average;
-    c->b = average;
-    c->g = average;
-    c++;
-  }
-}
+void BitmapRGBA::ConvertToGreyScale() { Neuron::Image::GreyScale(reinterpret_cast<uint8_t*>(m_pixels), m_width * m_height); }
 
 // *** Blit
 void BitmapRGBA::Blit(int _srcX, int _srcY, int _srcW, int _srcH, const BitmapRGBA* _srcBmp, int _destX, int _destY, int _destW, int _destH,
@@ -513,10 +470,11 @@ void BitmapRGBA::Blit(int _srcX, int _srcY, int _srcW, int _srcH, const BitmapRG
     float sx = _srcX;
     if (_bilinear)
     {
-      for (int dx = _destX; dx < _destX + _destW; ++dx)
+      const auto src = reinterpret_cast<const uint8_t*>(_srcBmp->m_pixels);
+      auto dest = reinterpret_cast<uint8_t*>(m_lines[dy] + _destX);
+      for (int dx = 0; dx < _destW; ++dx)
       {
-        const RGBAColour& c = _srcBmp->GetInterpolatedPixel(sx, sy);
-        PutPixel(dx, dy, c);
+        Neuron::Image::StorePixel(dest + dx * 4, Neuron::Image::Bilinear(src, _srcBmp->m_width, _srcBmp->m_height, sx, sy));
         sx += sxPitch;
       }
     }
@@ -538,33 +496,8 @@ void BitmapRGBA::ApplyDilateFilter()
   auto temp = new RGBAColour[m_width * m_height];
   memcpy(temp, m_pixels, sizeof(RGBAColour) * m_width * m_height);
 
-  for (int x = 1; x < m_width - 1; ++x)
-  {
-    for (int y = 1; y < m_height - 1; ++y)
-    {
-      float adjacentRed = 0.0f;
-      float adjacentGreen = 0.0f;
-      float adjacentBlue = 0.0f;
-      for (int i = -1; i <= 1; ++i)
-      {
-        for (int j = -1; j <= 1; ++j)
-        {
-          if (i != 0 || j != 0)
-          {
-            RGBAColour col = temp[(y + j) * m_width + (x + i)];
-            adjacentRed += col.r;
-            adjacentGreen += col.g;
-            adjacentBlue += col.b;
-          }
-        }
-      }
-      adjacentRed /= 8.0f;
-      adjacentGreen /= 8.0f;
-      adjacentBlue /= 8.0f;
+  Neuron::Image::Dilate(reinterpret_cast<const uint8_t*>(temp), reinterpret_cast<uint8_t*>(m_pixels), m_width, m_height);
 
-      m_pixels[y * m_width + x].Set(adjacentRed, adjacentGreen, adjacentBlue);
-    }
-  }
   delete[] temp;
 }
 
@@ -575,88 +508,7 @@ void BitmapRGBA::ApplyBlurFilter(float _scale)
   DEBUG_ASSERT(m_width > 0 && m_width <= 1024);
   DEBUG_ASSERT(m_height > 0 && m_height <= 1024);
 
-  auto temp = new RGBAColour[m_width * m_height];
-  memset(temp, 0, sizeof(RGBAColour) * m_width * m_height);
-
-  constexpr int blurSize = 5;
-  constexpr int halfBlurSize = 2;
-  float m[blurSize] = {2, 4, 7, 4, 2};
-  for (int i = 0; i < blurSize; ++i)
-    m[i] *= _scale * 0.0526f;
-
-  //
-  // Horizontal blur
-
-  for (int y = 0; y < m_height; ++y)
-  {
-    for (int x = 0; x < m_width; ++x)
-    {
-      const RGBAColour& src = m_lines[y][x];
-      if (src.r == 0 && src.g == 0 && src.b == 0)
-        continue;
-
-      for (int i = 0; i < blurSize; ++i)
-      {
-        int a = x + i - halfBlurSize;
-        if (a < 0 || a >= m_width)
-          continue;
-
-        const RGBAColour& dest = temp[y * m_width + a];
-        int r = dest.r + Round(static_cast<float>(src.r) * m[i]);
-        int g = dest.g + Round(static_cast<float>(src.g) * m[i]);
-        int b = dest.b + Round(static_cast<float>(src.b) * m[i]);
-
-        if (r > 255)
-          r = 255;
-        if (g > 255)
-          g = 255;
-        if (b > 255)
-          b = 255;
-
-        temp[y * m_width + a].Set(r, g, b);
-      }
-    }
-  }
-
-  for (int i = 0; i < blurSize; ++i)
-    m[i] *= 2.0f;
-
-  //
-  // Vertical blur
-
-  Clear(RGBAColour(0, 0, 0, 0));
-  for (int y = 0; y < m_height; ++y)
-  {
-    for (int x = 0; x < m_width; ++x)
-    {
-      const RGBAColour& src = temp[y * m_width + x];
-      if (src.r == 0 && src.g == 0 && src.b == 0)
-        continue;
-
-      for (int i = 0; i < blurSize; ++i)
-      {
-        int a = y + i - halfBlurSize;
-        if (a < 0 || a >= m_height)
-          continue;
-
-        const RGBAColour& dest = m_lines[a][x];
-        int r = dest.r + Round(static_cast<float>(src.r) * m[i]);
-        int g = dest.g + Round(static_cast<float>(src.g) * m[i]);
-        int b = dest.b + Round(static_cast<float>(src.b) * m[i]);
-
-        if (r > 255)
-          r = 255;
-        if (g > 255)
-          g = 255;
-        if (b > 255)
-          b = 255;
-
-        m_lines[a][x].Set(r, g, b);
-      }
-    }
-  }
-
-  delete[] temp;
+  Neuron::Image::Blur(reinterpret_cast<uint8_t*>(m_pixels), m_width, m_height, _scale);
 
   END_PROFILE(g_context->m_profiler, "ApplyBlur");
 }
@@ -0,0 +1,285 @@
+#include "pch.h"
+#include "bot_client.h"
+#include "bytestream.h"
+#include "clienttoserver.h"
+#include "net_socket_listener.h"
+#include "net_udp_packet.h"
+#include "networkupdate.h"
+#include "server.h"
+#include "servertoclientletter.h"
+#include "SyncChecksum.h"
+#include "team.h"
+
+BotClient::BotClient(int _index, const char* _serverIp, bool _requestTeam)
+  : m_index(_index),
+    m_requestTeam(_requestTeam),
+    m_socket(nullptr),
+    m_joined(false),
+    m_teamId(255),
+    m_lastProcessedSequenceId(-1),
+    m_nextFrame(0),
+    m_inputAck(-1),
+    m_positionBounds{2000.0f, 2000.0f}
+{
+  GetBotIP(_index, m_ip);
+  m_ipInt = Server::ConvertIPToInt(m_ip);
+
+  memset(&m_serverAddress, 0, sizeof(m_serverAddress));
+  m_serverAddress.sin_family = AF_INET;
+  m_serverAddress.sin_port = htons(SERVER_PORT);
+  inet_pton(AF_INET, _serverIp, &m_serverAddress.sin_addr);
+}
+
+BotClient::~BotClient()
+{
+  for (auto& [sequenceId, letter] : m_inbox)
+    delete letter;
+  m_frame.EmptyAndDelete();
+  m_unacked.EmptyAndDelete();
+  delete m_socket;
+}
+
+void BotClient::GetBotIP(int _index, char* _ip)
+{
+  snprintf(_ip, 16, "127.0.%d.%d", 1 + _index / 250, 1 + _index % 250);
+}
+
+bool BotClient::Connect(NetImpairment* _impairment)
+{
+  DEBUG_ASSERT(!m_socket);
+  const int port = Server::GetClientPort(SERVER_PORT);
+  m_socket = new NetSocketListener(port, m_ip);
+  if (m_socket->Bind() != NetOk)
+  {
+    DebugTrace("BOT {}: Cannot bind {}:{}\n", m_index, m_ip, port);
+    return false;
+  }
+  m_socket->SetImpairment(_impairment);
+
+  auto join = new NetworkUpdate();
+  join->SetType(NetworkUpdate::ClientJoin);
+  Queue(join);
+
+  if (m_requestTeam)
+  {
+    auto request = new NetworkUpdate();
+    request->SetType(NetworkUpdate::RequestTeam);
+    request->SetTeamType(Team::TeamTypeRemotePlayer);
+    request->SetDesiredTeamId(-1);
+    Queue(request);
+  }
+
+  return true;
+}
+
+void BotClient::Leave()
+{
+  if (!m_socket)
+    return;
+
+  auto leave = new NetworkUpdate();
+  leave->SetType(NetworkUpdate::ClientLeave);
+  Queue(leave);
+  SendFrame();
+}
+
+// *** Advance
+// One input frame: everything that has arrived is taken in and processed as
+// far as the sequence allows, then the scripted controls and a sync report
+// for each processed letter go out in one datagram.
+void BotClient::Advance()
+{
+  if (!m_socket)
+    return;
+
+  Receive();
+
+  //
+  // A completed snapshot stands in for every letter up to its sequence id
+
+  if (m_snapshot.IsComplete())
+  {
+    m_lastProcessedSequenceId = m_snapshot.GetSnapshotId();
+    m_snapshot.Reset();
+    m_joined = true;
+    while (!m_inbox.empty() && m_inbox.begin()->first <= m_lastProcessedSequenceId)
+    {
+      delete m_inbox.begin()->second;
+      m_inbox.erase(m_inbox.begin());
+    }
+  }
+
+  while (!m_inbox.empty() && m_inbox.begin()->first == m_lastProcessedSequenceId + 1)
+  {
+    ServerToClientLetter* letter = m_inbox.begin()->second;
+    m_inbox.erase(m_inbox.begin());
+    ProcessLetter(letter);
+    delete letter;
+  }
+
+  //
+  // Scripted input: the cursor circles the map and the buttons are pressed
+  // in a fixed rhythm, offset per bot
+
+  TeamControls controls;
+  const int beat = m_nextFrame + m_index;
+  const float angle = static_cast<float>(m_nextFrame + m_index * 7) * 0.05f;
+  controls.m_mousePos = LegacyVector3(1000.0f + 600.0f * cosf(angle), 0.0f, 1000.0f + 600.0f * sinf(angle));
+  controls.m_unitMove = beat % 10 == 0;
+  controls.m_primaryFireTarget = beat % 7 == 0;
+  controls.m_secondaryFireTarget = beat % 23 == 0;
+
+  auto alive = new NetworkUpdate();
+  alive->SetType(NetworkUpdate::Alive);
+  alive->SetTeamId(static_cast<unsigned char>(m_teamId));
+  alive->SetWorldPos(controls.m_mousePos);
+  alive->SetTeamControls(controls);
+  Queue(alive);
+
+  SendFrame();
+}
+
+void BotClient::Receive()
+{
+  while (NetUdpPacket* packet = m_socket->Poll())
+  {
+    ++m_stats.m_datagramsReceived;
+    m_stats.m_bytesReceived += packet->m_length;
+
+    auto letter = new ServerToClientLetter(packet->m_data, packet->m_length);
+    delete packet;
+
+    if (letter->m_type == ServerToClientLetter::Update)
+    {
+      long long ack = NetworkUpdate::GetInputKey(letter->m_inputAckFrame, letter->m_inputAckIndex);
+      m_inputAck = std::max(m_inputAck, ack);
+    }
+
+    if (letter->m_type == ServerToClientLetter::LocationSnapshot)
+    {
+      ReceiveSnapshotPart(letter);
+      delete letter;
+      continue;
+    }
+
+    if (letter->IsBulk())
+    {
+      delete letter;
+      continue;
+    }
+
+    int sequenceId = letter->GetSequenceId();
+    if (sequenceId <= m_lastProcessedSequenceId || m_inbox.contains(sequenceId))
+    {
+      ++m_stats.m_duplicateLetters;
+      delete letter;
+      continue;
+    }
+    m_inbox[sequenceId] = letter;
+  }
+}
+
+// *** ProcessLetter
+// Notes anything addressed to us and reports a digest of the letter.  The
+// input acknowledgement differs per client, so it is left out.
+void BotClient::ProcessLetter(ServerToClientLetter* _letter)
+{
+  const int sequenceId = _letter->GetSequenceId();
+  DEBUG_ASSERT(sequenceId == m_lastProcessedSequenceId + 1);
+  m_lastProcessedSequenceId = sequenceId;
+  ++m_stats.m_lettersProcessed;
+
+  if (_letter->m_type == ServerToClientLetter::HelloClient && _letter->m_ip == m_ipInt)
+    m_joined = true;
+  if (_letter->m_type == ServerToClientLetter::TeamAssign && _letter->m_ip == m_ipInt)
+    m_teamId = _letter->m_teamId;
+
+  SyncHasher hasher;
+  hasher.Fold(static_cast<int>(_letter->m_type)).Fold(sequenceId);
+  hasher.Fold(static_cast<int>(_letter->m_teamId)).Fold(static_cast<int>(_letter->m_teamType)).Fold(_letter->m_ip);
+  hasher.Fold(_letter->m_updates.Size());
+  for (int i = 0; i < _letter->m_updates.Size(); ++i)
+  {
+    const NetworkUpdate* update = _letter->m_updates[i];
+    const LegacyVector3& pos = update->GetWorldPos();
+    hasher.Fold(static_cast<int>(update->m_type)).Fold(static_cast<int>(update->m_teamId));
+    hasher.Fold(static_cast<int>(update->m_teamControls.GetFlags()));
+    hasher.Fold(pos.x).Fold(pos.y).Fold(pos.z);
+  }
+
+  SyncReport report;
+  report[SyncSubsystem::Entities] = hasher.Value();
+
+  auto sync = new NetworkUpdate();
+  sync->SetType(NetworkUpdate::Syncronise);
+  sync->SetLastProcessedId(sequenceId);
+  sync->SetSyncReport(report);
+  Queue(sync);
+}
+
+// *** ReceiveSnapshotPart
+// Same layout as ClientToServer::ReceiveSnapshotPart.  A bot has no Location
+// to load, so only completeness matters.
+void BotClient::ReceiveSnapshotPart(ServerToClientLetter* _letter)
+{
+  static constexpr int HEADER_SIZE = static_cast<int>(sizeof(int) * 3);
+  if (!_letter->m_bulkData || _letter->m_bulkDataSize < HEADER_SIZE)
+    return;
+
+  char* ptr = _letter->m_bulkData;
+  int snapshotId = READ_INT(ptr);
+  int part = READ_INT(ptr);
+  int numParts = READ_INT(ptr);
+
+  if (snapshotId <= m_lastProcessedSequenceId)
+    return;
+
+  m_snapshot.AddPart(snapshotId, part, numParts, ptr, _letter->m_bulkDataSize - HEADER_SIZE);
+}
+
+void BotClient::Queue(NetworkUpdate* _update)
+{
+  m_frame.PutDataAtEnd(_update);
+}
+
+// *** SendFrame
+// As ClientToServer::AdvanceSender: the frame's commands join the
+// unacknowledged ones, and one datagram carries as many as fit, always
+// starting at the oldest.
+void BotClient::SendFrame()
+{
+  const int frame = m_nextFrame++;
+  for (int i = 0; i < m_frame.Size(); ++i)
+  {
+    NetworkUpdate* update = m_frame[i];
+    update->SetInputFrame(frame, i);
+    update->SetLastSequenceId(m_lastProcessedSequenceId);
+    m_unacked.PutDataAtEnd(update);
+  }
+  m_frame.Empty();
+
+  while (m_unacked.Size() > 0 && m_unacked[0]->GetInputKey() <= m_inputAck)
+  {
+    delete m_unacked[0];
+    m_unacked.RemoveData(0);
+  }
+
+  if (m_unacked.Size() == 0)
+    return;
+
+  static constexpr int MAX_BATCH = 64;
+  NetworkUpdate* batch[MAX_BATCH];
+  char datagram[MAX_PACKET_SIZE];
+
+  int numInBatch = std::min(m_unacked.Size(), MAX_BATCH);
+  for (int i = 0; i < numInBatch; ++i)
+    batch[i] = m_unacked[i];
+
+  int datagramSize = 0;
+  int numPacked = NetworkUpdate::PackBatch(batch, numInBatch, m_positionBounds, datagram, sizeof(datagram), &datagramSize);
+  if (numPacked > 0 && m_socket->SendTo(&m_serverAddress, datagram, datagramSize) == NetOk)
+  {
+    ++m_stats.m_datagramsSent;
+    m_stats.m_bytesSent += datagramSize;
+  }
+}
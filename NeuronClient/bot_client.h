@@ -0,0 +1,87 @@
+#pragma once
+
+#include "llist.h"
+#include "net_lib.h"
+#include "networkupdate.h"
+#include "SnapshotStream.h"
+
+
+class NetImpairment;
+class NetSocketListener;
+class ServerToClientLetter;
+
+
+// ****************************************************************************
+//  Class BotClient
+//
+//  A headless client for load testing the server.  It speaks the same
+//  protocol as ClientToServer but has no Location: it joins, optionally asks
+//  for a team, sends a scripted TeamControls sample every input frame and
+//  consumes the letter stream in sequence order, starting from a snapshot if
+//  the server sends one.
+//
+//  With no simulation to checksum, its sync reports carry a digest of each
+//  letter instead.  Every bot sees the same letter for a sequence id, so the
+//  server reports a desync exactly when two bots were handed different ones.
+//
+//  The server tells clients apart by IP and replies to Server::GetClientPort, so each bot
+//  binds its own loopback address.  A bot has no threads; its owner calls
+//  Advance once per input frame.
+// ****************************************************************************
+
+class BotClient
+{
+public:
+    struct Stats
+    {
+        long long m_datagramsSent = 0;
+        long long m_bytesSent = 0;
+        long long m_datagramsReceived = 0;
+        long long m_bytesReceived = 0;
+        long long m_lettersProcessed = 0;
+        long long m_duplicateLetters = 0;       // Already processed or already waiting
+    };
+
+    BotClient( int _index, const char *_serverIp, bool _requestTeam );
+    ~BotClient();
+
+    bool Connect            ( NetImpairment *_impairment );    // Returns false if the bot's address could not be bound
+    void Advance            ();                                // Takes in what has arrived, then sends one input frame
+    void Leave              ();
+
+    const char *GetIP       () const { return m_ip; }
+    int  GetTeamId          () const { return m_teamId; }
+    int  GetLastProcessedSequenceId () const { return m_lastProcessedSequenceId; }
+    bool HasJoined          () const { return m_joined; }      // The server has acknowledged us
+    const Stats &GetStats   () const { return m_stats; }
+
+    static void GetBotIP    ( int _index, char *_ip );         // 127.0.x.y, never 127.0.0.1
+
+private:
+    void Receive            ();
+    void ProcessLetter      ( ServerToClientLetter *_letter );
+    void ReceiveSnapshotPart( ServerToClientLetter *_letter );
+    void Queue              ( NetworkUpdate *_update );
+    void SendFrame          ();
+
+    int                 m_index;
+    char                m_ip[16];
+    int                 m_ipInt;
+    bool                m_requestTeam;
+    NetIpAddress        m_serverAddress;
+    NetSocketListener   *m_socket;              // Bound to m_ip on the client port; sends as well as receives
+
+    bool                m_joined;
+    int                 m_teamId;               // 255 until a TeamAssign names us
+    int                 m_lastProcessedSequenceId;
+    int                 m_nextFrame;
+    long long           m_inputAck;             // Last command the server applied (NetworkUpdate::GetInputKey)
+    NetworkUpdate::PositionBounds m_positionBounds;     // Holds the scripted cursor, which circles (1000, 1000)
+    std::map<int, ServerToClientLetter *> m_inbox;      // Waiting for the letters before them
+    SnapshotAssembler   m_snapshot;
+
+    LList<NetworkUpdate *> m_frame;             // Commands for the frame being built
+    LList<NetworkUpdate *> m_unacked;           // Unacknowledged, oldest first
+
+    Stats               m_stats;
+};
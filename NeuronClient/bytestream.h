@@ -17,6 +17,7 @@
 #define READ_SIGNED_CHAR(_stream)			*((signed char*)_stream); _stream += sizeof(signed char);
 #define READ_UNSIGNED_CHAR(_stream)         *((unsigned char*)_stream); _stream += sizeof(unsigned char);
 #define READ_UNSIGNED_SHORT(_stream)        *((unsigned short*)_stream); _stream += sizeof(unsigned short);
+#define READ_UNSIGNED_INT64(_stream)        *((uint64_t*)_stream); _stream += sizeof(uint64_t);
 #define READ_WORLDOBJECTID(_stream)         *((WorldObjectId*)_stream); _stream += sizeof(WorldObjectId);
 
 
@@ -25,5 +26,6 @@
 #define WRITE_SIGNED_CHAR(_stream, _val)    *((signed char*)_stream) = _val; _stream += sizeof(signed char);
 #define WRITE_UNSIGNED_CHAR(_stream, _val)  *((unsigned char*)_stream) = _val; _stream += sizeof(unsigned char);
 #define WRITE_UNSIGNED_SHORT(_stream, _val) *((unsigned short*)_stream) = _val; _stream += sizeof(unsigned short);
+#define WRITE_UNSIGNED_INT64(_stream, _val) *((uint64_t*)_stream) = _val; _stream += sizeof(uint64_t);
 #define WRITE_WORLDOBJECTID(_stream, _val)  *((WorldObjectId*)_stream) = _val; _stream += sizeof(WorldObjectId);
 
@@ -1,11 +1,12 @@
 #include "pch.h"
+#include "net_impairment.h"
 #include "net_lib.h"
-#include "net_mutex.h"
 #include "net_socket.h"
 #include "net_socket_listener.h"
 #include "net_thread.h"
 #include "net_udp_packet.h"
 #include "hi_res_time.h"
+#include "bytestream.h"
 
 #include "preferences.h"
 #include "profiler.h"
@@ -22,6 +23,7 @@
 #include "clienttoserver.h"
 #include "servertoclientletter.h"
 #include "generic.h"
+#include "globals.h"
 
 static NetCallBackRetType ListenCallback(NetUdpPacket* udpdata)
 {
@@ -41,21 +43,34 @@ static NetCallBackRetType ListenCallback(NetUdpPacket* udpdata)
   return 0;
 }
 
-static NetCallBackRetType ListenThread([[maybe_unused]] void* ignored)
+static NetCallBackRetType ListenThread(void* _context)
 {
-  g_context->m_clientToServer->m_receiveSocket = new NetSocketListener(4001);
+  g_context = static_cast<GameContext*>(_context);
+  const int serverPort = g_prefsManager->GetInt("ServerPort", SERVER_PORT);
+  g_context->m_clientToServer->m_receiveSocket = new NetSocketListener(Server::GetClientPort(serverPort));
   NetRetCode retCode = g_context->m_clientToServer->m_receiveSocket->StartListening(ListenCallback);
   DEBUG_ASSERT(retCode == NetOk);
   return 0;
 }
 
+static NetCallBackRetType SendThread(void* _context)
+{
+  g_context = static_cast<GameContext*>(_context);
+  g_context->m_clientToServer->RunSender();
+  return 0;
+}
+
 ClientToServer::ClientToServer()
+  : m_nextInputFrame(0),
+    m_nextInputFrameTime(0.0),
+    m_inputAck(-1),
+    m_positionBounds(NetworkUpdate::PositionBounds{}),
+    m_sendSignal(0),
+    m_sending(false),
+    m_senderRunning(false)
 {
   m_lastValidSequenceIdFromServer = -1;
 
-  m_inboxMutex = new NetMutex();
-  m_outboxMutex = new NetMutex();
-
   if (!g_context->m_bypassNetworking)
   {
     m_netLib = new NetLib();
@@ -67,57 +82,113 @@ ClientToServer::ClientToServer()
     char addressBuf[256];
     strncpy(addressBuf, serverAddress ? serverAddress : "", sizeof(addressBuf));
     addressBuf[sizeof(addressBuf) - 1] = '\0';
-    m_sendSocket->Connect(addressBuf, 4000);
+    m_sendSocket->Connect(addressBuf, g_prefsManager->GetInt("ServerPort", SERVER_PORT));
 
-    NetStartThread(ListenThread);
+    m_impairment = CreateNetImpairmentFromPrefs(1);
+    m_sendSocket->SetImpairment(m_impairment);
+
+    // I/O threads work for the match that started them
+    NetStartThread(ListenThread, g_context);
+
+    m_sending = true;
+    m_senderRunning = true;
+    NetStartThread(SendThread, g_context);
   }
   else
   {
     m_netLib = nullptr;
     m_sendSocket = nullptr;
+    m_impairment = nullptr;
   }
   m_receiveSocket = nullptr;
 }
 
 ClientToServer::~ClientToServer()
 {
-  //while (m_outbox.Size() > 0) {}
+  // Stop the I/O thread before tearing down the queue it drains
+  if (m_senderRunning)
+  {
+    m_sending = false;
+    m_sendSignal.release();
+    while (m_senderRunning)
+      NetSleep(1);
+  }
 
+  DrainReceiveQueue();
   m_inbox.EmptyAndDelete();
   m_bulkInbox.EmptyAndDelete();
-  m_outbox.EmptyAndDelete();
-  SAFE_DELETE(m_inboxMutex);
-  SAFE_DELETE(m_outboxMutex);
+
+  m_inputFrame.EmptyAndDelete();
+  m_unacked.EmptyAndDelete();
+
+  NetworkUpdate* update;
+  while (m_outbox.TryPop(update))
+    delete update;
+
   SAFE_DELETE(m_netLib);
   SAFE_DELETE(m_sendSocket);
   SAFE_DELETE(m_receiveSocket);
+  SAFE_DELETE(m_impairment);    // After the socket, which forgets its queued datagrams on close
 }
 
 void ClientToServer::AdvanceSender()
 {
   int bytesSentThisFrame = 0;
-  g_context->m_clientToServer->m_outboxMutex->Lock();
+  NetworkUpdate* letter;
 
-  while (g_context->m_clientToServer->m_outbox.Size())
+  if (g_context->m_bypassNetworking)
   {
-    NetworkUpdate* letter = g_context->m_clientToServer->m_outbox[0];
-    DEBUG_ASSERT(letter);
+    while (m_outbox.TryPop(letter))
+    {
+      DEBUG_ASSERT(letter);
+      g_context->m_server->ReceiveLetter(letter, GetOurIP_String());
+    }
+  }
+  else
+  {
+    while (m_outbox.TryPop(letter))
+      m_unacked.PutDataAtEnd(letter);
 
-    if (g_context->m_bypassNetworking)
-      g_context->m_server->ReceiveLetter(letter, g_context->m_clientToServer->GetOurIP_String());
-    else
+    //
+    // Forget commands the server has applied.  Nothing else is ever dropped:
+    // the server applies commands strictly in order, so one lost for good
+    // would hold back every command after it.
+
+    long long ack = m_inputAck.load(std::memory_order_acquire);
+    while (m_unacked.Size() > 0 && m_unacked[0]->GetInputKey() <= ack)
     {
-      int letterSize = 0;
-      char* byteStream = letter->GetByteStream(&letterSize);
-      NetSocket* socket = g_context->m_clientToServer->m_sendSocket;
-      socket->WriteData(byteStream, letterSize);
-      bytesSentThisFrame += letterSize;
-      delete letter;
+      delete m_unacked[0];
+      m_unacked.RemoveData(0);
     }
 
-    g_context->m_clientToServer->m_outbox.RemoveData(0);
+    //
+    // One datagram per frame carrying as many unacknowledged commands as fit,
+    // always starting at the oldest.  Each datagram then continues on from
+    // what the server has applied, whichever arrive and in whatever order, so
+    // its high-water mark never skips a command.  Commands that do not fit,
+    // as while sync reports pile up during catch-up, wait for the acks.
+
+    if (m_unacked.Size() > 0)
+    {
+      static constexpr int MAX_BATCH = 64;
+      NetworkUpdate* batch[MAX_BATCH];
+      char datagram[MAX_PACKET_SIZE];
+
+      int numInBatch = std::min(m_unacked.Size(), MAX_BATCH);
+      for (int i = 0; i < numInBatch; ++i)
+        batch[i] = m_unacked[i];
+
+      const NetworkUpdate::PositionBounds bounds = m_positionBounds.load(std::memory_order_acquire);
+      int datagramSize = 0;
+      int numPacked = NetworkUpdate::PackBatch(batch, numInBatch, bounds, datagram, sizeof(datagram), &datagramSize);
+      DEBUG_ASSERT(numPacked > 0);
+      if (numPacked > 0)
+      {
+        m_sendSocket->WriteData(datagram, datagramSize);
+        bytesSentThisFrame += datagramSize;
+      }
+    }
   }
-  g_context->m_clientToServer->m_outboxMutex->Unlock();
 
   if (bytesSentThisFrame > 0)
   {
@@ -125,7 +196,91 @@ void ClientToServer::AdvanceSender()
   }
 }
 
-void ClientToServer::Advance() { AdvanceSender(); }
+// *** RunSender
+// Body of the I/O thread: socket writes happen here so the sim thread never
+// blocks on the network.  Advance wakes it once per frame.
+void ClientToServer::RunSender()
+{
+  while (m_sending)
+  {
+    (void)m_sendSignal.try_acquire_for(std::chrono::milliseconds(100));
+    AdvanceSender();
+  }
+  m_senderRunning = false;
+}
+
+void ClientToServer::Advance()
+{
+  DrainReceiveQueue();
+
+  double timeNow = GetHighResTime();
+  if (timeNow < m_nextInputFrameTime)
+    return;
+
+  m_nextInputFrameTime += IAMALIVE_PERIOD;
+  if (timeNow > m_nextInputFrameTime)
+    m_nextInputFrameTime = timeNow + IAMALIVE_PERIOD;
+
+  // Wake the sender even for an empty frame so unacknowledged input is repeated
+  FlushInputFrame();
+  if (g_context->m_bypassNetworking)
+    AdvanceSender();
+  else
+    m_sendSignal.release();
+}
+
+// *** FlushInputFrame
+// Closes the current input frame and hands its commands to the sender.
+bool ClientToServer::FlushInputFrame()
+{
+  if (m_inputFrame.Size() == 0)
+    return false;
+
+  int frame = m_nextInputFrame++;
+  for (int i = 0; i < m_inputFrame.Size(); ++i)
+  {
+    NetworkUpdate* letter = m_inputFrame[i];
+    letter->SetInputFrame(frame, i);
+    letter->SetLastSequenceId(m_lastValidSequenceIdFromServer);
+
+    if (!m_outbox.TryPush(letter))
+    {
+      DebugTrace("CLIENT : Outbox full, dropping update\n");
+      delete letter;
+    }
+  }
+  m_inputFrame.Empty();
+
+  return true;
+}
+
+// *** CoalesceInput
+// Adds a command to the current input frame.  Only the latest Alive per team
+// and the latest aim per radar dish matter, so those replace earlier ones in
+// place: a button press sampled before a SelectUnit must still come first.
+void ClientToServer::CoalesceInput(NetworkUpdate* _letter)
+{
+  for (int i = 0; i < m_inputFrame.Size(); ++i)
+  {
+    NetworkUpdate* existing = m_inputFrame[i];
+    if (existing->m_type != _letter->m_type || existing->m_teamId != _letter->m_teamId)
+      continue;
+
+    if (_letter->m_type == NetworkUpdate::Alive)
+    {
+      // Keep any button presses from the earlier sample
+      _letter->m_teamControls.SetFlags(_letter->m_teamControls.GetFlags() | existing->m_teamControls.GetFlags());
+    }
+    else if (_letter->m_type != NetworkUpdate::AimBuilding || existing->m_buildingId != _letter->m_buildingId)
+      continue;
+
+    delete existing;
+    *m_inputFrame.GetPointer(i) = _letter;
+    return;
+  }
+
+  m_inputFrame.PutDataAtEnd(_letter);
+}
 
 int ClientToServer::GetOurIP_Int()
 {
@@ -190,35 +345,51 @@ char* ClientToServer::GetOurIP_String()
 
 int ClientToServer::GetNextLetterSeqID()
 {
-  int result = -1;
+  DrainReceiveQueue();
 
-  m_inboxMutex->Lock();
+  int result = -1;
   if (m_inbox.Size() > 0)
     result = m_inbox[0]->GetSequenceId();
-  m_inboxMutex->Unlock();
 
   return result;
 }
 
 ServerToClientLetter* ClientToServer::GetNextLetter()
 {
-  m_inboxMutex->Lock();
+  DrainReceiveQueue();
+
   ServerToClientLetter* letter = nullptr;
 
   if (m_inbox.Size() > 0)
   {
     letter = m_inbox[0];
-    if (letter->GetSequenceId() == g_lastProcessedSequenceId + 1)
+    if (letter->GetSequenceId() == g_context->m_lastProcessedSequenceId + 1)
       m_inbox.RemoveData(0);
     else
       letter = nullptr;
   }
 
-  m_inboxMutex->Unlock();
+  return letter;
+}
+
+ServerToClientLetter* ClientToServer::GetNextBulkLetter()
+{
+  DrainReceiveQueue();
+
+  ServerToClientLetter* letter = nullptr;
+
+  if (m_bulkInbox.Size() > 0)
+  {
+    letter = m_bulkInbox[0];
+    m_bulkInbox.RemoveData(0);
+  }
 
   return letter;
 }
 
+// *** ReceiveLetter
+// Called on the listener thread (or the sim thread when bypassing networking).
+// Only timing is handled here; ordering happens in DrainReceiveQueue.
 void ClientToServer::ReceiveLetter(ServerToClientLetter* letter)
 {
   //
@@ -233,93 +404,162 @@ void ClientToServer::ReceiveLetter(ServerToClientLetter* letter)
 #endif
 
   //
-  // Pheromone bulk letters bypass sequence tracking entirely — they are
-  // not simulation ticks and must not inflate the lag counter (§A.5).
+  // Work out our start time.  Pheromone bulk letters are not simulation
+  // ticks and carry no meaningful sequence id (§A.5).
 
-  if (letter->m_type == ServerToClientLetter::ChunkPheromoneUpdate ||
-      letter->m_type == ServerToClientLetter::ChunkPheromoneFullSync)
+  if (!letter->IsBulk())
   {
-    m_inboxMutex->Lock();
-    m_bulkInbox.PutDataAtEnd(letter);
-    m_inboxMutex->Unlock();
-    return;
+    double newStartTime = GetHighResTime() - static_cast<float>(letter->GetSequenceId()) * SERVER_ADVANCE_PERIOD;
+    if (newStartTime < g_context->m_startTime)
+    {
+      g_context->m_startTime = newStartTime;
+#ifdef _DEBUG
+      // DebugTrace( "Start Time set to %f\n", (float) g_context->m_startTime );
+#endif
+    }
+    //#ifdef _DEBUG
+    else if (newStartTime > g_context->m_startTime + 0.1f)
+    {
+      g_context->m_startTime = newStartTime;
+      //        DebugTrace( "Start Time set to %f\n", (float) g_context->m_startTime );
+    }
+    //#endif
   }
 
-  //
-  // Check for duplicates
-
-  if (letter->GetSequenceId() <= m_lastValidSequenceIdFromServer)
+  if (!m_receiveQueue.TryPush(letter))
   {
+    // The sim thread is badly behind; the server resends anything unacknowledged
     delete letter;
-    return;
   }
+}
 
-  //
-  // Work out our start time
-
-  double newStartTime = GetHighResTime() - static_cast<float>(letter->GetSequenceId()) * SERVER_ADVANCE_PERIOD;
-  if (newStartTime < g_startTime)
-  {
-    g_startTime = newStartTime;
-#ifdef _DEBUG
-    // DebugTrace( "Start Time set to %f\n", (float) g_startTime );
-#endif
-  }
-  //#ifdef _DEBUG
-  else if (newStartTime > g_startTime + 0.1f)
+// *** DrainReceiveQueue
+// Moves letters handed over by the listener into the sim-thread-only inboxes.
+void ClientToServer::DrainReceiveQueue()
+{
+  ServerToClientLetter* letter;
+  while (m_receiveQueue.TryPop(letter))
   {
-    g_startTime = newStartTime;
-    //        DebugTrace( "Start Time set to %f\n", (float) g_startTime );
-  }
-  //#endif
+    //
+    // Every Update letter acknowledges our input, even a duplicate one
 
-  //
-  // Do a sorted insert of the letter into the inbox
+    if (letter->m_type == ServerToClientLetter::Update)
+    {
+      long long ack = NetworkUpdate::GetInputKey(letter->m_inputAckFrame, letter->m_inputAckIndex);
+      if (ack > m_inputAck.load(std::memory_order_relaxed))
+        m_inputAck.store(ack, std::memory_order_release);
+    }
 
-  m_inboxMutex->Lock();
-  int i;
-  bool inserted = false;
-  for (i = m_inbox.Size() - 1; i >= 0; --i)
-  {
-    ServerToClientLetter* thisLetter = m_inbox[i];
-    if (letter->GetSequenceId() > thisLetter->GetSequenceId())
+    //
+    // Bulk letters bypass sequence tracking entirely — they are not
+    // simulation ticks and must not inflate the lag counter (§A.5).
+
+    if (letter->m_type == ServerToClientLetter::LocationSnapshot)
     {
-      m_inbox.PutDataAtIndex(letter, i + 1);
-      inserted = true;
-      break;
+      ReceiveSnapshotPart(letter);
+      delete letter;
+      continue;
+    }
+
+    if (letter->IsBulk())
+    {
+      m_bulkInbox.PutDataAtEnd(letter);
+      continue;
     }
-    if (letter->GetSequenceId() == thisLetter->GetSequenceId())
+
+    //
+    // Check for duplicates
+
+    if (letter->GetSequenceId() <= m_lastValidSequenceIdFromServer)
     {
-      // Throw this letter away, it's a duplicate
       delete letter;
-      inserted = true;
-      break;
+      continue;
+    }
+
+    //
+    // Do a sorted insert of the letter into the inbox
+
+    int i;
+    bool inserted = false;
+    for (i = m_inbox.Size() - 1; i >= 0; --i)
+    {
+      ServerToClientLetter* thisLetter = m_inbox[i];
+      if (letter->GetSequenceId() > thisLetter->GetSequenceId())
+      {
+        m_inbox.PutDataAtIndex(letter, i + 1);
+        inserted = true;
+        break;
+      }
+      if (letter->GetSequenceId() == thisLetter->GetSequenceId())
+      {
+        // Throw this letter away, it's a duplicate
+        delete letter;
+        inserted = true;
+        break;
+      }
+    }
+    if (!inserted)
+      m_inbox.PutDataAtStart(letter);
+
+    //
+    // Recalculate our last Known Sequence Id
+
+    for (i = 0; i < m_inbox.Size(); ++i)
+    {
+      ServerToClientLetter* thisLetter = m_inbox[i];
+      if (thisLetter->GetSequenceId() > m_lastValidSequenceIdFromServer + 1)
+        break;
+      m_lastValidSequenceIdFromServer = thisLetter->GetSequenceId();
     }
   }
-  if (!inserted)
-    m_inbox.PutDataAtStart(letter);
+}
 
-  //
-  // Recalculate our last Known Sequence Id
+// *** ReceiveSnapshotPart
+void ClientToServer::ReceiveSnapshotPart(ServerToClientLetter* _letter)
+{
+  static constexpr int HEADER_SIZE = static_cast<int>(sizeof(int) * 3);
+  if (!_letter->m_bulkData || _letter->m_bulkDataSize < HEADER_SIZE)
+    return;
 
-  for (i = 0; i < m_inbox.Size(); ++i)
+  char* ptr = _letter->m_bulkData;
+  int snapshotId = READ_INT(ptr);
+  int part = READ_INT(ptr);
+  int numParts = READ_INT(ptr);
+
+  // Resent parts of a snapshot we have already loaded
+  if (snapshotId <= m_lastValidSequenceIdFromServer)
+    return;
+
+  if (m_snapshot.AddPart(snapshotId, part, numParts, ptr, _letter->m_bulkDataSize - HEADER_SIZE))
+    DebugTrace("CLIENT : Received {} byte snapshot at sequence {}\n", m_snapshot.Size(), snapshotId);
+}
+
+// *** ResetSequence
+// Continues the letter stream from a snapshot: letters up to and including
+// _sequenceId are already accounted for by it.
+void ClientToServer::ResetSequence(int _sequenceId)
+{
+  m_snapshot.Reset();
+  m_lastValidSequenceIdFromServer = _sequenceId;
+
+  while (m_inbox.Size() > 0 && m_inbox[0]->GetSequenceId() <= _sequenceId)
   {
-    ServerToClientLetter* thisLetter = m_inbox[i];
-    if (thisLetter->GetSequenceId() > m_lastValidSequenceIdFromServer + 1)
-      break;
-    m_lastValidSequenceIdFromServer = thisLetter->GetSequenceId();
+    delete m_inbox[0];
+    m_inbox.RemoveData(0);
   }
 
-  m_inboxMutex->Unlock();
+  for (int i = 0; i < m_inbox.Size(); ++i)
+  {
+    if (m_inbox[i]->GetSequenceId() > m_lastValidSequenceIdFromServer + 1)
+      break;
+    m_lastValidSequenceIdFromServer = m_inbox[i]->GetSequenceId();
+  }
 }
 
 void ClientToServer::SendLetter(NetworkUpdate* letter)
 {
   letter->SetLastSequenceId(m_lastValidSequenceIdFromServer);
-
-  m_outboxMutex->Lock();
-  m_outbox.PutDataAtEnd(letter);
-  m_outboxMutex->Unlock();
+  CoalesceInput(letter);
 }
 
 void ClientToServer::ClientJoin()
@@ -337,8 +577,17 @@ void ClientToServer::ClientLeave()
   letter->SetType(NetworkUpdate::ClientLeave);
   SendLetter(letter);
 
+  // Don't wait for the frame timer; we are about to stop advancing
+  if (FlushInputFrame())
+  {
+    if (g_context->m_bypassNetworking)
+      AdvanceSender();
+    else
+      m_sendSignal.release();
+  }
+
   m_lastValidSequenceIdFromServer = -1;
-  g_lastProcessedSequenceId = -1;
+  g_context->m_lastProcessedSequenceId = -1;
 }
 
 void ClientToServer::RequestTeam(int _teamType, int _desiredId)
@@ -362,12 +611,12 @@ void ClientToServer::SendIAmAlive(unsigned char _teamId, const TeamControls& _te
   SendLetter(letter);
 }
 
-void ClientToServer::SendSyncronisation(int _lastProcessedId, unsigned char _sync)
+void ClientToServer::SendSyncronisation(int _lastProcessedId, const SyncReport& _report)
 {
   auto letter = new NetworkUpdate();
   letter->SetType(NetworkUpdate::Syncronise);
   letter->SetLastProcessedId(_lastProcessedId);
-  letter->SetSync(_sync);
+  letter->SetSyncReport(_report);
   SendLetter(letter);
 }
 
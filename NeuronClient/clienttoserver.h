@@ -2,35 +2,59 @@
 
 #include "llist.h"
 #include "LegacyVector3.h"
+#include "RingQueue.h"
+#include "SnapshotStream.h"
 
 #include "worldobject.h"
 #include "entity.h"
+#include "networkupdate.h"
+
+
+#define CLIENT_RECEIVE_QUEUE_SIZE   4096            // Letters from the listener awaiting the sim thread
+#define CLIENT_OUTBOX_SIZE          1024            // NetworkUpdates awaiting the I/O thread
 
 
 class NetLib;
+class NetImpairment;
 class NetSocket;
-class NetMutex;
 class NetSocketListener;
 class ServerToClientLetter;
-class NetworkUpdate;
+struct SyncReport;
 
 
 class ClientToServer
 {
 private:
 	NetLib				*m_netLib;
+    NetImpairment       *m_impairment;              // Simulated network conditions on sends; nullptr normally
 
 	void AdvanceSender	();
+    void DrainReceiveQueue ();
+    bool FlushInputFrame   ();                      // Returns false if the frame was empty
+    void CoalesceInput     ( NetworkUpdate *_letter );
+    void ReceiveSnapshotPart ( ServerToClientLetter *_letter );
+
+    LList<NetworkUpdate *> m_inputFrame;            // Commands for the frame being built; sim thread only
+    int                 m_nextInputFrame;
+    double              m_nextInputFrameTime;
+    std::atomic<long long> m_inputAck;              // Last command the server applied (NetworkUpdate::GetInputKey)
+    LList<NetworkUpdate *> m_unacked;               // Unacknowledged commands, oldest first; I/O thread only
+    std::atomic<NetworkUpdate::PositionBounds> m_positionBounds;   // Of the world being played; set by the sim thread
+
+    std::counting_semaphore<> m_sendSignal;         // Released once per frame to wake the I/O thread
+    std::atomic<bool>   m_sending;
+    std::atomic<bool>   m_senderRunning;
+
+    SnapshotAssembler   m_snapshot;                 // Late join: parts of the Location snapshot; sim thread only
 
 public:
     NetSocket           *m_sendSocket;
     NetSocketListener   *m_receiveSocket;
 
-    NetMutex            *m_inboxMutex;
-    NetMutex            *m_outboxMutex;
-    LList               <ServerToClientLetter *> m_inbox;
-    LList               <NetworkUpdate *> m_outbox;
-    LList               <ServerToClientLetter *> m_bulkInbox;  // pheromone letters (no sequence tracking)
+    SpscRingQueue       <ServerToClientLetter *, CLIENT_RECEIVE_QUEUE_SIZE> m_receiveQueue;  // Listener thread -> sim thread, unsorted
+    SpscRingQueue       <NetworkUpdate *, CLIENT_OUTBOX_SIZE> m_outbox;                      // Sim thread -> I/O thread
+    LList               <ServerToClientLetter *> m_inbox;      // Sorted by sequence id; sim thread only
+    LList               <ServerToClientLetter *> m_bulkInbox;  // pheromone letters (no sequence tracking); sim thread only
 
     int                 m_lastValidSequenceIdFromServer;    // eg if we have 11,12,13,15,18 then this is 13
 
@@ -42,9 +66,21 @@ public:
     char *GetOurIP_String		();
 
     ServerToClientLetter    *GetNextLetter();
+    ServerToClientLetter    *GetNextBulkLetter();
     int                      GetNextLetterSeqID();
 
+    // Late join.  Once the snapshot is complete the caller loads it, then calls
+    // ResetSequence with its sequence id so letters resume from the one after.
+    bool                     IsSnapshotComplete() const { return m_snapshot.IsComplete(); }
+    const SnapshotAssembler &GetSnapshot() const { return m_snapshot; }
+    void                     ResetSequence( int _sequenceId );
+    void                     DiscardSnapshot() { m_snapshot.Reset(); }
+
+    // Positions in commands are quantised against these once a world is loaded
+    void SetPositionBounds( NetworkUpdate::PositionBounds const &_bounds ) { m_positionBounds.store( _bounds, std::memory_order_release ); }
+
 	void Advance				();
+    void RunSender              ();
 
     void ReceiveLetter          ( ServerToClientLetter *letter );
     void SendLetter             ( NetworkUpdate *letter );
@@ -62,7 +98,7 @@ public:
     void RequestRunProgram      ( unsigned char _teamId, unsigned char _program );
     void RequestTargetProgram   ( unsigned char _teamId, unsigned char _program, LegacyVector3 const &_pos );
 
-    void SendSyncronisation     ( int _lastProcessedId, unsigned char _sync );
+    void SendSyncronisation     ( int _lastProcessedId, SyncReport const &_report );
     void SendIAmAlive           ( unsigned char _teamId, TeamControls const &_teamControls );
 };
 
@@ -48,6 +48,10 @@ public:
 
     inline int NumUsed() const;								// FAST Returns the number of used entries
 
+    int  FreeListHead	() const { return firstfree; }		// Free slots in the order PutData will use them,
+    int  FreeListNext	( int index ) const { return freelist[index]; }	// -1 terminated
+    void SetFreeList	( const int *order, int count );	// FAST Every unused slot, in the order to reuse them
+
     void Empty();											// FAST Resets the array to empty
     void EmptyAndDelete();                                  // FAST
 };
@@ -361,6 +365,21 @@ int FastDArray<T>::GetNextFree()
 }
 
 
+template <class T>
+void FastDArray <T>::SetFreeList(const int* order, int count)
+{
+	DEBUG_ASSERT(count == this->m_arraySize - numused);
+
+	firstfree = -1;
+	for (int i = count - 1; i >= 0; --i)
+	{
+		DEBUG_ASSERT(this->shadow[order[i]] == 0);
+		freelist[order[i]] = firstfree;
+		firstfree = order[i];
+	}
+}
+
+
 template <class T>
 int FastDArray <T>::NumUsed() const
 {
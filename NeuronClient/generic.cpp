@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "generic.h"
+#include "net_impairment.h"
+#include "preferences.h"
 
 
 void IpToString(struct in_addr in, char *newip)
@@ -9,3 +11,23 @@ void IpToString(struct in_addr in, char *newip)
                                         in.S_un.S_un_b.s_b3,
                                         in.S_un.S_un_b.s_b4 );
 }
+
+
+NetImpairment* CreateNetImpairmentFromPrefs(int _stream)
+{
+  NetImpairmentConfig config;
+  config.m_lossPercent = g_prefsManager->GetFloat("NetSimLoss", 0.0f);
+  config.m_duplicatePercent = g_prefsManager->GetFloat("NetSimDuplicate", 0.0f);
+  config.m_reorderPercent = g_prefsManager->GetFloat("NetSimReorder", 0.0f);
+  config.m_latencyMs = g_prefsManager->GetInt("NetSimLatency", 0);
+  config.m_jitterMs = g_prefsManager->GetInt("NetSimJitter", 0);
+  config.m_reorderMs = g_prefsManager->GetInt("NetSimReorderDelay", config.m_reorderMs);
+  config.m_seed = static_cast<unsigned int>(g_prefsManager->GetInt("NetSimSeed", 1) + _stream);
+
+  if (!config.IsImpaired())
+    return nullptr;
+
+  DebugTrace("NETSIM: stream {} loss {}% duplicate {}% reorder {}% latency {}+{}ms\n", _stream, config.m_lossPercent,
+             config.m_duplicatePercent, config.m_reorderPercent, config.m_latencyMs, config.m_jitterMs);
+  return new NetImpairment(config);
+}
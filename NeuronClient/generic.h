@@ -2,3 +2,9 @@
 
 void IpToString(struct in_addr in, char *newip);
 
+// An impairment simulator configured by the NetSim preferences, or nullptr if
+// none are set.  Each stream of datagrams (server, client, bots) passes its
+// own _stream so they do not share random decisions.
+class NetImpairment;
+NetImpairment *CreateNetImpairmentFromPrefs(int _stream);
+
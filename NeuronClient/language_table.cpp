@@ -56,9 +56,7 @@ LangTable::LangTable(const char *_filename)
 
 LangTable::~LangTable()
 {
-    DArray<LangPhrase *> *phrasesRaw = m_phrasesRaw.ConvertToDArray();
-    phrasesRaw->EmptyAndDelete();
-	delete phrasesRaw;
+    m_phrasesRaw.ClearAndDelete();
 	delete m_phrasesKbd;
 	delete m_phrasesXin;
 	/*
@@ -91,9 +89,10 @@ void LangTable::ParseLanguageFile(char const *_filename)
 		phrase->m_key = _strdup(key);
 
 		// Make sure the this key isn't already used
-		if(m_phrasesRaw.LookupTree(key))
+		if(LangPhrase **existing = m_phrasesRaw.Find(key))
         {
-            m_phrasesRaw.RemoveData( key );
+            delete *existing;
+            m_phrasesRaw.Erase( key );
         }
 
 		char *aString = in->GetRestOfLine();
@@ -123,7 +122,7 @@ void LangTable::ParseLanguageFile(char const *_filename)
             phrase->m_string[stringLength-2] = '\x0';
         }
 
-		m_phrasesRaw.PutData(phrase->m_key, phrase);
+		m_phrasesRaw.TryEmplace(phrase->m_key, phrase);
 	}
 
 	delete in;
@@ -189,15 +188,13 @@ bool buildCaption(char const *_baseString, char *_dest, InputMode _mood); // see
 
 
 // Only used for debugging
-bool printTable( HashTable<int> const *keys, const char *table, std::ostream &out )
+bool printTable( Neuron::StringMap<int> const *keys, const char *table, std::ostream &out )
 {
 	if ( keys && table && out.good() ) {
-		for ( unsigned int i = 0; i < keys->Size(); ++i ) {
-			if ( keys->ValidIndex( i ) ) {
-				out << keys->GetName( i ) << '\t'
-				    << ( table + keys->GetData( i ) ) << std::endl;
-			}
-		}
+		keys->ForEach( [&]( std::string_view _key, int _offset ) {
+			out << _key << '\t'
+			    << ( table + _offset ) << std::endl;
+		} );
 		return true;
 	}
 	return false;
@@ -211,8 +208,8 @@ void LangTable::RebuildTables()
 	delete m_phrasesKbd;
 	delete m_phrasesXin;
 
-	m_phrasesKbd = new HashTable<int>();
-	m_phrasesXin = new HashTable<int>();
+	m_phrasesKbd = new Neuron::StringMap<int>();
+	m_phrasesXin = new Neuron::StringMap<int>();
 
 	RebuildTable( m_phrasesKbd, stream, INPUT_MODE_KEYBOARD );
 	RebuildTable( m_phrasesXin, stream, INPUT_MODE_GAMEPAD );
@@ -236,52 +233,46 @@ void LangTable::RebuildTables()
 	}
 }
 
-void LangTable::RebuildTable( HashTable<int> *_phrases, std::ostringstream &stream, InputMode _mood )
+void LangTable::RebuildTable( Neuron::StringMap<int> *_phrases, std::ostringstream &stream, InputMode _mood )
 {
 	char theString[1024];
 
-	DArray<LangPhrase*> *ary = m_phrasesRaw.ConvertToDArray();
-
 	stream << '\x0'; // This is our empty string
 
-	// DebugTrace(" There are %d keys to add\n", ary->Size() );
-
-	for ( int i = 0; i < ary->Size(); ++i ) {
-		if ( ary->ValidIndex( i ) ) {
-			LangPhrase const *phrase = ary->GetData( i );
-			if ( strncmp( phrase->m_key, "part_", 5 ) != 0 ) {
-				char key[1024];
-				strncpy( key, phrase->m_key, sizeof(key) );
-				key[sizeof(key) - 1] = '\0';
-
-				if ( !wrong_suffix( phrase->m_key, _mood ) ) {
-					// Make sure this is the most specific string, or ignore it
-					if ( chomp_mode_suffix( key ) || !specific_key_exists( key, _mood ) ) {
-						int currPos = stream.tellp();
-						buildCaption( phrase->m_string, theString, _mood );
-						stream << theString << '\x0';
-
-						// DebugTrace("%d Adding key %d: %s -> %s\n", _mood, i, key, theString );
-						_phrases->PutData( key, currPos );
-					}
-				} else {
-					// Make sure this is the most specific string, or ignore it
-					if ( chomp_mode_suffix( key ) && !RawDoesPhraseExist( key, _mood ) &&
-					     !specific_key_exists( key, _mood ) ) {
-
-						// DebugTrace("%d Adding key %d: %s -> 0\n", _mood, i, key );
-						_phrases->PutData( key, 0 ); // Give me an empty string
-					}
+	// DebugTrace(" There are %d keys to add\n", m_phrasesRaw.Count() );
+
+	// In key order, so that the string chunk comes out the same every time
+	m_phrasesRaw.ForEachSorted( [&]( std::string_view, LangPhrase const *phrase ) {
+		if ( strncmp( phrase->m_key, "part_", 5 ) != 0 ) {
+			char key[1024];
+			strncpy( key, phrase->m_key, sizeof(key) );
+			key[sizeof(key) - 1] = '\0';
+
+			if ( !wrong_suffix( phrase->m_key, _mood ) ) {
+				// Make sure this is the most specific string, or ignore it
+				if ( chomp_mode_suffix( key ) || !specific_key_exists( key, _mood ) ) {
+					int currPos = stream.tellp();
+					buildCaption( phrase->m_string, theString, _mood );
+					stream << theString << '\x0';
+
+					// DebugTrace("%d Adding key: %s -> %s\n", _mood, key, theString );
+					_phrases->TryEmplace( key, currPos );
+				}
+			} else {
+				// Make sure this is the most specific string, or ignore it
+				if ( chomp_mode_suffix( key ) && !RawDoesPhraseExist( key, _mood ) &&
+				     !specific_key_exists( key, _mood ) ) {
+
+					// DebugTrace("%d Adding key: %s -> 0\n", _mood, key );
+					_phrases->TryEmplace( key, 0 ); // Give me an empty string
 				}
 			}
 		}
-	}
-
-	delete ary;
+	} );
 }
 
 
-HashTable<int> *LangTable::GetCurrentTable()
+Neuron::StringMap<int> *LangTable::GetCurrentTable()
 {
 	if ( g_inputManager )
 		return GetCurrentTable( g_inputManager->getInputMode() );
@@ -289,7 +280,7 @@ HashTable<int> *LangTable::GetCurrentTable()
 }
 
 
-HashTable<int> *LangTable::GetCurrentTable( InputMode _mood )
+Neuron::StringMap<int> *LangTable::GetCurrentTable( InputMode _mood )
 {
 	if ( !m_phrasesKbd || !m_phrasesXin )
 		RebuildTables();
@@ -307,15 +298,14 @@ HashTable<int> *LangTable::GetCurrentTable( InputMode _mood )
 
 bool LangTable::DoesPhraseExist(char const *_key)
 {
-	HashTable<int> *phrases = GetCurrentTable();
+	Neuron::StringMap<int> *phrases = GetCurrentTable();
     if( !_key || !phrases )
     {
         return false;
     }
     else
     {
-        int phrase = phrases->GetData( _key, -1 );
-        return( phrase != -1 );
+        return phrases->Contains( _key );
     }
 }
 
@@ -350,15 +340,14 @@ bool LangTable::RawDoesPhraseExist(char const *_key)
     }
     else
     {
-        LangPhrase const *phrase = m_phrasesRaw.GetData( _key );
-        return( phrase != NULL );
+        return m_phrasesRaw.Contains( _key );
     }
 }
 
 
 char *LangTable::LookupPhrase(char const *_key)
 {
-	HashTable<int> *phrases = GetCurrentTable();
+	Neuron::StringMap<int> *phrases = GetCurrentTable();
     char *phrase = NULL;
 
     if( !_key || !phrases || !m_chunk )
@@ -367,7 +356,7 @@ char *LangTable::LookupPhrase(char const *_key)
     }
     else
     {
-		int offset = phrases->GetData( _key );
+		int offset = phrases->Get( _key );
 		if ( offset >= 0 )
 		    phrase = m_chunk + offset;
 
@@ -416,13 +405,13 @@ char *LangTable::RawLookupPhrase(char const *_key, InputMode _mood)
 				case INPUT_MODE_KEYBOARD: memcpy( key + len, "_kbd", 5 ); break;
 				case INPUT_MODE_GAMEPAD: memcpy( key + len, "_xin", 5 ); break;
 			}
-			phrase = m_phrasesRaw.GetData( key );
+			phrase = m_phrasesRaw.Get( key );
 			delete [] key;
 		}
 
 		if ( !phrase )
 		{
-			phrase = m_phrasesRaw.GetData( _key );
+			phrase = m_phrasesRaw.Get( _key );
 		}
 
 	    if ( !phrase )
@@ -454,51 +443,33 @@ void LangTable::TestAgainstEnglish()
     //
     // Look for strings in English that are not in this language
 
-    DArray<LangPhrase *> *englishPhrases = english->m_phrasesRaw.ConvertToDArray();
-
-    for( int i = 0; i < englishPhrases->Size(); ++i )
+    english->m_phrasesRaw.ForEachSorted( [&]( std::string_view, LangPhrase const *phrase )
     {
-        if( englishPhrases->ValidIndex(i) )
+        if( !DoesPhraseExist( phrase->m_key ) )
         {
-            LangPhrase *phrase = englishPhrases->GetData(i);
-
-            if( !DoesPhraseExist( phrase->m_key ) )
-            {
-                fprintf( output, "ERROR : Failed to find translation for string ID '%s'\n", phrase->m_key );
-            }
-            else
+            fprintf( output, "ERROR : Failed to find translation for string ID '%s'\n", phrase->m_key );
+        }
+        else
+        {
+            char const *translatedPhrase = LookupPhrase( phrase->m_key );
+            if( strcmp( phrase->m_string, translatedPhrase ) == 0 )
             {
-                char const *translatedPhrase = LookupPhrase( phrase->m_key );
-                if( strcmp( phrase->m_string, translatedPhrase ) == 0 )
-                {
-                    fprintf( output, "ERROR : String ID appears not to be translated : '%s'\n", phrase->m_key );
-                }
+                fprintf( output, "ERROR : String ID appears not to be translated : '%s'\n", phrase->m_key );
             }
         }
-    }
-
-    delete englishPhrases;
+    } );
 
 
     //
     // Look for phrases in this language that are not in English
 
-    DArray<LangPhrase *> *langPhrases = m_phrasesRaw.ConvertToDArray();
-
-    for( int i = 0; i < langPhrases->Size(); ++i )
+    m_phrasesRaw.ForEachSorted( [&]( std::string_view, LangPhrase const *phrase )
     {
-        if( langPhrases->ValidIndex(i) )
+        if( !english->DoesPhraseExist( phrase->m_key ) )
         {
-            LangPhrase *phrase = langPhrases->GetData(i);
-
-            if( !english->DoesPhraseExist( phrase->m_key ) )
-            {
-                fprintf( output, "ERROR : Found new string ID not present in original English : '%s'\n", phrase->m_key );
-            }
+            fprintf( output, "ERROR : Found new string ID not present in original English : '%s'\n", phrase->m_key );
         }
-    }
-
-	delete langPhrases;
+    } );
 
 
     //
@@ -511,7 +482,10 @@ void LangTable::TestAgainstEnglish()
 
 DArray<LangPhrase *> *LangTable::GetPhraseList()
 {
-    DArray<LangPhrase *> *englishPhrases = m_phrasesRaw.ConvertToDArray();
+    // Sorted by key, deliberately.  BTree::ConvertToDArray gave them root
+    // first, then the left and right subtrees, which is not key order.
+    DArray<LangPhrase *> *englishPhrases = new DArray<LangPhrase *>;
+    m_phrasesRaw.ForEachSorted( [&]( std::string_view, LangPhrase *phrase ) { englishPhrases->PutData( phrase ); } );
     return englishPhrases;
 }
 
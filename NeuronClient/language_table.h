@@ -2,8 +2,8 @@
 
 #include "input_types.h"
 #include "llist.h"
-#include "btree.h"
-#include "hash_table.h"
+#include "darray.h"
+#include "StringMap.h"
 
 class LangPhrase
 {
@@ -18,17 +18,17 @@ class LangPhrase
 class LangTable
 {
   LangPhrase m_notFound;
-  BTree<LangPhrase*> m_phrasesRaw;
-  HashTable<int>* m_phrasesKbd;
-  HashTable<int>* m_phrasesXin;
+  Neuron::StringMap<LangPhrase*> m_phrasesRaw;
+  Neuron::StringMap<int>* m_phrasesKbd;
+  Neuron::StringMap<int>* m_phrasesXin;
   char* m_chunk;
 
   bool specific_key_exists(const char* _key, InputMode _mood);
   bool RawDoesPhraseExist(const char* _key);
-  HashTable<int>* GetCurrentTable();
-  HashTable<int>* GetCurrentTable(InputMode _mood);
+  Neuron::StringMap<int>* GetCurrentTable();
+  Neuron::StringMap<int>* GetCurrentTable(InputMode _mood);
 
-  void RebuildTable(HashTable<int>* _phrases, std::ostringstream& stream, InputMode _mood);
+  void RebuildTable(Neuron::StringMap<int>* _phrases, std::ostringstream& stream, InputMode _mood);
 
   public:
     LangTable(const char* _filename);
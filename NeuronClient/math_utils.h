@@ -7,6 +7,12 @@ class Vector2;
 class Matrix34;
 class Plane;
 
+namespace Neuron
+{
+  class SnapshotWriter;
+  class SnapshotReader;
+}
+
 inline float frand(float range = 1.0f) { return range * (static_cast<float>(darwiniaRandom()) / static_cast<float>(DARWINIA_RAND_MAX)); }
 
 inline float sfrand(float range = 1.0f)
@@ -18,6 +24,9 @@ inline float sfrand(float range = 1.0f)
 unsigned long syncrand();
 inline float syncfrand(float range = 1.0f) { return syncrand() * (range / 4294967296.0f); }
 inline float syncsfrand(float range = 1.0f) { return (syncfrand() - 0.5f) * range; }
+uint64_t GetSyncRandDigest();
+void WriteSyncRandState(Neuron::SnapshotWriter& _writer); // Late-join snapshots carry the generator's exact position
+void ReadSyncRandState(Neuron::SnapshotReader& _reader);
 
 #ifndef M_PI
 #define M_PI 3.1415926535897932384626f
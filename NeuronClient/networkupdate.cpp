@@ -4,6 +4,7 @@
 
 
 
+#include "BitStream.h"
 #include "bytestream.h"
 #include "networkupdate.h"
 
@@ -17,7 +18,8 @@ NetworkUpdate::NetworkUpdate()
     m_numTroops(0),
     m_unitId(0),
     m_buildingId(-1),
-    m_sync(0)
+    m_inputFrame(-1),
+    m_inputIndex(0)
 {
 }
 
@@ -54,12 +56,14 @@ int NetworkUpdate::ReadByteStream(char *_byteStream)
 				unsigned char flags = READ_UNSIGNED_SHORT(_byteStream);
 				m_teamControls.SetFlags( flags );
 			}
-            m_sync = READ_UNSIGNED_CHAR(_byteStream);
             break;
 
         case Syncronise:
             m_lastProcessedSeqId = READ_INT(_byteStream);
-            m_sync = READ_UNSIGNED_CHAR(_byteStream);
+            for (int i = 0; i < NumSyncSubsystems; ++i)
+            {
+                m_syncReport.m_checksums[i] = READ_UNSIGNED_INT64(_byteStream);
+            }
             break;
 
         case SelectUnit:
@@ -174,6 +178,12 @@ void NetworkUpdate::SetLastSequenceId( int _lastSequenceId )
     m_lastSequenceId = _lastSequenceId;
 }
 
+void NetworkUpdate::SetInputFrame( int _frame, int _index )
+{
+    m_inputFrame = _frame;
+    m_inputIndex = _index;
+}
+
 void NetworkUpdate::SetUnitId( int _unitId )
 {
     m_unitId = _unitId;
@@ -214,9 +224,9 @@ void NetworkUpdate::SetLastProcessedId( int _lastProcessedId )
     m_lastProcessedSeqId = _lastProcessedId;
 }
 
-void NetworkUpdate::SetSync( unsigned char _sync )
+void NetworkUpdate::SetSyncReport( SyncReport const &_report )
 {
-    m_sync = _sync;
+    m_syncReport = _report;
 }
 
 char *NetworkUpdate::GetByteStream(int *_linearSize)
@@ -244,12 +254,14 @@ char *NetworkUpdate::GetByteStream(int *_linearSize)
             WRITE_FLOAT( byteStream, GetWorldPos().y );
             WRITE_FLOAT( byteStream, GetWorldPos().z );
 			WRITE_UNSIGNED_SHORT( byteStream, m_teamControls.GetFlags() );
-            WRITE_UNSIGNED_CHAR( byteStream, m_sync );
             break;
 
         case Syncronise:
             WRITE_INT(byteStream, m_lastProcessedSeqId );
-            WRITE_UNSIGNED_CHAR(byteStream, m_sync );
+            for (int i = 0; i < NumSyncSubsystems; ++i)
+            {
+                WRITE_UNSIGNED_INT64(byteStream, m_syncReport.m_checksums[i] );
+            }
             break;
 
         case SelectUnit:
@@ -306,6 +318,315 @@ char *NetworkUpdate::GetByteStream(int *_linearSize)
 }
 
 
+// *** PackPosition
+// Positions inside the world are quantised to NETWORKUPDATE_POSITIONBITS per
+// horizontal axis.  Anything outside (or with no bounds) is sent raw.
+void NetworkUpdate::PackPosition( BitWriter &_writer, PositionBounds const &_bounds ) const
+{
+    LegacyVector3 const &pos = GetWorldPos();
+    bool quantise = _bounds.IsValid() &&
+                    pos.x >= 0.0f && pos.x <= _bounds.m_sizeX &&
+                    pos.z >= 0.0f && pos.z <= _bounds.m_sizeZ &&
+                    fabsf(pos.y) * NETWORKUPDATE_HEIGHTSCALE < 1e6f;
+
+    _writer.WriteBool( quantise );
+    if( quantise )
+    {
+        _writer.WriteQuantised( pos.x, 0.0f, _bounds.m_sizeX, NETWORKUPDATE_POSITIONBITS );
+        _writer.WriteVarInt( static_cast<int>( floorf(pos.y * NETWORKUPDATE_HEIGHTSCALE + 0.5f) ) );
+        _writer.WriteQuantised( pos.z, 0.0f, _bounds.m_sizeZ, NETWORKUPDATE_POSITIONBITS );
+    }
+    else
+    {
+        _writer.WriteFloat( pos.x );
+        _writer.WriteFloat( pos.y );
+        _writer.WriteFloat( pos.z );
+    }
+}
+
+
+// Returns false for a quantised position in a batch that carried no bounds
+bool NetworkUpdate::UnpackPosition( BitReader &_reader, PositionBounds const &_bounds )
+{
+    LegacyVector3 &pos = GetWorldPos();
+    if( _reader.ReadBool() )
+    {
+        if( !_bounds.IsValid() ) return false;
+        pos.x = _reader.ReadQuantised( 0.0f, _bounds.m_sizeX, NETWORKUPDATE_POSITIONBITS );
+        pos.y = static_cast<float>( _reader.ReadVarInt() ) / NETWORKUPDATE_HEIGHTSCALE;
+        pos.z = _reader.ReadQuantised( 0.0f, _bounds.m_sizeZ, NETWORKUPDATE_POSITIONBITS );
+    }
+    else
+    {
+        pos.x = _reader.ReadFloat();
+        pos.y = _reader.ReadFloat();
+        pos.z = _reader.ReadFloat();
+    }
+    return true;
+}
+
+
+// *** PackBits
+// Field order mirrors GetByteStream.  m_lastSequenceId is carried once per
+// batch rather than per update (see PackBatch).
+void NetworkUpdate::PackBits( BitWriter &_writer, PositionBounds const &_bounds ) const
+{
+    _writer.WriteBits( m_type, 4 );
+
+    switch( m_type )
+    {
+        case ClientJoin:
+        case ClientLeave:
+            break;
+
+        case RequestTeam:
+            _writer.WriteBits( m_teamType, 8 );
+            _writer.WriteBits( m_entityType, 8 );
+            _writer.WriteVarInt( m_desiredTeamId );
+            break;
+
+        case Alive:
+            _writer.WriteBits( m_teamId, 8 );
+            PackPosition( _writer, _bounds );
+            _writer.WriteBits( m_teamControls.GetFlags(), NETWORKUPDATE_TEAMCONTROLFLAGS );
+            break;
+
+        case Syncronise:
+            _writer.WriteVarUInt( static_cast<unsigned int>(m_lastProcessedSeqId + 1) );
+            for (int i = 0; i < NumSyncSubsystems; ++i)
+            {
+                _writer.WriteUInt64( m_syncReport.m_checksums[i] );
+            }
+            break;
+
+        case SelectUnit:
+            _writer.WriteBits( m_teamId, 8 );
+            _writer.WriteVarInt( m_unitId );
+            _writer.WriteVarInt( m_entityId );
+            _writer.WriteVarInt( m_buildingId );
+            break;
+
+        case CreateUnit:
+            _writer.WriteBits( m_teamId, 8 );
+            _writer.WriteBits( m_entityType, 8 );
+            _writer.WriteVarInt( m_numTroops );
+            _writer.WriteVarInt( m_buildingId );
+            PackPosition( _writer, _bounds );
+            break;
+
+        case AimBuilding:
+            _writer.WriteBits( m_teamId, 8 );
+            _writer.WriteVarInt( m_buildingId );
+            PackPosition( _writer, _bounds );
+            break;
+
+        case ToggleLaserFence:
+            _writer.WriteVarInt( m_buildingId );
+            break;
+
+        case RunProgram:
+            _writer.WriteBits( m_teamId, 8 );
+            _writer.WriteBits( m_program, 8 );
+            break;
+
+        case TargetProgram:
+            _writer.WriteBits( m_teamId, 8 );
+            _writer.WriteBits( m_program, 8 );
+            PackPosition( _writer, _bounds );
+            break;
+
+        case Invalid:
+            DEBUG_ASSERT(false);
+    }
+}
+
+
+bool NetworkUpdate::UnpackBits( BitReader &_reader, PositionBounds const &_bounds )
+{
+    m_type = (UpdateType) _reader.ReadBits( 4 );
+
+    switch( m_type )
+    {
+        case ClientJoin:
+        case ClientLeave:
+            break;
+
+        case RequestTeam:
+            m_teamType = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_entityType = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_desiredTeamId = static_cast<signed char>( _reader.ReadVarInt() );
+            break;
+
+        case Alive:
+            m_teamId = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            if( !UnpackPosition( _reader, _bounds ) ) return false;
+            m_teamControls.SetFlags( static_cast<unsigned short>( _reader.ReadBits( NETWORKUPDATE_TEAMCONTROLFLAGS ) ) );
+            break;
+
+        case Syncronise:
+            m_lastProcessedSeqId = static_cast<int>( _reader.ReadVarUInt() ) - 1;
+            for (int i = 0; i < NumSyncSubsystems; ++i)
+            {
+                m_syncReport.m_checksums[i] = _reader.ReadUInt64();
+            }
+            break;
+
+        case SelectUnit:
+            m_teamId = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_unitId = _reader.ReadVarInt();
+            m_entityId = _reader.ReadVarInt();
+            m_buildingId = _reader.ReadVarInt();
+            break;
+
+        case CreateUnit:
+            m_teamId = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_entityType = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_numTroops = _reader.ReadVarInt();
+            m_buildingId = _reader.ReadVarInt();
+            if( !UnpackPosition( _reader, _bounds ) ) return false;
+            break;
+
+        case AimBuilding:
+            m_teamId = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_buildingId = _reader.ReadVarInt();
+            if( !UnpackPosition( _reader, _bounds ) ) return false;
+            break;
+
+        case ToggleLaserFence:
+            m_buildingId = _reader.ReadVarInt();
+            break;
+
+        case RunProgram:
+            m_teamId = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_program = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            break;
+
+        case TargetProgram:
+            m_teamId = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            m_program = static_cast<unsigned char>( _reader.ReadBits( 8 ) );
+            if( !UnpackPosition( _reader, _bounds ) ) return false;
+            break;
+
+        default:
+            return false;
+    }
+
+    return !_reader.Overflowed();
+}
+
+
+// *** PackBatch
+// Datagram layout:
+//   [8 bits version][1 bit bounds][float sizeX][float sizeZ][varuint lastSequenceId + 1]
+// where the two sizes are present only if the bounds bit is set.
+//   { [1 bit more=1][1 bit frame start][update] }*  [1 bit more=0]
+// A frame start is followed by [varuint inputFrame + 1][varuint inputIndex];
+// otherwise the update continues the previous one's frame at the next index.
+int NetworkUpdate::PackBatch( NetworkUpdate * const *_updates, int _numUpdates, PositionBounds const &_bounds,
+                              char *_buffer, int _bufferSize, int *_linearSize )
+{
+    BitWriter writer( _buffer, _bufferSize );
+
+    // Every update in the batch was queued after the previous datagram went
+    // out, so the most recent acknowledgement covers all of them
+    int lastSequenceId = -1;
+    for (int i = 0; i < _numUpdates; ++i)
+    {
+        if( _updates[i]->m_lastSequenceId > lastSequenceId ) lastSequenceId = _updates[i]->m_lastSequenceId;
+    }
+
+    writer.WriteBits( NETWORKUPDATE_BATCHVERSION, 8 );
+    writer.WriteBool( _bounds.IsValid() );
+    if( _bounds.IsValid() )
+    {
+        writer.WriteFloat( _bounds.m_sizeX );
+        writer.WriteFloat( _bounds.m_sizeZ );
+    }
+    writer.WriteVarUInt( static_cast<unsigned int>(lastSequenceId + 1) );
+
+    int numPacked = 0;
+    while( numPacked < _numUpdates )
+    {
+        int rollback = writer.GetBitPosition();
+        const NetworkUpdate *update = _updates[numPacked];
+        const NetworkUpdate *previous = numPacked > 0 ? _updates[numPacked - 1] : nullptr;
+        bool frameStart = !previous ||
+                          update->m_inputFrame != previous->m_inputFrame ||
+                          update->m_inputIndex != previous->m_inputIndex + 1;
+
+        writer.WriteBool( true );
+        writer.WriteBool( frameStart );
+        if( frameStart )
+        {
+            writer.WriteVarUInt( static_cast<unsigned int>(update->m_inputFrame + 1) );
+            writer.WriteVarUInt( static_cast<unsigned int>(update->m_inputIndex) );
+        }
+        update->PackBits( writer, _bounds );
+
+        // Leave room for the terminator bit
+        if( writer.Overflowed() || writer.GetBitPosition() + 1 > _bufferSize * 8 )
+        {
+            writer.Rewind( rollback );
+            break;
+        }
+        ++numPacked;
+    }
+
+    writer.WriteBool( false );
+    DEBUG_ASSERT( numPacked > 0 || _numUpdates == 0 );
+
+    *_linearSize = writer.BytesWritten();
+    return numPacked;
+}
+
+
+int NetworkUpdate::UnpackBatch( const char *_buffer, int _length, LList<NetworkUpdate *> *_updates )
+{
+    BitReader reader( _buffer, _length );
+
+    if( reader.ReadBits( 8 ) != NETWORKUPDATE_BATCHVERSION ) return 0;
+
+    PositionBounds bounds;
+    if( reader.ReadBool() )
+    {
+        bounds.m_sizeX = reader.ReadFloat();
+        bounds.m_sizeZ = reader.ReadFloat();
+        if( !bounds.IsValid() ) return 0;
+    }
+    int lastSequenceId = static_cast<int>( reader.ReadVarUInt() ) - 1;
+
+    int numUnpacked = 0;
+    int inputFrame = -1;
+    int inputIndex = -1;
+    while( reader.ReadBool() )
+    {
+        if( reader.ReadBool() )
+        {
+            inputFrame = static_cast<int>( reader.ReadVarUInt() ) - 1;
+            inputIndex = static_cast<int>( reader.ReadVarUInt() );
+        }
+        else
+        {
+            ++inputIndex;
+        }
+
+        auto update = new NetworkUpdate();
+        if( !update->UnpackBits( reader, bounds ) )
+        {
+            delete update;
+            break;
+        }
+
+        update->SetLastSequenceId( lastSequenceId );
+        update->SetInputFrame( inputFrame, inputIndex );
+        _updates->PutDataAtEnd( update );
+        ++numUnpacked;
+    }
+
+    return numUnpacked;
+}
+
+
 //void NetworkUpdate::SendToDebugStream(FILE *_out, int _seqNum)
 //{
 //    _ostr << _seqNum << ": ";
@@ -330,11 +651,3 @@ char *NetworkUpdate::GetByteStream(int *_linearSize)
 //    }
 //    _ostr << "\n";
 //}
-
-
-// *** Operator =
-NetworkUpdate const &NetworkUpdate::operator = (NetworkUpdate const &n)
-{
-    memcpy( this, &n, sizeof(NetworkUpdate) );
-    return *this;
-}
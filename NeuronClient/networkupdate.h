@@ -10,12 +10,23 @@
 
 #pragma once
 
-#define NETWORKUPDATE_BYTESTREAMSIZE        42
+#define NETWORKUPDATE_BYTESTREAMSIZE        48
+#define NETWORKUPDATE_BATCHVERSION          3       // First byte of every bit-packed client->server datagram
+#define NETWORKUPDATE_POSITIONBITS          16      // Quantisation of x/z relative to the world size
+#define NETWORKUPDATE_HEIGHTSCALE           8.0f    // y is sent as a varint in 1/8 units
+#define NETWORKUPDATE_TEAMCONTROLFLAGS      9       // Bits used by TeamControls::GetFlags
 
 #include "worldobject.h"
 #include "entity.h"
 
 #include "team.h"
+#include "SyncReport.h"
+
+namespace Neuron
+{
+  class BitWriter;
+  class BitReader;
+}
 
 class NetworkUpdate
 {
@@ -54,12 +65,29 @@ public:
 	TeamControls	m_teamControls;
 
     int             m_lastProcessedSeqId;       // Used for sync checks
-    unsigned char   m_sync;
+    SyncReport      m_syncReport;               // Per-subsystem state checksums after m_lastProcessedSeqId
 
     int m_lastSequenceId;
 
+    int m_inputFrame;                           // Client input frame this command belongs to, -1 if none
+    int m_inputIndex;                           // Position within that frame
+
     char m_byteStream[NETWORKUPDATE_BYTESTREAMSIZE];
 
+    // Positions inside [0, size] on x and z are quantised.  The bounds travel
+    // in each batch header, so a decoder needs no world of its own.
+    struct PositionBounds
+    {
+        float m_sizeX = 0.0f;
+        float m_sizeZ = 0.0f;
+
+        bool IsValid() const { return m_sizeX > 0.0f && m_sizeZ > 0.0f; }
+    };
+
+private:
+    void PackPosition       ( BitWriter &_writer, PositionBounds const &_bounds ) const;
+    bool UnpackPosition     ( BitReader &_reader, PositionBounds const &_bounds );
+
 public:
     NetworkUpdate();
     NetworkUpdate( char *_byteStream );
@@ -83,9 +111,14 @@ public:
 	void SetPower		    ( float _power );
     void SetProgram         ( unsigned char _prog );
     void SetLastProcessedId ( int _lastProcessedId );
-    void SetSync            ( unsigned char _sync );
+    void SetSyncReport      ( SyncReport const &_report );
 
     void SetLastSequenceId( int _lastSequenceId );
+    void SetInputFrame      ( int _frame, int _index );
+
+    // Orders commands across input frames; the server applies each key at most once
+    static long long GetInputKey( int _frame, int _index ) { return (static_cast<long long>(_frame) << 16) | _index; }
+    long long GetInputKey   () const                    { return GetInputKey( m_inputFrame, m_inputIndex ); }
 
 	const LegacyVector3 &			GetWorldPos() const;
 	LegacyVector3 &				GetWorldPos();
@@ -93,9 +126,21 @@ public:
     int ReadByteStream(char *_byteStream);                          // Returns number of bytes read
 	char *GetByteStream(int *_linearSize);
 
+    // Compact encoding for client->server datagrams.  Several updates are
+    // coalesced per datagram; see PackBatch / UnpackBatch.
+    void PackBits           ( BitWriter &_writer, PositionBounds const &_bounds ) const;
+    bool UnpackBits         ( BitReader &_reader, PositionBounds const &_bounds );     // Returns false on a malformed stream
+
+    // Packs updates from the front of _updates until the datagram is full.
+    // Returns the number of updates packed and writes the datagram size to _linearSize.
+    // Invalid _bounds send every position raw.
+    static int  PackBatch   ( NetworkUpdate * const *_updates, int _numUpdates, PositionBounds const &_bounds,
+                              char *_buffer, int _bufferSize, int *_linearSize );
+    static int  UnpackBatch ( const char *_buffer, int _length, LList<NetworkUpdate *> *_updates );
+
 //    void SendToDebugStream(FILE *_out, int _seqNum);
 
-    NetworkUpdate const &operator = (NetworkUpdate const &n);
+    NetworkUpdate &operator = (NetworkUpdate const &n) = default;
 };
 
 // Inlines
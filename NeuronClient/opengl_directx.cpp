@@ -9,6 +9,7 @@
 #include "matrix34.h"
 #include "tree_renderer.h"
 #include "ShapeMeshCache.h"
+#include "ImageKernels.h"
 
 using namespace OpenGLD3D;
 
@@ -1367,12 +1368,11 @@ void glBindTexture(GLenum target, GLuint texture)
     s_activeTextureState->target = texture;
 }
 
-int gluBuild2DMipmaps(GLenum target, GLint components, GLint width, GLint height, GLenum format, GLenum type, const void* data)
+// Recreates the bound texture with numLevels mips of RGBA8, levels[0] at
+// width x height and each after it half the size of the one before, and
+// queues the upload on this frame's command list
+static int uploadTexture(GLint width, GLint height, const UINT8* const* levels, int numLevels)
 {
-  DEBUG_ASSERT(target == GL_TEXTURE_2D);
-  DEBUG_ASSERT(format == GL_RGBA);
-  DEBUG_ASSERT(type == GL_UNSIGNED_BYTE);
-
   GLuint texIdx = s_activeTextureState->target;
   if (texIdx >= s_textureResources.size())
     return -1;
@@ -1393,7 +1393,7 @@ int gluBuild2DMipmaps(GLenum target, GLint components, GLint width, GLint height
   texDesc.Width = width;
   texDesc.Height = height;
   texDesc.DepthOrArraySize = 1;
-  texDesc.MipLevels = 1; // No auto mip gen for now
+  texDesc.MipLevels = static_cast<UINT16>(numLevels);
   texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
   texDesc.SampleDesc.Count = 1;
 
@@ -1402,33 +1402,38 @@ int gluBuild2DMipmaps(GLenum target, GLint components, GLint width, GLint height
   if (FAILED(hr))
     return -1;
 
-  // Upload via ring buffer
+  // Upload via ring buffer, every level in one allocation
   UINT64 uploadSize = 0;
-  D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
-  device->GetCopyableFootprints(&texDesc, 0, 1, 0, &footprint, nullptr, nullptr, &uploadSize);
+  std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> footprints(numLevels);
+  device->GetCopyableFootprints(&texDesc, 0, numLevels, 0, footprints.data(), nullptr, nullptr, &uploadSize);
 
   auto alloc = Graphics::GetCurrentUploadBuffer().Allocate(uploadSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
 
-  // Copy row by row (respecting row pitch alignment)
-  auto srcData = static_cast<const UINT8*>(data);
-  auto destData = static_cast<UINT8*>(alloc.cpuPtr);
-  UINT srcRowPitch = width * 4;
-  UINT dstRowPitch = footprint.Footprint.RowPitch;
-  for (int row = 0; row < height; row++)
-    memcpy(destData + row * dstRowPitch, srcData + row * srcRowPitch, srcRowPitch);
-
-  D3D12_TEXTURE_COPY_LOCATION srcLoc = {};
-  srcLoc.pResource = Graphics::GetCurrentUploadBuffer().GetResource();
-  srcLoc.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-  srcLoc.PlacedFootprint = footprint;
-  srcLoc.PlacedFootprint.Offset = alloc.offset;
-
-  D3D12_TEXTURE_COPY_LOCATION dstLoc = {};
-  dstLoc.pResource = tex.resource.get();
-  dstLoc.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-  dstLoc.SubresourceIndex = 0;
-
-  cmdList->CopyTextureRegion(&dstLoc, 0, 0, 0, &srcLoc, nullptr);
+  for (int level = 0; level < numLevels; level++)
+  {
+    const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& footprint = footprints[level];
+
+    // Copy row by row (respecting row pitch alignment)
+    auto srcData = levels[level];
+    auto destData = static_cast<UINT8*>(alloc.cpuPtr) + footprint.Offset;
+    UINT srcRowPitch = footprint.Footprint.Width * 4;
+    UINT dstRowPitch = footprint.Footprint.RowPitch;
+    for (UINT row = 0; row < footprint.Footprint.Height; row++)
+      memcpy(destData + row * dstRowPitch, srcData + row * srcRowPitch, srcRowPitch);
+
+    D3D12_TEXTURE_COPY_LOCATION srcLoc = {};
+    srcLoc.pResource = Graphics::GetCurrentUploadBuffer().GetResource();
+    srcLoc.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    srcLoc.PlacedFootprint = footprint;
+    srcLoc.PlacedFootprint.Offset = alloc.offset + footprint.Offset;
+
+    D3D12_TEXTURE_COPY_LOCATION dstLoc = {};
+    dstLoc.pResource = tex.resource.get();
+    dstLoc.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    dstLoc.SubresourceIndex = level;
+
+    cmdList->CopyTextureRegion(&dstLoc, 0, 0, 0, &srcLoc, nullptr);
+  }
 
   // Transition to shader resource
   D3D12_RESOURCE_BARRIER barrier = {};
@@ -1439,27 +1444,16 @@ int gluBuild2DMipmaps(GLenum target, GLint components, GLint width, GLint height
   barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
   cmdList->ResourceBarrier(1, &barrier);
 
-  // Create SRV
+  // Create the SRV, or update it in the texture's existing descriptor slot
   if (!tex.valid)
-  {
     tex.srvHandle = g_glState.AllocateSRVSlot();
-    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-    srvDesc.Texture2D.MipLevels = 1;
-    device->CreateShaderResourceView(tex.resource.get(), &srvDesc, tex.srvHandle);
-  }
-  else
-  {
-    // Update existing SRV (reuse the same descriptor slot)
-    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-    srvDesc.Texture2D.MipLevels = 1;
-    device->CreateShaderResourceView(tex.resource.get(), &srvDesc, tex.srvHandle);
-  }
+
+  D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+  srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+  srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+  srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+  srvDesc.Texture2D.MipLevels = numLevels;
+  device->CreateShaderResourceView(tex.resource.get(), &srvDesc, tex.srvHandle);
 
   tex.width = width;
   tex.height = height;
@@ -1468,8 +1462,34 @@ int gluBuild2DMipmaps(GLenum target, GLint components, GLint width, GLint height
   return 0;
 }
 
+int gluBuild2DMipmaps(GLenum target, GLint components, GLint width, GLint height, GLenum format, GLenum type, const void* data)
+{
+  DEBUG_ASSERT(target == GL_TEXTURE_2D);
+  DEBUG_ASSERT(format == GL_RGBA);
+  DEBUG_ASSERT(type == GL_UNSIGNED_BYTE);
+
+  // The whole chain down to 1x1, filtered on the CPU in linear light
+  std::vector<std::vector<uint8_t>> chain;
+  const int numLevels = Neuron::Image::BuildMipChain(static_cast<const uint8_t*>(data), width, height, chain);
+
+  std::vector<const UINT8*> levels(numLevels);
+  levels[0] = static_cast<const UINT8*>(data);
+  for (int level = 1; level < numLevels; level++)
+    levels[level] = chain[level - 1].data();
+
+  return uploadTexture(width, height, levels.data(), numLevels);
+}
+
 void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type,
-                  const GLvoid* pixels) { gluBuild2DMipmaps(target, 4, width, height, format, type, pixels); }
+                  const GLvoid* pixels)
+{
+  DEBUG_ASSERT(target == GL_TEXTURE_2D);
+  DEBUG_ASSERT(format == GL_RGBA);
+  DEBUG_ASSERT(type == GL_UNSIGNED_BYTE);
+
+  auto data = static_cast<const UINT8*>(pixels);
+  uploadTexture(width, height, &data, 1);
+}
 
 void glTexParameteri(GLenum target, GLenum pname, GLint param)
 {
@@ -2067,8 +2087,7 @@ void glGetDoublev(GLenum pname, GLdouble* params)
 // gluProject / gluUnProject
 // ============================================================================
 
-int gluProject(GLdouble objx, GLdouble objy, GLdouble objz, const GLdouble modelMatrix[16], const GLdouble projMatrix[16],
-               const GLint viewport[4], GLdouble* winx, GLdouble* winy, GLdouble* winz)
+static void LoadProjectMatrices(const GLdouble modelMatrix[16], const GLdouble projMatrix[16], XMMATRIX* _model, XMMATRIX* _proj)
 {
   XMFLOAT4X4 model4, proj4;
   for (int i = 0; i < 16; i++)
@@ -2077,11 +2096,17 @@ int gluProject(GLdouble objx, GLdouble objy, GLdouble objz, const GLdouble model
     reinterpret_cast<float*>(&proj4)[i] = static_cast<float>(projMatrix[i]);
   }
 
-  XMVECTOR obj = XMVectorSet(static_cast<float>(objx), static_cast<float>(objy), static_cast<float>(objz), 1.0f);
-  XMMATRIX model = XMLoadFloat4x4(&model4);
-  XMMATRIX proj = XMLoadFloat4x4(&proj4);
-  XMVECTOR win0 = XMVector4Transform(obj, model);
-  XMVECTOR win = XMVector4Transform(win0, proj);
+  *_model = XMLoadFloat4x4(&model4);
+  *_proj = XMLoadFloat4x4(&proj4);
+}
+
+// Window coordinates in float; gluProject only widens them
+static bool ProjectPoint(float _x, float _y, float _z, const XMMATRIX& _model, const XMMATRIX& _proj, const GLint viewport[4], float* _winX,
+                         float* _winY, float* _winZ)
+{
+  XMVECTOR obj = XMVectorSet(_x, _y, _z, 1.0f);
+  XMVECTOR win0 = XMVector4Transform(obj, _model);
+  XMVECTOR win = XMVector4Transform(win0, _proj);
 
   XMFLOAT4 w;
   XMStoreFloat4(&w, win);
@@ -2093,12 +2118,42 @@ int gluProject(GLdouble objx, GLdouble objy, GLdouble objz, const GLdouble model
   w.x = w.x * 0.5f + 0.5f;
   w.y = w.y * 0.5f + 0.5f;
   w.z = w.z * 0.5f + 0.5f;
-  *winx = w.x * viewport[2] + viewport[0];
-  *winy = w.y * viewport[3] + viewport[1];
-  *winz = w.z;
+  *_winX = w.x * viewport[2] + viewport[0];
+  *_winY = w.y * viewport[3] + viewport[1];
+  *_winZ = w.z;
   return true;
 }
 
+int gluProject(GLdouble objx, GLdouble objy, GLdouble objz, const GLdouble modelMatrix[16], const GLdouble projMatrix[16],
+               const GLint viewport[4], GLdouble* winx, GLdouble* winy, GLdouble* winz)
+{
+  XMMATRIX model, proj;
+  LoadProjectMatrices(modelMatrix, projMatrix, &model, &proj);
+
+  float x, y, z;
+  if (!ProjectPoint(static_cast<float>(objx), static_cast<float>(objy), static_cast<float>(objz), model, proj, viewport, &x, &y, &z))
+    return false;
+  *winx = x;
+  *winy = y;
+  *winz = z;
+  return true;
+}
+
+void gluProjectPoints(int _count, const GLfloat* _objXyz, const GLdouble modelMatrix[16], const GLdouble projMatrix[16],
+                      const GLint viewport[4], GLfloat* _winX, GLfloat* _winY)
+{
+  XMMATRIX model, proj;
+  LoadProjectMatrices(modelMatrix, projMatrix, &model, &proj);
+
+  for (int i = 0; i < _count; i++)
+  {
+    const GLfloat* obj = _objXyz + i * 3;
+    float z;
+    if (!ProjectPoint(obj[0], obj[1], obj[2], model, proj, viewport, &_winX[i], &_winY[i], &z))
+      _winX[i] = _winY[i] = std::numeric_limits<float>::quiet_NaN();
+  }
+}
+
 int gluUnProject(GLdouble winx, GLdouble winy, GLdouble winz, const GLdouble modelMatrix[16], const GLdouble projMatrix[16],
                  const GLint viewport[4], GLdouble* objx, GLdouble* objy, GLdouble* objz)
 {
@@ -395,6 +395,9 @@ void gluPerspective (GLdouble fovy, GLdouble aspect, GLdouble zNear, GLdouble zF
 void gluLookAt (GLdouble eyex, GLdouble eyey, GLdouble eyez, GLdouble centerx, GLdouble centery, GLdouble centerz, GLdouble upx, GLdouble upy, GLdouble upz);
 int gluBuild2DMipmaps (GLenum target, GLint components, GLint width, GLint height, GLenum format, GLenum type, const void *data);
 int gluProject (GLdouble objx, GLdouble objy, GLdouble objz,  const GLdouble modelMatrix[16], const GLdouble  projMatrix[16], const GLint     viewport[4], GLdouble *winx, GLdouble *winy, GLdouble *winz);
+// As gluProject for _count points packed xyz, sharing the matrix setup.  A point
+// gluProject would fail on comes back as NaN.
+void gluProjectPoints (int _count, const GLfloat *_objXyz, const GLdouble modelMatrix[16], const GLdouble projMatrix[16], const GLint viewport[4], GLfloat *_winX, GLfloat *_winY);
 int gluUnProject (GLdouble winx, GLdouble winy, GLdouble winz, const GLdouble modelMatrix[16], const GLdouble projMatrix[16], const GLint    viewport[4], GLdouble *objx, GLdouble *objy, GLdouble *objz);
 
 #include "opengl_directx_inline.h"
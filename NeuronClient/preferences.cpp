@@ -128,7 +128,7 @@ PrefsManager::PrefsManager(const std::string& _filename)
 PrefsManager::~PrefsManager()
 {
   free(m_filename);
-  m_items.EmptyAndDelete();
+  m_items.ClearAndDelete();
   m_fileText.EmptyAndDelete();
 }
 
@@ -256,7 +256,7 @@ void PrefsManager::Load(const char* _filename)
   if (!_filename)
     _filename = m_filename;
 
-  m_items.EmptyAndDelete();
+  m_items.ClearAndDelete();
 
   // Try to read preferences if they exist
   FILE* in = fopen(_filename, "r");
@@ -304,11 +304,7 @@ void PrefsManager::Save()
   // write out all the new prefs items because they didn't exist in m_fileText.
 
   // First clear the "has been written" flags on all the items
-  for (unsigned int i = 0; i < m_items.Size(); ++i)
-  {
-    if (m_items.ValidIndex(i))
-      m_items[i]->m_hasBeenWritten = false;
-  }
+  m_items.ForEach([](std::string_view, PrefsItem* _item) { _item->m_hasBeenWritten = false; });
 
   // Now use m_fileText as a template to write most of the items
   FILE* out = fopen(m_filename, "w");
@@ -342,65 +338,47 @@ void PrefsManager::Save()
         }
         ++c;
       }
-      char key[128];
-      int keyLen = keyEnd - keyStart;
-      strncpy(key, keyStart, keyLen);
-      key[keyLen] = '\0';
-      int itemIndex = m_items.GetIndex(key);
-      PrefsItem* item = m_items.GetData(itemIndex);
+      PrefsItem* item = m_items.Get(std::string_view(keyStart, keyEnd - keyStart));
       SaveItem(out, item);
     }
   }
 
   // Finally output any items that haven't already been written
-  for (unsigned int i = 0; i < m_items.Size(); ++i)
+  m_items.ForEach([&](std::string_view, PrefsItem* _item)
   {
-    if (m_items.ValidIndex(i))
-    {
-      PrefsItem* item = m_items.GetData(i);
-      if (!item->m_hasBeenWritten)
-        SaveItem(out, item);
-    }
-  }
+    if (!_item->m_hasBeenWritten)
+      SaveItem(out, _item);
+  });
 
   fclose(out);
 }
 
 void PrefsManager::Clear()
 {
-  m_items.EmptyAndDelete();
+  m_items.ClearAndDelete();
   m_fileText.EmptyAndDelete();
 }
 
 float PrefsManager::GetFloat(const char* _key, float _default) const
 {
-  int index = m_items.GetIndex(_key);
-  if (index == -1)
-    return _default;
-  PrefsItem* item = m_items.GetData(index);
-  if (item->m_type != PrefsItem::TypeFloat)
+  PrefsItem* item = m_items.Get(_key);
+  if (!item || item->m_type != PrefsItem::TypeFloat)
     return _default;
   return item->m_float;
 }
 
 int PrefsManager::GetInt(const char* _key, int _default) const
 {
-  int index = m_items.GetIndex(_key);
-  if (index == -1)
-    return _default;
-  PrefsItem* item = m_items.GetData(index);
-  if (item->m_type != PrefsItem::TypeInt)
+  PrefsItem* item = m_items.Get(_key);
+  if (!item || item->m_type != PrefsItem::TypeInt)
     return _default;
   return item->m_int;
 }
 
 const char* PrefsManager::GetString(const char* _key, const char* _default) const
 {
-  int index = m_items.GetIndex(_key);
-  if (index == -1)
-    return _default;
-  PrefsItem* item = m_items.GetData(index);
-  if (item->m_type != PrefsItem::TypeString)
+  PrefsItem* item = m_items.Get(_key);
+  if (!item || item->m_type != PrefsItem::TypeString)
     return _default;
   return item->m_str;
 }
@@ -424,16 +402,15 @@ const char* PrefsManager::GetString(const char* _key, const char* _default) cons
 
 void PrefsManager::SetString(const char* _key, const char* _string)
 {
-  int index = m_items.GetIndex(_key);
+  PrefsItem* item = m_items.Get(_key);
 
-  if (index == -1)
+  if (!item)
   {
-    auto item = new PrefsItem(_key, _string);
-    m_items.PutData(item->m_key, item);
+    item = new PrefsItem(_key, _string);
+    m_items.TryEmplace(item->m_key, item);
   }
   else
   {
-    PrefsItem* item = m_items.GetData(index);
     DEBUG_ASSERT(item->m_type == PrefsItem::TypeString);
     char* newString = _strdup(_string);
     free(item->m_str);
@@ -446,16 +423,15 @@ void PrefsManager::SetString(const char* _key, const char* _string)
 
 void PrefsManager::SetFloat(const char* _key, float _float)
 {
-  int index = m_items.GetIndex(_key);
+  PrefsItem* item = m_items.Get(_key);
 
-  if (index == -1)
+  if (!item)
   {
-    auto item = new PrefsItem(_key, _float);
-    m_items.PutData(item->m_key, item);
+    item = new PrefsItem(_key, _float);
+    m_items.TryEmplace(item->m_key, item);
   }
   else
   {
-    PrefsItem* item = m_items.GetData(index);
     DEBUG_ASSERT(item->m_type == PrefsItem::TypeFloat);
     item->m_float = _float;
   }
@@ -463,16 +439,15 @@ void PrefsManager::SetFloat(const char* _key, float _float)
 
 void PrefsManager::SetInt(const char* _key, int _int)
 {
-  int index = m_items.GetIndex(_key);
+  PrefsItem* item = m_items.Get(_key);
 
-  if (index == -1)
+  if (!item)
   {
-    auto item = new PrefsItem(_key, _int);
-    m_items.PutData(item->m_key, item);
+    item = new PrefsItem(_key, _int);
+    m_items.TryEmplace(item->m_key, item);
   }
   else
   {
-    PrefsItem* item = m_items.GetData(index);
     DEBUG_ASSERT(item->m_type == PrefsItem::TypeInt);
     item->m_int = _int;
   }
@@ -494,15 +469,18 @@ void PrefsManager::AddLine(const char* _line, bool _overwrite)
 
     auto item = new PrefsItem(localCopy);
 
-    int idx = m_items.GetIndex(item->m_key);
-    if (_overwrite && idx >= 0)
+    // A key already present keeps its item unless told to overwrite
+    PrefsItem** existing = m_items.Find(item->m_key);
+    if (!existing)
+      m_items.TryEmplace(item->m_key, item);
+    else if (_overwrite)
     {
-      delete m_items.GetData(idx);
-      m_items.RemoveData(item->m_key);
+      delete *existing;
+      *existing = item;
       saveLine = false;
     }
-
-    m_items.PutData(item->m_key, item);
+    else
+      delete item;
     free(localCopy);
   }
 
@@ -534,7 +512,5 @@ void PrefsManager::AddLine(const char* _line, bool _overwrite)
 
 bool PrefsManager::DoesKeyExist(const char* _key)
 {
-  int index = m_items.GetIndex(_key);
-
-  return index != -1;
+  return m_items.Contains(_key);
 }
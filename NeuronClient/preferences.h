@@ -2,7 +2,7 @@
 
 #include <string>
 
-#include "hash_table.h"
+#include "StringMap.h"
 #include "fast_darray.h"
 
 
@@ -47,7 +47,7 @@ public:
 class PrefsManager
 {
 private:
-	HashTable <PrefsItem *> m_items;
+	Neuron::StringMap<PrefsItem *> m_items;
 	FastDArray<char *> m_fileText;
     char *m_filename;
 
@@ -39,7 +39,7 @@ ProfiledElement::ProfiledElement(char const *_name, ProfiledElement *_parent)
 ProfiledElement::~ProfiledElement()
 {
 	free(m_name);
-	m_children.EmptyAndDelete();
+	m_children.ClearAndDelete();
 }
 
 
@@ -81,13 +81,7 @@ void ProfiledElement::Advance()
 	m_historyNumSeconds += 1.0;
 	m_historyNumCalls += m_lastNumCalls;
 
-	for (unsigned int i = 0; i < m_children.Size(); ++i)
-	{
-		if (m_children.ValidIndex(i))
-		{
-			m_children[i]->Advance();
-		}
-	}
+	m_children.ForEach([](std::string_view, ProfiledElement *_child) { _child->Advance(); });
 }
 
 
@@ -100,13 +94,7 @@ void ProfiledElement::ResetHistory()
 	m_longest = DBL_MIN;
 	m_shortest = DBL_MAX;
 
-	for (unsigned int i = 0; i < m_children.Size(); ++i)
-	{
-		if (m_children.ValidIndex(i))
-		{
-			m_children[i]->ResetHistory();
-		}
-	}
+	m_children.ForEach([](std::string_view, ProfiledElement *_child) { _child->ResetHistory(); });
 }
 
 
@@ -114,25 +102,30 @@ double ProfiledElement::GetMaxChildTime()
 {
 	double rv = 0.0;
 
-	short first = m_children.StartOrderedWalk();
-	if (first == -1)
+	// Scaled by the history length of the child that sorts first by name
+	std::string_view firstName;
+	ProfiledElement *first = nullptr;
+	m_children.ForEach([&](std::string_view _name, ProfiledElement *_child)
 	{
-		return 0.0;
-	}
-
-	short i = first;
-	while (i != -1)
-	{
-		float val = m_children[i]->m_historyTotalTime;
+		float val = _child->m_historyTotalTime;
 		if (val > rv)
 		{
 			rv = val;
 		}
 
-		i = m_children.GetNextOrderedIndex();
+		if (!first || Neuron::StringKey::Compare(_name, firstName) < 0)
+		{
+			firstName = _name;
+			first = _child;
+		}
+	});
+
+	if (!first)
+	{
+		return 0.0;
 	}
 
-	return rv / m_children[first]->m_historyNumSeconds;
+	return rv / first->m_historyNumSeconds;
 }
 
 
@@ -214,11 +207,11 @@ void Profiler::StartProfile(char const *_name)
 {
 	MAIN_THREAD_ONLY;
 
-	ProfiledElement *pe = m_currentElement->m_children.GetData(_name);
+	ProfiledElement *pe = m_currentElement->m_children.Get(_name);
 	if (!pe)
 	{
 		pe = new ProfiledElement(_name, m_currentElement);
-		m_currentElement->m_children.PutData(_name, pe);
+		m_currentElement->m_children.TryEmplace(_name, pe);
 	}
 
 	ASSERT_TEXT(m_rootElement->m_isExpanded, "Profiler root element has been un-expanded");
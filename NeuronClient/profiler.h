@@ -1,6 +1,6 @@
 #pragma once
 
-#include "sorting_hash_table.h"
+#include "StringMap.h"
 
 
 #ifdef PROFILER_ENABLED
@@ -35,7 +35,7 @@ public:
 	double				m_callStartTime;
     char				*m_name;
 
-	SortingHashTable	<ProfiledElement *> m_children;
+	Neuron::StringMap<ProfiledElement *> m_children;
 	ProfiledElement		*m_parent;
 
 	bool				m_isExpanded;			// Bit of data that a tree view display can use
@@ -84,9 +84,10 @@ public:
 	void				ResetHistory	();
 };
 
-	#define SET_PROFILE(profiler, itemName, value) profiler->SetProfile(itemName, value)
-	#define START_PROFILE(profiler, itemName) profiler->StartProfile(itemName)
-	#define END_PROFILE(profiler, itemName) profiler->EndProfile(itemName)
+	// A headless match has no profiler
+	#define SET_PROFILE(profiler, itemName, value) do { if (profiler) (profiler)->SetProfile(itemName, value); } while (false)
+	#define START_PROFILE(profiler, itemName) do { if (profiler) (profiler)->StartProfile(itemName); } while (false)
+	#define END_PROFILE(profiler, itemName) do { if (profiler) (profiler)->EndProfile(itemName); } while (false)
 
 #else // PROFILER_ENABLED
 	#define SET_PROFILE(profiler, name, value)
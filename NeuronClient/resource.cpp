@@ -15,25 +15,20 @@
 void Resource::AddBitmap(const char* _name, const BitmapRGBA& _bmp, [[maybe_unused]] bool _mipMapping)
 {
   // Only insert if a bitmap with no other bitmap is already using that name
-  if (m_bitmaps.GetIndex(_name) == -1)
-  {
-    auto bmpCopy = new BitmapRGBA(_bmp);
-    m_bitmaps.PutData(_name, bmpCopy);
-  }
+  if (!m_bitmaps.Contains(_name))
+    m_bitmaps.TryEmplace(_name, new BitmapRGBA(_bmp));
 }
 
 void Resource::DeleteBitmap(const char* _name)
 {
-  int index = m_bitmaps.GetIndex(_name);
-  if (index >= 0)
+  if (BitmapRGBA** bmp = m_bitmaps.Find(_name))
   {
-    BitmapRGBA* bmp = m_bitmaps.GetData(index);
-    delete bmp;
-    m_bitmaps.RemoveData(index);
+    delete *bmp;
+    m_bitmaps.Erase(_name);
   }
 }
 
-const BitmapRGBA* Resource::GetBitmap(const char* _name) { return m_bitmaps.GetData(_name); }
+const BitmapRGBA* Resource::GetBitmap(const char* _name) { return m_bitmaps.Get(_name); }
 
 TextReader* Resource::GetTextReader(std::string_view _filename)
 {
@@ -59,19 +54,19 @@ BinaryReader* Resource::GetBinaryReader(std::string_view _filename)
 
 int Resource::GetTexture(const char* _name, bool _mipMapping, bool _masked)
 {
-  // First lookup this name in the BTree of existing textures
-  int theTexture = m_textures.GetData(_name, -1);
+  // First lookup this name in the table of existing textures
+  int theTexture = m_textures.Get(_name, -1);
 
   // If the texture wasn't there, then look in our bitmap store
   if (theTexture == -1)
   {
-    BitmapRGBA* bmp = m_bitmaps.GetData(_name);
+    BitmapRGBA* bmp = m_bitmaps.Get(_name);
     if (bmp)
     {
       if (_masked)
         bmp->ConvertPinkToTransparent();
       theTexture = bmp->ConvertToTexture(_mipMapping);
-      m_textures.PutData(_name, theTexture);
+      m_textures.InsertOrAssign(_name, theTexture);
     }
   }
 
@@ -92,7 +87,7 @@ int Resource::GetTexture(const char* _name, bool _mipMapping, bool _masked)
       if (_masked)
         bmp.ConvertPinkToTransparent();
       theTexture = bmp.ConvertToTexture(_mipMapping);
-      m_textures.PutData(_name, theTexture);
+      m_textures.InsertOrAssign(_name, theTexture);
     }
   }
 
@@ -108,14 +103,12 @@ int Resource::GetTexture(const char* _name, bool _mipMapping, bool _masked)
 
 bool Resource::DoesTextureExist(const char* _name)
 {
-  // First lookup this name in the BTree of existing textures
-  int theTexture = m_textures.GetData(_name, -1);
-  if (theTexture != -1)
+  // First lookup this name in the table of existing textures
+  if (m_textures.Get(_name, -1) != -1)
     return true;
 
   // If the texture wasn't there, then look in our bitmap store
-  BitmapRGBA* bmp = m_bitmaps.GetData(_name);
-  if (bmp)
+  if (m_bitmaps.Get(_name))
     return true;
 
   // If we still didn't find it, try to load it from a file on the disk
@@ -131,18 +124,18 @@ bool Resource::DoesTextureExist(const char* _name)
 
 void Resource::DeleteTexture(const char* _name)
 {
-  int id = m_textures.GetData(_name);
+  int id = m_textures.Get(_name);
   if (id > 0)
   {
     unsigned int id2 = id;
     glDeleteTextures(1, &id2);
-    m_textures.RemoveData(_name);
+    m_textures.Erase(_name);
   }
 }
 
 ShapeStatic* Resource::GetShapeStatic(const char* _name)
 {
-  ShapeStatic* theShape = m_shapes.GetData(_name);
+  ShapeStatic* theShape = m_shapes.Get(_name);
 
   // If we haven't loaded the shape before, try to load it from the disk
   if (!theShape)
@@ -153,7 +146,7 @@ ShapeStatic* Resource::GetShapeStatic(const char* _name)
       theShape = NEW ShapeStatic(to_string(fullFilename).c_str());
 
     ASSERT_TEXT(theShape, "Couldn't create shape file {}", _name);
-    m_shapes.PutData(_name, theShape);
+    m_shapes.InsertOrAssign(_name, theShape);
   }
 
   return theShape;
@@ -219,7 +212,7 @@ int Resource::CreateDisplayList(const char* _name)
   DEBUG_ASSERT(_name && strlen(_name) < 20);
 
   unsigned int id = glGenLists(1);
-  m_displayLists.PutData(_name, id);
+  m_displayLists.InsertOrAssign(_name, id);
 
   return id;
 }
@@ -229,7 +222,7 @@ int Resource::GetDisplayList(const char* _name)
   // Make sure name isn't NULL and isn't too long
   DEBUG_ASSERT(_name && strlen(_name) < 20);
 
-  return m_displayLists.GetData(_name, -1);
+  return m_displayLists.Get(_name, -1);
 }
 
 void Resource::DeleteDisplayList(const char* _name)
@@ -240,11 +233,11 @@ void Resource::DeleteDisplayList(const char* _name)
   // Make sure name isn't too long
   DEBUG_ASSERT(strlen(_name) < 20);
 
-  int id = m_displayLists.GetData(_name, -1);
+  int id = m_displayLists.Get(_name, -1);
   if (id >= 0)
   {
     glDeleteLists(id, 1);
-    m_displayLists.RemoveData(_name);
+    m_displayLists.Erase(_name);
   }
 }
 
@@ -252,28 +245,21 @@ void Resource::FlushOpenGlState()
 {
 #if 1 // Try to catch crash on shutdown bug
   // Tell OpenGL to delete the display lists
-  for (unsigned int i = 0; i < m_displayLists.Size(); ++i)
-  {
-    if (m_displayLists.ValidIndex(i))
-      glDeleteLists(m_displayLists[i], 1);
-  }
+  m_displayLists.ForEach([](std::string_view, int _id) { glDeleteLists(_id, 1); });
 
   // Tell OpenGL to delete the textures
-  for (unsigned int i = 0; i < m_textures.Size(); ++i)
+  m_textures.ForEach([](std::string_view, int _id)
   {
-    if (m_textures.ValidIndex(i))
-    {
-      unsigned int id = i;
-      glDeleteTextures(1, &id);
-    }
-  }
+    unsigned int id = _id;
+    glDeleteTextures(1, &id);
+  });
 #endif
 
   // Forget all the display lists
-  m_displayLists.Empty();
+  m_displayLists.Clear();
 
   // Forget all the texture handles
-  m_textures.Empty();
+  m_textures.Clear();
 
   if (g_context->m_location)
     g_context->m_location->FlushOpenGlState();
@@ -1,9 +1,9 @@
 #pragma once
 
 #include "ShapeStatic.h"
-#include "btree.h"
-#include "hash_table.h"
+#include "darray.h"
 #include "sound_stream_decoder.h"
+#include "StringMap.h"
 #include "bitmap.h"
 
 class Resource
@@ -15,12 +15,12 @@ class Resource
     // they can be used as if they had been loaded from disk or the archive.
     // USUALLY USED for AUTOGENERATED bitmaps, so that the resource system
     // can regenerate textures for them when the OpenGL context is destroyed.
-    inline static HashTable<BitmapRGBA*> m_bitmaps;
+    inline static Neuron::StringMap<BitmapRGBA*> m_bitmaps;
 
-    inline static HashTable<int> m_displayLists;
+    inline static Neuron::StringMap<int> m_displayLists;
 
-    inline static HashTable<int> m_textures;
-    inline static HashTable<ShapeStatic*> m_shapes;
+    inline static Neuron::StringMap<int> m_textures;
+    inline static Neuron::StringMap<ShapeStatic*> m_shapes;
 
     static int WildCmp(const char* _wild, const char* _string);
 
@@ -109,21 +109,18 @@ void CachedSampleHandle::Restart()
 
 CachedSampleManager::~CachedSampleManager()
 {
-	for (unsigned int i = 0; i < m_cache.Size(); ++i)
-	{
-		delete m_cache.GetData(i);
-	}
+	m_cache.ClearAndDelete();
 }
 
 
 CachedSampleHandle *CachedSampleManager::GetSample(char const *_sampleName)
 {
-	CachedSample *cachedSample = m_cache.GetData(_sampleName);
+	CachedSample *cachedSample = m_cache.Get(_sampleName);
 
 	if (!cachedSample)
 	{
 		cachedSample = new CachedSample(_sampleName);
-		m_cache.PutData(_sampleName, cachedSample);
+		m_cache.TryEmplace(_sampleName, cachedSample);
     }
 
 	CachedSampleHandle *rv = new CachedSampleHandle(cachedSample);
@@ -133,7 +130,7 @@ CachedSampleHandle *CachedSampleManager::GetSample(char const *_sampleName)
 
 void CachedSampleManager::EmptyCache()
 {
-    m_cache.EmptyAndDelete();
+    m_cache.ClearAndDelete();
 }
 
 
@@ -141,15 +138,11 @@ int CachedSampleManager::GetMemoryUsage()
 {
     int memoryUsage = 0;
 
-	for( unsigned int i = 0; i < m_cache.Size(); ++i )
+	m_cache.ForEach([&](std::string_view, const CachedSample *sample)
 	{
-		if( m_cache.ValidIndex(i) )
-		{
-			CachedSample *sample = m_cache.GetData(i);
-            int sampleSize = sizeof(signed short) * sample->m_numChannels * sample->m_numSamples;
-            memoryUsage += sampleSize;
-        }
-    }
+        int sampleSize = sizeof(signed short) * sample->m_numChannels * sample->m_numSamples;
+        memoryUsage += sampleSize;
+    });
 
     return memoryUsage;
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "hash_table.h"
+#include "StringMap.h"
 
 
 class SoundStreamDecoder;
@@ -56,7 +56,7 @@ public:
 class CachedSampleManager
 {
 protected:
-	HashTable <CachedSample *>	m_cache;
+	Neuron::StringMap<CachedSample *>	m_cache;
 
 public:
 	~CachedSampleManager();
@@ -1,12 +1,13 @@
 #include "pch.h"
 #include "server.h"
 #include "GameApp.h"
+#include "bytestream.h"
 #include "clienttoserver.h"
 
 #include "generic.h"
 #include "globals.h"
+#include "net_impairment.h"
 #include "net_lib.h"
-#include "net_mutex.h"
 #include "net_socket.h"
 #include "net_socket_listener.h"
 #include "net_thread.h"
@@ -39,8 +40,11 @@ static NetCallBackRetType ListenCallback(NetUdpPacket* udpdata)
 
     if (g_context->m_server)
     {
-      auto letter = new NetworkUpdate(udpdata->m_data);
-      g_context->m_server->ReceiveLetter(letter, newip);
+      // Each datagram carries a bit-packed batch of updates (see NetworkUpdate::PackBatch)
+      LList<NetworkUpdate*> updates;
+      NetworkUpdate::UnpackBatch(udpdata->m_data, udpdata->m_length, &updates);
+      for (int i = 0; i < updates.Size(); ++i)
+        g_context->m_server->ReceiveLetter(updates[i], newip);
       //            SET_PROFILE(g_context->m_profiler,  "#Server Receive", (double) udpdata->getLength() );
     }
 
@@ -50,50 +54,111 @@ static NetCallBackRetType ListenCallback(NetUdpPacket* udpdata)
   return 0;
 }
 
-Server::Server()
+Server::Server(int _port)
   : m_netLib(nullptr),
+    m_listener(nullptr),
+    m_impairment(nullptr),
+    m_sendSignal(0),
+    m_sending(false),
+    m_senderRunning(false),
+    m_listenerRunning(false),
+    m_port(_port),
     m_sequenceId(0),
-    m_inboxMutex(nullptr),
-    m_outboxMutex(nullptr) { m_sync.SetSize(0); }
+    m_inboxDropped(0),
+    m_outboxDropped(0),
+    m_firstDesyncSequenceId(-1),
+    m_firstDesyncSubsystem(-1),
+    m_desyncReports(0) { m_syncReports.SetSize(0); }
 
 Server::~Server()
 {
-  m_history.EmptyAndDelete();
+  // Stop both I/O threads before tearing down anything they touch.  The
+  // listen thread fills m_inbox; the send thread drains m_outbox through
+  // m_listener, so it goes before the listener does.
+  while (m_listenerRunning)
+    m_listener->StopListening();    // Repeated in case the thread had yet to start listening
+
+  if (m_senderRunning)
+  {
+    m_sending = false;
+    m_sendSignal.release();
+    while (m_senderRunning)
+      NetSleep(1);
+  }
+
+  // Frees m_port for the next Server
+  SAFE_DELETE(m_listener);
+  SAFE_DELETE(m_impairment);    // After the socket, which forgets its queued datagrams on close
+  SAFE_DELETE(m_netLib);
+
+  while (!m_history.Empty())
+    delete m_history.PopFront();
   m_clients.EmptyAndDelete();
   m_teams.EmptyAndDelete();
   m_chunkStates.EmptyAndDelete();
 
-  m_inboxMutex->Lock();
-  m_inbox.EmptyAndDelete();
-  m_inboxMutex->Unlock();
+  NetworkUpdate* update;
+  while (m_inbox.TryPop(update))
+    delete update;
 
-  m_outboxMutex->Lock();
-  m_outbox.EmptyAndDelete();
-  m_outboxMutex->Unlock();
+  ServerOutgoingLetter outgoing;
+  while (m_outbox.TryPop(outgoing))
+    delete outgoing.m_letter;
 }
 
-static NetCallBackRetType ListenThread([[maybe_unused]] void* ptr)
+static NetCallBackRetType ListenThread(void* _context)
 {
-  auto m_listener = new NetSocketListener(4000);
-  m_listener->StartListening(ListenCallback);
+  g_context = static_cast<GameContext*>(_context);
+  g_context->m_server->RunListener();
   return 0;
 }
 
-void Server::Initialise()
+static NetCallBackRetType SendThread(void* _context)
 {
-  m_inboxMutex = new NetMutex();
-  m_outboxMutex = new NetMutex();
+  g_context = static_cast<GameContext*>(_context);
+  g_context->m_server->RunSender();
+  return 0;
+}
 
+void Server::Initialise()
+{
   if (!g_context->m_bypassNetworking)
   {
     m_netLib = new NetLib();
     m_netLib->Initialise();
 
-    NetStartThread(ListenThread);
+    // Bind before the listen thread starts so AdvanceSender can reply through it immediately
+    m_listener = new NetSocketListener(m_port);
+    NetRetCode retCode = m_listener->Bind();
+    DEBUG_ASSERT(retCode == NetOk);
+
+    m_impairment = CreateNetImpairmentFromPrefs(0);
+    m_listener->SetImpairment(m_impairment);
+
+    // I/O threads work for the match that started them
+    m_listenerRunning = true;
+    NetStartThread(ListenThread, g_context);
+
+    m_sending = true;
+    m_senderRunning = true;
+    NetStartThread(SendThread, g_context);
+  }
+}
+
+// *** RunSender
+// Body of the I/O thread: socket writes happen here so the sim thread never
+// blocks on the network.  Advance wakes it once per tick.
+void Server::RunSender()
+{
+  while (m_sending)
+  {
+    (void)m_sendSignal.try_acquire_for(std::chrono::milliseconds(100));
+    AdvanceSender();
   }
+  m_senderRunning = false;
 }
 
-int Server::GetClientId(char* _ip)
+int Server::GetClientId(const char* _ip)
 {
   for (int i = 0; i < m_clients.Size(); ++i)
   {
@@ -108,6 +173,10 @@ int Server::GetClientId(char* _ip)
   return -1;
 }
 
+// One above the server's own port rather than a fixed one, so clients of two
+// Servers hosted side by side (on ports two apart) never take each other's letters
+int Server::GetClientPort(int _serverPort) { return _serverPort + 1; }
+
 int Server::ConvertIPToInt(const char* _ip)
 {
   ASSERT_TEXT(strlen(_ip) < 17, "IP address too long");
@@ -141,7 +210,7 @@ const char* Server::ConvertIntToIP(const int _ip)
 void Server::RegisterNewClient(char* _ip)
 {
   DEBUG_ASSERT(GetClientId(_ip) == -1);
-  auto sToC = new ServerToClient(_ip);
+  auto sToC = new ServerToClient(_ip, GetClientPort(m_port));
   int clientId = m_clients.PutData(sToC);
 
   // Create matching chunk subscription state
@@ -151,6 +220,13 @@ void Server::RegisterNewClient(char* _ip)
     m_chunkStates.SetSize(clientId + 1);
   m_chunkStates.PutData(chunkState, clientId);
 
+  // Replaying a long match is slow, and impossible once the history has been truncated
+  if (m_sequenceId > SERVER_SNAPSHOT_MIN_SEQUENCE || m_history.GetFirstId() > 0)
+  {
+    DebugTrace("SERVER: {} joined at sequence {}; waiting for a snapshot\n", _ip, m_sequenceId);
+    sToC->m_awaitingSnapshot = true;
+  }
+
   //
   // Tell all clients about it
 
@@ -256,16 +332,8 @@ void Server::RegisterNewTeam(char* _ip, int _teamType, int _desiredTeamId)
 
 NetworkUpdate* Server::GetNextLetter()
 {
-  m_inboxMutex->Lock();
   NetworkUpdate* letter = nullptr;
-
-  if (m_inbox.Size() > 0)
-  {
-    letter = m_inbox[0];
-    m_inbox.RemoveData(0);
-  }
-
-  m_inboxMutex->Unlock();
+  m_inbox.TryPop(letter);
   return letter;
 }
 
@@ -273,9 +341,12 @@ void Server::ReceiveLetter(NetworkUpdate* update, char* fromIP)
 {
   update->SetClientIp(fromIP);
 
-  m_inboxMutex->Lock();
-  m_inbox.PutDataAtEnd(update);
-  m_inboxMutex->Unlock();
+  if (!m_inbox.TryPush(update))
+  {
+    // The sim thread is badly behind; shed load rather than block the listener
+    ++m_inboxDropped;
+    delete update;
+  }
 }
 
 void Server::SendLetter(ServerToClientLetter* letter)
@@ -286,7 +357,7 @@ void Server::SendLetter(ServerToClientLetter* letter)
   letter->SetSequenceId(m_sequenceId);
   m_sequenceId++;
 
-  m_history.PutDataAtEnd(letter);
+  m_history.Put(letter->GetSequenceId(), letter);
 }
 
 // *** SendLetterToClient — bypasses m_history, sends directly to one client's outbox.
@@ -300,11 +371,9 @@ void Server::SendLetterToClient(ServerToClientLetter* letter, int _clientId)
     return;
   }
 
-  // Pheromone letters get sequenceId 0 (sentinel — not tracked by the
+  // Bulk letters get sequenceId 0 (sentinel — not tracked by the
   // client's sequence-gap detector).  Normal letters get a real ID.
-  bool isBulk = (letter->m_type == ServerToClientLetter::ChunkPheromoneUpdate ||
-                 letter->m_type == ServerToClientLetter::ChunkPheromoneFullSync);
-  if (isBulk)
+  if (letter->IsBulk())
   {
     letter->SetSequenceId(0);
   }
@@ -315,9 +384,28 @@ void Server::SendLetterToClient(ServerToClientLetter* letter, int _clientId)
   }
   letter->SetClientId(_clientId);
 
-  m_outboxMutex->Lock();
-  m_outbox.PutDataAtEnd(letter);
-  m_outboxMutex->Unlock();
+  QueueOutgoing(letter);
+}
+
+// *** QueueOutgoing
+// Hands a letter addressed to one client over to the I/O thread.
+void Server::QueueOutgoing(ServerToClientLetter* _letter)
+{
+  int clientId = _letter->GetClientId();
+  if (!m_clients.ValidIndex(clientId))
+  {
+    delete _letter;
+    return;
+  }
+
+  ServerOutgoingLetter outgoing = {_letter, *m_clients[clientId]->GetAddress()};
+  if (!m_outbox.TryPush(outgoing))
+  {
+    // The I/O thread is behind.  Sequenced letters are resent from m_history
+    // until the client acknowledges them, so dropping here is safe.
+    ++m_outboxDropped;
+    delete _letter;
+  }
 }
 
 // *** SendLetterToChunkSubscribers — fan-out a letter to every client subscribed
@@ -360,34 +448,43 @@ void Server::UnsubscribeClientFromChunk(int _clientId, int _chunkX, int _chunkZ)
 void Server::AdvanceSender()
 {
   int bytesSentThisFrame = 0;
-  m_outboxMutex->Lock();
+  m_sendBuffer.clear();
+  m_sendAddresses.clear();
+  m_sendBatch.clear();
 
-  while (m_outbox.Size())
+  ServerOutgoingLetter outgoing;
+  while (m_outbox.TryPop(outgoing))
   {
-    ServerToClientLetter* letter = m_outbox[0];
+    ServerToClientLetter* letter = outgoing.m_letter;
     DEBUG_ASSERT(letter);
 
-    if (m_clients.ValidIndex(letter->GetClientId()))
+    if (g_context->m_bypassNetworking)
+      g_context->m_clientToServer->ReceiveLetter(letter);
+    else
     {
-      if (g_context->m_bypassNetworking)
-        g_context->m_clientToServer->ReceiveLetter(letter);
-      else
-      {
-        int linearSize = 0;
-        ServerToClient* client = m_clients[letter->GetClientId()];
-        NetSocket* socket = client->GetSocket();
-        char* linearisedLetter = letter->GetByteStream(&linearSize);
-        socket->WriteData(linearisedLetter, linearSize);
-        bytesSentThisFrame += linearSize;
-        delete letter;
-      }
+      // Linearise now (the byte stream buffer is reused) and send the whole outbox in one batch below
+      int linearSize = 0;
+      char* linearisedLetter = letter->GetByteStream(&linearSize);
+      m_sendBuffer.insert(m_sendBuffer.end(), linearisedLetter, linearisedLetter + linearSize);
+      m_sendAddresses.push_back(outgoing.m_to);
+      m_sendBatch.push_back({nullptr, nullptr, linearSize});
+      bytesSentThisFrame += linearSize;
+      delete letter;
     }
-
-    // The letter has now been sent so we can take it off the outbox list
-    m_outbox.RemoveData(0);
   }
 
-  m_outboxMutex->Unlock();
+  if (!m_sendBatch.empty())
+  {
+    // The vectors may have reallocated while filling, so point into them only now
+    const char* data = m_sendBuffer.data();
+    for (size_t i = 0; i < m_sendBatch.size(); ++i)
+    {
+      m_sendBatch[i].m_to = &m_sendAddresses[i];
+      m_sendBatch[i].m_data = data;
+      data += m_sendBatch[i].m_length;
+    }
+    m_listener->SendBatch(m_sendBatch.data(), static_cast<int>(m_sendBatch.size()));
+  }
 
   if (bytesSentThisFrame > 0)
   {
@@ -409,64 +506,51 @@ void Server::Advance()
 
   while (incoming)
   {
-    if (incoming->m_type == NetworkUpdate::ClientJoin)
-    {
-      if (GetClientId(incoming->m_clientIp) == -1)
-      {
-        DebugTrace("SERVER: New Client connected from {}\n", incoming->m_clientIp);
-        RegisterNewClient(incoming->m_clientIp);
-      }
-    }
-    else if (incoming->m_type == NetworkUpdate::ClientLeave)
-    {
-      if (GetClientId(incoming->m_clientIp) != -1)
-      {
-        DebugTrace("SERVER: Client at {} disconnected gracefully\n", incoming->m_clientIp);
-        RemoveClient(incoming->m_clientIp);
-      }
-    }
-    else if (incoming->m_type == NetworkUpdate::RequestTeam)
+    //
+    // Clients resend each input frame until we acknowledge it, so apply every command only once
+
+    int senderId = GetClientId(incoming->m_clientIp);
+    bool duplicate = (senderId != -1 && !m_clients[senderId]->AcceptInput(incoming->m_inputFrame, incoming->m_inputIndex));
+
+    if (!duplicate)
     {
-      if (GetClientId(incoming->m_clientIp) != -1)
+      if (incoming->m_type == NetworkUpdate::ClientJoin)
       {
-        DebugTrace("SERVER: New team request from {}\n", incoming->m_clientIp);
-        RegisterNewTeam(incoming->m_clientIp, incoming->m_teamType, incoming->m_desiredTeamId);
+        if (GetClientId(incoming->m_clientIp) == -1)
+        {
+          DebugTrace("SERVER: New Client connected from {}\n", incoming->m_clientIp);
+          RegisterNewClient(incoming->m_clientIp);
+          m_clients[GetClientId(incoming->m_clientIp)]->AcceptInput(incoming->m_inputFrame, incoming->m_inputIndex);
+        }
       }
-    }
-    else if (incoming->m_type == NetworkUpdate::Syncronise)
-    {
-      int sequenceId = incoming->m_lastProcessedSeqId;
-      unsigned char sync = incoming->m_sync;
-
-      if (sequenceId != 0 && !m_sync.ValidIndex(sequenceId - 1))
+      else if (incoming->m_type == NetworkUpdate::ClientLeave)
       {
-        // This incoming packet has a sequence ID that is too high
-        // Most likely it was sent from a previous client connected to a previous server
-        // Then that server shut down, and this one started up
-        // Then this server received the packet intended for the old server
-        // So we simply discard it
-        //DebugTrace( "Sync %d discarded as bogus\n", sequenceId );
+        if (GetClientId(incoming->m_clientIp) != -1)
+        {
+          DebugTrace("SERVER: Client at {} disconnected gracefully\n", incoming->m_clientIp);
+          RemoveClient(incoming->m_clientIp);
+        }
       }
-      else
+      else if (incoming->m_type == NetworkUpdate::RequestTeam)
       {
-        if (m_sync.Size() <= sequenceId)
-          m_sync.SetSize(m_sync.Size() + 1000);
-
-        if (m_sync.ValidIndex(sequenceId))
+        if (senderId != -1 && m_clients[senderId]->m_awaitingSnapshot)
         {
-          unsigned char lastKnownSync = m_sync[sequenceId];
-          DEBUG_ASSERT(lastKnownSync == sync);
-          //DebugTrace( "Sync %02d verified as %03d\n", sequenceId, sync );
+          // The TeamAssign must come after the snapshot, or the client would not know which team is its own
+          auto deferred = new NetworkUpdate();
+          *deferred = *incoming;
+          m_clients[senderId]->m_deferredRequests.PutDataAtEnd(deferred);
         }
-        else
+        else if (GetClientId(incoming->m_clientIp) != -1)
         {
-          m_sync.PutData(sync, sequenceId);
-          //DebugTrace( "Sync %02d set to %03d\n", sequenceId, sync );
+          DebugTrace("SERVER: New team request from {}\n", incoming->m_clientIp);
+          RegisterNewTeam(incoming->m_clientIp, incoming->m_teamType, incoming->m_desiredTeamId);
         }
       }
+      else if (incoming->m_type == NetworkUpdate::Syncronise)
+        ReceiveSyncReport(incoming->m_lastProcessedSeqId, incoming->m_syncReport, incoming->m_clientIp);
+      else if (incoming->m_teamId != 255)
+        letter->AddUpdate(incoming);
     }
-    else if (incoming->m_teamId != 255)
-      letter->AddUpdate(incoming);
 
     int clientId = GetClientId(incoming->m_clientIp);
     if (clientId != -1)
@@ -482,6 +566,8 @@ void Server::Advance()
 
   SendLetter(letter);
 
+  AdvanceSnapshots();
+
   //
   // Update all clients depending on their state
 
@@ -491,35 +577,215 @@ void Server::Advance()
 
   for (int i = 0; i < m_clients.Size(); ++i)
   {
-    if (m_clients.ValidIndex(i))
+    if (m_clients.ValidIndex(i) && !m_clients[i]->m_awaitingSnapshot)
     {
       ServerToClient* s2c = m_clients[i];
-      int sendFrom = s2c->m_lastKnownSequenceId + 1;
-      int sendTo = m_history.Size();
+      int sendFrom = std::max(s2c->m_lastKnownSequenceId + 1, m_history.GetFirstId());
+      int sendTo = m_history.GetEndId();
       if (sendTo - sendFrom > maxUpdates)
         sendTo = sendFrom + maxUpdates;
 
       for (int l = sendFrom; l < sendTo; ++l)
       {
-        if (m_history.ValidIndex(l))
+        ServerToClientLetter* theLetter = m_history.Get(l);
+        if (theLetter)
         {
-          ServerToClientLetter* theLetter = m_history[l];
           auto letterCopy = new ServerToClientLetter(*theLetter);
           letterCopy->SetClientId(i);
-
-          m_outboxMutex->Lock();
-          m_outbox.PutDataAtEnd(letterCopy);
-          m_outboxMutex->Unlock();
+          letterCopy->SetInputAck(s2c->m_lastInputFrame, s2c->m_lastInputIndex);
+          QueueOutgoing(letterCopy);
         }
       }
     }
   }
 
-  AdvanceSender();
+  TruncateHistory();
+
+  if (g_context->m_bypassNetworking)
+    AdvanceSender();
+  else
+    m_sendSignal.release();
 
   END_PROFILE(g_context->m_profiler, "Advance Server");
 }
 
+// *** TruncateHistory
+// Frees letters every connected client has processed.  Processed rather than
+// acknowledged, because a snapshot is taken at the host's processed sequence
+// id and a late joiner needs everything after it.  Nothing is freed while no
+// client is connected, or while a demo is being recorded, since SaveHistory
+// needs the whole stream.
+void Server::TruncateHistory()
+{
+  if (g_prefsManager->GetInt("RecordDemo") != 0)
+    return;
+
+  int ackedByAll = INT_MAX;
+  for (int i = 0; i < m_clients.Size(); ++i)
+  {
+    if (!m_clients.ValidIndex(i))
+      continue;
+
+    ServerToClient* s2c = m_clients[i];
+    if (s2c->m_awaitingSnapshot)
+    {
+      if (s2c->m_snapshot)
+        ackedByAll = std::min(ackedByAll, s2c->m_snapshotSequenceId);
+    }
+    else
+      ackedByAll = std::min(ackedByAll, std::min(s2c->m_lastKnownSequenceId, s2c->m_lastProcessedSequenceId));
+  }
+
+  if (ackedByAll == INT_MAX)
+    return;
+
+  while (!m_history.Empty() && m_history.GetFirstId() <= ackedByAll)
+    delete m_history.PopFront();
+}
+
+// *** IsSnapshotRequested
+bool Server::IsSnapshotRequested() const
+{
+  for (int i = 0; i < m_clients.Size(); ++i)
+  {
+    if (m_clients.ValidIndex(i) && m_clients[i]->m_awaitingSnapshot && !m_clients[i]->m_snapshot)
+      return true;
+  }
+  return false;
+}
+
+// *** SendSnapshot
+// Hands the snapshot to every client still waiting for one.  AdvanceSnapshots
+// sends it in parts over the following ticks.
+void Server::SendSnapshot(int _sequenceId, const uint8_t* _data, int _size)
+{
+  auto snapshot = std::make_shared<const std::vector<uint8_t>>(_data, _data + _size);
+
+  for (int i = 0; i < m_clients.Size(); ++i)
+  {
+    if (!m_clients.ValidIndex(i))
+      continue;
+
+    ServerToClient* s2c = m_clients[i];
+    if (!s2c->m_awaitingSnapshot || s2c->m_snapshot)
+      continue;
+
+    DebugTrace("SERVER: Sending {} a {} byte snapshot at sequence {}\n", s2c->GetIP(), _size, _sequenceId);
+    s2c->m_snapshot = snapshot;
+    s2c->m_snapshotSequenceId = _sequenceId;
+    s2c->m_snapshotNextPart = 0;
+    s2c->m_snapshotResendTimer = SERVER_SNAPSHOT_RESEND;
+  }
+}
+
+// *** AdvanceSnapshots
+// Paces snapshot parts out to late joiners.  Once a joiner reports the
+// snapshot's sequence id it rejoins the normal resend stream from the next
+// letter, and any team request it made meanwhile is granted.
+void Server::AdvanceSnapshots()
+{
+  for (int i = 0; i < m_clients.Size(); ++i)
+  {
+    if (!m_clients.ValidIndex(i))
+      continue;
+
+    ServerToClient* s2c = m_clients[i];
+    if (!s2c->m_awaitingSnapshot || !s2c->m_snapshot)
+      continue;
+
+    if (s2c->m_lastKnownSequenceId >= s2c->m_snapshotSequenceId)
+    {
+      s2c->m_awaitingSnapshot = false;
+      s2c->m_snapshot.reset();
+
+      for (int r = 0; r < s2c->m_deferredRequests.Size(); ++r)
+      {
+        NetworkUpdate* request = s2c->m_deferredRequests[r];
+        RegisterNewTeam(s2c->GetIP(), request->m_teamType, request->m_desiredTeamId);
+      }
+      s2c->m_deferredRequests.EmptyAndDelete();
+      continue;
+    }
+
+    const std::vector<uint8_t>& snapshot = *s2c->m_snapshot;
+    const int size = static_cast<int>(snapshot.size());
+    const int numParts = std::max(1, (size + SERVER_SNAPSHOT_PART_SIZE - 1) / SERVER_SNAPSHOT_PART_SIZE);
+
+    if (s2c->m_snapshotNextPart >= numParts)
+    {
+      // Every part is out; if some were lost the assembler ignores the duplicates
+      if (--s2c->m_snapshotResendTimer > 0)
+        continue;
+      s2c->m_snapshotNextPart = 0;
+      s2c->m_snapshotResendTimer = SERVER_SNAPSHOT_RESEND;
+    }
+
+    const int lastPart = std::min(numParts, s2c->m_snapshotNextPart + SERVER_SNAPSHOT_PARTS_PER_TICK);
+    for (int part = s2c->m_snapshotNextPart; part < lastPart; ++part)
+    {
+      const int offset = part * SERVER_SNAPSHOT_PART_SIZE;
+      const int partSize = std::min(SERVER_SNAPSHOT_PART_SIZE, size - offset);
+
+      auto letter = new ServerToClientLetter();
+      letter->SetType(ServerToClientLetter::LocationSnapshot);
+      letter->m_bulkDataSize = static_cast<int>(sizeof(int) * 3) + partSize;
+      letter->m_bulkData = new char[letter->m_bulkDataSize];
+
+      char* ptr = letter->m_bulkData;
+      WRITE_INT(ptr, s2c->m_snapshotSequenceId);
+      WRITE_INT(ptr, part);
+      WRITE_INT(ptr, numParts);
+      memcpy(ptr, snapshot.data() + offset, partSize);
+
+      SendLetterToClient(letter, i);
+    }
+    s2c->m_snapshotNextPart = lastPart;
+  }
+}
+
+// *** ReceiveSyncReport
+// The first report for a sequence id becomes the reference; every later report
+// is compared against it.  Only the earliest divergence is recorded, because
+// everything after the first desynced tick is noise.
+void Server::ReceiveSyncReport(int _sequenceId, const SyncReport& _report, const char* _fromIP)
+{
+  int clientId = GetClientId(_fromIP);
+  if (clientId != -1 && _sequenceId > m_clients[clientId]->m_lastProcessedSequenceId)
+    m_clients[clientId]->m_lastProcessedSequenceId = _sequenceId;
+
+  if (_sequenceId != 0 && !m_syncReports.ValidIndex(_sequenceId - 1))
+  {
+    // This incoming packet has a sequence ID that is too high
+    // Most likely it was sent from a previous client connected to a previous server
+    // Then that server shut down, and this one started up
+    // Then this server received the packet intended for the old server
+    // So we simply discard it
+    return;
+  }
+
+  if (m_syncReports.Size() <= _sequenceId)
+    m_syncReports.SetSize(m_syncReports.Size() + 1000);
+
+  if (!m_syncReports.ValidIndex(_sequenceId))
+  {
+    m_syncReports.PutData(_report, _sequenceId);
+    return;
+  }
+
+  int subsystem = m_syncReports[_sequenceId].FirstMismatch(_report);
+  if (subsystem == -1)
+    return;
+
+  ++m_desyncReports;
+
+  if (m_firstDesyncSequenceId == -1 || _sequenceId < m_firstDesyncSequenceId)
+  {
+    m_firstDesyncSequenceId = _sequenceId;
+    m_firstDesyncSubsystem = subsystem;
+    DebugTrace("SERVER: Desync detected at sequence {} in {} (client {})\n", _sequenceId, SyncReport::GetSubsystemName(subsystem), _fromIP);
+  }
+}
+
 void Server::LoadHistory(const char* _filename)
 {
   FILE* file = fopen(_filename, "rb");
@@ -536,7 +802,7 @@ void Server::LoadHistory(const char* _filename)
     fread(byteStream, linearSize, 1, file);
 
     auto letter = new ServerToClientLetter(byteStream, linearSize);
-    m_history.PutData(letter);
+    m_history.Put(letter->GetSequenceId(), letter);
 
     if (letter->GetSequenceId() > m_sequenceId)
       m_sequenceId = letter->GetSequenceId() + 1;
@@ -549,12 +815,20 @@ void Server::SaveHistory(const char* _filename)
 {
   FILE* file = fopen(_filename, "wb");
 
-  int historySize = m_history.Size();
+  int historySize = 0;
+  for (int id = m_history.GetFirstId(); id < m_history.GetEndId(); ++id)
+  {
+    if (m_history.Get(id))
+      ++historySize;
+  }
   fwrite(&historySize, sizeof(historySize), 1, file);
 
-  for (int i = 0; i < historySize; ++i)
+  for (int id = m_history.GetFirstId(); id < m_history.GetEndId(); ++id)
   {
-    ServerToClientLetter* letter = m_history[i];
+    ServerToClientLetter* letter = m_history.Get(id);
+    if (!letter)
+      continue;
+
     int linearSize;
     char* byteStream = letter->GetByteStream(&linearSize);
 
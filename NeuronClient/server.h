@@ -2,12 +2,27 @@
 
 #include "llist.h"
 #include "darray.h"
+#include "SyncReport.h"
+#include "RingQueue.h"
+#include "SequenceRing.h"
+#include "net_lib.h"
 #include <unordered_set>
 
 
+#define SERVER_PORT             4000                // Default; several hosted Servers each take their own
+#define SERVER_INBOX_SIZE       4096                // NetworkUpdates awaiting the sim thread
+#define SERVER_OUTBOX_SIZE      4096                // Letters awaiting the I/O thread
+
+#define SERVER_SNAPSHOT_MIN_SEQUENCE    100                     // Clients joining later than this start from a snapshot
+#define SERVER_SNAPSHOT_PART_SIZE       (MAX_PACKET_SIZE - 32)  // Snapshot bytes per LocationSnapshot letter
+#define SERVER_SNAPSHOT_PARTS_PER_TICK  32
+#define SERVER_SNAPSHOT_RESEND          10                      // Ticks to wait for an acknowledgement before resending every part
+
+
 class NetLib;
-class NetMutex;
-class NetSocketListner;
+class NetImpairment;
+class NetSocketListener;
+struct NetDatagram;
 class ServerToClient;
 class ServerToClientLetter;
 class NetworkUpdate;
@@ -22,6 +37,15 @@ public:
 };
 
 
+// A letter on its way to the I/O thread.  The destination is resolved on the
+// sim thread so the I/O thread never reads m_clients.
+struct ServerOutgoingLetter
+{
+    ServerToClientLetter *m_letter;
+    NetIpAddress          m_to;
+};
+
+
 // Per-client chunk subscription state for AoI-aware pheromone delivery (§A.2).
 struct ClientChunkState
 {
@@ -39,43 +63,72 @@ class Server
 {
 private:
     NetLib	        *m_netLib;
+    NetSocketListener *m_listener;                                              // On m_port; receives from and sends to every client
+    NetImpairment   *m_impairment;                                              // Simulated network conditions on sends; nullptr normally
 
-    LList           <ServerToClientLetter *> m_history;
+    std::vector     <char> m_sendBuffer;                                        // Linearised letters for one AdvanceSender batch
+    std::vector     <NetIpAddress> m_sendAddresses;
+    std::vector     <NetDatagram> m_sendBatch;
+
+    std::counting_semaphore<> m_sendSignal;                                     // Released once per tick to wake the I/O thread
+    std::atomic     <bool> m_sending;
+    std::atomic     <bool> m_senderRunning;
+    std::atomic     <bool> m_listenerRunning;
+
+    void QueueOutgoing      ( ServerToClientLetter *_letter );
+    void TruncateHistory    ();
+    void AdvanceSnapshots   ();
+
+    SequenceRing    <ServerToClientLetter *> m_history;                         // Indexed by sequence id; nullptr for letters sent to one client only
 
 public:
+    int             m_port;
     int             m_sequenceId;
 
     DArray          <ServerToClient *> m_clients;
     DArray          <ServerTeam *> m_teams;
 
-    NetMutex         *m_inboxMutex;
-    NetMutex         *m_outboxMutex;
-    LList           <NetworkUpdate *> m_inbox;
-    LList           <ServerToClientLetter *> m_outbox;
+    MpscRingQueue   <NetworkUpdate *, SERVER_INBOX_SIZE> m_inbox;               // Listener thread(s) -> sim thread
+    SpscRingQueue   <ServerOutgoingLetter, SERVER_OUTBOX_SIZE> m_outbox;        // Sim thread -> I/O thread
+    std::atomic     <int> m_inboxDropped;                                       // Updates lost to a full inbox
+    int             m_outboxDropped;                                            // Letters lost to a full outbox (resent from m_history)
 
-    DArray          <unsigned char> m_sync;                                     // Synchronisation values for each sequenceId
+    DArray          <SyncReport> m_syncReports;                                 // First sync report received for each sequenceId
+    int             m_firstDesyncSequenceId;                                    // -1 while all clients agree
+    int             m_firstDesyncSubsystem;                                     // SyncSubsystem that diverged first
+    int             m_desyncReports;                                            // Reports that disagreed with the first for their sequenceId
 
     DArray          <ClientChunkState *> m_chunkStates;  // parallel to m_clients
 
 public:
-    Server();
+    Server( int _port = SERVER_PORT );
     ~Server();
 
     void Initialise			();
 
+
     NetworkUpdate *GetNextLetter();
 
     void ReceiveLetter      ( NetworkUpdate *update, char *fromIP );
     void SendLetter         ( ServerToClientLetter *letter );
 
-    int  GetClientId        ( char *_ip );
+    int  GetClientId        ( const char *_ip );
     void RegisterNewClient  ( char *_ip );
     void RemoveClient       ( char *_ip );
     void RegisterNewTeam    ( char *_ip, int _teamType, int _desiredTeamId );
 
-	void AdvanceSender		();
+	void AdvanceSender		();                                                 // Drains m_outbox; I/O thread, or sim thread when bypassing networking
+    void RunSender          ();
+    void RunListener        ();                                                 // Listen thread; returns once StopListening takes effect
     void Advance			();
 
+    void ReceiveSyncReport  ( int _sequenceId, SyncReport const &_report, const char *_fromIP );
+
+    // Late join.  The host polls IsSnapshotRequested between ticks and answers with
+    // a snapshot of its Location taken after processing _sequenceId.
+    bool IsSnapshotRequested() const;
+    void SendSnapshot       ( int _sequenceId, const uint8_t *_data, int _size );
+
     void LoadHistory        ( const char *_filename );
     void SaveHistory        ( const char *_filename );
 
@@ -85,6 +138,7 @@ public:
     void SubscribeClientToChunk      ( int _clientId, int _chunkX, int _chunkZ );
     void UnsubscribeClientFromChunk  ( int _clientId, int _chunkX, int _chunkZ );
 
+    static int   GetClientPort ( int _serverPort );                             // Where a Server's clients listen
     static int   ConvertIPToInt( const char *_ip );
     static const char *ConvertIntToIP( const int _ip );
 };
@@ -1,26 +1,55 @@
 #include "pch.h"
 #include "net_lib.h"
-#include "net_socket.h"
 #include "GameApp.h"
 
+#include "networkupdate.h"
 #include "servertoclient.h"
 
-ServerToClient::ServerToClient(char* _ip)
-  : m_socket(nullptr)
+ServerToClient::ServerToClient(char* _ip, int _port)
 {
   strncpy(m_ip, _ip, sizeof(m_ip));
   m_ip[sizeof(m_ip) - 1] = '\0';
 
+  memset(&m_address, 0, sizeof(m_address));
+  m_address.sin_family = AF_INET;
+  m_address.sin_port = htons(_port);
   if (!g_context->m_bypassNetworking)
   {
-    m_socket = new NetSocket();
-    NetRetCode retCode = m_socket->Connect(_ip, 4001);
-    DEBUG_ASSERT(retCode == NetOk);
+    int result = inet_pton(AF_INET, m_ip, &m_address.sin_addr);
+    DEBUG_ASSERT(result == 1);
   }
 
   m_lastKnownSequenceId = -1;
+  m_lastInputFrame = -1;
+  m_lastInputIndex = -1;
+  m_lastProcessedSequenceId = -1;
+
+  m_awaitingSnapshot = false;
+  m_snapshotSequenceId = -1;
+  m_snapshotNextPart = 0;
+  m_snapshotResendTimer = 0;
 }
 
+ServerToClient::~ServerToClient() { m_deferredRequests.EmptyAndDelete(); }
+
 char* ServerToClient::GetIP() { return m_ip; }
 
-NetSocket* ServerToClient::GetSocket() { return m_socket; }
+const NetIpAddress* ServerToClient::GetAddress() const { return &m_address; }
+
+bool ServerToClient::AcceptInput(int _frame, int _index)
+{
+  if (_frame == -1)
+    return true; // Not part of an input frame
+
+  // A client that restarted numbers its frames from zero again
+  bool restarted = _frame < m_lastInputFrame - SERVERTOCLIENT_INPUTRESTART;
+
+  if (restarted || NetworkUpdate::GetInputKey(_frame, _index) > NetworkUpdate::GetInputKey(m_lastInputFrame, m_lastInputIndex))
+  {
+    m_lastInputFrame = _frame;
+    m_lastInputIndex = _index;
+    return true;
+  }
+
+  return false;
+}
@@ -3,22 +3,45 @@
 
 #pragma once
 
+#include "llist.h"
+#include "net_lib.h"
 
-class NetSocket;
+
+#define SERVERTOCLIENT_INPUTRESTART     1000    // Input frames; a jump back further than this means the client restarted
+
+
+class NetworkUpdate;
 
 
 class ServerToClient
 {
 private:
-    char		m_ip[16];
-    NetSocket	*m_socket;
+    char		    m_ip[16];
+    NetIpAddress    m_address;          // Client's listen port; the server sends through its own listener socket
 
 public:
-    ServerToClient( char *_ip );
+    ServerToClient( char *_ip, int _port );
+    ~ServerToClient();
 
     char        *GetIP ();
-    NetSocket   *GetSocket ();
+    const NetIpAddress *GetAddress () const;
 
     int         m_lastKnownSequenceId;
+    int         m_lastInputFrame;       // Last input command applied from this client
+    int         m_lastInputIndex;
+    int         m_lastProcessedSequenceId;  // From the client's sync reports; may trail m_lastKnownSequenceId
+
+    // Late join: the client starts from a Location snapshot instead of replaying the history
+    bool        m_awaitingSnapshot;
+    std::shared_ptr<const std::vector<uint8_t>> m_snapshot;    // nullptr until the host has taken one
+    int         m_snapshotSequenceId;       // Last sequence id the snapshot includes
+    int         m_snapshotNextPart;
+    int         m_snapshotResendTimer;      // Ticks left before every part is sent again
+    LList       <NetworkUpdate *> m_deferredRequests;           // Team requests held until the snapshot is acknowledged
+
+    // True if the command is newer than anything applied so far; it then becomes the last applied.
+    // Clients start every datagram at their oldest unacknowledged command, so a newer one always
+    // follows straight on from the last applied, whatever was lost or reordered before it.
+    bool        AcceptInput ( int _frame, int _index );
 };
 
@@ -8,7 +8,8 @@
 #include "servertoclientletter.h"
 
 
-static char s_byteStream[SERVERTOCLIENTLETTER_BYTESTREAMSIZE];
+// Per thread: letters are linearised on the server I/O thread
+static thread_local char s_byteStream[SERVERTOCLIENTLETTER_BYTESTREAMSIZE];
 
 
 
@@ -20,6 +21,8 @@ ServerToClientLetter::ServerToClientLetter()
     m_teamId(0),
     m_teamType(0),
     m_ip(0),
+    m_inputAckFrame(-1),
+    m_inputAckIndex(-1),
     m_bulkData(nullptr),
     m_bulkDataSize(0)
 {
@@ -34,6 +37,8 @@ ServerToClientLetter::ServerToClientLetter( ServerToClientLetter &copyMe )
     m_teamId(copyMe.m_teamId),
     m_teamType(copyMe.m_teamType),
     m_ip(copyMe.m_ip),
+    m_inputAckFrame(copyMe.m_inputAckFrame),
+    m_inputAckIndex(copyMe.m_inputAckIndex),
     m_bulkData(nullptr),
     m_bulkDataSize(0)
 {
@@ -65,6 +70,8 @@ ServerToClientLetter::ServerToClientLetter(char *_byteStream, [[maybe_unused]] i
 	m_teamId(0),
 	m_teamType(0),
 	m_ip(0),
+	m_inputAckFrame(-1),
+	m_inputAckIndex(-1),
 	m_bulkData(nullptr),
 	m_bulkDataSize(0)
 {
@@ -86,6 +93,8 @@ ServerToClientLetter::ServerToClientLetter(char *_byteStream, [[maybe_unused]] i
 
 	case Update:
 	{
+		m_inputAckFrame = READ_INT(_byteStream);
+		m_inputAckIndex = READ_INT(_byteStream);
 		int numUpdates = READ_INT(_byteStream);
 		DEBUG_ASSERT(numUpdates >= 0);
 
@@ -100,6 +109,7 @@ ServerToClientLetter::ServerToClientLetter(char *_byteStream, [[maybe_unused]] i
 
 	case ChunkPheromoneUpdate:
 	case ChunkPheromoneFullSync:
+	case LocationSnapshot:
 	{
 		// Bulk payload: the remaining bytes after the header are the payload.
 		m_bulkDataSize = READ_INT(_byteStream);
@@ -177,6 +187,13 @@ void ServerToClientLetter::SetIp(int ip)
     m_ip = ip;
 }
 
+// *** SetInputAck
+void ServerToClientLetter::SetInputAck(int _frame, int _index)
+{
+    m_inputAckFrame = _frame;
+    m_inputAckIndex = _index;
+}
+
 // *** AddUpdate
 void ServerToClientLetter::AddUpdate ( NetworkUpdate *_update )
 {
@@ -186,6 +203,14 @@ void ServerToClientLetter::AddUpdate ( NetworkUpdate *_update )
     m_updates.PutData( update );
 }
 
+// *** IsBulk
+bool ServerToClientLetter::IsBulk() const
+{
+    return m_type == ChunkPheromoneUpdate ||
+           m_type == ChunkPheromoneFullSync ||
+           m_type == LocationSnapshot;
+}
+
 // *** GetByteStream
 char *ServerToClientLetter::GetByteStream(int *_linearSize)
 {
@@ -209,6 +234,8 @@ char *ServerToClientLetter::GetByteStream(int *_linearSize)
 
 	case Update:
 	{
+		WRITE_INT(byteStream, m_inputAckFrame);
+		WRITE_INT(byteStream, m_inputAckIndex);
 		int numUpdates = m_updates.Size();
 		DEBUG_ASSERT(numUpdates >= 0);
 		WRITE_INT(byteStream, numUpdates);
@@ -226,6 +253,7 @@ char *ServerToClientLetter::GetByteStream(int *_linearSize)
 
 	case ChunkPheromoneUpdate:
 	case ChunkPheromoneFullSync:
+	case LocationSnapshot:
 	{
 		// Bulk payload is too large for s_byteStream.
 		// Allocate a temporary buffer: header (type + seqId + bulkSize) + payload.
@@ -22,7 +22,8 @@ public:
         TeamAssign,
         Update,
         ChunkPheromoneUpdate,    // Bulk pheromone delta for one chunk (§A.5)
-        ChunkPheromoneFullSync   // Full pheromone state for one chunk
+        ChunkPheromoneFullSync,  // Full pheromone state for one chunk
+        LocationSnapshot         // One part of a late-join snapshot of the whole Location
     };
 
     LetterType m_type;                      // If you add any new data here, remember to update the copy constructor
@@ -30,12 +31,16 @@ public:
     unsigned char m_teamType;
     int m_ip;                               // This tells you specifically which client gets the HelloClient or TeamAssign
 
+    int m_inputAckFrame;                    // Update only: the receiving client's last applied input command
+    int m_inputAckIndex;                    //   (see NetworkUpdate::GetInputKey)
+
     LList<NetworkUpdate *> m_updates;
 
     // Variable-length bulk payload for pheromone data (§A.5).
     // Heap-allocated; nullptr when unused.  Layout depends on m_type:
     //   ChunkPheromoneUpdate:   [int chunkX][int chunkZ][ushort count][PhDelta × count]
     //   ChunkPheromoneFullSync: [int chunkX][int chunkZ][raw float pairs]
+    //   LocationSnapshot:       [int snapshotSequenceId][int part][int numParts][snapshot bytes]
     char* m_bulkData;
     int   m_bulkDataSize;
 
@@ -55,12 +60,15 @@ public:
     void SetTeamId      (int teamId);
     void SetTeamType    (int teamType);
     void SetIp          (int ip);
+    void SetInputAck    (int _frame, int _index);
 
     int GetClientId();
     int GetSequenceId();
 
     void AddUpdate              ( NetworkUpdate *_update );
 
+    bool IsBulk                 () const;       // Out-of-band payload; carries no meaningful sequence id
+
 	// Writes all the current data into a sequential byte stream suitable to
 	// be stuffed into a UDP packet. Sets linearSize to be the stream length.
 	// Do NOT DELETE the returned pointer - it is part of this object.
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "DspKernels.h"
 
 //*****************************************************************************
 // Class DspEffect
@@ -16,8 +17,9 @@ public:
 
     virtual void SetParameters  ( float const *_params ) = 0;
 
-	// _data is both input and output
-    virtual void Process        ( signed short *_data, unsigned int _numSamples ) = 0;
+	// _data is both input and output, float samples on the 16 bit scale.
+	// Effects do not clamp or round; the chain does that once at the end.
+    virtual void Process        ( float *_data, unsigned int _numSamples ) = 0;
 };
 
 
@@ -28,22 +30,8 @@ public:
 class DspResLowPass : public DspEffect
 {
 protected:
-    float   m_xn1;   // storage for delayed signals
-	float   m_xn2;
-	float   m_yn1;
-	float   m_yn2;
-
-	float   m_a0;    // coefficients
-	float   m_a1;
-	float   m_a2;
-
-	float   m_b1;
-	float   m_b2;
-
-	float   m_cosOmega;
-	float   m_sinOmega;
-
-	float	m_gain;
+	Neuron::Dsp::BiquadState	m_state;	// storage for delayed signals
+	Neuron::Dsp::BiquadCoefs	m_coefs;
 
     void CalcCoefs      ( float _frequency, float _resonance, float _gain );
 
@@ -51,7 +39,7 @@ public:
 	DspResLowPass(int _sampleRate);
 
     void SetParameters  ( float const *_params );
-	void Process        ( signed short *_data, unsigned int _numSamples);
+	void Process        ( float *_data, unsigned int _numSamples);
 };
 
 
@@ -68,7 +56,7 @@ public:
     DspBitCrusher(int _sampleRate);
 
     void SetParameters  ( float const *_params );
-	void Process        ( signed short *_data, unsigned int _numSamples);
+	void Process        ( float *_data, unsigned int _numSamples);
 
 };
 
@@ -91,14 +79,11 @@ protected:
 	float				m_phase;
 	int					m_waveType;
 
-	void ProcessTriangle(signed short *_data, unsigned int _numSamples);
-	void ProcessSquare	(signed short *_data, unsigned int _numSamples);
-
 public:
 	DspGargle(int _sampleRate);
 
 	void SetParameters	(float const *_params);
-	void Process		(signed short *_data, unsigned int _numSamples);
+	void Process		(float *_data, unsigned int _numSamples);
 };
 
 
@@ -121,7 +106,7 @@ public:
 	~DspEcho();
 
 	void SetParameters	(float const *_params);
-	void Process		(signed short *_data, unsigned int _numSamples);
+	void Process		(float *_data, unsigned int _numSamples);
 };
 
 
@@ -133,18 +118,17 @@ public:
 class DspReverb : public DspEffect
 {
 protected:
-	signed short		*m_buffer;
+	float				*m_buffer;
 	unsigned int		m_bufferSize;	// In samples
 	int					m_currentBufferIndex;
 	float				m_wetDryMix;
-	int					m_delays[NUM_REVERB_DELAY_UNITS];
-	float				m_decays[NUM_REVERB_DELAY_UNITS];
+	Neuron::Dsp::ReverbTap	m_taps[NUM_REVERB_DELAY_UNITS];
 
 public:
 	DspReverb(int _sampleRate);
 	~DspReverb();
 
 	void SetParameters	(float const *_params);
-	void Process		(signed short *_data, unsigned int _numSamples);
+	void Process		(float *_data, unsigned int _numSamples);
 };
 
@@ -912,6 +912,8 @@ WorldObject* SoundInstance::GetAttachedObject()
             break;
           }
         }
+
+        g_context->m_soundSystem->ReindexSound(this);
       }
     }
 
@@ -620,16 +620,10 @@ void SoundLibrary3dDirectSound::PopulateBuffer(int _channel, int _fromSample, in
   //
   // Apply any non DirectSound filters
 
-  for (int i = DSP_RESONANTLOWPASS; i < NUM_FILTERS; ++i)
-  {
-    if (channel->m_dspFX[i].m_userFilter == nullptr)
-      continue;
-
-    if (buf1)
-      channel->m_dspFX[i].m_userFilter->Process(static_cast<signed short*>(buf1), size1 / 2);
-    if (buf2)
-      channel->m_dspFX[i].m_userFilter->Process(static_cast<signed short*>(buf2), size2 / 2);
-  }
+  if (buf1)
+    ApplyUserFilters(channel, static_cast<signed short*>(buf1), size1 / 2);
+  if (buf2)
+    ApplyUserFilters(channel, static_cast<signed short*>(buf2), size2 / 2);
 
   //
   // Unlock the buffer
@@ -644,6 +638,32 @@ void SoundLibrary3dDirectSound::PopulateBuffer(int _channel, int _fromSample, in
   channel->m_channelHealth = 1.0f - (static_cast<float>(_numSamples) / static_cast<float>(channel->m_numBufferSamples));
 }
 
+// The filters run in float one after another, and the result is rounded to
+// 16 bits once at the end
+void SoundLibrary3dDirectSound::ApplyUserFilters(DirectSoundChannel* _channel, signed short* _data, unsigned int _numSamples)
+{
+  bool anyFilters = false;
+  for (int i = DSP_RESONANTLOWPASS; i < NUM_FILTERS; ++i)
+    anyFilters |= _channel->m_dspFX[i].m_userFilter != nullptr;
+  if (!anyFilters)
+    return;
+
+  START_PROFILE(g_context->m_profiler, "UserFilters");
+
+  m_dspBlock.resize(_numSamples);
+  Neuron::Dsp::FromShort(_data, m_dspBlock.data(), _numSamples);
+
+  for (int i = DSP_RESONANTLOWPASS; i < NUM_FILTERS; ++i)
+  {
+    if (_channel->m_dspFX[i].m_userFilter)
+      _channel->m_dspFX[i].m_userFilter->Process(m_dspBlock.data(), _numSamples);
+  }
+
+  Neuron::Dsp::ToShort(m_dspBlock.data(), _data, _numSamples);
+
+  END_PROFILE(g_context->m_profiler, "UserFilters");
+}
+
 long SoundLibrary3dDirectSound::CalcWrappedDelta(long a, long b, unsigned long bufferSize)
 {
   long delta = b - a;
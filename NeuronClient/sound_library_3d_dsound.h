@@ -19,12 +19,14 @@ protected:
     DirectSoundChannel  *m_channels;
 	DirectSoundChannel	*m_musicChannel;
 	DirectSoundData		*m_directSound;
+	std::vector<float>	m_dspBlock;		// Float samples for the user filter chain
 
 protected:
 	IDirectSoundBuffer *CreateSecondaryBuffer(int _numSamples);
     void RefreshCapabilities();
 	long CalcWrappedDelta	(long a, long b, unsigned long bufferSize);
     void PopulateBuffer		(int _channel, int _fromSample, int _numSamples, bool _isMusic);
+	void ApplyUserFilters	(DirectSoundChannel *_channel, signed short *_data, unsigned int _numSamples);
     void CommitChanges      ();					// Commits all pos/or/vel etc changes
 	void AdvanceChannel		(int _channel, int _frameNum);
 	int  GetNumFilters		(int _channel);
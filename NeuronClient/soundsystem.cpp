@@ -621,27 +621,28 @@ void SoundSystem::ParseSampleGroup(TextReader* _in, SampleGroup* _group)
 bool SoundSystem::InitialiseSound(SoundInstance* _instance)
 {
   bool createNewSound = true;
+  int eventKey = GetEventKey(_instance->m_eventName, true);
 
   if (_instance->m_instanceType != SoundInstance::Polyphonic)
   {
     // This is a monophonic sound, so look for an exisiting
-    // instance of the same sound
-    for (int i = 0; i < m_sounds.Size(); ++i)
+    // instance of the same sound (the first, as a scan would find)
+    int existing = -1;
+    m_soundsByEvent.ForEach(eventKey, [&](int _slot)
     {
-      if (m_sounds.ValidIndex(i))
+      if (m_sounds[_slot]->m_instanceType != SoundInstance::Polyphonic && (existing == -1 || _slot < existing))
+        existing = _slot;
+    });
+
+    if (existing != -1)
+    {
+      SoundInstance* thisInstance = m_sounds[existing];
+      for (int j = 0; j < _instance->m_objIds.Size(); ++j)
       {
-        SoundInstance* thisInstance = m_sounds[i];
-        if (thisInstance->m_instanceType != SoundInstance::Polyphonic && _stricmp(thisInstance->m_eventName, _instance->m_eventName) == 0)
-        {
-          for (int j = 0; j < _instance->m_objIds.Size(); ++j)
-          {
-            WorldObjectId* id = _instance->m_objIds[j];
-            thisInstance->m_objIds.PutData(new WorldObjectId(*id));
-          }
-          createNewSound = false;
-          break;
-        }
+        WorldObjectId* id = _instance->m_objIds[j];
+        thisInstance->m_objIds.PutData(new WorldObjectId(*id));
       }
+      createNewSound = false;
     }
   }
 
@@ -650,6 +651,9 @@ bool SoundSystem::InitialiseSound(SoundInstance* _instance)
     _instance->m_id.m_index = m_sounds.PutData(_instance);
     _instance->m_id.m_uniqueId = SoundInstanceId::GenerateUniqueId();
     _instance->m_restartAttempts = 3; //int( 1.0f + (float) _instance->m_volume.GetOutput() / 5.0f );
+    m_soundsByObject.Insert(_instance->m_id.m_index, _instance->m_objId);
+    m_soundsByEvent.Insert(_instance->m_id.m_index, eventKey);
+    m_voiceOrder.Add(_instance->m_id);
     return true;
   }
   return false;
@@ -694,12 +698,31 @@ int SoundSystem::FindBestAvailableChannel()
 void SoundSystem::ShutdownSound(SoundInstance* _instance)
 {
   if (m_sounds.ValidIndex(_instance->m_id.m_index))
+  {
     m_sounds.MarkNotUsed(_instance->m_id.m_index);
+    m_soundsByObject.Remove(_instance->m_id.m_index);
+    m_soundsByEvent.Remove(_instance->m_id.m_index);
+  }
 
   _instance->StopPlaying();
   delete _instance;
 }
 
+void SoundSystem::ReindexSound(SoundInstance* _instance)
+{
+  int slot = _instance->m_id.m_index;
+  if (m_sounds.ValidIndex(slot) && m_sounds[slot] == _instance)
+    m_soundsByObject.Move(slot, _instance->m_objId);
+}
+
+int SoundSystem::GetEventKey(const char* _eventName, bool _create)
+{
+  if (!_create)
+    return m_eventKeys.Get(_eventName, -1);
+
+  return *m_eventKeys.TryEmplace(_eventName, m_eventKeys.Count()).first;
+}
+
 SoundInstance* SoundSystem::GetSoundInstance(SoundInstanceId id)
 {
   if (!m_sounds.ValidIndex(id.m_index))
@@ -859,24 +882,21 @@ void SoundSystem::StopAllSounds(WorldObjectId _id, const char* _eventName)
   }
   else
   {
-    for (int i = 0; i < m_sounds.Size(); ++i)
+    int eventKey = _eventName ? GetEventKey(_eventName, false) : -1;
+    if (_eventName && eventKey == -1)
+      return;
+
+    m_soundsByObject.ForEach(_id, [&](int _slot)
     {
-      if (m_sounds.ValidIndex(i))
+      SoundInstance* instance = m_sounds[_slot];
+      if (!_eventName || m_soundsByEvent.GetKey(_slot) == eventKey)
       {
-        SoundInstance* instance = m_sounds[i];
-
-        if (instance->m_objId == _id)
-        {
-          if (!_eventName || _stricmp(instance->m_eventName, _eventName) == 0)
-          {
-            if (instance->IsPlaying())
-              instance->BeginRelease(true);
-            else
-              ShutdownSound(instance);
-          }
-        }
+        if (instance->IsPlaying())
+          instance->BeginRelease(true);
+        else
+          ShutdownSound(instance);
       }
-    }
+    });
   }
 }
 
@@ -894,15 +914,21 @@ int SoundSystem::IsSoundPlaying(SoundInstanceId _id)
 
 int SoundSystem::NumInstancesPlaying(WorldObjectId _id, const char* _eventName)
 {
+  int eventKey = GetEventKey(_eventName, false);
+  if (eventKey == -1)
+    return 0;
+
   int result = 0;
 
   for (int i = 0; i < m_numChannels; ++i)
   {
     SoundInstanceId soundId = m_channels[i];
     SoundInstance* instance = GetSoundInstance(soundId);
-    bool instanceMatch = !_id.IsValid() || instance->m_objId == _id;
+    if (!instance)
+      continue;
 
-    if (instance && instanceMatch && _stricmp(instance->m_eventName, _eventName) == 0)
+    bool instanceMatch = !_id.IsValid() || instance->m_objId == _id;
+    if (instanceMatch && m_soundsByEvent.GetKey(soundId.m_index) == eventKey)
       ++result;
   }
 
@@ -911,19 +937,19 @@ int SoundSystem::NumInstancesPlaying(WorldObjectId _id, const char* _eventName)
 
 int SoundSystem::NumInstances(WorldObjectId _id, const char* _eventName)
 {
-  int result = 0;
+  int eventKey = GetEventKey(_eventName, false);
+  if (eventKey == -1)
+    return 0;
 
-  for (int i = 0; i < m_sounds.Size(); ++i)
-  {
-    if (m_sounds.ValidIndex(i))
-    {
-      SoundInstance* instance = m_sounds[i];
-      bool instanceMatch = !_id.IsValid() || instance->m_objId == _id;
+  if (!_id.IsValid())
+    return m_soundsByEvent.Count(eventKey);
 
-      if (instance && instanceMatch && _stricmp(instance->m_eventName, _eventName) == 0)
-        ++result;
-    }
-  }
+  int result = 0;
+  m_soundsByObject.ForEach(_id, [&](int _slot)
+  {
+    if (m_soundsByEvent.GetKey(_slot) == eventKey)
+      ++result;
+  });
 
   return result;
 }
@@ -945,24 +971,6 @@ int SoundSystem::NumChannelsUsed()
 
 int SoundSystem::NumSoundsDiscarded() { return NumSoundInstances() - NumChannelsUsed(); }
 
-int SoundInstanceCompare(const void* elem1, const void* elem2)
-{
-  SoundInstanceId id1 = *((SoundInstanceId*)elem1);
-  SoundInstanceId id2 = *((SoundInstanceId*)elem2);
-
-  SoundInstance* instance1 = g_context->m_soundSystem->GetSoundInstance(id1);
-  SoundInstance* instance2 = g_context->m_soundSystem->GetSoundInstance(id2);
-
-  DEBUG_ASSERT(instance1);
-  DEBUG_ASSERT(instance2);
-
-  if (instance1->m_perceivedVolume < instance2->m_perceivedVolume)
-    return +1;
-  if (instance1->m_perceivedVolume > instance2->m_perceivedVolume)
-    return -1;
-  return 0;
-}
-
 void SoundSystem::Advance()
 {
   if (!m_channels)
@@ -1016,22 +1024,6 @@ void SoundSystem::Advance()
     //
     // First pass : Recalculate all Perceived Sound Volumes
     // Throw away sounds that have had their chance
-    // Build a list of instanceIDs for sorting
-
-    START_PROFILE(g_context->m_profiler, "Allocate Sorted Array");
-    static int sortedArraySize = 128;
-    static SoundInstanceId* sortedIds = nullptr;
-    if (m_sounds.NumUsed() > sortedArraySize)
-    {
-      delete [] sortedIds;
-      sortedIds = nullptr;
-      while (sortedArraySize < m_sounds.NumUsed()) { sortedArraySize *= 2; }
-    }
-    if (!sortedIds)
-      sortedIds = new SoundInstanceId[sortedArraySize];
-
-    int numSortedIds = 0;
-    END_PROFILE(g_context->m_profiler, "Allocate Sorted Array");
 
     START_PROFILE(g_context->m_profiler, "Perceived Volumes");
     for (int i = 0; i < m_sounds.Size(); ++i)
@@ -1046,29 +1038,25 @@ void SoundSystem::Advance()
         else if (instance->m_positionType == SoundInstance::Type3DAttachedToObject && !instance->GetAttachedObject())
           ShutdownSound(instance);
         else
-        {
           instance->CalculatePerceivedVolume();
-          sortedIds[numSortedIds] = instance->m_id;
-          numSortedIds++;
-        }
       }
     }
     END_PROFILE(g_context->m_profiler, "Perceived Volumes");
 
     //
     // Sort sounds into perceived volume order
-    // NOTE : There are exactly numSortedId elements in sortedIds.
-    // NOTE : It isn't safe to assume numSortedIds == m_sounds.NumUsed()
+    // The order is kept from the last update, which it is usually close to
 
     START_PROFILE(g_context->m_profiler, "Sort Samples");
-    qsort(sortedIds, numSortedIds, sizeof(SoundInstanceId), SoundInstanceCompare);
+    m_voiceOrder.Update([this](const SoundInstanceId& _id) { return GetSoundInstance(_id) != nullptr; },
+                        [this](const SoundInstanceId& _id) { return GetSoundInstance(_id)->m_perceivedVolume; });
     END_PROFILE(g_context->m_profiler, "Sort Samples");
 
     //
     // Second pass : Recalculate all Sound Priorities starting with the nearest sounds
     // Reduce priorities as more of the same sounds are played
 
-    BTree<float> existingInstances;
+    m_eventDerate.assign(m_eventKeys.Count(), 1.0f);
 
     //
     // Also look out for the highest priority new sound to swap in
@@ -1078,22 +1066,14 @@ void SoundSystem::Advance()
     SoundInstance* newInstance = nullptr;
     float highestInstancePriority = 0.0f;
 
-    for (int i = 0; i < numSortedIds; ++i)
+    for (const auto& voice : m_voiceOrder.GetVoices())
     {
-      SoundInstanceId id = sortedIds[i];
-      SoundInstance* instance = GetSoundInstance(id);
+      SoundInstance* instance = GetSoundInstance(voice.m_id);
       DEBUG_ASSERT(instance);
 
-      instance->m_calculatedPriority = instance->m_perceivedVolume;
-
-      BTree<float>* existingInstance = existingInstances.LookupTree(instance->m_eventName);
-      if (existingInstance)
-      {
-        instance->m_calculatedPriority *= existingInstance->data;
-        existingInstance->data *= 0.75f;
-      }
-      else
-        existingInstances.PutData(instance->m_eventName, 0.75f);
+      float& derate = m_eventDerate[m_soundsByEvent.GetKey(voice.m_id.m_index)];
+      instance->m_calculatedPriority = instance->m_perceivedVolume * derate;
+      derate *= 0.75f;
 
       if (!instance->IsPlaying() && instance->m_calculatedPriority > highestInstancePriority)
       {
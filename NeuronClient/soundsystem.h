@@ -4,6 +4,8 @@
 #include "llist.h"
 #include "LegacyVector3.h"
 #include "sound_instance.h"
+#include "StringMap.h"
+#include "VoiceScheduler.h"
 #include "worldobject.h"
 
 class Entity;
@@ -102,6 +104,18 @@ class SampleGroup
 // Class SoundSystem
 //*****************************************************************************
 
+struct WorldObjectIdHash
+{
+  size_t operator()(const WorldObjectId& _id) const
+  {
+    size_t hash = _id.GetTeamId();
+    hash = hash * 1000003 + static_cast<size_t>(_id.GetUnitId());
+    hash = hash * 1000003 + static_cast<size_t>(_id.GetIndex());
+    hash = hash * 1000003 + static_cast<size_t>(_id.GetUniqueId());
+    return hash;
+  }
+};
+
 class SoundSystem
 {
   public:
@@ -139,6 +153,18 @@ class SoundSystem
     DArray<SampleGroup*> m_sampleGroups;
 
   protected:
+    // Every m_sounds slot is filed under its instance's m_objId and event,
+    // so the per-object and per-event queries need not scan m_sounds.
+    // Events are keyed by a small int per name, case ignored.
+    Neuron::SlotIndex<WorldObjectId, WorldObjectIdHash> m_soundsByObject;
+    Neuron::SlotIndex<int> m_soundsByEvent;
+    Neuron::StringMap<int> m_eventKeys;
+
+    Neuron::VoiceOrder<SoundInstanceId> m_voiceOrder; // Loudest first, kept between updates
+    std::vector<float> m_eventDerate; // Advance scratch, by event key
+
+    int GetEventKey(const char* _eventName, bool _create); // -1 if not _create and never seen
+
     void ParseSoundEvent(TextReader* _in, SoundSourceBlueprint* _source, const char* _entityName);
     void ParseSoundEffect(TextReader* _in, SoundEventBlueprint* _blueprint);
     void ParseSampleGroup(TextReader* _in, SampleGroup* _group);
@@ -162,6 +188,7 @@ class SoundSystem
 
     bool InitialiseSound(SoundInstance* _instance); // Sets up sound, adds to instance list
     void ShutdownSound(SoundInstance* _instance); // Stops / deletes sound + removes refs
+    void ReindexSound(SoundInstance* _instance); // Call after changing _instance->m_objId
 
     int IsSoundPlaying(SoundInstanceId _id);
     int NumInstancesPlaying(WorldObjectId _id, const char* _eventName);
@@ -0,0 +1,64 @@
+#pragma once
+
+
+#include <float.h>
+
+#include "LegacyVector3.h"
+#include "PolylineGrid.h"
+#include "math_utils.h"
+#include "vector2.h"
+
+
+// ****************************************************************************
+// Class WayPointGrid
+// The resolved positions of a route's waypoints and a grid over them, for the
+// nearest waypoint and nearest edge searches on long routes.  Both give what
+// a scan of every waypoint would: the smallest distance, and of equals the
+// lowest id.  Call Build after changing m_pos.
+// ****************************************************************************
+
+class WayPointGrid
+{
+protected:
+	Neuron::PolylineGrid		m_grid;
+
+public:
+	std::vector<LegacyVector3>	m_pos;
+
+	void Build()
+	{
+		m_grid.Build(static_cast<int>(m_pos.size()), [this](int _id) -> LegacyVector3 const & { return m_pos[_id]; });
+	}
+
+	int GetIdOfNearestWayPoint(LegacyVector3 const &_pos) const
+	{
+		return m_grid.NearestPoint(_pos.x, _pos.z, [&](int _id)
+		{
+			LegacyVector3 delta = _pos - m_pos[_id];
+			return delta.MagSquared();
+		});
+	}
+
+	// Returns the id of the first waypoint of the nearest edge, and the
+	// distance to it in _dist if asked
+	int GetIdOfNearestEdge(LegacyVector3 const &_pos, float *_dist) const
+	{
+		Vector2 pos(_pos.x, _pos.z);
+		float distToNearest = FLT_MAX;
+		int idOfNearest = m_grid.NearestSegment(_pos.x, _pos.z, [&](int _id)
+		{
+			Vector2 start(m_pos[_id].x, m_pos[_id].z);
+			Vector2 end(m_pos[_id + 1].x, m_pos[_id + 1].z);
+			float dist = PointSegDist2D(pos, start, end);
+			distToNearest = std::min(distToNearest, dist);
+			return dist;
+		});
+
+		if (_dist && idOfNearest != -1)
+		{
+			*_dist = distToNearest;
+		}
+
+		return idOfNearest;
+	}
+};
@@ -0,0 +1,207 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // Mirrors the layout of a bit-packed NetworkUpdate::Alive: team id,
+    // quantised position, TeamControls flags.
+    constexpr float WORLD_SIZE = 4000.0f;
+
+    void PackAlive(BitWriter& _writer, int _teamId, float _x, float _y, float _z, unsigned int _flags)
+    {
+        _writer.WriteBool(true);
+        _writer.WriteBits(4, 4);
+        _writer.WriteBits(_teamId, 8);
+        _writer.WriteBool(true);
+        _writer.WriteQuantised(_x, 0.0f, WORLD_SIZE, 16);
+        _writer.WriteVarInt(static_cast<int>(std::floor(_y * 8.0f + 0.5f)));
+        _writer.WriteQuantised(_z, 0.0f, WORLD_SIZE, 16);
+        _writer.WriteBits(_flags, 9);
+    }
+
+    // Legacy fixed layout: type, lastSequenceId, teamId, 3 floats, flags, sync
+    constexpr int LEGACY_ALIVE_BYTES = 4 + 4 + 1 + 12 + 2 + 1;
+}
+
+TEST_CLASS(BitStreamTests)
+{
+public:
+
+    // --- Round trips --------------------------------------------------------
+
+    TEST_METHOD(Bits_RoundTrip_AcrossByteBoundaries)
+    {
+        char buffer[32];
+        BitWriter writer(buffer, sizeof(buffer));
+        writer.WriteBits(0x5, 3);
+        writer.WriteBits(0x1ABCD, 17);
+        writer.WriteBits(0xFFFFFFFF, 32);
+        writer.WriteBool(true);
+
+        BitReader reader(buffer, writer.BytesWritten());
+        Assert::AreEqual(0x5u, reader.ReadBits(3));
+        Assert::AreEqual(0x1ABCDu, reader.ReadBits(17));
+        Assert::AreEqual(0xFFFFFFFFu, reader.ReadBits(32));
+        Assert::IsTrue(reader.ReadBool());
+        Assert::IsFalse(reader.Overflowed());
+    }
+
+    TEST_METHOD(VarInt_RoundTrip_CoversRange)
+    {
+        const int32_t values[] = {0, 1, -1, 63, -64, 127, 128, -129, 100000, INT32_MAX, INT32_MIN};
+        char buffer[128];
+        BitWriter writer(buffer, sizeof(buffer));
+        for (int32_t v : values)
+            writer.WriteVarInt(v);
+
+        BitReader reader(buffer, writer.BytesWritten());
+        for (int32_t v : values)
+            Assert::AreEqual(v, reader.ReadVarInt());
+        Assert::IsFalse(reader.Overflowed());
+    }
+
+    TEST_METHOD(VarUInt_SmallValue_IsOneByte)
+    {
+        char buffer[8];
+        BitWriter writer(buffer, sizeof(buffer));
+        writer.WriteVarUInt(127);
+        Assert::AreEqual(1, writer.BytesWritten());
+    }
+
+    TEST_METHOD(UInt64_And_Float_RoundTrip)
+    {
+        char buffer[16];
+        BitWriter writer(buffer, sizeof(buffer));
+        writer.WriteBool(false);
+        writer.WriteUInt64(0x0123456789ABCDEFULL);
+        writer.WriteFloat(-3.25f);
+
+        BitReader reader(buffer, writer.BytesWritten());
+        Assert::IsFalse(reader.ReadBool());
+        Assert::AreEqual(0x0123456789ABCDEFULL, reader.ReadUInt64());
+        Assert::AreEqual(-3.25f, reader.ReadFloat());
+    }
+
+    TEST_METHOD(Quantised_ErrorWithinHalfStep)
+    {
+        char buffer[4];
+        const float step = WORLD_SIZE / 65535.0f;
+        for (float v = 0.0f; v <= WORLD_SIZE; v += 37.3f)
+        {
+            BitWriter writer(buffer, sizeof(buffer));
+            writer.WriteQuantised(v, 0.0f, WORLD_SIZE, 16);
+            BitReader reader(buffer, writer.BytesWritten());
+            Assert::AreEqual(v, reader.ReadQuantised(0.0f, WORLD_SIZE, 16), step * 0.5f + 1e-3f);
+        }
+    }
+
+    // --- Bounds -------------------------------------------------------------
+
+    TEST_METHOD(Writer_Overflow_IsReported)
+    {
+        char buffer[2];
+        BitWriter writer(buffer, sizeof(buffer));
+        writer.WriteBits(0xFF, 8);
+        writer.WriteBits(0xFF, 9);
+        Assert::IsTrue(writer.Overflowed());
+        Assert::AreEqual(8, writer.GetBitPosition());
+    }
+
+    TEST_METHOD(Writer_Rewind_ClearsDiscardedBits)
+    {
+        char buffer[4];
+        BitWriter writer(buffer, sizeof(buffer));
+        writer.WriteBits(0x3, 2);
+        int mark = writer.GetBitPosition();
+        writer.WriteBits(0xFFFFFF, 24);
+        writer.Rewind(mark);
+        writer.WriteBits(0x0, 6);
+
+        BitReader reader(buffer, sizeof(buffer));
+        Assert::AreEqual(0x3u, reader.ReadBits(8));
+        Assert::AreEqual(0u, reader.ReadBits(24));
+    }
+
+    TEST_METHOD(Reader_Overrun_ReturnsZero)
+    {
+        char buffer[1] = {0x7F};
+        BitReader reader(buffer, sizeof(buffer));
+        reader.ReadBits(6);
+        Assert::AreEqual(0u, reader.ReadBits(4));
+        Assert::IsTrue(reader.Overflowed());
+    }
+
+    // --- Size and throughput ------------------------------------------------
+
+    TEST_METHOD(AliveUpdate_PackedIsSmallerThanLegacy)
+    {
+        char buffer[64];
+        BitWriter writer(buffer, sizeof(buffer));
+        PackAlive(writer, 2, 1234.5f, 87.25f, 3021.0f, 0x105);
+        Assert::IsTrue(writer.BytesWritten() * 2 < LEGACY_ALIVE_BYTES);
+    }
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_PackUnpackAliveBatches)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_PackUnpackAliveBatches)
+    {
+        constexpr int ITERATIONS = 20000;
+        constexpr int DATAGRAM_SIZE = 512;
+        char datagram[DATAGRAM_SIZE];
+
+        int updatesPerDatagram = 0;
+        int bytesPerDatagram = 0;
+        uint32_t checksum = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            BitWriter writer(datagram, DATAGRAM_SIZE);
+            writer.WriteBits(1, 8);
+            writer.WriteVarUInt(static_cast<uint32_t>(i));
+
+            int packed = 0;
+            for (;;)
+            {
+                int mark = writer.GetBitPosition();
+                PackAlive(writer, packed & 3, static_cast<float>(packed * 13 % 4000), 40.0f, 1000.0f, packed & 0x1FF);
+                if (writer.Overflowed() || writer.GetBitPosition() + 1 > DATAGRAM_SIZE * 8)
+                {
+                    writer.Rewind(mark);
+                    break;
+                }
+                ++packed;
+            }
+            writer.WriteBool(false);
+
+            BitReader reader(datagram, writer.BytesWritten());
+            reader.ReadBits(8);
+            reader.ReadVarUInt();
+            while (reader.ReadBool())
+            {
+                reader.ReadBits(4);
+                checksum += reader.ReadBits(8);
+                reader.ReadBool();
+                checksum += reader.ReadBits(16);
+                checksum += static_cast<uint32_t>(reader.ReadVarInt());
+                checksum += reader.ReadBits(16);
+                checksum += reader.ReadBits(9);
+            }
+
+            updatesPerDatagram = packed;
+            bytesPerDatagram = writer.BytesWritten();
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        Assert::IsTrue(updatesPerDatagram > 0);
+        Assert::IsTrue(checksum != 0);
+
+        double updatesPerSecond = static_cast<double>(ITERATIONS) * updatesPerDatagram / elapsed;
+        Logger::WriteMessage(std::format("Alive: {} bytes packed vs {} legacy, {} updates per {}-byte datagram, {:.1f} M updates/s round trip\n",
+            static_cast<double>(bytesPerDatagram) / updatesPerDatagram, LEGACY_ALIVE_BYTES, updatesPerDatagram, bytesPerDatagram,
+            updatesPerSecond / 1.0e6).c_str());
+    }
+};
@@ -0,0 +1,318 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    CellRect RandomRect(Lcg& _rng)
+    {
+        CellRect rect;
+        rect.m_minX = static_cast<int>(_rng.Next() % 12);
+        rect.m_minZ = static_cast<int>(_rng.Next() % 12);
+        rect.m_maxX = rect.m_minX + static_cast<int>(_rng.Next() % 6) - 1;
+        rect.m_maxZ = rect.m_minZ + static_cast<int>(_rng.Next() % 6) - 1;
+        return rect;
+    }
+
+    // Stands in for WorldObjectId, with what IdGridCell asks of it
+    struct TestId
+    {
+        int m_id = -1;
+
+        [[nodiscard]] bool operator==(const TestId& _other) const { return m_id == _other.m_id; }
+        void SetInvalid() { m_id = -1; }
+    };
+
+    struct UpdateStats
+    {
+        int64_t m_updates = 0;
+        int64_t m_unchanged = 0;
+        int64_t m_cellsEntered = 0;
+        int64_t m_cellsLeft = 0;
+        int64_t m_cellsTouched = 0;
+    };
+
+    // One team of EntityGrid: its cells, its GetCellRect, and UpdateObject for
+    // a radius before and after
+    class Grid
+    {
+    public:
+        Grid(int _numCells, float _cellSize)
+            : m_numCells(_numCells), m_cellSizeRecip(1.0f / _cellSize)
+        {
+            m_cells.Initialise(_numCells, _numCells);
+        }
+
+        CellRect GetCellRect(float _x, float _z, float _radius) const
+        {
+            CellRect rect;
+            rect.m_minX = std::max(0, static_cast<int>((_x - _radius / 2) * m_cellSizeRecip));
+            rect.m_maxX = std::min(m_numCells - 1, static_cast<int>((_x + _radius / 2) * m_cellSizeRecip));
+            rect.m_minZ = std::max(0, static_cast<int>((_z - _radius / 2) * m_cellSizeRecip));
+            rect.m_maxZ = std::min(m_numCells - 1, static_cast<int>((_z + _radius / 2) * m_cellSizeRecip));
+            return rect;
+        }
+
+        void Add(int _id, float _x, float _z, float _radius)
+        {
+            const CellRect cells = GetCellRect(_x, _z, _radius);
+            m_cells.AddId({_id}, cells);
+            m_stats.m_cellsTouched += cells.Count();
+        }
+
+        void Remove(int _id, float _x, float _z, float _radius)
+        {
+            const CellRect cells = GetCellRect(_x, _z, _radius);
+            m_cells.RemoveId({_id}, cells, [](int, int) { Assert::Fail(L"Id missing from a cell"); });
+            m_stats.m_cellsTouched += cells.Count();
+        }
+
+        // As EntityGrid::UpdateObject was for a radius: out of every cell and back in
+        void UpdateLegacy(int _id, float _oldX, float _oldZ, float _newX, float _newZ, float _radius)
+        {
+            ++m_stats.m_updates;
+            Remove(_id, _oldX, _oldZ, _radius);
+            Add(_id, _newX, _newZ, _radius);
+        }
+
+        void Update(int _id, float _oldX, float _oldZ, float _newX, float _newZ, float _radius)
+        {
+            ++m_stats.m_updates;
+            const CellRect oldCells = GetCellRect(_oldX, _oldZ, _radius);
+            const CellRect newCells = GetCellRect(_newX, _newZ, _radius);
+            if (oldCells == newCells)
+            {
+                ++m_stats.m_unchanged;
+                return;
+            }
+
+            const auto moves = m_cells.MoveId({_id}, oldCells, newCells, [](int, int) { Assert::Fail(L"Id missing from a cell"); });
+            m_stats.m_cellsLeft += moves.m_cellsLeft;
+            m_stats.m_cellsEntered += moves.m_cellsEntered;
+            m_stats.m_cellsTouched += moves.m_cellsLeft + moves.m_cellsEntered;
+        }
+
+        // Every slot and free list the same
+        [[nodiscard]] bool operator==(const Grid& _other) const
+        {
+            for (int z = 0; z < m_numCells; ++z)
+            {
+                for (int x = 0; x < m_numCells; ++x)
+                {
+                    const IdGridCell<TestId>& a = m_cells.GetCell(x, z);
+                    const IdGridCell<TestId>& b = _other.m_cells.GetCell(x, z);
+                    if (a.m_arraySize != b.m_arraySize || a.m_firstFree != b.m_firstFree || a.m_numSlotsFree != b.m_numSlotsFree)
+                        return false;
+                    for (int i = 0; i < a.m_arraySize; ++i)
+                    {
+                        if (!(a.m_objectIds[i] == b.m_objectIds[i]) || a.m_usageLists[i] != b.m_usageLists[i])
+                            return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        UpdateStats m_stats;
+
+    private:
+        IdCellGrid<TestId> m_cells;
+        int m_numCells;
+        float m_cellSizeRecip;
+    };
+
+    struct Mover
+    {
+        float m_x, m_z;
+        float m_radius;
+        float m_speed;
+        float m_heading;
+    };
+
+    // Moves one object a tick: most wander, some stand still
+    void Step(Lcg& _rng, Mover& _mover, float _worldSize)
+    {
+        if (_mover.m_speed == 0.0f)
+            return;
+        _mover.m_heading += _rng.Range(-0.3f, 0.3f);
+        _mover.m_x = std::clamp(_mover.m_x + std::cos(_mover.m_heading) * _mover.m_speed, 0.0f, _worldSize);
+        _mover.m_z = std::clamp(_mover.m_z + std::sin(_mover.m_heading) * _mover.m_speed, 0.0f, _worldSize);
+    }
+}
+
+TEST_CLASS(CellRectTests)
+{
+public:
+
+    // --- Rectangles ---------------------------------------------------------
+
+    TEST_METHOD(Equality_TreatsAllEmptyRectsAlike)
+    {
+        Assert::IsTrue(CellRect{} == CellRect{5, 5, 2, 9});
+        Assert::IsFalse(CellRect{} == CellRect{1, 1, 1, 1});
+        Assert::IsTrue(CellRect{1, 2, 3, 4} == CellRect{1, 2, 3, 4});
+        Assert::AreEqual(0, CellRect{}.Count());
+        Assert::AreEqual(6, CellRect{1, 2, 3, 3}.Count());
+    }
+
+    TEST_METHOD(ForEachCellNotIn_IsTheSetDifference)
+    {
+        Lcg rng(23);
+        for (int trial = 0; trial < 20000; ++trial)
+        {
+            const CellRect a = RandomRect(rng);
+            const CellRect b = RandomRect(rng);
+
+            std::vector<std::pair<int, int>> expected;
+            for (int x = a.m_minX; x <= a.m_maxX; ++x)
+            {
+                for (int z = a.m_minZ; z <= a.m_maxZ; ++z)
+                {
+                    if (!b.Contains(x, z))
+                        expected.emplace_back(x, z);
+                }
+            }
+
+            std::vector<std::pair<int, int>> visited;
+            a.ForEachCellNotIn(b, [&](int _x, int _z) { visited.emplace_back(_x, _z); });
+            std::ranges::sort(visited);
+            Assert::IsTrue(expected == visited);
+        }
+    }
+
+    // --- Against the full update ----------------------------------------------
+
+    TEST_METHOD(IncrementalUpdate_LeavesCellsAsAFullUpdateDoes)
+    {
+        // Every slot and free list the same, so neighbour queries return the
+        // same ids in the same order
+        constexpr int NUM_CELLS = 24;
+        constexpr float CELL_SIZE = 8.0f;
+        constexpr float WORLD = NUM_CELLS * CELL_SIZE;
+
+        Lcg rng(41);
+        std::vector<Mover> movers;
+        for (int i = 0; i < 400; ++i)
+        {
+            const float radius = (i % 5 == 0) ? rng.Range(8.0f, 40.0f) : 4.0f;
+            const float speed = (i % 3 == 0) ? 0.0f : rng.Range(0.2f, 6.0f);
+            movers.push_back({rng.Range(0.0f, WORLD), rng.Range(0.0f, WORLD), radius, speed, rng.Range(0.0f, 6.3f)});
+        }
+
+        Grid legacy(NUM_CELLS, CELL_SIZE);
+        Grid incremental(NUM_CELLS, CELL_SIZE);
+        for (int i = 0; i < static_cast<int>(movers.size()); ++i)
+        {
+            legacy.Add(i, movers[i].m_x, movers[i].m_z, movers[i].m_radius);
+            incremental.Add(i, movers[i].m_x, movers[i].m_z, movers[i].m_radius);
+        }
+
+        for (int tick = 0; tick < 300; ++tick)
+        {
+            for (int i = 0; i < static_cast<int>(movers.size()); ++i)
+            {
+                Mover& mover = movers[i];
+                const float oldX = mover.m_x, oldZ = mover.m_z;
+                Step(rng, mover, WORLD);
+                legacy.UpdateLegacy(i, oldX, oldZ, mover.m_x, mover.m_z, mover.m_radius);
+                incremental.Update(i, oldX, oldZ, mover.m_x, mover.m_z, mover.m_radius);
+            }
+
+            // Deaths and births now and then, which reuse freed slots
+            if (tick % 10 == 0)
+            {
+                const int i = static_cast<int>(rng.Next() % movers.size());
+                legacy.Remove(i, movers[i].m_x, movers[i].m_z, movers[i].m_radius);
+                incremental.Remove(i, movers[i].m_x, movers[i].m_z, movers[i].m_radius);
+                movers[i].m_x = rng.Range(0.0f, WORLD);
+                movers[i].m_z = rng.Range(0.0f, WORLD);
+                legacy.Add(i, movers[i].m_x, movers[i].m_z, movers[i].m_radius);
+                incremental.Add(i, movers[i].m_x, movers[i].m_z, movers[i].m_radius);
+            }
+
+            Assert::IsTrue(legacy == incremental);
+        }
+
+        Assert::IsTrue(incremental.m_stats.m_unchanged > 0);
+        Assert::IsTrue(incremental.m_stats.m_cellsTouched < legacy.m_stats.m_cellsTouched);
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_BusyLevel)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_BusyLevel)
+    {
+        // A level's entity grid (8 unit cells) with thousands of Darwinians of
+        // radius 4, some standing about, and a few hundred bigger entities.
+        // Every one is updated every tick, as Team::Advance does.
+        constexpr int NUM_CELLS = 256;
+        constexpr float CELL_SIZE = 8.0f;
+        constexpr float WORLD = NUM_CELLS * CELL_SIZE;
+        constexpr int TICKS = 100;
+
+        std::vector<Mover> movers;
+        Lcg setup(7);
+        for (int i = 0; i < 6000; ++i)
+        {
+            const bool big = i % 20 == 0;
+            const float radius = big ? setup.Range(10.0f, 40.0f) : 4.0f;
+            const float speed = (i % 4 == 0) ? 0.0f : setup.Range(0.5f, big ? 4.0f : 2.0f);
+            movers.push_back({setup.Range(0.0f, WORLD), setup.Range(0.0f, WORLD), radius, speed, setup.Range(0.0f, 6.3f)});
+        }
+
+        // Every tick's positions up front, so only the grid is timed
+        const int numMovers = static_cast<int>(movers.size());
+        std::vector<Mover> paths;
+        paths.reserve(static_cast<size_t>(numMovers) * (TICKS + 1));
+        paths.insert(paths.end(), movers.begin(), movers.end());
+        Lcg rng(99);
+        for (int tick = 0; tick < TICKS; ++tick)
+        {
+            for (int i = 0; i < numMovers; ++i)
+            {
+                Mover mover = paths[static_cast<size_t>(tick) * numMovers + i];
+                Step(rng, mover, WORLD);
+                paths.push_back(mover);
+            }
+        }
+
+        const auto run = [&](bool _incremental, Grid& _grid)
+        {
+            for (int i = 0; i < numMovers; ++i)
+                _grid.Add(i, movers[i].m_x, movers[i].m_z, movers[i].m_radius);
+            _grid.m_stats = {};
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int tick = 0; tick < TICKS; ++tick)
+            {
+                const Mover* from = &paths[static_cast<size_t>(tick) * numMovers];
+                const Mover* to = from + numMovers;
+                for (int i = 0; i < numMovers; ++i)
+                {
+                    if (_incremental)
+                        _grid.Update(i, from[i].m_x, from[i].m_z, to[i].m_x, to[i].m_z, to[i].m_radius);
+                    else
+                        _grid.UpdateLegacy(i, from[i].m_x, from[i].m_z, to[i].m_x, to[i].m_z, to[i].m_radius);
+                }
+            }
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        Grid legacy(NUM_CELLS, CELL_SIZE);
+        Grid incremental(NUM_CELLS, CELL_SIZE);
+        const double legacySeconds = run(false, legacy);
+        const double incrementalSeconds = run(true, incremental);
+
+        Assert::IsTrue(legacy == incremental);
+        const UpdateStats& stats = incremental.m_stats;
+        const double updates = static_cast<double>(stats.m_updates);
+        Logger::WriteMessage(std::format("{} entities: full {:.1f} ns/update ({:.2f} cells), incremental {:.1f} ns/update ({:.2f} cells, "
+            "{:.0f}% unchanged, {:.2f} entered, {:.2f} left) ({:.1f}x)\n", movers.size(),
+            legacySeconds * 1.0e9 / updates, legacy.m_stats.m_cellsTouched / updates,
+            incrementalSeconds * 1.0e9 / updates, stats.m_cellsTouched / updates, 100.0 * stats.m_unchanged / updates,
+            stats.m_cellsEntered / updates, stats.m_cellsLeft / updates, legacySeconds / incrementalSeconds).c_str());
+    }
+};
@@ -0,0 +1,209 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    std::vector<std::pair<int, int>> Ranges(const ChunkVertexMap& _map, int _chunk)
+    {
+        std::vector<std::pair<int, int>> ranges;
+        _map.ForEachRange(_chunk, [&](int _begin, int _end) { ranges.emplace_back(_begin, _end); });
+        return ranges;
+    }
+
+    // A terrain mesh laid out the way LandscapeRenderer builds it: one
+    // triangle strip per row of the vertex grid, two sentinel vertices at the
+    // start of each strip, every other vertex coloured from the pheromone
+    // cell under it.  Cells are grouped into square chunks.
+    class ToyLandscape
+    {
+    public:
+        ToyLandscape(int _gridSize, int _cellsPerVertex, int _chunkSize)
+            : m_cellsPerSide(_gridSize * _cellsPerVertex),
+              m_chunkSize(_chunkSize),
+              m_chunksPerSide((m_cellsPerSide + _chunkSize - 1) / _chunkSize),
+              m_cells(static_cast<size_t>(m_cellsPerSide) * m_cellsPerSide, 0)
+        {
+            for (int row = 0; row + 1 < _gridSize; ++row)
+            {
+                m_cellOf.push_back(-1);
+                m_cellOf.push_back(-1);
+                for (int x = 0; x < _gridSize; ++x)
+                {
+                    for (int z : {row, row + 1})
+                        m_cellOf.push_back(z * _cellsPerVertex * m_cellsPerSide + x * _cellsPerVertex);
+                }
+            }
+
+            Lcg rng(7);
+            for (size_t v = 0; v < m_cellOf.size(); ++v)
+                m_base.push_back(rng.Next() & 0xFF);
+            m_colours = m_base;
+
+            m_map.Build(GetNumChunks(), static_cast<int>(m_cellOf.size()), [&](int _vertex) { return ChunkOfVertex(_vertex); });
+        }
+
+        [[nodiscard]] int GetNumChunks() const { return m_chunksPerSide * m_chunksPerSide; }
+        [[nodiscard]] int GetNumVerts() const { return static_cast<int>(m_cellOf.size()); }
+        [[nodiscard]] const ChunkVertexMap& GetMap() const { return m_map; }
+        [[nodiscard]] const std::vector<uint32_t>& GetColours() const { return m_colours; }
+
+        // Sets one random cell in _chunk
+        void Deposit(Lcg& _rng, int _chunk)
+        {
+            // The last row and column of chunks may be partly off the world
+            const int cx = std::min(m_cellsPerSide - 1, (_chunk % m_chunksPerSide) * m_chunkSize + static_cast<int>(_rng.Next() % m_chunkSize));
+            const int cz = std::min(m_cellsPerSide - 1, (_chunk / m_chunksPerSide) * m_chunkSize + static_cast<int>(_rng.Next() % m_chunkSize));
+            m_cells[static_cast<size_t>(cz) * m_cellsPerSide + cx] = _rng.Next() & 0xFF;
+        }
+
+        // The old overlay update: every vertex of every strip
+        void RecolourAll()
+        {
+            for (int v = 0; v < GetNumVerts(); ++v)
+                Recolour(v);
+        }
+
+        void RecolourChunks(const std::vector<int>& _dirty)
+        {
+            for (int chunk : _dirty)
+                m_map.ForEachVertex(chunk, [&](int _vertex) { Recolour(_vertex); });
+        }
+
+    private:
+        [[nodiscard]] int ChunkOfVertex(int _vertex) const
+        {
+            const int cell = m_cellOf[_vertex];
+            if (cell < 0)
+                return -1;
+            return (cell / m_cellsPerSide / m_chunkSize) * m_chunksPerSide + (cell % m_cellsPerSide) / m_chunkSize;
+        }
+
+        void Recolour(int _vertex)
+        {
+            const int cell = m_cellOf[_vertex];
+            m_colours[_vertex] = cell < 0 ? m_base[_vertex] : std::min(255u, m_base[_vertex] + m_cells[cell]);
+        }
+
+        int m_cellsPerSide;
+        int m_chunkSize;
+        int m_chunksPerSide;
+        std::vector<uint32_t> m_cells;
+        std::vector<int> m_cellOf;
+        std::vector<uint32_t> m_base;
+        std::vector<uint32_t> m_colours;
+        ChunkVertexMap m_map;
+    };
+}
+
+TEST_CLASS(ChunkVertexMapTests)
+{
+public:
+
+    // --- Building -----------------------------------------------------------
+
+    TEST_METHOD(Build_MergesConsecutiveVerticesIntoRanges)
+    {
+        //                    0   1  2  3  4  5  6  7   8  9
+        const int chunkOf[] = {-1, 0, 0, 1, 1, 0, 2, -1, 2, 2};
+        ChunkVertexMap map;
+        map.Build(4, 10, [&](int _vertex) { return chunkOf[_vertex]; });
+
+        Assert::AreEqual(4, map.GetNumChunks());
+        Assert::AreEqual(5, map.GetNumRanges());
+        Assert::IsTrue(Ranges(map, 0) == std::vector<std::pair<int, int>>{{1, 3}, {5, 6}});
+        Assert::IsTrue(Ranges(map, 1) == std::vector<std::pair<int, int>>{{3, 5}});
+        Assert::IsTrue(Ranges(map, 2) == std::vector<std::pair<int, int>>{{6, 7}, {8, 10}});
+        Assert::IsTrue(Ranges(map, 3).empty());
+        Assert::AreEqual(3, map.GetNumVerts(0));
+        Assert::AreEqual(0, map.GetNumVerts(3));
+
+        map.Clear();
+        Assert::AreEqual(0, map.GetNumChunks());
+    }
+
+    TEST_METHOD(Build_EveryChunkedVertexAppearsOnce)
+    {
+        ToyLandscape land(65, 2, 32);
+        std::vector<int> seen(land.GetNumVerts(), 0);
+        int total = 0;
+        for (int chunk = 0; chunk < land.GetNumChunks(); ++chunk)
+        {
+            land.GetMap().ForEachVertex(chunk, [&](int _vertex) { ++seen[_vertex]; });
+            total += land.GetMap().GetNumVerts(chunk);
+        }
+
+        const int sentinels = 2 * 64;
+        Assert::AreEqual(land.GetNumVerts() - sentinels, total);
+        Assert::AreEqual(sentinels, static_cast<int>(std::ranges::count(seen, 0)));
+        Assert::AreEqual(0, static_cast<int>(std::ranges::count_if(seen, [](int _n) { return _n > 1; })));
+
+        // Strips cross chunks row by row, so ranges are far fewer than vertices
+        Assert::IsTrue(land.GetMap().GetNumRanges() * 8 < total);
+    }
+
+    // --- Equivalence --------------------------------------------------------
+
+    TEST_METHOD(RecolourChunks_MatchesRecolouringEverything)
+    {
+        ToyLandscape incremental(65, 2, 32);
+        ToyLandscape full(65, 2, 32);
+        Lcg rngA(11);
+        Lcg rngB(11);
+
+        for (int update = 0; update < 40; ++update)
+        {
+            // A few deposits in a few chunks, as one frame of deltas would bring
+            std::vector<int> dirty;
+            const int deposits = 1 + update % 5;
+            for (int d = 0; d < deposits; ++d)
+            {
+                const int chunk = static_cast<int>((update * 7 + d * 3) % incremental.GetNumChunks());
+                incremental.Deposit(rngA, chunk);
+                full.Deposit(rngB, chunk);
+                if (std::ranges::find(dirty, chunk) == dirty.end())
+                    dirty.push_back(chunk);
+            }
+
+            incremental.RecolourChunks(dirty);
+            full.RecolourAll();
+            Assert::IsTrue(incremental.GetColours() == full.GetColours());
+        }
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_RecolourByDirtyChunks)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_RecolourByDirtyChunks)
+    {
+        // A 1024-cell world in 128-cell chunks (8x8, the TerrainChunk size)
+        // under a 256-vertex landscape grid: about 130k strip vertices.
+        constexpr int REPEATS = 50;
+        ToyLandscape land(256, 4, 128);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; ++r)
+            land.RecolourAll();
+        const double fullTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+        Logger::WriteMessage(std::format("{} vertices, {} chunks, {} ranges: {:.1f} us recolouring everything\n",
+            land.GetNumVerts(), land.GetNumChunks(), land.GetMap().GetNumRanges(), fullTime * 1.0e6).c_str());
+
+        // LandscapeRenderer goes back to the full pass above half the chunks
+        for (int numDirty : {1, 4, 16, 32, 64})
+        {
+            std::vector<int> dirty;
+            for (int i = 0; i < numDirty; ++i)
+                dirty.push_back((i * 37) % land.GetNumChunks());
+
+            start = std::chrono::steady_clock::now();
+            for (int r = 0; r < REPEATS; ++r)
+                land.RecolourChunks(dirty);
+            const double chunkTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+            Logger::WriteMessage(std::format("{} dirty chunks: {:.1f} us ({:.1f}x)\n",
+                numDirty, chunkTime * 1.0e6, fullTime / chunkTime).c_str());
+        }
+    }
+};
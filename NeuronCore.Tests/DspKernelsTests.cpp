@@ -0,0 +1,535 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    constexpr int SAMPLE_RATE = 44100;
+
+    // A second of something like game audio: two tones and some noise,
+    // loud enough that the effects have to clamp now and then
+    std::vector<int16_t> TestSignal(int _count, uint32_t _seed = 7)
+    {
+        Lcg rng(_seed);
+        std::vector<int16_t> signal(_count);
+        for (int i = 0; i < _count; ++i)
+        {
+            const double t = static_cast<double>(i) / SAMPLE_RATE;
+            const double s = 14000.0 * std::sin(2.0 * 3.14159265 * 220.0 * t) + 9000.0 * std::sin(2.0 * 3.14159265 * 3150.0 * t) +
+                6000.0 * (rng.NextFloat() - 0.5f);
+            signal[i] = static_cast<int16_t>(std::clamp(s, -32767.0, 32767.0));
+        }
+        return signal;
+    }
+
+    std::vector<float> ToFloat(const std::vector<int16_t>& _in)
+    {
+        std::vector<float> out(_in.size());
+        Dsp::FromShort(_in.data(), out.data(), static_cast<int>(_in.size()));
+        return out;
+    }
+
+    std::vector<int16_t> ToShort(const std::vector<float>& _in)
+    {
+        std::vector<int16_t> out(_in.size());
+        Dsp::ToShort(_in.data(), out.data(), static_cast<int>(_in.size()));
+        return out;
+    }
+
+    int MaxDifference(const std::vector<int16_t>& _a, const std::vector<int16_t>& _b)
+    {
+        int worst = 0;
+        for (size_t i = 0; i < _a.size(); ++i)
+            worst = std::max(worst, std::abs(_a[i] - _b[i]));
+        return worst;
+    }
+
+    // The effects as sound_filter.cpp had them before the float chain: one
+    // sample at a time on 16 bit buffers, each truncating its own output
+
+    Dsp::BiquadCoefs LowPassCoefs(float _frequency, float _resonance, float _gain)
+    {
+        const float omega = 2.0f * 3.14159265f * (_frequency / 44100.0f);
+        const float cosOmega = std::cos(omega);
+        const float alpha = std::sin(omega) / (2.0f * _resonance);
+        const float scalar = 1.0f / (1.0f + alpha);
+        const float omc = 1.0f - cosOmega;
+
+        Dsp::BiquadCoefs coefs;
+        coefs.m_a0 = omc * 0.5f * scalar;
+        coefs.m_a1 = omc * scalar;
+        coefs.m_a2 = coefs.m_a0;
+        coefs.m_b1 = -2.0f * cosOmega * scalar;
+        coefs.m_b2 = (1.0f - alpha) * scalar;
+        coefs.m_gain = _gain;
+        return coefs;
+    }
+
+    struct ToyResLowPass
+    {
+        Dsp::BiquadCoefs m_c;
+        float m_xn1 = 0.0f, m_xn2 = 0.0f, m_yn1 = 0.0f, m_yn2 = 0.0f;
+
+        void Process(int16_t* _data, int _count)
+        {
+            for (int i = 0; i < _count; ++i)
+            {
+                const float xn = _data[i];
+                const float yn = m_c.m_a0 * xn + m_c.m_a1 * m_xn1 + m_c.m_a2 * m_xn2 - m_c.m_b1 * m_yn1 - m_c.m_b2 * m_yn2;
+                _data[i] = static_cast<int16_t>(std::clamp(yn * m_c.m_gain, -32765.0f, 32765.0f));
+                m_xn2 = m_xn1;
+                m_xn1 = xn;
+                m_yn2 = m_yn1;
+                m_yn1 = yn;
+            }
+        }
+    };
+
+    void ToyBitCrush(int16_t* _data, int _count, float _bitRate)
+    {
+        const float stepSize = 65536.0f / std::pow(2.0f, _bitRate);
+        for (int i = 0; i < _count; ++i)
+        {
+            const int numSteps = static_cast<int>(_data[i] / stepSize);
+            _data[i] = static_cast<int16_t>(std::clamp(static_cast<int>(stepSize * numSteps), -32767, 32767));
+        }
+    }
+
+    float ToyGargle(int16_t* _data, int _count, float _phase, float _inc, float _wet, bool _square)
+    {
+        const float dry = 1.0f - _wet;
+        for (int i = 0; i < _count; ++i)
+        {
+            while (_phase >= 2.0f)
+                _phase -= 2.0f;
+            if (_square)
+                _data[i] = _phase < 1.0f ? _data[i] : 0;
+            else
+                _data[i] = static_cast<int16_t>(_data[i] * dry + _data[i] * (_phase < 1.0f ? _phase : 2.0f - _phase) * _wet);
+            _phase += _inc;
+        }
+        return _phase;
+    }
+
+    struct ToyEcho
+    {
+        std::vector<float> m_line;
+        int m_pos = 0;
+
+        void Process(int16_t* _data, int _count, float _wet, float _feedback)
+        {
+            for (int i = 0; i < _count; ++i)
+            {
+                const float in = _data[i];
+                _data[i] = static_cast<int16_t>(std::clamp(in * (1.0f - _wet) + m_line[m_pos] * _wet, -32766.0f, 32766.0f));
+                m_line[m_pos] = m_line[m_pos] * _feedback + in;
+                m_pos = (m_pos + 1) % static_cast<int>(m_line.size());
+            }
+        }
+    };
+
+    const Dsp::ReverbTap REVERB_TAPS[] = {
+        {static_cast<int>(0.0011f * SAMPLE_RATE), 0.36f}, {static_cast<int>(0.003f * SAMPLE_RATE), 0.25f},
+        {static_cast<int>(0.011f * SAMPLE_RATE), 0.34f}, {static_cast<int>(0.019f * SAMPLE_RATE), 0.23f},
+        {static_cast<int>(0.029f * SAMPLE_RATE), 0.32f}, {static_cast<int>(0.046f * SAMPLE_RATE), 0.21f}};
+    constexpr int NUM_REVERB_TAPS = static_cast<int>(std::size(REVERB_TAPS));
+    constexpr int REVERB_LINE = 3 * SAMPLE_RATE;
+
+    struct ToyReverb
+    {
+        std::vector<int16_t> m_line = std::vector<int16_t>(REVERB_LINE);
+        int m_pos = 0;
+
+        void Process(int16_t* _data, int _count)
+        {
+            for (int k = 0; k < _count; ++k)
+            {
+                int x = 0;
+                for (const Dsp::ReverbTap& tap : REVERB_TAPS)
+                    x += static_cast<int>(m_line[(m_pos - tap.m_delay + REVERB_LINE) % REVERB_LINE] * tap.m_decay);
+                const int s = std::clamp(static_cast<int>(_data[k] * 0.23f + x * 0.67f), -32766, 32766);
+                m_line[m_pos] = static_cast<int16_t>(s);
+                _data[k] = static_cast<int16_t>(s);
+                m_pos = (m_pos + 1) % REVERB_LINE;
+            }
+        }
+    };
+
+    // Feeds _signal to _process in blocks of irregular size, as the sound
+    // library does with the two halves of a locked buffer
+    template <typename T, typename TProcess>
+    void InBlocks(std::vector<T>& _signal, TProcess&& _process)
+    {
+        static constexpr int SIZES[] = {1024, 7, 333, 4096, 1, 2, 3, 4, 5, 513};
+        int done = 0;
+        for (int b = 0; done < static_cast<int>(_signal.size()); ++b)
+        {
+            const int count = std::min(SIZES[b % std::size(SIZES)], static_cast<int>(_signal.size()) - done);
+            _process(_signal.data() + done, count);
+            done += count;
+        }
+    }
+}
+
+TEST_CLASS(DspKernelsTests)
+{
+public:
+
+    // --- Conversion ---------------------------------------------------------
+
+    TEST_METHOD(FromShortThenToShort_RoundTrips)
+    {
+        std::vector<int16_t> all;
+        for (int s = -32767; s <= 32767; ++s)
+            all.push_back(static_cast<int16_t>(s));
+        Assert::IsTrue(ToShort(ToFloat(all)) == all);
+    }
+
+    TEST_METHOD(ToShort_ClampsAndRoundsToNearest)
+    {
+        const std::vector<float> in = {0.4f, 0.5f, 1.5f, -2.5f, -0.6f, 99999.0f, -99999.0f, 32767.4f, 12.75f};
+        const std::vector<int16_t> expected = {0, 0, 2, -2, -1, 32767, -32767, 32767, 13};
+        Assert::IsTrue(ToShort(in) == expected);
+    }
+
+    // --- Effects against the 16 bit originals --------------------------------
+
+    TEST_METHOD(Biquad_MatchesOldLowPassToOneStep)
+    {
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE);
+        const Dsp::BiquadCoefs coefs = LowPassCoefs(1000.0f, 2.0f, 1.5f);
+
+        std::vector<int16_t> old = signal;
+        ToyResLowPass toy{coefs};
+        InBlocks(old, [&](int16_t* _data, int _count) { toy.Process(_data, _count); });
+
+        std::vector<float> block = ToFloat(signal);
+        Dsp::BiquadState state;
+        InBlocks(block, [&](float* _data, int _count) { Dsp::Biquad(_data, _count, coefs, state); });
+
+        // Truncation against rounding, and the old clamp at 32765
+        Assert::IsTrue(MaxDifference(old, ToShort(block)) <= 2);
+    }
+
+    TEST_METHOD(BitCrush_MatchesOldCrusherExactly)
+    {
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE / 4);
+        for (float bitRate : {1.0f, 4.0f, 8.0f, 12.0f, 16.0f})
+        {
+            std::vector<int16_t> old = signal;
+            ToyBitCrush(old.data(), static_cast<int>(old.size()), bitRate);
+
+            std::vector<float> block = ToFloat(signal);
+            InBlocks(block, [&](float* _data, int _count) { Dsp::BitCrush(_data, _count, 65536.0f / std::pow(2.0f, bitRate)); });
+            Assert::IsTrue(ToShort(block) == old);
+        }
+    }
+
+    TEST_METHOD(Gargle_MatchesOldGargle)
+    {
+        // A power of two step keeps the phase exact however it is summed
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE / 2);
+        const float inc = 1.0f / 512.0f;
+
+        for (bool square : {false, true})
+        {
+            std::vector<int16_t> old = signal;
+            float toyPhase = 0.25f;
+            InBlocks(old, [&](int16_t* _data, int _count) { toyPhase = ToyGargle(_data, _count, toyPhase, inc, 0.7f, square); });
+
+            std::vector<float> block = ToFloat(signal);
+            float phase = 0.25f;
+            InBlocks(block, [&](float* _data, int _count) { phase = Dsp::Gargle(_data, _count, phase, inc, 0.7f, square); });
+
+            Assert::IsTrue(MaxDifference(old, ToShort(block)) <= (square ? 0 : 1));
+            Assert::IsTrue(phase >= 0.0f && phase < 2.0f);
+        }
+    }
+
+    TEST_METHOD(Gargle_FastModulationFallsBackToScalar)
+    {
+        std::vector<float> block(37, 100.0f);
+        const float phase = Dsp::Gargle(block.data(), 37, 0.0f, 0.75f, 1.0f, true);
+
+        float expected = 0.0f;
+        for (int i = 0; i < 37; ++i)
+        {
+            Assert::AreEqual(expected < 1.0f ? 100.0f : 0.0f, block[i]);
+            expected += 0.75f;
+            while (expected >= 2.0f)
+                expected -= 2.0f;
+        }
+        Assert::AreEqual(expected, phase);
+    }
+
+    TEST_METHOD(Echo_MatchesOldEchoToOneStep)
+    {
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE);
+        const int delay = SAMPLE_RATE / 5;
+
+        std::vector<int16_t> old = signal;
+        ToyEcho toy{std::vector<float>(delay)};
+        InBlocks(old, [&](int16_t* _data, int _count) { toy.Process(_data, _count, 0.4f, 0.5f); });
+
+        std::vector<float> block = ToFloat(signal);
+        std::vector<float> line(delay);
+        int pos = 0;
+        InBlocks(block, [&](float* _data, int _count) { pos = Dsp::Echo(_data, _count, line.data(), delay, pos, 0.4f, 0.5f); });
+
+        // The line never held quantized samples, so only the output rounding differs
+        Assert::IsTrue(MaxDifference(old, ToShort(block)) <= 1);
+        Assert::AreEqual(toy.m_pos, pos);
+    }
+
+    TEST_METHOD(Echo_ShortDelayWrapsWithinABlock)
+    {
+        std::vector<float> block(20, 0.0f);
+        block[0] = 1000.0f;
+        std::vector<float> line(3);
+        const int pos = Dsp::Echo(block.data(), 20, line.data(), 3, 0, 1.0f, 0.5f);
+
+        // Fully wet: the impulse comes back every 3 samples, halving
+        const std::vector<float> expected = {0, 0, 0, 1000, 0, 0, 500, 0, 0, 250, 0, 0, 125, 0, 0, 62.5f, 0, 0, 31.25f, 0};
+        Assert::IsTrue(block == expected);
+        Assert::AreEqual(20 % 3, pos);
+    }
+
+    TEST_METHOD(Reverb_ImpulseHitsEachTap)
+    {
+        std::vector<float> block(REVERB_LINE / 10, 0.0f);
+        block[0] = 10000.0f;
+        std::vector<float> line(REVERB_LINE);
+        InBlocks(block, [&, pos = 0](float* _data, int _count) mutable
+        {
+            pos = Dsp::Reverb(_data, _count, line.data(), REVERB_LINE, pos, REVERB_TAPS, NUM_REVERB_TAPS, 0.23f, 0.67f);
+        });
+
+        const float first = 10000.0f * 0.23f;
+        Assert::AreEqual(first, block[0]);
+        Assert::AreEqual(0.0f, block[1]);
+
+        // Until the echoes start echoing, each tap returns the first sample once
+        const int d0 = REVERB_TAPS[0].m_delay;
+        for (const Dsp::ReverbTap& tap : REVERB_TAPS)
+        {
+            if (tap.m_delay < 2 * d0)
+            {
+                Assert::AreEqual(first * tap.m_decay * 0.67f, block[tap.m_delay]);
+                Assert::AreEqual(0.0f, block[tap.m_delay - 1]);
+            }
+        }
+        Assert::AreEqual(first * 0.36f * 0.67f * 0.36f * 0.67f, block[2 * d0], 1e-3f);
+    }
+
+    TEST_METHOD(Reverb_MatchesScalarReference)
+    {
+        // The same sums in the same order one sample at a time, so the runs
+        // and the four-wide loop must not change a bit of the output
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE);
+
+        std::vector<float> expected = ToFloat(signal);
+        {
+            std::vector<float> line(REVERB_LINE);
+            int pos = 0;
+            for (float& s : expected)
+            {
+                float sum = 0.0f;
+                for (const Dsp::ReverbTap& tap : REVERB_TAPS)
+                    sum += line[(pos - tap.m_delay + REVERB_LINE) % REVERB_LINE] * tap.m_decay;
+                s = std::clamp(s * 0.23f + sum * 0.67f, -Dsp::SAMPLE_MAX, Dsp::SAMPLE_MAX);
+                line[pos] = s;
+                pos = (pos + 1) % REVERB_LINE;
+            }
+        }
+
+        std::vector<float> block = ToFloat(signal);
+        std::vector<float> line(REVERB_LINE);
+        int pos = 0;
+        InBlocks(block, [&](float* _data, int _count)
+        {
+            pos = Dsp::Reverb(_data, _count, line.data(), REVERB_LINE, pos, REVERB_TAPS, NUM_REVERB_TAPS, 0.23f, 0.67f);
+        });
+        Assert::IsTrue(block == expected);
+        Assert::AreEqual(SAMPLE_RATE % REVERB_LINE, pos);
+    }
+
+    TEST_METHOD(Reverb_StartsCloseToOldReverb)
+    {
+        // The taps feed back more than they take in, so the old line's
+        // truncations compound and the two part company once the tail
+        // builds up; over the first 50ms they agree to a few steps
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE / 20);
+
+        std::vector<int16_t> old = signal;
+        ToyReverb toy;
+        InBlocks(old, [&](int16_t* _data, int _count) { toy.Process(_data, _count); });
+
+        std::vector<float> block = ToFloat(signal);
+        std::vector<float> line(REVERB_LINE);
+        int pos = 0;
+        InBlocks(block, [&](float* _data, int _count)
+        {
+            pos = Dsp::Reverb(_data, _count, line.data(), REVERB_LINE, pos, REVERB_TAPS, NUM_REVERB_TAPS, 0.23f, 0.67f);
+        });
+        Assert::AreEqual(toy.m_pos, pos);
+        Assert::IsTrue(MaxDifference(old, ToShort(block)) <= 4);
+    }
+
+    // --- Chain --------------------------------------------------------------
+
+    TEST_METHOD(Chain_RoundingOnceBeatsRoundingPerEffect)
+    {
+        // Low pass then echo then gargle, against the same chain in double
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE / 2);
+        const Dsp::BiquadCoefs coefs = LowPassCoefs(2500.0f, 1.0f, 0.8f);
+        const int delay = 1500;
+        const float inc = 1.0f / 1024.0f;
+
+        std::vector<double> exact(signal.begin(), signal.end());
+        {
+            double xn1 = 0, xn2 = 0, yn1 = 0, yn2 = 0;
+            for (double& s : exact)
+            {
+                const double yn = coefs.m_a0 * s + coefs.m_a1 * xn1 + coefs.m_a2 * xn2 - coefs.m_b1 * yn1 - coefs.m_b2 * yn2;
+                xn2 = xn1; xn1 = s; yn2 = yn1; yn1 = yn;
+                s = yn * coefs.m_gain;
+            }
+            std::vector<double> line(delay);
+            for (size_t i = 0; i < exact.size(); ++i)
+            {
+                double& echo = line[i % delay];
+                const double in = exact[i];
+                exact[i] = in * 0.6 + echo * 0.4;
+                echo = echo * 0.5 + in;
+            }
+            double phase = 0.0;
+            for (double& s : exact)
+            {
+                s *= 0.3 + 0.7 * (phase < 1.0 ? phase : 2.0 - phase);
+                phase += inc;
+                if (phase >= 2.0)
+                    phase -= 2.0;
+            }
+        }
+
+        std::vector<int16_t> old = signal;
+        {
+            ToyResLowPass lowPass{coefs};
+            ToyEcho echo{std::vector<float>(delay)};
+            float phase = 0.0f;
+            InBlocks(old, [&](int16_t* _data, int _count)
+            {
+                lowPass.Process(_data, _count);
+                echo.Process(_data, _count, 0.4f, 0.5f);
+                phase = ToyGargle(_data, _count, phase, inc, 0.7f, false);
+            });
+        }
+
+        std::vector<int16_t> chained = signal;
+        {
+            Dsp::BiquadState state;
+            std::vector<float> line(delay);
+            int pos = 0;
+            float phase = 0.0f;
+            std::vector<float> block;
+            InBlocks(chained, [&](int16_t* _data, int _count)
+            {
+                block.resize(_count);
+                Dsp::FromShort(_data, block.data(), _count);
+                Dsp::Biquad(block.data(), _count, coefs, state);
+                pos = Dsp::Echo(block.data(), _count, line.data(), delay, pos, 0.4f, 0.5f);
+                phase = Dsp::Gargle(block.data(), _count, phase, inc, 0.7f, false);
+                Dsp::ToShort(block.data(), _data, _count);
+            });
+        }
+
+        double oldError = 0.0;
+        double chainedError = 0.0;
+        for (size_t i = 0; i < exact.size(); ++i)
+        {
+            const double target = std::clamp(exact[i], -32767.0, 32767.0);
+            oldError += std::abs(old[i] - target);
+            chainedError += std::abs(chained[i] - target);
+        }
+        oldError /= exact.size();
+        chainedError /= exact.size();
+
+        Assert::IsTrue(chainedError <= 0.55);
+        Assert::IsTrue(chainedError < oldError);
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_EffectThroughput)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_EffectThroughput)
+    {
+        // Ten seconds of audio through each effect in 1024 sample blocks, the
+        // 16 bit original against the float kernel.  In the chain the float
+        // side converts once per block whatever the number of effects, so
+        // that is timed on its own.
+        constexpr int BLOCK = 1024;
+        constexpr int SECONDS = 10;
+        const std::vector<int16_t> signal = TestSignal(SAMPLE_RATE);
+        const std::vector<float> floatSignal = ToFloat(signal);
+
+        const auto time = [&]<typename T>(const std::vector<T>& _signal, auto&& _process)
+        {
+            std::vector<T> buffer = _signal;
+            const auto start = std::chrono::steady_clock::now();
+            for (int s = 0; s < SECONDS; ++s)
+            {
+                std::copy(_signal.begin(), _signal.end(), buffer.begin());
+                for (int i = 0; i + BLOCK <= SAMPLE_RATE; i += BLOCK)
+                    _process(buffer.data() + i, BLOCK);
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return static_cast<double>(SECONDS) * SAMPLE_RATE / seconds / 1.0e6;
+        };
+
+        std::vector<float> block(BLOCK);
+        const double convert = time(signal, [&](int16_t* _data, int _count)
+        {
+            Dsp::FromShort(_data, block.data(), _count);
+            Dsp::ToShort(block.data(), _data, _count);
+        });
+        Logger::WriteMessage(std::format("FromShort + ToShort: {:.1f} Msamples/s\n", convert).c_str());
+
+        const auto report = [](const char* _name, double _old, double _new)
+        {
+            Logger::WriteMessage(std::format("{}: {:.1f} Msamples/s 16 bit, {:.1f} Msamples/s float ({:.1f}x)\n", _name, _old, _new, _new / _old).c_str());
+        };
+
+        const Dsp::BiquadCoefs coefs = LowPassCoefs(1000.0f, 2.0f, 1.0f);
+        ToyResLowPass toyLowPass{coefs};
+        Dsp::BiquadState state;
+        report("ResLowPass", time(signal, [&](int16_t* _data, int _count) { toyLowPass.Process(_data, _count); }),
+            time(floatSignal, [&](float* _data, int _count) { Dsp::Biquad(_data, _count, coefs, state); }));
+
+        report("BitCrusher", time(signal, [&](int16_t* _data, int _count) { ToyBitCrush(_data, _count, 6.0f); }),
+            time(floatSignal, [&](float* _data, int _count) { Dsp::BitCrush(_data, _count, 65536.0f / 64.0f); }));
+
+        float toyPhase = 0.0f;
+        float phase = 0.0f;
+        report("Gargle", time(signal, [&](int16_t* _data, int _count) { toyPhase = ToyGargle(_data, _count, toyPhase, 40.0f / SAMPLE_RATE, 0.5f, false); }),
+            time(floatSignal, [&](float* _data, int _count) { phase = Dsp::Gargle(_data, _count, phase, 40.0f / SAMPLE_RATE, 0.5f, false); }));
+
+        const int delay = SAMPLE_RATE / 5;
+        ToyEcho toyEcho{std::vector<float>(delay)};
+        std::vector<float> echoLine(delay);
+        int echoPos = 0;
+        report("Echo", time(signal, [&](int16_t* _data, int _count) { toyEcho.Process(_data, _count, 0.5f, 0.5f); }),
+            time(floatSignal, [&](float* _data, int _count) { echoPos = Dsp::Echo(_data, _count, echoLine.data(), delay, echoPos, 0.5f, 0.5f); }));
+
+        ToyReverb toyReverb;
+        std::vector<float> reverbLine(REVERB_LINE);
+        int reverbPos = 0;
+        report("Reverb", time(signal, [&](int16_t* _data, int _count) { toyReverb.Process(_data, _count); }),
+            time(floatSignal, [&](float* _data, int _count)
+            {
+                reverbPos = Dsp::Reverb(_data, _count, reverbLine.data(), REVERB_LINE, reverbPos, REVERB_TAPS, NUM_REVERB_TAPS, 0.23f, 0.67f);
+            }));
+    }
+};
@@ -0,0 +1,198 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    constexpr int TRAIL_SIZE = 3;
+
+    // Centipede::RecordHistoryPosition and GetTrailPosition over the LList
+    // trail it kept before and the ring it keeps now
+
+    void Record(LList<LegacyVector3>& _trail, const LegacyVector3& _pos)
+    {
+        _trail.PutDataAtStart(_pos);
+        for (int i = TRAIL_SIZE; i < _trail.Size(); ++i)
+            _trail.RemoveData(i);
+    }
+
+    void Record(HistoryRing<LegacyVector3, 4>& _trail, const LegacyVector3& _pos)
+    {
+        _trail.Push(_pos);
+        _trail.Truncate(TRAIL_SIZE);
+    }
+
+    bool TrailPosition(LList<LegacyVector3>& _trail, int _numSteps, float _size, LegacyVector3& _pos)
+    {
+        if (_trail.Size() < TRAIL_SIZE)
+            return false;
+        const LegacyVector3 pos1 = *_trail.GetPointer(_numSteps + 1);
+        const LegacyVector3 pos2 = *_trail.GetPointer(_numSteps);
+        _pos = pos1 + (pos2 - pos1) * (1.0f - _size);
+        return true;
+    }
+
+    bool TrailPosition(const HistoryRing<LegacyVector3, 4>& _trail, int _numSteps, float _size, LegacyVector3& _pos)
+    {
+        if (_trail.Size() < TRAIL_SIZE)
+            return false;
+        const LegacyVector3& pos1 = _trail[_numSteps + 1];
+        const LegacyVector3& pos2 = _trail[_numSteps];
+        _pos = pos1 + (pos2 - pos1) * (1.0f - _size);
+        return true;
+    }
+}
+
+TEST_CLASS(HistoryRingTests)
+{
+public:
+
+    // --- Order --------------------------------------------------------------
+
+    TEST_METHOD(Index_ZeroIsNewest)
+    {
+        HistoryRing<int, 8> ring;
+        Assert::IsTrue(ring.IsEmpty());
+        Assert::IsFalse(ring.ValidIndex(0));
+
+        for (int i = 1; i <= 5; ++i)
+            ring.Push(i);
+
+        Assert::AreEqual(5, ring.Size());
+        for (int age = 0; age < 5; ++age)
+            Assert::AreEqual(5 - age, ring[age]);
+        Assert::IsFalse(ring.ValidIndex(5));
+        Assert::IsFalse(ring.ValidIndex(-1));
+    }
+
+    TEST_METHOD(Push_WhenFull_DropsOldest)
+    {
+        HistoryRing<int, 4> ring;
+        for (int i = 0; i < 1000; ++i)
+        {
+            ring.Push(i);
+            Assert::AreEqual(std::min(i + 1, 4), ring.Size());
+            Assert::AreEqual(i, ring[0]);
+        }
+
+        for (int age = 0; age < 4; ++age)
+            Assert::AreEqual(999 - age, ring[age]);
+        Assert::AreEqual(4, HistoryRing<int, 4>::GetCapacity());
+    }
+
+    // --- Truncation ---------------------------------------------------------
+
+    TEST_METHOD(Truncate_KeepsNewest)
+    {
+        HistoryRing<int, 16> ring;
+        for (int i = 0; i < 20; ++i)
+            ring.Push(i);
+
+        ring.Truncate(30);
+        Assert::AreEqual(16, ring.Size());
+
+        ring.Truncate(3);
+        Assert::AreEqual(3, ring.Size());
+        Assert::AreEqual(19, ring[0]);
+        Assert::AreEqual(17, ring[2]);
+
+        ring.Push(20);
+        Assert::AreEqual(4, ring.Size());
+        Assert::AreEqual(17, ring[3]);
+
+        ring.Clear();
+        Assert::IsTrue(ring.IsEmpty());
+        ring.Push(21);
+        Assert::AreEqual(21, ring[0]);
+    }
+
+    TEST_METHOD(MatchesAListThroughPushesAndTruncates)
+    {
+        // Pushes at the front and trims at the back at random, as a trail
+        // bounded by distance does
+        HistoryRing<int, 32> ring;
+        std::deque<int> reference;
+        Lcg rng(12345);
+        for (int i = 0; i < 20000; ++i)
+        {
+            const uint32_t r = rng.Next();
+            ring.Push(i);
+            reference.push_front(i);
+            if (reference.size() > 32)
+                reference.pop_back();
+
+            if ((r >> 16) < 40)
+            {
+                const int keep = static_cast<int>(r % 33);
+                ring.Truncate(keep);
+                while (static_cast<int>(reference.size()) > keep)
+                    reference.pop_back();
+            }
+
+            Assert::AreEqual(static_cast<int>(reference.size()), ring.Size());
+            for (int age = 0; age < ring.Size(); ++age)
+                Assert::AreEqual(reference[age], ring[age]);
+        }
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_CentipedeChains)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_CentipedeChains)
+    {
+        // Models Centipede::Advance over long chains: the head wanders, and
+        // every segment behind it follows the trail of the one in front and
+        // then records its own.  Baseline is the LList trail; both sides must
+        // put every segment in the same place.
+        constexpr int CHAINS = 20;
+        constexpr int SEGMENTS = 200;
+        constexpr int TICKS = 1000;
+
+        const auto run = [&]<typename TTrail>(std::vector<TTrail>& _trails, double& _checksum)
+        {
+            std::vector<LegacyVector3> positions(CHAINS * SEGMENTS, LegacyVector3(0.0f, 0.0f, 0.0f));
+            const auto start = std::chrono::steady_clock::now();
+            for (int tick = 0; tick < TICKS; ++tick)
+            {
+                for (int c = 0; c < CHAINS; ++c)
+                {
+                    for (int s = 0; s < SEGMENTS; ++s)
+                    {
+                        const int id = c * SEGMENTS + s;
+                        if (s == 0)
+                        {
+                            const float angle = tick * 0.05f + c;
+                            positions[id] = LegacyVector3(positions[id].x + std::sin(angle), 0.0f, positions[id].z + std::cos(angle));
+                        }
+                        else
+                        {
+                            const float size = std::min(1.0f, 0.2f * (1.0f + s * 0.1f));
+                            TrailPosition(_trails[id - 1], 1, size, positions[id]);
+                        }
+                        Record(_trails[id], positions[id]);
+                    }
+                }
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            _checksum = 0.0;
+            for (const LegacyVector3& p : positions)
+                _checksum += p.x + p.z;
+            return seconds;
+        };
+
+        std::vector<LList<LegacyVector3>> lists(CHAINS * SEGMENTS);
+        std::vector<HistoryRing<LegacyVector3, 4>> rings(CHAINS * SEGMENTS);
+        double listChecksum = 0.0, ringChecksum = 0.0;
+        const double listSeconds = run(lists, listChecksum);
+        const double ringSeconds = run(rings, ringChecksum);
+
+        Assert::AreEqual(listChecksum, ringChecksum);
+        const double updates = static_cast<double>(CHAINS) * SEGMENTS * TICKS;
+        Logger::WriteMessage(std::format("{} chains of {} segments: linked list {:.1f} ns/segment, ring {:.1f} ns/segment ({:.1f}x)\n",
+            CHAINS, SEGMENTS, listSeconds * 1.0e9 / updates, ringSeconds * 1.0e9 / updates, listSeconds / ringSeconds).c_str());
+    }
+};
@@ -0,0 +1,584 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    struct Pixel
+    {
+        uint8_t r, g, b, a;
+    };
+
+    struct ToyBitmap
+    {
+        std::string m_name;
+        int m_width = 0;
+        int m_height = 0;
+        std::vector<Pixel> m_pixels;
+
+        uint8_t* Bytes() { return reinterpret_cast<uint8_t*>(m_pixels.data()); }
+        const uint8_t* Bytes() const { return reinterpret_cast<const uint8_t*>(m_pixels.data()); }
+    };
+
+    bool SamePixels(const ToyBitmap& _a, const ToyBitmap& _b)
+    {
+        return _a.m_pixels.size() == _b.m_pixels.size() &&
+            std::memcmp(_a.m_pixels.data(), _b.m_pixels.data(), _a.m_pixels.size() * sizeof(Pixel)) == 0;
+    }
+
+    // Noise with some black, which the blur treats specially, and alpha
+    // that is not all 255
+    ToyBitmap NoiseBitmap(int _width, int _height, uint32_t _seed)
+    {
+        Lcg rng(_seed);
+        ToyBitmap bmp{"noise", _width, _height, std::vector<Pixel>(static_cast<size_t>(_width) * _height)};
+        for (Pixel& p : bmp.m_pixels)
+        {
+            const uint32_t bits = rng.Next();
+            if ((bits & 3) == 0)
+                p = {0, 0, 0, static_cast<uint8_t>(bits >> 8)};
+            else
+                p = {static_cast<uint8_t>(bits), static_cast<uint8_t>(bits >> 8), static_cast<uint8_t>(bits >> 16), static_cast<uint8_t>(rng.Next())};
+        }
+        return bmp;
+    }
+
+    // --- Shipped bitmaps ----------------------------------------------------
+
+    std::filesystem::path ShippedAssetDirectory()
+    {
+        return std::filesystem::path(__FILE__).parent_path().parent_path() / "Starstrike" / "Assets";
+    }
+
+    uint32_t ReadLe(const std::vector<uint8_t>& _data, size_t _at, int _bytes)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < _bytes; ++i)
+            value |= static_cast<uint32_t>(_data[_at + i]) << (i * 8);
+        return value;
+    }
+
+    // Enough of BitmapRGBA's loader for the shipped files: Windows headers,
+    // uncompressed, 4, 8 or 24 bits a pixel, bottom-up.  Alpha is 255 as the
+    // loader leaves it.
+    ToyBitmap LoadBmp(const std::filesystem::path& _path)
+    {
+        std::ifstream file(_path, std::ios::binary);
+        const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        ToyBitmap bmp;
+        bmp.m_name = _path.filename().string();
+        if (data.size() < 54 || data[0] != 'B' || data[1] != 'M')
+            return bmp;
+
+        const uint32_t offBits = ReadLe(data, 10, 4);
+        const uint32_t headerSize = ReadLe(data, 14, 4);
+        const int width = static_cast<int>(ReadLe(data, 18, 4));
+        const int height = static_cast<int>(ReadLe(data, 22, 4));
+        const int bitCount = static_cast<int>(ReadLe(data, 28, 2));
+        if (headerSize < 40 || ReadLe(data, 30, 4) != 0 || width <= 0 || height <= 0)
+            return bmp;
+
+        const size_t palette = 14 + headerSize;
+        const size_t stride = ((static_cast<size_t>(width) * bitCount + 31) / 32) * 4;
+        if (offBits + stride * height > data.size())
+            return bmp;
+
+        bmp.m_width = width;
+        bmp.m_height = height;
+        bmp.m_pixels.resize(static_cast<size_t>(width) * height);
+        for (int y = 0; y < height; ++y)
+        {
+            const uint8_t* row = data.data() + offBits + (height - 1 - y) * stride;
+            for (int x = 0; x < width; ++x)
+            {
+                Pixel& p = bmp.m_pixels[y * width + x];
+                if (bitCount == 24)
+                {
+                    p = {row[x * 3 + 2], row[x * 3 + 1], row[x * 3], 255};
+                    continue;
+                }
+                const int index = bitCount == 8 ? row[x] : (row[x / 2] >> (x & 1 ? 0 : 4)) & 15;
+                const uint8_t* entry = data.data() + palette + index * 4;
+                p = {entry[2], entry[1], entry[0], 255};
+            }
+        }
+        return bmp;
+    }
+
+    std::vector<ToyBitmap> LoadShippedBitmaps()
+    {
+        std::vector<std::filesystem::path> files;
+        const std::filesystem::path directory = ShippedAssetDirectory();
+        if (std::filesystem::exists(directory))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+            {
+                if (entry.path().extension() == ".bmp")
+                    files.push_back(entry.path());
+            }
+        }
+        std::ranges::sort(files);
+
+        std::vector<ToyBitmap> bitmaps;
+        for (const std::filesystem::path& file : files)
+        {
+            ToyBitmap bmp = LoadBmp(file);
+            if (bmp.m_width > 0)
+                bitmaps.push_back(std::move(bmp));
+        }
+        if (bitmaps.empty())
+            Logger::WriteMessage(std::format("No bitmaps under {}; using noise only\n", directory.string()).c_str());
+        return bitmaps;
+    }
+
+    // --- Scalar references --------------------------------------------------
+
+    // BitmapRGBA's filters as they were before ImageKernels, on ToyBitmap
+
+    void LegacyGreyScale(ToyBitmap& _bmp)
+    {
+        for (Pixel& c : _bmp.m_pixels)
+        {
+            const int average = (c.r + c.b + c.g) / 3;
+            c.r = static_cast<uint8_t>(average);
+            c.b = static_cast<uint8_t>(average);
+            c.g = static_cast<uint8_t>(average);
+        }
+    }
+
+    void LegacyDilate(ToyBitmap& _bmp)
+    {
+        const std::vector<Pixel> temp = _bmp.m_pixels;
+        const int w = _bmp.m_width;
+        for (int x = 1; x < w - 1; ++x)
+        {
+            for (int y = 1; y < _bmp.m_height - 1; ++y)
+            {
+                float red = 0.0f, green = 0.0f, blue = 0.0f;
+                for (int i = -1; i <= 1; ++i)
+                {
+                    for (int j = -1; j <= 1; ++j)
+                    {
+                        if (i != 0 || j != 0)
+                        {
+                            const Pixel col = temp[(y + j) * w + (x + i)];
+                            red += col.r;
+                            green += col.g;
+                            blue += col.b;
+                        }
+                    }
+                }
+                red /= 8.0f;
+                green /= 8.0f;
+                blue /= 8.0f;
+                _bmp.m_pixels[y * w + x] = {static_cast<uint8_t>(red), static_cast<uint8_t>(green), static_cast<uint8_t>(blue), 255};
+            }
+        }
+    }
+
+    void LegacyBlur(ToyBitmap& _bmp, float _scale)
+    {
+        const int w = _bmp.m_width;
+        const int h = _bmp.m_height;
+        std::vector<Pixel> temp(static_cast<size_t>(w) * h, Pixel{0, 0, 0, 0});
+
+        float m[5] = {2, 4, 7, 4, 2};
+        for (float& v : m)
+            v *= _scale * 0.0526f;
+
+        const auto add = [](Pixel& _dest, const Pixel& _src, float _m)
+        {
+            const int r = std::min(255, _dest.r + static_cast<int>(static_cast<float>(_src.r) * _m));
+            const int g = std::min(255, _dest.g + static_cast<int>(static_cast<float>(_src.g) * _m));
+            const int b = std::min(255, _dest.b + static_cast<int>(static_cast<float>(_src.b) * _m));
+            _dest = {static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b), 255};
+        };
+
+        for (int y = 0; y < h; ++y)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                const Pixel& src = _bmp.m_pixels[y * w + x];
+                if (src.r == 0 && src.g == 0 && src.b == 0)
+                    continue;
+                for (int i = 0; i < 5; ++i)
+                {
+                    const int a = x + i - 2;
+                    if (a >= 0 && a < w)
+                        add(temp[y * w + a], src, m[i]);
+                }
+            }
+        }
+
+        for (float& v : m)
+            v *= 2.0f;
+
+        std::ranges::fill(_bmp.m_pixels, Pixel{0, 0, 0, 0});
+        for (int y = 0; y < h; ++y)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                const Pixel& src = temp[y * w + x];
+                if (src.r == 0 && src.g == 0 && src.b == 0)
+                    continue;
+                for (int i = 0; i < 5; ++i)
+                {
+                    const int a = y + i - 2;
+                    if (a >= 0 && a < h)
+                        add(_bmp.m_pixels[a * w + x], src, m[i]);
+                }
+            }
+        }
+    }
+
+    Pixel LegacyGetPixelClipped(const ToyBitmap& _bmp, int _x, int _y)
+    {
+        if (_x < 0 || _x >= _bmp.m_width || _y < 0 || _y >= _bmp.m_height)
+            return {0, 0, 0, 255};
+        return _bmp.m_pixels[_y * _bmp.m_width + _x];
+    }
+
+    Pixel LegacyInterpolatedPixel(const ToyBitmap& _bmp, float _x, float _y)
+    {
+        const int x1 = static_cast<int>(floorf(_x));
+        const int y1 = static_cast<int>(floorf(_y));
+        int x2 = static_cast<int>(ceilf(_x));
+        int y2 = static_cast<int>(ceilf(_y));
+        if (x2 == _bmp.m_width)
+            x2 = _bmp.m_width - 1;
+        if (y2 == _bmp.m_height)
+            y2 = _bmp.m_height - 1;
+
+        const float fx = _x - x1;
+        const float fy = _y - y1;
+        const float w11 = (1.0f - fx) * (1.0f - fy);
+        const float w12 = (1.0f - fx) * fy;
+        const float w21 = fx * (1.0f - fy);
+        const float w22 = fx * fy;
+
+        const Pixel c11 = LegacyGetPixelClipped(_bmp, x1, y1);
+        const Pixel c12 = LegacyGetPixelClipped(_bmp, x1, y2);
+        const Pixel c21 = LegacyGetPixelClipped(_bmp, x2, y1);
+        const Pixel c22 = LegacyGetPixelClipped(_bmp, x2, y2);
+
+        const auto mix = [&](uint8_t Pixel::* _c)
+        {
+            return static_cast<uint8_t>(static_cast<float>(c11.*_c) * w11 + static_cast<float>(c12.*_c) * w12 + static_cast<float>(c21.*_c) * w21 +
+                static_cast<float>(c22.*_c) * w22);
+        };
+        return {mix(&Pixel::r), mix(&Pixel::g), mix(&Pixel::b), mix(&Pixel::a)};
+    }
+
+    // Blit with _bilinear, the whole of _src onto the whole of _dst
+    void LegacyScale(const ToyBitmap& _src, ToyBitmap& _dst)
+    {
+        const float sxPitch = static_cast<float>(_src.m_width) / static_cast<float>(_dst.m_width);
+        const float syPitch = static_cast<float>(_src.m_height) / static_cast<float>(_dst.m_height);
+        float sy = 0.0f;
+        for (int dy = 0; dy < _dst.m_height; ++dy)
+        {
+            float sx = 0.0f;
+            for (int dx = 0; dx < _dst.m_width; ++dx)
+            {
+                _dst.m_pixels[dy * _dst.m_width + dx] = LegacyInterpolatedPixel(_src, sx, sy);
+                sx += sxPitch;
+            }
+            sy += syPitch;
+        }
+    }
+
+    void KernelScale(const ToyBitmap& _src, ToyBitmap& _dst)
+    {
+        const float sxPitch = static_cast<float>(_src.m_width) / static_cast<float>(_dst.m_width);
+        const float syPitch = static_cast<float>(_src.m_height) / static_cast<float>(_dst.m_height);
+        float sy = 0.0f;
+        for (int dy = 0; dy < _dst.m_height; ++dy)
+        {
+            float sx = 0.0f;
+            for (int dx = 0; dx < _dst.m_width; ++dx)
+            {
+                Image::StorePixel(_dst.Bytes() + (dy * _dst.m_width + dx) * 4, Image::Bilinear(_src.Bytes(), _src.m_width, _src.m_height, sx, sy));
+                sx += sxPitch;
+            }
+            sy += syPitch;
+        }
+    }
+
+    int NextPowerOfTwo(int _size)
+    {
+        int size = 1;
+        while (size < _size)
+            size *= 2;
+        return size;
+    }
+
+    // The 2x2 sRGB box filter in doubles, rounded to nearest
+    std::vector<Pixel> ReferenceDownsample(const ToyBitmap& _src)
+    {
+        const auto toLinear = [](int _c)
+        {
+            const double c = _c / 255.0;
+            return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+        };
+        const auto toSrgb = [](double _c)
+        {
+            const double c = _c < 0.0031308 ? _c * 12.92 : 1.055 * std::pow(_c, 1.0 / 2.4) - 0.055;
+            return static_cast<uint8_t>(std::lround(std::clamp(c, 0.0, 1.0) * 255.0));
+        };
+
+        const int w = Image::MipSize(_src.m_width);
+        const int h = Image::MipSize(_src.m_height);
+        std::vector<Pixel> out(static_cast<size_t>(w) * h);
+        for (int y = 0; y < h; ++y)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                double r = 0.0, g = 0.0, b = 0.0, a = 0.0;
+                for (int j = 0; j < 2; ++j)
+                {
+                    for (int i = 0; i < 2; ++i)
+                    {
+                        const int sx = std::min(x * 2 + i, _src.m_width - 1);
+                        const int sy = std::min(y * 2 + j, _src.m_height - 1);
+                        const Pixel& p = _src.m_pixels[sy * _src.m_width + sx];
+                        r += toLinear(p.r);
+                        g += toLinear(p.g);
+                        b += toLinear(p.b);
+                        a += p.a;
+                    }
+                }
+                out[y * w + x] = {toSrgb(r / 4.0), toSrgb(g / 4.0), toSrgb(b / 4.0), static_cast<uint8_t>(std::lround(a / 4.0))};
+            }
+        }
+        return out;
+    }
+
+    int MaxDifference(const std::vector<Pixel>& _a, const uint8_t* _b)
+    {
+        const auto* a = reinterpret_cast<const uint8_t*>(_a.data());
+        int worst = 0;
+        for (size_t i = 0; i < _a.size() * 4; ++i)
+            worst = std::max(worst, std::abs(a[i] - _b[i]));
+        return worst;
+    }
+
+    // The shipped bitmaps and some noise of awkward sizes, for the tails
+    std::vector<ToyBitmap> TestBitmaps()
+    {
+        std::vector<ToyBitmap> bitmaps = LoadShippedBitmaps();
+        bitmaps.push_back(NoiseBitmap(1, 1, 1));
+        bitmaps.push_back(NoiseBitmap(3, 7, 2));
+        bitmaps.push_back(NoiseBitmap(37, 19, 3));
+        bitmaps.push_back(NoiseBitmap(128, 128, 4));
+        return bitmaps;
+    }
+}
+
+TEST_CLASS(ImageKernelsTests)
+{
+public:
+    // --- Filters ------------------------------------------------------------
+
+    TEST_METHOD(GreyScaleMatchesScalar)
+    {
+        for (const ToyBitmap& original : TestBitmaps())
+        {
+            ToyBitmap legacy = original;
+            ToyBitmap kernel = original;
+            LegacyGreyScale(legacy);
+            Image::GreyScale(kernel.Bytes(), static_cast<int>(kernel.m_pixels.size()));
+            Assert::IsTrue(SamePixels(legacy, kernel));
+        }
+    }
+
+    TEST_METHOD(DilateMatchesScalar)
+    {
+        for (const ToyBitmap& original : TestBitmaps())
+        {
+            ToyBitmap legacy = original;
+            ToyBitmap kernel = original;
+            LegacyDilate(legacy);
+            Image::Dilate(original.Bytes(), kernel.Bytes(), kernel.m_width, kernel.m_height);
+            Assert::IsTrue(SamePixels(legacy, kernel));
+        }
+    }
+
+    TEST_METHOD(BlurMatchesScalar)
+    {
+        // 10 is what the cursors use; the small scale leaves dim pixels
+        // contributing nothing, which must still make their neighbours opaque
+        for (const float scale : {10.0f, 1.0f, 0.3f})
+        {
+            for (const ToyBitmap& original : TestBitmaps())
+            {
+                ToyBitmap legacy = original;
+                ToyBitmap kernel = original;
+                LegacyBlur(legacy, scale);
+                Image::Blur(kernel.Bytes(), kernel.m_width, kernel.m_height, scale);
+                Assert::IsTrue(SamePixels(legacy, kernel));
+            }
+        }
+    }
+
+    TEST_METHOD(BilinearMatchesScalar)
+    {
+        Lcg rng(11);
+        for (const ToyBitmap& original : TestBitmaps())
+        {
+            // Anywhere on the image and a little way off it, where the
+            // samples pick up the opaque black of GetPixelClipped
+            for (int i = 0; i < 2000; ++i)
+            {
+                const float x = (rng.NextFloat() * 1.2f - 0.1f) * original.m_width;
+                const float y = (rng.NextFloat() * 1.2f - 0.1f) * original.m_height;
+                const Pixel legacy = LegacyInterpolatedPixel(original, x, y);
+                Pixel kernel;
+                Image::StorePixel(&kernel.r, Image::Bilinear(original.Bytes(), original.m_width, original.m_height, x, y));
+                Assert::IsTrue(std::memcmp(&legacy, &kernel, sizeof(Pixel)) == 0);
+            }
+        }
+    }
+
+    TEST_METHOD(ScaledBlitMatchesScalar)
+    {
+        // As ConvertToTexture scales a bitmap up to a power of two
+        for (const ToyBitmap& original : TestBitmaps())
+        {
+            const int size = NextPowerOfTwo(std::max(original.m_width, original.m_height));
+            ToyBitmap legacy{original.m_name, size, size, std::vector<Pixel>(static_cast<size_t>(size) * size)};
+            ToyBitmap kernel = legacy;
+            LegacyScale(original, legacy);
+            KernelScale(original, kernel);
+            Assert::IsTrue(SamePixels(legacy, kernel));
+        }
+    }
+
+    // --- Mips ---------------------------------------------------------------
+
+    TEST_METHOD(MipCountReachesOnePixel)
+    {
+        Assert::AreEqual(1, Image::MipCount(1, 1));
+        Assert::AreEqual(9, Image::MipCount(256, 256));
+        Assert::AreEqual(10, Image::MipCount(800, 600));
+        Assert::AreEqual(8, Image::MipCount(1, 128));
+
+        std::vector<std::vector<uint8_t>> levels;
+        const ToyBitmap bmp = NoiseBitmap(800, 600, 5);
+        Assert::AreEqual(10, Image::BuildMipChain(bmp.Bytes(), bmp.m_width, bmp.m_height, levels));
+        Assert::AreEqual(size_t{9}, levels.size());
+        Assert::AreEqual(size_t{400 * 300 * 4}, levels[0].size());
+        Assert::AreEqual(size_t{3 * 2 * 4}, levels[7].size());
+        Assert::AreEqual(size_t{4}, levels[8].size());
+    }
+
+    TEST_METHOD(DownsampleAveragesLinearLight)
+    {
+        // A black and white checkerboard is half as bright, which in sRGB
+        // is 188, not the 128 of averaging the stored values
+        ToyBitmap checker{"checker", 4, 4, std::vector<Pixel>(16)};
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                const uint8_t c = (x + y) & 1 ? 255 : 0;
+                checker.m_pixels[y * 4 + x] = {c, c, c, c};
+            }
+        }
+
+        std::vector<Pixel> half(4);
+        Image::DownsampleSrgb(checker.Bytes(), 4, 4, reinterpret_cast<uint8_t*>(half.data()));
+        for (const Pixel& p : half)
+        {
+            Assert::AreEqual(188, static_cast<int>(p.r));
+            Assert::AreEqual(188, static_cast<int>(p.g));
+            Assert::AreEqual(188, static_cast<int>(p.b));
+            Assert::AreEqual(128, static_cast<int>(p.a));
+        }
+    }
+
+    TEST_METHOD(DownsampleMatchesReference)
+    {
+        // Within one step of the filter done in doubles, on every level
+        for (const ToyBitmap& original : TestBitmaps())
+        {
+            ToyBitmap level = original;
+            while (level.m_width > 1 || level.m_height > 1)
+            {
+                const std::vector<Pixel> reference = ReferenceDownsample(level);
+                ToyBitmap next{level.m_name, Image::MipSize(level.m_width), Image::MipSize(level.m_height), std::vector<Pixel>(reference.size())};
+                Image::DownsampleSrgb(level.Bytes(), level.m_width, level.m_height, next.Bytes());
+                Assert::IsTrue(MaxDifference(reference, next.Bytes()) <= 1);
+                level = std::move(next);
+            }
+        }
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_Kernels)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_Kernels)
+    {
+        // Each filter over every shipped bitmap (noise if there are none),
+        // the per-pixel original against the kernel, in Mpixels/s
+        std::vector<ToyBitmap> bitmaps = LoadShippedBitmaps();
+        if (bitmaps.empty())
+            bitmaps.push_back(NoiseBitmap(512, 512, 6));
+
+        double pixels = 0.0;
+        for (const ToyBitmap& bmp : bitmaps)
+            pixels += static_cast<double>(bmp.m_pixels.size());
+
+        constexpr int PASSES = 3;
+        const auto time = [&](auto&& _filter)
+        {
+            std::vector<ToyBitmap> work = bitmaps;
+            const auto start = std::chrono::steady_clock::now();
+            for (int pass = 0; pass < PASSES; ++pass)
+            {
+                for (ToyBitmap& bmp : work)
+                    _filter(bmp);
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return PASSES * pixels / seconds / 1.0e6;
+        };
+
+        const auto report = [](const char* _name, double _old, double _new)
+        {
+            Logger::WriteMessage(std::format("{}: {:.1f} Mpixels/s scalar, {:.1f} Mpixels/s kernel ({:.1f}x)\n", _name, _old, _new, _new / _old).c_str());
+        };
+
+        report("GreyScale", time([](ToyBitmap& _bmp) { LegacyGreyScale(_bmp); }),
+            time([](ToyBitmap& _bmp) { Image::GreyScale(_bmp.Bytes(), static_cast<int>(_bmp.m_pixels.size())); }));
+
+        std::vector<Pixel> copy;
+        report("Dilate", time([](ToyBitmap& _bmp) { LegacyDilate(_bmp); }), time([&](ToyBitmap& _bmp)
+        {
+            copy = _bmp.m_pixels;
+            Image::Dilate(reinterpret_cast<const uint8_t*>(copy.data()), _bmp.Bytes(), _bmp.m_width, _bmp.m_height);
+        }));
+
+        report("Blur", time([](ToyBitmap& _bmp) { LegacyBlur(_bmp, 10.0f); }),
+            time([](ToyBitmap& _bmp) { Image::Blur(_bmp.Bytes(), _bmp.m_width, _bmp.m_height, 10.0f); }));
+
+        ToyBitmap scaled;
+        const auto scaleTo = [&](ToyBitmap& _bmp)
+        {
+            const int size = NextPowerOfTwo(std::max(_bmp.m_width, _bmp.m_height));
+            scaled.m_width = size;
+            scaled.m_height = size;
+            scaled.m_pixels.resize(static_cast<size_t>(size) * size);
+        };
+        report("Bilinear Blit", time([&](ToyBitmap& _bmp) { scaleTo(_bmp); LegacyScale(_bmp, scaled); }),
+            time([&](ToyBitmap& _bmp) { scaleTo(_bmp); KernelScale(_bmp, scaled); }));
+
+        // The mip chain has no scalar original; gluBuild2DMipmaps used to
+        // upload level 0 alone
+        std::vector<std::vector<uint8_t>> levels;
+        const double mips = time([&](ToyBitmap& _bmp) { Image::BuildMipChain(_bmp.Bytes(), _bmp.m_width, _bmp.m_height, levels); });
+        Logger::WriteMessage(std::format("BuildMipChain: {:.1f} Mpixels/s of level 0\n", mips).c_str());
+    }
+};
@@ -0,0 +1,187 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+TEST_CLASS(JobSystemTests)
+{
+public:
+
+    // --- Dependencies -------------------------------------------------------
+
+    TEST_METHOD(Dependencies_DiamondRunsInOrder)
+    {
+        JobSystem jobs(4);
+        for (int round = 0; round < 200; ++round)
+        {
+            std::atomic<int> clock = 0;
+            int a = -1, b = -1, c = -1, d = -1;
+            JobHandle top = jobs.Submit([&] { a = clock++; });
+            JobHandle left = jobs.Submit([&] { b = clock++; }, {top});
+            JobHandle right = jobs.Submit([&] { c = clock++; }, {top});
+            JobHandle bottom = jobs.Submit([&] { d = clock++; }, {left, right});
+            jobs.Wait(bottom);
+
+            Assert::AreEqual(0, a);
+            Assert::IsTrue(b > a && c > a);
+            Assert::AreEqual(3, d);
+        }
+    }
+
+    TEST_METHOD(Dependencies_ChainAndFanIn)
+    {
+        constexpr int CHAIN = 300;
+        constexpr int FAN = 64;
+
+        JobSystem jobs(6);
+        std::vector<int> order;
+        JobHandle previous;
+        for (int i = 0; i < CHAIN; ++i)
+            previous = jobs.Submit([&order, i] { order.push_back(i); }, {previous});
+
+        std::atomic<int> finished = 0;
+        std::vector<JobHandle> fan;
+        for (int i = 0; i < FAN; ++i)
+            fan.push_back(jobs.Submit([&] { ++finished; }, {previous}));
+
+        int seenByLast = -1;
+        jobs.Wait(jobs.Submit([&] { seenByLast = finished; }, fan));
+
+        Assert::AreEqual(FAN, seenByLast);
+        Assert::AreEqual(static_cast<size_t>(CHAIN), order.size());
+        for (int i = 0; i < CHAIN; ++i)
+            Assert::AreEqual(i, order[i]);
+    }
+
+    TEST_METHOD(Dependencies_FinishedOrEmptyHandlesDoNotBlock)
+    {
+        JobSystem jobs(2);
+        JobHandle done = jobs.Submit([] {});
+        jobs.Wait(done);
+
+        bool ran = false;
+        jobs.Wait(jobs.Submit([&] { ran = true; }, {done, JobHandle()}));
+        Assert::IsTrue(ran);
+        Assert::IsTrue(JobHandle().IsFinished());
+    }
+
+    // --- ParallelFor --------------------------------------------------------
+
+    TEST_METHOD(ParallelFor_VisitsEveryIndexOnce)
+    {
+        JobSystem jobs(4);
+        for (int grain : {1, 3, 64, 5000})
+        {
+            std::vector<std::atomic<int>> visits(1001);
+            jobs.ParallelFor(-1, 1000, grain, [&](int _index) { ++visits[_index + 1]; });
+            for (const std::atomic<int>& count : visits)
+                Assert::AreEqual(1, count.load());
+        }
+    }
+
+    TEST_METHOD(ParallelFor_NestedInsideJobs)
+    {
+        JobSystem jobs(3);
+        std::atomic<int> total = 0;
+        jobs.ParallelFor(0, 16, 1, [&](int) {
+            jobs.ParallelFor(0, 100, 7, [&](int _index) { total += _index; });
+        });
+        Assert::AreEqual(16 * 4950, total.load());
+    }
+
+    TEST_METHOD(ParallelFor_WithoutJobSystemRunsInOrder)
+    {
+        std::vector<int> order;
+        ParallelFor(nullptr, 0, 10, 4, [&](int _index) { order.push_back(_index); });
+        Assert::AreEqual(static_cast<size_t>(10), order.size());
+        for (int i = 0; i < 10; ++i)
+            Assert::AreEqual(i, order[i]);
+    }
+
+    // --- Scratch ------------------------------------------------------------
+
+    TEST_METHOD(Scratch_AlignedPrivateAndReused)
+    {
+        JobSystem jobs(4);
+        std::atomic<bool> corrupted = false;
+        jobs.ParallelFor(0, 256, 1, [&](int _index) {
+            auto* values = JobSystem::AllocateScratch<int>(1000 + _index);
+            auto* wide = JobSystem::AllocateScratch(24, 64);
+            if (reinterpret_cast<uintptr_t>(values) % alignof(int) != 0 || reinterpret_cast<uintptr_t>(wide) % 64 != 0)
+                corrupted = true;
+            for (int i = 0; i < 1000 + _index; ++i)
+                values[i] = _index;
+            std::this_thread::yield();
+            for (int i = 0; i < 1000 + _index; ++i)
+                corrupted = corrupted || values[i] != _index;
+        });
+        Assert::IsFalse(corrupted.load());
+
+        void* first;
+        {
+            JobSystem::ScratchScope scope;
+            first = JobSystem::AllocateScratch(1024);
+            (void)JobSystem::AllocateScratch(1024 * 1024);
+        }
+        JobSystem::ScratchScope scope;
+        Assert::IsTrue(first == JobSystem::AllocateScratch(1024));
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_SchedulerOverhead)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_SchedulerOverhead)
+    {
+        // Cost of the scheduler itself: empty jobs submitted and waited on,
+        // and a ParallelFor over items too cheap to be worth splitting,
+        // against the same loop run directly.
+        constexpr int JOBS = 100000;
+        constexpr int ITEMS = 1 << 20;
+        constexpr int REPEATS = 20;
+
+        JobSystem jobs;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<JobHandle> handles(JOBS);
+        for (JobHandle& handle : handles)
+            handle = jobs.Submit([] {});
+        for (const JobHandle& handle : handles)
+            jobs.Wait(handle);
+        const double independent = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        JobHandle previous;
+        for (int i = 0; i < JOBS; ++i)
+            previous = jobs.Submit([] {}, {previous});
+        jobs.Wait(previous);
+        const double chained = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<float> values(ITEMS, 1.0f);
+        auto body = [&](int _index) { values[_index] = values[_index] * 0.999f + 0.001f; };
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; ++r)
+        {
+            for (int i = 0; i < ITEMS; ++i)
+                body(i);
+        }
+        const double serial = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < REPEATS; ++r)
+            jobs.ParallelFor(0, ITEMS, 4096, body);
+        const double parallel = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+
+        start = std::chrono::steady_clock::now();
+        for (int r = 0; r < JOBS / 10; ++r)
+            jobs.ParallelFor(0, jobs.GetNumWorkers(), 1, [](int) {});
+        const double emptyFor = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / (JOBS / 10);
+
+        Logger::WriteMessage(std::format("{} workers: {:.0f} ns per independent job, {:.0f} ns per chained job, {:.2f} us per empty ParallelFor; "
+            "{} items serial {:.2f} ms, ParallelFor {:.2f} ms ({:.1f}x)\n",
+            jobs.GetNumWorkers(), independent * 1.0e9 / JOBS, chained * 1.0e9 / JOBS, emptyFor * 1.0e6,
+            ITEMS, serial * 1.0e3, parallel * 1.0e3, serial / parallel).c_str());
+    }
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+// The subset of the Visual Studio Native Unit Test Framework that the
+// NetLib tests use, so that the Linux build runs the same test sources.
+// TEST_CLASS and TEST_METHOD register each method; TestMain.cpp runs them
+// all and fails if any Assert does.
+
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Microsoft::VisualStudio::CppUnitTestFramework
+{
+  struct TestMethodInfo
+  {
+    std::string m_name;
+    std::function<void()> m_run;
+  };
+
+  inline std::vector<TestMethodInfo>& GetTestMethods()
+  {
+    static std::vector<TestMethodInfo> methods;
+    return methods;
+  }
+
+  inline bool RegisterTestMethod(const char* _className, const char* _methodName, void (*_run)())
+  {
+    GetTestMethods().push_back({std::string(_className) + "::" + _methodName, _run});
+    return true;
+  }
+
+  class Assert
+  {
+  public:
+    template <class T>
+    static void AreEqual(const T& _expected, const T& _actual, const wchar_t* = nullptr)
+    {
+      if (!(_expected == _actual))
+        throw std::runtime_error("Assert::AreEqual failed");
+    }
+
+    static void AreEqual(double _expected, double _actual, double _tolerance, const wchar_t* = nullptr)
+    {
+      if (std::fabs(_expected - _actual) > _tolerance)
+        throw std::runtime_error("Assert::AreEqual failed");
+    }
+
+    static void IsTrue(bool _condition, const wchar_t* = nullptr)
+    {
+      if (!_condition)
+        throw std::runtime_error("Assert::IsTrue failed");
+    }
+
+    static void IsFalse(bool _condition, const wchar_t* = nullptr)
+    {
+      if (_condition)
+        throw std::runtime_error("Assert::IsFalse failed");
+    }
+
+    template <class T>
+    static void IsNull(const T* _pointer, const wchar_t* = nullptr)
+    {
+      if (_pointer)
+        throw std::runtime_error("Assert::IsNull failed");
+    }
+
+    template <class T>
+    static void IsNotNull(const T* _pointer, const wchar_t* = nullptr)
+    {
+      if (!_pointer)
+        throw std::runtime_error("Assert::IsNotNull failed");
+    }
+
+    static void Fail(const wchar_t* = nullptr) { throw std::runtime_error("Assert::Fail"); }
+  };
+
+  class Logger
+  {
+  public:
+    static void WriteMessage(const char* _message) { fputs(_message, stdout); }
+  };
+}
+
+// A method's body is a complete-class context, so the runner each
+// TEST_METHOD registers can call the method it declares next
+#define TEST_CLASS(className) \
+  class className; \
+  class className##_Base { protected: using TestClassType = className; static constexpr const char* TestClassName = #className; }; \
+  class className : public className##_Base
+
+#define TEST_METHOD(methodName) \
+  static void methodName##_Run() { TestClassType().methodName(); } \
+  static inline const bool methodName##_Registered = ::Microsoft::VisualStudio::CppUnitTestFramework::RegisterTestMethod(TestClassName, #methodName, &methodName##_Run); \
+  void methodName()
@@ -0,0 +1,25 @@
+#include "CppUnitTest.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// Runs every registered test method; the exit code is the number that failed
+int main()
+{
+  int failed = 0;
+  for (const TestMethodInfo& method : GetTestMethods())
+  {
+    try
+    {
+      method.m_run();
+      printf("Passed %s\n", method.m_name.c_str());
+    }
+    catch (const std::exception& e)
+    {
+      ++failed;
+      printf("FAILED %s: %s\n", method.m_name.c_str(), e.what());
+    }
+  }
+
+  printf("%zu tests, %d failed\n", GetTestMethods().size(), failed);
+  return failed;
+}
@@ -0,0 +1,223 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // Stand-in for GameContext: the per-match state a simulation reaches
+    // through a thread-local pointer rather than through its arguments.
+    struct ToyContext
+    {
+        uint32_t m_random = 1;
+        int m_nextId = 0;
+        SyncChecksum m_checksum;
+    };
+
+    thread_local ToyContext* t_context = nullptr;
+
+    struct ToyContextScope
+    {
+        explicit ToyContextScope(ToyContext* _context) : m_previous(t_context) { t_context = _context; }
+        ~ToyContextScope() { t_context = m_previous; }
+        ToyContext* m_previous;
+    };
+
+    float ToyRandom()
+    {
+        t_context->m_random = t_context->m_random * 1664525u + 1013904223u;
+        return static_cast<float>(t_context->m_random >> 8) / 16777216.0f;
+    }
+
+    // A match: objects that wander, die and respawn, folding their state
+    // into the match's checksum every tick.
+    class ToyMatch
+    {
+    public:
+        ToyMatch(uint32_t _seed, int _numObjects)
+        {
+            m_context.m_random = _seed;
+            ToyContextScope scope(&m_context);
+            m_objects.resize(_numObjects);
+            for (Object& object : m_objects)
+                Spawn(object);
+        }
+
+        void Advance()
+        {
+            ToyContextScope scope(&m_context);
+            for (Object& object : m_objects)
+            {
+                object.m_x += object.m_vx;
+                object.m_z += object.m_vz;
+                object.m_vx += (ToyRandom() - 0.5f) * 0.1f;
+                object.m_vz += (ToyRandom() - 0.5f) * 0.1f;
+                if (--object.m_life <= 0)
+                    Spawn(object);
+                t_context->m_checksum.Update(object.m_syncContribution,
+                    SyncHasher().Fold(object.m_id).Fold(object.m_x).Fold(object.m_z).Fold(object.m_life).Value());
+            }
+            ++m_ticks;
+        }
+
+        [[nodiscard]] uint64_t GetChecksum() const { return m_context.m_checksum.Value(); }
+        [[nodiscard]] int GetTicks() const { return m_ticks; }
+
+    private:
+        struct Object
+        {
+            int m_id = 0;
+            float m_x = 0.0f, m_z = 0.0f;
+            float m_vx = 0.0f, m_vz = 0.0f;
+            int m_life = 0;
+            uint64_t m_syncContribution = 0;
+        };
+
+        static void Spawn(Object& _object)
+        {
+            _object.m_id = ++t_context->m_nextId;
+            _object.m_x = ToyRandom() * 1000.0f;
+            _object.m_z = ToyRandom() * 1000.0f;
+            _object.m_vx = ToyRandom() - 0.5f;
+            _object.m_vz = ToyRandom() - 0.5f;
+            _object.m_life = 20 + static_cast<int>(ToyRandom() * 200.0f);
+        }
+
+        ToyContext m_context;
+        std::vector<Object> m_objects;
+        int m_ticks = 0;
+    };
+
+    // Seconds per AdvanceAll with _numMatches matches on _numWorkers threads
+    double MeasureTick(int _numWorkers, int _numMatches, int _objectsPerMatch, int _ticks)
+    {
+        std::vector<std::unique_ptr<ToyMatch>> matches;
+        MatchHost host(_numWorkers);
+        for (int m = 0; m < _numMatches; ++m)
+        {
+            matches.push_back(std::make_unique<ToyMatch>(m + 1, _objectsPerMatch));
+            host.AddMatch([match = matches.back().get()] { match->Advance(); });
+        }
+
+        host.AdvanceAll(); // Warm up
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < _ticks; ++t)
+            host.AdvanceAll();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / _ticks;
+    }
+}
+
+TEST_CLASS(MatchHostTests)
+{
+public:
+
+    // --- Scheduling ---------------------------------------------------------
+
+    TEST_METHOD(AdvanceAll_RunsEveryMatchOncePerTick)
+    {
+        constexpr int MATCHES = 97;
+        constexpr int TICKS = 200;
+
+        std::vector<int> counts(MATCHES, 0);
+        std::vector<std::atomic<int>> inFlight(MATCHES);
+        std::atomic<bool> overlapped = false;
+
+        MatchHost host(4);
+        for (int m = 0; m < MATCHES; ++m)
+        {
+            host.AddMatch([&, m] {
+                if (inFlight[m].fetch_add(1) != 0)
+                    overlapped = true;
+                ++counts[m];
+                inFlight[m].fetch_sub(1);
+            });
+        }
+
+        for (int t = 0; t < TICKS; ++t)
+        {
+            host.AdvanceAll();
+            for (int m = 0; m < MATCHES; ++m)
+                Assert::AreEqual(t + 1, counts[m]);
+        }
+        Assert::IsFalse(overlapped.load());
+        Assert::AreEqual(4, host.GetNumWorkers());
+    }
+
+    TEST_METHOD(RemoveMatch_StopsAdvancingAndSlotIsReused)
+    {
+        int a = 0, b = 0, c = 0;
+        MatchHost host(2);
+        host.AddMatch([&] { ++a; });
+        int slot = host.AddMatch([&] { ++b; });
+        host.AdvanceAll();
+        host.RemoveMatch(slot);
+        host.AdvanceAll();
+        Assert::AreEqual(1, host.GetNumMatches());
+        Assert::AreEqual(slot, host.AddMatch([&] { ++c; }));
+        host.AdvanceAll();
+
+        Assert::AreEqual(3, a);
+        Assert::AreEqual(1, b);
+        Assert::AreEqual(1, c);
+    }
+
+    // --- Isolation ----------------------------------------------------------
+
+    TEST_METHOD(HostedMatches_MatchSerialRuns)
+    {
+        // Matches hop between threads every tick; each must still see only
+        // its own context, so its checksum matches running it alone.
+        constexpr int MATCHES = 24;
+        constexpr int TICKS = 300;
+
+        std::vector<std::unique_ptr<ToyMatch>> hosted;
+        MatchHost host(6);
+        for (int m = 0; m < MATCHES; ++m)
+        {
+            hosted.push_back(std::make_unique<ToyMatch>(1000 + m, 64));
+            host.AddMatch([match = hosted.back().get()] { match->Advance(); });
+        }
+        for (int t = 0; t < TICKS; ++t)
+            host.AdvanceAll();
+
+        for (int m = 0; m < MATCHES; ++m)
+        {
+            ToyMatch alone(1000 + m, 64);
+            for (int t = 0; t < TICKS; ++t)
+                alone.Advance();
+            Assert::AreEqual(TICKS, hosted[m]->GetTicks());
+            Assert::AreEqual(alone.GetChecksum(), hosted[m]->GetChecksum());
+        }
+        Assert::IsNull(t_context);
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_MatchesPerCore)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_MatchesPerCore)
+    {
+        // ToyMatches at the server's 10 Hz tick.  A tick's cost is measured
+        // for one match on one thread, then for many matches on every core;
+        // capacity is how many matches fit in the tick budget.  This measures
+        // the host's scheduling and scaling, not what a real Location costs;
+        // the MatchHostCheckAt preference measures that in game.
+        constexpr double TICK_PERIOD = 0.1;
+        constexpr int OBJECTS = 4000;
+        constexpr int TICKS = 20;
+
+        const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        const int matches = cores * 8;
+
+        const double single = MeasureTick(1, 1, OBJECTS, TICKS);
+        const double pooled = MeasureTick(cores, matches, OBJECTS, TICKS);
+
+        const double perCoreSerial = TICK_PERIOD / single;
+        const double perCorePooled = TICK_PERIOD / pooled * matches / cores;
+        Logger::WriteMessage(std::format("{} objects per match at {:.0f} Hz: one match {:.2f} ms/tick; {} matches on {} cores {:.2f} ms/tick; "
+            "{:.0f} matches per core serial, {:.0f} pooled ({:.0f}% scaling)\n",
+            OBJECTS, 1.0 / TICK_PERIOD, single * 1.0e3, matches, cores, pooled * 1.0e3, perCoreSerial, perCorePooled,
+            100.0 * perCorePooled / perCoreSerial).c_str());
+    }
+};
@@ -0,0 +1,312 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+    constexpr unsigned short RECEIVE_PORT = 47111;
+    constexpr unsigned short SEND_PORT = 47112;
+
+    std::mutex s_receivedLock;
+    std::vector<int> s_received;    // Payloads in arrival order
+
+    NetCallBackRetType OnPacket(NetUdpPacket* _packet)
+    {
+        int value = 0;
+        memcpy(&value, _packet->m_data, sizeof(value));
+        {
+            std::scoped_lock lock(s_receivedLock);
+            s_received.push_back(value);
+        }
+        delete _packet;
+        return 0;
+    }
+
+    NetIpAddress LoopbackAddress(unsigned short _port)
+    {
+        NetIpAddress address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(_port);
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        return address;
+    }
+
+    int NumReceived()
+    {
+        std::scoped_lock lock(s_receivedLock);
+        return static_cast<int>(s_received.size());
+    }
+
+    bool WaitForPackets(int _count)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (NumReceived() < _count && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return NumReceived() == _count;
+    }
+
+    // Sends _count consecutive ints through an impaired listener, one every
+    // _spacingMs, and returns what arrived in arrival order
+    std::vector<int> SendThrough(const NetImpairmentConfig& _config, int _count, int _spacingMs, int _expected)
+    {
+        NetLib netLib;
+        Assert::IsTrue(netLib.Initialise());
+        {
+            std::scoped_lock lock(s_receivedLock);
+            s_received.clear();
+        }
+
+        NetSocketListener receiver(RECEIVE_PORT);
+        Assert::IsTrue(receiver.Bind() == NetOk);
+        std::thread listenThread([&receiver] { receiver.StartListening(OnPacket); });
+
+        NetImpairment impairment(_config);
+        {
+            NetSocketListener sender(SEND_PORT);
+            Assert::IsTrue(sender.Bind() == NetOk);
+            sender.SetImpairment(&impairment);
+
+            NetIpAddress to = LoopbackAddress(RECEIVE_PORT);
+            for (int i = 0; i < _count; ++i)
+            {
+                Assert::IsTrue(sender.SendTo(&to, &i, sizeof(i)) == NetOk);
+                if (_spacingMs > 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(_spacingMs));
+            }
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (impairment.GetNumPending() > 0 && std::chrono::steady_clock::now() < deadline)
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        WaitForPackets(_expected);
+        receiver.StopListening();
+        listenThread.join();
+
+        std::scoped_lock lock(s_receivedLock);
+        return s_received;
+    }
+}
+
+TEST_CLASS(NetImpairmentTests)
+{
+public:
+
+    // --- Planning -----------------------------------------------------------
+
+    TEST_METHOD(Plan_PassesEverythingWhenUnimpaired)
+    {
+        NetImpairmentConfig config;
+        Assert::IsFalse(config.IsImpaired());
+
+        NetImpairment impairment(config);
+        for (int i = 0; i < 1000; ++i)
+        {
+            NetImpairmentFate fate = impairment.Plan();
+            Assert::AreEqual(1, fate.m_numCopies);
+            Assert::AreEqual(0, fate.m_delayMs[0]);
+            Assert::IsFalse(fate.m_reordered);
+        }
+    }
+
+    TEST_METHOD(Plan_IsDeterministicForASeed)
+    {
+        NetImpairmentConfig config;
+        config.m_lossPercent = 20.0f;
+        config.m_duplicatePercent = 10.0f;
+        config.m_reorderPercent = 10.0f;
+        config.m_latencyMs = 50;
+        config.m_jitterMs = 30;
+        config.m_seed = 1234;
+
+        NetImpairment a(config);
+        NetImpairment b(config);
+        config.m_seed = 4321;
+        NetImpairment other(config);
+
+        int differences = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            NetImpairmentFate fateA = a.Plan();
+            NetImpairmentFate fateB = b.Plan();
+            NetImpairmentFate fateOther = other.Plan();
+
+            Assert::AreEqual(fateA.m_numCopies, fateB.m_numCopies);
+            Assert::AreEqual(fateA.m_reordered, fateB.m_reordered);
+            for (int c = 0; c < fateA.m_numCopies; ++c)
+                Assert::AreEqual(fateA.m_delayMs[c], fateB.m_delayMs[c]);
+
+            if (fateA.m_numCopies != fateOther.m_numCopies || (fateA.m_numCopies > 0 && fateA.m_delayMs[0] != fateOther.m_delayMs[0]))
+                ++differences;
+        }
+        Assert::IsTrue(differences > 500);
+    }
+
+    TEST_METHOD(Plan_MatchesConfiguredRates)
+    {
+        NetImpairmentConfig config;
+        config.m_lossPercent = 10.0f;
+        config.m_duplicatePercent = 5.0f;
+        config.m_reorderPercent = 20.0f;
+        config.m_latencyMs = 40;
+        config.m_jitterMs = 20;
+        config.m_reorderMs = 100;
+        NetImpairment impairment(config);
+
+        constexpr int COUNT = 100000;
+        int lost = 0;
+        int duplicated = 0;
+        int reordered = 0;
+        for (int i = 0; i < COUNT; ++i)
+        {
+            NetImpairmentFate fate = impairment.Plan();
+            if (fate.m_numCopies == 0)
+            {
+                ++lost;
+                continue;
+            }
+
+            duplicated += fate.m_numCopies - 1;
+            reordered += fate.m_reordered ? 1 : 0;
+            for (int c = 0; c < fate.m_numCopies; ++c)
+            {
+                int delay = fate.m_delayMs[c] - ((c == 0 && fate.m_reordered) ? config.m_reorderMs : 0);
+                Assert::IsTrue(delay >= config.m_latencyMs && delay <= config.m_latencyMs + config.m_jitterMs);
+            }
+        }
+
+        // Rates of what survived loss
+        const int survived = COUNT - lost;
+        Assert::AreEqual(10.0, 100.0 * lost / COUNT, 0.5);
+        Assert::AreEqual(5.0, 100.0 * duplicated / survived, 0.5);
+        Assert::AreEqual(20.0, 100.0 * reordered / survived, 0.5);
+    }
+
+    TEST_METHOD(Plan_OtherRatesDoNotReshuffleLoss)
+    {
+        NetImpairmentConfig config;
+        config.m_lossPercent = 30.0f;
+        NetImpairment plain(config);
+
+        config.m_duplicatePercent = 50.0f;
+        config.m_jitterMs = 100;
+        NetImpairment busy(config);
+
+        for (int i = 0; i < 1000; ++i)
+            Assert::AreEqual(plain.Plan().m_numCopies == 0, busy.Plan().m_numCopies == 0);
+    }
+
+    // --- Delivery over loopback ---------------------------------------------
+
+    TEST_METHOD(Send_LosesAndDuplicatesAsPlanned)
+    {
+        NetImpairmentConfig config;
+        config.m_lossPercent = 25.0f;
+        config.m_duplicatePercent = 25.0f;
+        config.m_seed = 99;
+
+        // Replay the same seed to know what should arrive
+        NetImpairment planner(config);
+        constexpr int COUNT = 200;
+        std::vector<int> expected(COUNT, 0);
+        int expectedTotal = 0;
+        for (int i = 0; i < COUNT; ++i)
+        {
+            expected[i] = planner.Plan().m_numCopies;
+            expectedTotal += expected[i];
+        }
+
+        std::vector<int> received = SendThrough(config, COUNT, 0, expectedTotal);
+        Assert::AreEqual(expectedTotal, static_cast<int>(received.size()));
+        for (int i = 0; i < COUNT; ++i)
+            Assert::AreEqual(expected[i], static_cast<int>(std::ranges::count(received, i)));
+    }
+
+    TEST_METHOD(Send_ReorderedDatagramsAreOvertaken)
+    {
+        NetImpairmentConfig config;
+        config.m_reorderPercent = 30.0f;
+        config.m_reorderMs = 40;
+        config.m_latencyMs = 5;
+
+        constexpr int COUNT = 40;
+        std::vector<int> received = SendThrough(config, COUNT, 2, COUNT);
+        Assert::AreEqual(COUNT, static_cast<int>(received.size()));
+
+        std::vector<int> sorted = received;
+        std::ranges::sort(sorted);
+        for (int i = 0; i < COUNT; ++i)
+            Assert::AreEqual(i, sorted[i]);
+        Assert::IsFalse(std::ranges::is_sorted(received));
+    }
+
+    TEST_METHOD(Send_DelaysByTheConfiguredLatency)
+    {
+        NetImpairmentConfig config;
+        config.m_latencyMs = 60;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<int> received = SendThrough(config, 1, 0, 1);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        Assert::AreEqual(1, static_cast<int>(received.size()));
+        Assert::IsTrue(elapsed.count() >= 60);
+    }
+
+    TEST_METHOD(Forget_DiscardsQueuedDatagrams)
+    {
+        NetLib netLib;
+        Assert::IsTrue(netLib.Initialise());
+
+        NetImpairmentConfig config;
+        config.m_latencyMs = 10000;
+        NetImpairment impairment(config);
+        {
+            NetSocketListener sender(SEND_PORT);
+            Assert::IsTrue(sender.Bind() == NetOk);
+            sender.SetImpairment(&impairment);
+
+            NetIpAddress to = LoopbackAddress(RECEIVE_PORT);
+            int value = 7;
+            for (int i = 0; i < 10; ++i)
+                sender.SendTo(&to, &value, sizeof(value));
+            Assert::AreEqual(10, impairment.GetNumPending());
+        }
+
+        // Closing the sender forgot everything it had queued
+        Assert::AreEqual(0, impairment.GetNumPending());
+        Assert::AreEqual(10LL, impairment.GetStats().m_datagrams);
+        Assert::AreEqual(0LL, impairment.GetStats().m_delivered);
+    }
+
+    // --- Polling ------------------------------------------------------------
+
+    TEST_METHOD(Poll_ReceivesOnABoundAddress)
+    {
+        NetLib netLib;
+        Assert::IsTrue(netLib.Initialise());
+
+        NetSocketListener receiver(RECEIVE_PORT, "127.0.0.1");
+        Assert::IsTrue(receiver.Bind() == NetOk);
+        Assert::IsNull(receiver.Poll());
+
+        NetSocketListener sender(SEND_PORT);
+        Assert::IsTrue(sender.Bind() == NetOk);
+        NetIpAddress to = LoopbackAddress(RECEIVE_PORT);
+        int value = 42;
+        Assert::IsTrue(sender.SendTo(&to, &value, sizeof(value)) == NetOk);
+
+        NetUdpPacket* packet = nullptr;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (!packet && std::chrono::steady_clock::now() < deadline)
+            packet = receiver.Poll();
+
+        Assert::IsNotNull(packet);
+        Assert::AreEqual(static_cast<int>(sizeof(int)), packet->m_length);
+        int received = 0;
+        memcpy(&received, packet->m_data, sizeof(received));
+        Assert::AreEqual(42, received);
+        Assert::AreEqual(static_cast<int>(htons(SEND_PORT)), static_cast<int>(packet->m_clientAddress.sin_port));
+        delete packet;
+    }
+};
@@ -0,0 +1,119 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+    constexpr unsigned short RECEIVE_PORT = 47101;
+    constexpr unsigned short SEND_PORT = 47102;
+
+    std::atomic<int> s_received;
+    std::atomic<int> s_payloadSum;
+
+    NetCallBackRetType OnPacket(NetUdpPacket* _packet)
+    {
+        int value = 0;
+        memcpy(&value, _packet->m_data, sizeof(value));
+        s_payloadSum += value;
+        ++s_received;
+        delete _packet;
+        return 0;
+    }
+
+    NetIpAddress LoopbackAddress(unsigned short _port)
+    {
+        NetIpAddress address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(_port);
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        return address;
+    }
+
+    bool WaitForPackets(int _count)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (s_received < _count && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        return s_received == _count;
+    }
+}
+
+TEST_CLASS(NetLoopbackTests)
+{
+public:
+
+    // --- NetUdpPacket pool --------------------------------------------------
+
+    TEST_METHOD(PacketPool_ReusesFreedPacket)
+    {
+        auto* first = new NetUdpPacket();
+        auto firstAddress = reinterpret_cast<uintptr_t>(first);
+        delete first;
+
+        auto* second = new NetUdpPacket();
+        Assert::AreEqual(firstAddress, reinterpret_cast<uintptr_t>(second));
+        delete second;
+    }
+
+    // --- NetSocketListener --------------------------------------------------
+
+    TEST_METHOD(Listener_ReceivesSendBatch)
+    {
+        NetLib netLib;
+        Assert::IsTrue(netLib.Initialise());
+        s_received = 0;
+        s_payloadSum = 0;
+
+        NetSocketListener receiver(RECEIVE_PORT);
+        Assert::IsTrue(receiver.Bind() == NetOk);
+        std::thread listenThread([&receiver] { receiver.StartListening(OnPacket); });
+
+        constexpr int COUNT = 200;
+        NetIpAddress to = LoopbackAddress(RECEIVE_PORT);
+        int payloads[COUNT];
+        NetDatagram datagrams[COUNT];
+        int expectedSum = 0;
+        for (int i = 0; i < COUNT; ++i)
+        {
+            payloads[i] = i;
+            expectedSum += i;
+            datagrams[i] = { &to, reinterpret_cast<const char*>(&payloads[i]), static_cast<int>(sizeof(int)) };
+        }
+
+        NetSocketListener sender(SEND_PORT);
+        Assert::IsTrue(sender.Bind() == NetOk);
+        Assert::AreEqual(COUNT, sender.SendBatch(datagrams, COUNT));
+
+        bool allArrived = WaitForPackets(COUNT);
+        receiver.StopListening();
+        listenThread.join();
+
+        Assert::IsTrue(allArrived);
+        Assert::AreEqual(expectedSum, s_payloadSum.load());
+    }
+
+    TEST_METHOD(Listener_ReceivesFromNetSocket)
+    {
+        NetLib netLib;
+        Assert::IsTrue(netLib.Initialise());
+        s_received = 0;
+        s_payloadSum = 0;
+
+        NetSocketListener receiver(RECEIVE_PORT);
+        Assert::IsTrue(receiver.Bind() == NetOk);
+        std::thread listenThread([&receiver] { receiver.StartListening(OnPacket); });
+
+        NetSocket socket;
+        char host[] = "127.0.0.1";
+        Assert::IsTrue(socket.Connect(host, RECEIVE_PORT) == NetOk);
+        int value = 42;
+        Assert::IsTrue(socket.WriteData(&value, sizeof(value)) == NetOk);
+
+        bool arrived = WaitForPackets(1);
+        receiver.StopListening();
+        listenThread.join();
+
+        Assert::IsTrue(arrived);
+        Assert::AreEqual(42, s_payloadSum.load());
+    }
+};
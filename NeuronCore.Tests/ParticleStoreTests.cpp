@@ -0,0 +1,328 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    constexpr float STEP = 0.1f;   // SERVER_ADVANCE_PERIOD
+
+    // The particle as ParticleSystem kept it before the store: one object per
+    // particle, advanced with scalar maths in the same order of operations
+    struct ToyParticle
+    {
+        float m_pos[3];
+        float m_vel[3];
+        float m_friction;
+        float m_gravity;
+        float m_deathTime;
+        float m_size;
+
+        void Advance()
+        {
+            for (int k = 0; k < 3; ++k)
+                m_pos[k] += m_vel[k] * STEP;
+            float amount = STEP * m_friction;
+            for (int k = 0; k < 3; ++k)
+                m_vel[k] *= (1.0f - amount);
+            if (m_gravity != 0.0f)
+                m_vel[1] -= STEP * m_gravity;
+        }
+    };
+
+    ToyParticle RandomToy(Lcg& _rng, float _now)
+    {
+        ToyParticle p;
+        for (int k = 0; k < 3; ++k)
+        {
+            p.m_pos[k] = _rng.Range(-1000.0f, 1000.0f);
+            p.m_vel[k] = _rng.Range(-50.0f, 50.0f);
+        }
+        p.m_friction = _rng.Range(0.0f, 2.0f);
+        p.m_gravity = _rng.NextFloat() < 0.5f ? 0.0f : _rng.Range(1.0f, 20.0f);
+        p.m_deathTime = _now + _rng.Range(0.5f, 5.0f);
+        p.m_size = _rng.Range(1.0f, 30.0f);
+        return p;
+    }
+
+    ParticleSpawn ToSpawn(const ToyParticle& _p, uint8_t _priority = 0)
+    {
+        ParticleSpawn spawn;
+        spawn.m_pos = XMFLOAT3(_p.m_pos[0], _p.m_pos[1], _p.m_pos[2]);
+        spawn.m_vel = XMFLOAT3(_p.m_vel[0], _p.m_vel[1], _p.m_vel[2]);
+        spawn.m_damping = 1.0f - STEP * _p.m_friction;
+        spawn.m_gravityStep = STEP * _p.m_gravity;
+        spawn.m_deathTime = _p.m_deathTime;
+        spawn.m_size = _p.m_size;
+        spawn.m_priority = _priority;
+        return spawn;
+    }
+
+    ParticleSpawn Tagged(int _tag, uint8_t _priority = 0, float _deathTime = 100.0f)
+    {
+        ParticleSpawn spawn;
+        spawn.m_pos = XMFLOAT3(static_cast<float>(_tag), 0.0f, 0.0f);
+        spawn.m_vel = XMFLOAT3(0.0f, 0.0f, 0.0f);
+        spawn.m_colour = static_cast<uint32_t>(_tag);
+        spawn.m_deathTime = _deathTime;
+        spawn.m_priority = _priority;
+        return spawn;
+    }
+
+    std::vector<uint32_t> Tags(const ParticleStore& _store)
+    {
+        std::vector<uint32_t> tags;
+        for (int i = 0; i < _store.Count(); ++i)
+            tags.push_back(_store.GetColour(i));
+        std::ranges::sort(tags);
+        return tags;
+    }
+
+    bool SameBits(float _a, float _b) { return std::bit_cast<uint32_t>(_a) == std::bit_cast<uint32_t>(_b); }
+}
+
+TEST_CLASS(ParticleStoreTests)
+{
+public:
+
+    // --- Storage ------------------------------------------------------------
+
+    TEST_METHOD(Spawn_StoresEveryField)
+    {
+        ParticleStore store(8);
+        ParticleSpawn spawn;
+        spawn.m_pos = XMFLOAT3(1.0f, 2.0f, 3.0f);
+        spawn.m_vel = XMFLOAT3(4.0f, 5.0f, 6.0f);
+        spawn.m_deathTime = 7.0f;
+        spawn.m_size = 8.0f;
+        spawn.m_colour = 0xAABBCCDD;
+        spawn.m_type = 9;
+        spawn.m_priority = 2;
+
+        Assert::AreEqual(0, store.Spawn(spawn));
+        Assert::AreEqual(1, store.Count());
+        Assert::AreEqual(2.0f, store.GetPos(0).y);
+        Assert::AreEqual(6.0f, store.GetVel(0).z);
+        Assert::AreEqual(7.0f, store.GetDeathTime(0));
+        Assert::AreEqual(8.0f, store.GetSize(0));
+        Assert::AreEqual(0xAABBCCDDu, store.GetColour(0));
+        Assert::AreEqual(9, store.GetType(0));
+        Assert::AreEqual(2, store.GetPriority(0));
+        Assert::AreEqual(1, store.CountWithPriority(2));
+    }
+
+    TEST_METHOD(Remove_MovesLastParticleIntoTheHole)
+    {
+        ParticleStore store(8);
+        for (int tag = 0; tag < 4; ++tag)
+            store.Spawn(Tagged(tag, static_cast<uint8_t>(tag % 2)));
+
+        store.Remove(1);
+        Assert::AreEqual(3, store.Count());
+        Assert::AreEqual(3u, store.GetColour(1));
+        Assert::AreEqual(3.0f, store.GetPos(1).x);
+        Assert::AreEqual(1, store.GetPriority(1));
+        Assert::AreEqual(2, store.CountWithPriority(0));
+        Assert::AreEqual(1, store.CountWithPriority(1));
+
+        store.Remove(2);
+        Assert::IsTrue(Tags(store) == std::vector<uint32_t>{0, 3});
+    }
+
+    TEST_METHOD(RemoveExpired_KeepsOnlyTheLiving)
+    {
+        ParticleStore store(100);
+        for (int tag = 0; tag < 50; ++tag)
+            store.Spawn(Tagged(tag, 0, (tag % 3 == 0) ? 1.0f : 10.0f));
+
+        store.RemoveExpired(1.0);   // Not yet past
+        Assert::AreEqual(50, store.Count());
+
+        store.RemoveExpired(5.0);
+        std::vector<uint32_t> expected;
+        for (uint32_t tag = 0; tag < 50; ++tag)
+        {
+            if (tag % 3 != 0)
+                expected.push_back(tag);
+        }
+        Assert::IsTrue(Tags(store) == expected);
+    }
+
+    // --- Budget -------------------------------------------------------------
+
+    TEST_METHOD(Budget_EvictsLowerPriorityAndDropsTheRest)
+    {
+        ParticleStore store(4);
+        store.Spawn(Tagged(0, 0));
+        store.Spawn(Tagged(1, 1));
+        store.Spawn(Tagged(2, 0));
+        store.Spawn(Tagged(3, 2));
+
+        // Equal to the lowest held: dropped
+        Assert::AreEqual(-1, store.Spawn(Tagged(4, 0)));
+
+        // Higher: replaces the priority 0 particles one at a time
+        Assert::IsTrue(store.Spawn(Tagged(5, 3)) >= 0);
+        Assert::IsTrue(store.Spawn(Tagged(6, 1)) >= 0);
+        Assert::AreEqual(0, store.CountWithPriority(0));
+
+        // Now the lowest held is 1, so another 1 is dropped
+        Assert::AreEqual(-1, store.Spawn(Tagged(7, 1)));
+        Assert::IsTrue(Tags(store) == std::vector<uint32_t>{1, 3, 5, 6});
+
+        const ParticleStore::Stats& stats = store.GetStats();
+        Assert::AreEqual(4, stats.m_peakCount);
+        Assert::AreEqual(int64_t{6}, stats.m_spawned);
+        Assert::AreEqual(int64_t{2}, stats.m_dropped);
+        Assert::AreEqual(int64_t{2}, stats.m_evicted);
+    }
+
+    TEST_METHOD(SetBudget_ShrinkEvictsLowestPriorityFirst)
+    {
+        ParticleStore store(100);
+        for (int tag = 0; tag < 100; ++tag)
+            store.Spawn(Tagged(tag, static_cast<uint8_t>(tag % ParticleStore::NUM_PRIORITIES)));
+
+        store.SetBudget(30);
+        Assert::AreEqual(30, store.Count());
+        Assert::AreEqual(0, store.CountWithPriority(0));
+        Assert::AreEqual(0, store.CountWithPriority(1));
+        Assert::AreEqual(5, store.CountWithPriority(2));
+        Assert::AreEqual(25, store.CountWithPriority(3));
+
+        store.SetBudget(0);
+        Assert::AreEqual(0, store.Count());
+        Assert::AreEqual(-1, store.Spawn(Tagged(0, 3)));
+    }
+
+    // --- Equivalence --------------------------------------------------------
+
+    TEST_METHOD(Integrate_MatchesScalarParticleAdvance)
+    {
+        // Counts on both sides of a multiple of four, so the scalar tail runs
+        for (int count : {1, 7, 64, 1001})
+        {
+            Lcg rng(static_cast<uint32_t>(count));
+            std::vector<ToyParticle> toys;
+            ParticleStore store(count);
+            for (int i = 0; i < count; ++i)
+            {
+                toys.push_back(RandomToy(rng, 0.0f));
+                store.Spawn(ToSpawn(toys.back()));
+            }
+
+            for (int step = 0; step < 50; ++step)
+            {
+                for (ToyParticle& toy : toys)
+                    toy.Advance();
+
+                // Uneven split, as the job system might hand it out
+                const int split = (count * 3) / 5;
+                store.Integrate(0, split, STEP);
+                store.Integrate(split, count, STEP);
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                XMFLOAT3 pos = store.GetPos(i);
+                XMFLOAT3 vel = store.GetVel(i);
+                Assert::IsTrue(SameBits(toys[i].m_pos[0], pos.x) && SameBits(toys[i].m_pos[1], pos.y) && SameBits(toys[i].m_pos[2], pos.z));
+                Assert::IsTrue(SameBits(toys[i].m_vel[0], vel.x) && SameBits(toys[i].m_vel[1], vel.y) && SameBits(toys[i].m_vel[2], vel.z));
+            }
+        }
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_SpawnAndAdvance)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_SpawnAndAdvance)
+    {
+        // A steady state of _count particles living two seconds each: every
+        // tick expires a twentieth of them, spawns as many and advances the
+        // lot.  The toy side is a vector of objects with erase-by-swap, which
+        // is already kinder than the old sliced array.
+        constexpr int TICKS = 200;
+        constexpr int BLOCK = 4096;
+        JobSystem jobs;
+
+        for (int count : {2000, 10000, 50000})
+        {
+            std::vector<ToyParticle> seed;
+            Lcg rng(42);
+            for (int i = 0; i < count * 2; ++i)
+                seed.push_back(RandomToy(rng, 0.0f));
+            const int perTick = count / 20;
+
+            auto prime = [&](auto&& _spawn)
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    ToyParticle p = seed[i];
+                    p.m_deathTime = static_cast<float>(i % 20) * STEP;
+                    _spawn(p);
+                }
+            };
+
+            std::vector<ToyParticle> toys;
+            prime([&](const ToyParticle& _p) { toys.push_back(_p); });
+            auto start = std::chrono::steady_clock::now();
+            for (int t = 0; t < TICKS; ++t)
+            {
+                const float now = static_cast<float>(t) * STEP;
+                for (size_t i = 0; i < toys.size();)
+                {
+                    if (now > toys[i].m_deathTime)
+                    {
+                        toys[i] = toys.back();
+                        toys.pop_back();
+                    }
+                    else
+                    {
+                        toys[i].Advance();
+                        ++i;
+                    }
+                }
+                for (int i = 0; i < perTick; ++i)
+                {
+                    ToyParticle p = seed[(t * perTick + i) % seed.size()];
+                    p.m_deathTime = now + 2.0f;
+                    toys.push_back(p);
+                }
+            }
+            const double toyTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            auto runStore = [&](JobSystem* _jobs)
+            {
+                ParticleStore store(count * 2);
+                prime([&](const ToyParticle& _p) { store.Spawn(ToSpawn(_p)); });
+                auto storeStart = std::chrono::steady_clock::now();
+                for (int t = 0; t < TICKS; ++t)
+                {
+                    const float now = static_cast<float>(t) * STEP;
+                    store.RemoveExpired(now);
+                    const int live = store.Count();
+                    ParallelFor(_jobs, 0, (live + BLOCK - 1) / BLOCK, 1, [&](int _block)
+                    {
+                        store.Integrate(_block * BLOCK, std::min(live, (_block + 1) * BLOCK), STEP);
+                    });
+                    for (int i = 0; i < perTick; ++i)
+                    {
+                        ToyParticle p = seed[(t * perTick + i) % seed.size()];
+                        p.m_deathTime = now + 2.0f;
+                        store.Spawn(ToSpawn(p));
+                    }
+                }
+                Assert::AreEqual(int64_t{0}, store.GetStats().m_dropped);
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - storeStart).count();
+            };
+
+            const double serialTime = runStore(nullptr);
+            const double parallelTime = runStore(&jobs);
+            Logger::WriteMessage(std::format("{} particles: {:.1f} us/tick objects, {:.1f} us/tick SoA ({:.1f}x), {:.1f} us/tick SoA on {} workers ({:.1f}x)\n",
+                count, toyTime * 1.0e6 / TICKS, serialTime * 1.0e6 / TICKS, toyTime / serialTime,
+                parallelTime * 1.0e6 / TICKS, jobs.GetNumWorkers(), toyTime / parallelTime).c_str());
+        }
+    }
+};
@@ -0,0 +1,254 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // --- Route::GetIdOfNearestWayPoint / GetIdOfNearestEdge as they were ----
+
+    int LegacyNearestWayPoint(const std::vector<LegacyVector3>& _route, const LegacyVector3& _pos)
+    {
+        int idOfNearest = -1;
+        float distSqrdOfNearest = FLT_MAX;
+        for (int i = 0; i < static_cast<int>(_route.size()); ++i)
+        {
+            float distSqrd = (_pos - _route[i]).MagSquared();
+            if (distSqrd < distSqrdOfNearest)
+            {
+                idOfNearest = i;
+                distSqrdOfNearest = distSqrd;
+            }
+        }
+        return idOfNearest;
+    }
+
+    int LegacyNearestEdge(const std::vector<LegacyVector3>& _route, const LegacyVector3& _pos, float* _dist = nullptr)
+    {
+        if (_route.empty())
+            return -1;
+
+        int idOfNearest = 0;
+        float distOfNearest = FLT_MAX;
+        Vector2 pos(_pos.x, _pos.z);
+        Vector2 prevWayPoint(_route[0].x, _route[0].z);
+        for (int i = 1; i < static_cast<int>(_route.size()); ++i)
+        {
+            Vector2 wayPoint(_route[i].x, _route[i].z);
+            float dist = PointSegDist2D(pos, prevWayPoint, wayPoint);
+            if (dist < distOfNearest)
+            {
+                distOfNearest = dist;
+                idOfNearest = i;
+            }
+            prevWayPoint = wayPoint;
+        }
+        if (_dist)
+            *_dist = distOfNearest;
+        return idOfNearest - 1;
+    }
+
+    // The WayPointGrid that Route searches, with its point count to hand
+    class TestWayPointGrid : public WayPointGrid
+    {
+    public:
+        explicit TestWayPointGrid(const std::vector<LegacyVector3>& _route)
+        {
+            m_pos = _route;
+            Build();
+        }
+
+        [[nodiscard]] int GetNumIndexed() const { return m_grid.GetNumPoints(); }
+    };
+
+    // A walk across the map, as routes placed in the editor are
+    std::vector<LegacyVector3> WalkRoute(Lcg& _rng, int _numWayPoints, float _stride)
+    {
+        std::vector<LegacyVector3> route;
+        LegacyVector3 pos(_rng.Range(0.0f, 2000.0f), 0.0f, _rng.Range(0.0f, 2000.0f));
+        float heading = _rng.Range(0.0f, 6.2832f);
+        for (int i = 0; i < _numWayPoints; ++i)
+        {
+            route.push_back({pos.x, _rng.Range(0.0f, 100.0f), pos.z});
+            heading += _rng.Range(-0.6f, 0.6f);
+            const float step = _rng.Range(0.2f, 1.0f) * _stride;
+            pos.x += std::cos(heading) * step;
+            pos.z += std::sin(heading) * step;
+        }
+        return route;
+    }
+
+    // On a coarse lattice with y of zero, so that many distances tie
+    std::vector<LegacyVector3> LatticeRoute(Lcg& _rng, int _numWayPoints, int _size)
+    {
+        std::vector<LegacyVector3> route;
+        for (int i = 0; i < _numWayPoints; ++i)
+            route.push_back({static_cast<float>(_rng.Next() % _size) * 10.0f, 0.0f, static_cast<float>(_rng.Next() % _size) * 10.0f});
+        return route;
+    }
+
+    // The same waypoint, the same edge, and the same distance to it
+    void AssertMatchesLegacy(const std::vector<LegacyVector3>& _route, const WayPointGrid& _grid, const LegacyVector3& _pos)
+    {
+        float legacyDist = -1.0f, gridDist = -1.0f;
+        Assert::AreEqual(LegacyNearestWayPoint(_route, _pos), _grid.GetIdOfNearestWayPoint(_pos));
+        const int edge = _grid.GetIdOfNearestEdge(_pos, &gridDist);
+        Assert::AreEqual(LegacyNearestEdge(_route, _pos, &legacyDist), edge);
+        if (edge != -1)
+            Assert::IsTrue(legacyDist == gridDist || (std::isnan(legacyDist) && std::isnan(gridDist)));
+    }
+
+    void AssertMatchesLegacy(const std::vector<LegacyVector3>& _route, Lcg& _rng, int _numQueries, float _lo, float _hi, bool _integral)
+    {
+        const TestWayPointGrid grid(_route);
+        for (int q = 0; q < _numQueries; ++q)
+        {
+            LegacyVector3 pos(_rng.Range(_lo, _hi), _rng.Range(0.0f, 100.0f), _rng.Range(_lo, _hi));
+            if (_integral)
+                pos = LegacyVector3(std::floor(pos.x / 5.0f) * 5.0f, 0.0f, std::floor(pos.z / 5.0f) * 5.0f);
+            AssertMatchesLegacy(_route, grid, pos);
+        }
+    }
+}
+
+TEST_CLASS(PolylineGridTests)
+{
+public:
+
+    // --- Edge cases ---------------------------------------------------------
+
+    TEST_METHOD(EmptyAndShortRoutes)
+    {
+        const std::vector<LegacyVector3> empty;
+        const TestWayPointGrid none(empty);
+        Assert::AreEqual(-1, none.GetIdOfNearestWayPoint({1.0f, 2.0f, 3.0f}));
+        Assert::AreEqual(-1, none.GetIdOfNearestEdge({1.0f, 2.0f, 3.0f}, nullptr));
+
+        const std::vector<LegacyVector3> single = {{10.0f, 0.0f, 10.0f}};
+        const TestWayPointGrid one(single);
+        Assert::AreEqual(0, one.GetIdOfNearestWayPoint({-500.0f, 0.0f, 900.0f}));
+        Assert::AreEqual(-1, one.GetIdOfNearestEdge({-500.0f, 0.0f, 900.0f}, nullptr));
+
+        // Coincident points in x and z, separated only by height
+        const std::vector<LegacyVector3> stacked = {{5.0f, 50.0f, 5.0f}, {5.0f, 10.0f, 5.0f}, {5.0f, 10.0f, 5.0f}};
+        const TestWayPointGrid two(stacked);
+        Assert::AreEqual(1, two.GetIdOfNearestWayPoint({5.0f, 0.0f, 5.0f}));
+        float dist = 0.0f;
+        Assert::AreEqual(0, two.GetIdOfNearestEdge({100.0f, 0.0f, 5.0f}, &dist));
+        Assert::AreEqual(95.0f, dist);
+    }
+
+    TEST_METHOD(NonFiniteWayPoints_AreStillConsidered)
+    {
+        Lcg rng(3);
+        std::vector<LegacyVector3> route = WalkRoute(rng, 300, 20.0f);
+        route[17].x = std::numeric_limits<float>::quiet_NaN();
+        route[150].z = std::numeric_limits<float>::infinity();
+        route[299].x = -std::numeric_limits<float>::infinity();
+        AssertMatchesLegacy(route, rng, 2000, -200.0f, 2200.0f, false);
+
+        // A query that is itself off the map is near nothing
+        const TestWayPointGrid grid(route);
+        const LegacyVector3 nowhere(std::numeric_limits<float>::quiet_NaN(), 0.0f, 10.0f);
+        Assert::AreEqual(-1, grid.GetIdOfNearestWayPoint(nowhere));
+        AssertMatchesLegacy(route, grid, nowhere);
+    }
+
+    // --- Randomised equivalence ---------------------------------------------
+
+    TEST_METHOD(WalkedRoutes_MatchLinearScan)
+    {
+        Lcg rng(11);
+        for (const int length : {2, 3, 10, 100, 1000, 5000})
+        {
+            for (const float stride : {1.0f, 25.0f, 200.0f})
+            {
+                const std::vector<LegacyVector3> route = WalkRoute(rng, length, stride);
+                AssertMatchesLegacy(route, rng, 500, -1000.0f, 3000.0f, false);
+                AssertMatchesLegacy(route, rng, 500, 500.0f, 1500.0f, false);
+            }
+        }
+    }
+
+    TEST_METHOD(LatticeRoutes_BreakTiesByLowestId)
+    {
+        Lcg rng(29);
+        for (const int length : {4, 50, 400, 3000})
+        {
+            for (const int size : {2, 8, 40})
+            {
+                const std::vector<LegacyVector3> route = LatticeRoute(rng, length, size);
+                AssertMatchesLegacy(route, rng, 1000, -20.0f, size * 10.0f + 20.0f, true);
+            }
+        }
+    }
+
+    TEST_METHOD(Rebuild_ForgetsThePreviousRoute)
+    {
+        Lcg rng(5);
+        std::vector<LegacyVector3> route = WalkRoute(rng, 800, 30.0f);
+        TestWayPointGrid grid(route);
+        for (int pass = 0; pass < 5; ++pass)
+        {
+            route = WalkRoute(rng, 200 + pass * 300, 10.0f + pass * 20.0f);
+            grid.m_pos = route;
+            grid.Build();
+            Assert::AreEqual(static_cast<int>(route.size()), grid.GetNumIndexed());
+            for (int q = 0; q < 300; ++q)
+            {
+                const LegacyVector3 pos(rng.Range(-500.0f, 2500.0f), 0.0f, rng.Range(-500.0f, 2500.0f));
+                AssertMatchesLegacy(route, grid, pos);
+            }
+        }
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_LongRoutes)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_LongRoutes)
+    {
+        // Darwinians on a route each ask for the nearest waypoint; the edge
+        // query is timed alongside.  Both sides must give the same answers.
+        constexpr int QUERIES = 20000;
+
+        for (const int length : {100, 1000, 10000})
+        {
+            Lcg rng(static_cast<uint32_t>(length));
+            const std::vector<LegacyVector3> route = WalkRoute(rng, length, 20.0f);
+            std::vector<LegacyVector3> queries;
+            for (int q = 0; q < QUERIES; ++q)
+            {
+                const LegacyVector3& near = route[rng.Next() % route.size()];
+                queries.push_back({near.x + rng.Range(-60.0f, 60.0f), near.y, near.z + rng.Range(-60.0f, 60.0f)});
+            }
+
+            const auto time = [&](auto&& _query, int64_t& _checksum)
+            {
+                _checksum = 0;
+                const auto start = std::chrono::steady_clock::now();
+                for (const LegacyVector3& pos : queries)
+                    _checksum += _query(pos);
+                return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            };
+
+            const auto buildStart = std::chrono::steady_clock::now();
+            const TestWayPointGrid grid(route);
+            const double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - buildStart).count();
+
+            int64_t scanPoints = 0, gridPoints = 0, scanEdges = 0, gridEdges = 0;
+            const double scanPointSeconds = time([&](const LegacyVector3& _pos) { return LegacyNearestWayPoint(route, _pos); }, scanPoints);
+            const double gridPointSeconds = time([&](const LegacyVector3& _pos) { return grid.GetIdOfNearestWayPoint(_pos); }, gridPoints);
+            const double scanEdgeSeconds = time([&](const LegacyVector3& _pos) { return LegacyNearestEdge(route, _pos); }, scanEdges);
+            const double gridEdgeSeconds = time([&](const LegacyVector3& _pos) { return grid.GetIdOfNearestEdge(_pos, nullptr); }, gridEdges);
+
+            Assert::AreEqual(scanPoints, gridPoints);
+            Assert::AreEqual(scanEdges, gridEdges);
+            Logger::WriteMessage(std::format("{} waypoints (build {:.1f} us): nearest waypoint {:.2f} -> {:.2f} us ({:.1f}x), "
+                "nearest edge {:.2f} -> {:.2f} us ({:.1f}x)\n", length, buildSeconds * 1.0e6,
+                scanPointSeconds * 1.0e6 / QUERIES, gridPointSeconds * 1.0e6 / QUERIES, scanPointSeconds / gridPointSeconds,
+                scanEdgeSeconds * 1.0e6 / QUERIES, gridEdgeSeconds * 1.0e6 / QUERIES, scanEdgeSeconds / gridEdgeSeconds).c_str());
+        }
+    }
+};
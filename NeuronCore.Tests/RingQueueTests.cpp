@@ -0,0 +1,221 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // Producer index in the top byte, per-producer sequence below it
+    uint64_t Tag(int _producer, uint64_t _sequence) { return (static_cast<uint64_t>(_producer) << 56) | _sequence; }
+
+    uint64_t NowTicks()
+    {
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    }
+
+    struct LatencyStats
+    {
+        double m_itemsPerSecond = 0.0;
+        double m_meanLatencyUs = 0.0;
+        double m_maxLatencyUs = 0.0;
+    };
+
+    // Producers push their push-time; the consumer measures how long each item waited
+    template <typename TPush, typename TPop>
+    LatencyStats MeasureContention(int _producers, int _itemsPerProducer, TPush _push, TPop _pop)
+    {
+        std::atomic<bool> go = false;
+        std::vector<std::thread> threads;
+        for (int p = 0; p < _producers; ++p)
+        {
+            threads.emplace_back([&] {
+                while (!go) {}
+                for (int i = 0; i < _itemsPerProducer; ++i)
+                {
+                    while (!_push(NowTicks())) std::this_thread::yield();
+                }
+            });
+        }
+
+        const int total = _producers * _itemsPerProducer;
+        double latencySum = 0.0;
+        uint64_t latencyMax = 0;
+        auto start = std::chrono::steady_clock::now();
+        go = true;
+        for (int received = 0; received < total;)
+        {
+            uint64_t pushed;
+            if (!_pop(pushed))
+                continue;
+            uint64_t latency = NowTicks() - pushed;
+            latencySum += static_cast<double>(latency);
+            latencyMax = std::max(latencyMax, latency);
+            ++received;
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (auto& thread : threads)
+            thread.join();
+
+        constexpr double TICKS_PER_US = static_cast<double>(std::chrono::steady_clock::period::den) /
+            std::chrono::steady_clock::period::num / 1.0e6;
+        return { total / elapsed, latencySum / total / TICKS_PER_US, static_cast<double>(latencyMax) / TICKS_PER_US };
+    }
+}
+
+TEST_CLASS(RingQueueTests)
+{
+public:
+
+    // --- SpscRingQueue ------------------------------------------------------
+
+    TEST_METHOD(Spsc_IsFifoAndBounded)
+    {
+        SpscRingQueue<int, 4> queue;
+        int value = 0;
+        Assert::IsFalse(queue.TryPop(value));
+
+        for (int i = 0; i < 4; ++i)
+            Assert::IsTrue(queue.TryPush(i));
+        Assert::IsFalse(queue.TryPush(99));
+        Assert::AreEqual(4, queue.SizeApprox());
+
+        for (int i = 0; i < 4; ++i)
+        {
+            Assert::IsTrue(queue.TryPop(value));
+            Assert::AreEqual(i, value);
+        }
+        Assert::IsFalse(queue.TryPop(value));
+    }
+
+    TEST_METHOD(Spsc_WrapsAround)
+    {
+        SpscRingQueue<int, 4> queue;
+        int value = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            Assert::IsTrue(queue.TryPush(i));
+            Assert::IsTrue(queue.TryPush(i + 1));
+            Assert::IsTrue(queue.TryPop(value));
+            Assert::AreEqual(i, value);
+            Assert::IsTrue(queue.TryPop(value));
+            Assert::AreEqual(i + 1, value);
+        }
+    }
+
+    TEST_METHOD(Spsc_TwoThreads_PreservesOrder)
+    {
+        constexpr int COUNT = 200000;
+        SpscRingQueue<int, 256> queue;
+        std::thread producer([&queue] {
+            for (int i = 0; i < COUNT; ++i)
+            {
+                while (!queue.TryPush(i)) std::this_thread::yield();
+            }
+        });
+
+        bool ordered = true;
+        for (int expected = 0; expected < COUNT;)
+        {
+            int value;
+            if (queue.TryPop(value))
+                ordered &= (value == expected++);
+        }
+        producer.join();
+        Assert::IsTrue(ordered);
+    }
+
+    // --- MpscRingQueue ------------------------------------------------------
+
+    TEST_METHOD(Mpsc_IsFifoAndBounded)
+    {
+        MpscRingQueue<int, 8> queue;
+        int value = 0;
+        Assert::IsFalse(queue.TryPop(value));
+
+        for (int i = 0; i < 8; ++i)
+            Assert::IsTrue(queue.TryPush(i));
+        Assert::IsFalse(queue.TryPush(99));
+
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                Assert::IsTrue(queue.TryPop(value));
+                Assert::AreEqual(round * 8 + i, value);
+                Assert::IsTrue(queue.TryPush((round + 1) * 8 + i));
+            }
+        }
+    }
+
+    TEST_METHOD(Mpsc_ManyProducers_NoLossPerProducerOrder)
+    {
+        constexpr int PRODUCERS = 4;
+        constexpr int PER_PRODUCER = 50000;
+        MpscRingQueue<uint64_t, 1024> queue;
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < PRODUCERS; ++p)
+        {
+            producers.emplace_back([&queue, p] {
+                for (uint64_t i = 0; i < PER_PRODUCER; ++i)
+                {
+                    while (!queue.TryPush(Tag(p, i))) std::this_thread::yield();
+                }
+            });
+        }
+
+        uint64_t nextExpected[PRODUCERS] = {};
+        bool ordered = true;
+        for (int received = 0; received < PRODUCERS * PER_PRODUCER;)
+        {
+            uint64_t value;
+            if (!queue.TryPop(value))
+                continue;
+            int producer = static_cast<int>(value >> 56);
+            ordered &= (value & 0x00ffffffffffffffULL) == nextExpected[producer]++;
+            ++received;
+        }
+        for (auto& producer : producers)
+            producer.join();
+
+        Assert::IsTrue(ordered);
+        for (int p = 0; p < PRODUCERS; ++p)
+            Assert::AreEqual(static_cast<uint64_t>(PER_PRODUCER), nextExpected[p]);
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_InboxContention)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_InboxContention)
+    {
+        // Models the server inbox: several producers (listener threads) and
+        // the sim thread draining.  Baseline is a mutex-guarded list, as the
+        // NetMutex + LList inbox was.
+        constexpr int PRODUCERS = 4;
+        constexpr int PER_PRODUCER = 100000;
+
+        std::mutex mutex;
+        std::deque<uint64_t> list;
+        LatencyStats locked = MeasureContention(PRODUCERS, PER_PRODUCER,
+            [&](uint64_t _v) { std::scoped_lock lock(mutex); list.push_back(_v); return true; },
+            [&](uint64_t& _v) {
+                std::scoped_lock lock(mutex);
+                if (list.empty()) return false;
+                _v = list.front();
+                list.pop_front();
+                return true;
+            });
+
+        auto ring = std::make_unique<MpscRingQueue<uint64_t, 4096>>();
+        LatencyStats lockFree = MeasureContention(PRODUCERS, PER_PRODUCER,
+            [&](uint64_t _v) { return ring->TryPush(_v); },
+            [&](uint64_t& _v) { return ring->TryPop(_v); });
+
+        Assert::IsTrue(lockFree.m_itemsPerSecond > 0.0);
+        Logger::WriteMessage(std::format("Inbox, {} producers: mutex {:.1f} M/s (mean {:.1f} us, max {:.0f} us), MPSC ring {:.1f} M/s (mean {:.1f} us, max {:.0f} us)\n",
+            PRODUCERS, locked.m_itemsPerSecond / 1.0e6, locked.m_meanLatencyUs, locked.m_maxLatencyUs,
+            lockFree.m_itemsPerSecond / 1.0e6, lockFree.m_meanLatencyUs, lockFree.m_maxLatencyUs).c_str());
+    }
+};
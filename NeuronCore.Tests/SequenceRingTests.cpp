@@ -0,0 +1,148 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+TEST_CLASS(SequenceRingTests)
+{
+public:
+
+    // --- Lookup -------------------------------------------------------------
+
+    TEST_METHOD(Get_ReturnsValueById)
+    {
+        SequenceRing<int> ring(4);
+        for (int id = 0; id < 10; ++id)
+            ring.Put(id, id * 10);
+
+        Assert::AreEqual(0, ring.GetFirstId());
+        Assert::AreEqual(10, ring.GetEndId());
+        for (int id = 0; id < 10; ++id)
+            Assert::AreEqual(id * 10, ring.Get(id));
+        Assert::AreEqual(0, ring.Get(10));
+        Assert::AreEqual(0, ring.Get(-1));
+    }
+
+    TEST_METHOD(Put_FillsGapsWithDefault)
+    {
+        SequenceRing<int*> ring(4);
+        int a = 1, b = 2;
+        ring.Put(3, &a);
+        ring.Put(7, &b);
+
+        Assert::AreEqual(3, ring.GetFirstId());
+        Assert::AreEqual(5, ring.Size());
+        Assert::IsTrue(ring.Get(3) == &a);
+        Assert::IsTrue(ring.Get(4) == nullptr);
+        Assert::IsTrue(ring.Get(6) == nullptr);
+        Assert::IsTrue(ring.Get(7) == &b);
+    }
+
+    // --- Truncation ---------------------------------------------------------
+
+    TEST_METHOD(PopFront_ReusesSlotsWithoutGrowing)
+    {
+        SequenceRing<int> ring(8);
+        for (int id = 0; id < 1000; ++id)
+        {
+            ring.Put(id, id);
+            if (ring.Size() > 6)
+                Assert::AreEqual(id - 6, ring.PopFront());
+        }
+
+        Assert::AreEqual(8, ring.GetCapacity());
+        Assert::AreEqual(994, ring.GetFirstId());
+        for (int id = 994; id < 1000; ++id)
+            Assert::AreEqual(id, ring.Get(id));
+        Assert::IsFalse(ring.Contains(993));
+    }
+
+    TEST_METHOD(Growth_PreservesWrappedEntries)
+    {
+        SequenceRing<int> ring(4);
+        for (int id = 0; id < 3; ++id)
+            ring.Put(id, id);
+        ring.PopFront();
+        ring.PopFront();
+        for (int id = 3; id < 20; ++id)
+            ring.Put(id, id);
+
+        Assert::AreEqual(2, ring.GetFirstId());
+        for (int id = 2; id < 20; ++id)
+            Assert::AreEqual(id, ring.Get(id));
+    }
+
+    TEST_METHOD(Put_AfterEmptying_StartsNewWindow)
+    {
+        SequenceRing<int> ring(4);
+        ring.Put(0, 5);
+        ring.Clear();
+        Assert::IsTrue(ring.Empty());
+
+        ring.Put(40, 7);
+        Assert::AreEqual(40, ring.GetFirstId());
+        Assert::AreEqual(1, ring.Size());
+        Assert::AreEqual(7, ring.Get(40));
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_ResendHistory)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_ResendHistory)
+    {
+        // Models Server::Advance's resend pass: each client is sent up to 25
+        // letters starting from the last sequence id it acknowledged.  Clients
+        // lag by anything from 0 to LAG_SPREAD ticks.  Baseline is a linked
+        // list indexed from the head, as the LList history was; the ring also
+        // truncates what every client has acknowledged.
+        constexpr int CLIENTS = 64;
+        constexpr int LAG_SPREAD = 2000;
+        constexpr int TICKS = 3000;
+        constexpr int MAX_RESEND = 25;
+
+        auto clientAck = [](int _client, int _tick) { return std::max(-1, _tick - 1 - (_client * LAG_SPREAD) / CLIENTS); };
+
+        std::list<int> list;
+        uint64_t listSum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < TICKS; ++tick)
+        {
+            list.push_back(tick);
+            for (int c = 0; c < CLIENTS; ++c)
+            {
+                int from = clientAck(c, tick) + 1;
+                int to = std::min(static_cast<int>(list.size()), from + MAX_RESEND);
+                auto it = std::next(list.begin(), from);
+                for (int id = from; id < to; ++id, ++it)
+                    listSum += *it;
+            }
+        }
+        double listSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        SequenceRing<int> ring;
+        uint64_t ringSum = 0;
+        start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < TICKS; ++tick)
+        {
+            ring.Put(tick, tick);
+            int ackedByAll = INT_MAX;
+            for (int c = 0; c < CLIENTS; ++c)
+            {
+                int from = std::max(clientAck(c, tick) + 1, ring.GetFirstId());
+                int to = std::min(ring.GetEndId(), from + MAX_RESEND);
+                for (int id = from; id < to; ++id)
+                    ringSum += ring.Get(id);
+                ackedByAll = std::min(ackedByAll, clientAck(c, tick));
+            }
+            while (!ring.Empty() && ring.GetFirstId() <= ackedByAll)
+                ring.PopFront();
+        }
+        double ringSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        Assert::AreEqual(listSum, ringSum);
+        Logger::WriteMessage(std::format("Resend history, {} clients lagging 0-{} ticks: linked list {:.2f} us/tick, ring {:.2f} us/tick ({} entries retained, capacity {})\n",
+            CLIENTS, LAG_SPREAD, listSeconds * 1.0e6 / TICKS, ringSeconds * 1.0e6 / TICKS, ring.Size(), ring.GetCapacity()).c_str());
+    }
+};
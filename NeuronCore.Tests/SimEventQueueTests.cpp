@@ -0,0 +1,166 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    struct ToyEvent
+    {
+        int m_id;
+        uint64_t m_key;
+
+        [[nodiscard]] uint64_t CoalesceKey() const { return m_key; }
+    };
+
+    using ToyQueue = SimEventQueue<ToyEvent>;
+
+    std::vector<int> Ids(const ToyQueue& _queue)
+    {
+        std::vector<int> ids;
+        for (int i = 0; i < _queue.Count(); ++i)
+            ids.push_back(_queue.Get(i).m_id);
+        return ids;
+    }
+}
+
+TEST_CLASS(SimEventQueueTests)
+{
+public:
+
+    // --- Capacity -----------------------------------------------------------
+
+    TEST_METHOD(Push_GrowsPastInitialReserve)
+    {
+        ToyQueue queue(16);
+        for (int i = 0; i < 5000; ++i)
+            queue.Push({i, 0});
+
+        Assert::AreEqual(5000, queue.Count());
+        for (int i = 0; i < queue.Count(); ++i)
+            Assert::AreEqual(i, queue.Get(i).m_id);
+        Assert::AreEqual(5000, queue.GetStats().m_peakDepth);
+        Assert::AreEqual(static_cast<int64_t>(0), queue.GetStats().m_dropped);
+    }
+
+    TEST_METHOD(Push_BeyondMaxEventsIsDroppedAndCounted)
+    {
+        ToyQueue queue(4, 100);
+        for (int i = 0; i < 130; ++i)
+            queue.Push({i, 0});
+
+        Assert::AreEqual(100, queue.Count());
+        Assert::AreEqual(99, queue.Get(99).m_id);
+        Assert::AreEqual(static_cast<int64_t>(30), queue.GetStats().m_dropped);
+
+        queue.Clear();
+        queue.Push({0, 0});
+        Assert::AreEqual(1, queue.Count());
+        Assert::AreEqual(100, queue.GetStats().m_peakDepth);
+    }
+
+    // --- Coalescing ---------------------------------------------------------
+
+    TEST_METHOD(Coalesce_DuplicateKeysKeepFirst)
+    {
+        ToyQueue queue;
+        queue.Push({1, 7});
+        queue.Push({2, 0});
+        queue.Push({3, 7});
+        queue.Push({4, 0});
+        queue.Push({5, 8});
+        queue.Push({6, 8});
+
+        Assert::IsTrue(Ids(queue) == std::vector<int>{1, 2, 4, 5});
+        Assert::AreEqual(static_cast<int64_t>(2), queue.GetStats().m_coalesced);
+    }
+
+    TEST_METHOD(Coalesce_BarrierAndClearEndTheWindow)
+    {
+        ToyQueue queue;
+        queue.Push({1, 7});
+        queue.Push({2, SIM_EVENT_BARRIER});
+        queue.Push({3, 7});
+        queue.Push({4, 7});
+        queue.Push({5, SIM_EVENT_BARRIER});
+        Assert::IsTrue(Ids(queue) == std::vector<int>{1, 2, 3, 5});
+
+        queue.Clear();
+        queue.Push({6, 7});
+        Assert::IsTrue(Ids(queue) == std::vector<int>{6});
+    }
+
+    TEST_METHOD(Coalesce_ManyDistinctKeys)
+    {
+        // Enough keys to grow the lookup table several times, across Clears
+        ToyQueue queue;
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 3000; ++i)
+                queue.Push({i, static_cast<uint64_t>(i % 1000) + 1});
+            Assert::AreEqual(1000, queue.Count());
+            for (int i = 0; i < queue.Count(); ++i)
+                Assert::AreEqual(i, queue.Get(i).m_id);
+            queue.Clear();
+        }
+        Assert::AreEqual(static_cast<int64_t>(6000), queue.GetStats().m_coalesced);
+    }
+
+    // --- Lanes --------------------------------------------------------------
+
+    TEST_METHOD(Lanes_MergeInLaneOrderWhateverThreadsRan)
+    {
+        // Each lane pushes its own events plus one key shared by every
+        // lane; only lane 0's copy of the shared key survives the merge.
+        constexpr int LANES = 64;
+        constexpr int PER_LANE = 50;
+        constexpr uint64_t SHARED_KEY = 999999;
+
+        auto produce = [](int _lane, ToyQueue& _queue)
+        {
+            for (int i = 0; i < PER_LANE; ++i)
+                _queue.Push({_lane * 1000 + i, 0});
+            _queue.Push({_lane * 1000 + PER_LANE, SHARED_KEY});
+        };
+
+        ToyQueue serial;
+        serial.Push({-1, 0});
+        for (int lane = 0; lane < LANES; ++lane)
+            produce(lane, serial);
+
+        JobSystem jobs(4);
+        for (int run = 0; run < 20; ++run)
+        {
+            ToyQueue queue;
+            queue.Push({-1, 0});
+            queue.OpenLanes(LANES);
+            jobs.ParallelFor(0, LANES, 1, [&](int _lane)
+            {
+                ToyQueue::LaneScope scope(queue, _lane);
+                produce(_lane, queue);
+            });
+            Assert::AreEqual(1, queue.Count());
+            queue.MergeLanes();
+
+            Assert::IsTrue(Ids(serial) == Ids(queue));
+            Assert::AreEqual(static_cast<int64_t>(LANES - 1), queue.GetStats().m_coalesced);
+        }
+    }
+
+    TEST_METHOD(Lanes_ScopeOnlyRedirectsItsOwnQueue)
+    {
+        ToyQueue a, b;
+        a.OpenLanes(1);
+        {
+            ToyQueue::LaneScope scope(a, 0);
+            a.Push({1, 0});
+            b.Push({2, 0});
+        }
+        a.Push({3, 0});
+
+        Assert::IsTrue(Ids(a) == std::vector<int>{3});
+        Assert::IsTrue(Ids(b) == std::vector<int>{2});
+        a.MergeLanes();
+        Assert::IsTrue(Ids(a) == std::vector<int>{3, 1});
+    }
+};
@@ -0,0 +1,234 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    struct Other
+    {
+        bool m_used = false;
+        int m_type = 0;
+        float m_x = 0.0f;
+    };
+
+    // A team's others: slots handed out lowest free first, as FastDArray does,
+    // with the lists kept alongside as Team keeps them
+    class Others
+    {
+    public:
+        explicit Others(int _numTypes) : m_lists(_numTypes) {}
+
+        int Spawn(int _type, float _x)
+        {
+            int slot = 0;
+            while (slot < static_cast<int>(m_slots.size()) && m_slots[slot].m_used)
+                ++slot;
+            if (slot == static_cast<int>(m_slots.size()))
+                m_slots.emplace_back();
+            m_slots[slot] = Other{true, _type, _x};
+            m_lists.Add(_type, slot);
+            return slot;
+        }
+
+        void Kill(int _slot)
+        {
+            m_slots[_slot].m_used = false;
+            m_lists.Remove(_slot);
+        }
+
+        // The slots of one type as a loop over every slot finds them
+        [[nodiscard]] std::vector<int> Scan(int _type) const
+        {
+            std::vector<int> result;
+            for (int i = 0; i < static_cast<int>(m_slots.size()); ++i)
+            {
+                if (m_slots[i].m_used && m_slots[i].m_type == _type)
+                    result.push_back(i);
+            }
+            return result;
+        }
+
+        std::vector<Other> m_slots;
+        SlotTypeLists m_lists;
+    };
+}
+
+TEST_CLASS(SlotTypeListsTests)
+{
+public:
+
+    // --- Membership ---------------------------------------------------------
+
+    TEST_METHOD(AddAndRemove_KeepSlotsAscending)
+    {
+        SlotTypeLists lists(3);
+        for (const int slot : {7, 2, 9, 4})
+            lists.Add(1, slot);
+        lists.Add(0, 3);
+
+        Assert::IsTrue(std::vector<int>{2, 4, 7, 9} == lists.GetSlots(1));
+        Assert::AreEqual(1, lists.Count(0));
+        Assert::AreEqual(0, lists.Count(2));
+        Assert::AreEqual(1, lists.GetType(7));
+        Assert::AreEqual(-1, lists.GetType(5));
+        Assert::AreEqual(-1, lists.GetType(100));
+
+        lists.Remove(4);
+        lists.Remove(4);
+        lists.Remove(50);
+        Assert::IsTrue(std::vector<int>{2, 7, 9} == lists.GetSlots(1));
+        Assert::AreEqual(-1, lists.GetType(4));
+    }
+
+    TEST_METHOD(Add_ToAnotherType_MovesTheSlot)
+    {
+        SlotTypeLists lists(2);
+        lists.Add(0, 5);
+        lists.Add(0, 5);
+        Assert::AreEqual(1, lists.Count(0));
+
+        lists.Add(1, 5);
+        Assert::AreEqual(0, lists.Count(0));
+        Assert::AreEqual(1, lists.Count(1));
+        Assert::AreEqual(1, lists.GetType(5));
+
+        lists.Clear();
+        Assert::AreEqual(0, lists.Count(1));
+        Assert::AreEqual(-1, lists.GetType(5));
+        Assert::AreEqual(2, lists.GetNumTypes());
+    }
+
+    // --- Randomised equivalence ---------------------------------------------
+
+    TEST_METHOD(SpawnsAndDeaths_MatchAScanOfEverySlot)
+    {
+        constexpr int TYPES = 6;
+        Others others(TYPES);
+        std::vector<int> live;
+        Lcg rng(17);
+
+        for (int step = 0; step < 20000; ++step)
+        {
+            // Grows to a few hundred and then churns
+            const bool spawn = live.empty() || (rng.Next() % 1000) < (live.size() < 400 ? 700u : 480u);
+            if (spawn)
+            {
+                // Mostly the first type, as a team is mostly Darwinians
+                const int type = (rng.Next() % 4) == 0 ? 1 + static_cast<int>(rng.Next() % (TYPES - 1)) : 0;
+                live.push_back(others.Spawn(type, static_cast<float>(step)));
+            }
+            else
+            {
+                const size_t pick = rng.Next() % live.size();
+                others.Kill(live[pick]);
+                live[pick] = live.back();
+                live.pop_back();
+            }
+
+            if (step % 97 == 0)
+            {
+                for (int type = 0; type < TYPES; ++type)
+                    Assert::IsTrue(others.Scan(type) == others.m_lists.GetSlots(type));
+            }
+        }
+
+        for (int type = 0; type < TYPES; ++type)
+            Assert::IsTrue(others.Scan(type) == others.m_lists.GetSlots(type));
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_PerTypePasses)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_PerTypePasses)
+    {
+        // A team of Darwinians with a few Virii, officers and the like, and
+        // holes left by the dead.  Each frame draws Darwinians, Virii and the
+        // rest in their own passes and counts one type, first by scanning
+        // every slot as Team did, then through the lists.
+        constexpr int TYPES = 32;
+        constexpr int DARWINIAN = 0;
+        constexpr int VIRII = 1;
+        constexpr int FRAMES = 200;
+
+        struct Population
+        {
+            const char* m_name;
+            int m_darwinians;
+            int m_virii;
+            int m_rest;
+        };
+
+        for (const Population& population : {Population{"mostly Darwinians", 4000, 50, 40},
+                                             Population{"mixed", 1500, 1500, 400},
+                                             Population{"mostly Virii", 100, 3000, 20}})
+        {
+            Others others(TYPES);
+            Lcg rng(99);
+            std::vector<int> types;
+            types.insert(types.end(), population.m_darwinians, DARWINIAN);
+            types.insert(types.end(), population.m_virii, VIRII);
+            for (int i = 0; i < population.m_rest; ++i)
+                types.push_back(2 + static_cast<int>(rng.Next() % (TYPES - 2)));
+            for (size_t i = types.size() - 1; i > 0; --i)
+                std::swap(types[i], types[rng.Next() % (i + 1)]);
+            for (const int type : types)
+                others.Spawn(type, static_cast<float>(rng.Next() % 1000));
+            for (int i = 0; i < static_cast<int>(others.m_slots.size()); i += 7)
+                others.Kill(i);
+
+            const auto draw = [](const Other& _other, double& _sum) { _sum += _other.m_x; };
+
+            double scanSum = 0.0;
+            const auto scanStart = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < FRAMES; ++frame)
+            {
+                const int size = static_cast<int>(others.m_slots.size());
+                for (int i = 0; i < size; ++i)
+                {
+                    if (others.m_slots[i].m_used && others.m_slots[i].m_type == DARWINIAN)
+                        draw(others.m_slots[i], scanSum);
+                }
+                for (int i = 0; i < size; ++i)
+                {
+                    if (others.m_slots[i].m_used && others.m_slots[i].m_type == VIRII)
+                        draw(others.m_slots[i], scanSum);
+                }
+                for (int i = 0; i < size; ++i)
+                {
+                    if (others.m_slots[i].m_used && others.m_slots[i].m_type != DARWINIAN && others.m_slots[i].m_type != VIRII)
+                        draw(others.m_slots[i], scanSum);
+                }
+                int count = 0;
+                for (int i = 0; i < size; ++i)
+                    count += others.m_slots[i].m_used && others.m_slots[i].m_type == 2 + frame % (TYPES - 2);
+                scanSum += count;
+            }
+            const double scanSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - scanStart).count();
+
+            double listSum = 0.0;
+            const auto listStart = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < FRAMES; ++frame)
+            {
+                for (const int i : others.m_lists.GetSlots(DARWINIAN))
+                    draw(others.m_slots[i], listSum);
+                for (const int i : others.m_lists.GetSlots(VIRII))
+                    draw(others.m_slots[i], listSum);
+                for (int type = 2; type < TYPES; ++type)
+                {
+                    for (const int i : others.m_lists.GetSlots(type))
+                        draw(others.m_slots[i], listSum);
+                }
+                listSum += others.m_lists.Count(2 + frame % (TYPES - 2));
+            }
+            const double listSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - listStart).count();
+
+            Assert::AreEqual(scanSum, listSum);
+            Logger::WriteMessage(std::format("{} ({} slots): scanning {:.1f} us/frame, lists {:.1f} us/frame ({:.1f}x)\n",
+                population.m_name, others.m_slots.size(), scanSeconds * 1.0e6 / FRAMES, listSeconds * 1.0e6 / FRAMES,
+                scanSeconds / listSeconds).c_str());
+        }
+    }
+};
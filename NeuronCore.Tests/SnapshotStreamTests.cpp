@@ -0,0 +1,333 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // A miniature lockstep simulation with the same shape as Location: objects
+    // that advance every tick, a shared deterministic random stream, per-object
+    // digests folded into a running SyncChecksum, and commands arriving in
+    // sequenced letters that spawn and remove objects.  It tests the stream and
+    // the protocol; this project cannot link the game, so the real Location is
+    // checked in game by RunSnapshotCheck (Starstrike/snapshot_check.h).
+    struct ToyObject
+    {
+        int m_id = 0;
+        float m_pos[2] = {};
+        float m_vel[2] = {};
+        int m_health = 100;
+        uint64_t m_syncContribution = 0;
+
+        [[nodiscard]] uint64_t GetSyncHash() const
+        {
+            return SyncHasher().Fold(m_id).Fold(m_pos[0]).Fold(m_pos[1]).Fold(m_vel[0]).Fold(m_vel[1]).Fold(m_health).Value();
+        }
+    };
+
+    struct ToyLetter
+    {
+        int m_sequenceId;
+        int m_spawn;        // Objects to create
+        int m_damage;       // Health removed from every object
+    };
+
+    class ToyWorld
+    {
+    public:
+        void ProcessLetter(const ToyLetter& _letter)
+        {
+            for (int i = 0; i < _letter.m_spawn; ++i)
+            {
+                ToyObject object;
+                object.m_id = m_nextId++;
+                object.m_pos[0] = Random() * 100.0f;
+                object.m_pos[1] = Random() * 100.0f;
+                object.m_vel[0] = Random() - 0.5f;
+                object.m_vel[1] = Random() - 0.5f;
+                m_objects.push_back(object);
+            }
+
+            for (ToyObject& object : m_objects)
+                object.m_health -= _letter.m_damage;
+
+            // Advance, then fold state in exactly as Location::Advance* does
+            for (size_t i = 0; i < m_objects.size();)
+            {
+                ToyObject& object = m_objects[i];
+                object.m_pos[0] += object.m_vel[0];
+                object.m_pos[1] += object.m_vel[1];
+                object.m_vel[0] *= 0.99f + Random() * 0.02f;
+                if (object.m_health <= 0)
+                {
+                    m_checksum.Retire(object.m_syncContribution);
+                    m_objects.erase(m_objects.begin() + i);
+                    continue;
+                }
+                m_checksum.Update(object.m_syncContribution, object.GetSyncHash());
+                ++i;
+            }
+
+            m_lastProcessed = _letter.m_sequenceId;
+        }
+
+        void WriteSnapshot(SnapshotWriter& _writer) const
+        {
+            int header = _writer.BeginSection(SnapshotTag("HEAD"));
+            _writer.Write(m_lastProcessed);
+            _writer.Write(m_nextId);
+            _writer.Write(m_random);
+            _writer.Write(m_checksum.Value());
+            _writer.EndSection(header);
+
+            int objects = _writer.BeginSection(SnapshotTag("OBJS"));
+            _writer.WriteVarUInt(static_cast<uint32_t>(m_objects.size()));
+            for (const ToyObject& object : m_objects)
+                _writer.Write(object);
+            _writer.EndSection(objects);
+        }
+
+        bool ReadSnapshot(SnapshotReader& _reader)
+        {
+            uint32_t tag;
+            SnapshotReader section;
+            while (_reader.NextSection(&tag, &section))
+            {
+                if (tag == SnapshotTag("HEAD"))
+                {
+                    section.Read(m_lastProcessed);
+                    section.Read(m_nextId);
+                    section.Read(m_random);
+                    m_checksum.Reset();
+                    m_checksum.Add(section.Read<uint64_t>());
+                }
+                else if (tag == SnapshotTag("OBJS"))
+                {
+                    m_objects.resize(section.ReadVarUInt());
+                    for (ToyObject& object : m_objects)
+                        section.Read(object);
+                }
+                if (section.Overflowed())
+                    return false;
+            }
+            return !_reader.Overflowed();
+        }
+
+        [[nodiscard]] uint64_t GetChecksum() const { return m_checksum.Value(); }
+        [[nodiscard]] int GetLastProcessed() const { return m_lastProcessed; }
+        [[nodiscard]] size_t NumObjects() const { return m_objects.size(); }
+
+        // Recomputes the checksum from scratch, to prove the running one is not stale
+        [[nodiscard]] uint64_t RebuildChecksum() const
+        {
+            SyncChecksum checksum;
+            for (const ToyObject& object : m_objects)
+                checksum.Add(object.GetSyncHash());
+            return checksum.Value();
+        }
+
+    private:
+        float Random()
+        {
+            m_random = m_random * 1664525u + 1013904223u;
+            return static_cast<float>(m_random >> 8) / 16777216.0f;
+        }
+
+        std::vector<ToyObject> m_objects;
+        SyncChecksum m_checksum;
+        uint32_t m_random = 12345;
+        int m_nextId = 0;
+        int m_lastProcessed = -1;
+    };
+
+    std::vector<ToyLetter> MakeMatch(int _numLetters)
+    {
+        std::vector<ToyLetter> letters;
+        for (int i = 0; i < _numLetters; ++i)
+            letters.push_back({i, (i % 7 == 0) ? 5 : 0, (i % 3 == 0) ? 2 : 0});
+        return letters;
+    }
+}
+
+TEST_CLASS(SnapshotStreamTests)
+{
+public:
+
+    // --- Writer / Reader ----------------------------------------------------
+
+    TEST_METHOD(RoundTrip_ValuesAndStrings)
+    {
+        SnapshotWriter writer;
+        writer.Write(42);
+        writer.Write(-1.5f);
+        writer.WriteVarUInt(300);
+        writer.WriteString("mission.txt");
+
+        SnapshotReader reader(writer.GetData(), writer.Size());
+        Assert::AreEqual(42, reader.Read<int>());
+        Assert::AreEqual(-1.5f, reader.Read<float>());
+        Assert::AreEqual(300u, reader.ReadVarUInt());
+        char name[32];
+        reader.ReadString(name, sizeof(name));
+        Assert::AreEqual(std::string("mission.txt"), std::string(name));
+        Assert::AreEqual(0, reader.BytesRemaining());
+        Assert::IsFalse(reader.Overflowed());
+    }
+
+    TEST_METHOD(Reader_OverrunSetsFlagAndReturnsZero)
+    {
+        SnapshotWriter writer;
+        writer.Write(static_cast<uint16_t>(7));
+
+        SnapshotReader reader(writer.GetData(), writer.Size());
+        Assert::AreEqual(0, reader.Read<int>());
+        Assert::IsTrue(reader.Overflowed());
+    }
+
+    TEST_METHOD(Reader_CountLargerThanBufferIsRejected)
+    {
+        SnapshotWriter writer;
+        writer.WriteCount(3);
+        writer.Write(static_cast<uint8_t>(1));
+        writer.Write(static_cast<uint8_t>(2));
+        writer.Write(static_cast<uint8_t>(3));
+        writer.WriteCount(1000000);
+        writer.Write(static_cast<uint8_t>(4));
+
+        SnapshotReader reader(writer.GetData(), writer.Size());
+        Assert::AreEqual(3, reader.ReadCount());
+        Assert::AreEqual(uint8_t{1}, reader.Read<uint8_t>());
+        Assert::AreEqual(uint8_t{2}, reader.Read<uint8_t>());
+        Assert::AreEqual(uint8_t{3}, reader.Read<uint8_t>());
+        Assert::IsFalse(reader.Overflowed());
+        Assert::AreEqual(0, reader.ReadCount());
+        Assert::IsTrue(reader.Overflowed());
+    }
+
+    TEST_METHOD(Sections_UnknownTagsAreSkipped)
+    {
+        SnapshotWriter writer;
+        int future = writer.BeginSection(SnapshotTag("NEW!"));
+        writer.Write(1.0);
+        writer.WriteString("ignored");
+        writer.EndSection(future);
+        int known = writer.BeginSection(SnapshotTag("KNOW"));
+        writer.Write(99);
+        writer.EndSection(known);
+
+        SnapshotReader reader(writer.GetData(), writer.Size());
+        uint32_t tag;
+        SnapshotReader section;
+        int found = 0;
+        while (reader.NextSection(&tag, &section))
+        {
+            if (tag == SnapshotTag("KNOW"))
+                found = section.Read<int>();
+        }
+        Assert::AreEqual(99, found);
+        Assert::IsFalse(reader.Overflowed());
+    }
+
+    TEST_METHOD(Sections_TruncatedBufferIsRejected)
+    {
+        SnapshotWriter writer;
+        int section = writer.BeginSection(SnapshotTag("DATA"));
+        for (int i = 0; i < 16; ++i)
+            writer.Write(i);
+        writer.EndSection(section);
+
+        SnapshotReader reader(writer.GetData(), writer.Size() - 4);
+        uint32_t tag;
+        SnapshotReader contents;
+        Assert::IsFalse(reader.NextSection(&tag, &contents));
+        Assert::IsTrue(reader.Overflowed());
+    }
+
+    // --- Assembler ----------------------------------------------------------
+
+    TEST_METHOD(Assembler_OutOfOrderAndDuplicateParts)
+    {
+        std::vector<uint8_t> blob(1000);
+        for (size_t i = 0; i < blob.size(); ++i)
+            blob[i] = static_cast<uint8_t>(i * 31);
+
+        constexpr int PART_SIZE = 96;
+        const int numParts = (static_cast<int>(blob.size()) + PART_SIZE - 1) / PART_SIZE;
+        auto partSize = [&](int _part) { return std::min(PART_SIZE, static_cast<int>(blob.size()) - _part * PART_SIZE); };
+
+        SnapshotAssembler assembler;
+        bool complete = false;
+        for (int part = numParts - 1; part >= 0; part -= 2)
+            complete |= assembler.AddPart(7, part, numParts, blob.data() + part * PART_SIZE, partSize(part));
+        for (int part = numParts - 1; part >= 0; --part)
+            complete |= assembler.AddPart(7, part, numParts, blob.data() + part * PART_SIZE, partSize(part));
+
+        Assert::IsTrue(complete);
+        Assert::IsTrue(assembler.IsComplete());
+        Assert::AreEqual(static_cast<int>(blob.size()), assembler.Size());
+        Assert::IsTrue(std::memcmp(blob.data(), assembler.GetData(), blob.size()) == 0);
+    }
+
+    TEST_METHOD(Assembler_NewSnapshotDiscardsOldParts)
+    {
+        uint8_t a[4] = {1, 1, 1, 1};
+        uint8_t b[4] = {2, 2, 2, 2};
+        SnapshotAssembler assembler;
+        Assert::IsFalse(assembler.AddPart(10, 0, 2, a, 4));
+        Assert::IsFalse(assembler.AddPart(20, 0, 2, b, 4));
+        Assert::IsTrue(assembler.AddPart(20, 1, 2, b, 4));
+        Assert::AreEqual(20, assembler.GetSnapshotId());
+        Assert::AreEqual(8, assembler.Size());
+        Assert::AreEqual(static_cast<uint8_t>(2), assembler.GetData()[0]);
+    }
+
+    // --- Late join ----------------------------------------------------------
+
+    TEST_METHOD(LateJoin_SnapshotMatchesReplayFromTickZero)
+    {
+        constexpr int JOIN_AT = 150;
+        constexpr int NUM_LETTERS = 400;
+        constexpr int PART_SIZE = 480;
+        std::vector<ToyLetter> letters = MakeMatch(NUM_LETTERS);
+
+        // The host has played up to JOIN_AT and snapshots itself there
+        ToyWorld host;
+        for (int i = 0; i <= JOIN_AT; ++i)
+            host.ProcessLetter(letters[i]);
+        SnapshotWriter writer;
+        host.WriteSnapshot(writer);
+
+        // The snapshot travels in parts, last part first
+        SnapshotAssembler assembler;
+        const int numParts = (writer.Size() + PART_SIZE - 1) / PART_SIZE;
+        for (int part = numParts; part-- > 0;)
+        {
+            int size = std::min(PART_SIZE, writer.Size() - part * PART_SIZE);
+            assembler.AddPart(host.GetLastProcessed(), part, numParts, writer.GetData() + part * PART_SIZE, size);
+        }
+        Assert::IsTrue(assembler.IsComplete());
+
+        // The late joiner starts from the snapshot and processes only what follows
+        ToyWorld joiner;
+        SnapshotReader reader(assembler.GetData(), assembler.Size());
+        Assert::IsTrue(joiner.ReadSnapshot(reader));
+        Assert::AreEqual(JOIN_AT, joiner.GetLastProcessed());
+        Assert::AreEqual(host.GetChecksum(), joiner.GetChecksum());
+
+        ToyWorld replayed;
+        for (int i = 0; i < NUM_LETTERS; ++i)
+        {
+            replayed.ProcessLetter(letters[i]);
+            if (i > JOIN_AT)
+            {
+                host.ProcessLetter(letters[i]);
+                joiner.ProcessLetter(letters[i]);
+                Assert::AreEqual(replayed.GetChecksum(), joiner.GetChecksum());
+            }
+        }
+
+        Assert::AreEqual(replayed.GetChecksum(), host.GetChecksum());
+        Assert::AreEqual(replayed.RebuildChecksum(), joiner.RebuildChecksum());
+        Assert::AreEqual(replayed.NumObjects(), joiner.NumObjects());
+    }
+};
@@ -0,0 +1,485 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // Stand-in for LegacyVector3 with the same arithmetic
+    struct Vec3
+    {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+
+        Vec3 operator+(const Vec3& _b) const { return {x + _b.x, y + _b.y, z + _b.z}; }
+        Vec3 operator-(const Vec3& _b) const { return {x - _b.x, y - _b.y, z - _b.z}; }
+        Vec3 operator*(float _b) const { return {x * _b, y * _b, z * _b}; }
+        float operator*(const Vec3& _b) const { return x * _b.x + y * _b.y + z * _b.z; }
+        Vec3 operator^(const Vec3& _b) const { return {y * _b.z - z * _b.y, z * _b.x - x * _b.z, x * _b.y - y * _b.x}; }
+        [[nodiscard]] float MagSquared() const { return x * x + y * y + z * z; }
+
+        Vec3 Normalise() const
+        {
+            float lenSqrd = x * x + y * y + z * z;
+            if (lenSqrd > 0.0f)
+            {
+                float invLen = 1.0f / sqrtf(lenSqrd);
+                return {x * invLen, y * invLen, z * invLen};
+            }
+            return {0.0f, 0.0f, 1.0f};
+        }
+    };
+
+    // --- Copy of the exact test in math_utils.cpp, quirks included ----------
+
+    bool RaySphereIntersection(const Vec3& rayStart, const Vec3& rayDir, const Vec3& spherePos, float sphereRadius, float _rayLen = 1e10,
+                               Vec3* pos = nullptr)
+    {
+        Vec3 l = spherePos - rayStart;
+        float tca = l * rayDir;
+        if (tca < 0.0f)
+            return false;
+
+        float radiusSqrd = sphereRadius * sphereRadius;
+        float lMagSqrd = l.MagSquared();
+        float d2 = lMagSqrd - (tca * tca);
+        if (d2 > radiusSqrd)
+            return false;
+
+        float thc = sqrtf(radiusSqrd - d2);
+        float t = tca - thc;
+        if (t < 0 || t > _rayLen)
+            return false;
+
+        if (pos)
+            *pos = rayStart + rayDir * t;
+        return true;
+    }
+
+    // --- Scenes, camera and picks -------------------------------------------
+
+    Vec3 RandomDirection(Lcg& _random)
+    {
+        return Vec3{_random.Range(-1.0f, 1.0f), _random.Range(-1.0f, 1.0f), _random.Range(-1.0f, 1.0f)}.Normalise();
+    }
+
+    // A perspective camera over the map, projecting the way Camera::Get2DScreenPos
+    // does: row vector times view, times projection, divide by w, into the viewport
+    struct SyntheticCamera
+    {
+        static constexpr float WIDTH = 1280.0f;
+        static constexpr float HEIGHT = 720.0f;
+
+        Vec3 m_eye, m_right, m_up, m_front;
+        float m_tanHalfFov = 0.0f;
+        float m_view[16] = {};
+        float m_proj[16] = {};
+
+        SyntheticCamera(const Vec3& _eye, const Vec3& _target, float _fovDegrees)
+          : m_eye(_eye)
+        {
+            m_front = (_target - _eye).Normalise();
+            m_right = (Vec3{0.0f, 1.0f, 0.0f} ^ m_front).Normalise();
+            m_up = m_front ^ m_right;
+            m_tanHalfFov = tanf(_fovDegrees * 0.5f * 3.14159265f / 180.0f);
+
+            const Vec3 axes[3] = {m_right, m_up, m_front};
+            for (int c = 0; c < 3; ++c)
+            {
+                m_view[0 * 4 + c] = (&axes[c].x)[0];
+                m_view[1 * 4 + c] = (&axes[c].x)[1];
+                m_view[2 * 4 + c] = (&axes[c].x)[2];
+                m_view[3 * 4 + c] = -(axes[c] * _eye);
+            }
+            m_view[15] = 1.0f;
+
+            const float nearZ = 1.0f, farZ = 10000.0f;
+            m_proj[0] = 1.0f / (m_tanHalfFov * WIDTH / HEIGHT);
+            m_proj[5] = 1.0f / m_tanHalfFov;
+            m_proj[10] = farZ / (farZ - nearZ);
+            m_proj[11] = 1.0f;
+            m_proj[14] = -nearZ * farZ / (farZ - nearZ);
+        }
+
+        static void Transform(const float _v[4], const float _m[16], float _out[4])
+        {
+            for (int c = 0; c < 4; ++c)
+                _out[c] = _v[0] * _m[c] + _v[1] * _m[4 + c] + _v[2] * _m[8 + c] + _v[3] * _m[12 + c];
+        }
+
+        void Project(const Vec3& _p, float* _x, float* _y) const
+        {
+            const float obj[4] = {_p.x, _p.y, _p.z, 1.0f};
+            float eye[4], clip[4];
+            Transform(obj, m_view, eye);
+            Transform(eye, m_proj, clip);
+            if (clip[3] == 0.0f)
+            {
+                *_x = *_y = std::numeric_limits<float>::quiet_NaN();
+                return;
+            }
+            *_x = (clip[0] / clip[3] * 0.5f + 0.5f) * WIDTH;
+            *_y = (clip[1] / clip[3] * 0.5f + 0.5f) * HEIGHT;
+        }
+
+        // Camera::GetClickRay for a pixel
+        void ClickRay(float _x, float _y, Vec3* _start, Vec3* _dir) const
+        {
+            const float ndcX = _x / WIDTH * 2.0f - 1.0f;
+            const float ndcY = _y / HEIGHT * 2.0f - 1.0f;
+            *_start = m_eye;
+            *_dir = (m_front + m_right * (ndcX * m_tanHalfFov * WIDTH / HEIGHT) + m_up * (ndcY * m_tanHalfFov)).Normalise();
+        }
+    };
+
+    struct ToySphere
+    {
+        Vec3 m_pos;
+        float m_radius;
+        bool m_unbounded;   // Hit by some other shape, as a radar dish is
+    };
+
+    // Entities and buildings on a map, a few of them duplicated so that picks
+    // tie, and a few too big to cull much
+    std::vector<ToySphere> MakeScene(Lcg& _random, int _count)
+    {
+        std::vector<ToySphere> spheres;
+        for (int i = 0; i < _count; ++i)
+        {
+            ToySphere s;
+            if (i > 10 && i % 17 == 0)
+            {
+                s = spheres[_random.Index(static_cast<int>(spheres.size()))];
+            }
+            else
+            {
+                s.m_pos = {_random.Range(0.0f, 2000.0f), _random.Range(0.0f, 120.0f), _random.Range(0.0f, 2000.0f)};
+                s.m_radius = i % 29 == 0 ? _random.Range(40.0f, 150.0f) : _random.Range(0.5f, 12.0f);
+                s.m_unbounded = i % 31 == 0;
+            }
+            spheres.push_back(s);
+        }
+        return spheres;
+    }
+
+    void BuildGrid(SphereGrid& _grid, const std::vector<ToySphere>& _spheres)
+    {
+        _grid.Build(static_cast<int>(_spheres.size()), [&](int _i)
+        {
+            const ToySphere& s = _spheres[_i];
+            if (s.m_unbounded)
+                return SphereGrid::Sphere{0.0f, 0.0f, 0.0f, std::numeric_limits<float>::infinity()};
+            return SphereGrid::Sphere{s.m_pos.x, s.m_pos.y, s.m_pos.z, s.m_radius};
+        });
+    }
+
+    struct Pick
+    {
+        int m_index = -1;
+        float m_rangeSqd = std::numeric_limits<float>::max();
+    };
+
+    // Location's loop before the grid: each hit projected on its own, the
+    // first closest kept
+    Pick PickAll(const std::vector<ToySphere>& _spheres, const SyntheticCamera& _camera, const Vec3& _start, const Vec3& _dir)
+    {
+        Pick pick;
+        for (int i = 0; i < static_cast<int>(_spheres.size()); ++i)
+        {
+            Vec3 hitPos;
+            if (RaySphereIntersection(_start, _dir, _spheres[i].m_pos, _spheres[i].m_radius, 1e10, &hitPos))
+            {
+                float centerPosX, centerPosY, rayHitX, rayHitY;
+                _camera.Project(_spheres[i].m_pos, &centerPosX, &centerPosY);
+                _camera.Project(hitPos, &rayHitX, &rayHitY);
+
+                float rangeSqd = pow(centerPosX - rayHitX, 2) + pow(centerPosY - rayHitY, 2);
+                if (rangeSqd < pick.m_rangeSqd)
+                {
+                    pick.m_rangeSqd = rangeSqd;
+                    pick.m_index = i;
+                }
+            }
+        }
+        return pick;
+    }
+
+    // Location's picks now: hits gathered from the grid in its own order, then
+    // projected together, ties going to the lowest index
+    Pick PickGrid(const SphereGrid& _grid, const std::vector<ToySphere>& _spheres, const SyntheticCamera& _camera, const Vec3& _start,
+                  const Vec3& _dir)
+    {
+        struct Hit
+        {
+            int m_index;
+            Vec3 m_hitPos;
+        };
+        std::vector<Hit> hits;
+        _grid.ForEachNearLine(_start, _dir, [&](int _i)
+        {
+            Vec3 hitPos;
+            if (RaySphereIntersection(_start, _dir, _spheres[_i].m_pos, _spheres[_i].m_radius, 1e10, &hitPos))
+                hits.push_back({_i, hitPos});
+        });
+
+        std::vector<float> screen(hits.size() * 4);
+        for (size_t h = 0; h < hits.size(); ++h)
+        {
+            _camera.Project(_spheres[hits[h].m_index].m_pos, &screen[h * 4], &screen[h * 4 + 1]);
+            _camera.Project(hits[h].m_hitPos, &screen[h * 4 + 2], &screen[h * 4 + 3]);
+        }
+
+        Pick pick;
+        for (size_t h = 0; h < hits.size(); ++h)
+        {
+            float rangeSqd = pow(screen[h * 4] - screen[h * 4 + 2], 2) + pow(screen[h * 4 + 1] - screen[h * 4 + 3], 2);
+            if (rangeSqd < pick.m_rangeSqd || (pick.m_index != -1 && rangeSqd == pick.m_rangeSqd && hits[h].m_index < pick.m_index))
+            {
+                pick.m_rangeSqd = rangeSqd;
+                pick.m_index = hits[h].m_index;
+            }
+        }
+        return pick;
+    }
+
+    SyntheticCamera MakeCamera(Lcg& _random)
+    {
+        const Vec3 target{_random.Range(200.0f, 1800.0f), 0.0f, _random.Range(200.0f, 1800.0f)};
+        const Vec3 offset = Vec3{_random.Range(-1.0f, 1.0f), _random.Range(0.2f, 1.0f), _random.Range(-1.0f, 1.0f)}.Normalise();
+        return SyntheticCamera(target + offset * _random.Range(50.0f, 1500.0f), target, _random.Range(30.0f, 90.0f));
+    }
+
+    // Rays a player might cast, and rays that only just graze a sphere
+    void MakeRay(Lcg& _random, const SyntheticCamera& _camera, const std::vector<ToySphere>& _spheres, int _kind, Vec3* _start,
+                 Vec3* _dir)
+    {
+        if (_kind == 0)
+        {
+            _camera.ClickRay(_random.Range(0.0f, SyntheticCamera::WIDTH), _random.Range(0.0f, SyntheticCamera::HEIGHT), _start, _dir);
+            return;
+        }
+
+        const ToySphere& s = _spheres[_random.Index(static_cast<int>(_spheres.size()))];
+        Vec3 target = s.m_pos;
+        if (_kind == 2)
+        {
+            const Vec3 toward = (s.m_pos - _camera.m_eye).Normalise();
+            const Vec3 side = (toward ^ RandomDirection(_random)).Normalise();
+            target = s.m_pos + side * (s.m_radius * _random.Range(0.999f, 1.001f));
+        }
+        *_start = _camera.m_eye;
+        *_dir = (target - _camera.m_eye).Normalise();
+    }
+}
+
+TEST_CLASS(SphereGridTests)
+{
+public:
+
+    // --- Culling ------------------------------------------------------------
+
+    TEST_METHOD(Query_VisitsFewSpheres)
+    {
+        Lcg random(3);
+        std::vector<ToySphere> spheres = MakeScene(random, 5000);
+        for (ToySphere& s : spheres)
+        {
+            s.m_radius = std::min(s.m_radius, 12.0f);
+            s.m_unbounded = false;
+        }
+        SphereGrid grid;
+        BuildGrid(grid, spheres);
+        Assert::AreEqual(5000, grid.GetNumItems());
+        Assert::AreEqual(0, grid.GetNumUnbounded());
+
+        // Straight down onto the map
+        int visited = 0;
+        grid.ForEachNearLine(Vec3{1000.0f, 500.0f, 1000.0f}, Vec3{0.0f, -1.0f, 0.0f}, [&](int) { ++visited; });
+        Assert::IsTrue(visited < 5000 / 100);
+    }
+
+    TEST_METHOD(Query_UnboundedAlwaysVisited)
+    {
+        Lcg random(5);
+        std::vector<ToySphere> spheres = MakeScene(random, 1000);
+        SphereGrid grid;
+        BuildGrid(grid, spheres);
+
+        int unbounded = 0;
+        for (const ToySphere& s : spheres)
+            unbounded += s.m_unbounded ? 1 : 0;
+        Assert::AreEqual(unbounded, grid.GetNumUnbounded());
+
+        std::vector<char> visited(spheres.size(), 0);
+        grid.ForEachNearLine(Vec3{-500.0f, 5000.0f, -500.0f}, Vec3{0.0f, 1.0f, 0.0f}, [&](int _i) { visited[_i] = 1; });
+        for (size_t i = 0; i < spheres.size(); ++i)
+        {
+            if (spheres[i].m_unbounded)
+                Assert::IsTrue(visited[i] != 0);
+        }
+    }
+
+    TEST_METHOD(Query_NonFiniteLineVisitsEverything)
+    {
+        Lcg random(11);
+        std::vector<ToySphere> spheres = MakeScene(random, 300);
+        SphereGrid grid;
+        BuildGrid(grid, spheres);
+
+        int visited = 0;
+        grid.ForEachNearLine(Vec3{0.0f, 0.0f, 0.0f}, Vec3{std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f}, [&](int) { ++visited; });
+        Assert::AreEqual(300, visited);
+    }
+
+    TEST_METHOD(Build_Empty)
+    {
+        SphereGrid grid;
+        grid.Build(0, [](int) { return SphereGrid::Sphere{}; });
+        Assert::AreEqual(0, grid.GetNumCells());
+        int visited = 0;
+        grid.ForEachNearLine(Vec3{}, Vec3{0.0f, 0.0f, 1.0f}, [&](int) { ++visited; });
+        Assert::AreEqual(0, visited);
+    }
+
+    // --- Equivalence --------------------------------------------------------
+
+    TEST_METHOD(Query_FindsEveryHit)
+    {
+        // Including directions a little off unit length, which loosen the
+        // exact test
+        Lcg random(777);
+        for (int round = 0; round < 10; ++round)
+        {
+            std::vector<ToySphere> spheres = MakeScene(random, 500 + round * 100);
+            SphereGrid grid;
+            BuildGrid(grid, spheres);
+
+            for (int q = 0; q < 300; ++q)
+            {
+                const SyntheticCamera camera = MakeCamera(random);
+                Vec3 start, dir;
+                MakeRay(random, camera, spheres, q % 3, &start, &dir);
+                if (q % 5 == 0)
+                    dir = dir * (q % 10 == 0 ? 1.002f : 0.998f);
+
+                std::vector<char> visited(spheres.size(), 0);
+                grid.ForEachNearLine(start, dir, [&](int _i) { ++visited[_i]; });
+                for (size_t i = 0; i < spheres.size(); ++i)
+                {
+                    Assert::IsTrue(visited[i] <= 1);
+                    if (RaySphereIntersection(start, dir, spheres[i].m_pos, spheres[i].m_radius))
+                        Assert::IsTrue(visited[i] == 1);
+                }
+            }
+        }
+    }
+
+    TEST_METHOD(Equivalence_RandomScenesAndCameras)
+    {
+        Lcg random(12345);
+        int picks = 0, queries = 0, grazes = 0;
+        for (int round = 0; round < 20; ++round)
+        {
+            std::vector<ToySphere> spheres = MakeScene(random, 200 + round * 150);
+            SphereGrid grid;
+            BuildGrid(grid, spheres);
+
+            for (int c = 0; c < 10; ++c)
+            {
+                const SyntheticCamera camera = MakeCamera(random);
+                for (int q = 0; q < 100; ++q)
+                {
+                    Vec3 start, dir;
+                    const int kind = q % 3;
+                    MakeRay(random, camera, spheres, kind, &start, &dir);
+
+                    const Pick all = PickAll(spheres, camera, start, dir);
+                    const Pick fast = PickGrid(grid, spheres, camera, start, dir);
+                    Assert::AreEqual(all.m_index, fast.m_index);
+                    Assert::AreEqual(all.m_rangeSqd, fast.m_rangeSqd);
+
+                    picks += all.m_index != -1;
+                    grazes += kind == 2 && all.m_index != -1;
+                    ++queries;
+                }
+            }
+        }
+
+        // Rays must have both hit and missed plenty, and grazed some
+        Assert::IsTrue(picks > queries / 4 && picks < queries * 19 / 20);
+        Assert::IsTrue(grazes > queries / 30);
+    }
+
+    TEST_METHOD(Equivalence_TiesGoToTheLowestIndex)
+    {
+        // Several copies of one sphere: whichever order the grid visits them
+        // in, the loop's answer is the first
+        std::vector<ToySphere> spheres;
+        Lcg random(21);
+        for (int i = 0; i < 200; ++i)
+            spheres.push_back({{random.Range(0.0f, 2000.0f), 10.0f, random.Range(0.0f, 2000.0f)}, 5.0f, false});
+        for (int i = 0; i < 8; ++i)
+            spheres.push_back({{1000.0f, 10.0f, 1000.0f}, 5.0f, false});
+
+        SphereGrid grid;
+        BuildGrid(grid, spheres);
+        const SyntheticCamera camera(Vec3{1000.0f, 800.0f, 600.0f}, Vec3{1000.0f, 0.0f, 1000.0f}, 60.0f);
+        const Vec3 dir = (Vec3{1000.0f, 11.0f, 1000.0f} - camera.m_eye).Normalise();
+
+        const Pick all = PickAll(spheres, camera, camera.m_eye, dir);
+        Assert::AreEqual(200, all.m_index);
+        Assert::AreEqual(all.m_index, PickGrid(grid, spheres, camera, camera.m_eye, dir).m_index);
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_CursorPicks)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_CursorPicks)
+    {
+        // A crowded map picked four times a frame, as the cursor, task
+        // manager and input code do, with the grid rebuilt every frame
+        constexpr int SPHERES = 20000;
+        constexpr int FRAMES = 200;
+        constexpr int PICKS_PER_FRAME = 4;
+
+        Lcg random(99);
+        std::vector<ToySphere> spheres = MakeScene(random, SPHERES);
+        for (ToySphere& s : spheres)
+            s.m_radius = std::min(s.m_radius, 12.0f);
+
+        std::vector<SyntheticCamera> cameras;
+        std::vector<Vec3> starts, dirs;
+        for (int f = 0; f < FRAMES; ++f)
+        {
+            cameras.push_back(MakeCamera(random));
+            Vec3 start, dir;
+            MakeRay(random, cameras.back(), spheres, f % 2, &start, &dir);
+            starts.push_back(start);
+            dirs.push_back(dir);
+        }
+
+        std::vector<Pick> answers;
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < FRAMES; ++f)
+        {
+            for (int p = 0; p < PICKS_PER_FRAME; ++p)
+                answers.push_back(PickAll(spheres, cameras[f], starts[f], dirs[f]));
+        }
+        const auto middle = std::chrono::steady_clock::now();
+
+        SphereGrid grid;
+        for (int f = 0; f < FRAMES; ++f)
+        {
+            BuildGrid(grid, spheres);
+            for (int p = 0; p < PICKS_PER_FRAME; ++p)
+                Assert::AreEqual(answers[f * PICKS_PER_FRAME + p].m_index, PickGrid(grid, spheres, cameras[f], starts[f], dirs[f]).m_index);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double all = std::chrono::duration<double>(middle - start).count();
+        const double fast = std::chrono::duration<double>(end - middle).count();
+        Logger::WriteMessage(std::format("{} spheres, {} picks a frame: {:.1f} us/frame all, {:.1f} us/frame grid ({:.1f}x)\n", SPHERES,
+            PICKS_PER_FRAME, all * 1.0e6 / FRAMES, fast * 1.0e6 / FRAMES, all / fast).c_str());
+    }
+};
@@ -0,0 +1,392 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    struct NoCaseLess
+    {
+        bool operator()(const std::string& _a, const std::string& _b) const { return StringKey::Compare(_a, _b) < 0; }
+    };
+
+    int CompareNoCase(const char* _a, const char* _b) { return StringKey::Compare(_a, _b); }
+
+    // --- The containers StringMap replaced, as NeuronClient had them -------
+
+    // HashTable<T>: 16 bit additive hash, linear probing, doubling at half
+    // full, keys compared with _stricmp
+    template <typename T>
+    class LegacyHashTable
+    {
+    public:
+        LegacyHashTable() : m_keys(4, nullptr), m_data(4), m_mask(3), m_slotsFree(4) {}
+
+        ~LegacyHashTable()
+        {
+            for (char* key : m_keys)
+                delete[] key;
+        }
+
+        int GetIndex(const char* _key) const
+        {
+            unsigned int index = HashFunc(_key);
+            if (!m_keys[index])
+                return -1;
+            while (CompareNoCase(m_keys[index], _key) != 0)
+            {
+                index = (index + 1) & m_mask;
+                if (!m_keys[index])
+                    return -1;
+            }
+            return static_cast<int>(index);
+        }
+
+        void PutData(const char* _key, const T& _data)
+        {
+            if (m_slotsFree * 2 <= m_keys.size())
+                Grow();
+            const unsigned int index = GetInsertPos(_key);
+            const size_t len = strlen(_key) + 1;
+            m_keys[index] = new char[len];
+            memcpy(m_keys[index], _key, len);
+            m_data[index] = _data;
+            --m_slotsFree;
+        }
+
+        T GetData(const char* _key, const T& _default = T{}) const
+        {
+            const int index = GetIndex(_key);
+            return index >= 0 ? m_data[index] : _default;
+        }
+
+    private:
+        unsigned int HashFunc(const char* _key) const
+        {
+            unsigned short rv = 0;
+            while (_key[0] && _key[1])
+            {
+                rv += _key[0] & 0xDF;
+                rv += ~(_key[1] & 0xDF);
+                _key += 2;
+            }
+            if (_key[0])
+                rv += *_key & 0xDF;
+            return rv & m_mask;
+        }
+
+        unsigned int GetInsertPos(const char* _key) const
+        {
+            unsigned int index = HashFunc(_key);
+            while (m_keys[index])
+                index = (index + 1) & m_mask;
+            return index;
+        }
+
+        void Grow()
+        {
+            Assert::IsTrue(m_keys.size() < 65536);
+            std::vector<char*> oldKeys(m_keys.size() * 2, nullptr);
+            std::vector<T> oldData(m_keys.size() * 2);
+            std::swap(oldKeys, m_keys);
+            std::swap(oldData, m_data);
+            m_mask = static_cast<unsigned int>(m_keys.size()) - 1;
+            for (size_t i = 0; i < oldKeys.size(); ++i)
+            {
+                if (oldKeys[i])
+                {
+                    const unsigned int index = GetInsertPos(oldKeys[i]);
+                    m_keys[index] = oldKeys[i];
+                    m_data[index] = oldData[i];
+                }
+            }
+            m_slotsFree += static_cast<unsigned int>(m_keys.size() - oldKeys.size());
+        }
+
+        std::vector<char*> m_keys;
+        std::vector<T> m_data;
+        unsigned int m_mask;
+        unsigned int m_slotsFree;
+    };
+
+    // BTree<T>: unbalanced binary tree on _stricmp
+    template <typename T>
+    class LegacyBTree
+    {
+    public:
+        ~LegacyBTree()
+        {
+            for (Node* node : m_nodes)
+            {
+                delete[] node->m_id;
+                delete node;
+            }
+        }
+
+        void PutData(const char* _id, const T& _data)
+        {
+            Node** link = &m_root;
+            while (*link)
+                link = CompareNoCase(_id, (*link)->m_id) <= 0 ? &(*link)->m_left : &(*link)->m_right;
+
+            const size_t len = strlen(_id) + 1;
+            *link = new Node{new char[len], _data};
+            memcpy((*link)->m_id, _id, len);
+            m_nodes.push_back(*link);
+        }
+
+        T GetData(const char* _id) const
+        {
+            for (const Node* node = m_root; node;)
+            {
+                const int compare = CompareNoCase(_id, node->m_id);
+                if (compare == 0)
+                    return node->m_data;
+                node = compare < 0 ? node->m_left : node->m_right;
+            }
+            return T{};
+        }
+
+    private:
+        struct Node
+        {
+            char* m_id;
+            T m_data;
+            Node* m_left = nullptr;
+            Node* m_right = nullptr;
+        };
+
+        Node* m_root = nullptr;
+        std::vector<Node*> m_nodes;
+    };
+
+    // Names like the ones the resource, profiler and language tables hold
+    std::vector<std::string> MakeNames(int _count, const char* _prefix)
+    {
+        std::vector<std::string> names;
+        for (int i = 0; i < _count; ++i)
+            names.push_back(std::string(_prefix) + (i % 37 == 0 ? "Sprites/" : "textures/") + std::to_string(i) + ".bmp");
+        return names;
+    }
+
+    struct Counted
+    {
+        explicit Counted(int* _deleted) : m_deleted(_deleted) {}
+        ~Counted() { ++*m_deleted; }
+        int* m_deleted;
+    };
+}
+
+TEST_CLASS(StringMapTests)
+{
+public:
+    // --- StringKey ----------------------------------------------------------
+
+    TEST_METHOD(StringKey_HashIgnoresCaseAndIsNeverZero)
+    {
+        static_assert(StringKey("Advance SoundSystem").GetHash() == StringKey("ADVANCE soundsystem").GetHash());
+        static_assert(StringKey("").GetHash() != 0);
+
+        Assert::AreEqual(StringKey("textures/Laser.bmp").GetHash(), StringKey(std::string("TEXTURES/laser.BMP")).GetHash());
+        Assert::IsTrue(StringKey::Equal("RenderWaterDetail", "renderwaterdetail"));
+        Assert::IsFalse(StringKey::Equal("RenderWaterDetail", "RenderWaterDetai"));
+
+        Assert::IsTrue(StringKey::Compare("abc", "ABD") < 0);
+        Assert::IsTrue(StringKey::Compare("ABC", "ab") > 0);
+        Assert::AreEqual(0, StringKey::Compare("Part_One", "part_one"));
+    }
+
+    // --- StringMap ----------------------------------------------------------
+
+    TEST_METHOD(StringMap_FindIgnoresCase)
+    {
+        StringMap<int> map;
+        map.InsertOrAssign("ControlMethod", 1);
+        map.InsertOrAssign("UserProfile", 2);
+
+        Assert::AreEqual(1, *map.Find("controlmethod"));
+        Assert::AreEqual(2, map.Get("USERPROFILE"));
+        Assert::IsNull(map.Find("Control"));
+        Assert::AreEqual(-1, map.Get("Missing", -1));
+
+        // A view into a longer string looks up by the view alone
+        const std::string line = "UserProfile = NewUser";
+        Assert::AreEqual(2, map.Get(std::string_view(line).substr(0, 11)));
+    }
+
+    TEST_METHOD(StringMap_TryEmplaceKeepsInsertOrAssignReplaces)
+    {
+        StringMap<int> map;
+        auto [first, isNew] = map.TryEmplace("Key", 1);
+        Assert::IsTrue(isNew);
+        Assert::AreEqual(1, *first);
+
+        auto [second, isNewAgain] = map.TryEmplace("KEY", 2);
+        Assert::IsFalse(isNewAgain);
+        Assert::AreEqual(1, *second);
+
+        map.InsertOrAssign("kEY", 3);
+        Assert::AreEqual(3, map.Get("Key"));
+        Assert::AreEqual(1, map.Count());
+
+        // The first spelling is the one kept
+        map.ForEach([](std::string_view _key, int) { Assert::IsTrue(_key == "Key"); });
+    }
+
+    TEST_METHOD(StringMap_GrowsPastTheOldLimit)
+    {
+        // HashTable asserted once it needed more than 65536 slots
+        constexpr int COUNT = 100000;
+        const std::vector<std::string> names = MakeNames(COUNT, "");
+
+        StringMap<int> map;
+        for (int i = 0; i < COUNT; ++i)
+            map.TryEmplace(names[i], i);
+
+        Assert::AreEqual(COUNT, map.Count());
+        Assert::IsTrue(map.GetNumSlots() > 65536);
+        for (int i = 0; i < COUNT; ++i)
+            Assert::AreEqual(i, map.Get(names[i], -1));
+    }
+
+    TEST_METHOD(StringMap_MatchesAMapThroughInsertsAndErases)
+    {
+        // Few enough keys that the table stays small and its runs collide,
+        // so erase has chains to repair
+        constexpr int KEYS = 300;
+        const std::vector<std::string> names = MakeNames(KEYS, "Erase");
+
+        Lcg random(44);
+        StringMap<int> map;
+        std::map<std::string, int, NoCaseLess> reference;
+        for (int step = 0; step < 30000; ++step)
+        {
+            const std::string& name = names[random.Index(KEYS)];
+            switch (random.Index(3))
+            {
+            case 0:
+                map.InsertOrAssign(name, step);
+                reference[name] = step;
+                break;
+            case 1:
+                map.TryEmplace(name, step);
+                reference.try_emplace(name, step);
+                break;
+            default:
+                Assert::AreEqual(reference.erase(name) == 1, map.Erase(name));
+                break;
+            }
+
+            if (step % 1000 == 0)
+            {
+                Assert::AreEqual(static_cast<int>(reference.size()), map.Count());
+                for (const std::string& n : names)
+                {
+                    const auto it = reference.find(n);
+                    const int* value = map.Find(n);
+                    Assert::AreEqual(it != reference.end(), value != nullptr);
+                    if (value)
+                        Assert::AreEqual(it->second, *value);
+                }
+            }
+        }
+
+        map.Clear();
+        Assert::IsTrue(map.IsEmpty());
+        Assert::IsNull(map.Find(names[0]));
+        map.InsertOrAssign(names[0], 7);
+        Assert::AreEqual(7, map.Get(names[0]));
+    }
+
+    TEST_METHOD(StringMap_ForEachSortedIgnoresCase)
+    {
+        const char* keys[] = {"part_b", "Zeta", "alpha", "Beta", "PART_A", "gamma_kbd", "gamma"};
+
+        StringMap<int> map;
+        std::map<std::string, int, NoCaseLess> reference;
+        for (int i = 0; i < static_cast<int>(std::size(keys)); ++i)
+        {
+            map.TryEmplace(keys[i], i);
+            reference.emplace(keys[i], i);
+        }
+
+        std::vector<int> walked;
+        map.ForEachSorted([&](std::string_view, int _value) { walked.push_back(_value); });
+
+        std::vector<int> expected;
+        for (const auto& [key, value] : reference)
+            expected.push_back(value);
+        Assert::IsTrue(walked == expected);
+    }
+
+    TEST_METHOD(StringMap_ClearAndDeleteOwnsValues)
+    {
+        int deleted = 0;
+        StringMap<Counted*> map;
+        map.TryEmplace("a", new Counted(&deleted));
+        map.TryEmplace("b", new Counted(&deleted));
+        map.TryEmplace("c", new Counted(&deleted));
+
+        map.ClearAndDelete();
+        Assert::AreEqual(3, deleted);
+        Assert::AreEqual(0, map.Count());
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_Lookup)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_Lookup)
+    {
+        // Fill each container with a resource table's worth of names, then
+        // look names up, half of them absent and in another case
+        constexpr int LOOKUPS = 50000;
+
+        for (const int count : {64, 1000, 4000})
+        {
+            const std::vector<std::string> names = MakeNames(count, "");
+            std::vector<std::string> queries;
+            Lcg random(static_cast<uint32_t>(count));
+            for (int i = 0; i < LOOKUPS; ++i)
+            {
+                std::string query = names[random.Index(count)];
+                if (i & 1)
+                {
+                    std::ranges::transform(query, query.begin(), [](char _c) { return static_cast<char>(toupper(static_cast<unsigned char>(_c))); });
+                    query += "x";
+                }
+                queries.push_back(std::move(query));
+            }
+
+            using Clock = std::chrono::steady_clock;
+            const auto time = [](auto&& _work)
+            {
+                const auto start = Clock::now();
+                _work();
+                return std::chrono::duration<double>(Clock::now() - start).count();
+            };
+
+            long long legacySum = 0, treeSum = 0, mapSum = 0;
+            LegacyHashTable<int> legacy;
+            LegacyBTree<int> tree;
+            StringMap<int> map;
+
+            const double legacyFill = time([&] { for (int i = 0; i < count; ++i) legacy.PutData(names[i].c_str(), i + 1); });
+            const double treeFill = time([&] { for (int i = 0; i < count; ++i) tree.PutData(names[i].c_str(), i + 1); });
+            const double mapFill = time([&] { for (int i = 0; i < count; ++i) map.TryEmplace(names[i], i + 1); });
+
+            const double legacyFind = time([&] { for (const std::string& q : queries) legacySum += legacy.GetData(q.c_str()); });
+            const double treeFind = time([&] { for (const std::string& q : queries) treeSum += tree.GetData(q.c_str()); });
+            const double mapFind = time([&] { for (const std::string& q : queries) mapSum += map.Get(q); });
+
+            Assert::AreEqual(legacySum, mapSum);
+            Assert::AreEqual(treeSum, mapSum);
+
+            Logger::WriteMessage(std::format("{} names: fill {:.0f} / {:.0f} / {:.0f} ns per name, find {:.0f} / {:.0f} / {:.0f} ns "
+                                             "(HashTable / BTree / StringMap), {:.1f}x faster than HashTable\n",
+                count, legacyFill * 1.0e9 / count, treeFill * 1.0e9 / count, mapFill * 1.0e9 / count,
+                legacyFind * 1.0e9 / LOOKUPS, treeFind * 1.0e9 / LOOKUPS, mapFind * 1.0e9 / LOOKUPS, legacyFind / mapFind).c_str());
+        }
+    }
+};
@@ -0,0 +1,172 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // Rolling ground with flat sea floor at zero, as a landscape is
+    void FillHeights(SurfaceMap2D<float>& _map, Lcg& _rng)
+    {
+        for (unsigned short y = 0; y < _map.GetNumRows(); ++y)
+        {
+            for (unsigned short x = 0; x < _map.GetNumColumns(); ++x)
+            {
+                const float height = 40.0f * sinf(x * 0.13f) * cosf(y * 0.07f) + _rng.Range(-3.0f, 3.0f);
+                _map.PutData(x, y, height < 0.0f ? 0.0f : height);
+            }
+        }
+    }
+
+    // GetValues, which samples four at a time, against GetValue one by one
+    void AssertSameBits(const SurfaceMap2D<float>& _map, const std::vector<float>& _x, const std::vector<float>& _y)
+    {
+        std::vector<float> batched(_x.size());
+        _map.GetValues(_x.data(), _y.data(), batched.data(), static_cast<int>(_x.size()));
+        for (size_t i = 0; i < _x.size(); ++i)
+            Assert::AreEqual(std::bit_cast<uint32_t>(_map.GetValue(_x[i], _y[i])), std::bit_cast<uint32_t>(batched[i]));
+    }
+}
+
+TEST_CLASS(SurfaceKernelsTests)
+{
+public:
+
+    // --- Equivalence --------------------------------------------------------
+
+    TEST_METHOD(RandomPoints_MatchGetValueBitForBit)
+    {
+        struct Shape
+        {
+            float m_width;
+            float m_height;
+            float m_x0;
+            float m_y0;
+            float m_cellSizeX;
+            float m_cellSizeY;
+        };
+
+        Lcg rng(2024);
+        for (const Shape& shape : {Shape{2000.0f, 2000.0f, 0.0f, 0.0f, 12.0f, 12.0f}, Shape{1500.0f, 900.0f, -250.0f, -150.0f, 7.3f, 11.1f},
+                                   Shape{100.0f, 100.0f, 0.0f, 0.0f, 100.0f, 100.0f}, Shape{64.0f, 31.0f, 3.5f, -8.25f, 1.0f, 0.5f}})
+        {
+            SurfaceMap2D<float> map(shape.m_width, shape.m_height, shape.m_x0, shape.m_y0, shape.m_cellSizeX, shape.m_cellSizeY, -1.0f);
+            FillHeights(map, rng);
+
+            // Mostly on the map, with plenty off every edge where indices wrap
+            std::vector<float> x, y;
+            for (int i = 0; i < 20003; ++i)
+            {
+                x.push_back(shape.m_x0 + rng.Range(-0.5f, 1.5f) * shape.m_width);
+                y.push_back(shape.m_y0 + rng.Range(-0.5f, 1.5f) * shape.m_height);
+            }
+            AssertSameBits(map, x, y);
+        }
+    }
+
+    TEST_METHOD(EdgeCoordinates_MatchGetValueBitForBit)
+    {
+        SurfaceMap2D<float> map(640.0f, 480.0f, -20.0f, 10.0f, 8.0f, 6.0f, -1.0f);
+        Lcg rng(7);
+        FillHeights(map, rng);
+
+        // Cell corners, the origin from either side, signed zeros once the
+        // origin is taken off, and far enough out that the 16 bit index wraps
+        const float tiny = 1.0e-5f;
+        std::vector<float> x, y;
+        for (const float dx : {-0.0f, 0.0f, tiny, -tiny, 8.0f, 320.0f, 639.99f, 640.0f, 648.0f, -8.0f, 524288.0f, -524288.0f, 1.0e8f})
+        {
+            for (const float dy : {-0.0f, 0.0f, tiny, -tiny, 6.0f, 240.0f, 479.99f, 480.0f, 486.0f, -6.0f, 393216.0f, -1.0e8f})
+            {
+                x.push_back(-20.0f + dx);
+                y.push_back(10.0f + dy);
+                x.push_back(dx);
+                y.push_back(dy);
+            }
+        }
+        AssertSameBits(map, x, y);
+
+        // With the origin at zero a coordinate of -0 gives a fraction of -0,
+        // and where every sample is -0 that decides the sign of the result
+        SurfaceMap2D<float> zeros(64.0f, 64.0f, 0.0f, 0.0f, 4.0f, 4.0f, -1.0f);
+        zeros.SetAll(-0.0f);
+        AssertSameBits(zeros, x, y);
+    }
+
+    TEST_METHOD(EveryTailLength_MatchesGetValue)
+    {
+        SurfaceMap2D<float> map(300.0f, 300.0f, 0.0f, 0.0f, 10.0f, 10.0f, -1.0f);
+        Lcg rng(31);
+        FillHeights(map, rng);
+
+        for (int count = 0; count <= 9; ++count)
+        {
+            std::vector<float> x, y;
+            for (int i = 0; i < count; ++i)
+            {
+                x.push_back(rng.Range(0.0f, 300.0f));
+                y.push_back(rng.Range(0.0f, 300.0f));
+            }
+            AssertSameBits(map, x, y);
+        }
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_SamplesPerSecond)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_SamplesPerSecond)
+    {
+        // A landscape sized height map, sampled at scattered points as
+        // entities snap to the ground and in rows as the water light map and
+        // the camera's ray walks do
+        SurfaceMap2D<float> map(4000.0f, 4000.0f, 0.0f, 0.0f, 12.0f, 12.0f, -1.0f);
+        Lcg rng(5);
+        FillHeights(map, rng);
+
+        constexpr int COUNT = 1 << 16;
+        constexpr int PASSES = 40;
+
+        struct Pattern
+        {
+            const char* m_name;
+            bool m_scattered;
+        };
+
+        for (const Pattern& pattern : {Pattern{"scattered", true}, Pattern{"rows", false}})
+        {
+            std::vector<float> x(COUNT), y(COUNT);
+            for (int i = 0; i < COUNT; ++i)
+            {
+                x[i] = pattern.m_scattered ? rng.Range(0.0f, 4000.0f) : 4000.0f * static_cast<float>(i % 256) / 256.0f;
+                y[i] = pattern.m_scattered ? rng.Range(0.0f, 4000.0f) : 4000.0f * static_cast<float>(i / 256) / 256.0f;
+            }
+            std::vector<float> out(COUNT);
+
+            double scalarSum = 0.0;
+            const auto scalarStart = std::chrono::steady_clock::now();
+            for (int pass = 0; pass < PASSES; ++pass)
+            {
+                for (int i = 0; i < COUNT; ++i)
+                    out[i] = map.GetValue(x[i], y[i]);
+                scalarSum += out[pass];
+            }
+            const double scalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - scalarStart).count();
+
+            double batchedSum = 0.0;
+            const auto batchedStart = std::chrono::steady_clock::now();
+            for (int pass = 0; pass < PASSES; ++pass)
+            {
+                map.GetValues(x.data(), y.data(), out.data(), COUNT);
+                batchedSum += out[pass];
+            }
+            const double batchedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - batchedStart).count();
+
+            Assert::AreEqual(scalarSum, batchedSum);
+            const double samples = static_cast<double>(COUNT) * PASSES;
+            Logger::WriteMessage(std::format("{}: GetValue {:.1f} M samples/s, GetValues {:.1f} M samples/s ({:.1f}x)\n", pattern.m_name,
+                samples / scalarSeconds * 1.0e-6, samples / batchedSeconds * 1.0e-6, scalarSeconds / batchedSeconds).c_str());
+        }
+    }
+};
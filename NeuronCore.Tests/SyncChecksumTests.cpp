@@ -0,0 +1,90 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+TEST_CLASS(SyncChecksumTests)
+{
+public:
+
+    // --- SyncHasher ---------------------------------------------------------
+
+    TEST_METHOD(Hasher_SameInput_SameDigest)
+    {
+        uint64_t a = SyncHasher().Fold(1).Fold(2.5f).Fold(true).Value();
+        uint64_t b = SyncHasher().Fold(1).Fold(2.5f).Fold(true).Value();
+        Assert::AreEqual(a, b);
+    }
+
+    TEST_METHOD(Hasher_IsOrderSensitive)
+    {
+        uint64_t a = SyncHasher().Fold(1).Fold(2).Value();
+        uint64_t b = SyncHasher().Fold(2).Fold(1).Value();
+        Assert::AreNotEqual(a, b);
+    }
+
+    TEST_METHOD(Hasher_DistinguishesSignedZero)
+    {
+        // Lockstep requires bit-identical state, so -0.0f must not hash like 0.0f
+        uint64_t a = SyncHasher().Fold(0.0f).Value();
+        uint64_t b = SyncHasher().Fold(-0.0f).Value();
+        Assert::AreNotEqual(a, b);
+    }
+
+    // --- SyncChecksum -------------------------------------------------------
+
+    TEST_METHOD(Checksum_IsOrderIndependent)
+    {
+        SyncChecksum a;
+        SyncChecksum b;
+        for (uint64_t i = 0; i < 100; ++i)
+            a.Add(SyncMix(i));
+        for (uint64_t i = 100; i-- > 0;)
+            b.Add(SyncMix(i));
+        Assert::AreEqual(a.Value(), b.Value());
+    }
+
+    TEST_METHOD(Checksum_IncrementalUpdate_MatchesRebuild)
+    {
+        constexpr int COUNT = 64;
+        uint64_t state[COUNT];
+        uint64_t contribution[COUNT] = {};
+
+        SyncChecksum incremental;
+        for (int i = 0; i < COUNT; ++i)
+        {
+            state[i] = i;
+            incremental.Update(contribution[i], SyncMix(state[i]));
+        }
+
+        // Mutate a subset, then retire one object
+        for (int tick = 0; tick < 10; ++tick)
+        {
+            int index = (tick * 7) % COUNT;
+            state[index] += 1000;
+            incremental.Update(contribution[index], SyncMix(state[index]));
+        }
+        incremental.Retire(contribution[5]);
+
+        SyncChecksum rebuilt;
+        for (int i = 0; i < COUNT; ++i)
+        {
+            if (i != 5)
+                rebuilt.Add(SyncMix(state[i]));
+        }
+
+        Assert::AreEqual(rebuilt.Value(), incremental.Value());
+        Assert::AreEqual(uint64_t(0), contribution[5]);
+    }
+
+    TEST_METHOD(Checksum_SingleChange_IsDetected)
+    {
+        uint64_t c1 = 0;
+        uint64_t c2 = 0;
+        SyncChecksum a;
+        SyncChecksum b;
+        a.Update(c1, SyncHasher().Fold(1.0f).Value());
+        b.Update(c2, SyncHasher().Fold(1.0000001f).Value());
+        Assert::AreNotEqual(a.Value(), b.Value());
+    }
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+// The tests' random numbers: a 32 bit LCG with the Numerical Recipes
+// constants, seeded by each test, so every run sees the same sequence.
+// Next gives the top 24 bits; the other forms scale those into [0, 1).
+class Lcg
+{
+public:
+    explicit Lcg(uint32_t _seed) : m_state(_seed) {}
+
+    uint32_t Next()
+    {
+        m_state = m_state * 1664525u + 1013904223u;
+        return m_state >> 8;
+    }
+
+    float NextFloat() { return static_cast<float>(Next()) / 16777216.0f; }   // [0, 1)
+
+    float Range(float _lo, float _hi) { return _lo + (_hi - _lo) * NextFloat(); }   // [_lo, _hi)
+
+    int Index(int _count) { return std::min(static_cast<int>(NextFloat() * _count), _count - 1); }   // [0, _count)
+
+private:
+    uint32_t m_state;
+};
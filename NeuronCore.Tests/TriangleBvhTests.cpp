@@ -0,0 +1,427 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    // The exact tests are math_utils' own RayTriIntersection and
+    // SphereTriangleIntersection, built into this project with the
+    // LegacyVector3 / Matrix34 arithmetic they run on
+
+    // --- Meshes and queries -------------------------------------------------
+
+    LegacyVector3 RandomInBox(Lcg& _random, const LegacyVector3& _lo, const LegacyVector3& _hi)
+    {
+        return {_random.Range(_lo.x, _hi.x), _random.Range(_lo.y, _hi.y), _random.Range(_lo.z, _hi.z)};
+    }
+
+    LegacyVector3 RandomDirection(Lcg& _random)
+    {
+        return LegacyVector3{_random.Range(-1.0f, 1.0f), _random.Range(-1.0f, 1.0f), _random.Range(-1.0f, 1.0f)}.Normalise();
+    }
+
+    struct ToyMesh
+    {
+        std::vector<LegacyVector3> m_positions;
+        std::vector<std::array<int, 3>> m_triangles;
+
+        void Build(TriangleBvh& _tree) const
+        {
+            _tree.Build(static_cast<int>(m_triangles.size()), [&](int _triangle, int _corner) -> const LegacyVector3&
+            {
+                return m_positions[m_triangles[_triangle][_corner]];
+            });
+        }
+
+        [[nodiscard]] LegacyVector3 Corner(const Matrix34& _frame, int _triangle, int _corner) const
+        {
+            return m_positions[m_triangles[_triangle][_corner]] * _frame;
+        }
+
+        [[nodiscard]] bool RayHitsTriangle(const Matrix34& _frame, const LegacyVector3& _start, const LegacyVector3& _dir, int _triangle) const
+        {
+            return RayTriIntersection(_start, _dir, Corner(_frame, _triangle, 0), Corner(_frame, _triangle, 1), Corner(_frame, _triangle, 2));
+        }
+
+        [[nodiscard]] bool SphereHitsTriangle(const Matrix34& _frame, const LegacyVector3& _center, float _radius, int _triangle) const
+        {
+            return SphereTriangleIntersection(_center, _radius, Corner(_frame, _triangle, 0), Corner(_frame, _triangle, 1),
+                                              Corner(_frame, _triangle, 2));
+        }
+
+        // The loops ShapeFragmentData::RayHit / SphereHit used to run
+        [[nodiscard]] bool RayHitAll(const Matrix34& _frame, const LegacyVector3& _start, const LegacyVector3& _dir) const
+        {
+            for (int i = 0; i < static_cast<int>(m_triangles.size()); ++i)
+            {
+                if (RayHitsTriangle(_frame, _start, _dir, i))
+                    return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool SphereHitAll(const Matrix34& _frame, const LegacyVector3& _center, float _radius) const
+        {
+            for (int i = 0; i < static_cast<int>(m_triangles.size()); ++i)
+            {
+                if (SphereHitsTriangle(_frame, _center, _radius, i))
+                    return true;
+            }
+            return false;
+        }
+
+        [[nodiscard]] bool RayHitTree(const TriangleBvh& _tree, const Matrix34& _frame, const LegacyVector3& _start, const LegacyVector3& _dir) const
+        {
+            return _tree.AnyNearLine(_frame, _start, _dir, [&](int _triangle) { return RayHitsTriangle(_frame, _start, _dir, _triangle); });
+        }
+
+        [[nodiscard]] bool SphereHitTree(const TriangleBvh& _tree, const Matrix34& _frame, const LegacyVector3& _center, float _radius) const
+        {
+            return _tree.AnyNearSphere(_frame, _center, _radius,
+                                       [&](int _triangle) { return SphereHitsTriangle(_frame, _center, _radius, _triangle); });
+        }
+    };
+
+    // Clusters of triangles of mixed sizes, plus slivers with repeated,
+    // collinear and nearly collinear corners
+    ToyMesh MakeMesh(Lcg& _random, int _numTriangles)
+    {
+        ToyMesh mesh;
+        for (int i = 0; i < _numTriangles; ++i)
+        {
+            const int base = static_cast<int>(mesh.m_positions.size());
+            const LegacyVector3 center = RandomInBox(_random, {-150.0f, -20.0f, -150.0f}, {150.0f, 60.0f, 150.0f});
+            const float size = _random.NextFloat() < 0.95f ? _random.Range(0.2f, 4.0f) : _random.Range(10.0f, 40.0f);
+            const LegacyVector3 a = center + RandomDirection(_random) * size;
+            const LegacyVector3 b = center + RandomDirection(_random) * size;
+            LegacyVector3 c = center + RandomDirection(_random) * size;
+
+            switch (i % 23)
+            {
+            case 5: c = a; break;                                       // Repeated corner
+            case 11: c = a + (b - a) * 0.37f; break;                    // Collinear
+            case 17: c = a + (b - a) * 2.0f + LegacyVector3{0.0f, 1e-6f, 0.0f}; break; // Nearly collinear
+            default: break;
+            }
+
+            mesh.m_positions.insert(mesh.m_positions.end(), {a, b, c});
+            mesh.m_triangles.push_back({base, base + 1, base + 2});
+        }
+        return mesh;
+    }
+
+    // Rotation with a uniform scale, somewhere out in a level
+    Matrix34 MakeFrame(Lcg& _random)
+    {
+        Matrix34 frame;
+        const LegacyVector3 f = RandomDirection(_random);
+        LegacyVector3 u = RandomDirection(_random) ^ f;
+        u.Normalise();
+        const LegacyVector3 r = u ^ f;
+        const float scale = _random.NextFloat() < 0.5f ? 1.0f : _random.Range(0.3f, 3.0f);
+        frame.r = r * scale;
+        frame.u = u * scale;
+        frame.f = f * scale;
+        frame.pos = RandomInBox(_random, {-4000.0f, -100.0f, -4000.0f}, {4000.0f, 500.0f, 4000.0f});
+        return frame;
+    }
+
+    LegacyVector3 PointOnTriangle(Lcg& _random, const ToyMesh& _mesh, const Matrix34& _frame, int _triangle)
+    {
+        float s = _random.NextFloat(), t = _random.NextFloat();
+        if (s + t > 1.0f)
+        {
+            s = 1.0f - s;
+            t = 1.0f - t;
+        }
+        const LegacyVector3 a = _mesh.Corner(_frame, _triangle, 0);
+        return a + (_mesh.Corner(_frame, _triangle, 1) - a) * s + (_mesh.Corner(_frame, _triangle, 2) - a) * t;
+    }
+
+    // --- Shipped shapes -----------------------------------------------------
+
+    struct ShippedShape
+    {
+        std::string m_name;
+        std::vector<ToyMesh> m_fragments;
+    };
+
+    std::filesystem::path ShippedShapeDirectory()
+    {
+        return std::filesystem::path(__FILE__).parent_path().parent_path() / "Starstrike" / "Assets" / "Shapes";
+    }
+
+    // Just enough of ShapeFragmentData's loader to recover each fragment's
+    // triangles, with strips unrolled the same way
+    ShippedShape LoadShippedShape(const std::filesystem::path& _path)
+    {
+        ShippedShape shape;
+        shape.m_name = _path.filename().string();
+
+        std::ifstream file(_path);
+        std::vector<std::vector<std::string>> lines;
+        for (std::string line; std::getline(file, line);)
+        {
+            std::ranges::replace(line, ':', ' ');
+            std::ranges::replace(line, ',', ' ');
+            std::istringstream words(line);
+            std::vector<std::string> tokens;
+            for (std::string word; words >> word && word[0] != '#';)
+                tokens.push_back(word);
+            if (!tokens.empty())
+                lines.push_back(std::move(tokens));
+        }
+
+        ToyMesh* mesh = nullptr;
+        std::vector<int> vertexPositions;
+        for (size_t i = 0; i < lines.size(); ++i)
+        {
+            const std::vector<std::string>& tokens = lines[i];
+            if (tokens[0] == "Fragment")
+            {
+                mesh = &shape.m_fragments.emplace_back();
+                vertexPositions.clear();
+            }
+            else if (tokens[0] == "Marker")
+                mesh = nullptr;
+            else if (!mesh || tokens.size() < 2)
+                continue;
+            else if (tokens[0] == "Positions")
+            {
+                for (int n = std::stoi(tokens[1]); n > 0; --n)
+                {
+                    const std::vector<std::string>& p = lines[++i];
+                    mesh->m_positions.push_back({std::stof(p[1]), std::stof(p[2]), std::stof(p[3])});
+                }
+            }
+            else if (tokens[0] == "Vertices")
+            {
+                for (int n = std::stoi(tokens[1]); n > 0; --n)
+                    vertexPositions.push_back(std::stoi(lines[++i][1]));
+            }
+            else if (tokens[0] == "Triangles")
+            {
+                for (int n = std::stoi(tokens[1]); n > 0; --n)
+                {
+                    const std::vector<std::string>& t = lines[++i];
+                    mesh->m_triangles.push_back({vertexPositions[std::stoi(t[0])], vertexPositions[std::stoi(t[1])], vertexPositions[std::stoi(t[2])]});
+                }
+            }
+            else if (tokens[0] == "Verts")
+            {
+                int remaining = std::stoi(tokens[1]);
+                int count = 0, v1 = 0, v2 = 0;
+                while (remaining > 0)
+                {
+                    for (const std::string& token : lines[++i])
+                    {
+                        const int v3 = std::stoi(token.substr(1));
+                        if (count >= 2 && v1 != v2 && v2 != v3 && v1 != v3)
+                        {
+                            if (count & 1)
+                                mesh->m_triangles.push_back({vertexPositions[v3], vertexPositions[v2], vertexPositions[v1]});
+                            else
+                                mesh->m_triangles.push_back({vertexPositions[v1], vertexPositions[v2], vertexPositions[v3]});
+                        }
+                        v1 = v2;
+                        v2 = v3;
+                        ++count;
+                        --remaining;
+                    }
+                }
+            }
+        }
+        return shape;
+    }
+}
+
+TEST_CLASS(TriangleBvhTests)
+{
+public:
+
+    // --- Culling ------------------------------------------------------------
+
+    TEST_METHOD(Query_VisitsFewTriangles)
+    {
+        Lcg random(7);
+        ToyMesh mesh = MakeMesh(random, 4000);
+        TriangleBvh tree;
+        mesh.Build(tree);
+        Assert::AreEqual(4000, tree.GetNumTriangles());
+
+        const Matrix34 frame = MakeFrame(random);
+        const int slivers = tree.GetNumSlivers(); // Always tested
+        Assert::IsTrue(slivers > 0 && slivers < 4000 / 5);
+
+        int tested = 0;
+        tree.AnyNearLine(frame, frame.pos, LegacyVector3{0.0f, 1.0f, 0.0f}, [&](int) { ++tested; return false; });
+        Assert::IsTrue(tested - slivers < 4000 / 20);
+
+        tested = 0;
+        tree.AnyNearSphere(frame, frame.pos, 1.0f, [&](int) { ++tested; return false; });
+        Assert::IsTrue(tested - slivers < 4000 / 100);
+    }
+
+    TEST_METHOD(Query_NonFiniteInputVisitsEverything)
+    {
+        Lcg random(11);
+        ToyMesh mesh = MakeMesh(random, 200);
+        TriangleBvh tree;
+        mesh.Build(tree);
+
+        Matrix34 frame = MakeFrame(random);
+        frame.r.x = std::numeric_limits<float>::quiet_NaN();
+        int tested = 0;
+        tree.AnyNearSphere(frame, frame.pos, 1.0f, [&](int) { ++tested; return false; });
+        Assert::AreEqual(200, tested);
+
+        const LegacyVector3 start{0.0f, 0.0f, 0.0f};
+        const LegacyVector3 dir{std::numeric_limits<float>::infinity(), 0.0f, 0.0f};
+        Assert::AreEqual(mesh.RayHitAll(MakeFrame(random), start, dir), mesh.RayHitTree(tree, MakeFrame(random), start, dir));
+    }
+
+    TEST_METHOD(Build_EmptyMesh)
+    {
+        TriangleBvh tree;
+        tree.Build(0, [](int, int) { return LegacyVector3{}; });
+        Assert::AreEqual(0, tree.GetNumNodes());
+        Assert::IsFalse(tree.AnyNearSphere(Matrix34(0), LegacyVector3{}, 1e6f, [](int) { return true; }));
+    }
+
+    // --- Equivalence --------------------------------------------------------
+
+    TEST_METHOD(Equivalence_RandomMeshesAndQueries)
+    {
+        // Queries are aimed at points on triangles, so many of them graze an
+        // edge or only just reach a face: where the culling would go wrong
+        Lcg random(12345);
+        int rayHits = 0, sphereHits = 0, queries = 0;
+        for (int round = 0; round < 20; ++round)
+        {
+            ToyMesh mesh = MakeMesh(random, 300 + round * 50);
+            TriangleBvh tree;
+            mesh.Build(tree);
+            Assert::IsTrue(tree.GetNumSlivers() > 0);
+
+            for (int f = 0; f < 5; ++f)
+            {
+                const Matrix34 frame = MakeFrame(random);
+                for (int q = 0; q < 400; ++q)
+                {
+                    const int triangle = random.Index(static_cast<int>(mesh.m_triangles.size()));
+                    const LegacyVector3 target = PointOnTriangle(random, mesh, frame, triangle);
+                    LegacyVector3 dir = RandomDirection(random);
+                    if (q % 7 == 0)
+                        dir = q % 14 == 0 ? LegacyVector3{0.0f, -1.0f, 0.0f} : LegacyVector3{dir.x, 0.0f, dir.z}.Normalise();
+                    const LegacyVector3 start = target - dir * random.Range(-50.0f, 500.0f) + RandomDirection(random) * random.Range(0.0f, 4.0f) * random.NextFloat();
+
+                    const bool rayAll = mesh.RayHitAll(frame, start, dir);
+                    Assert::AreEqual(rayAll, mesh.RayHitTree(tree, frame, start, dir));
+                    rayHits += rayAll;
+
+                    const LegacyVector3 center = target + RandomDirection(random) * random.Range(0.0f, 3.0f);
+                    float radius = random.Range(0.0f, 3.0f);
+                    if (q % 11 == 0)
+                        radius = -radius;
+                    const bool sphereAll = mesh.SphereHitAll(frame, center, radius);
+                    Assert::AreEqual(sphereAll, mesh.SphereHitTree(tree, frame, center, radius));
+                    sphereHits += sphereAll;
+                    ++queries;
+                }
+            }
+        }
+
+        // Both answers must have come up plenty of times
+        Assert::IsTrue(rayHits > queries / 10 && rayHits < queries * 9 / 10);
+        Assert::IsTrue(sphereHits > queries / 10 && sphereHits < queries * 9 / 10);
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_ShippedShapes)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_ShippedShapes)
+    {
+        // Every shipped .shp, each fragment hit-tested in place by rays and
+        // spheres aimed at it, as Location's picking and collision do.  The
+        // answers are checked against the loop as well as timed.
+        const std::filesystem::path directory = ShippedShapeDirectory();
+        if (!std::filesystem::exists(directory))
+        {
+            Logger::WriteMessage(std::format("{} not found; skipped\n", directory.string()).c_str());
+            return;
+        }
+
+        std::vector<std::filesystem::path> files;
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            if (entry.path().extension() == ".shp")
+                files.push_back(entry.path());
+        }
+        std::ranges::sort(files);
+
+        constexpr int QUERIES = 200;
+        Lcg random(99);
+        double totalAll = 0.0, totalTree = 0.0, totalBuild = 0.0;
+        int totalTriangles = 0;
+        for (const std::filesystem::path& file : files)
+        {
+            const ShippedShape shape = LoadShippedShape(file);
+            double shapeAll = 0.0, shapeTree = 0.0;
+            int shapeTriangles = 0;
+            for (const ToyMesh& mesh : shape.m_fragments)
+            {
+                if (mesh.m_triangles.empty())
+                    continue;
+                shapeTriangles += static_cast<int>(mesh.m_triangles.size());
+
+                auto start = std::chrono::steady_clock::now();
+                TriangleBvh tree;
+                mesh.Build(tree);
+                totalBuild += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                const Matrix34 frame = MakeFrame(random);
+                std::vector<LegacyVector3> starts, dirs, centers;
+                std::vector<float> radii;
+                for (int q = 0; q < QUERIES; ++q)
+                {
+                    const LegacyVector3 target = PointOnTriangle(random, mesh, frame, random.Index(static_cast<int>(mesh.m_triangles.size())));
+                    dirs.push_back(RandomDirection(random));
+                    starts.push_back(target - dirs.back() * 200.0f + RandomDirection(random) * random.Range(0.0f, 4.0f));
+                    centers.push_back(target + RandomDirection(random) * random.Range(0.0f, 6.0f));
+                    radii.push_back(random.Range(0.5f, 4.0f));
+                }
+
+                std::vector<char> answers;
+                start = std::chrono::steady_clock::now();
+                for (int q = 0; q < QUERIES; ++q)
+                {
+                    answers.push_back(mesh.RayHitAll(frame, starts[q], dirs[q]));
+                    answers.push_back(mesh.SphereHitAll(frame, centers[q], radii[q]));
+                }
+                const auto middle = std::chrono::steady_clock::now();
+                for (int q = 0; q < QUERIES; ++q)
+                {
+                    Assert::AreEqual(static_cast<bool>(answers[q * 2]), mesh.RayHitTree(tree, frame, starts[q], dirs[q]));
+                    Assert::AreEqual(static_cast<bool>(answers[q * 2 + 1]), mesh.SphereHitTree(tree, frame, centers[q], radii[q]));
+                }
+                shapeAll += std::chrono::duration<double>(middle - start).count();
+                shapeTree += std::chrono::duration<double>(std::chrono::steady_clock::now() - middle).count();
+            }
+
+            if (shapeTriangles >= 1000)
+            {
+                Logger::WriteMessage(std::format("{}: {} triangles, {:.2f} us/query all, {:.2f} us/query tree ({:.1f}x)\n", shape.m_name,
+                    shapeTriangles, shapeAll * 1.0e6 / (QUERIES * 2), shapeTree * 1.0e6 / (QUERIES * 2), shapeAll / shapeTree).c_str());
+            }
+            totalAll += shapeAll;
+            totalTree += shapeTree;
+            totalTriangles += shapeTriangles;
+        }
+
+        Logger::WriteMessage(std::format("{} shapes, {} triangles: built in {:.1f} ms; queries {:.1f} ms all, {:.1f} ms tree ({:.1f}x)\n",
+            files.size(), totalTriangles, totalBuild * 1.0e3, totalAll * 1.0e3, totalTree * 1.0e3, totalAll / totalTree).c_str());
+    }
+};
@@ -0,0 +1,426 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    std::vector<int> Slots(const SlotIndex<int>& _index, int _key)
+    {
+        std::vector<int> slots;
+        _index.ForEach(_key, [&](int _slot) { slots.push_back(_slot); });
+        std::ranges::sort(slots);
+        return slots;
+    }
+
+    // What VoiceOrder promises: the survivors of the previous order, then the
+    // newcomers, stable sorted loudest first
+    std::vector<int> ReferenceOrder(const std::vector<int>& _previous, const std::vector<int>& _added, const std::vector<char>& _alive,
+                                    const std::vector<float>& _volumes)
+    {
+        std::vector<int> order;
+        for (int id : _previous)
+        {
+            if (_alive[id])
+                order.push_back(id);
+        }
+        for (int id : _added)
+        {
+            if (_alive[id])
+                order.push_back(id);
+        }
+        std::ranges::stable_sort(order, [&](int _a, int _b) { return _volumes[_a] > _volumes[_b]; });
+        return order;
+    }
+
+    std::vector<int> Ids(const VoiceOrder<int>& _order)
+    {
+        std::vector<int> ids;
+        for (const auto& voice : _order.GetVoices())
+            ids.push_back(voice.m_id);
+        return ids;
+    }
+
+    // --- SoundSystem stand-in ----------------------------------------------
+
+    int CompareNoCase(const char* _a, const char* _b)
+    {
+        while (*_a && tolower(static_cast<unsigned char>(*_a)) == tolower(static_cast<unsigned char>(*_b)))
+        {
+            ++_a;
+            ++_b;
+        }
+        return tolower(static_cast<unsigned char>(*_a)) - tolower(static_cast<unsigned char>(*_b));
+    }
+
+    struct ToySound
+    {
+        int m_uniqueId;
+        int m_objId;
+        const char* m_eventName;
+        float m_volume;
+        float m_priority;
+    };
+
+    struct NoCaseLess
+    {
+        bool operator()(const std::string& _a, const std::string& _b) const { return CompareNoCase(_a.c_str(), _b.c_str()) < 0; }
+    };
+
+    const std::vector<ToySound>* g_sortSounds = nullptr;
+
+    // SoundInstanceCompare
+    int CompareVolume(const void* _a, const void* _b)
+    {
+        const float volumeA = (*g_sortSounds)[*static_cast<const int*>(_a)].m_volume;
+        const float volumeB = (*g_sortSounds)[*static_cast<const int*>(_b)].m_volume;
+        if (volumeA < volumeB)
+            return +1;
+        if (volumeA > volumeB)
+            return -1;
+        return 0;
+    }
+
+    std::string ToLower(const char* _name)
+    {
+        std::string lower(_name);
+        for (char& c : lower)
+            c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        return lower;
+    }
+}
+
+TEST_CLASS(VoiceSchedulerTests)
+{
+public:
+
+    // --- SlotIndex ----------------------------------------------------------
+
+    TEST_METHOD(SlotIndex_InsertRemoveMove)
+    {
+        SlotIndex<int> index;
+        index.Insert(3, 7);
+        index.Insert(10, 7);
+        index.Insert(4, 2);
+        Assert::AreEqual(2, index.Count(7));
+        Assert::AreEqual(1, index.Count(2));
+        Assert::AreEqual(0, index.Count(5));
+        Assert::AreEqual(2, index.GetNumKeys());
+        Assert::AreEqual(7, index.GetKey(10));
+
+        index.Move(3, 2);
+        Assert::IsTrue(Slots(index, 2) == std::vector<int>{3, 4});
+        Assert::IsTrue(Slots(index, 7) == std::vector<int>{10});
+
+        index.Remove(10);
+        index.Remove(10);
+        Assert::IsFalse(index.Contains(10));
+        Assert::AreEqual(0, index.Count(7));
+        Assert::AreEqual(1, index.GetNumKeys());
+
+        // Filing a slot again takes it away from its old key
+        index.Insert(4, 9);
+        Assert::IsTrue(Slots(index, 2) == std::vector<int>{3});
+        Assert::IsTrue(Slots(index, 9) == std::vector<int>{4});
+    }
+
+    TEST_METHOD(SlotIndex_ForEachMayRemoveTheSlotItVisits)
+    {
+        SlotIndex<int> index;
+        for (int slot = 0; slot < 20; ++slot)
+            index.Insert(slot, slot % 2);
+
+        std::vector<int> visited;
+        index.ForEach(0, [&](int _slot)
+        {
+            visited.push_back(_slot);
+            index.Remove(_slot);
+        });
+
+        std::ranges::sort(visited);
+        Assert::AreEqual(size_t{10}, visited.size());
+        for (int i = 0; i < 10; ++i)
+            Assert::AreEqual(i * 2, visited[i]);
+        Assert::AreEqual(0, index.Count(0));
+        Assert::AreEqual(10, index.Count(1));
+    }
+
+    TEST_METHOD(SlotIndex_MatchesAScan)
+    {
+        // Keys come and go as objects die, as WorldObjectIds do
+        constexpr int SLOTS = 300;
+        Lcg random(17);
+        SlotIndex<int> index;
+        std::vector<int> keys(SLOTS, -1);
+        int nextKey = 0;
+
+        for (int step = 0; step < 20000; ++step)
+        {
+            const int slot = random.Index(SLOTS);
+            const float action = random.NextFloat();
+            if (action < 0.4f)
+            {
+                const int key = random.NextFloat() < 0.8f ? random.Index(nextKey + 1) : ++nextKey;
+                index.Insert(slot, key);
+                keys[slot] = key;
+            }
+            else if (action < 0.6f)
+            {
+                index.Remove(slot);
+                keys[slot] = -1;
+            }
+            else if (action < 0.7f && keys[slot] != -1)
+            {
+                const int key = random.Index(nextKey + 1);
+                index.Move(slot, key);
+                keys[slot] = key;
+            }
+
+            if (step % 97 == 0)
+            {
+                std::vector<int> liveKeys;
+                for (int s = 0; s < SLOTS; ++s)
+                {
+                    Assert::AreEqual(keys[s] != -1, index.Contains(s));
+                    if (keys[s] != -1)
+                    {
+                        Assert::AreEqual(keys[s], index.GetKey(s));
+                        liveKeys.push_back(keys[s]);
+                    }
+                }
+                std::ranges::sort(liveKeys);
+                const auto duplicates = std::ranges::unique(liveKeys);
+                Assert::AreEqual(static_cast<int>(liveKeys.size() - duplicates.size()), index.GetNumKeys());
+
+                const int key = random.Index(nextKey + 1);
+                std::vector<int> expected;
+                for (int s = 0; s < SLOTS; ++s)
+                {
+                    if (keys[s] == key)
+                        expected.push_back(s);
+                }
+                Assert::IsTrue(expected == Slots(index, key));
+            }
+        }
+    }
+
+    // --- VoiceOrder ---------------------------------------------------------
+
+    TEST_METHOD(VoiceOrder_IsAStableSortOfThePreviousOrder)
+    {
+        // Volumes drift, sounds start and stop, and now and then every
+        // volume changes at once.  Volumes are coarse so that ties are common.
+        Lcg random(4242);
+        VoiceOrder<int> order;
+        std::vector<float> volumes;
+        std::vector<char> alive;
+        std::vector<int> previous;
+
+        for (int update = 0; update < 300; ++update)
+        {
+            std::vector<int> added;
+            const int numAdded = update == 0 ? 500 : random.Index(30);
+            for (int i = 0; i < numAdded; ++i)
+            {
+                const int id = static_cast<int>(volumes.size());
+                volumes.push_back(static_cast<float>(random.Index(100)));
+                alive.push_back(1);
+                order.Add(id);
+                added.push_back(id);
+            }
+
+            const bool cut = update % 50 == 49;
+            for (size_t id = 0; id < volumes.size(); ++id)
+            {
+                if (!alive[id])
+                    continue;
+                if (random.NextFloat() < 0.03f)
+                    alive[id] = 0;
+                else if (cut)
+                    volumes[id] = static_cast<float>(random.Index(100));
+                else if (random.NextFloat() < 0.2f)
+                    volumes[id] = std::clamp(volumes[id] + static_cast<float>(random.Index(5) - 2), 0.0f, 99.0f);
+            }
+
+            order.Update([&](int _id) { return alive[_id] != 0; }, [&](int _id) { return volumes[_id]; });
+
+            const std::vector<int> expected = ReferenceOrder(previous, added, alive, volumes);
+            Assert::IsTrue(expected == Ids(order));
+            for (const auto& voice : order.GetVoices())
+                Assert::AreEqual(volumes[voice.m_id], voice.m_volume);
+            previous = expected;
+        }
+    }
+
+    TEST_METHOD(VoiceOrder_Empty)
+    {
+        VoiceOrder<int> order;
+        order.Update([](int) { return true; }, [](int) { return 0.0f; });
+        Assert::AreEqual(size_t{0}, order.GetVoices().size());
+
+        order.Add(1);
+        order.Update([](int) { return false; }, [](int) { return 0.0f; });
+        Assert::AreEqual(size_t{0}, order.GetVoices().size());
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_SoundUpdate)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_SoundUpdate)
+    {
+        // A battle's worth of live sounds.  Each update some start and some
+        // stop, volumes drift as the camera moves, priorities are derated per
+        // event, and game code asks NumInstances of a few hundred objects.
+        constexpr int SOUNDS = 4000;
+        constexpr int OBJECTS = 1500;
+        constexpr int UPDATES = 100;
+        constexpr int CHURN = 40;
+        constexpr int QUERIES = 200;
+        const char* events[] = {"Darwinian SeenThreat", "Darwinian Fire", "Virii Move", "Centipede Attack", "Laser Hit",
+                                "Grenade Explode", "Spirit Appear", "Armour Move", "Squaddie Fire", "Engineer Build"};
+        constexpr int EVENTS = static_cast<int>(std::size(events));
+
+        Lcg random(8);
+        int nextUniqueId = 0;
+        const auto makeSound = [&]
+        {
+            return ToySound{nextUniqueId++, random.Index(OBJECTS), events[random.Index(EVENTS)], random.Range(0.0f, 1.0f), 0.0f};
+        };
+
+        struct Script
+        {
+            std::vector<int> m_kill;        // Slots, in this update's live set
+            std::vector<ToySound> m_spawn;
+            std::vector<std::pair<int, int>> m_queries;   // Object and event
+        };
+        std::vector<ToySound> initial;
+        for (int i = 0; i < SOUNDS; ++i)
+            initial.push_back(makeSound());
+        std::vector<Script> scripts(UPDATES);
+        for (Script& script : scripts)
+        {
+            for (int i = 0; i < CHURN; ++i)
+            {
+                script.m_kill.push_back(random.Index(SOUNDS));
+                script.m_spawn.push_back(makeSound());
+            }
+            for (int i = 0; i < QUERIES; ++i)
+                script.m_queries.emplace_back(random.Index(OBJECTS), random.Index(EVENTS));
+        }
+        std::vector<float> drift(SOUNDS * UPDATES);
+        for (float& d : drift)
+            d = random.Range(0.97f, 1.03f);
+
+        //
+        // Before: scan, qsort, derate through a map keyed on the name
+
+        std::vector<ToySound> sounds = initial;
+        std::vector<float> scanPriorities;
+        long long scanMatches = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int u = 0; u < UPDATES; ++u)
+        {
+            const Script& script = scripts[u];
+            for (int i = 0; i < CHURN; ++i)
+                sounds[script.m_kill[i]] = script.m_spawn[i];
+            for (int i = 0; i < SOUNDS; ++i)
+                sounds[i].m_volume *= drift[u * SOUNDS + i];
+
+            std::vector<int> sorted(SOUNDS);
+            for (int i = 0; i < SOUNDS; ++i)
+                sorted[i] = i;
+            g_sortSounds = &sounds;
+            std::qsort(sorted.data(), sorted.size(), sizeof(int), CompareVolume);
+            std::map<std::string, float, NoCaseLess> derate;
+            for (int slot : sorted)
+            {
+                auto [it, isNew] = derate.try_emplace(sounds[slot].m_eventName, 1.0f);
+                sounds[slot].m_priority = sounds[slot].m_volume * it->second;
+                it->second *= 0.75f;
+            }
+
+            for (auto [obj, event] : script.m_queries)
+            {
+                for (const ToySound& sound : sounds)
+                {
+                    if (sound.m_objId == obj && CompareNoCase(sound.m_eventName, events[event]) == 0)
+                        ++scanMatches;
+                }
+            }
+        }
+        for (const ToySound& sound : sounds)
+            scanPriorities.push_back(sound.m_priority);
+        const auto middle = std::chrono::steady_clock::now();
+
+        //
+        // After: the indexes and the kept order
+
+        sounds = initial;
+        SlotIndex<int> byObject, byEvent;
+        VoiceOrder<int> order;
+        std::vector<int> uniqueToSlot;
+        std::vector<float> derate(EVENTS);
+        std::unordered_map<std::string, int> eventKeys;
+        const auto eventKey = [&](const char* _name)
+        {
+            auto [it, isNew] = eventKeys.try_emplace(ToLower(_name), static_cast<int>(eventKeys.size()));
+            return it->second;
+        };
+        const auto file = [&](int _slot)
+        {
+            const ToySound& sound = sounds[_slot];
+            byObject.Insert(_slot, sound.m_objId);
+            byEvent.Insert(_slot, eventKey(sound.m_eventName));
+            uniqueToSlot.resize(std::max<size_t>(uniqueToSlot.size(), sound.m_uniqueId + 1), -1);
+            uniqueToSlot[sound.m_uniqueId] = _slot;
+            order.Add(sound.m_uniqueId);
+        };
+        for (int i = 0; i < SOUNDS; ++i)
+            file(i);
+
+        long long indexMatches = 0;
+        for (int u = 0; u < UPDATES; ++u)
+        {
+            const Script& script = scripts[u];
+            for (int i = 0; i < CHURN; ++i)
+            {
+                const int slot = script.m_kill[i];
+                uniqueToSlot[sounds[slot].m_uniqueId] = -1;
+                byObject.Remove(slot);
+                byEvent.Remove(slot);
+                sounds[slot] = script.m_spawn[i];
+                file(slot);
+            }
+            for (int i = 0; i < SOUNDS; ++i)
+                sounds[i].m_volume *= drift[u * SOUNDS + i];
+
+            order.Update([&](int _id) { return uniqueToSlot[_id] != -1; }, [&](int _id) { return sounds[uniqueToSlot[_id]].m_volume; });
+            std::ranges::fill(derate, 1.0f);
+            for (const auto& voice : order.GetVoices())
+            {
+                const int slot = uniqueToSlot[voice.m_id];
+                float& d = derate[byEvent.GetKey(slot)];
+                sounds[slot].m_priority = sounds[slot].m_volume * d;
+                d *= 0.75f;
+            }
+
+            for (auto [obj, event] : script.m_queries)
+            {
+                const int key = eventKey(events[event]);
+                byObject.ForEach(obj, [&](int _slot) { indexMatches += byEvent.GetKey(_slot) == key; });
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        Assert::AreEqual(scanMatches, indexMatches);
+        for (int i = 0; i < SOUNDS; ++i)
+            Assert::AreEqual(scanPriorities[i], sounds[i].m_priority);
+
+        const double scan = std::chrono::duration<double>(middle - start).count();
+        const double indexed = std::chrono::duration<double>(end - middle).count();
+        Logger::WriteMessage(std::format("{} sounds, {} queries an update: {:.1f} us/update scanning, {:.1f} us/update indexed ({:.1f}x)\n",
+            SOUNDS, QUERIES, scan * 1.0e6 / UPDATES, indexed * 1.0e6 / UPDATES, scan / indexed).c_str());
+    }
+};
@@ -0,0 +1,288 @@
+#include "pch.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Neuron;
+
+namespace
+{
+    std::vector<int> Visit(WakeScheduler& _schedule, int _begin, int _end)
+    {
+        std::vector<int> visited;
+        _schedule.ForEachAwake(_begin, _end, [&](int _slot) { visited.push_back(_slot); });
+        return visited;
+    }
+
+    // A chain of link buildings in the style of Pylon / ReceiverLink: each
+    // carries packets that take a few ticks to cross it and are then handed
+    // to the next link.  An idle link does nothing and may sleep; handing
+    // it a packet wakes it.  This tests the scheduler's contract; the real
+    // buildings are checked in game by RunDormancyCheck (DormancyCheckAt).
+    class ToyLinks
+    {
+    public:
+        ToyLinks(int _numLinks, bool _useDormancy)
+            : m_links(_numLinks),
+              m_useDormancy(_useDormancy)
+        {
+            for (int i = 0; i < _numLinks; ++i)
+                m_links[i].m_next = (i * 7 + 3) % _numLinks; // Out of slot order on purpose
+            m_schedule.Resize(_numLinks);
+        }
+
+        void Inject(int _link) { Trigger(_link); }
+
+        void Tick()
+        {
+            m_schedule.Tick();
+            m_schedule.ForEachAwake(0, static_cast<int>(m_links.size()), [&](int _slot) { Advance(_slot); });
+        }
+
+        [[nodiscard]] uint64_t GetChecksum() const { return m_checksum.Value(); }
+        [[nodiscard]] int GetAdvances() const { return m_advances; }
+
+    private:
+        struct Link
+        {
+            std::vector<int> m_packets;   // Ticks left to cross
+            int m_next = 0;
+            int m_delivered = 0;
+            uint64_t m_syncContribution = 0;
+        };
+
+        void Trigger(int _link)
+        {
+            m_links[_link].m_packets.push_back(3);
+            m_schedule.Wake(_link);
+        }
+
+        void Advance(int _slot)
+        {
+            ++m_advances;
+            Link& link = m_links[_slot];
+            for (size_t i = 0; i < link.m_packets.size();)
+            {
+                if (--link.m_packets[i] > 0)
+                {
+                    ++i;
+                    continue;
+                }
+                link.m_packets.erase(link.m_packets.begin() + i);
+                ++link.m_delivered;
+                if (link.m_delivered % 5 != 0) // Some packets stop here
+                    Trigger(link.m_next);
+            }
+
+            SyncHasher hasher;
+            hasher.Fold(_slot).Fold(link.m_delivered).Fold(static_cast<int>(link.m_packets.size()));
+            for (int packet : link.m_packets)
+                hasher.Fold(packet);
+            m_checksum.Update(link.m_syncContribution, hasher.Value());
+
+            if (m_useDormancy && link.m_packets.empty())
+                m_schedule.Sleep(_slot);
+        }
+
+        std::vector<Link> m_links;
+        WakeScheduler m_schedule;
+        SyncChecksum m_checksum;
+        bool m_useDormancy;
+        int m_advances = 0;
+    };
+
+    // Stand-in for a level's buildings: a virtual Advance plus a sync hash
+    // per visit, most of them idle
+    struct ToyBuilding
+    {
+        virtual ~ToyBuilding() = default;
+        virtual bool Advance() = 0;
+
+        float m_state = 0.0f;
+        uint64_t m_syncContribution = 0;
+    };
+
+    struct IdleBuilding : ToyBuilding
+    {
+        bool Advance() override { return false; }
+    };
+
+    struct BusyBuilding : ToyBuilding
+    {
+        bool Advance() override
+        {
+            m_state = m_state * 0.99f + 1.0f;
+            return true;
+        }
+    };
+
+    double MeasureBuildingTick(const std::vector<std::unique_ptr<ToyBuilding>>& _buildings, bool _useDormancy, int _ticks)
+    {
+        WakeScheduler schedule;
+        SyncChecksum checksum;
+        schedule.Resize(static_cast<int>(_buildings.size()));
+
+        auto tick = [&]
+        {
+            schedule.Tick();
+            schedule.ForEachAwake(0, static_cast<int>(_buildings.size()), [&](int _slot)
+            {
+                ToyBuilding* building = _buildings[_slot].get();
+                bool busy = building->Advance();
+                checksum.Update(building->m_syncContribution, SyncHasher().Fold(_slot).Fold(building->m_state).Value());
+                if (_useDormancy && !busy)
+                    schedule.Sleep(_slot);
+            });
+        };
+
+        tick(); // Warm up; idle buildings go to sleep here
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < _ticks; ++t)
+            tick();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / _ticks;
+    }
+}
+
+TEST_CLASS(WakeSchedulerTests)
+{
+public:
+
+    // --- Sleeping and waking ------------------------------------------------
+
+    TEST_METHOD(NewSlots_AreAwakeAndVisitedInOrder)
+    {
+        WakeScheduler schedule;
+        schedule.Resize(70);
+        schedule.Sleep(5);
+        schedule.Sleep(64);
+        schedule.Resize(130);
+
+        std::vector<int> visited = Visit(schedule, 0, 130);
+        Assert::AreEqual(size_t{128}, visited.size());
+        Assert::IsTrue(std::ranges::is_sorted(visited));
+        Assert::IsTrue(std::ranges::find(visited, 5) == visited.end());
+        Assert::IsTrue(std::ranges::find(visited, 64) == visited.end());
+        Assert::AreEqual(128, schedule.GetNumAwake());
+
+        Assert::IsTrue(Visit(schedule, 60, 66) == std::vector<int>{60, 61, 62, 63, 65});
+    }
+
+    TEST_METHOD(Sleep_ForeverUntilWoken)
+    {
+        WakeScheduler schedule;
+        schedule.Resize(4);
+        schedule.Sleep(2);
+        for (int t = 0; t < 100; ++t)
+            schedule.Tick();
+        Assert::IsFalse(schedule.IsAwake(2));
+
+        schedule.Wake(2);
+        Assert::IsTrue(Visit(schedule, 0, 4) == std::vector<int>{0, 1, 2, 3});
+    }
+
+    TEST_METHOD(Sleep_TimedSkipsExactlyThatManyTicks)
+    {
+        WakeScheduler schedule;
+        schedule.Resize(1);
+        schedule.Tick();
+        schedule.Sleep(0, 3);
+
+        int skipped = 0;
+        for (; skipped < 10; ++skipped)
+        {
+            schedule.Tick();
+            if (schedule.IsAwake(0))
+                break;
+        }
+        Assert::AreEqual(3, skipped);
+    }
+
+    TEST_METHOD(Sleep_StaleTimerDoesNotWakeLaterSleep)
+    {
+        WakeScheduler schedule;
+        schedule.Resize(1);
+        schedule.Sleep(0, 2);
+        schedule.Wake(0);
+        schedule.Sleep(0);
+        for (int t = 0; t < 5; ++t)
+            schedule.Tick();
+        Assert::IsFalse(schedule.IsAwake(0));
+
+        schedule.Clear();
+        Assert::IsTrue(schedule.IsAwake(0));
+    }
+
+    TEST_METHOD(ForEachAwake_SeesSlotsWokenAheadOfCursor)
+    {
+        WakeScheduler schedule;
+        schedule.Resize(200);
+        for (int i = 0; i < 200; ++i)
+            schedule.Sleep(i);
+        schedule.Wake(10);
+
+        // 10 wakes 150 (ahead, visited this pass) and 3 (behind, next pass)
+        std::vector<int> visited;
+        schedule.ForEachAwake(0, 200, [&](int _slot)
+        {
+            visited.push_back(_slot);
+            if (_slot == 10)
+            {
+                schedule.Wake(150);
+                schedule.Wake(3);
+            }
+        });
+        Assert::IsTrue(visited == std::vector<int>{10, 150});
+        Assert::IsTrue(Visit(schedule, 0, 200) == std::vector<int>{3, 10, 150});
+    }
+
+    // --- Equivalence --------------------------------------------------------
+
+    TEST_METHOD(Dormancy_MatchesAdvancingEverySlot)
+    {
+        constexpr int LINKS = 300;
+        constexpr int TICKS = 400;
+
+        ToyLinks everyTick(LINKS, false);
+        ToyLinks dormant(LINKS, true);
+        for (int t = 0; t < TICKS; ++t)
+        {
+            if (t % 37 == 0)
+            {
+                everyTick.Inject((t * 13) % LINKS);
+                dormant.Inject((t * 13) % LINKS);
+            }
+            everyTick.Tick();
+            dormant.Tick();
+            Assert::AreEqual(everyTick.GetChecksum(), dormant.GetChecksum());
+        }
+        Assert::IsTrue(dormant.GetAdvances() < everyTick.GetAdvances() / 4);
+    }
+
+    // --- Benchmark ----------------------------------------------------------
+
+    BEGIN_TEST_METHOD_ATTRIBUTE(Benchmark_BuildingTick)
+        TEST_METHOD_ATTRIBUTE(L"Category", L"Benchmark")
+    END_TEST_METHOD_ATTRIBUTE()
+    TEST_METHOD(Benchmark_BuildingTick)
+    {
+        // The largest shipped level (map_biosphere) has 144 buildings; run
+        // that and a 16x stress population, with one building in eight busy.
+        // This is the scheduler's overhead; RunDormancyCheck times a level.
+        constexpr int TICKS = 2000;
+
+        for (int numBuildings : {144, 144 * 16})
+        {
+            std::vector<std::unique_ptr<ToyBuilding>> buildings;
+            for (int i = 0; i < numBuildings; ++i)
+            {
+                if (i % 8 == 0)
+                    buildings.push_back(std::make_unique<BusyBuilding>());
+                else
+                    buildings.push_back(std::make_unique<IdleBuilding>());
+            }
+
+            const double everyTick = MeasureBuildingTick(buildings, false, TICKS);
+            const double dormant = MeasureBuildingTick(buildings, true, TICKS);
+            Logger::WriteMessage(std::format("{} buildings, {} busy: {:.2f} us/tick advancing all, {:.2f} us/tick with dormancy ({:.1f}x)\n",
+                numBuildings, (numBuildings + 7) / 8, everyTick * 1.0e6, dormant * 1.0e6, everyTick / dormant).c_str());
+        }
+    }
+};
@@ -1,14 +1,112 @@
 #pragma once
 
+#ifdef _WIN32
+
 // Standard library headers required by NeuronCore math headers
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
+#include <chrono>
+#include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Debug.h (DEBUG_ASSERT / DebugTrace) needs the Win32 debug output API;
+// NetLib needs WinSock, which must precede Windows.h
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <Windows.h>
+#pragma comment(lib, "Ws2_32.lib")
+#include "Debug.h"
 
 // NeuronCore math headers under test (also pulls in DirectXMath)
 #include "GameMath.h"
 
+// NeuronCore headers under test
+#include "BitStream.h"
+#include "CellRect.h"
+#include "ChunkVertexMap.h"
+#include "DspKernels.h"
+#include "HistoryRing.h"
+#include "IdCellGrid.h"
+#include "ImageKernels.h"
+#include "JobSystem.h"
+#include "MatchHost.h"
+#include "ParticleStore.h"
+#include "PolylineGrid.h"
+#include "RingQueue.h"
+#include "SequenceRing.h"
+#include "SimEventQueue.h"
+#include "SlotTypeLists.h"
+#include "SnapshotStream.h"
+#include "SphereGrid.h"
+#include "StringMap.h"
+#include "SurfaceKernels.h"
+#include "SyncChecksum.h"
+#include "TriangleBvh.h"
+#include "VoiceScheduler.h"
+#include "WakeScheduler.h"
+
+// NeuronClient's height map, header-only, for the batched sampling tests
+#include "2d_surface_map.h"
+
+// NeuronClient math, built into this project for its exact hit tests
+#include "LegacyVector3.h"
+#include "math_utils.h"
+#include "matrix34.h"
+
+// NeuronClient's list and route search, header-only, as the game uses them
+#include "llist.h"
+#include "waypoint_grid.h"
+
+// The tests' shared random numbers
+#include "TestRandom.h"
+
+// NetLib (linked from NeuronCore.lib) for the loopback tests
+#include "net_impairment.h"
+#include "net_lib.h"
+#include "net_socket.h"
+#include "net_socket_listener.h"
+#include "net_udp_packet.h"
+
 // Visual Studio Native Unit Test Framework
 #include <CppUnitTest.h>
+
+#else
+
+// The Linux build runs the NetLib tests alone; see CMakeLists.txt at the root
+#include "NeuronCoreLinux.h"
+
+#include "net_impairment.h"
+#include "net_lib.h"
+#include "net_socket.h"
+#include "net_socket_listener.h"
+#include "net_udp_packet.h"
+
+// Linux/CppUnitTest.h, which stands in for the Visual Studio framework
+#include <CppUnitTest.h>
+
+#endif
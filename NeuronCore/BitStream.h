@@ -0,0 +1,192 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// BitWriter / BitReader
+//
+// Little-endian bit packing into a caller-owned byte buffer, used for compact
+// network encodings.  Values are written LSB first; a field may straddle byte
+// boundaries.  Neither class allocates.
+//
+// Writes that would run past the buffer set Overflowed() and are dropped;
+// reads past the end set Overflowed() and return zero.  Callers check the flag
+// once after a batch of operations rather than after every field.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class BitWriter
+  {
+    public:
+      BitWriter(void* _buffer, int _capacityBytes) noexcept
+        : m_buffer(static_cast<uint8_t*>(_buffer)),
+          m_capacityBits(_capacityBytes * 8)
+      {
+        std::memset(m_buffer, 0, _capacityBytes);
+      }
+
+      void WriteBits(uint32_t _value, int _numBits) noexcept
+      {
+        DEBUG_ASSERT(_numBits > 0 && _numBits <= 32);
+        if (m_overflow || m_bitPos + _numBits > m_capacityBits)
+        {
+          m_overflow = true;
+          return;
+        }
+
+        if (_numBits < 32)
+          _value &= (1u << _numBits) - 1;
+
+        while (_numBits > 0)
+        {
+          const int bitOffset = m_bitPos & 7;
+          const int chunk = std::min(8 - bitOffset, _numBits);
+          m_buffer[m_bitPos >> 3] |= static_cast<uint8_t>((_value & ((1u << chunk) - 1)) << bitOffset);
+          _value >>= chunk;
+          _numBits -= chunk;
+          m_bitPos += chunk;
+        }
+      }
+
+      void WriteBool(bool _value) noexcept { WriteBits(_value ? 1 : 0, 1); }
+
+      void WriteUInt64(uint64_t _value) noexcept
+      {
+        WriteBits(static_cast<uint32_t>(_value), 32);
+        WriteBits(static_cast<uint32_t>(_value >> 32), 32);
+      }
+
+      // 7 bits per group plus a continuation bit: values below 128 cost one byte
+      void WriteVarUInt(uint32_t _value) noexcept
+      {
+        while (_value >= 0x80)
+        {
+          WriteBits((_value & 0x7f) | 0x80, 8);
+          _value >>= 7;
+        }
+        WriteBits(_value, 8);
+      }
+
+      // ZigZag so small negative values stay small
+      void WriteVarInt(int32_t _value) noexcept
+      {
+        WriteVarUInt((static_cast<uint32_t>(_value) << 1) ^ static_cast<uint32_t>(_value >> 31));
+      }
+
+      void WriteFloat(float _value) noexcept { WriteBits(std::bit_cast<uint32_t>(_value), 32); }
+
+      // Maps [_min, _max] onto _numBits of fixed point; the value is clamped to the range
+      void WriteQuantised(float _value, float _min, float _max, int _numBits) noexcept
+      {
+        DEBUG_ASSERT(_max > _min && _numBits > 0 && _numBits <= 24);
+        const uint32_t maxInt = (1u << _numBits) - 1;
+        const float normalised = std::clamp((_value - _min) / (_max - _min), 0.0f, 1.0f);
+        WriteBits(static_cast<uint32_t>(normalised * static_cast<float>(maxInt) + 0.5f), _numBits);
+      }
+
+      // Discards everything written after _bitPos, e.g. to drop a record that did not fit
+      void Rewind(int _bitPos) noexcept
+      {
+        DEBUG_ASSERT(_bitPos >= 0 && _bitPos <= m_bitPos);
+        const int firstByte = _bitPos >> 3;
+        const int endByte = (m_bitPos + 7) >> 3;
+        if (_bitPos & 7)
+          m_buffer[firstByte] &= static_cast<uint8_t>((1u << (_bitPos & 7)) - 1);
+        else if (firstByte < endByte)
+          m_buffer[firstByte] = 0;
+        if (endByte > firstByte + 1)
+          std::memset(m_buffer + firstByte + 1, 0, endByte - firstByte - 1);
+        m_bitPos = _bitPos;
+        m_overflow = false;
+      }
+
+      [[nodiscard]] int GetBitPosition() const noexcept { return m_bitPos; }
+      [[nodiscard]] int BytesWritten() const noexcept { return (m_bitPos + 7) >> 3; }
+      [[nodiscard]] bool Overflowed() const noexcept { return m_overflow; }
+
+    private:
+      uint8_t* m_buffer;
+      int m_capacityBits;
+      int m_bitPos = 0;
+      bool m_overflow = false;
+  };
+
+  class BitReader
+  {
+    public:
+      BitReader(const void* _buffer, int _lengthBytes) noexcept
+        : m_buffer(static_cast<const uint8_t*>(_buffer)),
+          m_lengthBits(_lengthBytes * 8) {}
+
+      uint32_t ReadBits(int _numBits) noexcept
+      {
+        DEBUG_ASSERT(_numBits > 0 && _numBits <= 32);
+        if (m_overflow || m_bitPos + _numBits > m_lengthBits)
+        {
+          m_overflow = true;
+          return 0;
+        }
+
+        uint32_t result = 0;
+        int shift = 0;
+        while (_numBits > 0)
+        {
+          const int bitOffset = m_bitPos & 7;
+          const int chunk = std::min(8 - bitOffset, _numBits);
+          const uint32_t bits = (m_buffer[m_bitPos >> 3] >> bitOffset) & ((1u << chunk) - 1);
+          result |= bits << shift;
+          shift += chunk;
+          _numBits -= chunk;
+          m_bitPos += chunk;
+        }
+        return result;
+      }
+
+      bool ReadBool() noexcept { return ReadBits(1) != 0; }
+
+      uint64_t ReadUInt64() noexcept
+      {
+        const uint64_t low = ReadBits(32);
+        const uint64_t high = ReadBits(32);
+        return low | (high << 32);
+      }
+
+      uint32_t ReadVarUInt() noexcept
+      {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+          const uint32_t group = ReadBits(8);
+          result |= (group & 0x7f) << shift;
+          if ((group & 0x80) == 0)
+            return result;
+        }
+        m_overflow = true; // Malformed: more than five groups
+        return 0;
+      }
+
+      int32_t ReadVarInt() noexcept
+      {
+        const uint32_t zigzag = ReadVarUInt();
+        return static_cast<int32_t>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+      }
+
+      float ReadFloat() noexcept { return std::bit_cast<float>(ReadBits(32)); }
+
+      float ReadQuantised(float _min, float _max, int _numBits) noexcept
+      {
+        const uint32_t maxInt = (1u << _numBits) - 1;
+        const uint32_t value = ReadBits(_numBits);
+        return _min + (_max - _min) * (static_cast<float>(value) / static_cast<float>(maxInt));
+      }
+
+      [[nodiscard]] int GetBitPosition() const noexcept { return m_bitPos; }
+      [[nodiscard]] int BitsRemaining() const noexcept { return m_lengthBits - m_bitPos; }
+      [[nodiscard]] bool Overflowed() const noexcept { return m_overflow; }
+
+    private:
+      const uint8_t* m_buffer;
+      int m_lengthBits;
+      int m_bitPos = 0;
+      bool m_overflow = false;
+  };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// CellRect
+//
+// An inclusive rectangle of grid cells, as covered by an object with a
+// radius.  When the object moves, ForEachCellNotIn gives the cells it left
+// (old rect not in new) and the cells it entered (new rect not in old), so
+// a grid only touches the edges of the move rather than every covered cell.
+// Cells are visited x outer, z inner.  A rect with a min above its max is
+// empty.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  struct CellRect
+  {
+    int m_minX = 0;
+    int m_minZ = 0;
+    int m_maxX = -1;
+    int m_maxZ = -1;
+
+    [[nodiscard]] bool IsEmpty() const noexcept { return m_minX > m_maxX || m_minZ > m_maxZ; }
+
+    [[nodiscard]] int Count() const noexcept
+    {
+      return IsEmpty() ? 0 : (m_maxX - m_minX + 1) * (m_maxZ - m_minZ + 1);
+    }
+
+    [[nodiscard]] bool Contains(int _x, int _z) const noexcept
+    {
+      return _x >= m_minX && _x <= m_maxX && _z >= m_minZ && _z <= m_maxZ;
+    }
+
+    [[nodiscard]] bool operator==(const CellRect& _other) const noexcept
+    {
+      if (IsEmpty() || _other.IsEmpty())
+        return IsEmpty() == _other.IsEmpty();
+      return m_minX == _other.m_minX && m_minZ == _other.m_minZ && m_maxX == _other.m_maxX && m_maxZ == _other.m_maxZ;
+    }
+
+    // _visit(int _x, int _z) for every cell in this rect and not in _other
+    template <typename TVisit>
+    void ForEachCellNotIn(const CellRect& _other, TVisit&& _visit) const
+    {
+      if (IsEmpty())
+        return;
+
+      for (int x = m_minX; x <= m_maxX; ++x)
+      {
+        if (_other.IsEmpty() || x < _other.m_minX || x > _other.m_maxX)
+        {
+          for (int z = m_minZ; z <= m_maxZ; ++z)
+            _visit(x, z);
+        }
+        else
+        {
+          // The column is shared: only the parts above and below _other
+          const int below = std::min(m_maxZ, _other.m_minZ - 1);
+          for (int z = m_minZ; z <= below; ++z)
+            _visit(x, z);
+          for (int z = std::max(m_minZ, _other.m_maxZ + 1); z <= m_maxZ; ++z)
+            _visit(x, z);
+        }
+      }
+    }
+  };
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// ChunkVertexMap
+//
+// Remembers which vertices of a mesh take their colour from each chunk of a
+// chunked grid, so a change to a few chunks only revisits those chunks'
+// vertices.  Vertices are stored as runs of consecutive indices: a terrain
+// strip crossing a chunk contributes one run, so the map stays a small
+// fraction of the vertex count.
+//
+// Build is given each vertex's chunk, or -1 for vertices that belong to no
+// chunk and are never revisited.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class ChunkVertexMap
+  {
+    public:
+      struct Range
+      {
+        int m_begin;
+        int m_end;
+      };
+
+      // _chunkOf(int _vertex) -> chunk in [0, _numChunks), or -1
+      template <typename TChunkOf>
+      void Build(int _numChunks, int _numVerts, TChunkOf&& _chunkOf)
+      {
+        // Runs in vertex order, then bucketed by chunk
+        std::vector<int> runChunk;
+        std::vector<Range> runs;
+        for (int v = 0; v < _numVerts; ++v)
+        {
+          const int chunk = _chunkOf(v);
+          DEBUG_ASSERT(chunk >= -1 && chunk < _numChunks);
+          if (chunk < 0)
+            continue;
+          if (!runs.empty() && runs.back().m_end == v && runChunk.back() == chunk)
+          {
+            ++runs.back().m_end;
+            continue;
+          }
+          runs.push_back({v, v + 1});
+          runChunk.push_back(chunk);
+        }
+
+        m_firstRange.assign(_numChunks + 1, 0);
+        for (int chunk : runChunk)
+          ++m_firstRange[chunk + 1];
+        for (int c = 0; c < _numChunks; ++c)
+          m_firstRange[c + 1] += m_firstRange[c];
+
+        m_ranges.resize(runs.size());
+        std::vector<int> next(m_firstRange.begin(), m_firstRange.end() - 1);
+        for (size_t r = 0; r < runs.size(); ++r)
+          m_ranges[next[runChunk[r]]++] = runs[r];
+      }
+
+      void Clear()
+      {
+        m_firstRange.clear();
+        m_ranges.clear();
+      }
+
+      // _visit(int _begin, int _end) for every run of _chunk's vertices, in vertex order
+      template <typename TVisit>
+      void ForEachRange(int _chunk, TVisit&& _visit) const
+      {
+        DEBUG_ASSERT(_chunk >= 0 && _chunk < GetNumChunks());
+        for (int r = m_firstRange[_chunk]; r < m_firstRange[_chunk + 1]; ++r)
+          _visit(m_ranges[r].m_begin, m_ranges[r].m_end);
+      }
+
+      // _visit(int _vertex) for every vertex of _chunk
+      template <typename TVisit>
+      void ForEachVertex(int _chunk, TVisit&& _visit) const
+      {
+        ForEachRange(_chunk, [&](int _begin, int _end)
+        {
+          for (int v = _begin; v < _end; ++v)
+            _visit(v);
+        });
+      }
+
+      [[nodiscard]] int GetNumChunks() const noexcept { return m_firstRange.empty() ? 0 : static_cast<int>(m_firstRange.size()) - 1; }
+      [[nodiscard]] int GetNumRanges() const noexcept { return static_cast<int>(m_ranges.size()); }
+
+      [[nodiscard]] int GetNumVerts(int _chunk) const
+      {
+        int count = 0;
+        ForEachRange(_chunk, [&](int _begin, int _end) { count += _end - _begin; });
+        return count;
+      }
+
+    private:
+      std::vector<int>   m_firstRange;   // Chunk c owns m_ranges[m_firstRange[c], m_firstRange[c + 1])
+      std::vector<Range> m_ranges;
+  };
+}
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <DirectXPackedVector.h>
+
+// ---------------------------------------------------------------------------
+// DspKernels
+//
+// Block kernels for the software DSP effects.  A block is an array of float
+// samples on the 16 bit scale, so a chain of effects can run on one block
+// and round to 16 bits once at the end (ToShort) rather than after every
+// effect.  Only ToShort clamps to the 16 bit range; the kernels in between
+// may overshoot it.
+//
+// Where samples are independent the kernels do four at a time, with a
+// scalar loop for the tail that does the same arithmetic in the same order.
+// The biquad is recursive and runs one sample at a time.  Echo and Reverb
+// read a delay line that they also write, so they work in runs short enough
+// that nothing a run reads was written by that run.
+// ---------------------------------------------------------------------------
+
+namespace Neuron::Dsp
+{
+  inline constexpr float SAMPLE_MAX = 32767.0f;
+
+  [[nodiscard]] inline XMVECTOR XM_CALLCONV Load(const float* _p) { return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(_p)); }
+  inline void XM_CALLCONV Store(float* _p, FXMVECTOR _value) { XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(_p), _value); }
+
+  inline void FromShort(const int16_t* _in, float* _out, int _count)
+  {
+    int i = 0;
+    for (; i + 4 <= _count; i += 4)
+      Store(_out + i, PackedVector::XMLoadShort4(reinterpret_cast<const PackedVector::XMSHORT4*>(_in + i)));
+    for (; i < _count; ++i)
+      _out[i] = _in[i];
+  }
+
+  // Clamps to +/-SAMPLE_MAX and rounds to nearest, halves to even
+  inline void ToShort(const float* _in, int16_t* _out, int _count)
+  {
+    int i = 0;
+    for (; i + 4 <= _count; i += 4)
+      PackedVector::XMStoreShort4(reinterpret_cast<PackedVector::XMSHORT4*>(_out + i), Load(_in + i));
+    for (; i < _count; ++i)
+      _out[i] = static_cast<int16_t>(std::nearbyint(std::clamp(_in[i], -SAMPLE_MAX, SAMPLE_MAX)));
+  }
+
+  // y(n) = a0*x(n) + a1*x(n-1) + a2*x(n-2) - b1*y(n-1) - b2*y(n-2)
+  // and the block gets gain*y(n)
+  struct BiquadCoefs
+  {
+    float m_a0 = 0.0f;
+    float m_a1 = 0.0f;
+    float m_a2 = 0.0f;
+    float m_b1 = 0.0f;
+    float m_b2 = 0.0f;
+    float m_gain = 1.0f;
+  };
+
+  struct BiquadState
+  {
+    float m_xn1 = 0.0f;
+    float m_xn2 = 0.0f;
+    float m_yn1 = 0.0f;
+    float m_yn2 = 0.0f;
+  };
+
+  inline void Biquad(float* _data, int _count, const BiquadCoefs& _coefs, BiquadState& _state)
+  {
+    float xn1 = _state.m_xn1;
+    float xn2 = _state.m_xn2;
+    float yn1 = _state.m_yn1;
+    float yn2 = _state.m_yn2;
+
+    for (int i = 0; i < _count; ++i)
+    {
+      const float xn = _data[i];
+      const float yn = _coefs.m_a0 * xn + _coefs.m_a1 * xn1 + _coefs.m_a2 * xn2 - _coefs.m_b1 * yn1 - _coefs.m_b2 * yn2;
+      _data[i] = yn * _coefs.m_gain;
+      xn2 = xn1;
+      xn1 = xn;
+      yn2 = yn1;
+      yn1 = yn;
+    }
+
+    _state = {xn1, xn2, yn1, yn2};
+  }
+
+  // Each sample becomes the multiple of _stepSize next towards zero
+  inline void BitCrush(float* _data, int _count, float _stepSize)
+  {
+    const XMVECTOR step = XMVectorReplicate(_stepSize);
+
+    int i = 0;
+    for (; i + 4 <= _count; i += 4)
+      Store(_data + i, XMVectorMultiply(XMVectorTruncate(XMVectorDivide(Load(_data + i), step)), step));
+    for (; i < _count; ++i)
+      _data[i] = std::trunc(_data[i] / _stepSize) * _stepSize;
+  }
+
+  // Amplitude modulation.  _phase runs over [0, 2) and goes up by _inc per
+  // sample; the new phase is returned.  The triangle wave mixes
+  // dry + wet * (phase < 1 ? phase : 2 - phase); the square wave passes the
+  // first half of each cycle and silences the second, ignoring _wet.
+  [[nodiscard]] inline float Gargle(float* _data, int _count, float _phase, float _inc, float _wet, bool _square)
+  {
+    const float dry = 1.0f - _wet;
+    const auto wrap = [](float _p)
+    {
+      while (_p >= 2.0f)
+        _p -= 2.0f;
+      return _p;
+    };
+
+    int i = 0;
+
+    // One wrap per lane is enough while three steps stay under a cycle
+    if (_inc < 0.5f)
+    {
+      const XMVECTOR one = XMVectorReplicate(1.0f);
+      const XMVECTOR two = XMVectorReplicate(2.0f);
+      const XMVECTOR ramp = XMVectorSet(0.0f, _inc, 2.0f * _inc, 3.0f * _inc);
+      const XMVECTOR vdry = XMVectorReplicate(dry);
+      const XMVECTOR vwet = XMVectorReplicate(_wet);
+
+      for (; i + 4 <= _count; i += 4)
+      {
+        _phase = wrap(_phase);
+        XMVECTOR phase = XMVectorAdd(XMVectorReplicate(_phase), ramp);
+        phase = XMVectorSelect(phase, XMVectorSubtract(phase, two), XMVectorGreaterOrEqual(phase, two));
+
+        XMVECTOR gain;
+        if (_square)
+          gain = XMVectorSelect(XMVectorZero(), one, XMVectorLess(phase, one));
+        else
+          gain = XMVectorAdd(vdry, XMVectorMultiply(vwet, XMVectorSubtract(one, XMVectorAbs(XMVectorSubtract(phase, one)))));
+
+        Store(_data + i, XMVectorMultiply(Load(_data + i), gain));
+        _phase += 4.0f * _inc;
+      }
+    }
+
+    for (; i < _count; ++i)
+    {
+      _phase = wrap(_phase);
+      const float gain = _square ? (_phase < 1.0f ? 1.0f : 0.0f) : dry + _wet * (1.0f - std::abs(_phase - 1.0f));
+      _data[i] *= gain;
+      _phase += _inc;
+    }
+
+    return wrap(_phase);
+  }
+
+  // A feedback echo _delay samples long.  _line holds the last _delay
+  // samples of the echo; _pos is where the current sample is in it, and the
+  // new _pos is returned.  Out goes dry*in + wet*line, and the line keeps
+  // feedback*line + in.
+  [[nodiscard]] inline int Echo(float* _data, int _count, float* _line, int _delay, int _pos, float _wet, float _feedback)
+  {
+    DEBUG_ASSERT(_delay > 0 && _pos >= 0 && _pos < _delay);
+
+    const float dry = 1.0f - _wet;
+    const XMVECTOR vdry = XMVectorReplicate(dry);
+    const XMVECTOR vwet = XMVectorReplicate(_wet);
+    const XMVECTOR vfeedback = XMVectorReplicate(_feedback);
+
+    int done = 0;
+    while (done < _count)
+    {
+      // Up to the end of the line; each line sample is touched once
+      const int run = std::min(_count - done, _delay - _pos);
+      float* data = _data + done;
+      float* line = _line + _pos;
+
+      int i = 0;
+      for (; i + 4 <= run; i += 4)
+      {
+        const XMVECTOR in = Load(data + i);
+        const XMVECTOR echo = Load(line + i);
+        Store(data + i, XMVectorAdd(XMVectorMultiply(in, vdry), XMVectorMultiply(echo, vwet)));
+        Store(line + i, XMVectorAdd(XMVectorMultiply(echo, vfeedback), in));
+      }
+      for (; i < run; ++i)
+      {
+        const float in = data[i];
+        const float echo = line[i];
+        data[i] = in * dry + echo * _wet;
+        line[i] = echo * _feedback + in;
+      }
+
+      done += run;
+      _pos += run;
+      if (_pos == _delay)
+        _pos = 0;
+    }
+
+    return _pos;
+  }
+
+  inline constexpr int MAX_REVERB_TAPS = 8;
+
+  struct ReverbTap
+  {
+    int   m_delay;   // In samples, at least 1 and less than the line size
+    float m_decay;
+  };
+
+  // A multi-tap feedback reverb.  _line holds the last _lineSize outputs,
+  // the current one going at _pos; the new _pos is returned.  Out goes
+  // dry*in + wet*(sum of decay*line[pos - delay]), clamped to +/-SAMPLE_MAX
+  // so that taps whose decays sum past 1 cannot run away.
+  [[nodiscard]] inline int Reverb(float* _data, int _count, float* _line, int _lineSize, int _pos,
+                                  const ReverbTap* _taps, int _numTaps, float _dry, float _wet)
+  {
+    DEBUG_ASSERT(_lineSize > 0 && _pos >= 0 && _pos < _lineSize);
+    DEBUG_ASSERT(_numTaps <= MAX_REVERB_TAPS);
+
+    int minDelay = _lineSize;
+    for (int t = 0; t < _numTaps; ++t)
+    {
+      DEBUG_ASSERT(_taps[t].m_delay > 0 && _taps[t].m_delay < _lineSize);
+      minDelay = std::min(minDelay, _taps[t].m_delay);
+    }
+
+    const XMVECTOR vdry = XMVectorReplicate(_dry);
+    const XMVECTOR vwet = XMVectorReplicate(_wet);
+    const XMVECTOR vmax = XMVectorReplicate(SAMPLE_MAX);
+    const XMVECTOR vmin = XMVectorReplicate(-SAMPLE_MAX);
+
+    int done = 0;
+    while (done < _count)
+    {
+      float* data = _data + done;
+      float* line = _line + _pos;
+      const float* reads[MAX_REVERB_TAPS];
+
+      // Short of the shortest delay, so the run reads no output of its own,
+      // and short of either end of the line, so the reads do not wrap
+      int run = std::min({_count - done, _lineSize - _pos, minDelay});
+      for (int t = 0; t < _numTaps; ++t)
+      {
+        reads[t] = _pos >= _taps[t].m_delay ? line - _taps[t].m_delay : line - _taps[t].m_delay + _lineSize;
+        run = std::min(run, static_cast<int>(_line + _lineSize - reads[t]));
+      }
+
+      int i = 0;
+      for (; i + 4 <= run; i += 4)
+      {
+        XMVECTOR sum = XMVectorZero();
+        for (int t = 0; t < _numTaps; ++t)
+          sum = XMVectorAdd(sum, XMVectorMultiply(Load(reads[t] + i), XMVectorReplicate(_taps[t].m_decay)));
+
+        const XMVECTOR out = XMVectorClamp(XMVectorAdd(XMVectorMultiply(Load(data + i), vdry), XMVectorMultiply(sum, vwet)), vmin, vmax);
+        Store(line + i, out);
+        Store(data + i, out);
+      }
+      for (; i < run; ++i)
+      {
+        float sum = 0.0f;
+        for (int t = 0; t < _numTaps; ++t)
+          sum += reads[t][i] * _taps[t].m_decay;
+
+        const float out = std::clamp(data[i] * _dry + sum * _wet, -SAMPLE_MAX, SAMPLE_MAX);
+        line[i] = out;
+        data[i] = out;
+      }
+
+      done += run;
+      _pos += run;
+      if (_pos == _lineSize)
+        _pos = 0;
+    }
+
+    return _pos;
+  }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// HistoryRing<T, Capacity>
+//
+// The last Capacity values pushed, newest first: index 0 is the most recent
+// push, Size() - 1 the oldest kept.  For the position trails that entities
+// record once a tick and read back by age.  Push and index are O(1) and
+// nothing is allocated; when the ring is full a push drops the oldest value.
+// Truncate drops from the old end, for trails whose length is decided per
+// push (a maximum count, or a total distance).
+//
+// Capacity must be a power of two.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  template <typename T, int Capacity>
+  class HistoryRing
+  {
+    static_assert(Capacity > 0 && std::has_single_bit(static_cast<unsigned>(Capacity)), "Capacity must be a power of two");
+
+    public:
+      void Push(const T& _value) noexcept
+      {
+        m_newest = (m_newest - 1) & MASK;
+        m_slots[m_newest] = _value;
+        if (m_size < Capacity)
+          ++m_size;
+      }
+
+      // 0 is the newest
+      [[nodiscard]] T& operator[](int _age) noexcept
+      {
+        DEBUG_ASSERT(ValidIndex(_age));
+        return m_slots[(m_newest + static_cast<unsigned>(_age)) & MASK];
+      }
+
+      [[nodiscard]] const T& operator[](int _age) const noexcept
+      {
+        DEBUG_ASSERT(ValidIndex(_age));
+        return m_slots[(m_newest + static_cast<unsigned>(_age)) & MASK];
+      }
+
+      [[nodiscard]] bool ValidIndex(int _age) const noexcept { return _age >= 0 && _age < m_size; }
+
+      // Keeps the newest _size values
+      void Truncate(int _size) noexcept { m_size = std::clamp(_size, 0, m_size); }
+      void Clear() noexcept { m_size = 0; }
+
+      [[nodiscard]] int Size() const noexcept { return m_size; }
+      [[nodiscard]] bool IsEmpty() const noexcept { return m_size == 0; }
+      [[nodiscard]] static constexpr int GetCapacity() noexcept { return Capacity; }
+
+    private:
+      static constexpr unsigned MASK = Capacity - 1;
+
+      std::array<T, Capacity> m_slots = {};
+      unsigned m_newest = 0;
+      int m_size = 0;
+  };
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "CellRect.h"
+
+// ---------------------------------------------------------------------------
+// IdCellGrid<Id>
+//
+// A grid of cells holding object ids, as EntityGrid keeps one per team.
+// Each cell's ids sit in slots that grow by doubling; a freed slot goes on
+// a list that the next add takes from the front, so the order of ids in a
+// cell depends only on the order of adds and removes.
+//
+// MoveId touches only the cells an object left or entered.  A cell it
+// stays in keeps the id in the same slot, just as removing it from every
+// cell and adding it back would, so readers see the same order either way.
+//
+// Id needs == and SetInvalid.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  template <typename Id>
+  class IdGridCell
+  {
+    public:
+      static constexpr int END_OF_LIST = -100000;
+
+      IdGridCell() = default;
+      IdGridCell(const IdGridCell&) = delete;
+      IdGridCell& operator=(const IdGridCell&) = delete;
+
+      ~IdGridCell()
+      {
+        delete[] m_objectIds;
+        delete[] m_usageLists;
+      }
+
+      void AddObjectId(const Id& _objectId)
+      {
+        if (m_firstFree == END_OF_LIST)
+        {
+          DEBUG_ASSERT(m_numSlotsFree == 0);
+
+          const int newArraySize = m_arraySize == 0 ? 2 : m_arraySize * 2;
+          m_numSlotsFree = newArraySize - m_arraySize;
+          auto newObjectIds = new Id[newArraySize];
+          auto newUsageLists = new int[newArraySize];
+
+          // Copy data from old array into first half of new array
+          for (int i = 0; i < m_arraySize; ++i)
+          {
+            newObjectIds[i] = m_objectIds[i];
+            newUsageLists[i] = m_usageLists[i];
+          }
+
+          // Fill the second half of the new usage array with free list entries
+          for (int i = m_arraySize; i < newArraySize - 1; ++i)
+            newUsageLists[i] = i + 1;
+          newUsageLists[newArraySize - 1] = END_OF_LIST;
+
+          delete[] m_objectIds;
+          delete[] m_usageLists;
+          m_firstFree = m_arraySize;
+          m_objectIds = newObjectIds;
+          m_usageLists = newUsageLists;
+          m_arraySize = newArraySize;
+        }
+
+        const int target = m_firstFree;
+        DEBUG_ASSERT(target >= 0 && target < m_arraySize);
+
+        m_firstFree = m_usageLists[target];
+        m_objectIds[target] = _objectId;
+        m_usageLists[target] = END_OF_LIST;
+        m_numSlotsFree--;
+      }
+
+      // False if the cell did not hold the id
+      bool RemoveObjectId(const Id& _objectId)
+      {
+        bool found = false;
+        for (int i = 0; i < m_arraySize; i++)
+        {
+          if (m_objectIds[i] == _objectId)
+          {
+            m_objectIds[i].SetInvalid();
+            m_usageLists[i] = m_firstFree;
+            m_firstFree = i;
+            m_numSlotsFree++;
+            found = true;
+          }
+        }
+
+        return found;
+      }
+
+      int m_numSlotsFree = 0;
+      int m_firstFree = END_OF_LIST;
+      Id* m_objectIds = nullptr;        // Invalid where the slot is free
+      int* m_usageLists = nullptr;      // The next free slot, or END_OF_LIST
+      int m_arraySize = 0;
+  };
+
+  template <typename Id>
+  class IdCellGrid
+  {
+    public:
+      struct Moves
+      {
+        int m_cellsLeft = 0;
+        int m_cellsEntered = 0;
+      };
+
+      // Only needed after the default constructor
+      void Initialise(int _numCellsX, int _numCellsZ)
+      {
+        m_numCellsX = _numCellsX;
+        m_numCellsZ = _numCellsZ;
+        m_cells = std::make_unique<IdGridCell<Id>[]>(static_cast<size_t>(_numCellsX) * _numCellsZ);
+      }
+
+      [[nodiscard]] IdGridCell<Id>& GetCell(int _x, int _z)
+      {
+        DEBUG_ASSERT(_x >= 0 && _x < m_numCellsX);
+        DEBUG_ASSERT(_z >= 0 && _z < m_numCellsZ);
+        return m_cells[_z * m_numCellsX + _x];
+      }
+
+      [[nodiscard]] const IdGridCell<Id>& GetCell(int _x, int _z) const
+      {
+        DEBUG_ASSERT(_x >= 0 && _x < m_numCellsX);
+        DEBUG_ASSERT(_z >= 0 && _z < m_numCellsZ);
+        return m_cells[_z * m_numCellsX + _x];
+      }
+
+      void AddId(const Id& _id, const CellRect& _cells)
+      {
+        for (int x = _cells.m_minX; x <= _cells.m_maxX; ++x)
+        {
+          for (int z = _cells.m_minZ; z <= _cells.m_maxZ; ++z)
+            GetCell(x, z).AddObjectId(_id);
+        }
+      }
+
+      // _onMissing(int _x, int _z) for every cell that did not hold the id
+      template <typename TMissing>
+      void RemoveId(const Id& _id, const CellRect& _cells, TMissing&& _onMissing)
+      {
+        for (int x = _cells.m_minX; x <= _cells.m_maxX; ++x)
+        {
+          for (int z = _cells.m_minZ; z <= _cells.m_maxZ; ++z)
+          {
+            if (!GetCell(x, z).RemoveObjectId(_id))
+              _onMissing(x, z);
+          }
+        }
+      }
+
+      // From the cells of _from to those of _to, leaving the cells in both alone
+      template <typename TMissing>
+      Moves MoveId(const Id& _id, const CellRect& _from, const CellRect& _to, TMissing&& _onMissing)
+      {
+        Moves moves;
+        _from.ForEachCellNotIn(_to, [&](int _x, int _z)
+        {
+          if (!GetCell(_x, _z).RemoveObjectId(_id))
+            _onMissing(_x, _z);
+          ++moves.m_cellsLeft;
+        });
+        _to.ForEachCellNotIn(_from, [&](int _x, int _z)
+        {
+          GetCell(_x, _z).AddObjectId(_id);
+          ++moves.m_cellsEntered;
+        });
+        return moves;
+      }
+
+      [[nodiscard]] int GetNumCellsX() const noexcept { return m_numCellsX; }
+      [[nodiscard]] int GetNumCellsZ() const noexcept { return m_numCellsZ; }
+
+    private:
+      std::unique_ptr<IdGridCell<Id>[]> m_cells;
+      int m_numCellsX = 0;
+      int m_numCellsZ = 0;
+  };
+}
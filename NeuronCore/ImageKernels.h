@@ -0,0 +1,260 @@
+#pragma once
+
+#include <DirectXPackedVector.h>
+
+// ---------------------------------------------------------------------------
+// ImageKernels
+//
+// Kernels over RGBA images, 8 bits a channel, rows packed with no padding:
+// the layout of BitmapRGBA's m_pixels.  A pixel is worked on as one
+// XMVECTOR of floats on the 0-255 scale, so the four channels go together
+// where the old code did them one at a time, and converting back truncates
+// as the float to unsigned char conversions in BitmapRGBA did.  Sums are of
+// whole numbers well inside a float's exact range, so each kernel gives
+// the same bytes as the scalar code it replaces.
+//
+// DownsampleSrgb builds the next level of a mip chain, averaging in linear
+// light rather than on the stored sRGB values, which would darken every
+// level.
+// ---------------------------------------------------------------------------
+
+namespace Neuron::Image
+{
+  [[nodiscard]] inline XMVECTOR XM_CALLCONV LoadPixel(const uint8_t* _p)
+  {
+    return PackedVector::XMLoadUByte4(reinterpret_cast<const PackedVector::XMUBYTE4*>(_p));
+  }
+
+  // _value must be in [0, 256); the fraction is dropped
+  inline void XM_CALLCONV StorePixel(uint8_t* _p, FXMVECTOR _value)
+  {
+    PackedVector::XMStoreUByte4(reinterpret_cast<PackedVector::XMUBYTE4*>(_p), XMVectorTruncate(_value));
+  }
+
+  // r, g and b each become (r + g + b) / 3, rounded down; alpha is kept.
+  // This one stays a byte loop: it is all memory traffic, and the compiler
+  // vectorises it better than four pixels of floats through a transpose.
+  inline void GreyScale(uint8_t* _pixels, int _count)
+  {
+    for (int i = 0; i < _count; ++i)
+    {
+      uint8_t* p = _pixels + i * 4;
+      const uint8_t grey = static_cast<uint8_t>((p[0] + p[1] + p[2]) / 3);
+      p[0] = grey;
+      p[1] = grey;
+      p[2] = grey;
+    }
+  }
+
+  // Each pixel not on the border becomes the mean of its eight neighbours
+  // in _src, opaque.  _dst must already hold _src's border.
+  inline void Dilate(const uint8_t* _src, uint8_t* _dst, int _width, int _height)
+  {
+    if (_width < 3 || _height < 3)
+      return;
+
+    const XMVECTOR eighth = XMVectorReplicate(0.125f);
+    const XMVECTOR alphaControl = XMVectorSelectControl(0, 0, 0, 1);
+    const XMVECTOR opaque = XMVectorReplicate(255.0f);
+
+    // Each column's sum over the three rows, then three columns at a time
+    std::vector<XMFLOAT4> columns(_width);
+    for (int y = 1; y < _height - 1; ++y)
+    {
+      const uint8_t* above = _src + (y - 1) * _width * 4;
+      const uint8_t* row = _src + y * _width * 4;
+      const uint8_t* below = _src + (y + 1) * _width * 4;
+      for (int x = 0; x < _width; ++x)
+        XMStoreFloat4(&columns[x], XMVectorAdd(XMVectorAdd(LoadPixel(above + x * 4), LoadPixel(row + x * 4)), LoadPixel(below + x * 4)));
+
+      uint8_t* out = _dst + y * _width * 4;
+      for (int x = 1; x < _width - 1; ++x)
+      {
+        XMVECTOR sum = XMVectorAdd(XMVectorAdd(XMLoadFloat4(&columns[x - 1]), XMLoadFloat4(&columns[x])), XMLoadFloat4(&columns[x + 1]));
+        sum = XMVectorSubtract(sum, LoadPixel(row + x * 4));
+        StorePixel(out + x * 4, XMVectorSelect(XMVectorMultiply(sum, eighth), opaque, alphaControl));
+      }
+    }
+  }
+
+  // BitmapRGBA's glow blur: a five tap horizontal pass then a five tap
+  // vertical pass at twice the weight, each tap's contribution truncated and
+  // each pass saturating at 255.  Pixels that no lit pixel reaches come out
+  // transparent black, the rest opaque.
+  inline void Blur(uint8_t* _pixels, int _width, int _height, float _scale)
+  {
+    constexpr int TAPS = 5;
+    constexpr int HALF_TAPS = 2;
+    float m[TAPS] = {2, 4, 7, 4, 2};
+    for (float& w : m)
+      w *= _scale * 0.0526f;
+
+    const XMVECTOR zero = XMVectorZero();
+    const XMVECTOR one = XMVectorReplicate(1.0f);
+    const XMVECTOR full = XMVectorReplicate(255.0f);
+    const XMVECTOR alphaControl = XMVectorSelectControl(0, 0, 0, 1);
+
+    // Horizontal, into floats.  Alpha becomes 1 where the pixel is lit,
+    // which is all the vertical pass wants of it.
+    std::vector<XMFLOAT4> row(_width);
+    std::vector<XMFLOAT4> temp(static_cast<size_t>(_width) * _height);
+    for (int y = 0; y < _height; ++y)
+    {
+      const uint8_t* src = _pixels + y * _width * 4;
+      for (int x = 0; x < _width; ++x)
+        XMStoreFloat4(&row[x], LoadPixel(src + x * 4));
+
+      for (int x = 0; x < _width; ++x)
+      {
+        XMVECTOR sum = zero;
+        for (int i = 0; i < TAPS; ++i)
+        {
+          const int s = x - i + HALF_TAPS;
+          if (s >= 0 && s < _width)
+            sum = XMVectorAdd(sum, XMVectorTruncate(XMVectorMultiply(XMLoadFloat4(&row[s]), XMVectorReplicate(m[i]))));
+        }
+        sum = XMVectorMin(sum, full);
+        const XMVECTOR lit = XMVectorSelect(zero, one, XMVectorGreater(XMVector3Dot(sum, one), zero));
+        XMStoreFloat4(&temp[y * _width + x], XMVectorSelect(sum, lit, alphaControl));
+      }
+    }
+
+    for (float& w : m)
+      w *= 2.0f;
+
+    // Vertical, a row of output at a time
+    for (int y = 0; y < _height; ++y)
+    {
+      uint8_t* out = _pixels + y * _width * 4;
+      for (int x = 0; x < _width; ++x)
+      {
+        XMVECTOR sum = zero;
+        XMVECTOR lit = zero;
+        for (int i = 0; i < TAPS; ++i)
+        {
+          const int s = y - i + HALF_TAPS;
+          if (s >= 0 && s < _height)
+          {
+            const XMVECTOR t = XMLoadFloat4(&temp[s * _width + x]);
+            sum = XMVectorAdd(sum, XMVectorTruncate(XMVectorMultiply(t, XMVectorReplicate(m[i]))));
+            lit = XMVectorAdd(lit, t);
+          }
+        }
+        const XMVECTOR alpha = XMVectorSelect(zero, full, XMVectorGreater(lit, zero));
+        StorePixel(out + x * 4, XMVectorSelect(XMVectorMin(sum, full), alpha, alphaControl));
+      }
+    }
+  }
+
+  // As BitmapRGBA::GetPixelClipped: off the image is opaque black
+  [[nodiscard]] inline XMVECTOR XM_CALLCONV LoadPixelClipped(const uint8_t* _pixels, int _width, int _height, int _x, int _y)
+  {
+    if (_x < 0 || _x >= _width || _y < 0 || _y >= _height)
+      return XMVectorSet(0.0f, 0.0f, 0.0f, 255.0f);
+    return LoadPixel(_pixels + (_y * _width + _x) * 4);
+  }
+
+  // Bilinear sample at (_x, _y), pixel centres on whole numbers, with
+  // BitmapRGBA::GetInterpolatedPixel's weights and edge handling
+  [[nodiscard]] inline XMVECTOR XM_CALLCONV Bilinear(const uint8_t* _pixels, int _width, int _height, float _x, float _y)
+  {
+    const int x1 = static_cast<int>(floorf(_x));
+    const int y1 = static_cast<int>(floorf(_y));
+    int x2 = static_cast<int>(ceilf(_x));
+    int y2 = static_cast<int>(ceilf(_y));
+    if (x2 == _width)
+      x2 = _width - 1;
+    if (y2 == _height)
+      y2 = _height - 1;
+
+    const float fx = _x - static_cast<float>(x1);
+    const float fy = _y - static_cast<float>(y1);
+
+    XMVECTOR sum = XMVectorMultiply(LoadPixelClipped(_pixels, _width, _height, x1, y1), XMVectorReplicate((1.0f - fx) * (1.0f - fy)));
+    sum = XMVectorAdd(sum, XMVectorMultiply(LoadPixelClipped(_pixels, _width, _height, x1, y2), XMVectorReplicate((1.0f - fx) * fy)));
+    sum = XMVectorAdd(sum, XMVectorMultiply(LoadPixelClipped(_pixels, _width, _height, x2, y1), XMVectorReplicate(fx * (1.0f - fy))));
+    sum = XMVectorAdd(sum, XMVectorMultiply(LoadPixelClipped(_pixels, _width, _height, x2, y2), XMVectorReplicate(fx * fy)));
+    return sum;
+  }
+
+  // --- Mip generation ------------------------------------------------------
+
+  [[nodiscard]] inline const float* SrgbToLinearTable()
+  {
+    static const std::array<float, 256> table = []
+    {
+      std::array<float, 256> t;
+      for (int i = 0; i < 256; ++i)
+      {
+        const double c = i / 255.0;
+        t[i] = static_cast<float>(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+      }
+      return t;
+    }();
+    return table.data();
+  }
+
+  // How many levels a full chain down to 1x1 has
+  [[nodiscard]] constexpr int MipCount(int _width, int _height)
+  {
+    int count = 1;
+    for (int size = std::max(_width, _height); size > 1; size /= 2)
+      ++count;
+    return count;
+  }
+
+  [[nodiscard]] constexpr int MipSize(int _size) { return std::max(1, _size / 2); }
+
+  // Halves _src into _dst (MipSize of each side), each output pixel the
+  // mean of a 2x2 block: colour averaged as linear light and encoded back to
+  // sRGB, alpha averaged as is.  A side of odd length loses its last row or
+  // column; a side of 1 stays 1.
+  inline void DownsampleSrgb(const uint8_t* _src, int _srcWidth, int _srcHeight, uint8_t* _dst)
+  {
+    const float* toLinear = SrgbToLinearTable();
+    const int width = MipSize(_srcWidth);
+    const int height = MipSize(_srcHeight);
+    const int dx = _srcWidth > 1 ? 1 : 0;
+    const int dy = _srcHeight > 1 ? 1 : 0;
+
+    const XMVECTOR quarter = XMVectorSet(0.25f, 0.25f, 0.25f, 0.25f / 255.0f);
+    const XMVECTOR full = XMVectorReplicate(255.0f);
+    const auto linear = [toLinear](const uint8_t* _p) { return XMVectorSet(toLinear[_p[0]], toLinear[_p[1]], toLinear[_p[2]], _p[3]); };
+
+    for (int y = 0; y < height; ++y)
+    {
+      const uint8_t* top = _src + (y * 2) * _srcWidth * 4;
+      const uint8_t* bottom = top + dy * _srcWidth * 4;
+      uint8_t* out = _dst + y * width * 4;
+      for (int x = 0; x < width; ++x)
+      {
+        const int a = x * 2 * 4;
+        const int b = a + dx * 4;
+        XMVECTOR sum = XMVectorAdd(XMVectorAdd(linear(top + a), linear(top + b)), XMVectorAdd(linear(bottom + a), linear(bottom + b)));
+        sum = XMColorRGBToSRGB(XMVectorMultiply(sum, quarter));
+        PackedVector::XMStoreUByte4(reinterpret_cast<PackedVector::XMUBYTE4*>(out + x * 4), XMVectorMultiply(sum, full));
+      }
+    }
+  }
+
+  // Level 0 is _pixels itself, which is not copied; the rest go into
+  // _levels, smallest last.  Returns the number of levels.
+  inline int BuildMipChain(const uint8_t* _pixels, int _width, int _height, std::vector<std::vector<uint8_t>>& _levels)
+  {
+    const int count = MipCount(_width, _height);
+    _levels.resize(count - 1);
+
+    const uint8_t* src = _pixels;
+    for (int level = 1; level < count; ++level)
+    {
+      std::vector<uint8_t>& dst = _levels[level - 1];
+      dst.resize(static_cast<size_t>(MipSize(_width)) * MipSize(_height) * 4);
+      DownsampleSrgb(src, _width, _height, dst.data());
+
+      src = dst.data();
+      _width = MipSize(_width);
+      _height = MipSize(_height);
+    }
+    return count;
+  }
+}
@@ -0,0 +1,372 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// JobSystem
+//
+// A pool of worker threads running small jobs.  Each worker owns a queue:
+// it takes its own most recent job first and, when that runs dry, steals
+// the oldest job from another worker.  Threads outside the pool submit to a
+// shared queue that every worker steals from.
+//
+// Submit takes the jobs the new job depends on; it is queued only once all
+// of them have finished, so a task graph is built by passing handles along.
+// Wait runs other jobs while it waits rather than blocking, so it is safe
+// to call from inside a job.
+//
+// ParallelFor splits an index range into chunks that the caller and the
+// workers claim in turn, like OpenMP's schedule(dynamic).  The caller
+// returns once every index has run.  Indices must be independent; the
+// order they run in is not defined.
+//
+// AllocateScratch hands out per-thread memory that is released when the
+// job (or ParallelFor chunk) that allocated it returns.  Nothing is freed
+// individually and nothing is returned to the heap between jobs.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class JobSystem;
+
+  // A submitted job.  A default-constructed handle counts as finished.
+  class JobHandle
+  {
+    public:
+      JobHandle() noexcept = default;
+
+      [[nodiscard]] bool IsFinished() const noexcept { return !m_job || m_job->m_finished.load(std::memory_order_acquire); }
+
+    private:
+      friend class JobSystem;
+
+      struct Job
+      {
+        std::function<void()> m_work;
+        std::atomic<int> m_pending{1};      // Unfinished dependencies, plus one until Submit returns
+        std::atomic<bool> m_finished{false};
+        std::mutex m_lock;                   // Guards m_dependents against m_finished
+        std::vector<std::shared_ptr<Job>> m_dependents;
+      };
+
+      explicit JobHandle(std::shared_ptr<Job> _job) noexcept
+        : m_job(std::move(_job)) {}
+
+      std::shared_ptr<Job> m_job;
+  };
+
+  class JobSystem
+  {
+    public:
+      using JobFunc = std::function<void()>;
+
+      // _numWorkers counts the calling thread; 0 uses one per hardware thread
+      explicit JobSystem(int _numWorkers = 0)
+      {
+        if (_numWorkers <= 0)
+          _numWorkers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        // Queue 0 is shared by every thread outside the pool
+        m_queues = std::make_unique<WorkQueue[]>(_numWorkers);
+        m_numQueues = _numWorkers;
+
+        m_workers.reserve(_numWorkers - 1);
+        for (int i = 1; i < _numWorkers; ++i)
+          m_workers.emplace_back([this, i] { RunWorker(i); });
+      }
+
+      ~JobSystem()
+      {
+        m_quit.store(true, std::memory_order_relaxed);
+        Signal(true);
+        for (std::thread& worker : m_workers)
+          worker.join();
+      }
+
+      JobSystem(const JobSystem&) = delete;
+      JobSystem& operator=(const JobSystem&) = delete;
+
+      JobHandle Submit(JobFunc _work, std::initializer_list<JobHandle> _dependencies = {})
+      {
+        return Submit(std::move(_work), _dependencies.begin(), _dependencies.size());
+      }
+
+      JobHandle Submit(JobFunc _work, const std::vector<JobHandle>& _dependencies)
+      {
+        return Submit(std::move(_work), _dependencies.data(), _dependencies.size());
+      }
+
+      // Runs queued jobs until _job has finished
+      void Wait(const JobHandle& _job)
+      {
+        while (!_job.IsFinished())
+        {
+          if (!RunOne())
+            std::this_thread::yield();
+        }
+      }
+
+      // _body(int _index) for every index in [_begin, _end), _grain indices per claim
+      template <typename TBody>
+      void ParallelFor(int _begin, int _end, int _grain, TBody&& _body)
+      {
+        if (_end <= _begin)
+          return;
+
+        _grain = std::max(_grain, 1);
+        const int numChunks = (_end - _begin + _grain - 1) / _grain;
+        std::atomic<int> nextChunk{0};
+        auto runChunks = [&]
+        {
+          for (int chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < numChunks;
+               chunk = nextChunk.fetch_add(1, std::memory_order_relaxed))
+          {
+            const ScratchMark mark = t_scratch.Mark();
+            const int last = std::min(_end, _begin + (chunk + 1) * _grain);
+            for (int i = _begin + chunk * _grain; i < last; ++i)
+              _body(i);
+            t_scratch.Release(mark);
+          }
+        };
+
+        const int numHelpers = std::min(numChunks, GetNumWorkers()) - 1;
+        std::vector<JobHandle> helpers;
+        helpers.reserve(numHelpers);
+        for (int i = 0; i < numHelpers; ++i)
+          helpers.push_back(Submit(runChunks));
+
+        runChunks();
+        for (const JobHandle& helper : helpers)
+          Wait(helper);
+      }
+
+      // Valid until the job or ParallelFor chunk running on this thread returns
+      [[nodiscard]] static void* AllocateScratch(size_t _size, size_t _alignment = alignof(std::max_align_t))
+      {
+        return t_scratch.Allocate(_size, _alignment);
+      }
+
+      template <typename T>
+      [[nodiscard]] static T* AllocateScratch(int _count)
+      {
+        static_assert(std::is_trivially_destructible_v<T>);
+        return static_cast<T*>(AllocateScratch(sizeof(T) * _count, alignof(T)));
+      }
+
+      [[nodiscard]] int GetNumWorkers() const noexcept { return m_numQueues; }
+
+      // Outside a job, releases the scratch memory this thread allocated
+      // while the scope was open
+      class ScratchScope;
+
+    private:
+      using Job = JobHandle::Job;
+
+      struct WorkQueue
+      {
+        std::mutex m_lock;
+        std::deque<std::shared_ptr<Job>> m_jobs;
+      };
+
+      struct ScratchMark
+      {
+        size_t m_block;
+        size_t m_offset;
+      };
+
+      // Bump allocator; blocks are kept for reuse once released
+      class ScratchArena
+      {
+        public:
+          void* Allocate(size_t _size, size_t _alignment)
+          {
+            for (;; ++m_block, m_offset = 0)
+            {
+              if (m_block == m_blocks.size())
+                m_blocks.push_back({std::make_unique<std::byte[]>(std::max(_size + _alignment, BLOCK_SIZE)), std::max(_size + _alignment, BLOCK_SIZE)});
+
+              Block& block = m_blocks[m_block];
+              const auto base = reinterpret_cast<uintptr_t>(block.m_data.get());
+              const size_t start = ((base + m_offset + _alignment - 1) & ~(static_cast<uintptr_t>(_alignment) - 1)) - base;
+              if (start + _size <= block.m_size)
+              {
+                m_offset = start + _size;
+                return block.m_data.get() + start;
+              }
+            }
+          }
+
+          [[nodiscard]] ScratchMark Mark() const noexcept { return {m_block, m_offset}; }
+
+          void Release(const ScratchMark& _mark) noexcept
+          {
+            m_block = _mark.m_block;
+            m_offset = _mark.m_offset;
+          }
+
+        private:
+          static constexpr size_t BLOCK_SIZE = 256 * 1024;
+
+          struct Block
+          {
+            std::unique_ptr<std::byte[]> m_data;
+            size_t m_size;
+          };
+
+          std::vector<Block> m_blocks;
+          size_t m_block = 0;
+          size_t m_offset = 0;
+      };
+
+      JobHandle Submit(JobFunc _work, const JobHandle* _dependencies, size_t _numDependencies)
+      {
+        auto job = std::make_shared<Job>();
+        job->m_work = std::move(_work);
+
+        for (size_t i = 0; i < _numDependencies; ++i)
+        {
+          Job* dependency = _dependencies[i].m_job.get();
+          if (!dependency)
+            continue;
+
+          std::scoped_lock lock(dependency->m_lock);
+          if (!dependency->m_finished.load(std::memory_order_relaxed))
+          {
+            job->m_pending.fetch_add(1, std::memory_order_relaxed);
+            dependency->m_dependents.push_back(job);
+          }
+        }
+
+        JobHandle handle(job);
+        if (job->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+          Enqueue(std::move(job));
+        return handle;
+      }
+
+      void Enqueue(std::shared_ptr<Job> _job)
+      {
+        WorkQueue& queue = m_queues[CurrentQueue()];
+        {
+          std::scoped_lock lock(queue.m_lock);
+          queue.m_jobs.push_back(std::move(_job));
+        }
+        Signal(false);
+      }
+
+      void Execute(const std::shared_ptr<Job>& _job)
+      {
+        const ScratchMark mark = t_scratch.Mark();
+        _job->m_work();
+        _job->m_work = nullptr;
+        t_scratch.Release(mark);
+
+        std::vector<std::shared_ptr<Job>> dependents;
+        {
+          std::scoped_lock lock(_job->m_lock);
+          _job->m_finished.store(true, std::memory_order_release);
+          dependents.swap(_job->m_dependents);
+        }
+        for (std::shared_ptr<Job>& dependent : dependents)
+        {
+          if (dependent->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Enqueue(std::move(dependent));
+        }
+      }
+
+      // Own queue newest-first, then steal oldest-first from the others
+      bool RunOne()
+      {
+        const int own = CurrentQueue();
+        std::shared_ptr<Job> job;
+        {
+          WorkQueue& queue = m_queues[own];
+          std::scoped_lock lock(queue.m_lock);
+          if (!queue.m_jobs.empty())
+          {
+            job = std::move(queue.m_jobs.back());
+            queue.m_jobs.pop_back();
+          }
+        }
+
+        for (int i = 1; !job && i < m_numQueues; ++i)
+        {
+          WorkQueue& victim = m_queues[(own + i) % m_numQueues];
+          std::scoped_lock lock(victim.m_lock);
+          if (!victim.m_jobs.empty())
+          {
+            job = std::move(victim.m_jobs.front());
+            victim.m_jobs.pop_front();
+          }
+        }
+
+        if (!job)
+          return false;
+        Execute(job);
+        return true;
+      }
+
+      void RunWorker(int _queue)
+      {
+        t_owner = this;
+        t_queue = _queue;
+        while (!m_quit.load(std::memory_order_relaxed))
+        {
+          const uint32_t signal = m_signal.load(std::memory_order_acquire);
+          if (!RunOne() && !m_quit.load(std::memory_order_relaxed))
+            m_signal.wait(signal, std::memory_order_acquire);
+        }
+      }
+
+      void Signal(bool _all)
+      {
+        m_signal.fetch_add(1, std::memory_order_release);
+        if (_all)
+          m_signal.notify_all();
+        else
+          m_signal.notify_one();
+      }
+
+      [[nodiscard]] int CurrentQueue() const noexcept { return t_owner == this ? t_queue : 0; }
+
+      inline static thread_local const JobSystem* t_owner = nullptr;
+      inline static thread_local int t_queue = 0;
+      static thread_local ScratchArena t_scratch;
+
+      std::unique_ptr<WorkQueue[]> m_queues;
+      int m_numQueues = 0;
+      std::vector<std::thread> m_workers;
+      alignas(64) std::atomic<uint32_t> m_signal{0};
+      std::atomic<bool> m_quit{false};
+  };
+
+  inline thread_local JobSystem::ScratchArena JobSystem::t_scratch;
+
+  class JobSystem::ScratchScope
+  {
+    public:
+      ScratchScope() noexcept
+        : m_mark(t_scratch.Mark()) {}
+
+      ~ScratchScope() { t_scratch.Release(m_mark); }
+
+      ScratchScope(const ScratchScope&) = delete;
+      ScratchScope& operator=(const ScratchScope&) = delete;
+
+    private:
+      ScratchMark m_mark;
+  };
+
+  // Runs on _jobs when there is one, otherwise in order on the caller
+  template <typename TBody>
+  void ParallelFor(JobSystem* _jobs, int _begin, int _end, int _grain, TBody&& _body)
+  {
+    if (_jobs)
+    {
+      _jobs->ParallelFor(_begin, _end, _grain, std::forward<TBody>(_body));
+      return;
+    }
+    for (int i = _begin; i < _end; ++i)
+    {
+      JobSystem::ScratchScope scratch;
+      _body(i);
+    }
+  }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// MatchHost
+//
+// Advances many independent simulations ("matches") in one process on a
+// fixed pool of worker threads.  AdvanceAll runs one tick of every match and
+// returns when all of them have finished, so every match keeps the same
+// fixed tick rate.
+//
+// Within a tick each match is claimed by exactly one thread, so a match is
+// never advanced concurrently with itself and never twice in one tick.
+// Which thread runs it changes from tick to tick; a match must therefore
+// keep all of its state with it rather than in thread-locals, and bind
+// whatever per-thread context it needs (e.g. GameContextScope) on entry.
+//
+// The calling thread takes part in every tick, so a host with one worker
+// runs everything on the caller.
+//
+// RunMatchHostCheck in Starstrike hosts real Locations this way, each with
+// a headless GameContext of its own.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class MatchHost
+  {
+    public:
+      using AdvanceFunc = std::function<void()>;
+
+      // _numWorkers counts the calling thread; 0 uses one per hardware thread
+      explicit MatchHost(int _numWorkers = 0)
+      {
+        if (_numWorkers <= 0)
+          _numWorkers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        m_workers.reserve(_numWorkers - 1);
+        for (int i = 1; i < _numWorkers; ++i)
+          m_workers.emplace_back([this] { RunWorker(); });
+      }
+
+      ~MatchHost()
+      {
+        m_quit.store(true, std::memory_order_relaxed);
+        m_generation.fetch_add(1, std::memory_order_release);
+        m_generation.notify_all();
+        for (std::thread& worker : m_workers)
+          worker.join();
+      }
+
+      MatchHost(const MatchHost&) = delete;
+      MatchHost& operator=(const MatchHost&) = delete;
+
+      // Not between AdvanceAll calls on another thread.  Returns the match's slot.
+      int AddMatch(AdvanceFunc _advance)
+      {
+        for (size_t i = 0; i < m_matches.size(); ++i)
+        {
+          if (!m_matches[i])
+          {
+            m_matches[i] = std::move(_advance);
+            return static_cast<int>(i);
+          }
+        }
+        m_matches.push_back(std::move(_advance));
+        return static_cast<int>(m_matches.size()) - 1;
+      }
+
+      void RemoveMatch(int _slot)
+      {
+        if (_slot >= 0 && _slot < static_cast<int>(m_matches.size()))
+          m_matches[_slot] = nullptr;
+      }
+
+      // One tick of every match
+      void AdvanceAll()
+      {
+        m_nextMatch.store(0, std::memory_order_relaxed);
+        m_busyWorkers.store(static_cast<int>(m_workers.size()), std::memory_order_relaxed);
+        m_generation.fetch_add(1, std::memory_order_release);
+        m_generation.notify_all();
+
+        RunMatches();
+
+        for (int busy = m_busyWorkers.load(std::memory_order_acquire); busy != 0; busy = m_busyWorkers.load(std::memory_order_acquire))
+          m_busyWorkers.wait(busy, std::memory_order_acquire);
+      }
+
+      [[nodiscard]] int GetNumWorkers() const noexcept { return static_cast<int>(m_workers.size()) + 1; }
+
+      [[nodiscard]] int GetNumMatches() const noexcept
+      {
+        return static_cast<int>(std::ranges::count_if(m_matches, [](const AdvanceFunc& _match) { return static_cast<bool>(_match); }));
+      }
+
+    private:
+      void RunMatches()
+      {
+        const int numMatches = static_cast<int>(m_matches.size());
+        for (int i = m_nextMatch.fetch_add(1, std::memory_order_relaxed); i < numMatches; i = m_nextMatch.fetch_add(1, std::memory_order_relaxed))
+        {
+          if (m_matches[i])
+            m_matches[i]();
+        }
+      }
+
+      void RunWorker()
+      {
+        uint32_t seen = 0;
+        for (;;)
+        {
+          m_generation.wait(seen, std::memory_order_acquire);
+          seen = m_generation.load(std::memory_order_acquire);
+          if (m_quit.load(std::memory_order_relaxed))
+            return;
+
+          RunMatches();
+
+          if (m_busyWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            m_busyWorkers.notify_one();
+        }
+      }
+
+      std::vector<AdvanceFunc> m_matches;
+      std::vector<std::thread> m_workers;
+
+      alignas(64) std::atomic<int> m_nextMatch{0};
+      alignas(64) std::atomic<int> m_busyWorkers{0};
+      alignas(64) std::atomic<uint32_t> m_generation{0};
+      std::atomic<bool> m_quit{false};
+  };
+}
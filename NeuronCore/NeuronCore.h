@@ -13,7 +13,9 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bit>
+#include <cmath>
 #include <concurrent_queue.h>
 #include <concurrent_unordered_map.h>
 #include <cstddef>
@@ -26,11 +28,13 @@
 #include <functional>
 #include <future>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <mdspan>
 #include <memory>
 #include <queue>
 #include <ranges>
+#include <semaphore>
 #include <set>
 #include <shared_mutex>
 #include <stack>
@@ -0,0 +1,52 @@
+#pragma once
+
+// What NeuronCore.h provides, for the Linux build.  That build is NetLib
+// alone (see CMakeLists.txt at the root): the rest of NeuronCore is
+// Windows-only.
+
+#include <algorithm>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+namespace Neuron
+{
+  template <class... Types>
+  void DebugTrace(const std::string_view _fmt, [[maybe_unused]] Types&&... _args)
+  {
+#if defined(_DEBUG) && defined(__cpp_lib_format)
+    const std::string message = std::vformat(_fmt, std::make_format_args(_args...));
+    fputs(message.c_str(), stderr);
+#elif defined(_DEBUG)
+    // No <format> before GCC 13: the message without its arguments
+    fwrite(_fmt.data(), 1, _fmt.size(), stderr);
+#else
+    (void)_fmt;
+#endif
+  }
+}
+
+#ifdef _DEBUG
+#define DEBUG_ASSERT(expression)             assert(expression)
+#else
+#define DEBUG_ASSERT(expression)             ((void)0)
+#endif
+
+using namespace Neuron;
@@ -0,0 +1,264 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// ParticleStore
+//
+// Struct-of-arrays storage for short-lived cosmetic particles.  Each field
+// lives in its own array so Integrate can move four particles per
+// instruction.  Particles are packed at [0, Count()); removing one moves
+// the last particle into its slot, so indices are only stable until the
+// next removal.
+//
+// The store never holds more than its budget.  When it is full, a new
+// particle evicts one of the least important particles held, provided the
+// new one is more important; otherwise the new one is dropped.  Lowering
+// the budget evicts least important first.
+//
+// Integrate applies one step of motion to a range of particles and touches
+// nothing outside it, so disjoint ranges may be integrated in parallel.
+// Everything else is single-threaded.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  struct ParticleSpawn
+  {
+    XMFLOAT3 m_pos;
+    XMFLOAT3 m_vel;
+    float    m_damping = 1.0f;      // Velocity is multiplied by this each step
+    float    m_gravityStep = 0.0f;  // Then this is taken off its y
+    float    m_deathTime = 0.0f;    // Expires once the clock passes this
+    float    m_size = 1.0f;
+    uint32_t m_colour = 0;          // Opaque to the store
+    uint8_t  m_type = 0;            // Opaque to the store
+    uint8_t  m_priority = 0;        // [0, NUM_PRIORITIES); higher survives longer
+  };
+
+  class ParticleStore
+  {
+    public:
+      static constexpr int NUM_PRIORITIES = 4;
+
+      struct Stats
+      {
+        int     m_peakCount = 0;
+        int64_t m_spawned = 0;
+        int64_t m_dropped = 0;   // Refused at the budget
+        int64_t m_evicted = 0;   // Removed to make room for something more important
+      };
+
+      explicit ParticleStore(int _budget = 10000)
+      {
+        SetBudget(_budget);
+      }
+
+      void SetBudget(int _budget)
+      {
+        m_budget = std::max(_budget, 0);
+        while (m_count > m_budget)
+        {
+          ++m_stats.m_evicted;
+          Remove(FindVictim(LowestPriority()));
+        }
+        Reserve(m_budget);
+      }
+
+      // Index of the new particle, or -1 if it was dropped
+      int Spawn(const ParticleSpawn& _spawn)
+      {
+        DEBUG_ASSERT(_spawn.m_priority < NUM_PRIORITIES);
+        if (m_count >= m_budget)
+        {
+          const int lowest = LowestPriority();
+          if (m_count == 0 || _spawn.m_priority <= lowest)
+          {
+            ++m_stats.m_dropped;
+            return -1;
+          }
+          ++m_stats.m_evicted;
+          Remove(FindVictim(lowest));
+        }
+
+        if (m_count == static_cast<int>(m_posX.size()))
+          Reserve(std::max(64, m_count * 2));
+
+        const int i = m_count++;
+        m_posX[i] = _spawn.m_pos.x;
+        m_posY[i] = _spawn.m_pos.y;
+        m_posZ[i] = _spawn.m_pos.z;
+        m_velX[i] = _spawn.m_vel.x;
+        m_velY[i] = _spawn.m_vel.y;
+        m_velZ[i] = _spawn.m_vel.z;
+        m_damping[i] = _spawn.m_damping;
+        m_gravityStep[i] = _spawn.m_gravityStep;
+        m_deathTime[i] = _spawn.m_deathTime;
+        m_size[i] = _spawn.m_size;
+        m_colour[i] = _spawn.m_colour;
+        m_type[i] = _spawn.m_type;
+        m_priority[i] = _spawn.m_priority;
+        ++m_priorityCount[_spawn.m_priority];
+
+        ++m_stats.m_spawned;
+        m_stats.m_peakCount = std::max(m_stats.m_peakCount, m_count);
+        return i;
+      }
+
+      // Moves the last particle into _index
+      void Remove(int _index)
+      {
+        DEBUG_ASSERT(_index >= 0 && _index < m_count);
+        --m_priorityCount[m_priority[_index]];
+        const int last = --m_count;
+        m_posX[_index] = m_posX[last];
+        m_posY[_index] = m_posY[last];
+        m_posZ[_index] = m_posZ[last];
+        m_velX[_index] = m_velX[last];
+        m_velY[_index] = m_velY[last];
+        m_velZ[_index] = m_velZ[last];
+        m_damping[_index] = m_damping[last];
+        m_gravityStep[_index] = m_gravityStep[last];
+        m_deathTime[_index] = m_deathTime[last];
+        m_size[_index] = m_size[last];
+        m_colour[_index] = m_colour[last];
+        m_type[_index] = m_type[last];
+        m_priority[_index] = m_priority[last];
+      }
+
+      // Removes every particle whose death time _now has passed
+      void RemoveExpired(double _now)
+      {
+        for (int i = 0; i < m_count;)
+        {
+          if (_now > m_deathTime[i])
+            Remove(i);
+          else
+            ++i;
+        }
+      }
+
+      // One step for particles [_begin, _end): pos += vel * dt, then
+      // vel *= damping, then vel.y -= gravityStep.  Multiplies and adds
+      // are kept separate so the result matches the same sums in scalar code.
+      void Integrate(int _begin, int _end, float _dt)
+      {
+        DEBUG_ASSERT(_begin >= 0 && _end <= m_count);
+        const XMVECTOR dt = XMVectorReplicate(_dt);
+
+        int i = _begin;
+        for (; i + 4 <= _end; i += 4)
+        {
+          const XMVECTOR damping = Load(m_damping, i);
+
+          XMVECTOR vel = Load(m_velX, i);
+          Store(m_posX, i, XMVectorAdd(Load(m_posX, i), XMVectorMultiply(vel, dt)));
+          Store(m_velX, i, XMVectorMultiply(vel, damping));
+
+          vel = Load(m_velY, i);
+          Store(m_posY, i, XMVectorAdd(Load(m_posY, i), XMVectorMultiply(vel, dt)));
+          Store(m_velY, i, XMVectorSubtract(XMVectorMultiply(vel, damping), Load(m_gravityStep, i)));
+
+          vel = Load(m_velZ, i);
+          Store(m_posZ, i, XMVectorAdd(Load(m_posZ, i), XMVectorMultiply(vel, dt)));
+          Store(m_velZ, i, XMVectorMultiply(vel, damping));
+        }
+
+        for (; i < _end; ++i)
+        {
+          m_posX[i] += m_velX[i] * _dt;
+          m_posY[i] += m_velY[i] * _dt;
+          m_posZ[i] += m_velZ[i] * _dt;
+          m_velX[i] *= m_damping[i];
+          m_velY[i] = m_velY[i] * m_damping[i] - m_gravityStep[i];
+          m_velZ[i] *= m_damping[i];
+        }
+      }
+
+      void Clear()
+      {
+        m_count = 0;
+        std::ranges::fill(m_priorityCount, 0);
+      }
+
+      [[nodiscard]] int Count() const noexcept { return m_count; }
+      [[nodiscard]] int GetBudget() const noexcept { return m_budget; }
+      [[nodiscard]] int CountWithPriority(int _priority) const noexcept { return m_priorityCount[_priority]; }
+
+      [[nodiscard]] const Stats& GetStats() const noexcept { return m_stats; }
+      void ResetStats() noexcept { m_stats = {}; }
+
+      [[nodiscard]] XMFLOAT3 GetPos(int _i) const noexcept { return {m_posX[_i], m_posY[_i], m_posZ[_i]}; }
+      [[nodiscard]] XMFLOAT3 GetVel(int _i) const noexcept { return {m_velX[_i], m_velY[_i], m_velZ[_i]}; }
+      void SetPos(int _i, const XMFLOAT3& _pos) noexcept { m_posX[_i] = _pos.x; m_posY[_i] = _pos.y; m_posZ[_i] = _pos.z; }
+      void SetVel(int _i, const XMFLOAT3& _vel) noexcept { m_velX[_i] = _vel.x; m_velY[_i] = _vel.y; m_velZ[_i] = _vel.z; }
+
+      [[nodiscard]] float GetDeathTime(int _i) const noexcept { return m_deathTime[_i]; }
+      [[nodiscard]] float GetSize(int _i) const noexcept { return m_size[_i]; }
+      [[nodiscard]] uint32_t GetColour(int _i) const noexcept { return m_colour[_i]; }
+      [[nodiscard]] int GetType(int _i) const noexcept { return m_type[_i]; }
+      [[nodiscard]] int GetPriority(int _i) const noexcept { return m_priority[_i]; }
+
+    private:
+      static XMVECTOR XM_CALLCONV Load(const std::vector<float>& _column, int _i)
+      {
+        return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(_column.data() + _i));
+      }
+
+      static void XM_CALLCONV Store(std::vector<float>& _column, int _i, FXMVECTOR _value)
+      {
+        XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(_column.data() + _i), _value);
+      }
+
+      void Reserve(int _capacity)
+      {
+        if (_capacity <= static_cast<int>(m_posX.size()))
+          return;
+        for (std::vector<float>* column : {&m_posX, &m_posY, &m_posZ, &m_velX, &m_velY, &m_velZ, &m_damping, &m_gravityStep, &m_deathTime, &m_size})
+          column->resize(_capacity);
+        m_colour.resize(_capacity);
+        m_type.resize(_capacity);
+        m_priority.resize(_capacity);
+      }
+
+      [[nodiscard]] int LowestPriority() const noexcept
+      {
+        for (int p = 0; p < NUM_PRIORITIES; ++p)
+        {
+          if (m_priorityCount[p] > 0)
+            return p;
+        }
+        return NUM_PRIORITIES;
+      }
+
+      // Some particle with _priority.  The search resumes where the last one
+      // stopped, so evicting many in a row stays linear overall.
+      int FindVictim(int _priority)
+      {
+        DEBUG_ASSERT(m_priorityCount[_priority] > 0);
+        if (m_evictCursor >= m_count)
+          m_evictCursor = 0;
+        for (;;)
+        {
+          if (m_priority[m_evictCursor] == _priority)
+            return m_evictCursor;
+          if (++m_evictCursor == m_count)
+            m_evictCursor = 0;
+        }
+      }
+
+      std::vector<float>    m_posX, m_posY, m_posZ;
+      std::vector<float>    m_velX, m_velY, m_velZ;
+      std::vector<float>    m_damping;
+      std::vector<float>    m_gravityStep;
+      std::vector<float>    m_deathTime;
+      std::vector<float>    m_size;
+      std::vector<uint32_t> m_colour;
+      std::vector<uint8_t>  m_type;
+      std::vector<uint8_t>  m_priority;
+
+      int   m_priorityCount[NUM_PRIORITIES] = {};
+      int   m_count = 0;
+      int   m_budget = 0;
+      int   m_evictCursor = 0;
+      Stats m_stats;
+  };
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// PolylineGrid
+//
+// Uniform grid over the x and z of a polyline's points, for nearest-point
+// and nearest-segment queries on long routes.  Segment i runs from point i
+// to point i + 1.  Like SphereGrid it ignores y when bucketing; points go in
+// the cell they fall in, segments in every cell their bounding box covers.
+// Building is a counting sort, cheap enough to redo whenever a point moves.
+//
+// A query searches outward from the query's cell a ring of cells at a time
+// and stops once the next ring is further than the best answer so far,
+// with some slack for the rounding of the caller's distance.  The caller
+// supplies the exact distance, so the answer is the one a loop over every
+// point or segment with that distance would give: the smallest, and the
+// lowest index of those equally small.  A distance must be at least the
+// distance in x and z.  Points with a non-finite x or z, and segments
+// touching one, are checked by every query.
+//
+// Vectors are anything with x and z members.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class PolylineGrid
+  {
+    public:
+      // _point(int _index) returns point _index
+      template <typename TPoint>
+      void Build(int _numPoints, TPoint&& _point)
+      {
+        Clear();
+        m_numPoints = _numPoints;
+
+        m_x.resize(_numPoints);
+        m_z.resize(_numPoints);
+        float lo[2] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        float hi[2] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+        int numFinite = 0;
+        for (int i = 0; i < _numPoints; ++i)
+        {
+          const auto& p = _point(i);
+          m_x[i] = p.x;
+          m_z[i] = p.z;
+          if (!IsFinite(i))
+            continue;
+          lo[0] = std::min(lo[0], m_x[i]);
+          hi[0] = std::max(hi[0], m_x[i]);
+          lo[1] = std::min(lo[1], m_z[i]);
+          hi[1] = std::max(hi[1], m_z[i]);
+          ++numFinite;
+        }
+
+        if (numFinite == 0)
+        {
+          for (int i = 0; i < _numPoints; ++i)
+            m_unboundedPoints.push_back(i);
+          for (int i = 0; i + 1 < _numPoints; ++i)
+            m_unboundedSegments.push_back(i);
+          return;
+        }
+
+        // About CELL_OCCUPANCY points to a cell, and no more than
+        // MAX_CELLS_PER_POINT cells a point however the points are spread
+        const float width = std::max(hi[0] - lo[0], MIN_CELL_SIZE);
+        const float depth = std::max(hi[1] - lo[1], MIN_CELL_SIZE);
+        float cellSize = std::sqrt(width * depth * CELL_OCCUPANCY / static_cast<float>(numFinite));
+        cellSize = std::max({cellSize, MIN_CELL_SIZE, std::sqrt(width * depth / (MAX_CELLS_PER_POINT * static_cast<float>(numFinite)))});
+
+        m_cellSize = cellSize;
+        m_cellSizeRecip = 1.0f / cellSize;
+        m_originX = lo[0];
+        m_originZ = lo[1];
+        m_numCellsX = static_cast<int>(width * m_cellSizeRecip) + 1;
+        m_numCellsZ = static_cast<int>(depth * m_cellSizeRecip) + 1;
+        const int numCells = m_numCellsX * m_numCellsZ;
+
+        // Points: one cell each
+        m_pointStart.assign(numCells + 1, 0);
+        for (int i = 0; i < _numPoints; ++i)
+        {
+          if (IsFinite(i))
+            ++m_pointStart[CellIndex(m_x[i], m_z[i]) + 1];
+          else
+            m_unboundedPoints.push_back(i);
+        }
+        for (int c = 0; c < numCells; ++c)
+          m_pointStart[c + 1] += m_pointStart[c];
+        m_pointItems.resize(m_pointStart.back());
+        m_cursor.assign(m_pointStart.begin(), m_pointStart.end() - 1);
+        for (int i = 0; i < _numPoints; ++i)
+        {
+          if (IsFinite(i))
+            m_pointItems[m_cursor[CellIndex(m_x[i], m_z[i])]++] = i;
+        }
+
+        // Segments: every cell of their box
+        m_segmentStart.assign(numCells + 1, 0);
+        for (int i = 0; i + 1 < _numPoints; ++i)
+        {
+          if (IsFinite(i) && IsFinite(i + 1))
+            ForEachSegmentCell(i, [&](int _cell) { ++m_segmentStart[_cell + 1]; });
+          else
+            m_unboundedSegments.push_back(i);
+        }
+        for (int c = 0; c < numCells; ++c)
+          m_segmentStart[c + 1] += m_segmentStart[c];
+        m_segmentItems.resize(m_segmentStart.back());
+        m_cursor.assign(m_segmentStart.begin(), m_segmentStart.end() - 1);
+        for (int i = 0; i + 1 < _numPoints; ++i)
+        {
+          if (IsFinite(i) && IsFinite(i + 1))
+            ForEachSegmentCell(i, [&](int _cell) { m_segmentItems[m_cursor[_cell]++] = i; });
+        }
+      }
+
+      void Clear()
+      {
+        m_numPoints = 0;
+        m_numCellsX = 0;
+        m_numCellsZ = 0;
+        m_x.clear();
+        m_z.clear();
+        m_pointStart.clear();
+        m_pointItems.clear();
+        m_segmentStart.clear();
+        m_segmentItems.clear();
+        m_unboundedPoints.clear();
+        m_unboundedSegments.clear();
+      }
+
+      // The point with the smallest _distSq(int _index), a squared
+      // distance, or -1 if there are no points
+      template <typename TDistSq>
+      [[nodiscard]] int NearestPoint(float _x, float _z, TDistSq&& _distSq) const
+      {
+        Best best;
+        for (const int i : m_unboundedPoints)
+          best.Offer(i, _distSq(i));
+        SearchRings(_x, _z, best, true, m_pointStart, m_pointItems, _distSq);
+        return best.m_index;
+      }
+
+      // The segment with the smallest _dist(int _index), a plain distance,
+      // or -1 if there are fewer than two points
+      template <typename TDist>
+      [[nodiscard]] int NearestSegment(float _x, float _z, TDist&& _dist) const
+      {
+        Best best;
+        for (const int i : m_unboundedSegments)
+          best.Offer(i, _dist(i));
+        SearchRings(_x, _z, best, false, m_segmentStart, m_segmentItems, _dist);
+        return best.m_index;
+      }
+
+      [[nodiscard]] int GetNumPoints() const noexcept { return m_numPoints; }
+      [[nodiscard]] int GetNumCellsX() const noexcept { return m_numCellsX; }
+      [[nodiscard]] int GetNumCellsZ() const noexcept { return m_numCellsZ; }
+
+    private:
+      static constexpr float CELL_OCCUPANCY = 2.0f;
+      static constexpr float MAX_CELLS_PER_POINT = 4.0f;
+      static constexpr float MIN_CELL_SIZE = 1.0f;
+
+      // Rings are skipped only when clearly further than the best so far
+      static constexpr float SLACK = 0.999f;
+
+      struct Best
+      {
+        int   m_index = -1;
+        float m_value = std::numeric_limits<float>::max();
+
+        void Offer(int _index, float _value)
+        {
+          // As a loop in index order keeping the first strictly smaller
+          if (_value < m_value || (_value == m_value && _index < m_index))
+          {
+            m_value = _value;
+            m_index = _index;
+          }
+        }
+      };
+
+      [[nodiscard]] bool IsFinite(int _i) const { return std::isfinite(m_x[_i]) && std::isfinite(m_z[_i]); }
+
+      [[nodiscard]] int CellCoord(float _v, float _origin, int _numCells) const
+      {
+        return std::clamp(static_cast<int>((_v - _origin) * m_cellSizeRecip), 0, _numCells - 1);
+      }
+
+      [[nodiscard]] int CellIndex(float _x, float _z) const
+      {
+        return CellCoord(_z, m_originZ, m_numCellsZ) * m_numCellsX + CellCoord(_x, m_originX, m_numCellsX);
+      }
+
+      template <typename TVisit>
+      void ForEachSegmentCell(int _segment, TVisit&& _visit) const
+      {
+        const int x0 = CellCoord(std::min(m_x[_segment], m_x[_segment + 1]), m_originX, m_numCellsX);
+        const int x1 = CellCoord(std::max(m_x[_segment], m_x[_segment + 1]), m_originX, m_numCellsX);
+        const int z0 = CellCoord(std::min(m_z[_segment], m_z[_segment + 1]), m_originZ, m_numCellsZ);
+        const int z1 = CellCoord(std::max(m_z[_segment], m_z[_segment + 1]), m_originZ, m_numCellsZ);
+        for (int z = z0; z <= z1; ++z)
+        {
+          for (int x = x0; x <= x1; ++x)
+            _visit(z * m_numCellsX + x);
+        }
+      }
+
+      // Offers every item in the rings of cells around (_x, _z) that could
+      // beat the best so far
+      template <typename TDistance>
+      void SearchRings(float _x, float _z, Best& _best, bool _squared, const std::vector<int>& _start, const std::vector<int>& _items,
+                       TDistance&& _distance) const
+      {
+        if (m_numCellsX == 0 || !std::isfinite(_x) || !std::isfinite(_z))
+        {
+          // Nothing bucketed, or nowhere to search from
+          if (m_numCellsX != 0)
+          {
+            for (const int i : _items)
+              _best.Offer(i, _distance(i));
+          }
+          return;
+        }
+
+        // The query's cell, which may be off the grid
+        const auto cell = [this](float _v, float _origin)
+        {
+          const float c = std::floor((_v - _origin) * m_cellSizeRecip);
+          return static_cast<int>(std::clamp(c, -1.0e6f, 1.0e6f));
+        };
+        const int cx = cell(_x, m_originX);
+        const int cz = cell(_z, m_originZ);
+
+        const auto outside = [](int _c, int _n) { return _c < 0 ? -_c : _c >= _n ? _c - _n + 1 : 0; };
+        const int firstRing = std::max(outside(cx, m_numCellsX), outside(cz, m_numCellsZ));
+        const int lastRing = std::max({cx, m_numCellsX - 1 - cx, cz, m_numCellsZ - 1 - cz});
+
+        const auto visitCell = [&](int _x, int _z)
+        {
+          const int c = _z * m_numCellsX + _x;
+          for (int k = _start[c]; k < _start[c + 1]; ++k)
+            _best.Offer(_items[k], _distance(_items[k]));
+        };
+
+        for (int ring = firstRing; ring <= lastRing; ++ring)
+        {
+          // Every cell in this ring is at least this far from the query
+          if (_best.m_index != -1)
+          {
+            const float gap = static_cast<float>(std::max(ring - 1, 0)) * m_cellSize * SLACK;
+            if ((_squared ? gap * gap : gap) > _best.m_value)
+              break;
+          }
+
+          const int z0 = std::max(cz - ring, 0);
+          const int z1 = std::min(cz + ring, m_numCellsZ - 1);
+          const int x0 = std::max(cx - ring, 0);
+          const int x1 = std::min(cx + ring, m_numCellsX - 1);
+          for (int z = z0; z <= z1; ++z)
+          {
+            if (z == cz - ring || z == cz + ring)
+            {
+              for (int x = x0; x <= x1; ++x)
+                visitCell(x, z);
+            }
+            else
+            {
+              if (cx - ring >= 0 && cx - ring < m_numCellsX)
+                visitCell(cx - ring, z);
+              if (ring > 0 && cx + ring >= 0 && cx + ring < m_numCellsX)
+                visitCell(cx + ring, z);
+            }
+          }
+        }
+      }
+
+      int   m_numPoints = 0;
+      float m_cellSize = 0.0f;
+      float m_cellSizeRecip = 0.0f;
+      float m_originX = 0.0f;
+      float m_originZ = 0.0f;
+      int   m_numCellsX = 0;
+      int   m_numCellsZ = 0;
+
+      std::vector<float> m_x;
+      std::vector<float> m_z;
+      std::vector<int>   m_pointStart;     // Cell c's points are m_pointItems[m_pointStart[c] .. m_pointStart[c + 1])
+      std::vector<int>   m_pointItems;
+      std::vector<int>   m_segmentStart;   // Likewise for segments
+      std::vector<int>   m_segmentItems;
+      std::vector<int>   m_unboundedPoints;
+      std::vector<int>   m_unboundedSegments;
+      std::vector<int>   m_cursor;         // Scratch for Build
+  };
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// SpscRingQueue<T, Capacity> / MpscRingQueue<T, Capacity>
+//
+// Bounded lock-free FIFOs for handing small handles (usually pointers)
+// between threads.  Capacity must be a power of two.  T must be trivially
+// copyable.  Neither queue allocates after construction.
+//
+// TryPush returns false when the queue is full; the caller decides whether
+// to drop or retry.  TryPop returns false when the queue is empty.
+//
+// SpscRingQueue: exactly one producer thread and one consumer thread.
+// MpscRingQueue: any number of producers, exactly one consumer.  Each slot
+// carries a sequence number (Vyukov's bounded queue) so producers only
+// contend on a single compare-exchange of the tail.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  inline constexpr size_t RING_QUEUE_CACHE_LINE = 64;
+
+  template <typename T, int Capacity>
+  class SpscRingQueue
+  {
+    static_assert(Capacity > 0 && std::has_single_bit(static_cast<unsigned>(Capacity)), "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    public:
+      bool TryPush(const T& _value) noexcept
+      {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_headCache == Capacity)
+        {
+          m_headCache = m_head.load(std::memory_order_acquire);
+          if (tail - m_headCache == Capacity)
+            return false;
+        }
+
+        m_slots[tail & MASK] = _value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+      }
+
+      bool TryPop(T& _value) noexcept
+      {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tailCache)
+        {
+          m_tailCache = m_tail.load(std::memory_order_acquire);
+          if (head == m_tailCache)
+            return false;
+        }
+
+        _value = m_slots[head & MASK];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+      }
+
+      // Exact only when called from the producer or consumer with the other side idle
+      [[nodiscard]] int SizeApprox() const noexcept
+      {
+        return static_cast<int>(m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire));
+      }
+
+      [[nodiscard]] static constexpr int GetCapacity() noexcept { return Capacity; }
+
+    private:
+      static constexpr size_t MASK = Capacity - 1;
+
+      // Consumer-owned line
+      alignas(RING_QUEUE_CACHE_LINE) std::atomic<size_t> m_head{0};
+      size_t m_tailCache = 0;
+
+      // Producer-owned line
+      alignas(RING_QUEUE_CACHE_LINE) std::atomic<size_t> m_tail{0};
+      size_t m_headCache = 0;
+
+      alignas(RING_QUEUE_CACHE_LINE) T m_slots[Capacity] = {};
+  };
+
+  template <typename T, int Capacity>
+  class MpscRingQueue
+  {
+    static_assert(Capacity > 1 && std::has_single_bit(static_cast<unsigned>(Capacity)), "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    public:
+      MpscRingQueue() noexcept
+      {
+        for (int i = 0; i < Capacity; ++i)
+          m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+      }
+
+      bool TryPush(const T& _value) noexcept
+      {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;)
+        {
+          slot = &m_slots[pos & MASK];
+          const size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+          const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+          if (diff == 0)
+          {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+              break;
+          }
+          else if (diff < 0)
+            return false; // Full: the consumer has not freed this slot yet
+          else
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+
+        slot->m_value = _value;
+        slot->m_sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+
+      // Single consumer.  Returns false if the oldest slot is still being
+      // written, even if later pushes have completed, so FIFO order holds.
+      bool TryPop(T& _value) noexcept
+      {
+        Slot& slot = m_slots[m_head & MASK];
+        if (slot.m_sequence.load(std::memory_order_acquire) != m_head + 1)
+          return false;
+
+        _value = slot.m_value;
+        slot.m_sequence.store(m_head + Capacity, std::memory_order_release);
+        ++m_head;
+        return true;
+      }
+
+      // Consumer thread only
+      [[nodiscard]] int SizeApprox() const noexcept
+      {
+        return static_cast<int>(m_tail.load(std::memory_order_acquire) - m_head);
+      }
+
+      [[nodiscard]] static constexpr int GetCapacity() noexcept { return Capacity; }
+
+    private:
+      static constexpr size_t MASK = Capacity - 1;
+
+      struct Slot
+      {
+        std::atomic<size_t> m_sequence;
+        T m_value;
+      };
+
+      // Consumer-owned line
+      alignas(RING_QUEUE_CACHE_LINE) size_t m_head = 0;
+
+      // Contended by producers
+      alignas(RING_QUEUE_CACHE_LINE) std::atomic<size_t> m_tail{0};
+
+      alignas(RING_QUEUE_CACHE_LINE) Slot m_slots[Capacity];
+  };
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// SequenceRing<T>
+//
+// A window of values keyed by a monotonically increasing sequence id, stored
+// in a contiguous power-of-two ring.  Lookup by id is a mask and an index,
+// whatever the window size.  New ids may only be added at or past the end of
+// the window and old ids only removed from the front, which is exactly the
+// shape of a resend history.
+//
+// Ids skipped by Put hold a default-constructed T, so a ring of pointers
+// reports them as nullptr.  The ring grows by doubling and never shrinks.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  template <typename T>
+  class SequenceRing
+  {
+    public:
+      explicit SequenceRing(int _initialCapacity = 256)
+        : m_slots(std::bit_ceil(static_cast<unsigned>(std::max(_initialCapacity, 1)))) {}
+
+      // _id must be at or past GetEndId(); any gap is filled with T{}
+      void Put(int _id, const T& _value)
+      {
+        DEBUG_ASSERT(_id >= m_endId);
+        if (m_firstId == m_endId)
+          m_firstId = m_endId = _id;
+
+        Reserve(_id - m_firstId + 1);
+        for (; m_endId < _id; ++m_endId)
+          m_slots[Slot(m_endId)] = T{};
+        m_slots[Slot(_id)] = _value;
+        m_endId = _id + 1;
+      }
+
+      // T{} if _id is outside the window
+      [[nodiscard]] T Get(int _id) const noexcept
+      {
+        return Contains(_id) ? m_slots[Slot(_id)] : T{};
+      }
+
+      [[nodiscard]] bool Contains(int _id) const noexcept { return _id >= m_firstId && _id < m_endId; }
+
+      // Removes and returns the oldest entry; the window must not be empty
+      T PopFront() noexcept
+      {
+        DEBUG_ASSERT(m_firstId < m_endId);
+        T& slot = m_slots[Slot(m_firstId++)];
+        T value = slot;
+        slot = T{};
+        return value;
+      }
+
+      void Clear() noexcept
+      {
+        while (m_firstId < m_endId)
+          PopFront();
+      }
+
+      [[nodiscard]] int GetFirstId() const noexcept { return m_firstId; }
+      [[nodiscard]] int GetEndId() const noexcept { return m_endId; }
+      [[nodiscard]] int Size() const noexcept { return m_endId - m_firstId; }
+      [[nodiscard]] bool Empty() const noexcept { return m_endId == m_firstId; }
+      [[nodiscard]] int GetCapacity() const noexcept { return static_cast<int>(m_slots.size()); }
+
+    private:
+      [[nodiscard]] size_t Slot(int _id) const noexcept { return static_cast<size_t>(_id) & (m_slots.size() - 1); }
+
+      void Reserve(int _count)
+      {
+        if (static_cast<size_t>(_count) <= m_slots.size())
+          return;
+
+        std::vector<T> grown(std::bit_ceil(static_cast<unsigned>(_count)));
+        for (int id = m_firstId; id < m_endId; ++id)
+          grown[static_cast<size_t>(id) & (grown.size() - 1)] = m_slots[Slot(id)];
+        m_slots.swap(grown);
+      }
+
+      std::vector<T> m_slots;
+      int m_firstId = 0;
+      int m_endId = 0;
+  };
+}
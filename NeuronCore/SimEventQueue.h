@@ -1,40 +1,233 @@
 #pragma once
 
 // ---------------------------------------------------------------------------
-// SimEventQueue<TEvent, Capacity>
+// SimEventQueue<TEvent>
 //
-// Fixed-capacity, flat-array queue of deferred simulation side-effects.
-// TEvent must be trivially copyable.  No per-frame allocations.
+// Growable queue of deferred simulation side-effects.  Storage is kept
+// across Clear(), so once the queue has grown to a match's busiest frame it
+// stops allocating.  Events beyond MaxEvents are dropped and counted rather
+// than growing without bound.
 //
 // Producers call Push() during simulation ticks.
-// The client drains via Count()/Get() after the simulation step, then Clear().
+// The client drains via Count()/Get() after each simulation tick, then Clear().
+//
+// Coalescing: TEvent::CoalesceKey() returns a key identifying what the event
+// does (e.g. "this sound on this object").  A push whose key matches an event
+// already queued since the last Clear() is dropped as a duplicate.  Key 0
+// never coalesces.  SIM_EVENT_BARRIER also never coalesces, and events
+// queued before it no longer absorb later duplicates, so "start, stop,
+// start" keeps both starts.
+//
+// Several threads: the owning thread calls OpenLanes(n) and each producer
+// binds a LaneScope for a lane index it was given (typically its
+// ParallelFor index).  Pushes on that thread go to the lane's private
+// buffer.  MergeLanes() then appends lane 0, 1, ... n-1 onto the queue,
+// coalescing as it goes, so the result depends on the lane indices and not
+// on which thread ran first.
 // ---------------------------------------------------------------------------
 
-template<typename TEvent, int Capacity>
+constexpr uint64_t SIM_EVENT_BARRIER = ~0ULL;
+
+template<typename TEvent>
 class SimEventQueue
 {
 public:
+  struct Stats
+  {
+    int     m_peakDepth = 0;    // Most events queued at once
+    int64_t m_dropped = 0;      // Lost to MaxEvents
+    int64_t m_coalesced = 0;    // Absorbed by an identical queued event
+  };
+
+  class LaneScope;
+
+  explicit SimEventQueue(int _reserve = 1024, int _maxEvents = 65536)
+    : m_maxEvents(_maxEvents)
+  {
+    m_main.m_events.reserve(_reserve);
+  }
+
+  SimEventQueue(const SimEventQueue&) = delete;
+  SimEventQueue& operator=(const SimEventQueue&) = delete;
+
   void Push(const TEvent& _event)
   {
-    DEBUG_ASSERT(m_count < Capacity); // Overflow diagnostic in debug builds
-    if (m_count < Capacity)
+    Buffer* lane = t_lane.m_owner == this ? t_lane.m_buffer : nullptr;
+    if (lane)
+      Append(*lane, _event, m_maxEvents, lane->m_stats);
+    else
     {
-      m_events[m_count] = _event;
-      ++m_count;
+      Append(m_main, _event, m_maxEvents, m_stats);
+      m_stats.m_peakDepth = std::max(m_stats.m_peakDepth, Count());
     }
   }
 
-  int Count() const { return m_count; }
+  int Count() const { return static_cast<int>(m_main.m_events.size()); }
 
   const TEvent& Get(int _index) const
   {
-    DEBUG_ASSERT(_index >= 0 && _index < m_count);
-    return m_events[_index];
+    DEBUG_ASSERT(_index >= 0 && _index < Count());
+    return m_main.m_events[_index];
+  }
+
+  void Clear() { m_main.Reset(); }
+
+  // Owning thread only, outside any parallel section
+  void OpenLanes(int _numLanes)
+  {
+    DEBUG_ASSERT(m_numOpenLanes == 0);
+    if (static_cast<int>(m_lanes.size()) < _numLanes)
+      m_lanes.resize(_numLanes);
+    m_numOpenLanes = _numLanes;
+  }
+
+  void MergeLanes()
+  {
+    for (int i = 0; i < m_numOpenLanes; ++i)
+    {
+      Buffer& lane = m_lanes[i];
+      m_stats.m_dropped += lane.m_stats.m_dropped;
+      m_stats.m_coalesced += lane.m_stats.m_coalesced;
+      for (const TEvent& event : lane.m_events)
+        Append(m_main, event, m_maxEvents, m_stats);
+      lane.Reset();
+      lane.m_stats = {};
+    }
+    m_numOpenLanes = 0;
+    m_stats.m_peakDepth = std::max(m_stats.m_peakDepth, Count());
   }
 
-  void Clear() { m_count = 0; }
+  [[nodiscard]] const Stats& GetStats() const { return m_stats; }
+  void ResetStats() { m_stats = {}; }
+
+private:
+  struct Slot
+  {
+    uint64_t m_key;
+    int      m_index;   // Event the key belongs to
+    uint32_t m_stamp;   // Slot is live only when this matches Buffer::m_stamp
+  };
+
+  struct Buffer
+  {
+    std::vector<TEvent> m_events;
+    std::vector<Slot>   m_slots;        // Open addressing, power-of-two size
+    uint32_t            m_stamp = 1;
+    int                 m_numKeys = 0;
+    int                 m_barrier = 0;  // Events before this index no longer coalesce
+    Stats               m_stats;        // Lanes only; folded in by MergeLanes
+
+    void Reset()
+    {
+      m_events.clear();
+      m_numKeys = 0;
+      m_barrier = 0;
+      if (++m_stamp == 0)
+      {
+        std::ranges::fill(m_slots, Slot{});
+        m_stamp = 1;
+      }
+    }
+  };
+
+  struct LaneBinding
+  {
+    const SimEventQueue* m_owner = nullptr;
+    Buffer*              m_buffer = nullptr;
+  };
+
+  static void Append(Buffer& _buffer, const TEvent& _event, int _maxEvents, Stats& _stats)
+  {
+    const uint64_t key = _event.CoalesceKey();
+    const int index = static_cast<int>(_buffer.m_events.size());
+
+    Slot* slot = nullptr;
+    if (key != 0 && key != SIM_EVENT_BARRIER)
+    {
+      slot = FindSlot(_buffer, key);
+      if (slot->m_stamp == _buffer.m_stamp && slot->m_index >= _buffer.m_barrier)
+      {
+        ++_stats.m_coalesced;
+        return;
+      }
+    }
+
+    if (index >= _maxEvents)
+    {
+      ++_stats.m_dropped;
+      return;
+    }
+
+    if (key == SIM_EVENT_BARRIER)
+      _buffer.m_barrier = index;
+    else if (slot)
+    {
+      if (slot->m_stamp != _buffer.m_stamp)
+        ++_buffer.m_numKeys;
+      *slot = {key, index, _buffer.m_stamp};
+    }
+    _buffer.m_events.push_back(_event);
+  }
+
+  // The slot holding _key, or the empty slot it would go in
+  static Slot* FindSlot(Buffer& _buffer, uint64_t _key)
+  {
+    if ((_buffer.m_numKeys + 1) * 2 > static_cast<int>(_buffer.m_slots.size()))
+      Grow(_buffer);
+
+    const size_t mask = _buffer.m_slots.size() - 1;
+    for (size_t i = static_cast<size_t>(_key ^ (_key >> 29)) & mask;; i = (i + 1) & mask)
+    {
+      Slot& slot = _buffer.m_slots[i];
+      if (slot.m_stamp != _buffer.m_stamp || slot.m_key == _key)
+        return &slot;
+    }
+  }
+
+  static void Grow(Buffer& _buffer)
+  {
+    std::vector<Slot> old = std::move(_buffer.m_slots);
+    _buffer.m_slots.assign(std::max<size_t>(64, old.size() * 2), Slot{});
+    const uint32_t stamp = _buffer.m_stamp;
+    _buffer.m_stamp = 1;
+    _buffer.m_numKeys = 0;
+
+    for (const Slot& slot : old)
+    {
+      if (slot.m_stamp != stamp)
+        continue;
+      Slot* moved = FindSlot(_buffer, slot.m_key);
+      *moved = {slot.m_key, slot.m_index, 1};
+      ++_buffer.m_numKeys;
+    }
+  }
+
+  inline static thread_local LaneBinding t_lane;
+
+  Buffer              m_main;
+  std::vector<Buffer> m_lanes;
+  int                 m_numOpenLanes = 0;
+  int                 m_maxEvents;
+  Stats               m_stats;
+};
+
+// Routes this thread's Push() calls on _queue to lane _lane until destroyed
+template<typename TEvent>
+class SimEventQueue<TEvent>::LaneScope
+{
+public:
+  LaneScope(SimEventQueue& _queue, int _lane)
+    : m_previous(t_lane)
+  {
+    DEBUG_ASSERT(_lane >= 0 && _lane < _queue.m_numOpenLanes);
+    t_lane = {&_queue, &_queue.m_lanes[_lane]};
+  }
+
+  ~LaneScope() { t_lane = m_previous; }
+
+  LaneScope(const LaneScope&) = delete;
+  LaneScope& operator=(const LaneScope&) = delete;
 
 private:
-  TEvent m_events[Capacity] = {};
-  int    m_count = 0;
+  LaneBinding m_previous;
 };
@@ -0,0 +1,81 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// SlotTypeLists
+//
+// For an array whose slots hold objects of several types, the slots holding
+// each type in ascending order.  A pass over one type walks its list instead
+// of every slot, and still visits them in the order a loop over the array
+// would, which matters wherever that pass draws sync random numbers.
+//
+// Add and Remove keep the lists sorted, so they cost a binary search and a
+// move of the slots after the one changed; both are rare next to the passes.
+// Removing a slot that was never added does nothing.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class SlotTypeLists
+  {
+    public:
+      explicit SlotTypeLists(int _numTypes = 0)
+        : m_slots(_numTypes) {}
+
+      void Add(int _type, int _slot)
+      {
+        DEBUG_ASSERT(_type >= 0 && _type < GetNumTypes());
+        DEBUG_ASSERT(_slot >= 0);
+        if (_slot >= static_cast<int>(m_typeOfSlot.size()))
+          m_typeOfSlot.resize(_slot + 1, NO_TYPE);
+        if (m_typeOfSlot[_slot] == _type)
+          return;
+        Remove(_slot);
+
+        m_typeOfSlot[_slot] = _type;
+        std::vector<int>& slots = m_slots[_type];
+        slots.insert(std::lower_bound(slots.begin(), slots.end(), _slot), _slot);
+      }
+
+      void Remove(int _slot)
+      {
+        if (_slot < 0 || _slot >= static_cast<int>(m_typeOfSlot.size()) || m_typeOfSlot[_slot] == NO_TYPE)
+          return;
+
+        std::vector<int>& slots = m_slots[m_typeOfSlot[_slot]];
+        const auto it = std::lower_bound(slots.begin(), slots.end(), _slot);
+        DEBUG_ASSERT(it != slots.end() && *it == _slot);
+        slots.erase(it);
+        m_typeOfSlot[_slot] = NO_TYPE;
+      }
+
+      void Clear()
+      {
+        for (std::vector<int>& slots : m_slots)
+          slots.clear();
+        m_typeOfSlot.clear();
+      }
+
+      // Ascending
+      [[nodiscard]] const std::vector<int>& GetSlots(int _type) const
+      {
+        DEBUG_ASSERT(_type >= 0 && _type < GetNumTypes());
+        return m_slots[_type];
+      }
+
+      [[nodiscard]] int Count(int _type) const { return static_cast<int>(GetSlots(_type).size()); }
+
+      // -1 if the slot holds nothing
+      [[nodiscard]] int GetType(int _slot) const
+      {
+        return _slot >= 0 && _slot < static_cast<int>(m_typeOfSlot.size()) ? m_typeOfSlot[_slot] : NO_TYPE;
+      }
+
+      [[nodiscard]] int GetNumTypes() const noexcept { return static_cast<int>(m_slots.size()); }
+
+    private:
+      static constexpr int NO_TYPE = -1;
+
+      std::vector<std::vector<int>> m_slots;
+      std::vector<int>              m_typeOfSlot;
+  };
+}
@@ -0,0 +1,263 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// SnapshotWriter / SnapshotReader / SnapshotAssembler
+//
+// Binary serialisation of simulation state for late-join catch-up.
+//
+// SnapshotWriter appends to a growable byte buffer.  State is grouped into
+// tagged sections, each prefixed with its length, so a reader can skip
+// sections it does not understand.  Values are written in native byte order;
+// snapshots are only exchanged between builds of the same game.
+//
+// SnapshotReader never reads past its buffer.  A read that would overrun sets
+// Overflowed() and returns zero, like BitReader; callers check the flag once
+// at the end rather than after every field.
+//
+// SnapshotAssembler collects the parts a snapshot was split into for
+// transport, in any order and with duplicates, and yields the whole buffer
+// once every part has arrived.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  // Four characters packed into a section tag, e.g. SnapshotTag("TEAM")
+  [[nodiscard]] constexpr uint32_t SnapshotTag(const char (&_name)[5]) noexcept
+  {
+    return static_cast<uint32_t>(static_cast<uint8_t>(_name[0])) |
+      (static_cast<uint32_t>(static_cast<uint8_t>(_name[1])) << 8) |
+      (static_cast<uint32_t>(static_cast<uint8_t>(_name[2])) << 16) |
+      (static_cast<uint32_t>(static_cast<uint8_t>(_name[3])) << 24);
+  }
+
+  class SnapshotWriter
+  {
+    public:
+      template <typename T>
+      void Write(const T& _value)
+      {
+        static_assert(std::is_trivially_copyable_v<T>);
+        WriteBytes(&_value, sizeof(T));
+      }
+
+      void WriteBytes(const void* _data, int _size)
+      {
+        const auto* bytes = static_cast<const uint8_t*>(_data);
+        m_data.insert(m_data.end(), bytes, bytes + _size);
+      }
+
+      // 7 bits per group plus a continuation bit, as BitWriter::WriteVarUInt
+      void WriteVarUInt(uint32_t _value)
+      {
+        while (_value >= 0x80)
+        {
+          m_data.push_back(static_cast<uint8_t>((_value & 0x7f) | 0x80));
+          _value >>= 7;
+        }
+        m_data.push_back(static_cast<uint8_t>(_value));
+      }
+
+      // Element count for a loop ReadCount reads back
+      void WriteCount(int _count) { WriteVarUInt(static_cast<uint32_t>(_count)); }
+
+      void WriteString(const char* _string)
+      {
+        const int length = _string ? static_cast<int>(strlen(_string)) : 0;
+        WriteVarUInt(static_cast<uint32_t>(length));
+        WriteBytes(_string, length);
+      }
+
+      // Returns a handle to pass to EndSection once the section's contents are written
+      int BeginSection(uint32_t _tag)
+      {
+        Write(_tag);
+        const int lengthOffset = Size();
+        Write(0);
+        return lengthOffset;
+      }
+
+      void EndSection(int _lengthOffset)
+      {
+        const int length = Size() - _lengthOffset - static_cast<int>(sizeof(int));
+        std::memcpy(m_data.data() + _lengthOffset, &length, sizeof(length));
+      }
+
+      [[nodiscard]] const uint8_t* GetData() const noexcept { return m_data.data(); }
+      [[nodiscard]] int Size() const noexcept { return static_cast<int>(m_data.size()); }
+
+    private:
+      std::vector<uint8_t> m_data;
+  };
+
+  class SnapshotReader
+  {
+    public:
+      SnapshotReader() noexcept = default;
+
+      SnapshotReader(const void* _data, int _size) noexcept
+        : m_data(static_cast<const uint8_t*>(_data)),
+          m_size(_size) {}
+
+      template <typename T>
+      T Read() noexcept
+      {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        ReadBytes(&value, sizeof(T));
+        return value;
+      }
+
+      // Also accepts fixed-size arrays
+      template <typename T>
+      void Read(T& _value) noexcept
+      {
+        static_assert(std::is_trivially_copyable_v<T>);
+        ReadBytes(&_value, sizeof(T));
+      }
+
+      void ReadBytes(void* _out, int _size) noexcept
+      {
+        if (m_overflow || _size > m_size - m_pos)
+        {
+          m_overflow = true;
+          std::memset(_out, 0, _size);
+          return;
+        }
+        std::memcpy(_out, m_data + m_pos, _size);
+        m_pos += _size;
+      }
+
+      uint32_t ReadVarUInt() noexcept
+      {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+          const uint8_t group = Read<uint8_t>();
+          result |= static_cast<uint32_t>(group & 0x7f) << shift;
+          if ((group & 0x80) == 0)
+            return result;
+        }
+        m_overflow = true; // Malformed: more than five groups
+        return 0;
+      }
+
+      // A count of elements that take at least a byte each.  A count the rest
+      // of the buffer cannot hold sets Overflowed() and returns 0, so a
+      // corrupt count never drives a long loop or a huge allocation.
+      int ReadCount() noexcept
+      {
+        const uint32_t count = ReadVarUInt();
+        if (m_overflow || count > static_cast<uint32_t>(m_size - m_pos))
+        {
+          m_overflow = true;
+          return 0;
+        }
+        return static_cast<int>(count);
+      }
+
+      // Copies at most _capacity - 1 characters and always terminates _out
+      void ReadString(char* _out, int _capacity) noexcept
+      {
+        const int length = static_cast<int>(ReadVarUInt());
+        if (m_overflow || length > m_size - m_pos)
+        {
+          m_overflow = true;
+          _out[0] = '\0';
+          return;
+        }
+        const int copied = std::min(length, _capacity - 1);
+        std::memcpy(_out, m_data + m_pos, copied);
+        _out[copied] = '\0';
+        m_pos += length;
+      }
+
+      // Reads the next section header and returns a reader over its contents.
+      // Returns false at the end of the buffer or if the section is truncated.
+      bool NextSection(uint32_t* _tag, SnapshotReader* _section) noexcept
+      {
+        if (m_overflow || m_pos == m_size)
+          return false;
+
+        *_tag = Read<uint32_t>();
+        const int length = Read<int>();
+        if (m_overflow || length < 0 || length > m_size - m_pos)
+        {
+          m_overflow = true;
+          return false;
+        }
+
+        *_section = SnapshotReader(m_data + m_pos, length);
+        m_pos += length;
+        return true;
+      }
+
+      // For data that reads cleanly but does not make sense: fails this read
+      // and every one after it, as an overrun does
+      void Invalidate() noexcept { m_overflow = true; }
+
+      [[nodiscard]] int BytesRemaining() const noexcept { return m_size - m_pos; }
+      [[nodiscard]] bool Overflowed() const noexcept { return m_overflow; }
+
+    private:
+      const uint8_t* m_data = nullptr;
+      int m_size = 0;
+      int m_pos = 0;
+      bool m_overflow = false;
+  };
+
+  class SnapshotAssembler
+  {
+    public:
+      // Returns true when this part completes the snapshot.  A part from a
+      // different snapshot id discards whatever was collected so far.
+      bool AddPart(int _snapshotId, int _part, int _numParts, const void* _data, int _size)
+      {
+        if (_numParts <= 0 || _part < 0 || _part >= _numParts || _size < 0)
+          return false;
+
+        if (_snapshotId != m_snapshotId || _numParts != static_cast<int>(m_parts.size()))
+        {
+          Reset();
+          m_snapshotId = _snapshotId;
+          m_parts.resize(_numParts);
+          m_received.assign(_numParts, false);
+        }
+
+        if (m_received[_part] || IsComplete())
+          return false;
+
+        const auto* bytes = static_cast<const uint8_t*>(_data);
+        m_parts[_part].assign(bytes, bytes + _size);
+        m_received[_part] = true;
+        if (++m_numReceived < _numParts)
+          return false;
+
+        for (const std::vector<uint8_t>& part : m_parts)
+          m_data.insert(m_data.end(), part.begin(), part.end());
+        m_parts.assign(m_parts.size(), {});
+        return true;
+      }
+
+      void Reset()
+      {
+        m_snapshotId = -1;
+        m_numReceived = 0;
+        m_parts.clear();
+        m_received.clear();
+        m_data.clear();
+      }
+
+      [[nodiscard]] bool IsComplete() const noexcept { return m_numReceived > 0 && m_numReceived == static_cast<int>(m_parts.size()); }
+      [[nodiscard]] int GetSnapshotId() const noexcept { return m_snapshotId; }
+      [[nodiscard]] int GetNumReceived() const noexcept { return m_numReceived; }
+      [[nodiscard]] const uint8_t* GetData() const noexcept { return m_data.data(); }
+      [[nodiscard]] int Size() const noexcept { return static_cast<int>(m_data.size()); }
+
+    private:
+      int m_snapshotId = -1;
+      int m_numReceived = 0;
+      std::vector<std::vector<uint8_t>> m_parts;
+      std::vector<bool> m_received;
+      std::vector<uint8_t> m_data;
+  };
+}
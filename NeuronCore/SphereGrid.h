@@ -0,0 +1,297 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// SphereGrid
+//
+// Uniform grid over the x and z of a set of spheres, for ray picking.  The
+// world is a height field, so like EntityGrid it ignores y when bucketing.
+// A query returns the spheres an infinite line might pass through, so a pick
+// only has to run its exact ray-sphere test on those instead of on every
+// object.  Building is a counting sort, cheap enough to redo whenever the
+// spheres move.
+//
+// The grid only culls.  The line is widened by the rounding the caller's
+// ray-sphere test can make (it measures the miss distance as the difference
+// of two large squares), so a sphere is skipped only when the line clearly
+// misses it.  Spheres with a non-finite centre or radius stand for objects
+// with no usable bound, and spheres much bigger than a cell would widen
+// every query; both are visited by every query rather than bucketed.  A
+// query with a non-finite line visits every sphere.  Either way the caller
+// sees every hit a loop over all the spheres would find, though not in index
+// order.
+//
+// Vectors are anything with x, y and z members.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class SphereGrid
+  {
+    public:
+      struct Sphere
+      {
+        float x, y, z;
+        float radius;
+      };
+
+      // _sphere(int _item) returns the bounding Sphere of an item
+      template <typename TSphere>
+      void Build(int _numItems, TSphere&& _sphere)
+      {
+        Clear();
+        m_numItems = _numItems;
+
+        m_spheres.resize(_numItems);   // Every element is written below
+        float lo[2] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+        float hi[2] = {-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+        int numFinite = 0;
+        for (int i = 0; i < _numItems; ++i)
+        {
+          Sphere& s = m_spheres[i];
+          s = _sphere(i);
+          if (!std::isfinite(s.x) || !std::isfinite(s.y) || !std::isfinite(s.z) || !std::isfinite(s.radius))
+          {
+            m_unbounded.push_back(i);
+            continue;
+          }
+
+          // The exact tests square the radius, so a negative one reaches as far
+          s.radius = std::abs(s.radius);
+          lo[0] = std::min(lo[0], s.x);
+          hi[0] = std::max(hi[0], s.x);
+          lo[1] = std::min(lo[1], s.z);
+          hi[1] = std::max(hi[1], s.z);
+          ++numFinite;
+        }
+
+        if (numFinite == 0)
+          return;
+
+        // About CELL_OCCUPANCY centres to a cell, within MAX_CELLS_PER_ITEM
+        // cells per sphere however the centres are spread
+        const float width = std::max(hi[0] - lo[0], MIN_CELL_SIZE);
+        const float depth = std::max(hi[1] - lo[1], MIN_CELL_SIZE);
+        float cellSize = std::sqrt(width * depth * CELL_OCCUPANCY / static_cast<float>(numFinite));
+        cellSize = std::max({cellSize, MIN_CELL_SIZE, std::sqrt(width * depth / (MAX_CELLS_PER_ITEM * static_cast<float>(numFinite)))});
+
+        m_cellSize = cellSize;
+        m_cellSizeRecip = 1.0f / cellSize;
+        m_originX = lo[0];
+        m_originZ = lo[1];
+        m_numCellsX = static_cast<int>(width * m_cellSizeRecip) + 1;
+        m_numCellsZ = static_cast<int>(depth * m_cellSizeRecip) + 1;
+        m_minY = std::numeric_limits<float>::max();
+        m_maxY = -std::numeric_limits<float>::max();
+
+        //
+        // Counting sort by cell
+
+        m_cellStart.assign(m_numCellsX * m_numCellsZ + 1, 0);
+        m_itemCell.assign(_numItems, -1);
+        for (int i = 0; i < _numItems; ++i)
+        {
+          const Sphere& s = m_spheres[i];
+          if (!std::isfinite(s.x) || !std::isfinite(s.y) || !std::isfinite(s.z) || !std::isfinite(s.radius))
+            continue;
+          if (s.radius > cellSize * LARGE_RADIUS)
+          {
+            m_large.push_back(i);
+            continue;
+          }
+
+          m_maxRadius = std::max(m_maxRadius, s.radius);
+          m_minY = std::min(m_minY, s.y);
+          m_maxY = std::max(m_maxY, s.y);
+          const int cell = CellIndex(s.x, s.z);
+          m_itemCell[i] = cell;
+          ++m_cellStart[cell + 1];
+        }
+
+        for (size_t c = 1; c < m_cellStart.size(); ++c)
+          m_cellStart[c] += m_cellStart[c - 1];
+
+        m_cellItems.resize(m_cellStart.back());
+        m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+        for (int i = 0; i < _numItems; ++i)
+        {
+          if (m_itemCell[i] != -1)
+            m_cellItems[m_cursor[m_itemCell[i]]++] = i;
+        }
+      }
+
+      void Clear()
+      {
+        m_cellStart.clear();
+        m_cellItems.clear();
+        m_unbounded.clear();
+        m_large.clear();
+        m_numItems = 0;
+        m_numCellsX = m_numCellsZ = 0;
+        m_maxRadius = 0.0f;
+      }
+
+      // _visit(int _item) for every sphere the infinite line through _origin
+      // along _dir might pass through
+      template <typename TVec, typename TVisit>
+      void ForEachNearLine(const TVec& _origin, const TVec& _dir, TVisit&& _visit) const
+      {
+        const float origin[3] = {_origin.x, _origin.y, _origin.z};
+        const float dir[3] = {_dir.x, _dir.y, _dir.z};
+        bool finite = true;
+        for (int k = 0; k < 3; ++k)
+          finite = finite && std::isfinite(origin[k]) && std::isfinite(dir[k]);
+        if (!finite)
+        {
+          for (int i = 0; i < m_numItems; ++i)
+            _visit(i);
+          return;
+        }
+
+        for (int item : m_unbounded)
+          _visit(item);
+        for (int item : m_large)
+          _visit(item);
+        if (m_cellItems.empty())
+          return;
+
+        // A ray-sphere test that takes the miss distance as |l|^2 - (l.d)^2
+        // is off by rounding in both squares, and by the whole of (l.d)^2
+        // times the error in |d|^2 when _dir is not quite unit length.  Both
+        // scale with |l|^2, so the line is widened in proportion to how far
+        // the grid reaches from its origin (|l| is at most sqrt(3) times the
+        // largest component of that; 2 covers it).
+        const float dirLengthSq = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
+        const float slack = std::sqrt(SLACK_RELATIVE_SQ + std::abs(dirLengthSq - 1.0f));
+        const float gridReach = std::max({std::abs(m_originX), std::abs(m_originZ), std::abs(m_originX + m_numCellsX * m_cellSize),
+                                          std::abs(m_originZ + m_numCellsZ * m_cellSize), std::abs(m_minY), std::abs(m_maxY)});
+        const float originReach = std::max({std::abs(origin[0]), std::abs(origin[1]), std::abs(origin[2])});
+        const float reach = m_maxRadius + 2.0f * (gridReach + originReach + m_maxRadius) * slack + PAD_ABSOLUTE;
+
+        //
+        // Clip the line to the box the bucketed centres lie in, widened by
+        // the reach: a sphere the line passes within reach of has its centre
+        // within reach of the clipped part in every axis
+
+        const float boxLo[3] = {m_originX - reach, m_minY - reach, m_originZ - reach};
+        const float boxHi[3] = {m_originX + m_numCellsX * m_cellSize + reach, m_maxY + reach, m_originZ + m_numCellsZ * m_cellSize + reach};
+        float tNear = -std::numeric_limits<float>::infinity();
+        float tFar = std::numeric_limits<float>::infinity();
+        for (int k = 0; k < 3; ++k)
+        {
+          if (dir[k] == 0.0f)
+          {
+            if (origin[k] < boxLo[k] || origin[k] > boxHi[k])
+              return;
+            continue;
+          }
+          const float t0 = (boxLo[k] - origin[k]) / dir[k];
+          const float t1 = (boxHi[k] - origin[k]) / dir[k];
+          tNear = std::max(tNear, std::min(t0, t1));
+          tFar = std::min(tFar, std::max(t0, t1));
+        }
+        if (tNear > tFar)
+          return;
+        if (!std::isfinite(tNear) || !std::isfinite(tFar))
+          tNear = tFar = 0.0f;   // A zero direction: the line is its origin
+
+        //
+        // Sweep the cells along the clipped segment's longer axis; in each
+        // column take the rows the segment passes through there, widened by
+        // the reach
+
+        const float a[2] = {origin[0] + dir[0] * tNear, origin[2] + dir[2] * tNear};
+        const float b[2] = {origin[0] + dir[0] * tFar, origin[2] + dir[2] * tFar};
+        const int major = std::abs(b[0] - a[0]) >= std::abs(b[1] - a[1]) ? 0 : 1;
+        const int minor = 1 - major;
+        const float gridOrigin[2] = {m_originX, m_originZ};
+        const int numCells[2] = {m_numCellsX, m_numCellsZ};
+        const float span = b[major] - a[major];
+
+        const float majorLo = std::min(a[major], b[major]) - reach;
+        const float majorHi = std::max(a[major], b[major]) + reach;
+        const int firstColumn = ClampCell((majorLo - gridOrigin[major]) * m_cellSizeRecip, numCells[major]);
+        const int lastColumn = ClampCell((majorHi - gridOrigin[major]) * m_cellSizeRecip, numCells[major]);
+        for (int column = firstColumn; column <= lastColumn; ++column)
+        {
+          // The part of the segment within reach of this column
+          const float columnLo = gridOrigin[major] + column * m_cellSize - reach;
+          const float columnHi = gridOrigin[major] + (column + 1) * m_cellSize + reach;
+          float s0 = 0.0f, s1 = 1.0f;
+          if (span != 0.0f)
+          {
+            s0 = (columnLo - a[major]) / span;
+            s1 = (columnHi - a[major]) / span;
+            if (s0 > s1)
+              std::swap(s0, s1);
+            s0 = std::max(s0, 0.0f);
+            s1 = std::min(s1, 1.0f);
+            if (s0 > s1)
+              continue;
+          }
+          const float m0 = a[minor] + (b[minor] - a[minor]) * s0;
+          const float m1 = a[minor] + (b[minor] - a[minor]) * s1;
+          const int firstRow = ClampCell((std::min(m0, m1) - reach - gridOrigin[minor]) * m_cellSizeRecip, numCells[minor]);
+          const int lastRow = ClampCell((std::max(m0, m1) + reach - gridOrigin[minor]) * m_cellSizeRecip, numCells[minor]);
+
+          for (int row = firstRow; row <= lastRow; ++row)
+          {
+            const int cell = major == 0 ? row * m_numCellsX + column : column * m_numCellsX + row;
+            for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i)
+              _visit(m_cellItems[i]);
+          }
+        }
+      }
+
+      [[nodiscard]] int GetNumItems() const noexcept { return m_numItems; }
+      [[nodiscard]] int GetNumCells() const noexcept { return m_numCellsX * m_numCellsZ; }
+      [[nodiscard]] int GetNumUnbounded() const noexcept { return static_cast<int>(m_unbounded.size()); }
+      [[nodiscard]] int GetNumLarge() const noexcept { return static_cast<int>(m_large.size()); }
+
+    private:
+      static constexpr float CELL_OCCUPANCY = 2.0f;
+      static constexpr float MAX_CELLS_PER_ITEM = 4.0f;
+      static constexpr float MIN_CELL_SIZE = 1.0f;
+
+      // Spheres with a radius over this many cells are visited by every query
+      static constexpr float LARGE_RADIUS = 1.0f;
+
+      // Relative rounding allowed in the caller's squared miss distance; its
+      // square root (about 3e-3) is the widening per unit of distance
+      static constexpr float SLACK_RELATIVE_SQ = 1.0e-5f;
+      static constexpr float PAD_ABSOLUTE = 1.0e-3f;
+
+      [[nodiscard]] int CellIndex(float _x, float _z) const noexcept
+      {
+        const int x = ClampCell((_x - m_originX) * m_cellSizeRecip, m_numCellsX);
+        const int z = ClampCell((_z - m_originZ) * m_cellSizeRecip, m_numCellsZ);
+        return z * m_numCellsX + x;
+      }
+
+      static int ClampCell(float _cell, int _numCells) noexcept
+      {
+        if (!(_cell > 0.0f))
+          return 0;
+        if (_cell >= static_cast<float>(_numCells - 1))
+          return _numCells - 1;
+        return static_cast<int>(_cell);
+      }
+
+      std::vector<Sphere> m_spheres;      // Build scratch, not cleared so that an unchanged count costs nothing to size
+      std::vector<int>    m_itemCell;     // Build scratch
+      std::vector<int>    m_cursor;       // Build scratch
+      std::vector<int>    m_cellStart;    // m_cellItems range of cell c is [m_cellStart[c], m_cellStart[c + 1])
+      std::vector<int>    m_cellItems;
+      std::vector<int>    m_unbounded;    // Never culled
+      std::vector<int>    m_large;        // Never culled
+      int                 m_numItems = 0;
+      int                 m_numCellsX = 0;
+      int                 m_numCellsZ = 0;
+      float               m_cellSize = 1.0f;
+      float               m_cellSizeRecip = 1.0f;
+      float               m_originX = 0.0f;
+      float               m_originZ = 0.0f;
+      float               m_minY = 0.0f;
+      float               m_maxY = 0.0f;
+      float               m_maxRadius = 0.0f;   // Of the bucketed spheres
+  };
+}
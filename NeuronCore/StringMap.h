@@ -0,0 +1,289 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// StringMap
+//
+// A hash map from strings to T, case ignored (ASCII), for the name tables
+// that sit under the profiler, preferences, language and resource lookups.
+//
+// Values live packed in one array, in insertion order until something is
+// erased (the last entry then moves into the hole).  The table itself is a
+// power-of-two array of 8 byte slots, each a 32 bit hash and an entry
+// index, probed linearly; a probe reads slots until the hash matches and
+// only then compares the key.  Erase shifts the run after the slot back,
+// so there are no tombstones and a table never degrades.  It grows by
+// doubling at three quarters full, without limit.
+//
+// Lookups take a StringKey, which any string converts to.  Building the
+// key hashes it, so a caller that asks about the same name more than once
+// can build the key once and pass that; a constexpr StringKey hashes at
+// compile time.  Entries keep their hash, so growing does not rehash keys.
+//
+// Pointers and references to values are good until the next insert or
+// erase.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class StringKey
+  {
+    public:
+      constexpr StringKey(std::string_view _text) noexcept
+        : m_text(_text),
+          m_hash(Hash(_text)) {}
+
+      constexpr StringKey(const char* _text) noexcept
+        : StringKey(std::string_view(_text)) {}
+
+      StringKey(const std::string& _text) noexcept
+        : StringKey(std::string_view(_text)) {}
+
+      [[nodiscard]] constexpr std::string_view GetText() const noexcept { return m_text; }
+      [[nodiscard]] constexpr uint32_t GetHash() const noexcept { return m_hash; }
+
+      // Never zero, so that a table can use zero for an empty slot
+      [[nodiscard]] static constexpr uint32_t Hash(std::string_view _text) noexcept
+      {
+        // FNV-1a over the lowered bytes, then a finaliser so that the low
+        // bits, which pick the slot, depend on every byte
+        uint32_t hash = 2166136261u;
+        for (const char c : _text)
+        {
+          hash ^= static_cast<uint8_t>(Lower(c));
+          hash *= 16777619u;
+        }
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        hash *= 0xc2b2ae35u;
+        hash ^= hash >> 16;
+        return hash | 0x80000000u;
+      }
+
+      [[nodiscard]] static constexpr bool Equal(std::string_view _a, std::string_view _b) noexcept
+      {
+        if (_a.size() != _b.size())
+          return false;
+        for (size_t i = 0; i < _a.size(); ++i)
+        {
+          if (Lower(_a[i]) != Lower(_b[i]))
+            return false;
+        }
+        return true;
+      }
+
+      // As _stricmp: negative, zero or positive
+      [[nodiscard]] static constexpr int Compare(std::string_view _a, std::string_view _b) noexcept
+      {
+        const size_t count = std::min(_a.size(), _b.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+          const int diff = static_cast<uint8_t>(Lower(_a[i])) - static_cast<uint8_t>(Lower(_b[i]));
+          if (diff != 0)
+            return diff;
+        }
+        return _a.size() < _b.size() ? -1 : _a.size() > _b.size() ? 1 : 0;
+      }
+
+    private:
+      [[nodiscard]] static constexpr char Lower(char _c) noexcept { return _c >= 'A' && _c <= 'Z' ? static_cast<char>(_c - 'A' + 'a') : _c; }
+
+      std::string_view m_text;
+      uint32_t         m_hash;
+  };
+
+  template <typename T>
+  class StringMap
+  {
+    public:
+      [[nodiscard]] T* Find(const StringKey& _key) noexcept
+      {
+        const int slot = FindSlot(_key);
+        return slot < 0 ? nullptr : &m_entries[m_slots[slot].m_entry].m_value;
+      }
+
+      [[nodiscard]] const T* Find(const StringKey& _key) const noexcept
+      {
+        const int slot = FindSlot(_key);
+        return slot < 0 ? nullptr : &m_entries[m_slots[slot].m_entry].m_value;
+      }
+
+      // The value under _key, or _default if there is none
+      [[nodiscard]] T Get(const StringKey& _key, const T& _default = T{}) const
+      {
+        const T* value = Find(_key);
+        return value ? *value : _default;
+      }
+
+      [[nodiscard]] bool Contains(const StringKey& _key) const noexcept { return FindSlot(_key) >= 0; }
+
+      // Adds T(_args...) under _key unless _key is already present.  Returns
+      // the value under _key and whether it was added.
+      template <typename... TArgs>
+      std::pair<T*, bool> TryEmplace(const StringKey& _key, TArgs&&... _args)
+      {
+        if (T* value = Find(_key))
+          return {value, false};
+
+        if ((static_cast<size_t>(m_entries.size()) + 1) * 4 > m_slots.size() * 3)
+          Rehash(std::max<size_t>(MIN_SLOTS, m_slots.size() * 2));
+
+        m_entries.push_back({std::string(_key.GetText()), _key.GetHash(), T(std::forward<TArgs>(_args)...)});
+        PlaceEntry(static_cast<int>(m_entries.size()) - 1);
+        return {&m_entries.back().m_value, true};
+      }
+
+      T& InsertOrAssign(const StringKey& _key, T _value)
+      {
+        auto [value, isNew] = TryEmplace(_key, std::move(_value));
+        if (!isNew)
+          *value = std::move(_value);
+        return *value;
+      }
+
+      // Returns whether _key was present
+      bool Erase(const StringKey& _key)
+      {
+        int slot = FindSlot(_key);
+        if (slot < 0)
+          return false;
+
+        // Move the last entry into the hole and repoint its slot
+        const int entry = m_slots[slot].m_entry;
+        const int last = static_cast<int>(m_entries.size()) - 1;
+        if (entry != last)
+        {
+          m_entries[entry] = std::move(m_entries[last]);
+          int lastSlot = static_cast<int>(m_entries[entry].m_hash & m_mask);
+          while (m_slots[lastSlot].m_entry != last)
+            lastSlot = (lastSlot + 1) & m_mask;
+          m_slots[lastSlot].m_entry = entry;
+        }
+        m_entries.pop_back();
+
+        // Shift back every slot in the run that would be reachable from
+        // its home slot through the hole
+        for (int next = (slot + 1) & m_mask; m_slots[next].m_hash != 0; next = (next + 1) & m_mask)
+        {
+          const int home = static_cast<int>(m_slots[next].m_hash & m_mask);
+          if (((next - home) & m_mask) >= ((next - slot) & m_mask))
+          {
+            m_slots[slot] = m_slots[next];
+            slot = next;
+          }
+        }
+        m_slots[slot] = {};
+        return true;
+      }
+
+      void Clear() noexcept
+      {
+        m_entries.clear();
+        std::ranges::fill(m_slots, Slot{});
+      }
+
+      // Deletes every value, then clears; for maps that own what they point at
+      void ClearAndDelete() requires std::is_pointer_v<T>
+      {
+        for (Entry& entry : m_entries)
+          delete entry.m_value;
+        Clear();
+      }
+
+      void Reserve(int _count)
+      {
+        size_t slots = MIN_SLOTS;
+        while (slots * 3 < static_cast<size_t>(_count) * 4)
+          slots *= 2;
+        if (slots > m_slots.size())
+          Rehash(slots);
+        m_entries.reserve(_count);
+      }
+
+      // _visit(std::string_view _key, T& _value) for every entry, in no
+      // particular order.  _visit must not insert or erase.
+      template <typename TVisit>
+      void ForEach(TVisit&& _visit)
+      {
+        for (Entry& entry : m_entries)
+          _visit(std::string_view(entry.m_key), entry.m_value);
+      }
+
+      template <typename TVisit>
+      void ForEach(TVisit&& _visit) const
+      {
+        for (const Entry& entry : m_entries)
+          _visit(std::string_view(entry.m_key), entry.m_value);
+      }
+
+      // As ForEach, in key order, case ignored
+      template <typename TVisit>
+      void ForEachSorted(TVisit&& _visit) const
+      {
+        std::vector<const Entry*> sorted;
+        sorted.reserve(m_entries.size());
+        for (const Entry& entry : m_entries)
+          sorted.push_back(&entry);
+        std::ranges::sort(sorted, [](const Entry* _a, const Entry* _b) { return StringKey::Compare(_a->m_key, _b->m_key) < 0; });
+
+        for (const Entry* entry : sorted)
+          _visit(std::string_view(entry->m_key), entry->m_value);
+      }
+
+      [[nodiscard]] int Count() const noexcept { return static_cast<int>(m_entries.size()); }
+      [[nodiscard]] bool IsEmpty() const noexcept { return m_entries.empty(); }
+      [[nodiscard]] int GetNumSlots() const noexcept { return static_cast<int>(m_slots.size()); }
+
+    private:
+      static constexpr size_t MIN_SLOTS = 8;
+
+      struct Slot
+      {
+        uint32_t m_hash = 0;   // Zero if empty
+        int32_t  m_entry = -1;
+      };
+
+      struct Entry
+      {
+        std::string m_key;
+        uint32_t    m_hash;
+        T           m_value;
+      };
+
+      [[nodiscard]] int FindSlot(const StringKey& _key) const noexcept
+      {
+        if (m_entries.empty())
+          return -1;
+
+        for (int slot = static_cast<int>(_key.GetHash() & m_mask);; slot = (slot + 1) & m_mask)
+        {
+          const Slot& s = m_slots[slot];
+          if (s.m_hash == 0)
+            return -1;
+          if (s.m_hash == _key.GetHash() && StringKey::Equal(m_entries[s.m_entry].m_key, _key.GetText()))
+            return slot;
+        }
+      }
+
+      void PlaceEntry(int _entry)
+      {
+        const uint32_t hash = m_entries[_entry].m_hash;
+        int slot = static_cast<int>(hash & m_mask);
+        while (m_slots[slot].m_hash != 0)
+          slot = (slot + 1) & m_mask;
+        m_slots[slot] = {hash, _entry};
+      }
+
+      void Rehash(size_t _numSlots)
+      {
+        m_slots.assign(_numSlots, Slot{});
+        m_mask = static_cast<int>(_numSlots) - 1;
+        for (int i = 0; i < static_cast<int>(m_entries.size()); ++i)
+          PlaceEntry(i);
+      }
+
+      std::vector<Slot>  m_slots;
+      std::vector<Entry> m_entries;
+      int                m_mask = 0;
+  };
+}
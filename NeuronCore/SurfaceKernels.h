@@ -0,0 +1,114 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// SurfaceKernels
+//
+// Bilinear lookups into a grid of floats, four points at a time, giving
+// exactly what SurfaceMap2D<float>::GetValue gives for each point.  That
+// means copying its quirks as well as its arithmetic: cell indices are the
+// low 16 bits of the truncated coordinate, the far neighbour wraps at 16
+// bits, and any index off the grid becomes 0.  The weights are multiplied
+// and summed separately and in the same order as GetValue, never fused.
+//
+// A tail of fewer than four points is padded out and run through the same
+// four-wide code, so every point takes one path whatever the count.
+// ---------------------------------------------------------------------------
+
+namespace Neuron::Surface
+{
+  struct Grid
+  {
+    const float* m_data = nullptr; // m_numColumns * m_numRows, rows of x
+    int m_numColumns = 0;
+    int m_numRows = 0;
+    float m_x0 = 0.0f;
+    float m_y0 = 0.0f;
+    float m_invCellSizeX = 0.0f;
+    float m_invCellSizeY = 0.0f;
+  };
+
+  // As floorf: exact, keeps the sign of zero and passes NaN through.  The
+  // SSE2 path of XMVectorFloor turns -0 into +0, which shows in the result
+  // when a coordinate of -0 meets samples of -0.
+  [[nodiscard]] inline XMVECTOR XM_CALLCONV Floor(FXMVECTOR _v)
+  {
+    const XMVECTOR truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(_v));
+    XMVECTOR floor = XMVectorSubtract(truncated, XMVectorSelect(XMVectorZero(), XMVectorSplatOne(), XMVectorGreater(truncated, _v)));
+    floor = XMVectorOrInt(floor, XMVectorAndInt(_v, g_XMNegativeZero));
+    return XMVectorSelect(_v, floor, XMVectorLess(XMVectorAbs(_v), XMVectorReplicate(8388608.0f)));
+  }
+
+  // The first index along one axis and its neighbour, each 0 if off the grid
+  inline void XM_CALLCONV CellIndices(FXMVECTOR _fractional, int _size, int32_t* _first, int32_t* _second)
+  {
+    const __m128i low16 = _mm_set1_epi32(0xFFFF);
+    const __m128i size = _mm_set1_epi32(_size);
+    const __m128i first = _mm_and_si128(_mm_cvttps_epi32(_fractional), low16);
+    const __m128i second = _mm_and_si128(_mm_add_epi32(first, _mm_set1_epi32(1)), low16);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_first), _mm_and_si128(first, _mm_cmplt_epi32(first, size)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(_second), _mm_and_si128(second, _mm_cmplt_epi32(second, size)));
+  }
+
+  [[nodiscard]] inline XMVECTOR XM_CALLCONV Gather(const Grid& _grid, const int32_t* _x, const int32_t* _y)
+  {
+    const float* data = _grid.m_data;
+    const int columns = _grid.m_numColumns;
+    return XMVectorSet(data[_y[0] * columns + _x[0]], data[_y[1] * columns + _x[1]], data[_y[2] * columns + _x[2]],
+                       data[_y[3] * columns + _x[3]]);
+  }
+
+  inline void SampleBilinear4(const Grid& _grid, const float* _x, const float* _y, float* _out)
+  {
+    const XMVECTOR x = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(_x)), XMVectorReplicate(_grid.m_x0));
+    const XMVECTOR y = XMVectorSubtract(XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(_y)), XMVectorReplicate(_grid.m_y0));
+    XMVECTOR fx = XMVectorMultiply(x, XMVectorReplicate(_grid.m_invCellSizeX));
+    XMVECTOR fy = XMVectorMultiply(y, XMVectorReplicate(_grid.m_invCellSizeY));
+
+    int32_t x1[4], x2[4], y1[4], y2[4];
+    CellIndices(fx, _grid.m_numColumns, x1, x2);
+    CellIndices(fy, _grid.m_numRows, y1, y2);
+
+    fx = XMVectorSubtract(fx, Floor(fx));
+    fy = XMVectorSubtract(fy, Floor(fy));
+
+    const XMVECTOR v11 = Gather(_grid, x1, y1);
+    const XMVECTOR v12 = Gather(_grid, x1, y2);
+    const XMVECTOR v21 = Gather(_grid, x2, y1);
+    const XMVECTOR v22 = Gather(_grid, x2, y2);
+
+    const XMVECTOR one = XMVectorSplatOne();
+    const XMVECTOR w11 = XMVectorMultiply(XMVectorSubtract(one, fx), XMVectorSubtract(one, fy));
+    const XMVECTOR w12 = XMVectorMultiply(XMVectorSubtract(one, fx), fy);
+    const XMVECTOR w21 = XMVectorMultiply(fx, XMVectorSubtract(one, fy));
+    const XMVECTOR w22 = XMVectorMultiply(fx, fy);
+
+    XMVECTOR result = XMVectorAdd(XMVectorMultiply(v11, w11), XMVectorMultiply(v12, w12));
+    result = XMVectorAdd(result, XMVectorMultiply(v21, w21));
+    result = XMVectorAdd(result, XMVectorMultiply(v22, w22));
+    XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(_out), result);
+  }
+
+  // _out[i] is the grid at (_x[i], _y[i]).  The grid must not be empty.
+  inline void SampleBilinear(const Grid& _grid, const float* _x, const float* _y, float* _out, int _count)
+  {
+    DEBUG_ASSERT(_grid.m_data && _grid.m_numColumns > 0 && _grid.m_numRows > 0);
+
+    int i = 0;
+    for (; i + 4 <= _count; i += 4)
+      SampleBilinear4(_grid, _x + i, _y + i, _out + i);
+
+    if (i < _count)
+    {
+      float x[4], y[4], out[4];
+      for (int lane = 0; lane < 4; ++lane)
+      {
+        const int from = std::min(i + lane, _count - 1);
+        x[lane] = _x[from];
+        y[lane] = _y[from];
+      }
+      SampleBilinear4(_grid, x, y, out);
+      for (int lane = 0; i + lane < _count; ++lane)
+        _out[i + lane] = out[lane];
+    }
+  }
+}
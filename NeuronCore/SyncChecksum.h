@@ -0,0 +1,81 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// SyncHasher / SyncChecksum
+//
+// Building blocks for lockstep desync detection.
+//
+// SyncHasher folds a sequence of values into a 64-bit digest.  It is used to
+// hash the state of a single object.  Floats are folded by bit pattern, so
+// two simulations only agree if they are bit-identical.
+//
+// SyncChecksum is an order-independent (multiset) sum of per-object digests.
+// Each object caches the digest it last contributed; when the object changes
+// the old digest is swapped for the new one in O(1).  This keeps the world
+// checksum current without ever walking the world.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  // SplitMix64 finaliser.  Cheap, and every input bit affects every output bit.
+  [[nodiscard]] constexpr uint64_t SyncMix(uint64_t _x) noexcept
+  {
+    _x ^= _x >> 30;
+    _x *= 0xbf58476d1ce4e5b9ULL;
+    _x ^= _x >> 27;
+    _x *= 0x94d049bb133111ebULL;
+    _x ^= _x >> 31;
+    return _x;
+  }
+
+  class SyncHasher
+  {
+    public:
+      constexpr SyncHasher() noexcept = default;
+      constexpr explicit SyncHasher(uint64_t _seed) noexcept : m_state(_seed) {}
+
+      constexpr SyncHasher& Fold(uint64_t _value) noexcept
+      {
+        m_state = SyncMix(m_state ^ (_value + 0x9e3779b97f4a7c15ULL + (m_state << 6) + (m_state >> 2)));
+        return *this;
+      }
+
+      constexpr SyncHasher& Fold(int _value) noexcept { return Fold(static_cast<uint64_t>(static_cast<uint32_t>(_value))); }
+      constexpr SyncHasher& Fold(unsigned int _value) noexcept { return Fold(static_cast<uint64_t>(_value)); }
+      constexpr SyncHasher& Fold(bool _value) noexcept { return Fold(static_cast<uint64_t>(_value ? 1 : 0)); }
+      SyncHasher& Fold(float _value) noexcept { return Fold(static_cast<uint64_t>(std::bit_cast<uint32_t>(_value))); }
+
+      [[nodiscard]] constexpr uint64_t Value() const noexcept { return m_state; }
+
+    private:
+      uint64_t m_state = 0xcbf29ce484222325ULL;
+  };
+
+  class SyncChecksum
+  {
+    public:
+      void Add(uint64_t _digest) noexcept { m_sum += _digest; }
+      void Remove(uint64_t _digest) noexcept { m_sum -= _digest; }
+
+      // Replaces the digest cached in _contribution with _digest.
+      void Update(uint64_t& _contribution, uint64_t _digest) noexcept
+      {
+        m_sum += _digest - _contribution;
+        _contribution = _digest;
+      }
+
+      // Removes the digest cached in _contribution and clears it.
+      void Retire(uint64_t& _contribution) noexcept
+      {
+        m_sum -= _contribution;
+        _contribution = 0;
+      }
+
+      void Reset() noexcept { m_sum = 0; }
+
+      [[nodiscard]] uint64_t Value() const noexcept { return m_sum; }
+
+    private:
+      uint64_t m_sum = 0;
+  };
+}
@@ -0,0 +1,344 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// TriangleBvh
+//
+// Bounding-volume hierarchy over the triangles of one mesh, built once in
+// the mesh's own space.  Queries place the mesh with an affine frame and
+// return the triangles a line or sphere might touch, so a hit test only has
+// to run its exact triangle test on those instead of on every triangle.
+//
+// The tree only culls.  Node boxes are padded and transformed
+// conservatively, so a triangle is skipped only when it is clearly out of
+// reach; the caller's own test decides every hit.  Triangles too thin to
+// have a reliable plane are never culled, and a query with a non-finite
+// frame or input visits every triangle.  Either way the answer is the one a
+// loop over all the triangles would give.
+//
+// Vectors are anything with x, y and z members.  Frames follow the
+// row-vector convention: a point p lands at p.x*r + p.y*u + p.z*f + pos.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class TriangleBvh
+  {
+    public:
+      // _corner(int _triangle, int _k) returns corner _k (0, 1 or 2) of a triangle
+      template <typename TCorner>
+      void Build(int _numTriangles, TCorner&& _corner)
+      {
+        Clear();
+        m_numTriangles = _numTriangles;
+
+        std::vector<BuildItem> items;
+        items.reserve(_numTriangles);
+        for (int i = 0; i < _numTriangles; ++i)
+        {
+          const Vec a = ToVec(_corner(i, 0));
+          const Vec b = ToVec(_corner(i, 1));
+          const Vec c = ToVec(_corner(i, 2));
+          if (IsSliver(a, b, c))
+          {
+            m_slivers.push_back(i);
+            continue;
+          }
+
+          BuildItem item{};
+          item.m_triangle = i;
+          float size = 0.0f;
+          for (int k = 0; k < 3; ++k)
+          {
+            item.m_min[k] = std::min({a[k], b[k], c[k]});
+            item.m_max[k] = std::max({a[k], b[k], c[k]});
+            size = std::max(size, item.m_max[k] - item.m_min[k]);
+          }
+          const float pad = size * PAD_RELATIVE + PAD_ABSOLUTE;
+          for (int k = 0; k < 3; ++k)
+          {
+            item.m_min[k] -= pad;
+            item.m_max[k] += pad;
+            item.m_centroid[k] = (item.m_min[k] + item.m_max[k]) * 0.5f;
+          }
+          items.push_back(item);
+        }
+
+        if (items.empty())
+          return;
+
+        m_nodes.reserve(2 * (items.size() / LEAF_SIZE + 1));
+        m_nodes.emplace_back();
+        Split(items, 0, 0, static_cast<int>(items.size()));
+
+        m_order.reserve(items.size());
+        for (const BuildItem& item : items)
+          m_order.push_back(item.m_triangle);
+      }
+
+      void Clear()
+      {
+        m_nodes.clear();
+        m_order.clear();
+        m_slivers.clear();
+        m_numTriangles = 0;
+      }
+
+      // _test(int _triangle) for the triangles the infinite line through
+      // _origin along _dir might cross, until one returns true
+      template <typename TFrame, typename TVec, typename TTest>
+      bool AnyNearLine(const TFrame& _frame, const TVec& _origin, const TVec& _dir, TTest&& _test) const
+      {
+        const Vec origin = ToVec(_origin);
+        const Vec dir = ToVec(_dir);
+        const Affine frame = ToAffine(_frame);
+        if (!frame.IsFinite() || !origin.IsFinite() || !dir.IsFinite())
+          return TestAll(_test);
+
+        return Traverse(frame, origin.MaxAbs(), _test, [&](const Vec& _center, const Vec& _extent)
+        {
+          float tNear = -std::numeric_limits<float>::infinity();
+          float tFar = std::numeric_limits<float>::infinity();
+          for (int k = 0; k < 3; ++k)
+          {
+            const float lo = _center[k] - _extent[k] - origin[k];
+            const float hi = _center[k] + _extent[k] - origin[k];
+            if (dir[k] == 0.0f)
+            {
+              if (lo > 0.0f || hi < 0.0f)
+                return false;
+              continue;
+            }
+            const float t0 = lo / dir[k];
+            const float t1 = hi / dir[k];
+            tNear = std::max(tNear, std::min(t0, t1));
+            tFar = std::min(tFar, std::max(t0, t1));
+          }
+          return tNear <= tFar;
+        });
+      }
+
+      // _test(int _triangle) for the triangles that might come within
+      // _radius of _center, until one returns true
+      template <typename TFrame, typename TVec, typename TTest>
+      bool AnyNearSphere(const TFrame& _frame, const TVec& _center, float _radius, TTest&& _test) const
+      {
+        const Vec center = ToVec(_center);
+        const Affine frame = ToAffine(_frame);
+        if (!frame.IsFinite() || !center.IsFinite() || !std::isfinite(_radius))
+          return TestAll(_test);
+
+        // Triangle tests compare squared distances, so a negative radius
+        // reaches as far as a positive one
+        const float radiusSq = _radius * _radius;
+        return Traverse(frame, center.MaxAbs() + std::abs(_radius), _test, [&](const Vec& _boxCenter, const Vec& _extent)
+        {
+          float distSq = 0.0f;
+          for (int k = 0; k < 3; ++k)
+          {
+            const float d = std::max(std::abs(center[k] - _boxCenter[k]) - _extent[k], 0.0f);
+            distSq += d * d;
+          }
+          return distSq <= radiusSq;
+        });
+      }
+
+      [[nodiscard]] int GetNumTriangles() const noexcept { return m_numTriangles; }
+      [[nodiscard]] int GetNumNodes() const noexcept { return static_cast<int>(m_nodes.size()); }
+      [[nodiscard]] int GetNumSlivers() const noexcept { return static_cast<int>(m_slivers.size()); }
+
+    private:
+      static constexpr int LEAF_SIZE = 4;
+      static constexpr int MAX_DEPTH = 64;
+
+      // Node boxes grow by this fraction of each triangle's size (the exact
+      // tests accept points a hair outside a triangle) and by a fixed floor
+      static constexpr float PAD_RELATIVE = 1.0e-3f;
+      static constexpr float PAD_ABSOLUTE = 1.0e-4f;
+
+      // World boxes grow by this fraction of the coordinates involved, for
+      // rounding in the transform and in the caller's tests
+      static constexpr float SLACK_RELATIVE = 1.0e-5f;
+
+      // Squared sine of the sharpest corner below which a triangle's plane is
+      // unreliable
+      static constexpr float SLIVER_SIN_SQ = 1.0e-8f;
+
+      struct Vec
+      {
+        float x, y, z;
+
+        float operator[](int _k) const noexcept { return (&x)[_k]; }
+        [[nodiscard]] bool IsFinite() const noexcept { return std::isfinite(x) && std::isfinite(y) && std::isfinite(z); }
+        [[nodiscard]] float MaxAbs() const noexcept { return std::max({std::abs(x), std::abs(y), std::abs(z)}); }
+      };
+
+      struct Affine
+      {
+        Vec r, u, f, pos;
+
+        [[nodiscard]] bool IsFinite() const noexcept { return r.IsFinite() && u.IsFinite() && f.IsFinite() && pos.IsFinite(); }
+
+        [[nodiscard]] Vec Point(const Vec& _p) const noexcept
+        {
+          return {r.x * _p.x + u.x * _p.y + f.x * _p.z + pos.x,
+                  r.y * _p.x + u.y * _p.y + f.y * _p.z + pos.y,
+                  r.z * _p.x + u.z * _p.y + f.z * _p.z + pos.z};
+        }
+
+        // Half-extents of the world box enclosing a local box
+        [[nodiscard]] Vec Extent(const Vec& _e) const noexcept
+        {
+          return {std::abs(r.x) * _e.x + std::abs(u.x) * _e.y + std::abs(f.x) * _e.z,
+                  std::abs(r.y) * _e.x + std::abs(u.y) * _e.y + std::abs(f.y) * _e.z,
+                  std::abs(r.z) * _e.x + std::abs(u.z) * _e.y + std::abs(f.z) * _e.z};
+        }
+      };
+
+      struct Node
+      {
+        Vec m_center;
+        Vec m_extent;
+        int m_first;   // Leaf: first entry in m_order.  Interior: left child; right follows it
+        int m_count;   // Triangles in a leaf, 0 for an interior node
+      };
+
+      struct BuildItem
+      {
+        float m_min[3];
+        float m_max[3];
+        float m_centroid[3];
+        int   m_triangle;
+      };
+
+      template <typename TVec>
+      static Vec ToVec(const TVec& _v) noexcept { return {_v.x, _v.y, _v.z}; }
+
+      template <typename TFrame>
+      static Affine ToAffine(const TFrame& _frame) noexcept
+      {
+        return {ToVec(_frame.r), ToVec(_frame.u), ToVec(_frame.f), ToVec(_frame.pos)};
+      }
+
+      static bool IsSliver(const Vec& _a, const Vec& _b, const Vec& _c) noexcept
+      {
+        const double e1[3] = {double(_b.x) - _a.x, double(_b.y) - _a.y, double(_b.z) - _a.z};
+        const double e2[3] = {double(_c.x) - _b.x, double(_c.y) - _b.y, double(_c.z) - _b.z};
+        const double cross[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+        const double crossSq = cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2];
+        const double e1Sq = e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2];
+        const double e2Sq = e2[0] * e2[0] + e2[1] * e2[1] + e2[2] * e2[2];
+        return !(crossSq > SLIVER_SIN_SQ * e1Sq * e2Sq);
+      }
+
+      // Fills node _node from items [_first, _last), splitting at the centroid median
+      void Split(std::vector<BuildItem>& _items, int _node, int _first, int _last)
+      {
+        float lo[3], hi[3], centroidLo[3], centroidHi[3];
+        for (int k = 0; k < 3; ++k)
+        {
+          lo[k] = centroidLo[k] = std::numeric_limits<float>::max();
+          hi[k] = centroidHi[k] = -std::numeric_limits<float>::max();
+        }
+        for (int i = _first; i < _last; ++i)
+        {
+          for (int k = 0; k < 3; ++k)
+          {
+            lo[k] = std::min(lo[k], _items[i].m_min[k]);
+            hi[k] = std::max(hi[k], _items[i].m_max[k]);
+            centroidLo[k] = std::min(centroidLo[k], _items[i].m_centroid[k]);
+            centroidHi[k] = std::max(centroidHi[k], _items[i].m_centroid[k]);
+          }
+        }
+
+        Node& node = m_nodes[_node];
+        node.m_center = {(lo[0] + hi[0]) * 0.5f, (lo[1] + hi[1]) * 0.5f, (lo[2] + hi[2]) * 0.5f};
+        node.m_extent = {(hi[0] - lo[0]) * 0.5f, (hi[1] - lo[1]) * 0.5f, (hi[2] - lo[2]) * 0.5f};
+
+        if (_last - _first <= LEAF_SIZE)
+        {
+          node.m_first = _first;
+          node.m_count = _last - _first;
+          return;
+        }
+
+        int axis = 0;
+        for (int k = 1; k < 3; ++k)
+        {
+          if (centroidHi[k] - centroidLo[k] > centroidHi[axis] - centroidLo[axis])
+            axis = k;
+        }
+
+        const int middle = _first + (_last - _first) / 2;
+        std::nth_element(_items.begin() + _first, _items.begin() + middle, _items.begin() + _last,
+                         [axis](const BuildItem& _a, const BuildItem& _b) { return _a.m_centroid[axis] < _b.m_centroid[axis]; });
+
+        const int left = static_cast<int>(m_nodes.size());
+        m_nodes[_node].m_first = left;
+        m_nodes[_node].m_count = 0;
+        m_nodes.emplace_back();
+        m_nodes.emplace_back();
+        Split(_items, left, _first, middle);
+        Split(_items, left + 1, middle, _last);
+      }
+
+      template <typename TTest>
+      bool TestAll(TTest& _test) const
+      {
+        for (int i = 0; i < m_numTriangles; ++i)
+        {
+          if (_test(i))
+            return true;
+        }
+        return false;
+      }
+
+      // _overlaps(center, extent) decides whether a node's world box is in reach
+      template <typename TTest, typename TOverlaps>
+      bool Traverse(const Affine& _frame, float _queryMagnitude, TTest& _test, TOverlaps&& _overlaps) const
+      {
+        for (int triangle : m_slivers)
+        {
+          if (_test(triangle))
+            return true;
+        }
+        if (m_nodes.empty())
+          return false;
+
+        const Node& root = m_nodes[0];
+        const float slack = SLACK_RELATIVE * (_queryMagnitude + _frame.Point(root.m_center).MaxAbs() + _frame.Extent(root.m_extent).MaxAbs()) +
+          PAD_ABSOLUTE;
+
+        int stack[MAX_DEPTH];
+        int depth = 0;
+        stack[depth++] = 0;
+        while (depth > 0)
+        {
+          const Node& node = m_nodes[stack[--depth]];
+          Vec extent = _frame.Extent(node.m_extent);
+          extent = {extent.x + slack, extent.y + slack, extent.z + slack};
+          if (!_overlaps(_frame.Point(node.m_center), extent))
+            continue;
+
+          if (node.m_count == 0)
+          {
+            DEBUG_ASSERT(depth + 2 <= MAX_DEPTH);
+            stack[depth++] = node.m_first + 1;
+            stack[depth++] = node.m_first;
+            continue;
+          }
+
+          for (int i = node.m_first; i < node.m_first + node.m_count; ++i)
+          {
+            if (_test(m_order[i]))
+              return true;
+          }
+        }
+        return false;
+      }
+
+      std::vector<Node> m_nodes;
+      std::vector<int>  m_order;     // Triangle indices, grouped by leaf
+      std::vector<int>  m_slivers;   // Never culled
+      int               m_numTriangles = 0;
+  };
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// VoiceScheduler
+//
+// The bookkeeping behind SoundSystem's choice of which sounds get a channel.
+//
+// SlotIndex files the slots of a sparse array (e.g. FastDArray) under a key,
+// so that every slot with a given key can be found without scanning the
+// array.  A slot has at most one key; Insert, Remove and Move are O(1).
+//
+// VoiceOrder keeps a set of ids sorted loudest first across updates.
+// Loudness drifts a little between updates, so last update's order is
+// nearly right and an insertion sort repairs it in about one pass; ids
+// added since are sorted among themselves and merged in.  If the order has
+// been shaken up too much for that to pay (a camera cut, say), it falls back
+// to a full sort.  Either way the result is that of a stable sort of the
+// previous order, newcomers last.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  template <typename TKey, typename THash = std::hash<TKey>, typename TEqual = std::equal_to<TKey>>
+  class SlotIndex
+  {
+    public:
+      // Files _slot under _key, first removing it from any key it had
+      void Insert(int _slot, const TKey& _key)
+      {
+        DEBUG_ASSERT(_slot >= 0);
+        if (_slot >= static_cast<int>(m_slots.size()))
+          m_slots.resize(_slot + 1);
+        Remove(_slot);
+
+        if (m_numEmptyBuckets > MIN_EMPTY_BUCKETS && m_numEmptyBuckets > static_cast<int>(m_buckets.size()) / 2)
+          EraseEmptyBuckets();
+
+        auto [it, isNew] = m_buckets.try_emplace(_key);
+        std::vector<int>& bucket = it->second;
+        if (!isNew && bucket.empty())
+          --m_numEmptyBuckets;
+
+        Slot& slot = m_slots[_slot];
+        slot.m_key = _key;
+        slot.m_position = static_cast<int>(bucket.size());
+        slot.m_indexed = true;
+        bucket.push_back(_slot);
+      }
+
+      void Remove(int _slot)
+      {
+        if (!Contains(_slot))
+          return;
+
+        Slot& slot = m_slots[_slot];
+        std::vector<int>& bucket = m_buckets.find(slot.m_key)->second;
+        const int last = bucket.back();
+        bucket[slot.m_position] = last;
+        m_slots[last].m_position = slot.m_position;
+        bucket.pop_back();
+        slot.m_indexed = false;
+
+        // Empty buckets are erased later, so that ForEach survives a Remove
+        if (bucket.empty())
+          ++m_numEmptyBuckets;
+      }
+
+      void Move(int _slot, const TKey& _key)
+      {
+        if (Contains(_slot) && TEqual{}(m_slots[_slot].m_key, _key))
+          return;
+        Insert(_slot, _key);
+      }
+
+      void Clear()
+      {
+        m_buckets.clear();
+        m_slots.clear();
+        m_numEmptyBuckets = 0;
+      }
+
+      // _visit(int _slot) for every slot filed under _key, in no particular
+      // order.  _visit may Remove the slot it is given, but no other.
+      template <typename TVisit>
+      void ForEach(const TKey& _key, TVisit&& _visit) const
+      {
+        auto it = m_buckets.find(_key);
+        if (it == m_buckets.end())
+          return;
+
+        // Backwards, so that a removal only moves slots already visited
+        const std::vector<int>& bucket = it->second;
+        for (int i = static_cast<int>(bucket.size()) - 1; i >= 0; --i)
+        {
+          if (i < static_cast<int>(bucket.size()))
+            _visit(bucket[i]);
+        }
+      }
+
+      [[nodiscard]] int Count(const TKey& _key) const
+      {
+        auto it = m_buckets.find(_key);
+        return it == m_buckets.end() ? 0 : static_cast<int>(it->second.size());
+      }
+
+      [[nodiscard]] bool Contains(int _slot) const noexcept
+      {
+        return _slot >= 0 && _slot < static_cast<int>(m_slots.size()) && m_slots[_slot].m_indexed;
+      }
+
+      // The key _slot is filed under; _slot must be Contained
+      [[nodiscard]] const TKey& GetKey(int _slot) const noexcept { return m_slots[_slot].m_key; }
+
+      [[nodiscard]] int GetNumKeys() const noexcept { return static_cast<int>(m_buckets.size()) - m_numEmptyBuckets; }
+
+    private:
+      static constexpr int MIN_EMPTY_BUCKETS = 64;
+
+      struct Slot
+      {
+        TKey m_key{};
+        int  m_position = 0;      // In its bucket
+        bool m_indexed = false;
+      };
+
+      void EraseEmptyBuckets()
+      {
+        std::erase_if(m_buckets, [](const auto& _bucket) { return _bucket.second.empty(); });
+        m_numEmptyBuckets = 0;
+      }
+
+      std::unordered_map<TKey, std::vector<int>, THash, TEqual> m_buckets;
+      std::vector<Slot> m_slots;
+      int m_numEmptyBuckets = 0;
+  };
+
+  template <typename TId>
+  class VoiceOrder
+  {
+    public:
+      struct Voice
+      {
+        TId   m_id;
+        float m_volume;
+      };
+
+      // _id joins the order at the next Update
+      void Add(const TId& _id) { m_voices.push_back({_id, 0.0f}); }
+
+      void Clear()
+      {
+        m_voices.clear();
+        m_numSorted = 0;
+      }
+
+      // Drops the ids _isAlive(id) rejects, then sorts the rest on
+      // _volume(id), loudest first
+      template <typename TAlive, typename TVolume>
+      void Update(TAlive&& _isAlive, TVolume&& _volume)
+      {
+        int numSorted = 0;
+        int numKept = 0;
+        for (int i = 0; i < static_cast<int>(m_voices.size()); ++i)
+        {
+          if (!_isAlive(m_voices[i].m_id))
+            continue;
+          if (i < m_numSorted)
+            ++numSorted;
+          m_voices[numKept] = m_voices[i];
+          m_voices[numKept].m_volume = _volume(m_voices[i].m_id);
+          ++numKept;
+        }
+        m_voices.resize(numKept);
+
+        const auto louder = [](const Voice& _a, const Voice& _b) { return _a.m_volume > _b.m_volume; };
+        const auto mid = m_voices.begin() + numSorted;
+        if (!InsertionSort(numSorted))
+          std::stable_sort(m_voices.begin(), mid, louder);
+        std::stable_sort(mid, m_voices.end(), louder);
+        std::inplace_merge(m_voices.begin(), mid, m_voices.end(), louder);
+        m_numSorted = numKept;
+      }
+
+      // Valid as of the last Update
+      [[nodiscard]] const std::vector<Voice>& GetVoices() const noexcept { return m_voices; }
+
+    private:
+      // Moves per voice an insertion sort may make before a full sort is cheaper
+      static constexpr int MAX_MOVES_PER_VOICE = 8;
+
+      // Sorts the first _count voices if that takes few enough moves; if not,
+      // leaves them in an order with the same stable sort and returns false
+      bool InsertionSort(int _count)
+      {
+        long long budget = static_cast<long long>(_count) * MAX_MOVES_PER_VOICE;
+        for (int i = 1; i < _count; ++i)
+        {
+          const Voice voice = m_voices[i];
+          int j = i;
+          while (j > 0 && m_voices[j - 1].m_volume < voice.m_volume)
+          {
+            m_voices[j] = m_voices[j - 1];
+            --j;
+          }
+          m_voices[j] = voice;
+          budget -= i - j;
+          if (budget < 0)
+            return false;
+        }
+        return true;
+      }
+
+      std::vector<Voice> m_voices;
+      int m_numSorted = 0;   // Voices that were present at the last Update
+  };
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+// ---------------------------------------------------------------------------
+// WakeScheduler
+//
+// Tracks which of a set of slots (e.g. the buildings in a level) need to be
+// advanced.  Slots start awake.  A slot put to sleep is skipped by
+// ForEachAwake until something calls Wake on it or, for a timed sleep,
+// until enough Tick calls have gone by.
+//
+// Awake slots are kept as a bitmask, so visiting them costs one word per
+// 64 slots plus the awake slots themselves.  Timers sit in a min-heap;
+// waking or re-sleeping a slot leaves its old heap entry behind to be
+// discarded when it surfaces.
+//
+// ForEachAwake re-reads the mask after every call, so a slot woken by the
+// callback is visited in the same pass if it lies ahead of the cursor.  A
+// caller that only sleeps slots whose update would do nothing therefore sees
+// exactly the results it would have seen updating every slot.
+// ---------------------------------------------------------------------------
+
+namespace Neuron
+{
+  class WakeScheduler
+  {
+    public:
+      static constexpr int FOREVER = -1;
+
+      // New slots are awake; slots past _numSlots are forgotten
+      void Resize(int _numSlots)
+      {
+        const int oldSlots = m_numSlots;
+        m_numSlots = _numSlots;
+        m_awake.resize((_numSlots + 63) / 64, 0);
+        m_stamps.resize(_numSlots, 0);
+        for (int i = oldSlots; i < _numSlots; ++i)
+          m_awake[i >> 6] |= Bit(i);
+        if (_numSlots & 63)
+          m_awake.back() &= Bit(_numSlots) - 1;
+      }
+
+      // Every slot awake, no timers pending
+      void Clear()
+      {
+        const int numSlots = m_numSlots;
+        m_numSlots = 0;
+        m_awake.clear();
+        m_stamps.clear();
+        m_timers.clear();
+        Resize(numSlots);
+      }
+
+      // Skips _slot for the next _ticks calls to Tick, or until Wake
+      void Sleep(int _slot, int _ticks = FOREVER)
+      {
+        DEBUG_ASSERT(_slot >= 0 && _slot < m_numSlots);
+        if (_ticks == 0)
+          return;
+
+        m_awake[_slot >> 6] &= ~Bit(_slot);
+        ++m_stamps[_slot];
+        if (_ticks > 0)
+        {
+          m_timers.push_back({m_tick + _ticks + 1, _slot, m_stamps[_slot]});
+          std::ranges::push_heap(m_timers, std::greater{}, &Timer::m_tick);
+        }
+      }
+
+      void Wake(int _slot)
+      {
+        if (_slot < 0 || _slot >= m_numSlots || IsAwake(_slot))
+          return;
+        m_awake[_slot >> 6] |= Bit(_slot);
+        ++m_stamps[_slot];
+      }
+
+      // Starts the next tick, waking slots whose timers have run out
+      void Tick()
+      {
+        ++m_tick;
+        while (!m_timers.empty() && m_timers.front().m_tick <= m_tick)
+        {
+          std::ranges::pop_heap(m_timers, std::greater{}, &Timer::m_tick);
+          const Timer timer = m_timers.back();
+          m_timers.pop_back();
+          if (timer.m_slot < m_numSlots && m_stamps[timer.m_slot] == timer.m_stamp)
+            Wake(timer.m_slot);
+        }
+      }
+
+      // _visit(int _slot) for every awake slot in [_begin, _end), in order
+      template <typename TVisit>
+      void ForEachAwake(int _begin, int _end, TVisit&& _visit)
+      {
+        _end = std::min(_end, m_numSlots);
+        for (int slot = NextAwake(_begin, _end); slot < _end; slot = NextAwake(slot + 1, _end))
+          _visit(slot);
+      }
+
+      [[nodiscard]] bool IsAwake(int _slot) const noexcept { return (m_awake[_slot >> 6] & Bit(_slot)) != 0; }
+
+      [[nodiscard]] int GetNumAwake() const noexcept
+      {
+        int count = 0;
+        for (uint64_t word : m_awake)
+          count += std::popcount(word);
+        return count;
+      }
+
+      [[nodiscard]] int GetNumSlots() const noexcept { return m_numSlots; }
+
+    private:
+      struct Timer
+      {
+        int      m_tick;
+        int      m_slot;
+        uint32_t m_stamp;   // Stale unless it still matches m_stamps[m_slot]
+      };
+
+      [[nodiscard]] static constexpr uint64_t Bit(int _slot) noexcept { return 1ULL << (_slot & 63); }
+
+      // First awake slot at or after _slot, or _end
+      [[nodiscard]] int NextAwake(int _slot, int _end) const noexcept
+      {
+        if (_slot >= _end)
+          return _end;
+
+        int word = _slot >> 6;
+        uint64_t bits = m_awake[word] & ~(Bit(_slot) - 1);
+        while (bits == 0)
+        {
+          if (++word << 6 >= _end)
+            return _end;
+          bits = m_awake[word];
+        }
+        return std::min(_end, (word << 6) + std::countr_zero(bits));
+      }
+
+      std::vector<uint64_t> m_awake;
+      std::vector<uint32_t> m_stamps;   // Bumped whenever a slot sleeps or wakes
+      std::vector<Timer>    m_timers;   // Min-heap on m_tick
+      int                   m_numSlots = 0;
+      int                   m_tick = 0;
+  };
+}
@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "net_impairment.h"
+
+
+bool NetImpairmentConfig::IsImpaired() const
+{
+	return m_lossPercent > 0.0f || m_duplicatePercent > 0.0f || m_reorderPercent > 0.0f ||
+		   m_latencyMs > 0 || m_jitterMs > 0;
+}
+
+
+NetImpairment::NetImpairment(const NetImpairmentConfig &config)
+:	m_config(config),
+	m_random(config.m_seed),
+	m_nextOrder(0),
+	m_running(true)
+{
+	m_thread = std::thread([this] { DeliveryLoop(); });
+}
+
+
+NetImpairment::~NetImpairment()
+{
+	{
+		std::scoped_lock lock(m_lock);
+		m_running = false;
+	}
+	m_wake.notify_all();
+	m_thread.join();
+}
+
+
+float NetImpairment::NextUnit()
+{
+	m_random = m_random * 1664525u + 1013904223u;
+	return static_cast<float>(m_random >> 8) * (1.0f / 16777216.0f);
+}
+
+
+NetImpairmentFate NetImpairment::Plan()
+{
+	std::scoped_lock lock(m_lock);
+
+	float lost = NextUnit() * 100.0f;
+	float duplicated = NextUnit() * 100.0f;
+	float reordered = NextUnit() * 100.0f;
+	float jitter[2] = { NextUnit(), NextUnit() };
+
+	NetImpairmentFate fate = {};
+	if (lost < m_config.m_lossPercent)
+	{
+		return fate;
+	}
+
+	fate.m_numCopies = (duplicated < m_config.m_duplicatePercent) ? 2 : 1;
+	for (int i = 0; i < fate.m_numCopies; ++i)
+	{
+		fate.m_delayMs[i] = m_config.m_latencyMs + static_cast<int>(jitter[i] * static_cast<float>(m_config.m_jitterMs + 1));
+	}
+
+	if (reordered < m_config.m_reorderPercent)
+	{
+		fate.m_reordered = true;
+		fate.m_delayMs[0] += m_config.m_reorderMs;
+	}
+
+	return fate;
+}
+
+
+void NetImpairment::Send(NetSocketHandle sockfd, const NetIpAddress *to, const void *buf, int bufLen)
+{
+	NetImpairmentFate fate = Plan();
+	auto now = std::chrono::steady_clock::now();
+
+	std::scoped_lock lock(m_lock);
+	++m_stats.m_datagrams;
+	if (fate.m_numCopies == 0)
+	{
+		++m_stats.m_lost;
+		return;
+	}
+	if (fate.m_numCopies > 1)
+	{
+		++m_stats.m_duplicated;
+	}
+	if (fate.m_reordered)
+	{
+		++m_stats.m_reordered;
+	}
+
+	for (int i = 0; i < fate.m_numCopies; ++i)
+	{
+		auto pending = std::make_unique<Pending>();
+		pending->m_due = now + std::chrono::milliseconds(fate.m_delayMs[i]);
+		pending->m_order = m_nextOrder++;
+		pending->m_sockfd = sockfd;
+		pending->m_to = *to;
+		pending->m_length = std::min(bufLen, MAX_PACKET_SIZE);
+		memcpy(pending->m_data, buf, pending->m_length);
+
+		m_pending.push_back(std::move(pending));
+		std::push_heap(m_pending.begin(), m_pending.end(), IsLater);
+	}
+	m_wake.notify_one();
+}
+
+
+void NetImpairment::Forget(NetSocketHandle sockfd)
+{
+	std::scoped_lock lock(m_lock);
+	std::erase_if(m_pending, [sockfd](const std::unique_ptr<Pending> &pending) { return pending->m_sockfd == sockfd; });
+	std::make_heap(m_pending.begin(), m_pending.end(), IsLater);
+}
+
+
+int NetImpairment::GetNumPending()
+{
+	std::scoped_lock lock(m_lock);
+	return static_cast<int>(m_pending.size());
+}
+
+
+NetImpairment::Stats NetImpairment::GetStats()
+{
+	std::scoped_lock lock(m_lock);
+	return m_stats;
+}
+
+
+bool NetImpairment::IsLater(const std::unique_ptr<Pending> &a, const std::unique_ptr<Pending> &b)
+{
+	if (a->m_due != b->m_due)
+	{
+		return a->m_due > b->m_due;
+	}
+	return a->m_order > b->m_order;
+}
+
+
+void NetImpairment::DeliveryLoop()
+{
+	std::unique_lock lock(m_lock);
+	while (m_running)
+	{
+		if (m_pending.empty())
+		{
+			m_wake.wait(lock);
+			continue;
+		}
+
+		auto due = m_pending.front()->m_due;
+		if (std::chrono::steady_clock::now() < due)
+		{
+			m_wake.wait_until(lock, due);
+			continue;
+		}
+
+		std::pop_heap(m_pending.begin(), m_pending.end(), IsLater);
+		std::unique_ptr<Pending> pending = std::move(m_pending.back());
+		m_pending.pop_back();
+		++m_stats.m_delivered;
+
+		// Sent under the lock: Forget waits for it, so the socket cannot be closed mid-send
+		sendto(pending->m_sockfd, pending->m_data, pending->m_length, 0,
+			   (const struct sockaddr *)&pending->m_to, sizeof(NetIpAddress));
+	}
+}
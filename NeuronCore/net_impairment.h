@@ -0,0 +1,103 @@
+// ****************************************************************************
+// A network impairment simulator
+//
+// Sits under NetSocket and NetSocketListener sends and subjects every
+// datagram to loss, latency, jitter, reordering and duplication, so the
+// client/server stack can be exercised over loopback as if over a poor link.
+// Decisions come from a seeded generator: the same seed and the same
+// sequence of datagrams always meet the same fate.
+//
+// Delayed datagrams are held by a delivery thread and sent from the socket
+// they were written to once they fall due.
+// ****************************************************************************
+
+#pragma once
+
+
+#include "net_lib.h"
+
+
+struct NetImpairmentConfig
+{
+	float			m_lossPercent = 0.0f;
+	float			m_duplicatePercent = 0.0f;	// A duplicate is delayed independently of the original
+	float			m_reorderPercent = 0.0f;	// Held back a further m_reorderMs, so later datagrams overtake it
+	int				m_latencyMs = 0;
+	int				m_jitterMs = 0;				// Each copy is delayed m_latencyMs plus up to this
+	int				m_reorderMs = 20;
+	unsigned int	m_seed = 1;
+
+	bool			IsImpaired() const;
+};
+
+
+// What happens to one datagram
+struct NetImpairmentFate
+{
+	int				m_numCopies;				// 0 if it is lost, 2 if it is duplicated
+	int				m_delayMs[2];
+	bool			m_reordered;
+};
+
+
+class NetImpairment
+{
+public:
+	struct Stats
+	{
+		long long	m_datagrams = 0;			// Written by the sockets
+		long long	m_lost = 0;
+		long long	m_duplicated = 0;
+		long long	m_reordered = 0;
+		long long	m_delivered = 0;			// Copies handed to the network stack
+	};
+
+	NetImpairment(const NetImpairmentConfig &config);
+	~NetImpairment();
+
+	// Decides the fate of the next datagram.  Every call draws the same
+	// number of values from the generator, so changing one rate in the
+	// config does not reshuffle the decisions made by the others
+	NetImpairmentFate	Plan();
+
+	// Plans the datagram and queues its copies for delivery.  The caller
+	// sees a successful send whatever happens, as it would for a real
+	// datagram lost on the way
+	void			Send(NetSocketHandle sockfd, const NetIpAddress *to, const void *buf, int bufLen);
+
+	// Discards anything queued for the socket; called before it is closed
+	void			Forget(NetSocketHandle sockfd);
+
+	// Datagrams queued and not yet delivered
+	int				GetNumPending();
+
+	const NetImpairmentConfig &GetConfig() const { return m_config; }
+	Stats			GetStats();
+
+protected:
+	struct Pending
+	{
+		std::chrono::steady_clock::time_point	m_due;
+		long long		m_order;				// Keeps datagrams due at the same moment in send order
+		NetSocketHandle	m_sockfd;
+		NetIpAddress	m_to;
+		int				m_length;
+		char			m_data[MAX_PACKET_SIZE];
+	};
+
+	static bool		IsLater(const std::unique_ptr<Pending> &a, const std::unique_ptr<Pending> &b);
+
+	float			NextUnit();					// [0, 1)
+	void			DeliveryLoop();
+
+	NetImpairmentConfig	m_config;
+	unsigned int	m_random;
+
+	std::mutex		m_lock;						// Guards everything below and m_random
+	std::condition_variable	m_wake;
+	std::vector<std::unique_ptr<Pending>>	m_pending;	// Min-heap on m_due
+	long long		m_nextOrder;
+	bool			m_running;
+	Stats			m_stats;
+	std::thread		m_thread;
+};
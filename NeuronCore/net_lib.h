@@ -6,7 +6,11 @@
 
 #pragma once
 
+#ifdef _WIN32
 #include "net_lib_win32.h"
+#else
+#include "net_lib_linux.h"
+#endif
 
 #define MAX_HOSTNAME_LEN   	256
 #define MAX_PACKET_SIZE  	512
@@ -0,0 +1,63 @@
+#pragma once
+
+// POSIX backend for NetLib (pthreads, epoll, recvmmsg/sendmmsg).
+//
+// Built by CMakeLists.txt at the root, which compiles NetLib alone for
+// Linux (NeuronCoreLinux.h stands in for NeuronCore.h) and runs the NetLib
+// loopback and impairment tests against it.  The _linux.cpp files are
+// excluded from the Windows build.
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+class NetUdpPacket;
+
+#ifndef WINAPI
+#define WINAPI
+#endif
+
+using NetCallBack = unsigned long(*)(NetUdpPacket* data);
+using NetThreadFunc = unsigned long(*)(void* ptr);
+
+// Define portable names for POSIX functions
+#define NetGetLastError() 			errno
+#define NetSleep(a) 				usleep((a) * 1000)
+#define NetCloseSocket 				close
+#define NetGetHostByName 			gethostbyname
+#define NetSetSocketNonBlocking(a) 	fcntl(a, F_SETFL, fcntl(a, F_GETFL, 0) | O_NONBLOCK)
+#define NetFdOpen 					fdopen
+
+// Define portable names for POSIX types
+#define NetSocketLenType 			socklen_t
+#define NetSocketHandle 			int
+#define NetHostDetails				struct hostent
+#define NetThreadHandle 			pthread_t
+#define NetCallBackRetType			unsigned long
+#define NetPollObject 				fd_set
+#define NetMutexHandle 				pthread_mutex_t
+
+// Define portable names for POSIX constants
+#define INVALID_SOCKET 				(-1)
+#define NET_SOCKET_ERROR 			(-1)
+#define NCSD_SEND 					SHUT_WR
+#define NCSD_READ 					SHUT_RD
+#define NET_RECEIVE_FLAG 			0
+
+// Define portable ways to test various conditions
+#define NetIsAddrInUse 				(errno == EADDRINUSE)
+#define NetIsSocketError(a) 		(a == -1)
+#define NetIsBlockingError(a) 		((a == EALREADY) || (a == EWOULDBLOCK) || (a == EAGAIN) || (a == EINPROGRESS))
+#define NetIsConnected(a) 			(a == EISCONN)
+#define NetIsReset(a) 				((a == ECONNRESET) || (a == ESHUTDOWN) || (a == EPIPE))
+
+// The listener drains the socket with epoll + recvmmsg and sends with sendmmsg
+#define NET_BATCHED_IO
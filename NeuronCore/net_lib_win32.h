@@ -11,6 +11,7 @@ using NetThreadFunc = unsigned long(WINAPI *)(void* ptr);
 #define NetCloseSocket 				closesocket
 #define NetGetHostByName 			gethostbyname // Should eventually be getaddrinfo (?)
 #define NetSetSocketNonBlocking(a) 	ioctlsocket(a, FIONBIO, (unsigned long *)0x01)
+#define NetFdOpen 					_fdopen
 
 // Define portable names for Win32 types
 #define NetSocketLenType 			int
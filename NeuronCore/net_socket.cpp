@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "net_socket.h"
+#include "net_impairment.h"
 
 NetSocket::NetSocket()
 {
@@ -9,6 +10,7 @@ NetSocket::NetSocket()
 	m_polltime = 100;
 	m_port = 0;
 	m_ipaddr = 0;
+	m_impairment = nullptr;
 	memset(&m_to, 0, sizeof(m_to));
 	memset(&m_listener, 0, sizeof(m_listener));
 	memset(m_hostname, 0, MAX_HOSTNAME_LEN);
@@ -19,6 +21,10 @@ NetSocket::~NetSocket()
 {
 	if (m_sockfd != INVALID_SOCKET)
 	{
+		if (m_impairment)
+		{
+			m_impairment->Forget(m_sockfd);
+		}
 		NetCloseSocket(m_sockfd);
 		m_sockfd = INVALID_SOCKET;
 	}
@@ -30,7 +36,7 @@ NetRetCode NetSocket::Flush()
 	NetRetCode ret = NetOk;
 	if (!m_stdiofd)
 	{
-		m_stdiofd = _fdopen(m_sockfd, "w");
+		m_stdiofd = NetFdOpen(m_sockfd, "w");
 	}
 	if ((m_stdiofd ==(FILE *)0) || (fflush(m_stdiofd)))
 	{
@@ -100,6 +106,10 @@ void NetSocket::Close()
 {
 	if (m_sockfd != INVALID_SOCKET)
 	{
+		if (m_impairment)
+		{
+			m_impairment->Forget(m_sockfd);
+		}
 		NetCloseSocket(m_sockfd);
 		m_sockfd = INVALID_SOCKET;
 	}
@@ -115,7 +125,7 @@ NetRetCode NetSocket::Connect()
 	int sockType = SOCK_DGRAM;
 	
 	m_sockfd = socket(AF_INET, sockType, 0);
-	if (!m_sockfd)
+	if (m_sockfd == INVALID_SOCKET)
 	{
 		return NetFailed;
 	}
@@ -137,7 +147,7 @@ NetRetCode NetSocket::Connect()
 	}
 	else 
 	{
-		servaddr->sin_addr.s_addr = * ((unsigned long *)pHostent->h_addr_list[0]);
+		memcpy(&servaddr->sin_addr, pHostent->h_addr_list[0], sizeof(servaddr->sin_addr));
 	}
 	//   }
 	
@@ -196,6 +206,17 @@ NetRetCode NetSocket::WriteData(void *bufAsVoid, int bufLen, int *numActualBytes
 	long timeoutSeconds = (long)((m_polltime*1000) / 100000);
 	long timeoutUSeconds = (long)((m_polltime*1000) % 100000);
 	
+	if (m_impairment)
+	{
+		// The impairment sends it, perhaps later, perhaps never
+		m_impairment->Send(m_sockfd, &m_to, buf, bufLen);
+		if (numActualBytes)
+		{
+			*numActualBytes = bufLen;
+		}
+		return NetOk;
+	}
+	
 	while ((bytesLeft > 0) && (!timedout))
 	{
 		FD_ZERO(&m_listener);
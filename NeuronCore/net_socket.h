@@ -10,6 +10,9 @@
 #include "net_lib.h"
 
 
+class NetImpairment;
+
+
 class NetSocket
 {
 protected:
@@ -58,6 +61,10 @@ public:
 	
 	unsigned long		GetIpAddr();
 	
+	// Routes every write through an impairment simulator; nullptr sends
+	// directly.  The impairment must outlive the socket
+	void				SetImpairment(NetImpairment *impairment) { m_impairment = impairment; }
+	
 protected:
 	NetRetCode			CheckTimeout(unsigned int *timeout,	unsigned int *timedout,	int haveAllData);
 	
@@ -65,6 +72,7 @@ protected:
 	NetPollObject		m_listener;
 	FILE				*m_stdiofd;
 	NetIpAddress		m_to;
+	NetImpairment		*m_impairment;
 	unsigned long		m_ipaddr;
 	unsigned int		m_timeout;
 	unsigned int		m_polltime;
@@ -1,58 +1,74 @@
 #include "pch.h"
 #include "net_lib.h"
+#include "net_impairment.h"
 #include "net_socket_listener.h"
 #include "net_udp_packet.h"
 
 
-NetSocketListener::NetSocketListener(unsigned short port)
+#define NET_POLL_TIMEOUT	250		// ms between checks of m_listening
+#define NET_SOCKET_BUFFER	(1024 * 1024)	// One socket carries every client's traffic
+
+
+NetSocketListener::NetSocketListener(unsigned short port, const char *bindAddress)
 {
+	m_sockfd = INVALID_SOCKET;
 	m_port = port;
 	m_listening = 0;
+	m_impairment = nullptr;
+	memset(m_bindAddress, 0, sizeof(m_bindAddress));
+	if (bindAddress)
+	{
+		strncpy(m_bindAddress, bindAddress, sizeof(m_bindAddress) - 1);
+	}
 }
 
 
 NetSocketListener::~NetSocketListener()
 {
-	NetCloseSocket(m_sockfd);
+	if (m_sockfd != INVALID_SOCKET)
+	{
+		if (m_impairment)
+		{
+			m_impairment->Forget(m_sockfd);
+		}
+		NetCloseSocket(m_sockfd);
+	}
 }
 
 
-NetRetCode NetSocketListener::StartListening(NetCallBack functionPointer)
+NetRetCode NetSocketListener::Bind()
 {
-	NetRetCode ret = NetOk;
+	if (m_sockfd != INVALID_SOCKET)
+	{
+		return NetOk;
+	}
+	
 	int bindAttempts = 0;
 	NetIpAddress servaddr;
-	NetIpAddress clientaddr;
-
 	memset(&servaddr, 0, sizeof(servaddr));
-	memset(&clientaddr, 0, sizeof(clientaddr));
 	
-	if (!(m_sockfd = socket(AF_INET, SOCK_DGRAM, 0)))
+	if ((m_sockfd = socket(AF_INET, SOCK_DGRAM, 0)) == INVALID_SOCKET)
 	{
 		return NetFailed;
 	}
 	
-	NetSocketHandle client = 0;
-
 	servaddr.sin_family = AF_INET;
 	servaddr.sin_addr.s_addr = htonl(INADDR_ANY);
 	servaddr.sin_port = htons(m_port);
-	
-	// Make sure incoming arguments make sense
-	if (functionPointer == nullptr)
+	if (m_bindAddress[0] && inet_pton(AF_INET, m_bindAddress, &servaddr.sin_addr) != 1)
 	{
+		NetCloseSocket(m_sockfd);
+		m_sockfd = INVALID_SOCKET;
 		return NetBadArgs;
 	}
 	
-	// Signal that we should be listening
-	m_listening = 1;
-	
 	// Bind socket to port
-	while ((bind(m_sockfd, (sockaddr *)&servaddr, sizeof(servaddr)) == -1) &&
-		   m_listening)
+	while (bind(m_sockfd, (sockaddr *)&servaddr, sizeof(servaddr)) == -1)
 	{
 		if ((bindAttempts++ == 10) || (!NetIsAddrInUse))
 		{
+			NetCloseSocket(m_sockfd);
+			m_sockfd = INVALID_SOCKET;
 			return NetFailed;
 		}
 		else
@@ -62,35 +78,298 @@ NetRetCode NetSocketListener::StartListening(NetCallBack functionPointer)
 		}
 	}
 	
-	int datasize = 0;
+	int bufferSize = NET_SOCKET_BUFFER;
+	setsockopt(m_sockfd, SOL_SOCKET, SO_RCVBUF, (const char *)&bufferSize, sizeof(bufferSize));
+	setsockopt(m_sockfd, SOL_SOCKET, SO_SNDBUF, (const char *)&bufferSize, sizeof(bufferSize));
+	
+#ifdef NET_BATCHED_IO
+	// One nonblocking socket serves every client; epoll tells us when to drain it
+	NetSetSocketNonBlocking(m_sockfd);
+#endif
+	
+	return NetOk;
+}
+
+
+NetRetCode NetSocketListener::StartListening(NetCallBack functionPointer)
+{
+	// Make sure incoming arguments make sense
+	if (functionPointer == nullptr)
+	{
+		return NetBadArgs;
+	}
+	
+	if (Bind() != NetOk)
+	{
+		return NetFailed;
+	}
+	
+	// Signal that we should be listening
+	m_listening = 1;
+	
+	return ReceiveLoop(functionPointer);
+}
+
+
+#ifdef NET_BATCHED_IO
+
+// Waits on epoll and drains the socket NET_RECEIVE_BATCH datagrams per
+// system call, receiving straight into pooled packets.
+NetRetCode NetSocketListener::ReceiveLoop(NetCallBack functionPointer)
+{
+	int epollfd = epoll_create1(0);
+	if (epollfd == -1)
+	{
+		return NetFailed;
+	}
+	
+	struct epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.fd = m_sockfd;
+	if (epoll_ctl(epollfd, EPOLL_CTL_ADD, m_sockfd, &event) == -1)
+	{
+		close(epollfd);
+		return NetFailed;
+	}
+	
+	NetUdpPacket *packets[NET_RECEIVE_BATCH] = {};
+	struct mmsghdr messages[NET_RECEIVE_BATCH];
+	struct iovec iovecs[NET_RECEIVE_BATCH];
+	
+	while (m_listening)
+	{
+		if (epoll_wait(epollfd, &event, 1, NET_POLL_TIMEOUT) <= 0)
+			continue;
+		
+		while (m_listening)
+		{
+			memset(messages, 0, sizeof(messages));
+			for (int i = 0; i < NET_RECEIVE_BATCH; ++i)
+			{
+				if (!packets[i])
+					packets[i] = new NetUdpPacket();
+				
+				iovecs[i].iov_base = packets[i]->m_data;
+				iovecs[i].iov_len = MAX_PACKET_SIZE;
+				messages[i].msg_hdr.msg_name = &packets[i]->m_clientAddress;
+				messages[i].msg_hdr.msg_namelen = sizeof(NetIpAddress);
+				messages[i].msg_hdr.msg_iov = &iovecs[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+			
+			int received = recvmmsg(m_sockfd, messages, NET_RECEIVE_BATCH, MSG_DONTWAIT, nullptr);
+			if (received <= 0)
+				break;	// Drained (EAGAIN) or error; go back to epoll
+			
+			for (int i = 0; i < received; ++i)
+			{
+				if (messages[i].msg_len == 0)
+					continue;
+				
+				// The function pointed to must free the NetUdpPacket passed in
+				packets[i]->m_sockfd = m_sockfd;
+				packets[i]->m_length = static_cast<int>(messages[i].msg_len);
+				(*functionPointer)(packets[i]);
+				packets[i] = nullptr;
+			}
+			
+			if (received < NET_RECEIVE_BATCH)
+				break;
+		}
+	}
+	
+	for (int i = 0; i < NET_RECEIVE_BATCH; ++i)
+	{
+		delete packets[i];
+	}
+	close(epollfd);
+	
+	return NetOk;
+}
+
+
+int NetSocketListener::SendBatch(const NetDatagram *datagrams, int count)
+{
+	if (m_impairment)
+	{
+		return SendImpaired(datagrams, count);
+	}
+	
+	struct mmsghdr messages[NET_SEND_BATCH];
+	struct iovec iovecs[NET_SEND_BATCH];
+	int sent = 0;
+	int retries = 0;
+	
+	while (sent < count)
+	{
+		int batch = std::min(count - sent, NET_SEND_BATCH);
+		memset(messages, 0, sizeof(messages[0]) * batch);
+		for (int i = 0; i < batch; ++i)
+		{
+			const NetDatagram &datagram = datagrams[sent + i];
+			iovecs[i].iov_base = const_cast<char *>(datagram.m_data);
+			iovecs[i].iov_len = datagram.m_length;
+			messages[i].msg_hdr.msg_name = const_cast<NetIpAddress *>(datagram.m_to);
+			messages[i].msg_hdr.msg_namelen = sizeof(NetIpAddress);
+			messages[i].msg_hdr.msg_iov = &iovecs[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+		
+		int result = sendmmsg(m_sockfd, messages, batch, 0);
+		if (result < 0)
+		{
+			int err = NetGetLastError();
+			if (!NetIsBlockingError(err) || retries++ == 10)
+			{
+				DebugTrace("SendBatch failed: {}", err);
+				break;
+			}
+			
+			// Send buffer full; wait briefly for it to drain
+			struct pollfd pfd = { m_sockfd, POLLOUT, 0 };
+			poll(&pfd, 1, 10);
+			continue;
+		}
+		
+		sent += result;
+	}
+	
+	return sent;
+}
+
+#else
+
+NetRetCode NetSocketListener::ReceiveLoop(NetCallBack functionPointer)
+{
+	NetIpAddress clientaddr;
+	NetPollObject readSet;
+	struct timeval timeVal;
 	char buf[MAX_PACKET_SIZE];
-	NetSocketLenType cliLen = sizeof(clientaddr);
 	
 	while (m_listening)
 	{
-		memset(buf, 0, MAX_PACKET_SIZE * sizeof(char));
-		datasize = recvfrom(m_sockfd, buf, MAX_PACKET_SIZE, 0,
-							(struct sockaddr *)&clientaddr, &cliLen);
+		// Poll rather than block so that StopListening takes effect
+		FD_ZERO(&readSet);
+		FD_SET(m_sockfd, &readSet);
+		timeVal.tv_sec = 0;
+		timeVal.tv_usec = NET_POLL_TIMEOUT * 1000;
+		if (select(static_cast<int>(m_sockfd) + 1, &readSet, nullptr, nullptr, &timeVal) <= 0)
+			continue;
+		
+		NetSocketLenType cliLen = sizeof(clientaddr);
+		int datasize = recvfrom(m_sockfd, buf, MAX_PACKET_SIZE, 0,
+								(struct sockaddr *)&clientaddr, &cliLen);
 		
 		if (datasize <= 0)
 			continue;
 
 		// Call function pointer with datagram data (type is NetUdpPacket) -
 		// the function pointed to must free NetUdpPacket passed in
-		auto packet = std::make_unique<NetUdpPacket>(client, &clientaddr, buf, datasize);
+		auto packet = std::make_unique<NetUdpPacket>(static_cast<int>(m_sockfd), &clientaddr, buf, datasize);
 		(*functionPointer)(packet.release());
-		if (!m_listening) break;
 	}
 	
-	return ret;
+	return NetOk;
+}
+
+
+int NetSocketListener::SendBatch(const NetDatagram *datagrams, int count)
+{
+	if (m_impairment)
+	{
+		return SendImpaired(datagrams, count);
+	}
+	
+	int sent = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		if (SendTo(datagrams[i].m_to, datagrams[i].m_data, datagrams[i].m_length) != NetOk)
+			break;
+		++sent;
+	}
+	return sent;
+}
+
+#endif
+
+
+NetRetCode NetSocketListener::SendTo(const NetIpAddress *to, const void *buf, int bufLen)
+{
+	if (m_impairment)
+	{
+		NetDatagram datagram = { to, static_cast<const char *>(buf), bufLen };
+		return (SendImpaired(&datagram, 1) == 1) ? NetOk : NetFailed;
+	}
+	
+#ifdef NET_BATCHED_IO
+	NetDatagram datagram = { to, static_cast<const char *>(buf), bufLen };
+	return (SendBatch(&datagram, 1) == 1) ? NetOk : NetFailed;
+#else
+	if (m_sockfd == INVALID_SOCKET)
+	{
+		return NetFailed;
+	}
+	int bytesSent = sendto(m_sockfd, static_cast<const char *>(buf), bufLen, 0,
+						   (const struct sockaddr *)to, sizeof(NetIpAddress));
+	return (bytesSent == bufLen) ? NetOk : NetFailed;
+#endif
+}
+
+
+int NetSocketListener::SendImpaired(const NetDatagram *datagrams, int count)
+{
+	if (m_sockfd == INVALID_SOCKET)
+	{
+		return 0;
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		m_impairment->Send(m_sockfd, datagrams[i].m_to, datagrams[i].m_data, datagrams[i].m_length);
+	}
+	return count;
+}
+
+
+NetUdpPacket *NetSocketListener::Poll()
+{
+	if (m_sockfd == INVALID_SOCKET)
+	{
+		return nullptr;
+	}
+	
+#ifndef NET_BATCHED_IO
+	// The socket blocks, so only read it once select says there is something to read
+	NetPollObject readSet;
+	struct timeval timeVal = { 0, 0 };
+	FD_ZERO(&readSet);
+	FD_SET(m_sockfd, &readSet);
+	if (select(static_cast<int>(m_sockfd) + 1, &readSet, nullptr, nullptr, &timeVal) <= 0)
+	{
+		return nullptr;
+	}
+#endif
+	
+	auto packet = std::make_unique<NetUdpPacket>();
+	NetSocketLenType fromLen = sizeof(NetIpAddress);
+	int datasize = recvfrom(m_sockfd, packet->m_data, MAX_PACKET_SIZE, 0,
+							(struct sockaddr *)&packet->m_clientAddress, &fromLen);
+	if (datasize <= 0)
+	{
+		return nullptr;
+	}
+	
+	packet->m_sockfd = static_cast<int>(m_sockfd);
+	packet->m_length = datasize;
+	return packet.release();
 }
 
    
 void NetSocketListener::StopListening()
 {
 	m_listening = 0;
-	NetSleep(250);
-	if (m_sockfd)
+	NetSleep(NET_POLL_TIMEOUT);
+	if (m_sockfd != INVALID_SOCKET)
 	{
 		shutdown(m_sockfd, 0);
 	}
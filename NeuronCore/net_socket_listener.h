@@ -1,6 +1,10 @@
 // ****************************************************************************
-// A UDP socket listener implementation. This class blocks until data is
-// received, so you probably want to put it in its own thread.
+// A UDP socket listener implementation. This class blocks until listening is
+// stopped, so you probably want to put it in its own thread.
+//
+// The listening socket can also send: a server bound to one port can reply
+// to every client through it, batching the datagrams with SendBatch.  A
+// socket its owner polls with Poll needs no listen thread at all.
 // ****************************************************************************
 
 #pragma once
@@ -9,20 +13,55 @@
 #include "net_lib.h"
 
 
+struct NetDatagram;
+class NetImpairment;
+class NetUdpPacket;
+
+
+#define NET_RECEIVE_BATCH	32		// Datagrams drained per recvmmsg call
+#define NET_SEND_BATCH		64		// Datagrams submitted per sendmmsg call
+
+
 class NetSocketListener
 {
 protected:
 	NetSocketHandle 	m_sockfd;
-	int					m_listening;
+	volatile int		m_listening;
 	unsigned short	 	m_port;
+	char				m_bindAddress[16];		// Empty for INADDR_ANY
+	NetImpairment		*m_impairment;
+
+	NetRetCode	ReceiveLoop(NetCallBack fnptr);
+	int			SendImpaired(const NetDatagram *datagrams, int count);
 
 public:
-	NetSocketListener(unsigned short port);
+	// bindAddress is a dotted IP, or nullptr to listen on every interface
+	NetSocketListener(unsigned short port, const char *bindAddress = nullptr);
 	~NetSocketListener();
 	
+	// Creates the socket and binds it to the port. Called by StartListening
+	// if needed; call it up front to send before the listen thread starts
+	NetRetCode	Bind();
+	
 	NetRetCode	StartListening(NetCallBack fnptr);
 	
-	// Stops the listener after next (non-blocking) accept call
+	// Stops the listener after the next receive poll times out
 	void		StopListening();
+	
+	// Receives one waiting datagram without blocking; the caller deletes it.
+	// Returns nullptr if none is waiting.  Not for use while listening
+	NetUdpPacket	*Poll();
+	
+	// Sends one datagram from the listening socket
+	NetRetCode	SendTo(const NetIpAddress *to, const void *buf, int bufLen);
+	
+	// Sends datagrams with as few system calls as the platform allows.
+	// Returns the number of datagrams handed to the network stack
+	int			SendBatch(const NetDatagram *datagrams, int count);
+	
+	// Routes every send through an impairment simulator; nullptr sends
+	// directly.  The impairment must outlive the listener
+	void		SetImpairment(NetImpairment *impairment) { m_impairment = impairment; }
+	
+	unsigned short	GetPort() const { return m_port; }
 };
-
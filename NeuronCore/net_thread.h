@@ -7,5 +7,6 @@
 #include "net_lib.h"
 
 
-NetRetCode NetStartThread(NetThreadFunc functionPointer);
+// argument is passed through to functionPointer
+NetRetCode NetStartThread(NetThreadFunc functionPointer, void *argument = nullptr);
 
@@ -0,0 +1,40 @@
+#include "pch.h"
+#include "net_thread.h"
+
+
+struct NetThreadStart
+{
+	NetThreadFunc	m_function;
+	void			*m_argument;
+};
+
+
+// pthreads expects void *(*)(void *); adapt the NetLib thread signature
+static void *NetThreadTrampoline(void *start)
+{
+	NetThreadStart call = *static_cast<NetThreadStart *>(start);
+	delete static_cast<NetThreadStart *>(start);
+	call.m_function(call.m_argument);
+	return nullptr;
+}
+
+
+NetRetCode NetStartThread(NetThreadFunc functionPtr, void *argument)
+{
+	NetRetCode retVal = NetOk;
+	pthread_t thread;
+	
+	auto start = new NetThreadStart{functionPtr, argument};
+	if (pthread_create(&thread, nullptr, NetThreadTrampoline, start) != 0)
+	{
+		delete start;
+		DebugTrace("Thread creation failed");
+		retVal = NetFailed;
+	}
+	else
+	{
+		pthread_detach(thread);
+	}
+
+	return retVal;
+}
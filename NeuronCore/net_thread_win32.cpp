@@ -2,12 +2,12 @@
 #include "net_thread.h"
 
 
-NetRetCode NetStartThread(NetThreadFunc functionPtr)
+NetRetCode NetStartThread(NetThreadFunc functionPtr, void *argument)
 {
 	NetRetCode retVal = NetOk;
 	DWORD dwID = 0;
 	
-	if (CreateThread(nullptr, 0, functionPtr, nullptr, 0, &dwID) == nullptr)
+	if (CreateThread(nullptr, 0, functionPtr, argument, 0, &dwID) == nullptr)
 	{
 		DebugTrace("Thread creation failed");
 		retVal = NetFailed;
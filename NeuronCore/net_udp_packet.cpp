@@ -1,6 +1,21 @@
 #include "pch.h"
+#include <mutex>
 #include "net_udp_packet.h"
 
+namespace
+{
+  std::mutex s_poolMutex;
+  void* s_pool[NET_PACKET_POOL_SIZE];
+  int s_poolSize = 0;
+}
+
+NetUdpPacket::NetUdpPacket()
+  : m_sockfd(0),
+    m_length(0)
+{
+  memset(&m_clientAddress, 0, sizeof(NetIpAddress));
+}
+
 NetUdpPacket::NetUdpPacket(int sockfd, NetIpAddress* clientAddress, char* buf, int len)
   : m_sockfd(sockfd)
 {
@@ -8,3 +23,29 @@ NetUdpPacket::NetUdpPacket(int sockfd, NetIpAddress* clientAddress, char* buf, i
   memcpy(&m_clientAddress, clientAddress, sizeof(NetIpAddress));
   memcpy(m_data, buf, m_length * sizeof(char));
 }
+
+void* NetUdpPacket::operator new(size_t size)
+{
+  DEBUG_ASSERT(size == sizeof(NetUdpPacket));
+  {
+    std::scoped_lock lock(s_poolMutex);
+    if (s_poolSize > 0)
+      return s_pool[--s_poolSize];
+  }
+  return ::operator new(size);
+}
+
+void NetUdpPacket::operator delete(void* ptr)
+{
+  if (!ptr)
+    return;
+  {
+    std::scoped_lock lock(s_poolMutex);
+    if (s_poolSize < NET_PACKET_POOL_SIZE)
+    {
+      s_pool[s_poolSize++] = ptr;
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
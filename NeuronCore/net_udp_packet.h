@@ -3,19 +3,38 @@
 
 // ****************************************************************************
 //  An object containing a single UDP datagram
+//
+//  Packets are allocated from a process-wide free list rather than the heap:
+//  the listener hands one to the callback per datagram and the callback
+//  deletes it, so steady-state receive does no heap allocation.
 // ****************************************************************************
 
 #include "net_lib.h"
 
 
+#define NET_PACKET_POOL_SIZE	256		// Free packets retained for reuse
+
+
 class NetUdpPacket
 {
 public:
+	NetUdpPacket();
 	NetUdpPacket(int sockfd, NetIpAddress *clientaddr, char *buf, int len);
 	
+	static void		*operator new(size_t size);
+	static void		operator delete(void *ptr);
+	
 	int 			m_sockfd;
 	int 			m_length;
 	NetIpAddress	m_clientAddress;
 	char 			m_data[MAX_PACKET_SIZE];
 };
 
+
+// A datagram to be sent, referencing caller-owned data
+struct NetDatagram
+{
+	const NetIpAddress	*m_to;
+	const char			*m_data;
+	int					m_length;
+};
@@ -1,5 +1,9 @@
 #pragma once
 
+#ifdef _WIN32
 #pragma warning(disable:4244) // TODO: Remove after fixing C4244 warnings in this project
 
 #include "NeuronCore.h"
+#else
+#include "NeuronCoreLinux.h"
+#endif
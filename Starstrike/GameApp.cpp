@@ -1,4 +1,5 @@
 #include "pch.h"
+#include "JobSystem.h"
 #include "clienttoserver.h"
 #include "language_table.h"
 #include "preferences.h"
@@ -13,6 +14,7 @@
 #include "soundsystem.h"
 #include "GameApp.h"
 #include "camera.h"
+#include "explosion.h"
 #include "global_world.h"
 #include "location.h"
 #include "particle_system.h"
@@ -37,7 +39,8 @@ GameApp::GameApp()
 
   g_prefsManager = new PrefsManager(GetPreferencesPath());
 
-  m_bypassNetworking = g_prefsManager->GetInt("BypassNetwork") ? true : false;
+  // The net load test hosts its own server and bots, which need the ports
+  m_bypassNetworking = g_prefsManager->GetInt("BypassNetwork") || g_prefsManager->GetInt("NetLoadTestBots", 0) > 0;
 
   m_backgroundColour.Set(0, 0, 0, 0);
 
@@ -47,6 +50,8 @@ GameApp::GameApp()
   m_profiler = new Profiler();
 #endif
 
+  m_jobSystem = new JobSystem();
+
   m_renderer = new Renderer();
   m_renderer->Initialise();
 
@@ -82,6 +87,7 @@ GameApp::GameApp()
   SetProfileName(g_prefsManager->GetString("UserProfile", "none"));
 
   m_particleSystem = new ParticleSystem();
+  m_explosionManager = new ExplosionManager();
   m_taskManager = new TaskManager();
   m_script = new Script();
   
@@ -106,6 +112,7 @@ GameApp::~GameApp()
   SAFE_DELETE(m_taskManagerInterface);
   SAFE_DELETE(m_script);
   SAFE_DELETE(m_taskManager);
+  SAFE_DELETE(m_explosionManager);
   SAFE_DELETE(m_particleSystem);
   SAFE_DELETE(m_camera);
   SAFE_DELETE(m_userInput);
@@ -117,6 +124,7 @@ GameApp::~GameApp()
 #ifdef PROFILER_ENABLED
   SAFE_DELETE(m_profiler);
 #endif
+  SAFE_DELETE(m_jobSystem);
   SAFE_DELETE(g_prefsManager);
 }
 
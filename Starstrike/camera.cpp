@@ -118,6 +118,28 @@ void Camera::Get2DScreenPos(const LegacyVector3& _vector, float* _screenX, float
   *_screenY = outY;
 }
 
+void Camera::Get2DScreenPositions(const LegacyVector3* _vectors, int _count, float* _screenX, float* _screenY)
+{
+  static_assert(sizeof(LegacyVector3) == 3 * sizeof(float));
+  if (_count <= 0)
+    return;
+
+  int viewport[4];
+  double viewMatrix[16];
+  double projMatrix[16];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+
+  const auto& mvTop = OpenGLD3D::GetModelViewStack().GetTop();
+  const auto& prTop = OpenGLD3D::GetProjectionStack().GetTop();
+  for (int i = 0; i < 16; i++)
+  {
+    viewMatrix[i] = reinterpret_cast<const float*>(&mvTop)[i];
+    projMatrix[i] = reinterpret_cast<const float*>(&prTop)[i];
+  }
+
+  gluProjectPoints(_count, &_vectors[0].x, viewMatrix, projMatrix, viewport, _screenX, _screenY);
+}
+
 void Camera::SetHeight(float _height) { m_height = _height; }
 
 void Camera::SetFOV(float _fov)
@@ -505,12 +527,18 @@ float Camera::DistanceToBlockage(const LegacyVector3& _dir, const float _maxDist
 
   constexpr unsigned int numSteps = 40;
   const float distStep = _maxDist / static_cast<float>(numSteps);
+
+  float xs[numSteps], zs[numSteps], landHeights[numSteps];
   for (int i = 1; i <= numSteps; ++i)
   {
-    float x = m_pos.x + _dir.x * distStep * static_cast<float>(i);
-    float z = m_pos.z + _dir.z * distStep * static_cast<float>(i);
-    float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue(x, z);
-    if (landHeight + MIN_GROUND_CLEARANCE > m_height)
+    xs[i - 1] = m_pos.x + _dir.x * distStep * static_cast<float>(i);
+    zs[i - 1] = m_pos.z + _dir.z * distStep * static_cast<float>(i);
+  }
+  g_context->m_location->m_landscape.m_heightMap->GetValues(xs, zs, landHeights, numSteps);
+
+  for (int i = 1; i <= numSteps; ++i)
+  {
+    if (landHeights[i - 1] + MIN_GROUND_CLEARANCE > m_height)
       return static_cast<float>(i) * distStep;
   }
 
@@ -1146,23 +1174,29 @@ void Camera::GetHighestTangentPoint(const LegacyVector3& _from, const LegacyVect
   const float deltaX = distStep * dir.x;
   const float deltaZ = distStep * dir.z;
 
+  float xs[numSteps], zs[numSteps], landHeights[numSteps];
+  for (int i = 0; i < numSteps; ++i)
+  {
+    x += deltaX;
+    z += deltaZ;
+    xs[i] = x;
+    zs[i] = z;
+  }
+  g_context->m_location->m_landscape.m_heightMap->GetValues(xs, zs, landHeights, numSteps);
+
   float maxGradient = 0.0f;
   float distanceTravelled = 0.0f;
 
-  for (int i = 1; i <= numSteps; ++i)
+  for (int i = 0; i < numSteps; ++i)
   {
-    x += deltaX;
-    z += deltaZ;
     distanceTravelled += distStep;
 
-    float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue(x, z);
-
-    float gradient = (landHeight - _from.y) / distanceTravelled;
+    float gradient = (landHeights[i] - _from.y) / distanceTravelled;
 
     if (gradient > maxGradient)
     {
       maxGradient = gradient;
-      location.Set(x, landHeight, z);
+      location.Set(xs[i], landHeights[i], zs[i]);
     }
   }
 }
@@ -1174,17 +1208,22 @@ void Camera::GetHighestPoint(const LegacyVector3& _from, const LegacyVector3& _t
 
   LegacyVector3 dir = (_to - _from).Normalise();
 
+  float xs[numSteps], zs[numSteps], landHeights[numSteps];
+  for (int i = 1; i <= numSteps; ++i)
+  {
+    xs[i - 1] = _from.x + dir.x * distStep * static_cast<float>(i);
+    zs[i - 1] = _from.z + dir.z * distStep * static_cast<float>(i);
+  }
+  g_context->m_location->m_landscape.m_heightMap->GetValues(xs, zs, landHeights, numSteps);
+
   float maxHeight = 0.0f;
 
-  for (int i = 1; i <= numSteps; ++i)
+  for (int i = 0; i < numSteps; ++i)
   {
-    float x = _from.x + dir.x * distStep * static_cast<float>(i);
-    float z = _from.z + dir.z * distStep * static_cast<float>(i);
-    float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue(x, z);
-    if (landHeight > maxHeight)
+    if (landHeights[i] > maxHeight)
     {
-      maxHeight = landHeight;
-      location.Set(x, landHeight, z);
+      maxHeight = landHeights[i];
+      location.Set(xs[i], landHeights[i], zs[i]);
     }
   }
 }
@@ -1211,15 +1250,23 @@ float Camera::DirectDistanceToBlockage(const LegacyVector3& _from, const LegacyV
   const float deltaY = distStep * dir.y;
   const float deltaZ = distStep * dir.z;
 
-  for (int i = 1; i <= numSteps; ++i)
+  // The whole ray in one batch; sampling past a blockage costs less than
+  // stopping at it one point at a time
+  float xs[numSteps], zs[numSteps], landHeights[numSteps];
+  for (int i = 0; i < numSteps; ++i)
   {
     x += deltaX;
-    y += deltaY;
     z += deltaZ;
+    xs[i] = x;
+    zs[i] = z;
+  }
+  g_context->m_location->m_landscape.m_heightMap->GetValues(xs, zs, landHeights, numSteps);
 
-    float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue(x, z);
+  for (int i = 1; i <= numSteps; ++i)
+  {
+    y += deltaY;
 
-    if (landHeight > y)
+    if (landHeights[i - 1] > y)
       return static_cast<float>(i) * distStep;
   }
 
@@ -194,6 +194,7 @@ class Camera
 
     void GetClickRay(int _x, int _y, LegacyVector3* _rayStart, LegacyVector3* _rayDir);
     void Get2DScreenPos(const LegacyVector3& _vector, float* _screenX, float* _screenY);
+    void Get2DScreenPositions(const LegacyVector3* _vectors, int _count, float* _screenX, float* _screenY); // Same results, one matrix fetch
 
     void SetBounds(float _minX, float _maxX, float _minZ, float _maxZ);
 
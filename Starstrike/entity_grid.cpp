@@ -7,141 +7,8 @@
 #include "location.h"
 #include "team.h"
 
-#define END_OF_LIST -100000
-
-// ****************************************************************************
-//  Class EntityGridCell
-// ****************************************************************************
-
-#define INITIAL_OBJECT_ID_ARRAY_SIZE	0
-
 unsigned int g_counter = 0;
 
-class EntityGridCell
-{
-  public:
-    int m_numSlotsFree;
-    int m_firstFree;
-
-    void OutputContents();
-
-    WorldObjectId* m_objectIds;
-    int* m_usageLists;
-    int m_arraySize;
-
-    EntityGridCell();
-    ~EntityGridCell();
-    void AddObjectId(WorldObjectId _objectId);
-    bool RemoveObjectId(WorldObjectId _objectId);
-};
-
-// *** Constructor
-EntityGridCell::EntityGridCell()
-  : m_numSlotsFree(INITIAL_OBJECT_ID_ARRAY_SIZE),
-    m_firstFree(END_OF_LIST),
-    m_arraySize(INITIAL_OBJECT_ID_ARRAY_SIZE)
-{
-  m_objectIds = nullptr;
-  m_usageLists = nullptr;
-}
-
-// *** Destructor
-EntityGridCell::~EntityGridCell()
-{
-  delete [] m_objectIds;
-  delete [] m_usageLists;
-}
-
-// *** OutputContents
-void EntityGridCell::OutputContents()
-{
-  char buffer[256];
-  snprintf(buffer, sizeof(buffer), "Grid Cell: ");
-  int i;
-  for (i = 0; i < m_arraySize; i++)
-  {
-    char buf2[128];
-    snprintf(buf2, sizeof(buf2), "%d ", m_usageLists[i]);
-    strncat(buffer, buf2, sizeof(buffer) - strlen(buffer) - 1);
-  }
-  strncat(buffer, "\n", sizeof(buffer) - strlen(buffer) - 1);
-  DebugTrace(buffer);
-}
-
-// *** AddObjectId
-void EntityGridCell::AddObjectId(WorldObjectId _objectId)
-{
-  //    OutputContents();
-
-  if (m_firstFree == END_OF_LIST)
-  {
-    DEBUG_ASSERT(m_numSlotsFree == 0);
-
-    int newArraySize = m_arraySize * 2;
-    if (m_arraySize == 0)
-    {
-      newArraySize = 2;
-      m_numSlotsFree = 2;
-    }
-    else
-      m_numSlotsFree = m_arraySize;
-    auto newObjectIds = new WorldObjectId[newArraySize];
-    auto newUsageLists = new int[newArraySize];
-
-    // Copy data from old array into first half of new array
-    for (int i = 0; i < m_arraySize; ++i)
-    {
-      newObjectIds[i] = m_objectIds[i];
-      newUsageLists[i] = m_usageLists[i];
-    }
-
-    // Fill the second half of the new usage array with free list entries
-    for (int i = m_arraySize; i < newArraySize - 1; ++i)
-      newUsageLists[i] = i + 1;
-    newUsageLists[newArraySize - 1] = END_OF_LIST;
-
-    // Throw away old arrays and update everything to reference the new one
-    delete [] m_objectIds;
-    delete [] m_usageLists;
-    m_firstFree = m_arraySize;
-    m_objectIds = newObjectIds;
-    m_usageLists = newUsageLists;
-    m_arraySize = newArraySize;
-  }
-
-  int target = m_firstFree;
-
-  DEBUG_ASSERT(target >= 0);
-  DEBUG_ASSERT(target < m_arraySize);
-
-  m_firstFree = m_usageLists[target];
-
-  m_objectIds[target] = _objectId;
-  m_usageLists[target] = END_OF_LIST;
-  m_numSlotsFree--;
-}
-
-// *** RemoveObject
-bool EntityGridCell::RemoveObjectId(WorldObjectId _objectId)
-{
-  // Search for the slot containing the specified ID
-  bool found = false;
-
-  for (int i = 0; i < m_arraySize; i++)
-  {
-    if (m_objectIds[i] == _objectId)
-    {
-      m_objectIds[i].SetInvalid();
-      m_usageLists[i] = m_firstFree;
-      m_firstFree = i;
-      m_numSlotsFree++;
-      found = true;
-    }
-  }
-
-  return found;
-}
-
 // ****************************************************************************
 //  Class EntityGrid
 // ****************************************************************************
@@ -179,7 +46,7 @@ EntityGrid::EntityGrid(float _cellSizeX, float _cellSizeZ)
   EnsureMaxNeighbours(100);
 
   for (int t = 0; t < NUM_TEAMS; ++t)
-    m_cells[t] = new EntityGridCell[m_numCellsX * m_numCellsZ];
+    m_cells[t].Initialise(m_numCellsX, m_numCellsZ);
 
   //	SetNewReportingThreshold(-1);
 }
@@ -199,11 +66,7 @@ void EntityGrid::EnsureMaxNeighbours(int _maxNeighbours)
 }
 
 // *** Destructor
-EntityGrid::~EntityGrid()
-{
-  for (int t = 0; t < NUM_TEAMS; ++t)
-    delete [] m_cells[t];
-}
+EntityGrid::~EntityGrid() {}
 
 // *** GetGridIndexX
 int EntityGrid::GetGridIndexX(float _worldX) { return static_cast<int>(_worldX * m_cellSizeXRecip); }
@@ -222,10 +85,18 @@ EntityGridCell* EntityGrid::GetCell(float _worldX, float _worldZ, int _team)
 // *** GetCell
 EntityGridCell* EntityGrid::GetCell(int _indexX, int _indexZ, int _team)
 {
-  DEBUG_ASSERT(_indexX >= 0 && _indexX < m_numCellsX);
-  DEBUG_ASSERT(_indexZ >= 0 && _indexZ < m_numCellsZ);
+  return &m_cells[_team].GetCell(_indexX, _indexZ);
+}
 
-  return &m_cells[_team][_indexZ * m_numCellsX + _indexX];
+// *** GetCellRect
+Neuron::CellRect EntityGrid::GetCellRect(float _worldX, float _worldZ, float _radius)
+{
+  Neuron::CellRect rect;
+  rect.m_minX = std::max(0, GetGridIndexX(_worldX - _radius / 2));
+  rect.m_maxX = std::min(m_numCellsX - 1, GetGridIndexX(_worldX + _radius / 2));
+  rect.m_minZ = std::max(0, GetGridIndexZ(_worldZ - _radius / 2));
+  rect.m_maxZ = std::min(m_numCellsZ - 1, GetGridIndexZ(_worldZ + _radius / 2));
+  return rect;
 }
 
 // *** AddObject
@@ -243,26 +114,7 @@ void EntityGrid::AddObject(WorldObjectId _objectID, float _worldX, float _worldZ
     gridCell->AddObjectId(_objectID);
   }
   else
-  {
-    int leftMostCell = GetGridIndexX(_worldX - _radius / 2);
-    int rightMostCell = GetGridIndexX(_worldX + _radius / 2);
-    int upMostCell = GetGridIndexZ(_worldZ - _radius / 2);
-    int downMostCell = GetGridIndexZ(_worldZ + _radius / 2);
-
-    leftMostCell = std::max(0, leftMostCell);
-    rightMostCell = std::min(m_numCellsX - 1, rightMostCell);
-    upMostCell = std::max(0, upMostCell);
-    downMostCell = std::min(m_numCellsZ - 1, downMostCell);
-
-    for (int x = leftMostCell; x <= rightMostCell; ++x)
-    {
-      for (int z = upMostCell; z <= downMostCell; ++z)
-      {
-        EntityGridCell* ogc = GetCell(x, z, teamId);
-        ogc->AddObjectId(_objectID);
-      }
-    }
-  }
+    m_cells[teamId].AddId(_objectID, GetCellRect(_worldX, _worldZ, _radius));
 }
 
 // *** RemoveObject
@@ -283,44 +135,58 @@ void EntityGrid::RemoveObject(WorldObjectId _objectID, float _worldX, float _wor
   }
   else
   {
-    int leftMostCell = GetGridIndexX(_worldX - _radius / 2);
-    int rightMostCell = GetGridIndexX(_worldX + _radius / 2);
-    int upMostCell = GetGridIndexZ(_worldZ - _radius / 2);
-    int downMostCell = GetGridIndexZ(_worldZ + _radius / 2);
-
-    leftMostCell = std::max(0, leftMostCell);
-    rightMostCell = std::min(m_numCellsX - 1, rightMostCell);
-    upMostCell = std::max(0, upMostCell);
-    downMostCell = std::min(m_numCellsZ - 1, downMostCell);
-
-    for (int x = leftMostCell; x <= rightMostCell; ++x)
+    m_cells[teamId].RemoveId(_objectID, GetCellRect(_worldX, _worldZ, _radius), [&](int _x, int _z)
     {
-      for (int z = upMostCell; z <= downMostCell; ++z)
-      {
-        EntityGridCell* ogc = GetCell(x, z, teamId);
-        bool success = ogc->RemoveObjectId(_objectID);
-        if (!success)
-          LogEntityGridError(_objectID, LegacyVector3(x * m_cellSizeX, 0.0f, z * m_cellSizeZ), 2);
-      }
-    }
+      LogEntityGridError(_objectID, LegacyVector3(_x * m_cellSizeX, 0.0f, _z * m_cellSizeZ), 2);
+    });
   }
 }
 
 // *** UpdateObject
+// Only the cells the object has left or entered are touched; see IdCellGrid.
 void EntityGrid::UpdateObject(WorldObjectId _objectId, float _oldWorldX, float _oldWorldZ, float _newWorldX, float _newWorldZ,
                               float _radius)
 {
+  ++m_updateStats.m_updates;
+
+  if (_radius > 0.0f)
+  {
+    int teamId = _objectId.GetTeamId();
+    if (teamId == 255)
+      return;
+
+    Neuron::CellRect oldCells = GetCellRect(_oldWorldX, _oldWorldZ, _radius);
+    Neuron::CellRect newCells = GetCellRect(_newWorldX, _newWorldZ, _radius);
+    if (oldCells == newCells)
+    {
+      ++m_updateStats.m_unchanged;
+      return;
+    }
+
+    auto moves = m_cells[teamId].MoveId(_objectId, oldCells, newCells, [&](int _x, int _z)
+    {
+      LogEntityGridError(_objectId, LegacyVector3(_x * m_cellSizeX, 0.0f, _z * m_cellSizeZ), 2);
+    });
+    m_updateStats.m_cellsLeft += moves.m_cellsLeft;
+    m_updateStats.m_cellsEntered += moves.m_cellsEntered;
+    return;
+  }
+
   int oldIndexX = GetGridIndexX(_oldWorldX);
   int oldIndexZ = GetGridIndexZ(_oldWorldZ);
 
   int newIndexX = GetGridIndexX(_newWorldX);
   int newIndexZ = GetGridIndexZ(_newWorldZ);
 
-  if (oldIndexX != newIndexX || oldIndexZ != newIndexZ || _radius > 0.0f)
+  if (oldIndexX != newIndexX || oldIndexZ != newIndexZ)
   {
     RemoveObject(_objectId, _oldWorldX, _oldWorldZ, _radius);
     AddObject(_objectId, _newWorldX, _newWorldZ, _radius);
+    ++m_updateStats.m_cellsLeft;
+    ++m_updateStats.m_cellsEntered;
   }
+  else
+    ++m_updateStats.m_unchanged;
 }
 
 // *** GetEnemies
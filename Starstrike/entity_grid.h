@@ -1,11 +1,14 @@
 #pragma once
 
 #include "globals.h"
+#include "CellRect.h"
+#include "IdCellGrid.h"
 
 
-class EntityGridCell;
 class WorldObjectId;
 
+using EntityGridCell = Neuron::IdGridCell<WorldObjectId>;
+
 
 // ****************************************************************************
 //  Class EntityGrid
@@ -13,10 +16,19 @@ class WorldObjectId;
 
 class EntityGrid
 {
+public:
+    struct UpdateStats
+    {
+        int64_t m_updates = 0;
+        int64_t m_unchanged = 0;        // Updates that left the object in the same cells
+        int64_t m_cellsEntered = 0;
+        int64_t m_cellsLeft = 0;
+    };
+
 private:
 	std::vector<WorldObjectId> m_neighbours;
 
-	EntityGridCell      *m_cells[NUM_TEAMS];
+	Neuron::IdCellGrid<WorldObjectId> m_cells[NUM_TEAMS];
 
     int                 m_numCellsX;
 	int                 m_numCellsZ;
@@ -25,8 +37,11 @@ private:
     float               m_cellSizeXRecip; // 1/m_cellSizeX
     float               m_cellSizeZRecip;
 
+    UpdateStats         m_updateStats;
+
 	EntityGridCell      *GetCell(float _worldX, float _worldZ, int _team);
 	EntityGridCell      *GetCell(int _indexX, int _indexZ, int _team);
+    Neuron::CellRect    GetCellRect(float _worldX, float _worldZ, float _radius);   // Cells covered by a non-zero radius
 
     void                EnsureMaxNeighbours( int _maxNeighbours );
 
@@ -43,6 +58,8 @@ public:
                                              float _newWorldX, float _newWorldZ,
                                              float _radius );
 
+    const UpdateStats &GetUpdateStats() const { return m_updateStats; }
+
     WorldObjectId *GetNeighbours(float _worldX, float _worldZ, float _range,
 								 int *_numFound, bool _includeTeam[NUM_TEAMS] );
 
@@ -82,5 +82,3 @@ class ExplosionManager
 
     const std::vector<Explosion*>& GetExplosionList() { return m_explosions; } // read access for DeformEffect
 };
-
-inline ExplosionManager g_explosionManager;
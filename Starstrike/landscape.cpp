@@ -453,6 +453,10 @@ Landscape::~Landscape() { Empty(); }
 
 void Landscape::BuildOpenGlState()
 {
+  // Nothing draws a headless match
+  if (!g_context->m_renderer)
+    return;
+
   delete m_renderer;
   m_renderer = new LandscapeRenderer(m_heightMap);
 }
@@ -881,10 +885,10 @@ void Landscape::GenerateTerrainWorld(int _seed)
 #endif
 }
 
-void Landscape::TickCA(float _alpha, float _beta, float _maxPh)
+void Landscape::TickCA(float _alpha, float _beta, float _maxPh, JobSystem* _jobs)
 {
   DEBUG_ASSERT(m_terrainWorld);
-  m_terrainWorld->TickActiveChunks(_alpha, _beta, _maxPh);
+  m_terrainWorld->TickActiveChunks(_alpha, _beta, _maxPh, _jobs);
 }
 
 TerrainWorld* Landscape::GetTerrainWorld()
@@ -12,6 +12,11 @@ class LandscapeDef;
 class LandscapeRenderer;
 class TerrainWorld;   // forward-declared; lives in GameLogic
 
+namespace Neuron
+{
+  class JobSystem;
+}
+
 // ****************************************************************************
 // Class LandscapeTile
 // ****************************************************************************
@@ -116,7 +121,7 @@ class Landscape
 
     // ---- Terrain world (CA substrate) ----
     void GenerateTerrainWorld(int _seed);
-    void TickCA(float _alpha, float _beta, float _maxPh);
+    void TickCA(float _alpha, float _beta, float _maxPh, JobSystem* _jobs = nullptr);
     TerrainWorld*       GetTerrainWorld();
     const TerrainWorld* GetTerrainWorld() const;
 };
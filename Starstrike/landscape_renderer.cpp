@@ -389,6 +389,7 @@ void LandscapeRenderer::BuildMeshData(SurfaceMap2D<float>* _heightMap)
   m_mirrorVersion = 0;
 #ifdef PHEROMONE_ACTIVE
   m_cachedCellCount = 0; // Invalidate cell cache
+  m_chunkVerts.Clear();
 #endif
 
   // Release all frame buffers
@@ -551,11 +552,8 @@ void LandscapeRenderer::Render()
 
 #ifdef PHEROMONE_ACTIVE
   // Pheromone overlay — blend tints into vertex colours when dirty.
-  if (m_pheromoneDirty && m_terrainWorld)
-  {
+  if ((m_pheromoneDirty || !m_dirtyChunks.empty()) && m_terrainWorld)
     UpdatePheromoneOverlay();
-    m_pheromoneDirty = false;
-  }
 #endif
 
   // Lazy upload to GPU
@@ -671,12 +669,14 @@ void LandscapeRenderer::RebuildColours(const TerrainWorld* _world)
     LandTriangleStrip* strip = m_strips[i];
 
     // First two verts have no triangle context — magenta sentinel.
-    m_verts[nextColId].m_col.Set(255, 0, 255);
-    m_baseColours.PutData(m_verts[nextColId].m_col, nextColId);
-    nextColId++;
-    m_verts[nextColId].m_col.Set(255, 0, 255);
-    m_baseColours.PutData(m_verts[nextColId].m_col, nextColId);
-    nextColId++;
+    for (int k = 0; k < 2; ++k)
+    {
+      m_verts[nextColId].m_col.Set(255, 0, 255);
+      m_baseColours.PutData(m_verts[nextColId].m_col, nextColId);
+      m_cachedCellX[nextColId] = -1;
+      m_cachedCellZ[nextColId] = -1;
+      nextColId++;
+    }
 
     const int numVerts = strip->m_numVerts - 2;
     for (int j = 0; j < numVerts; ++j)
@@ -699,6 +699,9 @@ void LandscapeRenderer::RebuildColours(const TerrainWorld* _world)
       if (cz >= worldCellsZ)
         cz = worldCellsZ - 1;
 
+      m_cachedCellX[nextColId] = cx;
+      m_cachedCellZ[nextColId] = cz;
+
       TerrainType type = _world->GetTerrainType(cx, cz);
 
       RGBAColour col;
@@ -712,6 +715,20 @@ void LandscapeRenderer::RebuildColours(const TerrainWorld* _world)
 
   DEBUG_ASSERT(nextColId == m_verts.NumUsed());
 
+  // Group vertices by the chunk their cell lies in, so a pheromone update
+  // to one chunk only recolours that chunk's vertices.
+  const int chunksX = _world->GetChunksX();
+  const int numChunks = chunksX * _world->GetChunksZ();
+  m_chunkVerts.Build(numChunks, vertCount, [&](int _vertex)
+  {
+    if (m_cachedCellX[_vertex] < 0)
+      return -1;
+    return (m_cachedCellZ[_vertex] / TerrainChunk::CHUNK_SIZE) * chunksX + m_cachedCellX[_vertex] / TerrainChunk::CHUNK_SIZE;
+  });
+  m_chunkDirty.assign(numChunks, false);
+  m_dirtyChunks.clear();
+  m_pheromoneDirty = true; // Put the overlay back on top of the new base colours
+
   // Force GPU re-upload with the new colours.
   InvalidateGPU();
 }
@@ -720,19 +737,25 @@ void LandscapeRenderer::RebuildColours(const TerrainWorld* _world)
 // Pheromone overlay
 // ============================================================================
 
-void LandscapeRenderer::MarkPheromoneDirty() { m_pheromoneDirty = true; }
-
-void LandscapeRenderer::UpdatePheromoneOverlay()
+void LandscapeRenderer::MarkPheromoneDirty(int _chunkX, int _chunkZ)
 {
-  if (!m_terrainWorld || m_baseColours.Size() <= 0)
+  if (!m_terrainWorld || _chunkX < 0 || _chunkX >= m_terrainWorld->GetChunksX() || _chunkZ < 0 ||
+      _chunkZ >= m_terrainWorld->GetChunksZ())
     return;
 
-  // Require cached cell indices (built by RebuildColours).
-  DEBUG_ASSERT(m_cachedCellCount == m_verts.NumUsed());
-  if (m_cachedCellCount != m_verts.NumUsed())
+  const int chunk = _chunkZ * m_terrainWorld->GetChunksX() + _chunkX;
+  if (chunk >= static_cast<int>(m_chunkDirty.size()) || m_chunkDirty[chunk])
     return;
+  m_chunkDirty[chunk] = true;
+  m_dirtyChunks.push_back(chunk);
+}
 
-  // Blue = home pheromone, Green = food pheromone.
+void LandscapeRenderer::MarkPheromoneDirty() { m_pheromoneDirty = true; }
+
+// Base (biome) colour with the pheromone tint of _cell blended on top.
+// Blue = home pheromone, Green = food pheromone.
+static RGBAColour PheromoneTint(const RGBAColour& _base, const TerrainCell& _cell)
+{
   static constexpr float INV_MAX_PH = 1.0f / 100.0f;
   static constexpr unsigned char PH_HOME_R = 40;
   static constexpr unsigned char PH_HOME_G = 80;
@@ -745,65 +768,91 @@ void LandscapeRenderer::UpdatePheromoneOverlay()
   // for visible contribution, i.e. cell.m_phHome > 1.0.
   static constexpr float PH_RAW_THRESHOLD = 1.0f;
 
-  int vertIdx = 0;
+  // Fast path: both pheromones negligible — restore base colour directly.
+  if (_cell.m_phHome <= PH_RAW_THRESHOLD && _cell.m_phFood <= PH_RAW_THRESHOLD)
+    return _base;
 
-  for (int i = 0; i < m_strips.Size(); ++i)
+  RGBAColour col = _base;
+
+  // Additive blend for home pheromone (blue tint).
+  float phHome = _cell.m_phHome * INV_MAX_PH;
+  if (phHome > 1.0f)
+    phHome = 1.0f;
+  if (phHome > 0.01f)
   {
-    LandTriangleStrip* strip = m_strips[i];
+    int r = col.r + static_cast<int>(PH_HOME_R * phHome);
+    int g = col.g + static_cast<int>(PH_HOME_G * phHome);
+    int b = col.b + static_cast<int>(PH_HOME_B * phHome);
+    col.r = r > 255 ? 255 : static_cast<unsigned char>(r);
+    col.g = g > 255 ? 255 : static_cast<unsigned char>(g);
+    col.b = b > 255 ? 255 : static_cast<unsigned char>(b);
+  }
 
-    // First two sentinel verts — copy base colour as-is.
-    m_verts[vertIdx].m_col = m_baseColours[vertIdx];
-    vertIdx++;
-    m_verts[vertIdx].m_col = m_baseColours[vertIdx];
-    vertIdx++;
+  // Additive blend for food pheromone (green tint).
+  float phFood = _cell.m_phFood * INV_MAX_PH;
+  if (phFood > 1.0f)
+    phFood = 1.0f;
+  if (phFood > 0.01f)
+  {
+    int r = col.r + static_cast<int>(PH_FOOD_R * phFood);
+    int g = col.g + static_cast<int>(PH_FOOD_G * phFood);
+    int b = col.b + static_cast<int>(PH_FOOD_B * phFood);
+    col.r = r > 255 ? 255 : static_cast<unsigned char>(r);
+    col.g = g > 255 ? 255 : static_cast<unsigned char>(g);
+    col.b = b > 255 ? 255 : static_cast<unsigned char>(b);
+  }
 
-    const int numVerts = strip->m_numVerts - 2;
-    for (int j = 0; j < numVerts; ++j, ++vertIdx)
-    {
-      // Use cached cell coordinates — avoids per-vertex centroid recomputation.
-      const TerrainCell& cell = m_terrainWorld->GetCell(m_cachedCellX[vertIdx], m_cachedCellZ[vertIdx]);
+  return col;
+}
 
-      // Fast path: both pheromones negligible — restore base colour directly.
-      if (cell.m_phHome <= PH_RAW_THRESHOLD && cell.m_phFood <= PH_RAW_THRESHOLD)
-      {
-        m_verts[vertIdx].m_col = m_baseColours[vertIdx];
-        continue;
-      }
+void LandscapeRenderer::UpdatePheromoneOverlay()
+{
+  if (!m_terrainWorld || m_baseColours.Size() <= 0)
+    return;
 
-      // Start from base (biome) colour.
-      RGBAColour col = m_baseColours[vertIdx];
+  // Require cached cell indices (built by RebuildColours).
+  DEBUG_ASSERT(m_cachedCellCount == m_verts.NumUsed());
+  if (m_cachedCellCount != m_verts.NumUsed())
+    return;
 
-      // Additive blend for home pheromone (blue tint).
-      float phHome = cell.m_phHome * INV_MAX_PH;
-      if (phHome > 1.0f)
-        phHome = 1.0f;
-      if (phHome > 0.01f)
+  // Going chunk by chunk costs about twice as much per vertex as one pass
+  // in strip order, so a full refresh, or a snapshot load marking most
+  // chunks, recolours every vertex in order instead.
+  if (m_pheromoneDirty || static_cast<int>(m_dirtyChunks.size()) * 2 > m_chunkVerts.GetNumChunks())
+  {
+    for (int vertex = 0; vertex < m_cachedCellCount; ++vertex)
+    {
+      // Strip sentinels have no cell and keep their base colour.
+      if (m_cachedCellX[vertex] < 0)
       {
-        int r = col.r + static_cast<int>(PH_HOME_R * phHome);
-        int g = col.g + static_cast<int>(PH_HOME_G * phHome);
-        int b = col.b + static_cast<int>(PH_HOME_B * phHome);
-        col.r = r > 255 ? 255 : static_cast<unsigned char>(r);
-        col.g = g > 255 ? 255 : static_cast<unsigned char>(g);
-        col.b = b > 255 ? 255 : static_cast<unsigned char>(b);
+        m_verts[vertex].m_col = m_baseColours[vertex];
+        continue;
       }
 
-      // Additive blend for food pheromone (green tint).
-      float phFood = cell.m_phFood * INV_MAX_PH;
-      if (phFood > 1.0f)
-        phFood = 1.0f;
-      if (phFood > 0.01f)
-      {
-        int r = col.r + static_cast<int>(PH_FOOD_R * phFood);
-        int g = col.g + static_cast<int>(PH_FOOD_G * phFood);
-        int b = col.b + static_cast<int>(PH_FOOD_B * phFood);
-        col.r = r > 255 ? 255 : static_cast<unsigned char>(r);
-        col.g = g > 255 ? 255 : static_cast<unsigned char>(g);
-        col.b = b > 255 ? 255 : static_cast<unsigned char>(b);
-      }
+      // Use cached cell coordinates — avoids per-vertex centroid recomputation.
+      const TerrainCell& cell = m_terrainWorld->GetCell(m_cachedCellX[vertex], m_cachedCellZ[vertex]);
+      m_verts[vertex].m_col = PheromoneTint(m_baseColours[vertex], cell);
+    }
 
-      m_verts[vertIdx].m_col = col;
+    for (int chunk : m_dirtyChunks)
+      m_chunkDirty[chunk] = false;
+    m_pheromoneDirty = false;
+  }
+  else
+  {
+    // Only the vertices coloured from dirty chunks can have changed; strip
+    // sentinels belong to no chunk and keep their base colour.
+    for (int chunk : m_dirtyChunks)
+    {
+      m_chunkVerts.ForEachVertex(chunk, [&](int _vertex)
+      {
+        const TerrainCell& cell = m_terrainWorld->GetCell(m_cachedCellX[_vertex], m_cachedCellZ[_vertex]);
+        m_verts[_vertex].m_col = PheromoneTint(m_baseColours[_vertex], cell);
+      });
+      m_chunkDirty[chunk] = false;
     }
   }
+  m_dirtyChunks.clear();
 
   // Force GPU re-upload.
   InvalidateGPU();
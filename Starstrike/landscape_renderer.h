@@ -1,6 +1,7 @@
 #pragma once
 
 #include "2d_surface_map.h"
+#include "ChunkVertexMap.h"
 #include "fast_darray.h"
 #include "rgb_colour.h"
 #include "texture_uv.h"
@@ -62,8 +63,14 @@ class LandscapeRenderer
     // Pointer to the terrain world (not owned — set by RebuildColours).
     const TerrainWorld* m_terrainWorld;
 
-    // Dirty flag: set when pheromone deltas arrive; cleared after overlay update.
+    // Every vertex needs recolouring (e.g. after a snapshot); cleared after overlay update.
     bool m_pheromoneDirty;
+
+    // Chunks whose pheromones changed since the last overlay update, and
+    // the vertices coloured from each chunk (built by RebuildColours).
+    std::vector<int> m_dirtyChunks;
+    std::vector<bool> m_chunkDirty;
+    Neuron::ChunkVertexMap m_chunkVerts;
 #endif
 
     FastDArray<LandVertex> m_verts;
@@ -86,8 +93,9 @@ class LandscapeRenderer
     int m_gpuMirrorCount = 0;
 
     #ifdef PHEROMONE_ACTIVE
-        // Cached per-vertex
+        // Cached per-vertex cell coordinates (built by RebuildColours and
     // reused by UpdatePheromoneOverlay to skip centroid recomputation).
+    // Strip sentinel vertices have no cell and hold -1.
     int* m_cachedCellX = nullptr;
     int* m_cachedCellZ = nullptr;
     int m_cachedCellCount = 0;
@@ -134,10 +142,13 @@ class LandscapeRenderer
     // Called once after Landscape::GenerateTerrainWorld() for procedural maps.
     void RebuildColours(const TerrainWorld* _world);
 
-    // Called by client networking when pheromone deltas arrive.
+    // Called by client networking when pheromones arrive for one chunk, or
+    // for every chunk at once (e.g. after a snapshot).
+    void MarkPheromoneDirty(int _chunkX, int _chunkZ);
     void MarkPheromoneDirty();
 
-    // Recompute pheromone overlay tint on all vertices from m_baseColours.
+    // Recompute pheromone overlay tint from m_baseColours on the vertices of
+    // dirty chunks only.
     void UpdatePheromoneOverlay();
 #endif
 };
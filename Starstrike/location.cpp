@@ -1,8 +1,10 @@
 #include "pch.h"
 #include "location.h"
 #include "GameApp.h"
+#include "GameSimEventQueue.h"
 #include "armour.h"
 #include "camera.h"
+#include "clienttoserver.h"
 #include "clouds.h"
 #include "darwinian.h"
 #include "engineer.h"
@@ -10,12 +12,14 @@
 #include "factory.h"
 #include "gamecursor.h"
 #include "global_world.h"
+#include "gunturret.h"
 #include "input.h"
 #include "insertion_squad.h"
 #include "landscape.h"
 #include "level_file.h"
 #include "main.h"
 #include "math_utils.h"
+#include "mine.h"
 #include "obstruction_grid.h"
 #include "officer.h"
 #include "particle_system.h"
@@ -24,9 +28,13 @@
 #include "renderer.h"
 #include "resource.h"
 #include "snow.h"
+#include "souldestroyer.h"
+#include "spam.h"
+#include "spawnpoint.h"
 #include "taskmanager.h"
 #include "taskmanager_interface.h"
 #include "team.h"
+#include "teleport.h"
 #include "BuildingRenderRegistry.h"
 #include "QuadBatcher.h"
 #include "BuildingRenderer.h"
@@ -61,7 +69,8 @@ Location::Location()
     m_teams(nullptr),
     m_christmasTimer(-99.9f),
     m_caAccumulator(0.0f),
-    m_caHeartbeatTick(0)
+    m_caHeartbeatTick(0),
+    m_pickEpoch(0)
 {
   m_spirits.SetTotalNumSlices(NUM_SLICES_PER_FRAME);
   m_lasers.SetTotalNumSlices(NUM_SLICES_PER_FRAME);
@@ -87,6 +96,8 @@ void Location::Init(const char* _missionFilename, const char* _mapFilename)
 
   InitLights();
   InitLandscape();
+  if (g_context->m_clientToServer)
+    g_context->m_clientToServer->SetPositionBounds({m_landscape.GetWorldSizeX(), m_landscape.GetWorldSizeZ()});
 
   // Generate terrain world (biome overlay) from seed + heightmap.
   // Legacy maps (terrainSeed == -1) get an all-Earth grid with zero pheromones.
@@ -131,8 +142,13 @@ void Location::Empty()
 {
   m_landscape.Empty();
 
+  for (SyncChecksum& checksum : m_syncChecksums)
+    checksum.Reset();
+
   m_lights.Empty(); // LList <Light *>
   m_buildings.Empty(); // LList <Building *>
+  m_buildingSchedule.Clear();
+  ++m_pickEpoch;
   m_spirits.Empty(); // FastDArray <Spirit>
   m_lasers.Empty();
   m_effects.Empty();
@@ -325,6 +341,13 @@ int Location::SpawnSpirit(const LegacyVector3& _pos, const LegacyVector3& _vel,
   return index;
 }
 
+//  *** RemoveSpirit
+void Location::RemoveSpirit(int _index)
+{
+  RetireSyncState(SyncSubsystem::Spirits, m_spirits.GetPointer(_index));
+  m_spirits.MarkNotUsed(_index);
+}
+
 //  *** GetSpirit
 int Location::GetSpirit(WorldObjectId _id)
 {
@@ -596,25 +619,42 @@ void Location::AdvanceBuildings(int _slice)
   START_PROFILE(g_context->m_profiler, "Advance Buildings");
   bool obstructionGridChanged = false;
 
+  // Dormant buildings are skipped until woken, so the cost of a tick
+  // follows the number of buildings with something to do
+  if (_slice == 0)
+    m_buildingSchedule.Tick();
+  m_buildingSchedule.Resize(m_buildings.Size());
+
   int startIndex, endIndex;
   m_buildings.GetNextSliceBounds(_slice, &startIndex, &endIndex);
-  for (int i = startIndex; i <= endIndex; ++i)
+  m_buildingSchedule.ForEachAwake(startIndex, endIndex + 1, [&](int i)
   {
-    if (m_buildings.ValidIndex(i))
-    {
-      Building* building = m_buildings.GetData(i);
+    if (!m_buildings.ValidIndex(i))
+      return;
 
-      START_PROFILE(g_context->m_profiler, Building::GetTypeName( building->m_type ));
-      bool removeBuilding = building->Advance();
-      END_PROFILE(g_context->m_profiler, Building::GetTypeName( building->m_type ));
+    Building* building = m_buildings.GetData(i);
+    building->m_dormantSlot = -1; // Awake, whether woken by Wake() or by its timer
 
-      if (removeBuilding)
-      {
-        m_buildings.MarkNotUsed(i);
-        obstructionGridChanged = true;
-      }
+    START_PROFILE(g_context->m_profiler, Building::GetTypeName( building->m_type ));
+    bool removeBuilding = building->Advance();
+    END_PROFILE(g_context->m_profiler, Building::GetTypeName( building->m_type ));
+
+    if (removeBuilding)
+    {
+      RetireSyncState(SyncSubsystem::Buildings, building);
+      m_buildings.MarkNotUsed(i);
+      obstructionGridChanged = true;
+      return;
     }
-  }
+
+    UpdateSyncState(SyncSubsystem::Buildings, building);
+    if (building->m_sleepTicks != 0)
+    {
+      m_buildingSchedule.Sleep(i, building->m_sleepTicks);
+      building->m_sleepTicks = 0;
+      building->m_dormantSlot = i;
+    }
+  });
 
   if (obstructionGridChanged)
   {
@@ -625,6 +665,17 @@ void Location::AdvanceBuildings(int _slice)
   END_PROFILE(g_context->m_profiler, "Advance Buildings");
 }
 
+int Location::GetNumAwakeBuildings() const
+{
+  int count = 0;
+  for (int i = 0; i < m_buildings.Size(); ++i)
+  {
+    if (m_buildings.ValidIndex(i) && (i >= m_buildingSchedule.GetNumSlots() || m_buildingSchedule.IsAwake(i)))
+      ++count;
+  }
+  return count;
+}
+
 /*
 void Location::AdvanceBuildings( int _slice )
 {
@@ -682,7 +733,9 @@ void Location::AdvanceSpirits(int _slice)
       Spirit* s = m_spirits.GetPointer(i);
       bool removeSpirit = s->Advance();
       if (removeSpirit)
-        m_spirits.MarkNotUsed(i);
+        RemoveSpirit(i);
+      else
+        UpdateSyncState(SyncSubsystem::Spirits, s);
     }
   }
 
@@ -710,7 +763,8 @@ void Location::DoMissionCompleteActions()
   GlobalLocation* gloc = g_context->m_globalWorld->GetLocation(g_context->m_locationId);
   gloc->m_missionCompleted = true;
 
-  g_context->m_taskManagerInterface->SetCurrentMessage(TaskManagerInterface::MessageObjectivesComplete, -1, 5.0f);
+  if (g_context->m_taskManagerInterface)
+    g_context->m_taskManagerInterface->SetCurrentMessage(TaskManagerInterface::MessageObjectivesComplete, -1, 5.0f);
 }
 
 // *** MissionComplete
@@ -731,38 +785,716 @@ bool Location::MissionComplete()
   return true;
 }
 
-// *** Advance
-void Location::Advance(int _slice)
+// *** GetSyncReport
+// All object checksums are maintained incrementally as objects advance, so
+// this is O(1) and cheap enough to call after every processed sequence id.
+void Location::GetSyncReport(SyncReport* _report) const
 {
-  if (g_context->m_paused)
-    return;
+  for (int i = 0; i < NumSyncSubsystems; ++i)
+    _report->m_checksums[i] = m_syncChecksums[i].Value();
 
-  m_lastSliceProcessed = _slice;
+  (*_report)[SyncSubsystem::Random] = GetSyncRandDigest();
+}
+
+// *** ComputeSyncReport
+// Hashes every object as it is now rather than summing the digests they
+// cached when they last advanced, so it trusts nothing a snapshot carried.
+// O(objects).
+void Location::ComputeSyncReport(SyncReport* _report) const
+{
+  SyncChecksum entities;
+  for (int t = 0; t < NUM_TEAMS; ++t)
+  {
+    const Team& team = m_teams[t];
+    for (int i = 0; i < team.m_others.Size(); ++i)
+    {
+      if (team.m_others.ValidIndex(i))
+        entities.Add(team.m_others[i]->GetSyncHash());
+    }
+
+    for (int u = 0; u < team.m_units.Size(); ++u)
+    {
+      if (!team.m_units.ValidIndex(u))
+        continue;
+
+      const Unit* unit = team.m_units[u];
+      for (int i = 0; i < unit->m_entities.Size(); ++i)
+      {
+        if (unit->m_entities.ValidIndex(i))
+          entities.Add(unit->m_entities[i]->GetSyncHash());
+      }
+    }
+  }
+
+  SyncChecksum buildings;
+  for (int i = 0; i < m_buildings.Size(); ++i)
+  {
+    if (m_buildings.ValidIndex(i))
+      buildings.Add(m_buildings[i]->GetSyncHash());
+  }
+
+  SyncChecksum spirits;
+  for (int i = 0; i < m_spirits.Size(); ++i)
+  {
+    if (m_spirits.ValidIndex(i))
+      spirits.Add(m_spirits[i].GetSyncHash());
+  }
+
+  (*_report)[SyncSubsystem::Entities] = entities.Value();
+  (*_report)[SyncSubsystem::Buildings] = buildings.Value();
+  (*_report)[SyncSubsystem::Spirits] = spirits.Value();
+  (*_report)[SyncSubsystem::Random] = GetSyncRandDigest();
+}
+
+// ****************************************************************************
+//  Late-join snapshots
+// ****************************************************************************
+
+static void WriteSnapshotEntity(SnapshotWriter& _writer, const Entity* _entity)
+{
+  _writer.Write(_entity->m_type);
+  _entity->WriteSnapshot(_writer);
+}
+
+// State shared by every object of a kind rather than owned by any one object
+static void WriteSnapshotStatics(SnapshotWriter& _writer, const LocationStatics& _statics)
+{
+  _writer.Write(_statics.m_lastWayPointId);
+  _writer.Write(_statics.m_refineryPopulation);
+  WriteSnapshotTime(_writer, _statics.m_refineryRecalculateTimer);
+  WriteSnapshotTime(_writer, _statics.m_overpopulationTimer);
+  _writer.Write(_statics.m_overpopulation);
+  WriteSnapshotList(_writer, _statics.m_teleportMap);
+}
+
+static void ReadSnapshotStatics(SnapshotReader& _reader, LocationStatics& _statics)
+{
+  _reader.Read(_statics.m_lastWayPointId);
+  _reader.Read(_statics.m_refineryPopulation);
+  ReadSnapshotTime(_reader, _statics.m_refineryRecalculateTimer);
+  ReadSnapshotTime(_reader, _statics.m_overpopulationTimer);
+  _reader.Read(_statics.m_overpopulation);
+  ReadSnapshotList(_reader, _statics.m_teleportMap);
+}
+
+// An effect of _type with nothing set; the snapshot supplies the rest.  No
+// Initialise, which would only queue the creation sound again.
+static WorldObject* NewSnapshotEffect(int _type)
+{
+  switch (_type)
+  {
+  case WorldObject::EffectThrowableGrenade:
+  case WorldObject::EffectThrowableAirstrikeBomb:
+    return new Grenade(g_zeroVector, g_upVector, 0.0f);
+  case WorldObject::EffectThrowableAirstrikeMarker:
+    return new AirStrikeMarker(g_zeroVector, g_upVector, 0.0f);
+  case WorldObject::EffectThrowableControllerGrenade:
+    return new ControllerGrenade(g_zeroVector, g_upVector, 0.0f);
+  case WorldObject::EffectGunTurretTarget:
+    return new GunTurretTarget(-1);
+  case WorldObject::EffectGunTurretShell:
+    return new TurretShell(0.0f);
+  case WorldObject::EffectSpamInfection:
+    return new SpamInfection();
+  case WorldObject::EffectBoxKite:
+    return new BoxKite();
+  case WorldObject::EffectSnow:
+    return new Snow();
+  case WorldObject::EffectRocket:
+    return new Rocket(g_zeroVector, g_upVector);
+  case WorldObject::EffectShockwave:
+    return new Shockwave(255, 0.0f);
+  case WorldObject::EffectMuzzleFlash:
+    return new MuzzleFlash();
+  case WorldObject::EffectOfficerOrders:
+    return new OfficerOrders();
+  case WorldObject::EffectZombie:
+    return new Zombie();
+  }
+  return nullptr;
+}
+
+// *** WriteSnapshot
+// Everything a client needs to continue the simulation from the letter after
+// _sequenceId.  Only call between ticks, never part way through the slices.
+void Location::WriteSnapshot(SnapshotWriter& _writer, int _sequenceId) const
+{
+  int section = _writer.BeginSection(SnapshotTag("LOCN"));
+  _writer.Write(_sequenceId);
+  _writer.WriteString(m_levelFile->m_mapFilename);
+  _writer.WriteString(m_levelFile->m_missionFilename);
+  _writer.Write(m_missionComplete);
+  _writer.Write(m_caAccumulator);
+  _writer.Write(m_caHeartbeatTick);
+  _writer.EndSection(section);
+
+  for (int t = 0; t < NUM_TEAMS; ++t)
+  {
+    const Team& team = m_teams[t];
+    if (team.m_teamType == Team::TeamTypeUnused)
+      continue;
+
+    section = _writer.BeginSection(SnapshotTag("TEAM"));
+    _writer.Write(t);
+    _writer.Write(team.m_currentUnitId);
+    _writer.Write(team.m_currentEntityId);
+    _writer.Write(team.m_currentBuildingId);
+    WriteSnapshotVector(_writer, team.m_currentMousePos);
+
+    WriteSnapshotArray(_writer, team.m_units, [&](int _unitId)
+    {
+      const Unit* unit = team.m_units[_unitId];
+      _writer.Write(unit->m_troopType);
+      unit->WriteSnapshot(_writer);
+      WriteSnapshotArray(_writer, unit->m_entities, [&](int _index) { WriteSnapshotEntity(_writer, unit->m_entities[_index]); });
+    });
+    WriteSnapshotArray(_writer, team.m_others, [&](int _index) { WriteSnapshotEntity(_writer, team.m_others[_index]); });
+    WriteSnapshotList(_writer, team.m_specials);
+    _writer.EndSection(section);
+  }
+
+  section = _writer.BeginSection(SnapshotTag("BLDG"));
+  WriteSnapshotArray(_writer, m_buildings, [&](int _index)
+  {
+    const Building* building = m_buildings[_index];
+    _writer.Write(building->m_type);
+    building->WriteSnapshot(_writer);
+  });
+  _writer.EndSection(section);
+
+  section = _writer.BeginSection(SnapshotTag("SPRT"));
+  WriteSnapshotArray(_writer, m_spirits, [&](int _index) { m_spirits[_index].WriteSnapshot(_writer); });
+  _writer.EndSection(section);
+
+  section = _writer.BeginSection(SnapshotTag("LASR"));
+  WriteSnapshotArray(_writer, m_lasers, [&](int _index) { m_lasers[_index].WriteSnapshot(_writer); });
+  _writer.EndSection(section);
+
+  section = _writer.BeginSection(SnapshotTag("EFCT"));
+  WriteSnapshotArray(_writer, m_effects, [&](int _index)
+  {
+    const WorldObject* effect = m_effects[_index];
+    _writer.Write(effect->m_type);
+    effect->WriteSnapshot(_writer);
+  });
+  _writer.EndSection(section);
+
+  // Pheromones are mostly zero, so only non-zero cells are written
+  if (const TerrainWorld* world = m_landscape.GetTerrainWorld())
+  {
+    section = _writer.BeginSection(SnapshotTag("PHER"));
+    std::vector<float> cells(TerrainChunk::CELL_COUNT * 2);
+    const int numChunks = world->GetChunksX() * world->GetChunksZ();
+    _writer.WriteVarUInt(static_cast<uint32_t>(numChunks));
+    for (int cz = 0; cz < world->GetChunksZ(); ++cz)
+    {
+      for (int cx = 0; cx < world->GetChunksX(); ++cx)
+      {
+        const TerrainChunk* chunk = world->GetChunk(cx, cz);
+        int numCells = 0;
+        if (chunk)
+        {
+          chunk->SerializePheromones(reinterpret_cast<char*>(cells.data()), static_cast<int>(cells.size() * sizeof(float)));
+          for (int i = 0; i < TerrainChunk::CELL_COUNT; ++i)
+          {
+            if (cells[i * 2] != 0.0f || cells[i * 2 + 1] != 0.0f)
+              ++numCells;
+          }
+        }
+
+        _writer.Write(cx);
+        _writer.Write(cz);
+        _writer.WriteVarUInt(static_cast<uint32_t>(numCells));
+        for (int i = 0; numCells > 0 && i < TerrainChunk::CELL_COUNT; ++i)
+        {
+          if (cells[i * 2] == 0.0f && cells[i * 2 + 1] == 0.0f)
+            continue;
+          _writer.WriteVarUInt(static_cast<uint32_t>(i));
+          _writer.Write(cells[i * 2]);
+          _writer.Write(cells[i * 2 + 1]);
+        }
+      }
+    }
+    _writer.EndSection(section);
+  }
+
+  section = _writer.BeginSection(SnapshotTag("STAT"));
+  WriteSnapshotStatics(_writer, m_statics);
+  _writer.EndSection(section);
+
+  // Last, so the reader restores them after anything above has drawn from them
+  section = _writer.BeginSection(SnapshotTag("SYNC"));
+  _writer.Write(WorldObjectId::GetNextUniqueId());
+  for (const SyncChecksum& checksum : m_syncChecksums)
+    _writer.Write(checksum.Value());
+  WriteSyncRandState(_writer);
+  _writer.EndSection(section);
+}
+
+// Everything ParseSnapshot builds.  None of it is reachable from the Location
+// until CommitSnapshot moves it in, and whatever is left when it goes out of
+// scope - all of it, if the snapshot was refused - is deleted with it.
+struct Location::StagedSnapshot
+{
+  struct TeamState
+  {
+    bool m_present = false;
+    int m_currentUnitId = -1;
+    int m_currentEntityId = -1;
+    int m_currentBuildingId = -1;
+    LegacyVector3 m_currentMousePos;
+    FastDArray<Unit*> m_units;
+    FastDArray<Entity*> m_others;
+    LList<WorldObjectId> m_specials;
+  };
+
+  struct PheromoneChunk
+  {
+    int m_x;
+    int m_z;
+    std::vector<float> m_cells;
+  };
+
+  int m_sequenceId = -1;
+  bool m_missionComplete = false;
+  float m_caAccumulator = 0.0f;
+  int m_caHeartbeatTick = 0;
+
+  TeamState m_teams[NUM_TEAMS];
+  std::vector<std::pair<Entity*, SnapshotReader>> m_entities; // Every entity, with where its state starts
+
+  FastDArray<Building*> m_buildings; // Read without Initialise; only templates for the live ones
+  std::vector<SnapshotReader> m_buildingStates;
+  FastDArray<Spirit> m_spirits;
+  FastDArray<Laser> m_lasers;
+  FastDArray<WorldObject*> m_effects;
+  std::vector<PheromoneChunk> m_pheromones;
+
+  bool m_hasStatics = false;
+  SnapshotReader m_statics;
+  int m_nextUniqueId = 0;
+  uint64_t m_checksums[NumSyncSubsystems] = {};
+  SnapshotReader m_syncRandState;
+
+  ~StagedSnapshot()
+  {
+    // Clear the ids first so that no destructor reaches into the live teams
+    for (auto& [entity, state] : m_entities)
+    {
+      entity->m_id.SetInvalid();
+      delete entity;
+    }
+
+    for (TeamState& team : m_teams)
+    {
+      for (int i = 0; i < team.m_units.Size(); ++i)
+      {
+        if (team.m_units.ValidIndex(i) && team.m_units[i])
+        {
+          team.m_units[i]->m_unitId = -1;
+          delete team.m_units[i];
+        }
+      }
+    }
+
+    for (int i = 0; i < m_buildings.Size(); ++i)
+    {
+      if (m_buildings.ValidIndex(i) && m_buildings[i])
+      {
+        m_buildings[i]->m_id.SetInvalid();
+        delete m_buildings[i];
+      }
+    }
+
+    for (int i = 0; i < m_effects.Size(); ++i)
+    {
+      if (m_effects.ValidIndex(i))
+        delete m_effects[i];
+    }
+  }
+};
+
+// *** ReadSnapshot
+// Loads a snapshot into a Location that has been Init'ed from the same level
+// but has not processed any letters.  The whole snapshot is parsed and
+// checked before any of it replaces the Location's state, so a snapshot that
+// is malformed or from another level returns false and changes nothing.
+bool Location::ReadSnapshot(SnapshotReader& _reader, int* _sequenceId)
+{
+  // Parsing constructs objects, which takes unique ids and draws on the sync
+  // random stream.  Both are put back if the snapshot is refused.
+  const int nextUniqueId = WorldObjectId::GetNextUniqueId();
+  const SyncRandState syncRandom = g_context->m_syncRandom;
+
+  StagedSnapshot snapshot;
+  if (!ParseSnapshot(_reader, &snapshot))
+  {
+    WorldObjectId::SetNextUniqueId(nextUniqueId);
+    g_context->m_syncRandom = syncRandom;
+    return false;
+  }
+
+  CommitSnapshot(&snapshot);
+  *_sequenceId = snapshot.m_sequenceId;
+  return true;
+}
+
+// *** ParseSnapshot
+// Builds every object in the snapshot into _snapshot, touching nothing the
+// Location owns.  Entities and buildings are only read here, not begun, and
+// are read again by CommitSnapshot once they can be.
+bool Location::ParseSnapshot(SnapshotReader& _reader, StagedSnapshot* _snapshot) const
+{
+  bool valid = true;
+  bool foundHeader = false;
+  bool foundSync = false;
+  std::vector<uint32_t> tags;
+
+  uint32_t tag;
+  SnapshotReader section;
+  while (valid && _reader.NextSection(&tag, &section))
+  {
+    // One of each, bar a TEAM per team; a repeat would orphan what the first built
+    if (tag != SnapshotTag("TEAM") && std::ranges::find(tags, tag) != tags.end())
+      return false;
+    tags.push_back(tag);
+
+    if (tag == SnapshotTag("LOCN"))
+    {
+      char mapFilename[MAX_FILENAME_LEN];
+      char missionFilename[MAX_FILENAME_LEN];
+      section.Read(_snapshot->m_sequenceId);
+      section.ReadString(mapFilename, sizeof(mapFilename));
+      section.ReadString(missionFilename, sizeof(missionFilename));
+      section.Read(_snapshot->m_missionComplete);
+      section.Read(_snapshot->m_caAccumulator);
+      section.Read(_snapshot->m_caHeartbeatTick);
+
+      if (_stricmp(mapFilename, m_levelFile->m_mapFilename) != 0 || _stricmp(missionFilename, m_levelFile->m_missionFilename) != 0)
+      {
+        DebugTrace("CLIENT : Snapshot is of {} / {}, not this level\n", mapFilename, missionFilename);
+        return false;
+      }
+      foundHeader = true;
+    }
+    else if (tag == SnapshotTag("TEAM"))
+    {
+      const int teamId = section.Read<int>();
+      if (teamId < 0 || teamId >= NUM_TEAMS || _snapshot->m_teams[teamId].m_present)
+        return false;
+
+      StagedSnapshot::TeamState& team = _snapshot->m_teams[teamId];
+      team.m_present = true;
+      section.Read(team.m_currentUnitId);
+      section.Read(team.m_currentEntityId);
+      section.Read(team.m_currentBuildingId);
+      ReadSnapshotVector(section, team.m_currentMousePos);
+
+      auto readEntity = [&](int) -> Entity*
+      {
+        const int type = section.Read<int>();
+        Entity* entity = valid && type >= 0 && type < Entity::NumEntityTypes ? Entity::NewEntity(type) : nullptr;
+        if (!entity)
+        {
+          valid = false;
+          return nullptr;
+        }
+
+        entity->SetType(type);
+        _snapshot->m_entities.emplace_back(entity, section);
+        entity->ReadSnapshot(section);
+        return entity;
+      };
+
+      valid = ReadSnapshotArray(section, team.m_units, [&](int _unitId) -> Unit*
+      {
+        const int troopType = section.Read<int>();
+        if (!valid || troopType < 0 || troopType >= Entity::NumEntityTypes)
+        {
+          valid = false;
+          return nullptr;
+        }
+
+        Unit* unit = Team::CreateUnit(troopType, teamId, _unitId, 0, g_zeroVector);
+        unit->ReadSnapshot(section);
+        valid = ReadSnapshotArray(section, unit->m_entities, readEntity) && valid;
+        return unit;
+      }) && valid;
+      valid = ReadSnapshotArray(section, team.m_others, readEntity) && valid;
+      ReadSnapshotList(section, team.m_specials);
+    }
+    else if (tag == SnapshotTag("BLDG"))
+    {
+      valid = ReadSnapshotArray(section, _snapshot->m_buildings, [&](int _index) -> Building*
+      {
+        const int type = section.Read<int>();
+        Building* building = valid ? Building::CreateBuilding(type) : nullptr;
+        if (!building)
+        {
+          valid = false;
+          return nullptr;
+        }
+
+        _snapshot->m_buildingStates.resize(_index + 1);
+        _snapshot->m_buildingStates[_index] = section;
+        building->ReadSnapshot(section);
+        return building;
+      }) && valid;
+    }
+    else if (tag == SnapshotTag("SPRT"))
+    {
+      valid = ReadSnapshotArray(section, _snapshot->m_spirits, [&](int)
+      {
+        Spirit spirit;
+        spirit.ReadSnapshot(section);
+        return spirit;
+      });
+    }
+    else if (tag == SnapshotTag("LASR"))
+    {
+      valid = ReadSnapshotArray(section, _snapshot->m_lasers, [&](int)
+      {
+        Laser laser;
+        laser.ReadSnapshot(section);
+        return laser;
+      });
+    }
+    else if (tag == SnapshotTag("EFCT"))
+    {
+      valid = ReadSnapshotArray(section, _snapshot->m_effects, [&](int) -> WorldObject*
+      {
+        WorldObject* effect = valid ? NewSnapshotEffect(section.Read<int>()) : nullptr;
+        if (!effect)
+        {
+          valid = false;
+          return nullptr;
+        }
+
+        effect->ReadSnapshot(section);
+        return effect;
+      }) && valid;
+    }
+    else if (tag == SnapshotTag("PHER"))
+    {
+      const int numChunks = section.ReadCount();
+      for (int c = 0; c < numChunks && !section.Overflowed(); ++c)
+      {
+        StagedSnapshot::PheromoneChunk& chunk = _snapshot->m_pheromones.emplace_back();
+        chunk.m_x = section.Read<int>();
+        chunk.m_z = section.Read<int>();
+        chunk.m_cells.assign(TerrainChunk::CELL_COUNT * 2, 0.0f);
+
+        const int numCells = section.ReadCount();
+        for (int i = 0; i < numCells && !section.Overflowed(); ++i)
+        {
+          const uint32_t cell = section.ReadVarUInt();
+          const float home = section.Read<float>();
+          const float food = section.Read<float>();
+          if (cell >= static_cast<uint32_t>(TerrainChunk::CELL_COUNT))
+          {
+            section.Invalidate();
+            break;
+          }
+          chunk.m_cells[cell * 2] = home;
+          chunk.m_cells[cell * 2 + 1] = food;
+        }
+      }
+    }
+    else if (tag == SnapshotTag("STAT"))
+    {
+      // Read through once into a scratch copy to check it
+      _snapshot->m_hasStatics = true;
+      _snapshot->m_statics = section;
+      LocationStatics statics;
+      ReadSnapshotStatics(section, statics);
+    }
+    else if (tag == SnapshotTag("SYNC"))
+    {
+      section.Read(_snapshot->m_nextUniqueId);
+      for (uint64_t& checksum : _snapshot->m_checksums)
+        section.Read(checksum);
+      _snapshot->m_syncRandState = section;
+      ReadSyncRandState(section);
+      foundSync = true;
+    }
+
+    if (section.Overflowed())
+      valid = false;
+  }
+
+  return valid && foundHeader && foundSync && !_reader.Overflowed();
+}
+
+// *** CommitSnapshot
+// Replaces the Location's state with a parsed snapshot.  Cannot fail.
+void Location::CommitSnapshot(StagedSnapshot* _snapshot)
+{
+  m_missionComplete = _snapshot->m_missionComplete;
+  m_caAccumulator = _snapshot->m_caAccumulator;
+  m_caHeartbeatTick = _snapshot->m_caHeartbeatTick;
+
+  // Buildings from the level file are already here.  Reuse the ones the
+  // host still has, build any it created since, drop any it destroyed.
+  std::vector<Building*> existing(m_buildings.Size());
+  for (int i = 0; i < m_buildings.Size(); ++i)
+    existing[i] = m_buildings.ValidIndex(i) ? m_buildings[i] : nullptr;
 
-#undef for
-#pragma omp parallel for schedule(dynamic)
-  for (int step = 0; step <= 4; step++)
+  FastDArray<Building*>& buildings = _snapshot->m_buildings;
+  for (int i = 0; i < buildings.Size(); ++i)
   {
-    switch (step)
+    if (!buildings.ValidIndex(i))
+      continue;
+
+    Building* staged = buildings[i];
+    Building* building = nullptr;
+    if (i < static_cast<int>(existing.size()) && existing[i] && existing[i]->m_type == staged->m_type &&
+      existing[i]->m_id.GetUniqueId() == staged->m_id.GetUniqueId())
+    {
+      building = existing[i];
+      existing[i] = nullptr;
+    }
+    else
     {
-    case 0:
-      AdvanceTeams(_slice);
-      break;
-    case 1:
-      AdvanceWeapons(_slice);
-      break;
-    case 2:
-      AdvanceBuildings(_slice);
-      break;
-    case 3:
-      AdvanceSpirits(_slice);
-      break;
-    case 4:
-      AdvanceClouds(_slice);
-      break;
+      building = Building::CreateBuilding(staged->m_type);
+      building->Initialise(staged);
+      building->SetDetail(g_prefsManager->GetInt("RenderBuildingDetail", 1));
     }
+
+    building->ReadSnapshot(_snapshot->m_buildingStates[i]);
+    staged->m_id.SetInvalid();
+    delete staged;
+    buildings[i] = building;
   }
 
+  for (Building* building : existing)
+    delete building;
+  InstallSnapshotArray(m_buildings, buildings);
+
+  // The host's dormant buildings are idle, so starting them awake is harmless
+  m_buildingSchedule.Clear();
+  m_obstructionGrid->CalculateAll();
+
+  // Every team is remote here; our own TeamAssign arrives after the snapshot
+  for (int t = 0; t < NUM_TEAMS; ++t)
+  {
+    StagedSnapshot::TeamState& staged = _snapshot->m_teams[t];
+    if (!staged.m_present)
+      continue;
+
+    Team* team = &m_teams[t];
+    if (team->m_teamType == Team::TeamTypeUnused)
+    {
+      team->Initialise(t);
+      team->SetTeamType(Team::TeamTypeRemotePlayer);
+    }
+
+    auto deleteEntity = [&](Entity* _entity)
+    {
+      m_entityGrid->RemoveObject(_entity->m_id, _entity->m_pos.x, _entity->m_pos.z, _entity->m_radius);
+      delete _entity;
+    };
+    for (int u = 0; u < team->m_units.Size(); ++u)
+    {
+      if (!team->m_units.ValidIndex(u))
+        continue;
+      Unit* unit = team->m_units[u];
+      for (int i = 0; i < unit->m_entities.Size(); ++i)
+      {
+        if (unit->m_entities.ValidIndex(i) && unit->m_entities[i])
+          deleteEntity(unit->m_entities[i]);
+      }
+      delete unit;
+    }
+    for (int i = 0; i < team->m_others.Size(); ++i)
+    {
+      if (team->m_others.ValidIndex(i) && team->m_others[i])
+        deleteEntity(team->m_others[i]);
+    }
+
+    InstallSnapshotArray(team->m_units, staged.m_units);
+    InstallSnapshotArray(team->m_others, staged.m_others);
+    team->RebuildOthersByType();
+
+    team->m_currentUnitId = staged.m_currentUnitId;
+    team->m_currentEntityId = staged.m_currentEntityId;
+    team->m_currentBuildingId = staged.m_currentBuildingId;
+    team->m_currentMousePos = staged.m_currentMousePos;
+  }
+
+  // Begin needs the id and position the parse gave each entity; then the
+  // host's state overrides its defaults
+  for (auto& [entity, state] : _snapshot->m_entities)
+  {
+    entity->Begin();
+    entity->ReadSnapshot(state);
+    m_entityGrid->AddObject(entity->m_id, entity->m_pos.x, entity->m_pos.z, entity->m_radius);
+  }
+  _snapshot->m_entities.clear();
+
+  // Officers and armour registered themselves in Begin; the host's order wins
+  for (int t = 0; t < NUM_TEAMS; ++t)
+  {
+    const StagedSnapshot::TeamState& staged = _snapshot->m_teams[t];
+    if (!staged.m_present)
+      continue;
+
+    m_teams[t].m_specials = staged.m_specials;
+  }
+
+  InstallSnapshotArray(m_spirits, _snapshot->m_spirits);
+  InstallSnapshotArray(m_lasers, _snapshot->m_lasers);
+
+  for (int i = 0; i < m_effects.Size(); ++i)
+  {
+    if (m_effects.ValidIndex(i))
+      delete m_effects[i];
+  }
+  InstallSnapshotArray(m_effects, _snapshot->m_effects);
+
+  if (TerrainWorld* world = m_landscape.GetTerrainWorld())
+  {
+    for (const StagedSnapshot::PheromoneChunk& staged : _snapshot->m_pheromones)
+    {
+      if (TerrainChunk* chunk = world->GetChunk(staged.m_x, staged.m_z))
+      {
+        chunk->DeserializePheromones(reinterpret_cast<const char*>(staged.m_cells.data()),
+                                     static_cast<int>(staged.m_cells.size() * sizeof(float)));
+      }
+    }
+  }
+
+  // Last, since Begin and Initialise above draw on the sync random stream
+  if (_snapshot->m_hasStatics)
+    ReadSnapshotStatics(_snapshot->m_statics, m_statics);
+
+  WorldObjectId::SetNextUniqueId(_snapshot->m_nextUniqueId);
+  for (int i = 0; i < NumSyncSubsystems; ++i)
+  {
+    m_syncChecksums[i].Reset();
+    m_syncChecksums[i].Add(_snapshot->m_checksums[i]);
+  }
+  ReadSyncRandState(_snapshot->m_syncRandState);
+}
+
+// *** Advance
+void Location::Advance(int _slice)
+{
+  if (g_context->m_paused)
+    return;
+
+  m_lastSliceProcessed = _slice;
+  ++m_pickEpoch;
+
+  // These phases stay in order on this thread: they all draw from syncrand,
+  // hand out WorldObjectIds and push sim events, so running them
+  // concurrently would make the result depend on timing.  Independent work
+  // inside a phase (the CA tick below) goes to g_context->m_jobSystem.
+  AdvanceTeams(_slice);
+  AdvanceWeapons(_slice);
+  AdvanceBuildings(_slice);
+  AdvanceSpirits(_slice);
+  AdvanceClouds(_slice);
+
   if (!m_missionComplete && MissionComplete())
   {
     m_missionComplete = true;
@@ -808,18 +1540,22 @@ void Location::AdvanceCA()
     world->SnapshotAllDirtyChunks();
 
     // 2. Diffuse + evaporate.
-    m_landscape.TickCA(CA_ALPHA, CA_BETA, CA_MAX_PH);
+    m_landscape.TickCA(CA_ALPHA, CA_BETA, CA_MAX_PH, g_context->m_jobSystem);
 
-    // 3. Build + send deltas per dirty chunk to subscribed clients.
+    // 3. Build + send deltas per dirty chunk to subscribed clients.  Letters
+    // are built in parallel but sent in chunk order.
     if (g_context->m_server)
     {
-      for (int i = 0; i < world->GetActiveChunkCount(); ++i)
+      const int numActive = world->GetActiveChunkCount();
+      std::vector<ServerToClientLetter*> letters(numActive, nullptr);
+
+      ParallelFor(g_context->m_jobSystem, 0, numActive, 1, [&](int i)
       {
-        TerrainChunk* chunk = world->GetActiveChunk(i);
+        const TerrainChunk* chunk = world->GetActiveChunk(i);
         if (!chunk || !chunk->m_dirty)
-          continue;
+          return;
 
-        TerrainChunk::PhDelta deltas[MAX_DELTAS_PER_CHUNK];
+        auto* deltas = JobSystem::AllocateScratch<TerrainChunk::PhDelta>(MAX_DELTAS_PER_CHUNK);
         int count = chunk->BuildDelta(deltas, MAX_DELTAS_PER_CHUNK, CA_DELTA_THRESHOLD);
         if (count > 0)
         {
@@ -837,11 +1573,18 @@ void Location::AdvanceCA()
           WRITE_INT(ptr, chunk->GetChunkZ());
           WRITE_UNSIGNED_SHORT(ptr, static_cast<unsigned short>(count));
           memcpy(ptr, deltas, count * sizeof(TerrainChunk::PhDelta));
-
-          g_context->m_server->SendLetterToChunkSubscribers(
-            letter, chunk->GetChunkX(), chunk->GetChunkZ());
+          letters[i] = letter;
         }
+      });
 
+      for (int i = 0; i < numActive; ++i)
+      {
+        TerrainChunk* chunk = world->GetActiveChunk(i);
+        if (!chunk || !chunk->m_dirty)
+          continue;
+
+        if (letters[i])
+          g_context->m_server->SendLetterToChunkSubscribers(letters[i], chunk->GetChunkX(), chunk->GetChunkZ());
         chunk->m_dirty = false;
       }
     }
@@ -1664,57 +2407,144 @@ void Location::UpdateTeam(unsigned char teamId, const TeamControls& teamControls
   }
 }
 
+namespace
+{
+  template <typename TArray>
+  uint64_t SlotCount(const TArray& _array)
+  {
+    return (static_cast<uint64_t>(_array.Size()) << 32) | static_cast<uint32_t>(_array.NumUsed());
+  }
+}
+
+// *** IsPickGridCurrent
+// True if _grid was built since the last Advance over the same slots.  If
+// not, it is marked current and emptied for the caller to rebuild.
+bool Location::IsPickGridCurrent(PickGrid& _grid, uint64_t _slots)
+{
+  if (_grid.m_epoch == m_pickEpoch && _grid.m_slots == _slots)
+    return true;
+
+  _grid.m_epoch = m_pickEpoch;
+  _grid.m_slots = _slots;
+  _grid.m_items.clear();
+  return false;
+}
+
+// *** ClosestPickOnScreen
+// Projects every hit's sphere centre and hit point in one batch and returns
+// the index in m_pickHits of the hit whose two points are closest on screen,
+// or -1.  Ties go to the lowest m_order, as they would in a loop over the
+// slots.
+int Location::ClosestPickOnScreen(float* _rangeSqd)
+{
+  const int numHits = static_cast<int>(m_pickHits.size());
+  m_pickPoints.resize(numHits * 2);
+  m_pickScreenX.resize(numHits * 2);
+  m_pickScreenY.resize(numHits * 2);
+  for (int i = 0; i < numHits; ++i)
+  {
+    m_pickPoints[i * 2] = m_pickHits[i].m_spherePos;
+    m_pickPoints[i * 2 + 1] = m_pickHits[i].m_hitPos;
+  }
+  g_context->m_camera->Get2DScreenPositions(m_pickPoints.data(), numHits * 2, m_pickScreenX.data(), m_pickScreenY.data());
+
+  float closestRangeSqd = FLT_MAX;
+  int closest = -1;
+  for (int i = 0; i < numHits; ++i)
+  {
+    float centerPosX = m_pickScreenX[i * 2];
+    float centerPosY = m_pickScreenY[i * 2];
+    float rayHitX = m_pickScreenX[i * 2 + 1];
+    float rayHitY = m_pickScreenY[i * 2 + 1];
+
+    float rangeSqd = pow(centerPosX - rayHitX, 2) + pow(centerPosY - rayHitY, 2);
+    if (rangeSqd < closestRangeSqd || (closest != -1 && rangeSqd == closestRangeSqd && m_pickHits[i].m_order < m_pickHits[closest].m_order))
+    {
+      closestRangeSqd = rangeSqd;
+      closest = i;
+    }
+  }
+
+  *_rangeSqd = closestRangeSqd;
+  return closest;
+}
+
 int Location::GetUnitId(const LegacyVector3& startRay, const LegacyVector3& direction, unsigned char team, float* _range)
 {
   if (team == 255)
     return -1;
 
-  float closestRangeSqd = FLT_MAX;
-  int unitId = -1;
+  Team& theTeam = m_teams[team];
+  PickGrid& grid = m_unitPickGrids[team];
 
-  //
-  // Perform quick preselection by doing ray-sphere intersection tests
-  // against the units centerpos and radius.  However we do then need to
-  // zoom in and perform ray-sphere checks against each entity, because a unit
-  // can become seperated so its bounding sphere covers a very large area.
+  uint64_t slots = SlotCount(theTeam.m_units);
+  for (int unit = 0; unit < theTeam.m_units.Size(); ++unit)
+  {
+    if (theTeam.m_units.ValidIndex(unit))
+      slots = slots * 31 + SlotCount(theTeam.m_units.GetData(unit)->m_entities);
+  }
 
-  for (int unit = 0; unit < m_teams[team].m_units.Size(); ++unit)
+  if (!IsPickGridCurrent(grid, slots))
   {
-    if (m_teams[team].m_units.ValidIndex(unit))
+    for (int unit = 0; unit < theTeam.m_units.Size(); ++unit)
     {
-      Unit* theUnit = m_teams[team].m_units.GetData(unit);
-      bool rayHit = RaySphereIntersection(startRay, direction, theUnit->m_centerPos, theUnit->m_radius * 1.5f);
-      if (rayHit && theUnit->NumAliveEntities() > 0)
+      if (!theTeam.m_units.ValidIndex(unit))
+        continue;
+      Unit* theUnit = theTeam.m_units.GetData(unit);
+      for (int i = 0; i < theUnit->m_entities.Size(); ++i)
       {
-        for (int i = 0; i < theUnit->m_entities.Size(); ++i)
-        {
-          if (theUnit->m_entities.ValidIndex(i))
-          {
-            Entity* entity = theUnit->m_entities[i];
-            LegacyVector3 spherePos = entity->m_pos + entity->m_centerPos;
-            float sphereRadius = entity->m_radius * 1.5f;
-            LegacyVector3 hitPos;
-
-            bool entityHit = RaySphereIntersection(startRay, direction, spherePos, sphereRadius, 1e10, &hitPos);
-            if (entityHit && !entity->m_dead)
-            {
-              float centerPosX, centerPosY, rayHitX, rayHitY;
-              g_context->m_camera->Get2DScreenPos(spherePos, &centerPosX, &centerPosY);
-              g_context->m_camera->Get2DScreenPos(hitPos, &rayHitX, &rayHitY);
-
-              float rangeSqd = pow(centerPosX - rayHitX, 2) + pow(centerPosY - rayHitY, 2);
-              if (rangeSqd < closestRangeSqd)
-              {
-                closestRangeSqd = rangeSqd;
-                unitId = unit;
-              }
-            }
-          }
-        }
+        if (theUnit->m_entities.ValidIndex(i))
+          grid.m_items.emplace_back(unit, i);
       }
     }
+
+    grid.m_grid.Build(static_cast<int>(grid.m_items.size()), [&](int _item)
+    {
+      Entity* entity = theTeam.m_units.GetData(grid.m_items[_item].first)->m_entities[grid.m_items[_item].second];
+      LegacyVector3 spherePos = entity->m_pos + entity->m_centerPos;
+      return Neuron::SphereGrid::Sphere{spherePos.x, spherePos.y, spherePos.z, entity->m_radius * 1.5f};
+    });
   }
 
+  //
+  // The grid finds the entities near the ray.  An entity still only counts
+  // if the ray also hits its unit's bounding sphere, which can cover a very
+  // large area as a unit can become seperated.
+
+  m_pickHits.clear();
+  m_pickUnitHits.assign(theTeam.m_units.Size(), -1);
+  grid.m_grid.ForEachNearLine(startRay, direction, [&](int _item)
+  {
+    auto [unit, i] = grid.m_items[_item];
+    if (!theTeam.m_units.ValidIndex(unit))
+      return;
+    Unit* theUnit = theTeam.m_units.GetData(unit);
+    if (!theUnit->m_entities.ValidIndex(i))
+      return;
+
+    signed char& unitHit = m_pickUnitHits[unit];
+    if (unitHit == -1)
+    {
+      bool rayHit = RaySphereIntersection(startRay, direction, theUnit->m_centerPos, theUnit->m_radius * 1.5f);
+      unitHit = rayHit && theUnit->NumAliveEntities() > 0 ? 1 : 0;
+    }
+    if (!unitHit)
+      return;
+
+    Entity* entity = theUnit->m_entities[i];
+    LegacyVector3 spherePos = entity->m_pos + entity->m_centerPos;
+    float sphereRadius = entity->m_radius * 1.5f;
+    LegacyVector3 hitPos;
+
+    bool entityHit = RaySphereIntersection(startRay, direction, spherePos, sphereRadius, 1e10, &hitPos);
+    if (entityHit && !entity->m_dead)
+      m_pickHits.push_back({(static_cast<uint64_t>(unit) << 32) | static_cast<uint32_t>(i), spherePos, hitPos});
+  });
+
+  float closestRangeSqd;
+  int closest = ClosestPickOnScreen(&closestRangeSqd);
+  int unitId = closest == -1 ? -1 : static_cast<int>(m_pickHits[closest].m_order >> 32);
+
   if (_range && unitId != -1)
     *_range = sqrtf(closestRangeSqd);
 
@@ -1726,38 +2556,50 @@ WorldObjectId Location::GetEntityId(const LegacyVector3& startRay, const LegacyV
   if (teamId == 255)
     return WorldObjectId();
 
-  float closestRangeSqd = FLT_MAX;
-  WorldObjectId entId;
+  Team& theTeam = m_teams[teamId];
+  PickGrid& grid = m_entityPickGrids[teamId];
 
-  int numEntities = m_teams[teamId].m_others.Size();
-  for (int i = 0; i < numEntities; ++i)
+  if (!IsPickGridCurrent(grid, SlotCount(theTeam.m_others)))
   {
-    if (m_teams[teamId].m_others.ValidIndex(i))
+    for (int i = 0; i < theTeam.m_others.Size(); ++i)
     {
-      Entity* ent = m_teams[teamId].m_others.GetData(i);
-      if (!ent->m_dead)
-      {
-        LegacyVector3 spherePos = ent->m_pos + ent->m_centerPos;
-        float sphereRadius = ent->m_radius * 1.5f;
-        LegacyVector3 hitPos;
-        bool rayHit = RaySphereIntersection(startRay, direction, spherePos, sphereRadius, 1e10, &hitPos);
-        if (rayHit)
-        {
-          float centerPosX, centerPosY, rayHitX, rayHitY;
-          g_context->m_camera->Get2DScreenPos(spherePos, &centerPosX, &centerPosY);
-          g_context->m_camera->Get2DScreenPos(hitPos, &rayHitX, &rayHitY);
-
-          float rangeSqd = pow(centerPosX - rayHitX, 2) + pow(centerPosY - rayHitY, 2);
-          if (rangeSqd < closestRangeSqd)
-          {
-            closestRangeSqd = rangeSqd;
-            entId = ent->m_id;
-          }
-        }
-      }
+      if (theTeam.m_others.ValidIndex(i))
+        grid.m_items.emplace_back(i, 0);
     }
+
+    grid.m_grid.Build(static_cast<int>(grid.m_items.size()), [&](int _item)
+    {
+      Entity* ent = theTeam.m_others.GetData(grid.m_items[_item].first);
+      LegacyVector3 spherePos = ent->m_pos + ent->m_centerPos;
+      return Neuron::SphereGrid::Sphere{spherePos.x, spherePos.y, spherePos.z, ent->m_radius * 1.5f};
+    });
   }
 
+  m_pickHits.clear();
+  grid.m_grid.ForEachNearLine(startRay, direction, [&](int _item)
+  {
+    int i = grid.m_items[_item].first;
+    if (!theTeam.m_others.ValidIndex(i))
+      return;
+
+    Entity* ent = theTeam.m_others.GetData(i);
+    if (!ent->m_dead)
+    {
+      LegacyVector3 spherePos = ent->m_pos + ent->m_centerPos;
+      float sphereRadius = ent->m_radius * 1.5f;
+      LegacyVector3 hitPos;
+      bool rayHit = RaySphereIntersection(startRay, direction, spherePos, sphereRadius, 1e10, &hitPos);
+      if (rayHit)
+        m_pickHits.push_back({static_cast<uint64_t>(i), spherePos, hitPos});
+    }
+  });
+
+  float closestRangeSqd;
+  int closest = ClosestPickOnScreen(&closestRangeSqd);
+  WorldObjectId entId;
+  if (closest != -1)
+    entId = theTeam.m_others.GetData(static_cast<int>(m_pickHits[closest].m_order))->m_id;
+
   if (_range && entId.IsValid())
     *_range = sqrtf(closestRangeSqd);
 
@@ -1767,47 +2609,59 @@ WorldObjectId Location::GetEntityId(const LegacyVector3& startRay, const LegacyV
 int Location::GetBuildingId(const LegacyVector3& rayStart, const LegacyVector3& rayDir, unsigned char teamId, float _maxDistance,
                             float* _range)
 {
-  float closestRangeSqd = FLT_MAX;
-  int buildingId = -1;
-
-  for (int i = 0; i < m_buildings.Size(); i++)
+  PickGrid& grid = m_buildingPickGrid;
+  if (!IsPickGridCurrent(grid, SlotCount(m_buildings)))
   {
-    if (m_buildings.ValidIndex(i))
+    for (int i = 0; i < m_buildings.Size(); i++)
     {
-      Building* building = m_buildings.GetData(i);
-      bool teamMatch = (teamId == 255 || building->m_id.GetTeamId() == 255 || teamId == building->m_id.GetTeamId());
+      if (m_buildings.ValidIndex(i))
+        grid.m_items.emplace_back(i, 0);
+    }
 
-      if (building->m_type != Building::TypeControlTower && teamMatch)
-      {
-        LegacyVector3 hitPos;
-        bool rayHit = false;
+    // A radar dish is hit by its shape, not its sphere, so it is never culled
+    grid.m_grid.Build(static_cast<int>(grid.m_items.size()), [&](int _item)
+    {
+      Building* building = m_buildings.GetData(grid.m_items[_item].first);
+      if (building->m_type == Building::TypeRadarDish)
+        return Neuron::SphereGrid::Sphere{0.0f, 0.0f, 0.0f, std::numeric_limits<float>::infinity()};
+      const LegacyVector3& c = building->m_centerPos;
+      return Neuron::SphereGrid::Sphere{c.x, c.y, c.z, building->m_radius};
+    });
+  }
 
-        if (building->m_type == Building::TypeRadarDish)
-        {
-          rayHit = building->DoesRayHit(rayStart, rayDir, 1e10);
-          if (rayHit)
-            RaySphereIntersection(rayStart, rayDir, building->m_centerPos, building->m_radius, _maxDistance, &hitPos);
-          // Have to do the raySphereIntersection in order to calculate the hitPos
-        }
-        else
-          rayHit = RaySphereIntersection(rayStart, rayDir, building->m_centerPos, building->m_radius, _maxDistance, &hitPos);
+  m_pickHits.clear();
+  grid.m_grid.ForEachNearLine(rayStart, rayDir, [&](int _item)
+  {
+    int i = grid.m_items[_item].first;
+    if (!m_buildings.ValidIndex(i))
+      return;
 
-        if (rayHit)
-        {
-          float centerPosX, centerPosY, rayHitX, rayHitY;
-          g_context->m_camera->Get2DScreenPos(building->m_centerPos, &centerPosX, &centerPosY);
-          g_context->m_camera->Get2DScreenPos(hitPos, &rayHitX, &rayHitY);
+    Building* building = m_buildings.GetData(i);
+    bool teamMatch = (teamId == 255 || building->m_id.GetTeamId() == 255 || teamId == building->m_id.GetTeamId());
 
-          float rangeSqd = pow(centerPosX - rayHitX, 2) + pow(centerPosY - rayHitY, 2);
-          if (rangeSqd < closestRangeSqd)
-          {
-            buildingId = building->m_id.GetUniqueId();
-            closestRangeSqd = rangeSqd;
-          }
-        }
+    if (building->m_type != Building::TypeControlTower && teamMatch)
+    {
+      LegacyVector3 hitPos;
+      bool rayHit = false;
+
+      if (building->m_type == Building::TypeRadarDish)
+      {
+        rayHit = building->DoesRayHit(rayStart, rayDir, 1e10);
+        if (rayHit)
+          RaySphereIntersection(rayStart, rayDir, building->m_centerPos, building->m_radius, _maxDistance, &hitPos);
+        // Have to do the raySphereIntersection in order to calculate the hitPos
       }
+      else
+        rayHit = RaySphereIntersection(rayStart, rayDir, building->m_centerPos, building->m_radius, _maxDistance, &hitPos);
+
+      if (rayHit)
+        m_pickHits.push_back({static_cast<uint64_t>(i), building->m_centerPos, hitPos});
     }
-  }
+  });
+
+  float closestRangeSqd;
+  int closest = ClosestPickOnScreen(&closestRangeSqd);
+  int buildingId = closest == -1 ? -1 : m_buildings.GetData(static_cast<int>(m_pickHits[closest].m_order))->m_id.GetUniqueId();
 
   if (_range)
     *_range = sqrtf(closestRangeSqd);
@@ -1950,10 +2804,13 @@ void Location::FireLaser(const LegacyVector3& _pos, const LegacyVector3& _vel, u
     break;
   }
 
-  Laser* l = m_lasers.GetPointer();
+  int laserIndex = m_lasers.GetNextFree();
+  Laser* l = m_lasers.GetPointer(laserIndex);
   l->m_pos = _pos;
   l->m_vel = _vel;
   l->m_fromTeamId = _teamId;
+  l->m_id.Set(_teamId, UNIT_LASERS, laserIndex, -1);
+  l->m_id.GenerateUniqueId();
   l->Initialise(lifetime);
 
   //
@@ -1986,7 +2843,7 @@ void Location::Bang(const LegacyVector3& _pos, float _range, float _damage)
   {
     LegacyVector3 vel(syncsfrand(20.0f), 10.0f + syncfrand(10.0f), syncsfrand(20.0f));
     float size = 120.0f + syncfrand(60.0f);
-    g_context->m_particleSystem->CreateParticle(_pos + g_upVector * _range * 0.3f, vel, Particle::TypeExplosionCore, size);
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(_pos + g_upVector * _range * 0.3f, vel, SimParticle::TypeExplosionCore, size));
   }
 
   int numDebris = std::max<int>(1, _range * _damage * 0.005f);
@@ -1994,7 +2851,7 @@ void Location::Bang(const LegacyVector3& _pos, float _range, float _damage)
   {
     LegacyVector3 vel(syncsfrand(30.0f), 20.0f + syncfrand(20.0f), syncsfrand(30.0f));
     float size = 30.0f + syncfrand(20.0f);
-    g_context->m_particleSystem->CreateParticle(_pos + g_upVector * _range * 0.5f, vel, Particle::TypeExplosionDebris, size);
+    g_context->m_simEventQueue.Push(SimEvent::MakeParticle(_pos + g_upVector * _range * 0.5f, vel, SimParticle::TypeExplosionDebris, size));
   }
 
   //
@@ -2030,17 +2887,10 @@ void Location::Bang(const LegacyVector3& _pos, float _range, float _damage)
   }
 
   //
-  // Is visible?
-
-  LegacyVector3 tmp;
-  bool isVisible = !m_landscape.RayHit(g_context->m_camera->GetPos(), _pos - g_context->m_camera->GetPos(), &tmp) || (tmp - g_context->m_camera->
-    GetPos()).Mag() > (_pos - g_context->m_camera->GetPos()).Mag() - 0.3f;
-
-  //
-  // Shockwave
+  // Shockwave.  Always, as it pushes entities; it used to depend on whether
+  // this client's camera could see the bang.
 
-  if (isVisible)
-    CreateShockwave(_pos, _range / 20.0f);
+  CreateShockwave(_pos, _range / 20.0f);
 
   //
   // Wow, that was a big bang. Maybe we killed a building
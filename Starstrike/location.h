@@ -1,6 +1,11 @@
 #pragma once
 
 #include "LegacyVector3.h"
+#include "LocationStatics.h"
+#include "SphereGrid.h"
+#include "SyncChecksum.h"
+#include "SyncReport.h"
+#include "WakeScheduler.h"
 #include "building.h"
 #include "fast_darray.h"
 #include "landscape.h"
@@ -35,6 +40,44 @@ class Location
     int m_lastSliceProcessed;
     bool m_missionComplete;
 
+    // Running sum of per-object state digests, one per subsystem (SyncSubsystem::Random is sampled on demand)
+    SyncChecksum m_syncChecksums[NumSyncSubsystems];
+
+    // Which m_buildings slots AdvanceBuildings visits; see Building::Sleep
+    WakeScheduler m_buildingSchedule;
+
+    // Ray picking.  A grid over the bounding spheres GetUnitId, GetEntityId
+    // or GetBuildingId test, rebuilt by the first pick after an Advance or a
+    // change in the slots it covers.  The cursor is picked several times a
+    // frame, so a grid serves a few queries before it goes stale.
+    struct PickGrid
+    {
+      Neuron::SphereGrid m_grid;
+      std::vector<std::pair<int, int>> m_items;   // Unit and entity slot; for the flat arrays, slot and 0
+      int m_epoch = -1;
+      uint64_t m_slots = 0;                       // SlotCount fingerprint at build time
+    };
+
+    struct PickHit
+    {
+      uint64_t m_order;                           // Position in a loop over the slots, for ties
+      LegacyVector3 m_spherePos;
+      LegacyVector3 m_hitPos;
+    };
+
+    int m_pickEpoch;                              // Bumped by Advance
+    PickGrid m_unitPickGrids[NUM_TEAMS];
+    PickGrid m_entityPickGrids[NUM_TEAMS];
+    PickGrid m_buildingPickGrid;
+    std::vector<PickHit> m_pickHits;
+    std::vector<LegacyVector3> m_pickPoints;
+    std::vector<float> m_pickScreenX;
+    std::vector<float> m_pickScreenY;
+    std::vector<signed char> m_pickUnitHits;
+
+    bool IsPickGridCurrent(PickGrid& _grid, uint64_t _slots);
+    int ClosestPickOnScreen(float* _rangeSqd);
+
     void LoadLevel(const char* _missionFilename, const char* _mapFilename);
 
     void AdvanceWeapons(int _slice);
@@ -63,6 +106,11 @@ class Location
 
     void DoMissionCompleteActions();
 
+    // A late-join snapshot, parsed apart from the live state; see ReadSnapshot
+    struct StagedSnapshot;
+    bool ParseSnapshot(SnapshotReader& _reader, StagedSnapshot* _snapshot) const;
+    void CommitSnapshot(StagedSnapshot* _snapshot);
+
     LegacyVector3 FindValidSpawnPosition(const LegacyVector3& _pos, float _spread);
 
   public:
@@ -87,6 +135,12 @@ class Location
     SliceDArray<Laser> m_lasers;
     SliceDArray<WorldObject*> m_effects;
 
+    LocationStatics m_statics;
+
+    void WakeBuilding(int _slot) { m_buildingSchedule.Wake(_slot); }
+    void WakeAllBuildings() { m_buildingSchedule.Clear(); }
+    int GetNumAwakeBuildings() const;
+
     Location();
     ~Location();
 
@@ -112,6 +166,7 @@ class Location
     void UpdateTeam(unsigned char teamId, const TeamControls& teamControls);
 
     int SpawnSpirit(const LegacyVector3& _pos, const LegacyVector3& _vel, unsigned char _teamId, WorldObjectId _id);
+    void RemoveSpirit(int _index); // Frees the slot and retires its sync state
     void ThrowWeapon(const LegacyVector3& _pos, const LegacyVector3& _target, int _type, unsigned char _fromTeamId);
     void FireRocket(const LegacyVector3& _pos, const LegacyVector3& _target, unsigned char _fromTeamId);
     void FireLaser(const LegacyVector3& _pos, const LegacyVector3& _vel, unsigned char _fromTeamId);
@@ -121,6 +176,22 @@ class Location
 
     bool MissionComplete();
 
+    // Lockstep desync detection: fold an object's state into its subsystem checksum
+    // after it advances, and retire its contribution when it is removed.
+    void UpdateSyncState(SyncSubsystem _subsystem, WorldObject* _object)
+    {
+      m_syncChecksums[static_cast<int>(_subsystem)].Update(_object->m_syncContribution, _object->GetSyncHash());
+    }
+
+    void RetireSyncState(SyncSubsystem _subsystem, WorldObject* _object) { m_syncChecksums[static_cast<int>(_subsystem)].Retire(_object->m_syncContribution); }
+    void GetSyncReport(SyncReport* _report) const;
+    void ComputeSyncReport(SyncReport* _report) const; // From every object's current state; for self checks
+
+    // Late join: the whole simulation state once _sequenceId has been processed.
+    // A snapshot that ReadSnapshot refuses leaves the Location as it was.
+    void WriteSnapshot(SnapshotWriter& _writer, int _sequenceId) const;
+    bool ReadSnapshot(SnapshotReader& _reader, int* _sequenceId);
+
     void AdvanceChristmas();
     static int ChristmasModEnabled(); // 0 = unavailable, 1 = enabled, 2 = disabled
 
@@ -24,6 +24,7 @@
 #include "location_input.h"
 #include "mainmenus.h"
 #include "math_utils.h"
+#include "net_load_test.h"
 #include "particle_system.h"
 #include "preferences.h"
 #include "profiler.h"
@@ -32,6 +33,7 @@
 #include "script.h"
 #include "server.h"
 #include "servertoclientletter.h"
+#include "snapshot_check.h"
 #include "sound_library_2d.h"
 #include "sound_library_3d_dsound.h"
 #include "soundsystem.h"
@@ -58,14 +60,10 @@
 //  Global Variables
 // ******************
 
-double g_startTime = DBL_MAX;
 double g_gameTime = 0.0;
 float g_advanceTime;
-double g_lastServerAdvance;
 float g_predictionTime;
 float g_targetFrameRate = 20.0f;
-int g_lastProcessedSequenceId = -1;
-int g_sliceNum; // Most recently advanced slice
 
 // ******************
 //  Local Functions
@@ -79,16 +77,16 @@ void UpdateAdvanceTime()
     g_advanceTime = 0.25f;
   g_gameTime = realTime;
 
-  g_predictionTime = static_cast<float>(realTime - g_lastServerAdvance) - 0.07f;
+  g_predictionTime = static_cast<float>(realTime - g_context->m_lastServerAdvance) - 0.07f;
 }
 
-double GetNetworkTime() { return g_lastProcessedSequenceId * 0.1f; }
+double GetNetworkTime() { return g_context->m_lastProcessedSequenceId * 0.1f; }
 
 void UpdateTargetFrameRate(int _currentSlice)
 {
-  int numUpdatesToProcess = g_context->m_clientToServer->m_lastValidSequenceIdFromServer - g_lastProcessedSequenceId;
+  int numUpdatesToProcess = g_context->m_clientToServer->m_lastValidSequenceIdFromServer - g_context->m_lastProcessedSequenceId;
   int numSlicesPending = numUpdatesToProcess * NUM_SLICES_PER_FRAME - _currentSlice;
-  float timeSinceStartOfAdvance = g_gameTime - g_lastServerAdvance;
+  float timeSinceStartOfAdvance = g_gameTime - g_context->m_lastServerAdvance;
   int numSlicesThatShouldBePending = 10 - timeSinceStartOfAdvance * 10.0f;
 
   // Increase or lower the target frame rate, depending on how far behind schedule
@@ -106,14 +104,15 @@ void UpdateTargetFrameRate(int _currentSlice)
 
 // ---------------------------------------------------------------------------
 // DrainSimEvents — process deferred side-effects from simulation.
-// Called after Location::Advance(), before ParticleSystem::Advance().
+// Called after Location::Advance(), before ParticleSystem::Advance(), so
+// the queue coalesces within one tick.
 // ---------------------------------------------------------------------------
 
 static void DrainSimEvents()
 {
-  for (int i = 0; i < g_simEventQueue.Count(); ++i)
+  for (int i = 0; i < g_context->m_simEventQueue.Count(); ++i)
   {
-    g_simEventQueue.Get(i).Visit(Overloaded{
+    g_context->m_simEventQueue.Get(i).Visit(Overloaded{
       [](const SimEvent::ParticleSpawn& e)
       {
         g_context->m_particleSystem->CreateParticle(
@@ -122,8 +121,8 @@ static void DrainSimEvents()
       },
       [](const SimEvent::Explosion& e)
       {
-        if (e.shape)
-          g_explosionManager.AddExplosion(e.shape, e.transform, e.fraction);
+        if (e.shape && g_context->m_explosionManager)
+          g_context->m_explosionManager->AddExplosion(e.shape, e.transform, e.fraction);
       },
       [](const SimEvent::SoundStop& e)
       {
@@ -153,24 +152,24 @@ static void DrainSimEvents()
       },
     });
   }
-  g_simEventQueue.Clear();
+  g_context->m_simEventQueue.Clear();
 }
 
 int GetNumSlicesToAdvance()
 {
-  int numUpdatesToProcess = g_context->m_clientToServer->m_lastValidSequenceIdFromServer - g_lastProcessedSequenceId;
+  int numUpdatesToProcess = g_context->m_clientToServer->m_lastValidSequenceIdFromServer - g_context->m_lastProcessedSequenceId;
   int numSlicesPending = numUpdatesToProcess * NUM_SLICES_PER_FRAME;
-  if (g_sliceNum != -1)
-    numSlicesPending -= g_sliceNum;
-  else if (g_sliceNum == -1)
+  if (g_context->m_sliceNum != -1)
+    numSlicesPending -= g_context->m_sliceNum;
+  else if (g_context->m_sliceNum == -1)
     numSlicesPending -= 10;
 
-  float timeSinceStartOfAdvance = g_gameTime - g_lastServerAdvance;
+  float timeSinceStartOfAdvance = g_gameTime - g_context->m_lastServerAdvance;
 
   int numSlicesToAdvance = timeSinceStartOfAdvance * 100;
-  if (g_sliceNum != -1)
-    numSlicesToAdvance -= g_sliceNum;
-  if (g_sliceNum == -1)
+  if (g_context->m_sliceNum != -1)
+    numSlicesToAdvance -= g_context->m_sliceNum;
+  if (g_context->m_sliceNum == -1)
     numSlicesToAdvance -= 10;
 
   //DEBUG_ASSERT( numSlicesToAdvance >= 0 );
@@ -220,9 +219,9 @@ bool ProcessServerLetters(ServerToClientLetter* letter)
       chunk->ApplyDelta(deltas, static_cast<int>(count));
 
 #ifdef PHEROMONE_ACTIVE
-      // Mark renderer dirty so pheromone overlay is rebuilt next frame.
+      // Mark this chunk dirty so its overlay is recoloured next frame.
       if (g_context->m_location->m_landscape.m_renderer)
-        g_context->m_location->m_landscape.m_renderer->MarkPheromoneDirty();
+        g_context->m_location->m_landscape.m_renderer->MarkPheromoneDirty(chunkX, chunkZ);
 #endif
     }
     return true;
@@ -246,7 +245,7 @@ bool ProcessServerLetters(ServerToClientLetter* letter)
 
 #ifdef PHEROMONE_ACTIVE
       if (g_context->m_location->m_landscape.m_renderer)
-        g_context->m_location->m_landscape.m_renderer->MarkPheromoneDirty();
+        g_context->m_location->m_landscape.m_renderer->MarkPheromoneDirty(chunkX, chunkZ);
 #endif
     }
     return true;
@@ -269,8 +268,6 @@ void RemoveAllWindows()
   }
 }
 
-unsigned char GenerateSyncValue() { return 255 * syncfrand(); }
-
 bool LocationGameLoop()
 {
   bool iAmAClient = true;
@@ -281,7 +278,12 @@ bool LocationGameLoop()
 
   TeamControls teamControls;
 
-  g_sliceNum = -1;
+  // Late-join, dormancy and match host self checks; see snapshot_check.h
+  int snapshotCheckAt = g_prefsManager->GetInt("SnapshotCheckAt", 0);
+  int dormancyCheckAt = g_prefsManager->GetInt("DormancyCheckAt", 0);
+  int matchHostCheckAt = g_prefsManager->GetInt("MatchHostCheckAt", 0);
+
+  g_context->m_sliceNum = -1;
 
   g_context->m_renderer->StartFadeIn(0.6f);
   g_context->m_soundSystem->TriggerOtherEvent(nullptr, "EnterLocation", SoundSourceBlueprint::TypeAmbience);
@@ -436,20 +438,71 @@ bool LocationGameLoop()
 
       // Drain pheromone bulk letters — these bypass sequence tracking and
       // are processed independently from the simulation tick stream.
+      while (ServerToClientLetter* bulk = g_context->m_clientToServer->GetNextBulkLetter())
+      {
+        RecordSnapshotCheckLetter(bulk, false);
+        ProcessServerLetters(bulk);
+        delete bulk;
+      }
+
+      // Late join.  Snapshots are only taken and loaded between ticks.
+      if (g_context->m_sliceNum == -1)
       {
-        g_context->m_clientToServer->m_inboxMutex->Lock();
-        while (g_context->m_clientToServer->m_bulkInbox.Size() > 0)
+        if (g_context->m_server && g_context->m_server->IsSnapshotRequested())
+        {
+          SnapshotWriter writer;
+          g_context->m_location->WriteSnapshot(writer, g_context->m_lastProcessedSequenceId);
+          g_context->m_server->SendSnapshot(g_context->m_lastProcessedSequenceId, writer.GetData(), writer.Size());
+        }
+
+        if (g_context->m_clientToServer->IsSnapshotComplete())
+        {
+          const SnapshotAssembler& snapshot = g_context->m_clientToServer->GetSnapshot();
+          SnapshotReader reader(snapshot.GetData(), snapshot.Size());
+          int sequenceId = -1;
+          if (g_context->m_location->ReadSnapshot(reader, &sequenceId))
+          {
+            // Begin() queued creation sounds for everything the snapshot rebuilt
+            g_context->m_simEventQueue.Clear();
+            DiscardSnapshotCheckRecording();
+
+            g_context->m_clientToServer->ResetSequence(sequenceId);
+            g_context->m_lastServerAdvance = static_cast<float>(sequenceId) * SERVER_ADVANCE_PERIOD + g_context->m_startTime;
+            g_context->m_lastProcessedSequenceId = sequenceId;
+
+            SyncReport syncReport;
+            g_context->m_location->GetSyncReport(&syncReport);
+            g_context->m_clientToServer->SendSyncronisation(g_context->m_lastProcessedSequenceId, syncReport);
+
+#ifdef PHEROMONE_ACTIVE
+            if (g_context->m_location->m_landscape.m_renderer)
+              g_context->m_location->m_landscape.m_renderer->MarkPheromoneDirty();
+#endif
+          }
+          else
+          {
+            DebugTrace("CLIENT : Rejected late-join snapshot {}\n", snapshot.GetSnapshotId());
+            g_context->m_clientToServer->DiscardSnapshot();
+          }
+        }
+
+        if (snapshotCheckAt > 0 && g_context->m_lastProcessedSequenceId >= snapshotCheckAt)
         {
-          ServerToClientLetter* bulk = g_context->m_clientToServer->m_bulkInbox[0];
-          g_context->m_clientToServer->m_bulkInbox.RemoveData(0);
-          g_context->m_clientToServer->m_inboxMutex->Unlock();
+          snapshotCheckAt = 0;
+          RunSnapshotCheck();
+        }
 
-          ProcessServerLetters(bulk);
-          delete bulk;
+        if (dormancyCheckAt > 0 && g_context->m_lastProcessedSequenceId >= dormancyCheckAt)
+        {
+          dormancyCheckAt = 0;
+          RunDormancyCheck();
+        }
 
-          g_context->m_clientToServer->m_inboxMutex->Lock();
+        if (matchHostCheckAt > 0 && g_context->m_lastProcessedSequenceId >= matchHostCheckAt)
+        {
+          matchHostCheckAt = 0;
+          RunMatchHostCheck();
         }
-        g_context->m_clientToServer->m_inboxMutex->Unlock();
       }
 
       int slicesToAdvance = GetNumSlicesToAdvance();
@@ -459,41 +512,43 @@ bool LocationGameLoop()
       // Do our heavy weight physics
       for (int i = 0; i < slicesToAdvance; ++i)
       {
-        if (g_sliceNum == -1)
+        if (g_context->m_sliceNum == -1)
         {
           // Read latest update from Server
           ServerToClientLetter* letter = g_context->m_clientToServer->GetNextLetter();
 
           if (letter)
           {
-            DEBUG_ASSERT(letter->GetSequenceId() == g_lastProcessedSequenceId + 1);
+            DEBUG_ASSERT(letter->GetSequenceId() == g_context->m_lastProcessedSequenceId + 1);
 
             //DebugTrace( "CLIENT : Processed update %d\n", letter->GetSequenceId() );
             //g_context->m_clientToServer->m_lastKnownSequenceIdFromServer = letter->GetSequenceId();
+            RecordSnapshotCheckLetter(letter, true);
             bool handled = ProcessServerLetters(letter);
             if (handled == false)
               g_context->m_clientToServer->ProcessServerUpdates(letter);
 
-            g_sliceNum = 0;
-            g_lastServerAdvance = static_cast<float>(letter->GetSequenceId()) * SERVER_ADVANCE_PERIOD + g_startTime;
-            g_lastProcessedSequenceId = letter->GetSequenceId();
+            g_context->m_sliceNum = 0;
+            g_context->m_lastServerAdvance = static_cast<float>(letter->GetSequenceId()) * SERVER_ADVANCE_PERIOD + g_context->m_startTime;
+            g_context->m_lastProcessedSequenceId = letter->GetSequenceId();
             delete letter;
 
-            unsigned char sync = GenerateSyncValue();
-            g_context->m_clientToServer->SendSyncronisation(g_lastProcessedSequenceId, sync);
+            SyncReport syncReport;
+            g_context->m_location->GetSyncReport(&syncReport);
+            g_context->m_clientToServer->SendSyncronisation(g_context->m_lastProcessedSequenceId, syncReport);
           }
         }
 
-        if (g_sliceNum != -1)
+        if (g_context->m_sliceNum != -1)
         {
-          g_context->m_location->Advance(g_sliceNum);
+          g_context->m_location->Advance(g_context->m_sliceNum);
           DrainSimEvents();
-          g_context->m_particleSystem->Advance(g_sliceNum);
+          g_context->m_particleSystem->Advance(g_context->m_sliceNum);
 
-          if (g_sliceNum < NUM_SLICES_PER_FRAME - 1)
-            g_sliceNum++;
+          if (g_context->m_sliceNum < NUM_SLICES_PER_FRAME - 1)
+            g_context->m_sliceNum++;
           else
-            g_sliceNum = -1;
+            g_context->m_sliceNum = -1;
         }
       }
 
@@ -514,7 +569,7 @@ bool LocationGameLoop()
       g_context->m_taskManager->Advance();
       g_context->m_taskManagerInterface->Advance();
       g_context->m_script->Advance();
-      g_explosionManager.Advance();
+      g_context->m_explosionManager->Advance();
       g_context->m_soundSystem->Advance();
 
       // DELETEME: for debug purposes only
@@ -530,7 +585,7 @@ bool LocationGameLoop()
   g_context->m_soundSystem->StopAllSounds(WorldObjectId(), "Ambience EnterLocation");
   g_context->m_soundSystem->TriggerOtherEvent(nullptr, "ExitLocation", SoundSourceBlueprint::TypeAmbience);
 
-  g_explosionManager.Reset();
+  g_context->m_explosionManager->Reset();
 
   if (g_context->m_globalWorld->GetLocationName(g_context->m_locationId))
     g_context->m_globalWorld->TransferSpirits(g_context->m_locationId);
@@ -719,6 +774,7 @@ bool EnterLocation()
     g_context->m_clientToServer->ClientJoin();
   }
 
+  StartSnapshotCheckRecording();
   g_context->m_location = new Location();
   g_context->m_locationInput = new LocationInput();
   g_context->m_location->Init(g_context->m_requestedMission, g_context->m_requestedMap);
@@ -800,4 +856,14 @@ void RunTheGame()
 }
 
 // Main Function
-void AppMain() { RunTheGame(); }
+void AppMain()
+{
+  if (g_prefsManager->GetInt("NetLoadTestBots", 0) > 0)
+  {
+    InitialiseHighResTime();
+    RunNetLoadTest();
+    return;
+  }
+
+  RunTheGame();
+}
@@ -0,0 +1,197 @@
+#include "pch.h"
+#include "net_load_test.h"
+#include "GameApp.h"
+#include "bot_client.h"
+#include "generic.h"
+#include "globals.h"
+#include "hi_res_time.h"
+#include "net_impairment.h"
+#include "net_socket_listener.h"
+#include "preferences.h"
+#include "server.h"
+#include "SyncReport.h"
+
+#define NETLOADTEST_REPORT      "NetLoadTest.txt"
+#define NETLOADTEST_SERVER_IP   "127.0.0.1"
+
+namespace
+{
+  struct BotRecord
+  {
+    std::unique_ptr<BotClient> m_bot;
+    int m_joinTick = -1;
+    int m_joinSequenceId = -1;  // Last letter the server had sent when the bot joined
+    int m_caughtUpTick = -1;    // First tick the bot had processed up to m_joinSequenceId
+  };
+
+  int Percentile(std::vector<int> _values, double _fraction)
+  {
+    if (_values.empty())
+      return 0;
+    std::ranges::sort(_values);
+    const size_t index = std::min(_values.size() - 1, static_cast<size_t>(_fraction * static_cast<double>(_values.size())));
+    return _values[index];
+  }
+}
+
+void RunNetLoadTest()
+{
+  const int numBots = g_prefsManager->GetInt("NetLoadTestBots", 0);
+  const float seconds = g_prefsManager->GetFloat("NetLoadTestSeconds", 30.0f);
+  const int joinsPerTick = std::max(1, g_prefsManager->GetInt("NetLoadTestJoinsPerTick", 4));
+  const int snapshotSize = std::max(1, g_prefsManager->GetInt("NetLoadTestSnapshotBytes", 16384));
+  const int numTicks = std::max(1, static_cast<int>(seconds / SERVER_ADVANCE_PERIOD));
+
+  //
+  // The test is a match of its own; the server's I/O threads bind to this
+  // context rather than the game's
+
+  GameContext context;
+  context.m_profiler = g_context->m_profiler;
+  GameContextScope scope(&context);
+
+  context.m_server = new Server();
+  context.m_server->Initialise();
+  Server* server = context.m_server;
+
+  // Bots have no simulation, so any snapshot will do as long as it takes several parts
+  std::vector<uint8_t> snapshot(snapshotSize, 0xA5);
+
+  std::unique_ptr<NetImpairment> botImpairment(CreateNetImpairmentFromPrefs(2));
+  std::vector<BotRecord> bots(numBots);
+  int numJoined = 0;
+  int numBindFailures = 0;
+
+  //
+  // Tick at the server's rate.  Bots join a few per tick, so the later ones
+  // arrive past SERVER_SNAPSHOT_MIN_SEQUENCE and exercise late join too.
+
+  const double startTime = GetHighResTime();
+  double nextTick = startTime;
+  int lateTicks = 0;
+
+  for (int tick = 0; tick < numTicks; ++tick)
+  {
+    for (int j = 0; j < joinsPerTick && numJoined < numBots; ++j, ++numJoined)
+    {
+      // Only NUM_TEAMS teams exist; every other bot drives no team, but its
+      // input and acknowledgements still load the server
+      BotRecord& record = bots[numJoined];
+      record.m_bot = std::make_unique<BotClient>(numJoined, NETLOADTEST_SERVER_IP, numJoined < NUM_TEAMS);
+      if (!record.m_bot->Connect(botImpairment.get()))
+      {
+        ++numBindFailures;
+        record.m_bot.reset();
+        continue;
+      }
+      record.m_joinTick = tick;
+      record.m_joinSequenceId = server->m_sequenceId - 1;
+    }
+
+    for (BotRecord& record : bots)
+    {
+      if (!record.m_bot)
+        continue;
+
+      record.m_bot->Advance();
+      if (record.m_caughtUpTick == -1 && record.m_bot->HasJoined() &&
+          record.m_bot->GetLastProcessedSequenceId() >= record.m_joinSequenceId)
+        record.m_caughtUpTick = tick;
+    }
+
+    if (server->IsSnapshotRequested())
+      server->SendSnapshot(server->m_sequenceId - 1, snapshot.data(), static_cast<int>(snapshot.size()));
+
+    server->Advance();
+
+    nextTick += SERVER_ADVANCE_PERIOD;
+    double now = GetHighResTime();
+    if (now < nextTick)
+      std::this_thread::sleep_for(std::chrono::duration<double>(nextTick - now));
+    else
+      ++lateTicks;
+  }
+
+  const double elapsed = GetHighResTime() - startTime;
+
+  //
+  // Gather the results before anyone leaves
+
+  BotClient::Stats total;
+  std::vector<int> catchUpTicks;
+  std::vector<int> lag;
+  int numConnected = 0;
+  int numNeverCaughtUp = 0;
+  for (const BotRecord& record : bots)
+  {
+    if (!record.m_bot)
+      continue;
+
+    ++numConnected;
+    const BotClient::Stats& stats = record.m_bot->GetStats();
+    total.m_datagramsSent += stats.m_datagramsSent;
+    total.m_bytesSent += stats.m_bytesSent;
+    total.m_datagramsReceived += stats.m_datagramsReceived;
+    total.m_bytesReceived += stats.m_bytesReceived;
+    total.m_lettersProcessed += stats.m_lettersProcessed;
+    total.m_duplicateLetters += stats.m_duplicateLetters;
+
+    if (record.m_caughtUpTick == -1)
+      ++numNeverCaughtUp;
+    else
+      catchUpTicks.push_back(record.m_caughtUpTick - record.m_joinTick);
+    lag.push_back(server->m_sequenceId - 1 - record.m_bot->GetLastProcessedSequenceId());
+  }
+
+  std::string report;
+  report += std::format("Net load test: {} bots for {} ticks in {:.1f}s ({} ticks late)\n", numConnected, numTicks, elapsed, lateTicks);
+  if (numBindFailures > 0)
+    report += std::format("  {} bots could not bind their address\n", numBindFailures);
+  if (botImpairment)
+  {
+    // The server impairs its own sends from the same preferences
+    const NetImpairmentConfig& config = botImpairment->GetConfig();
+    const NetImpairment::Stats impaired = botImpairment->GetStats();
+    report += std::format("  Impairment: loss {}%, duplicate {}%, reorder {}% (+{}ms), latency {}+{}ms, seed {}\n",
+                          config.m_lossPercent, config.m_duplicatePercent, config.m_reorderPercent, config.m_reorderMs,
+                          config.m_latencyMs, config.m_jitterMs, config.m_seed);
+    report += std::format("  Bot sends impaired: {} datagrams, {} lost, {} duplicated, {} reordered\n", impaired.m_datagrams,
+                          impaired.m_lost, impaired.m_duplicated, impaired.m_reordered);
+  }
+  report += std::format("  Server: {} letters ({:.1f}/s), inbox dropped {}, outbox dropped {}\n", server->m_sequenceId,
+                        server->m_sequenceId / elapsed, server->m_inboxDropped.load(), server->m_outboxDropped);
+  report += std::format("  Server -> bots: {} datagrams, {:.1f} KB/s, {} letters processed, {} duplicates\n",
+                        total.m_datagramsReceived, total.m_bytesReceived / elapsed / 1024.0, total.m_lettersProcessed,
+                        total.m_duplicateLetters);
+  report += std::format("  Bots -> server: {} datagrams, {:.1f} KB/s\n", total.m_datagramsSent, total.m_bytesSent / elapsed / 1024.0);
+  report += std::format("  Catch-up: median {} ticks, p95 {}, max {}, {} never caught up\n", Percentile(catchUpTicks, 0.5),
+                        Percentile(catchUpTicks, 0.95), Percentile(catchUpTicks, 1.0), numNeverCaughtUp);
+  report += std::format("  Lag at end: median {} letters, max {}\n", Percentile(lag, 0.5), Percentile(lag, 1.0));
+  report += std::format("  Desyncs: {} reports", server->m_desyncReports);
+  if (server->m_firstDesyncSequenceId != -1)
+    report += std::format(", first at sequence {} in {}", server->m_firstDesyncSequenceId, SyncReport::GetSubsystemName(server->m_firstDesyncSubsystem));
+  report += "\n";
+
+  DebugTrace("{}", report);
+  if (FILE* file = fopen(NETLOADTEST_REPORT, "w"))
+  {
+    fputs(report.c_str(), file);
+    fclose(file);
+  }
+
+  //
+  // Say goodbye, give the server a tick to hear it, then shut down
+
+  for (BotRecord& record : bots)
+  {
+    if (record.m_bot)
+      record.m_bot->Leave();
+  }
+  std::this_thread::sleep_for(std::chrono::duration<double>(SERVER_ADVANCE_PERIOD));
+  server->Advance();
+
+  // The Server stops its own listen and send threads, which run in this
+  // context, and releases its port before the context goes
+  bots.clear();
+  SAFE_DELETE(context.m_server);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Hosts a server in this process and runs NetLoadTestBots headless bots
+// against it over loopback for NetLoadTestSeconds, under whatever network
+// conditions the NetSim preferences describe.  Writes throughput, catch-up
+// time and desync count to NetLoadTest.txt.
+void RunNetLoadTest();
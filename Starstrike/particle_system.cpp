@@ -6,6 +6,7 @@
 
 #include "hi_res_time.h"
 #include "math_utils.h"
+#include "preferences.h"
 #include "profiler.h"
 #include "resource.h"
 
@@ -29,6 +30,7 @@ ParticleType::ParticleType()
 	m_size(1000.0f),
 	m_friction(0.0f),
 	m_gravity(0.0f),
+	m_priority(0),
 	m_colour1(0.5f, 0.5f, 0.5f),
 	m_colour2(0.95f, 0.95f, 0.95f)
 {
@@ -41,162 +43,6 @@ ParticleType::ParticleType()
 
 ParticleType Particle::m_types[TypeNumTypes];
 
-// *** Constructor
-Particle::Particle()
-{
-}
-
-
-// *** Initialise
-void Particle::Initialise(LegacyVector3 const &_pos, LegacyVector3 const &_vel,
-                          int _typeId, float _size)
-{
-	DEBUG_ASSERT(_typeId < Particle::TypeNumTypes);
-
-	m_pos = _pos;
-	m_vel = _vel;
-	m_typeId = _typeId;
-
-	ParticleType const &type = m_types[_typeId];
-	float amount = frand();
-	m_colour = type.m_colour1 * amount + type.m_colour2 * (1.0f - amount);
-
-    if( _size == -1 )
-    {
-        m_size = type.m_size;
-    }
-    else
-    {
-        m_size = _size;
-    }
-
-	m_birthTime = g_gameTime;
-}
-
-
-// *** Advance
-// Returns true if this particle should be removed from the particle list
-bool Particle::Advance()
-{
-	ParticleType const &type = m_types[m_typeId];
-	double timeToDie = m_birthTime + m_types[m_typeId].m_life;
-	if (g_gameTime > timeToDie)
-	{
-		return true;
-	}
-
-	m_pos += m_vel * SERVER_ADVANCE_PERIOD;
-
-	float amount = SERVER_ADVANCE_PERIOD * type.m_friction;
-	m_vel *= (1.0f - amount);
-
-	if (type.m_gravity != 0.0f)
-	{
-        float gravityScale = m_size / m_types[m_typeId].m_size;
-		m_vel.y -= SERVER_ADVANCE_PERIOD * type.m_gravity * gravityScale;
-	}
-
-
-    //
-    // Particles that spawn particles
-
-    bool particleCreated = false;
-
-    if( m_typeId == TypeExplosionDebris )
-    {
-        if( frand() < 0.3f )
-        {
-			// *** WARNING ***
-			// CreateParticle might have to resize the particles array, which
-			// might invalidate what "p" points to, so we need to make local
-			// copies of the bits of p that we need
-			LegacyVector3 pos = m_pos;
-			LegacyVector3 vel = m_vel / 5.0f;
-            g_context->m_particleSystem->CreateParticle( pos, vel, Particle::TypeRocketTrail, m_size/2.0f );
-            particleCreated = true;
-        }
-    }
-
-
-    //
-    // Particles that bounce
-
-    if( !particleCreated )
-    {
-        if( m_typeId == TypeSpark ||
-            m_typeId == TypeBrass ||
-            m_typeId == TypeBlueSpark ||
-			m_typeId == TypeLeaf )
-        {
-            float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue(m_pos.x, m_pos.z);
-            if( m_pos.y <= landHeight )
-            {
-	            LegacyVector3 lastPos = m_pos;// - m_vel * g_advanceTime;
-	            LegacyVector3 impactPos = (m_pos + lastPos) * 0.5f;
-	            m_pos = impactPos;
-	            m_pos.y = g_context->m_location->m_landscape.m_heightMap->GetValue(m_pos.x, m_pos.z);
-
-                LegacyVector3 normal = g_context->m_location->m_landscape.m_normalMap->GetValue(m_pos.x, m_pos.z);
-                float dotProd = normal * m_vel;
-                m_vel -= normal * 2.0f * dotProd * 0.7f;
-            }
-        }
-    }
-
-    return false;
-}
-
-
-// *** Render
-void Particle::Render(float _predictionTime)
-{
-    double birthTime = m_birthTime;
-	double deathTime = m_birthTime + m_types[m_typeId].m_life;
-    float startFade = birthTime + m_types[m_typeId].m_life * 0.75f;
-    int alpha;
-    if( g_gameTime < startFade )
-    {
-        alpha = 90;
-    }
-    else
-    {
-        float fractionFade = (g_gameTime - startFade) / (deathTime - startFade);
-        alpha = 90 - 90 * fractionFade;
-        if( alpha < 0 ) alpha = 0;
-    }
-
-    LegacyVector3 predictedPos = m_pos + _predictionTime * m_vel;
-    float size = m_size/16.0f;
-	LegacyVector3 up(g_context->m_camera->GetUp() * size);
-	LegacyVector3 right(g_context->m_camera->GetRight() * size);
-
-    if( m_typeId == TypeMissileTrail )
-    {
-        glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_COLOR );
-        float fraction = (float) alpha / 100.0f;
-        glColor4ub(m_colour.r*fraction, m_colour.g*fraction, m_colour.b*fraction, 0.0f );
-    }
-    else
-    {
-        glBlendFunc ( GL_SRC_ALPHA, GL_ONE );
-        glColor4ub(m_colour.r, m_colour.g, m_colour.b, alpha );
-    }
-
-    glBegin( GL_QUADS );
-		glTexCoord2i(0, 0);
-        glVertex3fv( (predictedPos - up).GetData() );
-
-		glTexCoord2i(0, 1);
-        glVertex3fv( (predictedPos + right).GetData() );
-
-		glTexCoord2i(1, 1);
-		glVertex3fv( (predictedPos + up).GetData() );
-
-		glTexCoord2i(1, 0);
-		glVertex3fv( (predictedPos - right).GetData() );
-    glEnd();
-}
-
 
 // *** SetupParticles
 void Particle::SetupParticles()
@@ -292,6 +138,21 @@ void Particle::SetupParticles()
     m_types[TypeLeaf].m_colour1.Set( 50, 150, 50 );
     m_types[TypeLeaf].m_colour2.Set( 50, 200, 50 );
 
+    // Which particles survive when the budget is full: explosions and
+    // muzzle flashes over sparks and fire, over trails and litter
+    m_types[TypeExplosionCore].m_priority = 3;
+    m_types[TypeMuzzleFlash].m_priority = 3;
+    m_types[TypeMissileFire].m_priority = 3;
+    m_types[TypeExplosionDebris].m_priority = 2;
+    m_types[TypeControlFlash].m_priority = 2;
+    m_types[TypeFire].m_priority = 1;
+    m_types[TypeSpark].m_priority = 1;
+    m_types[TypeBlueSpark].m_priority = 1;
+    m_types[TypeDarwinianFire].m_priority = 1;
+    m_types[TypeRocketTrail].m_priority = 0;
+    m_types[TypeBrass].m_priority = 0;
+    m_types[TypeMissileTrail].m_priority = 0;
+    m_types[TypeLeaf].m_priority = 0;
 }
 
 
@@ -299,13 +160,14 @@ void Particle::SetupParticles()
 // ParticleSystem
 // ****************************************************************************
 
+// Particles integrated per job when the advance is spread over the job system
+static constexpr int PARTICLE_BLOCK_SIZE = 4096;
+
+
 // *** Constructor
 ParticleSystem::ParticleSystem()
+:   m_particles(g_prefsManager->GetInt("RenderParticleBudget", 10000))
 {
-    m_particles.SetSize( 1500 );
-    m_particles.SetStepSize( 200 );
-	m_particles.SetTotalNumSlices(NUM_SLICES_PER_FRAME);
-
 	Particle::SetupParticles();
 }
 
@@ -314,35 +176,116 @@ ParticleSystem::ParticleSystem()
 void ParticleSystem::CreateParticle(LegacyVector3 const &_pos, LegacyVector3 const &_vel,
                                     int _typeId, float _size, RGBAColour col)
 {
-	Particle *aParticle = m_particles.GetPointer();
-    aParticle->Initialise(_pos, _vel, _typeId, _size);
+	DEBUG_ASSERT(_typeId < Particle::TypeNumTypes);
+	ParticleType const &type = Particle::GetType(_typeId);
+
+	Neuron::ParticleSpawn spawn;
+	spawn.m_pos = XMFLOAT3(_pos.x, _pos.y, _pos.z);
+	spawn.m_vel = XMFLOAT3(_vel.x, _vel.y, _vel.z);
+	spawn.m_size = ( _size == -1 ) ? type.m_size : _size;
+	spawn.m_type = static_cast<uint8_t>(_typeId);
+	spawn.m_priority = static_cast<uint8_t>(type.m_priority);
+
+	// Friction and gravity folded into per-step constants, in the same
+	// order of operations the scalar Particle::Advance used
+	spawn.m_damping = 1.0f - SERVER_ADVANCE_PERIOD * type.m_friction;
+	if (type.m_gravity != 0.0f)
+	{
+		float gravityScale = spawn.m_size / type.m_size;
+		spawn.m_gravityStep = SERVER_ADVANCE_PERIOD * type.m_gravity * gravityScale;
+	}
+
+	float birthTime = g_gameTime;
+	spawn.m_deathTime = birthTime + type.m_life;
+
+	float amount = frand();
+	RGBAColour colour = type.m_colour1 * amount + type.m_colour2 * (1.0f - amount);
 	if( col != RGBAColour(0))
 	{
-		aParticle->m_colour = col;
+		colour = col;
 	}
+	memcpy(&spawn.m_colour, &colour, sizeof(spawn.m_colour));
+
+	m_particles.Spawn(spawn);
 }
 
 
 // *** Advance
+// Every particle moves once per server tick, on slice 0: expired ones are
+// removed, the rest are integrated in blocks across the job system, then the
+// few types with extra behaviour are handled one by one.
 void ParticleSystem::Advance(int _slice)
 {
+    if (_slice != 0)
+        return;
+
     START_PROFILE(g_context->m_profiler, "Advance Particles");
 
-    int lower, upper;
-    m_particles.GetNextSliceBounds( _slice, &lower, &upper );
-    for( int i = lower; i <= upper; ++i )
+    m_particles.RemoveExpired(g_gameTime);
+
+    const int count = m_particles.Count();
+    const int numBlocks = (count + PARTICLE_BLOCK_SIZE - 1) / PARTICLE_BLOCK_SIZE;
+    ParallelFor(g_context->m_jobSystem, 0, numBlocks, 1, [&](int _block)
     {
-        if( m_particles.ValidIndex(i) )
+        const int begin = _block * PARTICLE_BLOCK_SIZE;
+        m_particles.Integrate(begin, std::min(count, begin + PARTICLE_BLOCK_SIZE), SERVER_ADVANCE_PERIOD);
+    });
+
+    AdvanceSpecial();
+
+    END_PROFILE(g_context->m_profiler, "Advance Particles");
+}
+
+
+// *** AdvanceSpecial
+// Debris leaves trails and sparks, brass and leaves bounce off the ground
+void ParticleSystem::AdvanceSpecial()
+{
+    struct Trail
+    {
+        LegacyVector3 m_pos;
+        LegacyVector3 m_vel;
+        float m_size;
+    };
+    std::vector<Trail> trails;  // Spawned after the loop so no particle moves under it
+
+    const int count = m_particles.Count();
+    for (int i = 0; i < count; ++i)
+    {
+        int typeId = m_particles.GetType(i);
+        if( typeId == Particle::TypeExplosionDebris )
+        {
+            if( frand() < 0.3f )
+            {
+                XMFLOAT3 pos = m_particles.GetPos(i);
+                XMFLOAT3 vel = m_particles.GetVel(i);
+                trails.push_back({ LegacyVector3(pos.x, pos.y, pos.z), LegacyVector3(vel.x, vel.y, vel.z) / 5.0f, m_particles.GetSize(i) / 2.0f });
+            }
+        }
+        else if( typeId == Particle::TypeSpark ||
+                 typeId == Particle::TypeBrass ||
+                 typeId == Particle::TypeBlueSpark ||
+                 typeId == Particle::TypeLeaf )
         {
-            Particle *p = m_particles.GetPointer(i);
-			if (p->Advance())
-			{
-				m_particles.MarkNotUsed(i);
-			}
-		}
+            XMFLOAT3 pos = m_particles.GetPos(i);
+            float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue(pos.x, pos.z);
+            if( pos.y <= landHeight )
+            {
+                pos.y = landHeight;
+                m_particles.SetPos(i, pos);
+
+                XMFLOAT3 vel = m_particles.GetVel(i);
+                LegacyVector3 velocity(vel.x, vel.y, vel.z);
+                LegacyVector3 normal = g_context->m_location->m_landscape.m_normalMap->GetValue(pos.x, pos.z);
+                float dotProd = normal * velocity;
+                velocity -= normal * 2.0f * dotProd * 0.7f;
+                m_particles.SetVel(i, XMFLOAT3(velocity.x, velocity.y, velocity.z));
+            }
+        }
     }
 
-    END_PROFILE(g_context->m_profiler, "Advance Particles");
+    for (const Trail& trail : trails)
+        CreateParticle(trail.m_pos, trail.m_vel, Particle::TypeRocketTrail, trail.m_size);
 }
 
 
@@ -360,26 +303,66 @@ void ParticleSystem::Render()
 	glTexParameteri	(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
     glDepthMask ( false );
 
+	// Every particle is advanced on slice 0, so all are up to date with
+	// the last server advance
+    LegacyVector3 cameraUp = g_context->m_camera->GetUp();
+    LegacyVector3 cameraRight = g_context->m_camera->GetRight();
+  	int count = m_particles.Count();
 
-	// Render all the particles that are up-to-date with server advances
-    int lastUpdated = m_particles.GetLastUpdated();
-  	int size = m_particles.Size();
-
-    for (int i = 0; i < size; i++)
+    for (int i = 0; i < count; i++)
 	{
-        if (m_particles.ValidIndex(i))
+        ParticleType const &type = Particle::GetType(m_particles.GetType(i));
+        double deathTime = m_particles.GetDeathTime(i);
+        double birthTime = deathTime - type.m_life;
+        float startFade = birthTime + type.m_life * 0.75f;
+        int alpha;
+        if( g_gameTime < startFade )
+        {
+            alpha = 90;
+        }
+        else
         {
-            Particle *p = m_particles.GetPointer(i);
+            float fractionFade = (g_gameTime - startFade) / (deathTime - startFade);
+            alpha = 90 - 90 * fractionFade;
+            if( alpha < 0 ) alpha = 0;
+        }
 
-            if( i <= lastUpdated )
-            {
-			    p->Render(g_predictionTime);
-            }
-            else
-            {
-                p->Render(g_predictionTime+SERVER_ADVANCE_PERIOD);
-            }
+        XMFLOAT3 pos = m_particles.GetPos(i);
+        XMFLOAT3 vel = m_particles.GetVel(i);
+        LegacyVector3 predictedPos = LegacyVector3(pos.x, pos.y, pos.z) + g_predictionTime * LegacyVector3(vel.x, vel.y, vel.z);
+        float size = m_particles.GetSize(i) / 16.0f;
+        LegacyVector3 up(cameraUp * size);
+        LegacyVector3 right(cameraRight * size);
+
+        uint32_t packedColour = m_particles.GetColour(i);
+        RGBAColour colour;
+        memcpy(&colour, &packedColour, sizeof(colour));
+
+        if( m_particles.GetType(i) == Particle::TypeMissileTrail )
+        {
+            glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_COLOR );
+            float fraction = (float) alpha / 100.0f;
+            glColor4ub(colour.r*fraction, colour.g*fraction, colour.b*fraction, 0.0f );
+        }
+        else
+        {
+            glBlendFunc ( GL_SRC_ALPHA, GL_ONE );
+            glColor4ub(colour.r, colour.g, colour.b, alpha );
         }
+
+        glBegin( GL_QUADS );
+		    glTexCoord2i(0, 0);
+            glVertex3fv( (predictedPos - up).GetData() );
+
+		    glTexCoord2i(0, 1);
+            glVertex3fv( (predictedPos + right).GetData() );
+
+		    glTexCoord2i(1, 1);
+		    glVertex3fv( (predictedPos + up).GetData() );
+
+		    glTexCoord2i(1, 0);
+		    glVertex3fv( (predictedPos - right).GetData() );
+        glEnd();
 	}
 
     glDepthMask ( true );
@@ -396,5 +379,5 @@ void ParticleSystem::Render()
 // *** Empty
 void ParticleSystem::Empty()
 {
-	m_particles.Empty();
+	m_particles.Clear();
 }
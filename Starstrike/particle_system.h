@@ -1,8 +1,8 @@
 #pragma once
 
 #include "rgb_colour.h"
-#include "slice_darray.h"
 #include "LegacyVector3.h"
+#include "ParticleStore.h"
 
 
 // ****************************************************************************
@@ -19,6 +19,7 @@ public:
 	float m_size;
 	float m_friction;		// Amount of friction to apply (0=none 1=a huge amount)
 	float m_gravity;		// Amount of gravity to apply (0=none 1=quite a lot)
+	int m_priority;			// Which particles survive when the budget is full (0 goes first)
 	RGBAColour m_colour1;		// Start of colour range
 	RGBAColour m_colour2;		// End of colour range
 
@@ -56,20 +57,7 @@ private:
 	static ParticleType m_types[TypeNumTypes];
 
 public:
-	LegacyVector3         m_pos;
-	LegacyVector3         m_vel;
-	float           m_birthTime;
-	int				m_typeId;
-    float           m_size;
-    RGBAColour      m_colour;
-
-	Particle();
-
-    void Initialise(LegacyVector3 const &_pos, LegacyVector3 const &_vel,
-                    int _type, float _size=-1.0f);
-	bool Advance();
-	void Render(float _predictionTime);
-
+    static ParticleType const &GetType(int _typeId) { return m_types[_typeId]; }
     static void SetupParticles();
 };
 
@@ -82,7 +70,9 @@ public:
 class ParticleSystem
 {
 private:
-	SliceDArray         <Particle> m_particles;
+	Neuron::ParticleStore m_particles;
+
+	void AdvanceSpecial();
 
 public:
 	ParticleSystem();
@@ -93,5 +83,8 @@ public:
 	void Advance(int _slice);
 	void Render();
 	void Empty();
+
+	Neuron::ParticleStore::Stats const &GetStats() const { return m_particles.GetStats(); }
+	int GetNumParticles() const { return m_particles.Count(); }
 };
 
@@ -244,22 +244,28 @@ void Renderer::RenderHUD()
   if (m_displayFPS)
   {
     const auto& gpuStats = OpenGLD3D::GetFrameStats();
+    const auto& eventStats = g_context->m_simEventQueue.GetStats();
+    const auto& particleStats = g_context->m_particleSystem->GetStats();
 
     glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
     glBegin(GL_QUADS);
     glVertex2f(8.0f, 1.0f);
-    glVertex2f(290.0f, 1.0f);
-    glVertex2f(290.0f, 15.0f);
+    glVertex2f(560.0f, 1.0f);
+    glVertex2f(560.0f, 15.0f);
     glVertex2f(8.0f, 15.0f);
     glEnd();
 
     glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
     g_editorFont.DrawText2D(12, 10, DEF_FONT_SIZE,
-      "FPS:%d  DC:%u  PSO:%u  Upload:%uKB",
+      "FPS:%d  DC:%u  PSO:%u  Upload:%uKB  Events:%d peak, %d dropped  Particles:%d, %d culled",
       m_fps,
       gpuStats.drawCalls,
       gpuStats.psoSwitches,
-      gpuStats.uploadHighWaterMark / 1024);
+      gpuStats.uploadHighWaterMark / 1024,
+      eventStats.m_peakDepth,
+      static_cast<int>(eventStats.m_dropped),
+      g_context->m_particleSystem->GetNumParticles(),
+      static_cast<int>(particleStats.m_dropped + particleStats.m_evicted));
   }
 
   if (m_displayInputMode)
@@ -291,7 +297,7 @@ void Renderer::RenderHUD()
 
   if (g_context->m_server)
   {
-    int latency = g_context->m_server->m_sequenceId - g_lastProcessedSequenceId;
+    int latency = g_context->m_server->m_sequenceId - g_context->m_lastProcessedSequenceId;
     if (latency > 10)
     {
       glColor4f(0.0f, 0.0f, 0.0f, 0.8f);
@@ -358,7 +364,7 @@ void Renderer::RenderFrame(bool withFlip)
   else
     g_context->m_globalWorld->Render();
 
-  g_explosionManager.Render();
+  g_context->m_explosionManager->Render();
   g_context->m_particleSystem->Render();
 
   // ====== 3D PASS ======
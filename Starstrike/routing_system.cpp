@@ -121,56 +121,66 @@ WayPoint *Route::GetWayPoint(int _id)
 }
 
 
-int	Route::GetIdOfNearestWayPoint(LegacyVector3 const &_pos)
+// *** UpdateWayPointPositions
+// Ground and 3D waypoints stay put once the level is loaded, so their
+// positions are resolved when the route changes size.  Building waypoints
+// follow their building's entrance, which a radar dish moves as it aims, so
+// those are resolved again on every search; the grid is only rebuilt when
+// one has actually moved.
+void Route::UpdateWayPointPositions()
 {
-	int idOfNearest = -1;
-	float distToNearestSqrd = FLT_MAX;
-
 	int size = m_wayPoints.Size();
-	for (int i = 0; i < size; ++i)
+	bool moved = false;
+
+	if (size != static_cast<int>(m_wayPointGrid.m_pos.size()))
+	{
+		m_wayPointGrid.m_pos.resize(size);
+		m_buildingWayPoints.clear();
+		for (int i = 0; i < size; ++i)
+		{
+			WayPoint *wp = m_wayPoints.GetData(i);
+			m_wayPointGrid.m_pos[i] = wp->GetPos();
+			if (wp->m_type == WayPoint::TypeBuilding)
+			{
+				m_buildingWayPoints.push_back(i);
+			}
+		}
+		moved = true;
+	}
+	else
 	{
-		WayPoint *wp = m_wayPoints.GetData(i);
-		LegacyVector3 delta = _pos - wp->GetPos();
-		float distSqrd = delta.MagSquared();
-		if (distSqrd < distToNearestSqrd)
+		for (int i : m_buildingWayPoints)
 		{
-			distToNearestSqrd = distSqrd;
-			idOfNearest = i;
+			LegacyVector3 pos = m_wayPoints.GetData(i)->GetPos();
+			LegacyVector3 const &cached = m_wayPointGrid.m_pos[i];
+			if (pos.x != cached.x || pos.y != cached.y || pos.z != cached.z)
+			{
+				m_wayPointGrid.m_pos[i] = pos;
+				moved = true;
+			}
 		}
 	}
 
-	return idOfNearest;
+	if (moved)
+	{
+		m_wayPointGrid.Build();
+	}
 }
 
 
-// Returns the id of the first waypoint of the nearest edge
-int	Route::GetIdOfNearestEdge(LegacyVector3 const &_pos, [[maybe_unused]] float *_dist)
+int	Route::GetIdOfNearestWayPoint(LegacyVector3 const &_pos)
 {
-	int idOfNearest = 0;
-	float distToNearest = FLT_MAX;
+	UpdateWayPointPositions();
+	return m_wayPointGrid.GetIdOfNearestWayPoint(_pos);
+}
 
-	Vector2 pos(_pos.x, _pos.z);
-	WayPoint *wp = m_wayPoints.GetData(0);
-	LegacyVector3 newPos = wp->GetPos();
-	Vector2 oldPos( newPos.x, newPos.z );
 
-	int size = m_wayPoints.Size();
-	for (int i = 1; i < size; ++i)
-	{
-		wp = m_wayPoints.GetData(i);
-		newPos = wp->GetPos();
-		Vector2 temp(newPos.x, newPos.z);
-		float dist = PointSegDist2D(pos, oldPos, temp);
-		oldPos = temp;
-
-		if (dist < distToNearest)
-		{
-			distToNearest = dist;
-			idOfNearest = i;
-		}
-	}
-
-	return idOfNearest - 1;
+// Returns the id of the first waypoint of the nearest edge, and the
+// distance to it in _dist if asked
+int	Route::GetIdOfNearestEdge(LegacyVector3 const &_pos, float *_dist)
+{
+	UpdateWayPointPositions();
+	return m_wayPointGrid.GetIdOfNearestEdge(_pos, _dist);
 }
 
 
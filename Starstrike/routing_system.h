@@ -3,6 +3,7 @@
 
 #include "llist.h"
 #include "LegacyVector3.h"
+#include "waypoint_grid.h"
 
 
 // ****************************************************************************
@@ -40,6 +41,12 @@ public:
 
 class Route
 {
+protected:
+	WayPointGrid				m_wayPointGrid;			// Resolved waypoint positions, for the searches
+	std::vector<int>			m_buildingWayPoints;	// Ids of TypeBuilding waypoints, which can move
+
+	void		UpdateWayPointPositions ();
+
 public:
 	int			m_id;
 	LList       <WayPoint *>m_wayPoints;
@@ -0,0 +1,459 @@
+#include "pch.h"
+#include "snapshot_check.h"
+#include "GameApp.h"
+#include "globals.h"
+#include "hi_res_time.h"
+#include "level_file.h"
+#include "location.h"
+#include "main.h"
+#include "MatchHost.h"
+#include "preferences.h"
+#include "render_backend_interface.h"
+#include "servertoclientletter.h"
+#include "SyncReport.h"
+#include "taskmanager.h"
+
+#define SNAPSHOTCHECK_REPORT    "SnapshotCheck.txt"
+#define DORMANCYCHECK_REPORT    "DormancyCheck.txt"
+#define MATCHHOSTCHECK_REPORT   "MatchHostCheck.txt"
+
+namespace
+{
+  // Every letter the client has applied to its Location since it entered it,
+  // and the match state the Location started from, so that RunSnapshotCheck
+  // can replay the match from tick 0.  Client main thread only.
+  struct Recording
+  {
+    struct Entry
+    {
+      std::unique_ptr<ServerToClientLetter> m_letter;
+      bool m_tick;      // Begins a tick, rather than a bulk letter applied out of band
+      int m_slice;      // Bulk letters: the next slice due when applied, -1 between ticks
+    };
+
+    bool m_active = false;
+    SyncRandState m_syncRandom;
+    int m_nextUniqueId = 0;
+    int m_difficultyLevel = 0;
+    std::vector<Entry> m_entries;
+  };
+
+  Recording s_recording;
+
+  // One tick of g_context's Location, as the client loop runs it once a letter is in.
+  // _recompute hashes every object rather than trusting the incremental sums.
+  void AdvanceTick(std::vector<SyncReport>* _reports, bool _recompute = false)
+  {
+    for (int slice = 0; slice < NUM_SLICES_PER_FRAME; ++slice)
+      g_context->m_location->Advance(slice);
+    g_context->m_simEventQueue.Clear();
+
+    SyncReport report;
+    if (_recompute)
+      g_context->m_location->ComputeSyncReport(&report);
+    else
+      g_context->m_location->GetSyncReport(&report);
+    _reports->push_back(report);
+  }
+
+  // A restored Location is a match of its own.  It shares the game's
+  // systems, but has its own sync random stream, unique ids and events.
+  void ShareSystems(GameContext* _context)
+  {
+    _context->m_userInput = g_context->m_userInput;
+    _context->m_soundSystem = g_context->m_soundSystem;
+    _context->m_particleSystem = g_context->m_particleSystem;
+    _context->m_langTable = g_context->m_langTable;
+    _context->m_profiler = g_context->m_profiler;
+    _context->m_jobSystem = g_context->m_jobSystem;
+    _context->m_globalWorld = g_context->m_globalWorld;
+    _context->m_locationId = g_context->m_locationId;
+    _context->m_camera = g_context->m_camera;
+    _context->m_renderer = g_context->m_renderer;
+    _context->m_locationInput = g_context->m_locationInput;
+    _context->m_taskManager = g_context->m_taskManager;
+    _context->m_taskManagerInterface = g_context->m_taskManagerInterface;
+    _context->m_script = g_context->m_script;
+    _context->m_gameCursor = g_context->m_gameCursor;
+    _context->m_gameCursor2D = g_context->m_gameCursor2D;
+    _context->m_bypassNetworking = true;
+    _context->m_difficultyLevel = g_context->m_difficultyLevel;
+    _context->m_gameMode = g_context->m_gameMode;
+  }
+
+  // A match as a server hosting many would run it: nothing to draw, play or
+  // profile, and nobody at the controls.  It shares only what the process
+  // loads once, and no job system, since the MatchHost is its parallelism.
+  void MakeHeadless(GameContext* _context)
+  {
+    _context->m_langTable = g_context->m_langTable;
+    _context->m_globalWorld = g_context->m_globalWorld;
+    _context->m_locationId = g_context->m_locationId;
+    _context->m_bypassNetworking = true;
+    _context->m_difficultyLevel = g_context->m_difficultyLevel;
+    _context->m_gameMode = g_context->m_gameMode;
+  }
+
+  // Builds _context's Location from _snapshot.  Call within its GameContextScope.
+  bool RestoreLocation(GameContext* _context, const LevelFile* _levelFile, const SnapshotWriter& _snapshot)
+  {
+    _context->m_location = new Location();
+    _context->m_location->Init(_levelFile->m_missionFilename, _levelFile->m_mapFilename);
+
+    SnapshotReader reader(_snapshot.GetData(), _snapshot.Size());
+    int sequenceId = -1;
+    if (!_context->m_location->ReadSnapshot(reader, &sequenceId))
+      return false;
+
+    _context->m_simEventQueue.Clear();
+    return true;
+  }
+
+  // Builds _context's Location afresh and applies every recorded letter at the
+  // slice the client applied it.  Call within its GameContextScope.
+  void ReplayLocation(GameContext* _context, const LevelFile* _levelFile)
+  {
+    _context->m_syncRandom = s_recording.m_syncRandom;
+    _context->m_nextUniqueId = s_recording.m_nextUniqueId;
+    _context->m_difficultyLevel = s_recording.m_difficultyLevel;
+
+    _context->m_location = new Location();
+    _context->m_location->Init(_levelFile->m_missionFilename, _levelFile->m_mapFilename);
+
+    int sliceNum = -1;
+    auto advanceTo = [&](int _slice)
+    {
+      while (sliceNum != -1 && sliceNum != _slice)
+      {
+        _context->m_location->Advance(sliceNum);
+        sliceNum = sliceNum < NUM_SLICES_PER_FRAME - 1 ? sliceNum + 1 : -1;
+      }
+      _context->m_simEventQueue.Clear();
+    };
+
+    for (const Recording::Entry& entry : s_recording.m_entries)
+    {
+      advanceTo(entry.m_tick ? -1 : entry.m_slice);
+
+      ServerToClientLetter* letter = entry.m_letter.get();
+      if (!ProcessServerLetters(letter))
+        _context->m_clientToServer->ProcessServerUpdates(letter);
+
+      if (entry.m_tick)
+        sliceNum = 0;
+    }
+
+    advanceTo(-1);
+  }
+
+  // Names the first of _reports whose entry differs from _expected's
+  int FindMismatch(const std::vector<SyncReport>& _expected, const std::vector<SyncReport>& _reports, int* _tick)
+  {
+    for (*_tick = 0; *_tick < static_cast<int>(_expected.size()); ++*_tick)
+    {
+      const int subsystem = _expected[*_tick].FirstMismatch(_reports[*_tick]);
+      if (subsystem != -1)
+        return subsystem;
+    }
+
+    return -1;
+  }
+
+  void WriteReport(const char* _filename, const std::string& _report)
+  {
+    DebugTrace("{}", _report);
+    if (FILE* file = fopen(_filename, "w"))
+    {
+      fputs(_report.c_str(), file);
+      fclose(file);
+    }
+  }
+}
+
+void StartSnapshotCheckRecording()
+{
+  s_recording.m_entries.clear();
+  s_recording.m_active = g_prefsManager->GetInt("SnapshotCheckAt", 0) > 0;
+  s_recording.m_syncRandom = g_context->m_syncRandom;
+  s_recording.m_nextUniqueId = g_context->m_nextUniqueId;
+  s_recording.m_difficultyLevel = g_context->m_difficultyLevel;
+}
+
+void RecordSnapshotCheckLetter(ServerToClientLetter* _letter, bool _tick)
+{
+  if (s_recording.m_active)
+    s_recording.m_entries.push_back({std::make_unique<ServerToClientLetter>(*_letter), _tick, g_context->m_sliceNum});
+}
+
+void DiscardSnapshotCheckRecording()
+{
+  s_recording.m_entries.clear();
+  s_recording.m_active = false;
+}
+
+void RunSnapshotCheck()
+{
+  const int numTicks = std::max(1, g_prefsManager->GetInt("SnapshotCheckTicks", 100));
+  Location* live = g_context->m_location;
+  const int sequenceId = g_context->m_lastProcessedSequenceId;
+
+  if (!s_recording.m_active)
+  {
+    WriteReport(SNAPSHOTCHECK_REPORT, "Snapshot check: this client joined from a snapshot, so there is no tick 0 to replay from\n");
+    g_context->m_requestQuit = true;
+    return;
+  }
+
+  SnapshotWriter snapshot;
+  live->WriteSnapshot(snapshot, sequenceId);
+
+  SyncReport liveReport;
+  live->ComputeSyncReport(&liveReport);
+
+  // Neither is drawn, and their buildings share ids with the live ones
+  IRenderBackend* renderBackend = std::exchange(g_renderBackend, nullptr);
+
+  GameContext restored;
+  ShareSystems(&restored);
+
+  // The replay issues its own tasks, so it has its own task manager
+  GameContext replay;
+  ShareSystems(&replay);
+  replay.m_clientToServer = g_context->m_clientToServer;
+  replay.m_taskManager = new TaskManager();
+
+  std::vector<SyncReport> restoredReports;
+  std::vector<SyncReport> replayReports;
+  bool wasRestored;
+  {
+    GameContextScope scope(&restored);
+    wasRestored = RestoreLocation(&restored, live->m_levelFile, snapshot);
+    if (wasRestored)
+    {
+      restoredReports.emplace_back();
+      restored.m_location->ComputeSyncReport(&restoredReports.back());
+      for (int tick = 0; tick < numTicks; ++tick)
+        AdvanceTick(&restoredReports, true);
+    }
+
+    SAFE_DELETE(restored.m_location);
+  }
+
+  {
+    GameContextScope scope(&replay);
+    ReplayLocation(&replay, live->m_levelFile);
+
+    replayReports.emplace_back();
+    replay.m_location->ComputeSyncReport(&replayReports.back());
+    for (int tick = 0; tick < numTicks && wasRestored; ++tick)
+      AdvanceTick(&replayReports, true);
+
+    SAFE_DELETE(replay.m_location);
+    SAFE_DELETE(replay.m_taskManager);
+  }
+
+  g_renderBackend = renderBackend;
+
+  std::string report;
+  if (wasRestored)
+  {
+    report = std::format("Snapshot check: {} byte snapshot at sequence id {}, {} letters replayed, {} ticks",
+                         snapshot.Size(), sequenceId, s_recording.m_entries.size(), numTicks);
+
+    // Entry 0 of each is the state at the snapshot, where the live Location must agree too
+    const int liveSubsystem = liveReport.FirstMismatch(replayReports[0]);
+    int tick = 0;
+    const int subsystem = FindMismatch(replayReports, restoredReports, &tick);
+
+    if (liveSubsystem != -1)
+      report += std::format(", the replay differs from the live Location in {}\n", SyncReport::GetSubsystemName(liveSubsystem));
+    else if (subsystem == -1)
+      report += ", in sync throughout\n";
+    else if (tick == 0)
+      report += std::format(", differs on restore in {}\n", SyncReport::GetSubsystemName(subsystem));
+    else
+      report += std::format(", first differs after tick {} in {}\n", tick, SyncReport::GetSubsystemName(subsystem));
+  }
+  else
+    report = "Snapshot check: the snapshot was refused\n";
+
+  DiscardSnapshotCheckRecording();
+  WriteReport(SNAPSHOTCHECK_REPORT, report);
+  g_context->m_requestQuit = true;
+}
+
+void RunDormancyCheck()
+{
+  const int numTicks = std::max(1, g_prefsManager->GetInt("DormancyCheckTicks", 100));
+  const LevelFile* levelFile = g_context->m_location->m_levelFile;
+
+  SnapshotWriter snapshot;
+  g_context->m_location->WriteSnapshot(snapshot, 0);
+
+  struct Run
+  {
+    std::vector<SyncReport> m_reports;
+    double m_seconds = 0.0;
+    int64_t m_awakeBuildings = 0;   // Summed over ticks
+    bool m_restored = false;
+  };
+
+  // Neither run is drawn, and their buildings share ids with the live ones
+  IRenderBackend* renderBackend = std::exchange(g_renderBackend, nullptr);
+
+  // One run after the other rather than tick by tick, so neither run's
+  // timing includes the other's cache traffic
+  Run runs[2];
+  for (int dormancy = 0; dormancy < 2; ++dormancy)
+  {
+    Run& run = runs[dormancy];
+    GameContext context;
+    ShareSystems(&context);
+    GameContextScope scope(&context);
+
+    run.m_restored = RestoreLocation(&context, levelFile, snapshot);
+    for (int tick = 0; tick < numTicks && run.m_restored; ++tick)
+    {
+      if (!dormancy)
+        context.m_location->WakeAllBuildings();
+
+      const double start = GetHighResTime();
+      AdvanceTick(&run.m_reports);
+      run.m_seconds += GetHighResTime() - start;
+      run.m_awakeBuildings += context.m_location->GetNumAwakeBuildings();
+    }
+
+    SAFE_DELETE(context.m_location);
+  }
+
+  g_renderBackend = renderBackend;
+
+  std::string report;
+  if (runs[0].m_restored && runs[1].m_restored)
+  {
+    const Run& everyTick = runs[0];
+    const Run& dormant = runs[1];
+    report = std::format("Dormancy check: {} ticks, {} buildings; every building {:.2f} ms/tick, dormancy {:.2f} ms/tick, "
+                         "{:.1f} awake on average", numTicks, g_context->m_location->m_buildings.NumUsed(),
+                         everyTick.m_seconds * 1.0e3 / numTicks, dormant.m_seconds * 1.0e3 / numTicks,
+                         static_cast<double>(dormant.m_awakeBuildings) / numTicks);
+
+    int tick = 0;
+    int subsystem = -1;
+    for (; tick < numTicks && subsystem == -1; ++tick)
+      subsystem = everyTick.m_reports[tick].FirstMismatch(dormant.m_reports[tick]);
+
+    if (subsystem == -1)
+      report += ", in sync throughout\n";
+    else
+      report += std::format(", first differs after tick {} in {}\n", tick, SyncReport::GetSubsystemName(subsystem));
+  }
+  else
+    report = "Dormancy check: the snapshot was refused\n";
+
+  WriteReport(DORMANCYCHECK_REPORT, report);
+  g_context->m_requestQuit = true;
+}
+
+void RunMatchHostCheck()
+{
+  const int numMatches = std::max(1, g_prefsManager->GetInt("MatchHostCheckMatches", 8));
+  const int numTicks = std::max(1, g_prefsManager->GetInt("MatchHostCheckTicks", 100));
+  const LevelFile* levelFile = g_context->m_location->m_levelFile;
+
+  SnapshotWriter snapshot;
+  g_context->m_location->WriteSnapshot(snapshot, 0);
+
+  struct Match
+  {
+    GameContext m_context;
+    std::vector<SyncReport> m_reports;
+  };
+
+  struct Run
+  {
+    int m_numWorkers = 0;           // As passed to MatchHost; 0 is one per hardware thread
+    int m_numThreads = 0;
+    double m_seconds = 0.0;
+  };
+
+  Run runs[2];
+  runs[0].m_numWorkers = 1;
+
+  bool restored = true;
+  int firstMismatchTick = -1;
+  int firstMismatchSubsystem = -1;
+  std::vector<SyncReport> expected;  // The first copy's, which every other must match
+
+  for (Run& run : runs)
+  {
+    std::vector<std::unique_ptr<Match>> matches;
+    for (int i = 0; i < numMatches && restored; ++i)
+    {
+      matches.push_back(std::make_unique<Match>());
+      Match* match = matches.back().get();
+      MakeHeadless(&match->m_context);
+      GameContextScope scope(&match->m_context);
+      restored = RestoreLocation(&match->m_context, levelFile, snapshot);
+    }
+
+    if (restored)
+    {
+      Neuron::MatchHost host(run.m_numWorkers);
+      run.m_numThreads = host.GetNumWorkers();
+      for (const std::unique_ptr<Match>& match : matches)
+      {
+        host.AddMatch([match = match.get()]
+        {
+          GameContextScope scope(&match->m_context);
+          AdvanceTick(&match->m_reports);
+        });
+      }
+
+      const double start = GetHighResTime();
+      for (int tick = 0; tick < numTicks; ++tick)
+        host.AdvanceAll();
+      run.m_seconds = GetHighResTime() - start;
+
+      for (const std::unique_ptr<Match>& match : matches)
+      {
+        if (expected.empty())
+          expected = match->m_reports;
+
+        for (int tick = 0; tick < numTicks && firstMismatchSubsystem == -1; ++tick)
+        {
+          firstMismatchSubsystem = expected[tick].FirstMismatch(match->m_reports[tick]);
+          if (firstMismatchSubsystem != -1)
+            firstMismatchTick = tick + 1;
+        }
+      }
+    }
+
+    for (const std::unique_ptr<Match>& match : matches)
+    {
+      GameContextScope scope(&match->m_context);
+      SAFE_DELETE(match->m_context.m_location);
+    }
+  }
+
+  std::string report;
+  if (restored)
+  {
+    const Run& serial = runs[0];
+    const Run& pooled = runs[1];
+    report = std::format("Match host check: {} matches, {} ticks; one thread {:.2f} ms/tick, {} threads {:.2f} ms/tick "
+                         "({:.0f}% scaling)", numMatches, numTicks, serial.m_seconds * 1.0e3 / numTicks, pooled.m_numThreads,
+                         pooled.m_seconds * 1.0e3 / numTicks,
+                         100.0 * serial.m_seconds / (pooled.m_seconds * pooled.m_numThreads));
+
+    if (firstMismatchSubsystem == -1)
+      report += ", in sync throughout\n";
+    else
+      report += std::format(", first differs after tick {} in {}\n", firstMismatchTick, SyncReport::GetSubsystemName(firstMismatchSubsystem));
+  }
+  else
+    report = "Match host check: the snapshot was refused\n";
+
+  WriteReport(MATCHHOSTCHECK_REPORT, report);
+  g_context->m_requestQuit = true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+class ServerToClientLetter;
+
+// Checks late join against the real simulation.  Snapshots the live
+// Location, restores the snapshot into a second Location and replays every
+// letter since the client entered it into a third, built afresh as at tick
+// 0.  Recomputes each one's sync report from its objects, so nothing the
+// snapshot carried vouches for itself, then advances the restored and
+// replayed Locations SnapshotCheckTicks ticks.  Writes the first tick and
+// subsystem at which their reports differ, if any, to SnapshotCheck.txt.
+// Call between ticks; the game quits afterwards.
+void RunSnapshotCheck();
+
+// The letters RunSnapshotCheck replays.  Start when entering a Location,
+// record each letter as it is applied, and discard on a late join, which
+// leaves nothing to replay from.  Record only while SnapshotCheckAt is set.
+void StartSnapshotCheckRecording();
+void RecordSnapshotCheckLetter(ServerToClientLetter* _letter, bool _tick);
+void DiscardSnapshotCheckRecording();
+
+// Checks dormant buildings against the real level.  Restores a snapshot of
+// the live Location twice and advances each DormancyCheckTicks ticks, once
+// waking every building every tick and once letting idle ones sleep.
+// Writes the time per tick of each run, how many buildings stayed awake
+// and the first tick at which their sync reports differ, if any, to
+// DormancyCheck.txt.  Call between ticks; the game quits afterwards.
+void RunDormancyCheck();
+
+// Checks that real Locations run as independent matches on a MatchHost.
+// Restores MatchHostCheckMatches headless copies of the live Location, each
+// in its own GameContext with no camera, renderer, particles, sound,
+// profiler, scripts or tasks, and advances them MatchHostCheckTicks ticks,
+// first on one thread and then on one per hardware thread.  Writes the time
+// per tick of each, the scaling, and whether every copy's sync reports
+// agreed to MatchHostCheck.txt.  Call between ticks; the game quits afterwards.
+void RunMatchHostCheck();
@@ -36,7 +36,8 @@ Team::Team()
     m_teamType(TeamTypeUnused),
     m_currentUnitId(-1),
     m_currentEntityId(-1),
-    m_currentBuildingId(-1)
+    m_currentBuildingId(-1),
+    m_othersByType(Entity::NumEntityTypes)
 {
   m_others.SetTotalNumSlices(NUM_SLICES_PER_FRAME);
   m_others.SetStepSize(100);
@@ -105,20 +106,24 @@ void Team::SelectUnit(int _unitId, int _entityId, int _buildingId)
   m_currentUnitId = _unitId;
   m_currentEntityId = _entityId;
 
-  if (m_teamId == g_context->m_globalWorld->m_myTeamId)
+  // The cursor, tasks and sounds are all missing in a headless match
+  if (m_teamId == g_context->m_globalWorld->m_myTeamId && g_context->m_gameCursor)
     g_context->m_gameCursor->BoostSelectionArrows(2.0f);
 
   if (m_currentUnitId == -1 && m_currentBuildingId == -1 && m_others.ValidIndex(m_currentEntityId))
   {
     Entity* entity = m_others[m_currentEntityId];
-    if (entity && entity->m_type == Entity::TypeOfficer)
+    if (entity && entity->m_type == Entity::TypeOfficer && g_context->m_taskManager)
       g_context->m_taskManager->SelectTask(-1);
   }
 
-  if (_unitId == -1 && _entityId == -1 && _buildingId == -1)
-    g_context->m_soundSystem->TriggerOtherEvent(nullptr, "TaskManagerDeselectTask", SoundSourceBlueprint::TypeInterface);
-  else
-    g_context->m_soundSystem->TriggerOtherEvent(nullptr, "TaskManagerSelectTask", SoundSourceBlueprint::TypeInterface);
+  if (g_context->m_soundSystem)
+  {
+    if (_unitId == -1 && _entityId == -1 && _buildingId == -1)
+      g_context->m_soundSystem->TriggerOtherEvent(nullptr, "TaskManagerDeselectTask", SoundSourceBlueprint::TypeInterface);
+    else
+      g_context->m_soundSystem->TriggerOtherEvent(nullptr, "TaskManagerSelectTask", SoundSourceBlueprint::TypeInterface);
+  }
 
   //    if( m_teamId == g_context->m_globalWorld->m_myTeamId )
   //    {
@@ -183,22 +188,24 @@ Entity* Team::GetMyEntity()
 Unit* Team::NewUnit(int _troopType, int _numEntities, int* _unitId, const LegacyVector3& _pos)
 {
   *_unitId = m_units.GetNextFree();
-  Unit* unit = nullptr;
-
-  if (_troopType == Entity::TypeInsertionSquadie)
-    unit = new InsertionSquad(m_teamId, *_unitId, _numEntities, _pos);
-  else if (_troopType == Entity::TypeSpaceInvader)
-    unit = new AirstrikeUnit(m_teamId, *_unitId, _numEntities, _pos);
-  else if (_troopType == Entity::TypeVirii)
-    unit = new ViriiUnit(m_teamId, *_unitId, _numEntities, _pos);
-  else
-    unit = new Unit(_troopType, m_teamId, *_unitId, _numEntities, _pos);
+  Unit* unit = CreateUnit(_troopType, m_teamId, *_unitId, _numEntities, _pos);
 
   m_units.PutData(unit, *_unitId);
   unit->Begin();
   return unit;
 }
 
+Unit* Team::CreateUnit(int _troopType, int _teamId, int _unitId, int _numEntities, const LegacyVector3& _pos)
+{
+  if (_troopType == Entity::TypeInsertionSquadie)
+    return new InsertionSquad(_teamId, _unitId, _numEntities, _pos);
+  if (_troopType == Entity::TypeSpaceInvader)
+    return new AirstrikeUnit(_teamId, _unitId, _numEntities, _pos);
+  if (_troopType == Entity::TypeVirii)
+    return new ViriiUnit(_teamId, _unitId, _numEntities, _pos);
+  return new Unit(_troopType, _teamId, _unitId, _numEntities, _pos);
+}
+
 Entity* Team::NewEntity(int _troopType, int _unitId, int* _index)
 {
   if (_unitId == -1)
@@ -206,6 +213,7 @@ Entity* Team::NewEntity(int _troopType, int _unitId, int* _index)
     Entity* entity = Entity::NewEntity(_troopType);
     DEBUG_ASSERT(entity);
     *_index = m_others.PutData(entity);
+    m_othersByType.Add(_troopType, *_index);
     return entity;
   }
   if (m_units.ValidIndex(_unitId))
@@ -217,12 +225,28 @@ Entity* Team::NewEntity(int _troopType, int _unitId, int* _index)
   return nullptr;
 }
 
+void Team::RemoveOther(int _index)
+{
+  g_context->m_location->RetireSyncState(SyncSubsystem::Entities, m_others[_index]);
+  m_others.MarkNotUsed(_index);
+  m_othersByType.Remove(_index);
+}
+
+void Team::RebuildOthersByType()
+{
+  m_othersByType.Clear();
+  for (int i = 0; i < m_others.Size(); ++i)
+  {
+    if (m_others.ValidIndex(i) && m_others[i])
+      m_othersByType.Add(m_others[i]->m_type, i);
+  }
+}
+
 int Team::NumEntities(int _troopType)
 {
-  int result = 0;
-  int i;
+  int result = m_othersByType.Count(_troopType);
 
-  for (i = 0; i < m_units.Size(); ++i)
+  for (int i = 0; i < m_units.Size(); ++i)
   {
     if (m_units.ValidIndex(i))
     {
@@ -232,16 +256,6 @@ int Team::NumEntities(int _troopType)
     }
   }
 
-  for (i = 0; i < m_others.Size(); ++i)
-  {
-    if (m_others.ValidIndex(i))
-    {
-      Entity* ent = m_others[i];
-      if (ent->m_type == _troopType)
-        ++result;
-    }
-  }
-
   return result;
 }
 
@@ -308,19 +322,24 @@ void Team::Advance(int _slice)
           END_PROFILE(g_context->m_profiler, entityName);
 
 #ifdef PROFILER_ENABLED
-          DEBUG_ASSERT(strcmp(g_context->m_profiler->m_currentElement->m_name, "Advance Others") == 0);
+          DEBUG_ASSERT(!g_context->m_profiler || strcmp(g_context->m_profiler->m_currentElement->m_name, "Advance Others") == 0);
 #endif
 
           if (amIdead)
           {
             g_context->m_location->m_entityGrid->RemoveObject(myId, oldPos.x, oldPos.z, ent->m_radius);
-            m_others.MarkNotUsed(i);
+            RemoveOther(i);
             delete ent;
           }
-          else if (!ent->m_enabled)
-            g_context->m_location->m_entityGrid->RemoveObject(myId, oldPos.x, oldPos.z, ent->m_radius);
           else
-            g_context->m_location->m_entityGrid->UpdateObject(myId, oldPos.x, oldPos.z, ent->m_pos.x, ent->m_pos.z, ent->m_radius);
+          {
+            g_context->m_location->UpdateSyncState(SyncSubsystem::Entities, ent);
+
+            if (!ent->m_enabled)
+              g_context->m_location->m_entityGrid->RemoveObject(myId, oldPos.x, oldPos.z, ent->m_radius);
+            else
+              g_context->m_location->m_entityGrid->UpdateObject(myId, oldPos.x, oldPos.z, ent->m_pos.x, ent->m_pos.z, ent->m_radius);
+          }
         }
       }
     }
@@ -436,23 +455,17 @@ void Team::RenderVirii(float _predictionTime)
 
   EntityRenderer* renderer = g_entityRenderRegistry.Get(Entity::TypeVirii);
 
-  for (int i = 0; i <= m_others.Size(); i++)
+  for (int i : GetOthers(Entity::TypeVirii))
   {
-    if (m_others.ValidIndex(i))
+    Entity* entity = m_others.GetData(i);
+    if (entity->IsInView())
     {
-      Entity* entity = m_others.GetData(i);
-      if (entity->m_type == Entity::TypeVirii)
-      {
-        if (entity->IsInView())
-        {
-          EntityRenderContext ctx;
-          ctx.predictionTime = (i <= lastUpdated) ? _predictionTime : _predictionTime + SERVER_ADVANCE_PERIOD;
-          ctx.highDetailFactor = 1.0f;
+      EntityRenderContext ctx;
+      ctx.predictionTime = (i <= lastUpdated) ? _predictionTime : _predictionTime + SERVER_ADVANCE_PERIOD;
+      ctx.highDetailFactor = 1.0f;
 
-          DEBUG_ASSERT(renderer);
-          renderer->Render(*entity, ctx);
-        }
-      }
+      DEBUG_ASSERT(renderer);
+      renderer->Render(*entity, ctx);
     }
   }
 
@@ -513,28 +526,22 @@ void Team::RenderDarwinians(float _predictionTime)
 
   EntityRenderer* renderer = g_entityRenderRegistry.Get(Entity::TypeDarwinian);
 
-  for (int i = 0; i <= m_others.Size(); i++)
+  for (int i : GetOthers(Entity::TypeDarwinian))
   {
-    if (m_others.ValidIndex(i))
+    Entity* entity = m_others.GetData(i);
+    if (entity->IsInView())
     {
-      Entity* entity = m_others.GetData(i);
-      if (entity->m_type == Entity::TypeDarwinian)
-      {
-        if (entity->IsInView())
-        {
-          float camDistSqd = (entity->m_pos - g_context->m_camera->GetPos()).MagSquared();
-          float highDetail = 1.0f - (camDistSqd / highDetailDistanceSqd);
-          highDetail = std::max(highDetail, 0.0f);
-          highDetail = std::min(highDetail, 1.0f);
+      float camDistSqd = (entity->m_pos - g_context->m_camera->GetPos()).MagSquared();
+      float highDetail = 1.0f - (camDistSqd / highDetailDistanceSqd);
+      highDetail = std::max(highDetail, 0.0f);
+      highDetail = std::min(highDetail, 1.0f);
 
-          EntityRenderContext ctx;
-          ctx.predictionTime = (i <= lastUpdated) ? _predictionTime : _predictionTime + SERVER_ADVANCE_PERIOD;
-          ctx.highDetailFactor = highDetail;
+      EntityRenderContext ctx;
+      ctx.predictionTime = (i <= lastUpdated) ? _predictionTime : _predictionTime + SERVER_ADVANCE_PERIOD;
+      ctx.highDetailFactor = highDetail;
 
-          DEBUG_ASSERT(renderer);
-          renderer->Render(*entity, ctx);
-        }
-      }
+      DEBUG_ASSERT(renderer);
+      renderer->Render(*entity, ctx);
     }
   }
 
@@ -549,45 +556,34 @@ void Team::RenderDarwinians(float _predictionTime)
 
 void Team::RenderOthers(float _predictionTime)
 {
+  // Type by type, skipping the types drawn in their own passes
   int lastUpdated = m_others.GetLastUpdated();
 
-  for (int i = 0; i <= lastUpdated; i++)
+  for (int type = 0; type < Entity::NumEntityTypes; ++type)
   {
-    if (m_others.ValidIndex(i))
-    {
-      Entity* entity = m_others.GetData(i);
-      if (entity->m_type != Entity::TypeVirii && entity->m_type != Entity::TypeDarwinian && entity->m_type != Entity::TypeAI && entity->IsInView())
-      {
-        START_PROFILE(g_context->m_profiler, Entity::GetTypeName( entity->m_type ));
-        EntityRenderer* renderer = g_entityRenderRegistry.Get(entity->m_type);
-        EntityRenderContext ctx;
-        ctx.predictionTime = _predictionTime;
-        ctx.highDetailFactor = 1.0f;
-        renderer->Render(*entity, ctx);
-        END_PROFILE(g_context->m_profiler, Entity::GetTypeName( entity->m_type ));
-      }
-    }
-  }
+    if (type == Entity::TypeVirii || type == Entity::TypeDarwinian || type == Entity::TypeAI)
+      continue;
 
-  int size = m_others.Size();
-  _predictionTime += SERVER_ADVANCE_PERIOD;
-  for (int i = lastUpdated + 1; i < size; i++)
-  {
-    if (m_others.ValidIndex(i))
+    const std::vector<int>& others = GetOthers(type);
+    if (others.empty())
+      continue;
+
+    START_PROFILE(g_context->m_profiler, Entity::GetTypeName( type ));
+    EntityRenderer* renderer = g_entityRenderRegistry.Get(type);
+    DEBUG_ASSERT(renderer);
+
+    for (int i : others)
     {
       Entity* entity = m_others.GetData(i);
-      if (entity->m_type != Entity::TypeVirii && entity->m_type != Entity::TypeDarwinian && entity->m_type != Entity::TypeAI && entity->IsInView())
+      if (entity->IsInView())
       {
-        START_PROFILE(g_context->m_profiler, Entity::GetTypeName( entity->m_type ));
-        EntityRenderer* renderer = g_entityRenderRegistry.Get(entity->m_type);
-        DEBUG_ASSERT(renderer);
         EntityRenderContext ctx;
-        ctx.predictionTime = _predictionTime;
+        ctx.predictionTime = (i <= lastUpdated) ? _predictionTime : _predictionTime + SERVER_ADVANCE_PERIOD;
         ctx.highDetailFactor = 1.0f;
         renderer->Render(*entity, ctx);
-        END_PROFILE(g_context->m_profiler, Entity::GetTypeName( entity->m_type ));
       }
     }
+    END_PROFILE(g_context->m_profiler, Entity::GetTypeName( type ));
   }
 }
 
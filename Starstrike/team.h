@@ -6,6 +6,7 @@
 #include "llist.h"
 #include "worldobject.h"
 #include "entity.h"
+#include "SlotTypeLists.h"
 
 class Unit;
 class InsertionSquad;
@@ -30,6 +31,7 @@ class Team
 
     FastDArray<Unit*> m_units;
     SliceDArray<Entity*> m_others;
+    Neuron::SlotTypeLists m_othersByType; // Slots of m_others holding each entity type; free them with RemoveOther
     LList<WorldObjectId> m_specials; // Officers and tanks for quick lookup
 
     RGBAColour m_colour;
@@ -54,8 +56,13 @@ class Team
     Unit* GetMyUnit();
     Entity* GetMyEntity();
     Unit* NewUnit(int _troopType, int _numEntities, int* _unitId, const LegacyVector3& _pos);
+    static Unit* CreateUnit(int _troopType, int _teamId, int _unitId, int _numEntities, const LegacyVector3& _pos); // Constructs but does not add or Begin
     Entity* NewEntity(int _troopType, int _unitId, int* _index);
 
+    void RemoveOther(int _index); // Frees the slot and retires its sync state; the caller deletes the entity
+    void RebuildOthersByType(); // After m_others has been filled directly
+    const std::vector<int>& GetOthers(int _type) const { return m_othersByType.GetSlots(_type); } // Ascending
+
     int NumEntities(int _troopType); // Counts the total number
 
     void Advance(int _slice);
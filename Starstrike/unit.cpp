@@ -59,6 +59,36 @@ void Unit::Begin()
 {
 }
 
+void Unit::WriteSnapshot( SnapshotWriter &_writer ) const
+{
+    WriteSnapshotVector( _writer, m_wayPoint );
+    _writer.Write( m_routeId );
+    _writer.Write( m_routeWayPointId );
+    WriteSnapshotVector( _writer, m_centerPos );
+    WriteSnapshotVector( _writer, m_vel );
+    _writer.Write( m_radius );
+    WriteSnapshotVector( _writer, m_targetDir );
+    _writer.Write( m_attackAccumulator );
+    WriteSnapshotVector( _writer, m_accumulatedCenter );
+    _writer.Write( m_accumulatedRadiusSquared );
+    _writer.Write( m_numAccumulated );
+}
+
+void Unit::ReadSnapshot( SnapshotReader &_reader )
+{
+    ReadSnapshotVector( _reader, m_wayPoint );
+    _reader.Read( m_routeId );
+    _reader.Read( m_routeWayPointId );
+    ReadSnapshotVector( _reader, m_centerPos );
+    ReadSnapshotVector( _reader, m_vel );
+    _reader.Read( m_radius );
+    ReadSnapshotVector( _reader, m_targetDir );
+    _reader.Read( m_attackAccumulator );
+    ReadSnapshotVector( _reader, m_accumulatedCenter );
+    _reader.Read( m_accumulatedRadiusSquared );
+    _reader.Read( m_numAccumulated );
+}
+
 Entity *Unit::NewEntity( int *_index )
 {
     Entity *entity = Entity::NewEntity( m_troopType );
@@ -84,6 +114,7 @@ void Unit::RemoveEntity( int _index, float _posX, float _posZ )
 		WorldObjectId myId( m_teamId, m_unitId, _index, entity->m_id.GetUniqueId() );
 
 		g_context->m_location->m_entityGrid->RemoveObject( myId, _posX, _posZ, entity->m_radius );
+		g_context->m_location->RetireSyncState( SyncSubsystem::Entities, entity );
 
 		m_entities.MarkNotUsed( _index );
         delete entity;
@@ -115,6 +146,8 @@ void Unit::AdvanceEntities(int _slice)
                 }
                 else
                 {
+                    g_context->m_location->UpdateSyncState( SyncSubsystem::Entities, s );
+
 					WorldObjectId myId( m_teamId, m_unitId, i, s->m_id.GetUniqueId() );
                     g_context->m_location->m_entityGrid->UpdateObject( myId, oldPos.x, oldPos.z, s->m_pos.x, s->m_pos.z, s->m_radius );
                 }
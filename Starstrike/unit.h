@@ -56,6 +56,9 @@ public:
 
     virtual bool    IsInView        ();
 
+    virtual void    WriteSnapshot   ( SnapshotWriter &_writer ) const;    // Unit state only; Location writes the entities
+    virtual void    ReadSnapshot    ( SnapshotReader &_reader );
+
     Entity  *NewEntity              ( int *_index );
     int     AddEntity               ( Entity *_entity );
     void    RemoveEntity            ( int _index, float _posX, float _posZ );
@@ -107,13 +107,19 @@ void Water::GenerateLightMap()
   landData.Initialise(MASK_SIZE, MASK_SIZE, 0.0f);
   landData.SetAll(0.0f);
 
+  float rowX[MASK_SIZE], rowZ[MASK_SIZE], landHeights[MASK_SIZE];
   for (int z = low; z < high; ++z)
   {
     for (int x = low; x < high; ++x)
     {
-      float landHeight = g_context->m_location->m_landscape.m_heightMap->GetValue((0.0f + static_cast<float>(x)) * scaleFactorX - offX,
-                                                                              (0.0f + static_cast<float>(z)) * scaleFactorZ - offZ);
-      if (landHeight > 0.0f)
+      rowX[x - low] = (0.0f + static_cast<float>(x)) * scaleFactorX - offX;
+      rowZ[x - low] = (0.0f + static_cast<float>(z)) * scaleFactorZ - offZ;
+    }
+    g_context->m_location->m_landscape.m_heightMap->GetValues(rowX, rowZ, landHeights, high - low);
+
+    for (int x = low; x < high; ++x)
+    {
+      if (landHeights[x - low] > 0.0f)
         landData.PutData(x, z, 1.0f);
     }
   }